@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <utility>
 
 extern "C" {
 #include <libavutil/channel_layout.h>
@@ -11,6 +12,7 @@ extern "C" {
 
 #include "player/common/log_manager.h"
 #include "player/common/timer_util.h"
+#include "player/stats/alloc_tracker.h"
 #include "player/stats/statistics_manager.h"
 
 namespace zenplay {
@@ -25,7 +27,8 @@ AudioPlayer::~AudioPlayer() {
   Cleanup();
 }
 
-Result<void> AudioPlayer::Init(const AudioConfig& config) {
+Result<void> AudioPlayer::Init(const AudioConfig& config,
+                              std::unique_ptr<AudioOutput> output) {
   config_ = config;
   target_sample_rate_ = config.target_sample_rate;  // 保存目标采样率用于PTS计算
 
@@ -36,8 +39,10 @@ Result<void> AudioPlayer::Init(const AudioConfig& config) {
   output_spec_.buffer_size = config_.buffer_size;
   output_spec_.format = config_.target_format;
 
-  // 创建音频输出设备
-  audio_output_ = AudioOutput::Create();
+  frame_queue_.SetMaxSize(config_.max_frame_queue_size);
+
+  // 音频输出设备由调用方创建
+  audio_output_ = std::move(output);
   if (!audio_output_) {
     return Result<void>::Err(ErrorCode::kAudioError,
                              "Failed to create audio output device");
@@ -146,6 +151,15 @@ bool AudioPlayer::PushFrameTimeout(ResampledAudioFrame frame, int timeout_ms) {
   }
 }
 
+size_t AudioPlayer::PushFrames(std::vector<ResampledAudioFrame>& frames) {
+  if (state_manager_->ShouldStop()) {
+    return 0;
+  }
+
+  // ✅ 队列满时阻塞，有空间后按批推入
+  return frame_queue_.PushBatch(frames);
+}
+
 void AudioPlayer::ClearFrames() {
   // ✅ 清空播放队列
   frame_queue_.Clear([](ResampledAudioFrame& frame) {
@@ -239,6 +253,9 @@ int AudioPlayer::AudioOutputCallback(void* user_data,
   }
 
   AudioPlayer* player = static_cast<AudioPlayer*>(user_data);
+  STATS_COUNT_WAKEUP(kAudioOutput);
+  // 回调运行在音频设备线程上，每次回调重新标记（只写 thread_local）
+  STATS_ALLOC_THREAD(kAudioOutput);
 
   TIMER_START(audio_render);
   int bytes_filled = player->FillAudioBuffer(buffer, buffer_size);
@@ -336,6 +353,11 @@ int AudioPlayer::FillAudioBuffer(uint8_t* buffer, int buffer_size) {
       need_update_base_pts = false;
     }
 
+    if (watchdog_) {
+      watchdog_->Heartbeat(PipelineWatchdog::Stage::kAudioOutput,
+                           new_frame.pts_ms);
+    }
+
     // ✅ Step 4: 设置为当前帧并继续消费
     current_playback_frame_ = std::move(new_frame);
     current_frame_offset_ = 0;
@@ -5,6 +5,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 extern "C" {
 #include <libavutil/frame.h>
@@ -15,6 +16,7 @@ extern "C" {
 #include "player/common/blocking_queue.h"
 #include "player/common/common_def.h"
 #include "player/common/error.h"
+#include "player/common/pipeline_watchdog.h"
 #include "player/common/player_state_manager.h"
 #include "player/sync/av_sync_controller.h"
 
@@ -50,6 +52,7 @@ class AudioPlayer {
     AVSampleFormat target_format = AV_SAMPLE_FMT_S16;  // 目标采样格式
     int target_bits_per_sample = 16;                   // 目标位深度
     int buffer_size = 1024;                            // 缓冲区大小
+    size_t max_frame_queue_size = 50;                  // PCM 帧队列容量
   };
 
   /**
@@ -64,9 +67,12 @@ class AudioPlayer {
   /**
    * @brief 初始化音频播放器
    * @param config 音频配置
+   * @param output 音频输出设备（通常为 AudioOutput::Create()，测试时可注入
+   *        记录输出时间的设备）；为空时初始化失败
    * @return Result<void> 成功返回Ok，失败返回错误码
    */
-  Result<void> Init(const AudioConfig& config = AudioConfig{});
+  Result<void> Init(const AudioConfig& config,
+                    std::unique_ptr<AudioOutput> output);
 
   /**
    * @brief 开始播放
@@ -116,6 +122,20 @@ class AudioPlayer {
    */
   void PostSeek(PlayerStateManager::PlayerState target_state);
 
+  /**
+   * @brief 设置卡死检测器，音频回调每取出一帧上报一次进度
+   * @param watchdog 外部管理，需在 Start() 之前设置
+   */
+  void SetWatchdog(PipelineWatchdog* watchdog) { watchdog_ = watchdog; }
+
+  /**
+   * @brief 设置音频时钟更新的同步控制器
+   * @note 先打开设备、后创建同步控制器时使用，需在 Start() 之前设置
+   */
+  void SetSyncController(AVSyncController* sync_controller) {
+    sync_controller_ = sync_controller;
+  }
+
   /**
    * @brief 设置音量
    * @param volume 音量值 (0.0 - 1.0)
@@ -145,6 +165,15 @@ class AudioPlayer {
    */
   bool PushFrameTimeout(ResampledAudioFrame frame, int timeout_ms = 100);
 
+  /**
+   * @brief 批量推送重采样后的帧（一次加锁、一次唤醒推入多帧）
+   * @param frames 待推送的帧，推入的帧从头部移除
+   * @return 推入的帧数；停止时未推入的帧留在 frames 中
+   *
+   * @note 用于一个包解码出多帧、或 Flush 一次取出大量帧的场景
+   */
+  size_t PushFrames(std::vector<ResampledAudioFrame>& frames);
+
   /**
    * @brief 清空音频帧队列
    */
@@ -221,6 +250,7 @@ class AudioPlayer {
   // 状态管理和音视频同步控制器
   PlayerStateManager* state_manager_;
   AVSyncController* sync_controller_;
+  PipelineWatchdog* watchdog_ = nullptr;  // 外部管理的卡死检测器
 
   // PTS跟踪 (基于采样数的精确计算)
   mutable std::mutex pts_mutex_;
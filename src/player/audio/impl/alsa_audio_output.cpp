@@ -95,7 +95,12 @@ void AlsaAudioOutput::Stop() {
     return;
   }
 
-  should_stop_ = true;
+  {
+    // 持锁设置：暂停中的音频线程不会错过唤醒
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    should_stop_ = true;
+  }
+  pause_cv_.notify_all();
   is_playing_ = false;
 
   // 等待音频线程结束
@@ -112,17 +117,24 @@ void AlsaAudioOutput::Stop() {
 }
 
 void AlsaAudioOutput::Pause() {
-  is_paused_ = true;
+  {
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    is_paused_ = true;
+  }
   if (pcm_handle_) {
     snd_pcm_pause(pcm_handle_, 1);
   }
 }
 
 void AlsaAudioOutput::Resume() {
-  is_paused_ = false;
   if (pcm_handle_) {
     snd_pcm_pause(pcm_handle_, 0);
   }
+  {
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    is_paused_ = false;
+  }
+  pause_cv_.notify_all();
 }
 
 void AlsaAudioOutput::SetVolume(float volume) {
@@ -324,7 +336,22 @@ void AlsaAudioOutput::AudioThreadMain() {
 
   while (!should_stop_.load()) {
     if (is_paused_.load()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      // 暂停时阻塞等待 Resume() / Stop()，不定时唤醒
+      std::unique_lock<std::mutex> lock(pause_mutex_);
+      pause_cv_.wait(lock, [this]() {
+        return !is_paused_.load() || should_stop_.load();
+      });
+      continue;
+    }
+
+    // 设备以非阻塞方式打开：等到能写入一个周期再取数据，避免空转；
+    // 超时（如设备被暂停）时回到循环开头重新检查状态
+    int ready = snd_pcm_wait(pcm_handle_, kDeviceWaitTimeoutMs);
+    if (ready == 0) {
+      continue;
+    }
+    if (ready < 0) {
+      snd_pcm_recover(pcm_handle_, ready, 1);
       continue;
     }
 
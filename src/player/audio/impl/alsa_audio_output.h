@@ -7,6 +7,7 @@
 #include <alsa/asoundlib.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -91,6 +92,13 @@ class AlsaAudioOutput : public AudioOutput {
   std::atomic<bool> is_paused_;
   std::atomic<bool> should_stop_;
 
+  // 暂停等待（Pause 后音频线程阻塞在这里，Resume / Stop 唤醒）
+  std::mutex pause_mutex_;
+  std::condition_variable pause_cv_;
+
+  // 等待设备可写的超时（毫秒），超时后重新检查暂停 / 停止
+  static constexpr int kDeviceWaitTimeoutMs = 100;
+
   // 音量控制
   mutable std::mutex volume_mutex_;
   std::atomic<float> volume_;
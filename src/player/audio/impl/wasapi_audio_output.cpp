@@ -113,7 +113,12 @@ void WasapiAudioOutput::Stop() {
     return;
   }
 
-  should_stop_ = true;
+  {
+    // 持锁设置：暂停中的音频线程不会错过唤醒
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    should_stop_ = true;
+  }
+  pause_cv_.notify_all();
   is_playing_ = false;
 
   // 等待音频线程结束
@@ -129,17 +134,24 @@ void WasapiAudioOutput::Stop() {
 }
 
 void WasapiAudioOutput::Pause() {
-  is_paused_ = true;
+  {
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    is_paused_ = true;
+  }
   if (audio_client_) {
     audio_client_->Stop();
   }
 }
 
 void WasapiAudioOutput::Resume() {
-  is_paused_ = false;
   if (audio_client_) {
     audio_client_->Start();
   }
+  {
+    std::lock_guard<std::mutex> lock(pause_mutex_);
+    is_paused_ = false;
+  }
+  pause_cv_.notify_all();
 }
 
 void WasapiAudioOutput::SetVolume(float volume) {
@@ -344,7 +356,11 @@ void WasapiAudioOutput::AudioThreadMain() {
 
   while (!should_stop_.load()) {
     if (is_paused_.load()) {
-      Sleep(10);
+      // 暂停时阻塞等待 Resume() / Stop()，不定时唤醒
+      std::unique_lock<std::mutex> lock(pause_mutex_);
+      pause_cv_.wait(lock, [this]() {
+        return !is_paused_.load() || should_stop_.load();
+      });
       continue;
     }
 
@@ -9,6 +9,7 @@
 #ifdef OS_WIN
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -113,6 +114,10 @@ class WasapiAudioOutput : public AudioOutput {
   std::atomic<bool> is_paused_;
   std::atomic<bool> should_stop_;
 
+  // 暂停等待（Pause 后音频线程阻塞在这里，Resume / Stop 唤醒）
+  std::mutex pause_mutex_;
+  std::condition_variable pause_cv_;
+
   // 音量控制
   mutable std::mutex volume_mutex_;
   std::atomic<float> volume_;
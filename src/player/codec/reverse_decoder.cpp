@@ -0,0 +1,255 @@
+#include "player/codec/reverse_decoder.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "player/codec/video_decoder.h"
+#include "player/common/log_manager.h"
+#include "player/demuxer/demuxer.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace zenplay {
+
+namespace {
+
+// 跳转没有退到 end_pts 之前时（无索引、关键帧间隔很长），逐次加大回退量
+constexpr int64_t kInitialBackoffUs = 1000;
+constexpr int64_t kMaxBackoffUs = 60 * 1000 * 1000;
+constexpr int kMaxSeekAttempts = 8;
+
+int64_t FramePts(const AVFrame* frame) {
+  return frame->pts != AV_NOPTS_VALUE ? frame->pts
+                                      : frame->best_effort_timestamp;
+}
+
+}  // namespace
+
+ReverseDecoder::ReverseDecoder(Demuxer* demuxer,
+                               std::mutex* demuxer_mutex,
+                               VideoDecoder* decoder,
+                               std::mutex* decoder_mutex)
+    : demuxer_(demuxer),
+      demuxer_mutex_(demuxer_mutex),
+      decoder_(decoder),
+      decoder_mutex_(decoder_mutex) {}
+
+ReverseDecoder::~ReverseDecoder() {
+  Stop();
+}
+
+Result<void> ReverseDecoder::Start(int64_t start_ms, const Options& options) {
+  if (worker_) {
+    return Result<void>::Err(ErrorCode::kAlreadyRunning,
+                             "Reverse decoder already running");
+  }
+  if (!demuxer_ || !decoder_ || !decoder_->opened()) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Reverse decoder requires an opened video stream");
+  }
+
+  stream_index_ = demuxer_->active_video_stream_index();
+  AVStream* stream = demuxer_->findStreamByIndex(stream_index_);
+  if (!stream) {
+    return Result<void>::Err(ErrorCode::kInvalidParameter,
+                             "No active video stream for reverse playback");
+  }
+
+  options_ = options;
+  time_base_ = stream->time_base;
+  stream_start_pts_ =
+      stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+
+  // 起始位置本身也要显示：第一块包含 start_ms 所在的帧
+  int64_t start_pts =
+      av_rescale_q(start_ms, AVRational{1, 1000}, time_base_) + 1;
+
+  stop_.store(false);
+  worker_done_.store(false);
+  chunk_queue_.Reset();
+  worker_ = std::make_unique<std::thread>(&ReverseDecoder::WorkerThread, this,
+                                          start_pts);
+
+  MODULE_INFO(LOG_MODULE_DECODER,
+              "Reverse decoding started at {}ms (chunk cap {} MB, {} frames)",
+              start_ms, options_.max_bytes / 3 / (1024 * 1024),
+              options_.max_frames_per_chunk);
+  return Result<void>::Ok();
+}
+
+void ReverseDecoder::Stop() {
+  stop_.store(true);
+  chunk_queue_.Stop();
+  if (worker_ && worker_->joinable()) {
+    worker_->join();
+  }
+  worker_.reset();
+  chunk_queue_.Clear();
+}
+
+bool ReverseDecoder::PopChunk(std::unique_ptr<FrameChunk>* chunk,
+                              int timeout_ms) {
+  return chunk_queue_.PopTimeout(*chunk, timeout_ms);
+}
+
+void ReverseDecoder::WorkerThread(int64_t start_pts) {
+  int64_t end_pts = start_pts;
+
+  while (!stop_.load()) {
+    auto result = DecodeChunkBefore(end_pts);
+    if (!result.IsOk()) {
+      if (!stop_.load()) {
+        MODULE_ERROR(LOG_MODULE_DECODER, "Reverse decoding stopped: {}",
+                     result.FullMessage());
+      }
+      break;
+    }
+
+    std::unique_ptr<FrameChunk> chunk = result.TakeValue();
+    bool last = chunk->reached_start;
+    end_pts = FramePts(chunk->frames.front().get());
+
+    MODULE_DEBUG(LOG_MODULE_DECODER,
+                 "Reverse chunk ready: {} frames, {} KB, first pts {}",
+                 chunk->frames.size(), chunk->bytes / 1024, end_pts);
+
+    // 队列满（呈现方还没取走上一块）时在这里等待
+    if (!chunk_queue_.Push(std::move(chunk)) || last) {
+      break;
+    }
+  }
+
+  worker_done_.store(true);
+  // 让呈现方在取完剩余帧块后看到结束
+  chunk_queue_.Stop();
+}
+
+Result<std::unique_ptr<ReverseDecoder::FrameChunk>>
+ReverseDecoder::DecodeChunkBefore(int64_t end_pts) {
+  int64_t end_us = av_rescale_q(end_pts, time_base_, AVRational{1, 1000000});
+  int64_t start_us =
+      av_rescale_q(stream_start_pts_, time_base_, AVRational{1, 1000000});
+  int64_t backoff_us = kInitialBackoffUs;
+
+  for (int attempt = 0; attempt < kMaxSeekAttempts && !stop_.load();
+       ++attempt) {
+    int64_t target_us = std::max(end_us - backoff_us, start_us);
+
+    auto chunk = std::make_unique<FrameChunk>();
+    chunk->time_base = time_base_;
+    bool truncated = false;
+    auto result = DecodeRange(target_us, end_pts, chunk.get(), &truncated);
+    if (!result.IsOk()) {
+      return Result<std::unique_ptr<FrameChunk>>::Err(result.Code(),
+                                                      result.Message());
+    }
+
+    if (!chunk->frames.empty()) {
+      // 跳转目标已到开头且没有丢弃开头的帧：这是最后一块
+      chunk->reached_start = target_us <= start_us && !truncated;
+      return Result<std::unique_ptr<FrameChunk>>::Ok(std::move(chunk));
+    }
+
+    if (target_us <= start_us) {
+      // 开头之前已经没有帧
+      break;
+    }
+    backoff_us = std::min(backoff_us * 16, kMaxBackoffUs);
+  }
+
+  return Result<std::unique_ptr<FrameChunk>>::Err(
+      ErrorCode::kDecoderError, "No frames found before pts " +
+                                    std::to_string(end_pts) +
+                                    " (reached start of stream)");
+}
+
+Result<void> ReverseDecoder::DecodeRange(int64_t target_us,
+                                         int64_t end_pts,
+                                         FrameChunk* chunk,
+                                         bool* truncated) {
+  const size_t max_chunk_bytes = options_.max_bytes / 3;
+  std::deque<AVFramePtr> window;
+  size_t window_bytes = 0;
+  bool reached_end = false;
+
+  auto accept_frames = [&](std::vector<AVFramePtr>* frames) {
+    for (auto& frame : *frames) {
+      int64_t pts = FramePts(frame.get());
+      if (pts == AV_NOPTS_VALUE) {
+        continue;
+      }
+      // 解码器按 PTS 顺序输出，越过 end_pts 即说明之前的帧已全部输出
+      if (pts >= end_pts) {
+        reached_end = true;
+        break;
+      }
+      window_bytes += FrameBytes(frame.get());
+      window.push_back(std::move(frame));
+
+      // 超限：丢弃最早的帧，由下一块重新解码
+      while (window.size() > 1 &&
+             (window_bytes > max_chunk_bytes ||
+              (options_.max_frames_per_chunk > 0 &&
+               window.size() > options_.max_frames_per_chunk))) {
+        window_bytes -= FrameBytes(window.front().get());
+        window.pop_front();
+        *truncated = true;
+      }
+    }
+    frames->clear();
+  };
+
+  std::scoped_lock lock(*demuxer_mutex_, *decoder_mutex_);
+
+  if (!demuxer_->Seek(target_us, true)) {
+    return Result<void>::Err(ErrorCode::kDemuxError,
+                             "Seek failed at " + std::to_string(target_us));
+  }
+  decoder_->FlushBuffers();
+
+  std::vector<AVFramePtr> frames;
+  while (!reached_end && !stop_.load()) {
+    auto packet_result = demuxer_->ReadPacket();
+    if (!packet_result.IsOk()) {
+      return Result<void>::Err(packet_result.Code(), packet_result.Message());
+    }
+
+    AVPacket* packet = packet_result.Value();
+    if (!packet) {
+      decoder_->Flush(&frames);  // EOF：取出解码器中剩余的帧
+      accept_frames(&frames);
+      break;
+    }
+
+    if (packet->stream_index == stream_index_) {
+      decoder_->Decode(packet, &frames);
+      accept_frames(&frames);
+    }
+    av_packet_free(&packet);
+  }
+
+  if (stop_.load()) {
+    return Result<void>::Err(ErrorCode::kInternalError,
+                             "Reverse decoding stopped");
+  }
+
+  chunk->frames.reserve(window.size());
+  for (auto& frame : window) {
+    chunk->frames.push_back(std::move(frame));
+  }
+  chunk->bytes = window_bytes;
+  return Result<void>::Ok();
+}
+
+size_t ReverseDecoder::FrameBytes(const AVFrame* frame) {
+  size_t bytes = 0;
+  for (int i = 0; i < AV_NUM_DATA_POINTERS && frame->buf[i]; ++i) {
+    bytes += frame->buf[i]->size;
+  }
+  return bytes;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "player/common/blocking_queue.h"
+#include "player/common/common_def.h"
+#include "player/common/error.h"
+
+extern "C" {
+#include <libavutil/rational.h>
+}
+
+namespace zenplay {
+
+class Demuxer;
+class VideoDecoder;
+
+/**
+ * @brief 倒序交付的帧块来源（呈现方只依赖这一接口）
+ */
+class ReverseFrameSource {
+ public:
+  /**
+   * @brief 一段按 PTS 升序排列的解码帧
+   */
+  struct FrameChunk {
+    std::vector<AVFramePtr> frames;
+    AVRational time_base{1, 1000000};
+    size_t bytes = 0;
+    bool reached_start = false;  // 已到达文件开头，这是最后一块
+  };
+
+  virtual ~ReverseFrameSource() = default;
+
+  /**
+   * @brief 停止产出并唤醒等待帧块的呈现方
+   */
+  virtual void Stop() = 0;
+
+  /**
+   * @brief 取下一块（时间上更早的一块）
+   * @return 超时、已停止或已交付完最后一块时返回 false
+   */
+  virtual bool PopChunk(std::unique_ptr<FrameChunk>* chunk,
+                        int timeout_ms) = 0;
+
+  /**
+   * @brief 所有帧块都已交付（到达开头或出错）
+   */
+  virtual bool finished() const = 0;
+};
+
+/**
+ * @brief 倒放解码器：按 GOP 向前解码，按时间倒序交付
+ *
+ * 视频只能从关键帧开始向前解码。工作线程从播放位置开始，每次跳转到
+ * 上一个 GOP 的关键帧，把整个 GOP 解码进一个帧块（按 PTS 升序），
+ * 交给呈现方倒序取用；呈现当前帧块的同时，工作线程已在解码更早的一块。
+ *
+ * 内存控制：
+ * - 同时最多存在三个帧块（呈现中 + 已就绪 + 解码中），每块上限
+ *   max_bytes / 3
+ * - GOP 超出单块上限时只保留最后一段，下一块从同一关键帧重新解码
+ *   到这一段的开头（以重复解码换取内存）
+ * - max_frames_per_chunk 限制帧数（硬件帧占用解码器固定大小的表面池）
+ *
+ * @note Demuxer 和 VideoDecoder 在倒放期间由工作线程使用，正向解封装 /
+ *       解码线程应暂停；两把锁保证停下之前的最后一次调用不会与之交叠
+ */
+class ReverseDecoder : public ReverseFrameSource {
+ public:
+  struct Options {
+    size_t max_bytes = 256 * 1024 * 1024;  // 所有帧块合计上限
+    size_t max_frames_per_chunk = 0;       // 0 表示不限制
+  };
+
+  /**
+   * @param demuxer_mutex 与正向解封装线程共用的 Demuxer 锁
+   * @param decoder_mutex 与正向解码线程共用的解码器锁
+   */
+  ReverseDecoder(Demuxer* demuxer,
+                 std::mutex* demuxer_mutex,
+                 VideoDecoder* decoder,
+                 std::mutex* decoder_mutex);
+  ~ReverseDecoder() override;
+
+  ReverseDecoder(const ReverseDecoder&) = delete;
+  ReverseDecoder& operator=(const ReverseDecoder&) = delete;
+
+  /**
+   * @brief 从指定位置开始向前（时间倒退方向）解码
+   * @param start_ms 起始位置（毫秒），第一块包含其之前的帧
+   */
+  Result<void> Start(int64_t start_ms, const Options& options);
+
+  /**
+   * @brief 停止工作线程并释放未取走的帧块
+   */
+  void Stop() override;
+
+  bool PopChunk(std::unique_ptr<FrameChunk>* chunk, int timeout_ms) override;
+
+  bool finished() const override {
+    return worker_done_.load() && chunk_queue_.Empty();
+  }
+
+ private:
+  void WorkerThread(int64_t start_pts);
+
+  /**
+   * @brief 解码 end_pts 之前最近的一段帧
+   * @param end_pts 上一块的第一帧 PTS（流时间基），本块只含更早的帧
+   */
+  Result<std::unique_ptr<FrameChunk>> DecodeChunkBefore(int64_t end_pts);
+
+  /**
+   * @brief 跳转到 target_us 之前的关键帧并解码到 end_pts
+   * @param chunk 输出：[关键帧, end_pts) 内的帧（超限时只保留末尾）
+   * @param truncated 输出：是否因超限丢弃了开头的帧
+   */
+  Result<void> DecodeRange(int64_t target_us,
+                           int64_t end_pts,
+                           FrameChunk* chunk,
+                           bool* truncated);
+
+  static size_t FrameBytes(const AVFrame* frame);
+
+  Demuxer* demuxer_;
+  std::mutex* demuxer_mutex_;
+  VideoDecoder* decoder_;
+  std::mutex* decoder_mutex_;
+
+  Options options_;
+  int stream_index_ = -1;
+  AVRational time_base_{1, 1000000};
+  int64_t stream_start_pts_ = 0;
+
+  std::unique_ptr<std::thread> worker_;
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> worker_done_{false};
+
+  // 就绪的帧块（容量 1：呈现方手中一块 + 队列中一块 + 工作线程一块）
+  BlockingQueue<std::unique_ptr<FrameChunk>> chunk_queue_{1};
+};
+
+}  // namespace zenplay
@@ -0,0 +1,262 @@
+#include "player/codec/seek_prefetcher.h"
+
+#include <chrono>
+#include <utility>
+
+#include "player/codec/video_decoder.h"
+#include "player/common/log_manager.h"
+#include "player/demuxer/demuxer.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace zenplay {
+
+namespace {
+
+int64_t FramePts(const AVFrame* frame) {
+  return frame->pts != AV_NOPTS_VALUE ? frame->pts
+                                      : frame->best_effort_timestamp;
+}
+
+}  // namespace
+
+SeekPrefetcher::SeekPrefetcher(std::string url, const Options& options)
+    : url_(std::move(url)),
+      options_(options),
+      demuxer_(std::make_unique<Demuxer>()),
+      decoder_(std::make_unique<VideoDecoder>()) {}
+
+SeekPrefetcher::~SeekPrefetcher() {
+  Stop();
+}
+
+void SeekPrefetcher::Request(int64_t timestamp_ms) {
+  if (timestamp_ms < 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_ || open_failed_) {
+      return;
+    }
+    if (ready_ && ready_->Covers(timestamp_ms)) {
+      pending_ms_ = kNoRequest;  // 已有覆盖这个位置的结果
+      return;
+    }
+    pending_ms_ = timestamp_ms;
+    if (!worker_) {
+      worker_ = std::make_unique<std::thread>(&SeekPrefetcher::WorkerThread,
+                                              this);
+    }
+  }
+  cv_.notify_one();
+}
+
+void SeekPrefetcher::Cancel() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ms_ = kNoRequest;
+  }
+  cv_.notify_one();
+}
+
+std::unique_ptr<SeekPrefetcher::Prefetch> SeekPrefetcher::Take(
+    int64_t timestamp_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!ready_ || !ready_->Covers(timestamp_ms)) {
+    return nullptr;
+  }
+  return std::move(ready_);
+}
+
+void SeekPrefetcher::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    pending_ms_ = kNoRequest;
+  }
+  cv_.notify_one();
+  // 工作线程可能阻塞在网络打开 / 读取中
+  demuxer_->Interrupt();
+  if (worker_ && worker_->joinable()) {
+    worker_->join();
+  }
+  worker_.reset();
+  ready_.reset();
+  decoder_->Close();
+  demuxer_->Close();
+}
+
+bool SeekPrefetcher::Superseded() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stop_ || pending_ms_ != kNoRequest;
+}
+
+void SeekPrefetcher::WorkerThread() {
+  const auto debounce = std::chrono::milliseconds(options_.debounce_ms);
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_) {
+    cv_.wait(lock, [this] { return stop_ || pending_ms_ != kNoRequest; });
+
+    // 鼠标仍在移动时不开始：位置在 debounce 时间内保持不变才预取
+    int64_t target_ms = pending_ms_;
+    while (!stop_ && target_ms != kNoRequest &&
+           cv_.wait_for(lock, debounce, [this, target_ms] {
+             return stop_ || pending_ms_ != target_ms;
+           })) {
+      target_ms = pending_ms_;
+    }
+    if (stop_ || target_ms == kNoRequest) {
+      continue;
+    }
+    pending_ms_ = kNoRequest;
+    lock.unlock();
+
+    auto open_result = EnsureOpened();
+    if (!open_result.IsOk()) {
+      MODULE_WARN(LOG_MODULE_DECODER, "Seek prefetch disabled: {}",
+                  open_result.FullMessage());
+      lock.lock();
+      open_failed_ = true;
+      break;
+    }
+
+    auto result = PrefetchAt(target_ms);
+    lock.lock();
+    if (result.IsOk()) {
+      ready_ = result.TakeValue();
+      MODULE_DEBUG(LOG_MODULE_DECODER,
+                   "Seek prefetch ready at {}ms: {} video / {} audio "
+                   "packets, {} frames",
+                   target_ms, ready_->video_packets.size(),
+                   ready_->audio_packets.size(), ready_->frames.size());
+    } else if (result.Code() != ErrorCode::kCancelled) {
+      MODULE_DEBUG(LOG_MODULE_DECODER, "Seek prefetch at {}ms skipped: {}",
+                   target_ms, result.FullMessage());
+    }
+  }
+}
+
+Result<void> SeekPrefetcher::EnsureOpened() {
+  if (decoder_->opened()) {
+    return Result<void>::Ok();
+  }
+
+  demuxer_->SetIoTimeouts(options_.open_timeout_ms, options_.io_timeout_ms);
+  auto result = demuxer_->Open(url_);
+  if (!result.IsOk()) {
+    return result;
+  }
+
+  AVStream* stream =
+      demuxer_->findStreamByIndex(demuxer_->active_video_stream_index());
+  if (!stream) {
+    return Result<void>::Err(ErrorCode::kStreamNotFound,
+                             "No video stream to prefetch");
+  }
+  // 软件解码：预解码的帧可以随时交给任何渲染器，也不占用硬件表面池
+  return decoder_->Open(stream->codecpar);
+}
+
+Result<std::unique_ptr<SeekPrefetcher::Prefetch>> SeekPrefetcher::PrefetchAt(
+    int64_t target_ms) {
+  using PrefetchResult = Result<std::unique_ptr<Prefetch>>;
+
+  auto prefetch = std::make_unique<Prefetch>();
+  prefetch->seek_us = target_ms * 1000;
+  prefetch->video_stream_index = demuxer_->active_video_stream_index();
+  prefetch->audio_stream_index = demuxer_->active_audio_stream_index();
+  prefetch->video_time_base =
+      demuxer_->findStreamByIndex(prefetch->video_stream_index)->time_base;
+
+  // 与播放控制器相同的跳转方式，两边落在同一个关键帧上
+  if (!demuxer_->Seek(prefetch->seek_us, true)) {
+    return PrefetchResult::Err(ErrorCode::kDemuxError,
+                               "Seek failed at " + std::to_string(target_ms));
+  }
+  decoder_->FlushBuffers();
+
+  bool done = false;
+  auto accept_frames = [&](std::vector<AVFramePtr>* frames) {
+    for (auto& frame : *frames) {
+      int64_t pts = FramePts(frame.get());
+      if (pts == AV_NOPTS_VALUE) {
+        continue;
+      }
+      int64_t pts_us = av_rescale_q(pts, prefetch->video_time_base,
+                                    AVRational{1, 1000000});
+      if (pts_us <= prefetch->seek_us) {
+        // 悬停位置之前的帧只保留最后一个（它的显示区间覆盖悬停位置）
+        prefetch->frames.clear();
+        prefetch->first_frame_us = pts_us;
+      } else if (prefetch->frames.size() >= options_.max_frames) {
+        done = true;
+        break;
+      } else if (prefetch->frames.empty()) {
+        prefetch->first_frame_us = pts_us;
+      }
+      prefetch->last_frame_us = pts_us;
+      prefetch->frames.push_back(std::move(frame));
+    }
+    frames->clear();
+  };
+
+  std::vector<AVFramePtr> frames;
+  while (!done) {
+    if (Superseded()) {
+      return PrefetchResult::Err(ErrorCode::kCancelled,
+                                 "Superseded by a newer position");
+    }
+
+    auto packet_result = demuxer_->ReadPacket();
+    if (!packet_result.IsOk()) {
+      return PrefetchResult::Err(packet_result.Code(),
+                                 packet_result.Message());
+    }
+
+    AVPacket* packet = packet_result.Value();
+    if (!packet) {
+      decoder_->Flush(&frames);  // EOF：取出解码器中剩余的帧
+      accept_frames(&frames);
+      break;
+    }
+
+    std::vector<AVPacket*>* packets = nullptr;
+    size_t max_packets = 0;
+    if (packet->stream_index == prefetch->video_stream_index) {
+      packets = &prefetch->video_packets;
+      max_packets = options_.max_video_packets;
+    } else if (packet->stream_index == prefetch->audio_stream_index) {
+      packets = &prefetch->audio_packets;
+      max_packets = options_.max_audio_packets;
+    } else {
+      av_packet_free(&packet);
+      continue;
+    }
+
+    // 点击时这些包要一次放进包队列：超出队列容量就放弃这个位置
+    if (packets->size() >= max_packets) {
+      av_packet_free(&packet);
+      return PrefetchResult::Err(
+          ErrorCode::kBufferTooSmall,
+          "Keyframe interval exceeds the packet queue capacity");
+    }
+    packets->push_back(packet);
+    if (packet->stream_index == prefetch->video_stream_index) {
+      decoder_->Decode(packet, &frames);
+      accept_frames(&frames);
+    }
+  }
+
+  if (prefetch->frames.empty()) {
+    return PrefetchResult::Err(ErrorCode::kDecoderError,
+                               "No frames decoded after the keyframe");
+  }
+  return PrefetchResult::Ok(std::move(prefetch));
+}
+
+}  // namespace zenplay
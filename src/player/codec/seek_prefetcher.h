@@ -0,0 +1,164 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "player/common/common_def.h"
+#include "player/common/error.h"
+
+extern "C" {
+#include <libavcodec/packet.h>
+#include <libavutil/rational.h>
+}
+
+namespace zenplay {
+
+class Demuxer;
+class VideoDecoder;
+
+/**
+ * @brief 悬停预取结果的来源（播放控制只依赖这一接口）
+ */
+class SeekPrefetchSource {
+ public:
+  /**
+   * @brief 一次预取的结果
+   *
+   * 包按读出顺序排列；帧按 PTS 升序，第一帧是显示区间覆盖悬停位置的帧。
+   */
+  struct Prefetch {
+    Prefetch() = default;
+    ~Prefetch() {
+      for (AVPacket* packet : video_packets) {
+        av_packet_free(&packet);
+      }
+      for (AVPacket* packet : audio_packets) {
+        av_packet_free(&packet);
+      }
+    }
+    Prefetch(const Prefetch&) = delete;
+    Prefetch& operator=(const Prefetch&) = delete;
+
+    /**
+     * @brief 在 timestamp_ms 点击能否直接使用这次预取
+     */
+    bool Covers(int64_t timestamp_ms) const {
+      int64_t timestamp_us = timestamp_ms * 1000;
+      return !frames.empty() && first_frame_us <= timestamp_us &&
+             timestamp_us <= last_frame_us;
+    }
+
+    int64_t seek_us = 0;  // 悬停位置，也是 Demuxer Seek 的目标
+    int video_stream_index = -1;
+    int audio_stream_index = -1;
+    AVRational video_time_base{1, 1000000};
+    std::vector<AVPacket*> video_packets;  // 拥有所有权
+    std::vector<AVPacket*> audio_packets;  // 拥有所有权
+    std::vector<AVFramePtr> frames;
+    int64_t first_frame_us = 0;  // frames 覆盖的区间
+    int64_t last_frame_us = 0;
+  };
+
+  virtual ~SeekPrefetchSource() = default;
+
+  /**
+   * @brief 悬停在 timestamp_ms：替换尚未开始的预取请求
+   */
+  virtual void Request(int64_t timestamp_ms) = 0;
+
+  /**
+   * @brief 丢弃尚未完成的预取请求（已就绪的结果保留）
+   */
+  virtual void Cancel() = 0;
+
+  /**
+   * @brief 取走覆盖 timestamp_ms 的预取结果
+   * @return 没有可用结果时返回 nullptr
+   */
+  virtual std::unique_ptr<Prefetch> Take(int64_t timestamp_ms) = 0;
+};
+
+/**
+ * @brief 悬停预取：鼠标停在进度条某个位置时，提前在后台完成到这个位置
+ *        的 Seek
+ *
+ * 工作线程使用独立的 Demuxer（同一 URL，首次预取时才打开）和软件
+ * VideoDecoder：跳转到悬停位置之前的关键帧，读出从关键帧开始的视频 /
+ * 音频包，并解码出悬停位置起的前几帧。随后在这个位置点击时，播放控制器
+ * 直接把这些包和帧放入队列，不再等待 Seek 和从关键帧开始的解码。
+ *
+ * - 悬停位置连续变化时只预取最新的一个，且要停留 debounce_ms 才开始
+ * - 只保留最近一次预取的结果；进行中的预取被新位置打断
+ * - 包数超过队列容量（max_*_packets）时放弃这个位置
+ */
+class SeekPrefetcher : public SeekPrefetchSource {
+ public:
+  struct Options {
+    size_t max_frames = 8;            // 悬停位置起预解码的帧数
+    size_t max_video_packets = 256;   // 关键帧到最后一帧的视频包上限
+    size_t max_audio_packets = 512;   // 同一区间的音频包上限
+    int64_t debounce_ms = 150;        // 悬停停留多久才开始预取
+    int64_t open_timeout_ms = 15000;  // 网络流打开超时
+    int64_t io_timeout_ms = 5000;     // 网络流单次读取超时
+  };
+
+  SeekPrefetcher(std::string url, const Options& options);
+  ~SeekPrefetcher() override;
+
+  SeekPrefetcher(const SeekPrefetcher&) = delete;
+  SeekPrefetcher& operator=(const SeekPrefetcher&) = delete;
+
+  /**
+   * @note 线程安全；首次调用时启动工作线程
+   */
+  void Request(int64_t timestamp_ms) override;
+
+  void Cancel() override;
+
+  std::unique_ptr<Prefetch> Take(int64_t timestamp_ms) override;
+
+  /**
+   * @brief 停止工作线程并关闭独立的 Demuxer / 解码器
+   */
+  void Stop();
+
+ private:
+  static constexpr int64_t kNoRequest = -1;
+
+  void WorkerThread();
+
+  /**
+   * @brief 打开独立的 Demuxer 和解码器（只在工作线程调用）
+   */
+  Result<void> EnsureOpened();
+
+  /**
+   * @brief 跳转到 target_ms 之前的关键帧，读包并解码到悬停位置之后
+   */
+  Result<std::unique_ptr<Prefetch>> PrefetchAt(int64_t target_ms);
+
+  // 有新的悬停位置或正在停止：放弃进行中的预取
+  bool Superseded();
+
+  const std::string url_;
+  const Options options_;
+
+  std::unique_ptr<Demuxer> demuxer_;
+  std::unique_ptr<VideoDecoder> decoder_;
+  bool open_failed_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int64_t pending_ms_ = kNoRequest;
+  bool stop_ = false;
+  std::unique_ptr<Prefetch> ready_;
+  std::unique_ptr<std::thread> worker_;
+};
+
+}  // namespace zenplay
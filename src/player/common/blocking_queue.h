@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace zenplay {
 
@@ -17,6 +19,8 @@ namespace zenplay {
  * - 阻塞/超时操作：支持阻塞式和超时式 Push/Pop
  * - 优雅关闭：Stop() 后唤醒所有等待线程并拒绝新操作
  * - 高效唤醒：使用两个条件变量分别通知生产者/消费者
+ * - 批量操作：PushBatch(For) / PopBatch / DrainAll 一次加锁、一次唤醒处理多个
+ *   元素，适用于突发生产（Seek 后的预读、解码器 Flush）
  *
  * 使用场景：
  * - 解码线程生产帧，渲染线程消费帧
@@ -236,6 +240,125 @@ class BlockingQueue {
     return true;
   }
 
+  // ========================================
+  // 批量操作
+  // ========================================
+
+  /**
+   * @brief 按顺序批量推入元素（阻塞版本）
+   *
+   * 每次获得空间时在一次加锁内推入尽可能多的元素，并只唤醒一次消费者；
+   * 队列满时阻塞，直到全部推入或队列被停止
+   *
+   * @param items 要推入的元素，成功推入的元素从头部移除
+   * @return 成功推入的个数；items 不为空表示队列已停止，未推入的元素
+   *         仍在 items 中，由调用方处理
+   */
+  size_t PushBatch(std::vector<T>& items) {
+    size_t pushed = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pushed < items.size()) {
+      not_full_cv_.wait(lock, [this] {
+        return stopped_ || (max_size_ == 0 || queue_.size() < max_size_);
+      });
+      if (stopped_) {
+        break;
+      }
+
+      size_t batch_start = pushed;
+      while (pushed < items.size() &&
+             (max_size_ == 0 || queue_.size() < max_size_)) {
+        queue_.push_back(std::move(items[pushed]));
+        ++pushed;
+      }
+      NotifyConsumers(pushed - batch_start);
+    }
+    items.erase(items.begin(), items.begin() + pushed);
+    return pushed;
+  }
+
+  /**
+   * @brief 按顺序批量推入元素（超时、可取消版本）
+   *
+   * 与 PushBatch 相同，但最多等待 timeout_ms，并在每次推入前于队列锁内
+   * 检查 cancelled()，返回 true 时立即停止。调用方先修改 cancelled()
+   * 依赖的状态、再调用 Clear() 时，Clear() 之后不会再有已取消的元素
+   * 进入队列（Clear() 同时唤醒阻塞在这里的生产者）
+   *
+   * @param items 要推入的元素，成功推入的元素从头部移除
+   * @param timeout_ms 超时时间（毫秒），0 表示不等待，负数表示一直等待
+   * @param cancelled 取消条件，持有队列锁时调用，不能再访问本队列
+   * @return 成功推入的个数；未推入的元素仍在 items 中，由调用方处理
+   */
+  template <typename CancelFunc>
+  size_t PushBatchFor(std::vector<T>& items,
+                      int64_t timeout_ms,
+                      CancelFunc cancelled) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(std::max<int64_t>(0, timeout_ms));
+    auto ready = [this, &cancelled] {
+      return stopped_ || cancelled() ||
+             (max_size_ == 0 || queue_.size() < max_size_);
+    };
+
+    size_t pushed = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pushed < items.size()) {
+      if (timeout_ms < 0) {
+        not_full_cv_.wait(lock, ready);
+      } else if (!not_full_cv_.wait_until(lock, deadline, ready)) {
+        break;
+      }
+      if (stopped_ || cancelled()) {
+        break;
+      }
+
+      size_t batch_start = pushed;
+      while (pushed < items.size() &&
+             (max_size_ == 0 || queue_.size() < max_size_)) {
+        queue_.push_back(std::move(items[pushed]));
+        ++pushed;
+      }
+      NotifyConsumers(pushed - batch_start);
+    }
+    items.erase(items.begin(), items.begin() + pushed);
+    return pushed;
+  }
+
+  /**
+   * @brief 批量弹出元素（超时版本）
+   *
+   * 等待直到队列非空，然后在一次加锁内弹出至多 max_n 个元素
+   *
+   * @param out 输出参数，弹出的元素追加到末尾
+   * @param max_n 最多弹出的个数
+   * @param timeout_ms 超时时间（毫秒），0 表示不等待
+   * @return 弹出的个数，0 表示超时或队列已停止且为空
+   */
+  size_t PopBatch(std::vector<T>& out, size_t max_n, int64_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    not_empty_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                           [this] { return stopped_ || !queue_.empty(); });
+
+    size_t count = std::min(max_n, queue_.size());
+    MoveFront_Locked(out, count);
+    return count;
+  }
+
+  /**
+   * @brief 非阻塞地取出队列中的全部元素
+   *
+   * @param out 输出参数，取出的元素按顺序追加到末尾
+   * @return 取出的个数
+   */
+  size_t DrainAll(std::vector<T>& out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t count = queue_.size();
+    MoveFront_Locked(out, count);
+    return count;
+  }
+
   /**
    * @brief 停止队列，唤醒所有等待的线程
    *
@@ -335,9 +458,48 @@ class BlockingQueue {
   /**
    * @brief 获取队列最大容量
    */
-  size_t MaxSize() const { return max_size_; }
+  size_t MaxSize() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return max_size_;
+  }
+
+  /**
+   * @brief 调整队列最大容量（0 表示无限制）
+   * @note 已在队列中的元素不会被丢弃；容量变大时唤醒阻塞的生产者
+   */
+  void SetMaxSize(size_t max_size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    max_size_ = max_size;
+    not_full_cv_.notify_all();
+  }
 
  private:
+  // 推入 count 个元素后唤醒消费者（多个元素时可能有多个消费者可以工作）
+  void NotifyConsumers(size_t count) {
+    if (count == 1) {
+      not_empty_cv_.notify_one();
+    } else if (count > 1) {
+      not_empty_cv_.notify_all();
+    }
+  }
+
+  // 从队头移出 count 个元素并唤醒生产者（调用方持有 mutex_）
+  void MoveFront_Locked(std::vector<T>& out, size_t count) {
+    if (count == 0) {
+      return;
+    }
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+      out.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    if (count == 1) {
+      not_full_cv_.notify_one();
+    } else {
+      not_full_cv_.notify_all();
+    }
+  }
+
   mutable std::mutex mutex_;
   std::condition_variable not_empty_cv_;  // 队列非空条件变量（消费者等待）
   std::condition_variable not_full_cv_;   // 队列未满条件变量（生产者等待）
@@ -48,7 +48,9 @@ struct MediaFrame {
   AVFramePtr frame;                                    // FFmpeg 解码后的帧
   MediaTimestamp timestamp;                            // 时间戳信息
   std::chrono::steady_clock::time_point receive_time;  // 接收时间
+  double duration_ms = 0.0;                            // 帧时长，0 表示未知
 
+  MediaFrame() = default;  // 空槽位（预分配的帧队列）
   MediaFrame(AVFramePtr f, const MediaTimestamp& ts)
       : frame(std::move(f)),
         timestamp(ts),
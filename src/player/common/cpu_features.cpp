@@ -0,0 +1,73 @@
+#include "player/common/cpu_features.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(ZENPLAY_ARCH_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace zenplay {
+
+namespace {
+
+#if defined(ZENPLAY_ARCH_X86) && defined(_MSC_VER)
+// MSVC 没有 __builtin_cpu_supports，直接读取 CPUID
+bool CheckOsAvxSupport() {
+  int info[4];
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  if (!osxsave) {
+    return false;
+  }
+  // XCR0: bit 1 = SSE 状态, bit 2 = AVX 状态，由操作系统负责保存
+  return (_xgetbv(0) & 0x6) == 0x6;
+}
+#endif
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features;
+
+  const char* disable = std::getenv("ZENPLAY_DISABLE_SIMD");
+  if (disable && std::strcmp(disable, "1") == 0) {
+    return features;
+  }
+
+#if defined(ZENPLAY_ARCH_X86)
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  features.sse2 = (info[3] & (1 << 26)) != 0;
+  features.ssse3 = (info[2] & (1 << 9)) != 0;
+  features.sse41 = (info[2] & (1 << 19)) != 0;
+
+  if (max_leaf >= 7 && CheckOsAvxSupport()) {
+    __cpuidex(info, 7, 0);
+    features.avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  features.sse2 = __builtin_cpu_supports("sse2");
+  features.ssse3 = __builtin_cpu_supports("ssse3");
+  features.sse41 = __builtin_cpu_supports("sse4.1");
+  features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+#elif defined(ZENPLAY_ARCH_ARM64)
+  // AArch64 必定支持 NEON
+  features.neon = true;
+#endif
+
+  return features;
+}
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+  static const CpuFeatures features = DetectCpuFeatures();
+  return features;
+}
+
+}  // namespace zenplay
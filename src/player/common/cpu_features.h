@@ -0,0 +1,53 @@
+/**
+ * @file cpu_features.h
+ * @brief 运行时 CPU 指令集检测
+ *
+ * 项目不为单个源文件单独设置 -mavx2 等编译选项，SIMD 代码通过
+ * ZENPLAY_TARGET_AVX2 等属性为单个函数启用指令集，再根据
+ * GetCpuFeatures() 的检测结果在运行时选择实现。
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define ZENPLAY_ARCH_X86 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define ZENPLAY_ARCH_ARM64 1
+#endif
+
+// GCC/Clang 需要为使用 AVX2 intrinsics 的函数显式开启目标指令集；
+// MSVC 无需任何属性即可使用全部 intrinsics
+#if defined(ZENPLAY_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ZENPLAY_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define ZENPLAY_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define ZENPLAY_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ZENPLAY_TARGET_SSSE3
+#define ZENPLAY_TARGET_SSE41
+#define ZENPLAY_TARGET_AVX2
+#endif
+
+namespace zenplay {
+
+/**
+ * @brief CPU 支持的 SIMD 指令集
+ */
+struct CpuFeatures {
+  bool sse2 = false;
+  bool ssse3 = false;
+  bool sse41 = false;
+  bool avx2 = false;
+  bool neon = false;
+};
+
+/**
+ * @brief 获取当前 CPU 支持的指令集（首次调用时检测，之后返回缓存结果）
+ *
+ * 设置环境变量 ZENPLAY_DISABLE_SIMD=1 可以强制走标量实现，便于对比测试。
+ */
+const CpuFeatures& GetCpuFeatures();
+
+}  // namespace zenplay
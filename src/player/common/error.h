@@ -87,6 +87,7 @@ enum class ErrorCode : int {
   kInternalError = 704,   ///< 内部错误
   kBufferTooSmall = 705,  ///< 缓冲区太小
   kNotSupported = 706,    ///< 不支持的操作
+  kCancelled = 707,       ///< 操作被取消（停止 / Seek 打断）
 };
 
 /**
@@ -209,6 +210,8 @@ inline const char* ErrorCodeToString(ErrorCode code) {
       return "BufferTooSmall";
     case ErrorCode::kNotSupported:
       return "NotSupported";
+    case ErrorCode::kCancelled:
+      return "Cancelled";
 
     default:
       return "UnknownErrorCode";
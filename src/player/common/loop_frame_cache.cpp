@@ -0,0 +1,220 @@
+#include "player/common/loop_frame_cache.h"
+
+#include "player/common/log_manager.h"
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+namespace zenplay {
+
+LoopFrameCache::LoopFrameCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+LoopFrameCache::~LoopFrameCache() {
+  Clear();
+}
+
+void LoopFrameCache::Reset(int64_t start_ms, int64_t end_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  video_frames_.clear();
+  audio_frames_.clear();
+  bytes_used_ = 0;
+  overflowed_ = false;
+  video_complete_ = false;
+  audio_complete_ = false;
+  start_ms_ = start_ms;
+  end_ms_ = end_ms;
+}
+
+void LoopFrameCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  video_frames_.clear();
+  audio_frames_.clear();
+  bytes_used_ = 0;
+}
+
+LoopFrameCache::AddResult LoopFrameCache::AddVideoFrame(
+    const AVFrame* frame,
+    const MediaTimestamp& timestamp) {
+  double pts_ms = timestamp.ToMilliseconds();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (video_complete_ || pts_ms >= static_cast<double>(end_ms_)) {
+    video_complete_ = true;
+    return AddResult::kPastEnd;
+  }
+  if (overflowed_) {
+    return AddResult::kOverflow;
+  }
+  if (pts_ms < static_cast<double>(start_ms_)) {
+    return AddResult::kBeforeStart;
+  }
+
+  // 硬件帧引用的是解码器固定大小的表面池，长时间持有会让解码器饿死
+  if (frame->hw_frames_ctx) {
+    Invalidate_Locked("hardware frames cannot be retained");
+    return AddResult::kOverflow;
+  }
+
+  size_t bytes = FrameBytes(frame);
+  if (bytes_used_ + bytes > max_bytes_) {
+    Invalidate_Locked("memory cap reached");
+    return AddResult::kOverflow;
+  }
+
+  AVFramePtr ref(av_frame_clone(frame));
+  if (!ref) {
+    Invalidate_Locked("av_frame_clone failed");
+    return AddResult::kOverflow;
+  }
+
+  VideoEntry entry;
+  entry.frame = std::move(ref);
+  entry.timestamp = timestamp;
+  entry.pts_ms = pts_ms;
+  video_frames_.push_back(std::move(entry));
+  bytes_used_ += bytes;
+  return AddResult::kCached;
+}
+
+LoopFrameCache::AddResult LoopFrameCache::AddAudioFrame(
+    const ResampledAudioFrame& frame) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (audio_complete_ || frame.pts_ms >= end_ms_) {
+    audio_complete_ = true;
+    return AddResult::kPastEnd;
+  }
+  if (overflowed_) {
+    return AddResult::kOverflow;
+  }
+  // 跨越 A 点的帧也要缓存，否则每轮开头会缺一小段声音
+  if (frame.pts_ms + frame.GetDurationMs() <= static_cast<double>(start_ms_)) {
+    return AddResult::kBeforeStart;
+  }
+
+  size_t bytes = frame.GetDataSize();
+  if (bytes_used_ + bytes > max_bytes_) {
+    Invalidate_Locked("memory cap reached");
+    return AddResult::kOverflow;
+  }
+
+  audio_frames_.push_back(frame);
+  bytes_used_ += bytes;
+  return AddResult::kCached;
+}
+
+void LoopFrameCache::MarkVideoComplete() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  video_complete_ = true;
+}
+
+void LoopFrameCache::MarkAudioComplete() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  audio_complete_ = true;
+}
+
+bool LoopFrameCache::IsComplete(bool need_video, bool need_audio) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return (!need_video || video_complete_) && (!need_audio || audio_complete_);
+}
+
+bool LoopFrameCache::IsReplayable(bool need_video, bool need_audio) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (overflowed_) {
+    return false;
+  }
+  if (need_video && (!video_complete_ || video_frames_.empty())) {
+    return false;
+  }
+  if (need_audio && (!audio_complete_ || audio_frames_.empty())) {
+    return false;
+  }
+  return need_video || need_audio;
+}
+
+bool LoopFrameCache::overflowed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return overflowed_;
+}
+
+size_t LoopFrameCache::bytes_used() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_used_;
+}
+
+size_t LoopFrameCache::video_frame_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return video_frames_.size();
+}
+
+size_t LoopFrameCache::audio_frame_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return audio_frames_.size();
+}
+
+double LoopFrameCache::VideoFramePtsMs(size_t index) const {
+  return video_frames_[index].pts_ms;
+}
+
+int64_t LoopFrameCache::AudioFramePtsMs(size_t index) const {
+  return audio_frames_[index].pts_ms;
+}
+
+AVFramePtr LoopFrameCache::MakeVideoFrame(size_t index,
+                                          int64_t iteration,
+                                          MediaTimestamp* timestamp) const {
+  const VideoEntry& entry = video_frames_[index];
+  AVFramePtr frame(av_frame_clone(entry.frame.get()));
+  if (!frame) {
+    return nullptr;
+  }
+
+  *timestamp = entry.timestamp;
+  int64_t offset = av_rescale_q(iteration * period_ms(), AVRational{1, 1000},
+                                entry.timestamp.time_base);
+  if (timestamp->pts != AV_NOPTS_VALUE) {
+    timestamp->pts += offset;
+  }
+  if (timestamp->dts != AV_NOPTS_VALUE) {
+    timestamp->dts += offset;
+  }
+  if (frame->pts != AV_NOPTS_VALUE) {
+    frame->pts += offset;
+  }
+  if (frame->pkt_dts != AV_NOPTS_VALUE) {
+    frame->pkt_dts += offset;
+  }
+  return frame;
+}
+
+ResampledAudioFrame LoopFrameCache::MakeAudioFrame(size_t index,
+                                                   int64_t iteration) const {
+  ResampledAudioFrame frame = audio_frames_[index];
+  frame.pts_ms += iteration * period_ms();
+  return frame;
+}
+
+size_t LoopFrameCache::FrameBytes(const AVFrame* frame) {
+  size_t bytes = 0;
+  for (int i = 0; i < AV_NUM_DATA_POINTERS && frame->buf[i]; ++i) {
+    bytes += frame->buf[i]->size;
+  }
+  for (int i = 0; i < frame->nb_extended_buf; ++i) {
+    bytes += frame->extended_buf[i]->size;
+  }
+  return bytes;
+}
+
+void LoopFrameCache::Invalidate_Locked(const char* reason) {
+  MODULE_WARN(LOG_MODULE_PLAYER,
+              "A-B loop cache disabled ({}), {} video / {} audio frames, "
+              "{} MB released",
+              reason, video_frames_.size(), audio_frames_.size(),
+              bytes_used_ / (1024 * 1024));
+  overflowed_ = true;
+  video_frames_.clear();
+  audio_frames_.clear();
+  bytes_used_ = 0;
+}
+
+}  // namespace zenplay
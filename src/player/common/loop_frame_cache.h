@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "player/audio/resampled_audio_frame.h"
+#include "player/common/common_def.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief A-B 循环区间的解码帧缓存
+ *
+ * 第一遍播放循环区间时，解码线程把区间内的视频帧（AVFrame 引用）和
+ * 重采样后的 PCM 存入缓存；两路都到达 B 点后缓存即完整，之后每一轮
+ * 循环直接从内存取帧，不再 Seek / 解码。
+ *
+ * 回放时时间戳按轮次单调递增（第 n 轮 = 原始 PTS + n × 区间长度），
+ * 时钟不会回跳，音视频同步和渲染逻辑无需感知循环。
+ *
+ * 超出内存上限或遇到硬件帧（占用解码器的固定表面池）时缓存失效，
+ * 调用方退回到每轮 Seek 的方式。
+ *
+ * @note Add* / Mark* 可在不同解码线程并发调用；
+ *       Make* 只能在缓存完整后调用（此后内容不再变化）
+ */
+class LoopFrameCache {
+ public:
+  /**
+   * @brief 添加帧的结果
+   */
+  enum class AddResult {
+    kCached,       // 已缓存
+    kBeforeStart,  // 在 A 点之前（Seek 落在 A 之前的关键帧），照常显示
+    kPastEnd,      // 已到达 B 点，该路第一遍结束（自动标记完成）
+    kOverflow,     // 缓存已失效（超出上限或不支持），照常显示
+  };
+
+  explicit LoopFrameCache(size_t max_bytes);
+  ~LoopFrameCache();
+
+  LoopFrameCache(const LoopFrameCache&) = delete;
+  LoopFrameCache& operator=(const LoopFrameCache&) = delete;
+
+  /**
+   * @brief 清空缓存并设置新的循环区间
+   * @param start_ms A 点（毫秒）
+   * @param end_ms B 点（毫秒），必须大于 start_ms
+   */
+  void Reset(int64_t start_ms, int64_t end_ms);
+
+  /**
+   * @brief 释放所有缓存的帧
+   */
+  void Clear();
+
+  /**
+   * @brief 缓存一帧视频（增加引用，不拷贝像素）
+   */
+  AddResult AddVideoFrame(const AVFrame* frame,
+                          const MediaTimestamp& timestamp);
+
+  /**
+   * @brief 缓存一帧重采样后的音频（拷贝 PCM）
+   */
+  AddResult AddAudioFrame(const ResampledAudioFrame& frame);
+
+  /**
+   * @brief 标记某一路第一遍结束（B 点在文件末尾之后，遇到 EOF）
+   */
+  void MarkVideoComplete();
+  void MarkAudioComplete();
+
+  /**
+   * @brief 所需的各路是否都已结束第一遍
+   */
+  bool IsComplete(bool need_video, bool need_audio) const;
+
+  /**
+   * @brief 缓存是否可用于回放（完整且未失效）
+   */
+  bool IsReplayable(bool need_video, bool need_audio) const;
+
+  bool overflowed() const;
+  size_t bytes_used() const;
+  size_t max_bytes() const { return max_bytes_; }
+  int64_t start_ms() const { return start_ms_; }
+  int64_t end_ms() const { return end_ms_; }
+  int64_t period_ms() const { return end_ms_ - start_ms_; }
+
+  size_t video_frame_count() const;
+  size_t audio_frame_count() const;
+
+  /**
+   * @brief 第 index 个视频帧的原始 PTS（毫秒），用于回放时按时间交错
+   */
+  double VideoFramePtsMs(size_t index) const;
+  int64_t AudioFramePtsMs(size_t index) const;
+
+  /**
+   * @brief 生成第 iteration 轮的视频帧（新引用，PTS 已偏移）
+   * @param timestamp 输出：偏移后的时间戳
+   */
+  AVFramePtr MakeVideoFrame(size_t index,
+                            int64_t iteration,
+                            MediaTimestamp* timestamp) const;
+
+  /**
+   * @brief 生成第 iteration 轮的音频帧（拷贝，PTS 已偏移）
+   */
+  ResampledAudioFrame MakeAudioFrame(size_t index, int64_t iteration) const;
+
+ private:
+  struct VideoEntry {
+    AVFramePtr frame;
+    MediaTimestamp timestamp;
+    double pts_ms = 0.0;
+  };
+
+  static size_t FrameBytes(const AVFrame* frame);
+  void Invalidate_Locked(const char* reason);
+
+  const size_t max_bytes_;
+  int64_t start_ms_ = 0;
+  int64_t end_ms_ = 0;
+
+  mutable std::mutex mutex_;
+  std::vector<VideoEntry> video_frames_;
+  std::vector<ResampledAudioFrame> audio_frames_;
+  size_t bytes_used_ = 0;
+  bool overflowed_ = false;
+  bool video_complete_ = false;
+  bool audio_complete_ = false;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,229 @@
+#include "player/common/pipeline_watchdog.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "player/common/timer.h"
+#include "player/stats/statistics_manager.h"
+
+namespace zenplay {
+
+uint32_t PipelineWatchdog::Snapshot::stalled_mask() const {
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kStageCount; ++i) {
+    if (stages[i].stalled) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+}
+
+std::string PipelineWatchdog::Snapshot::ToString() const {
+  std::ostringstream out;
+  out << "state=" << state << ", clock=" << clock_ms << "ms";
+  for (size_t i = 0; i < kStageCount; ++i) {
+    const StageSnapshot& stage = stages[i];
+    if (!stage.enabled) {
+      continue;
+    }
+    out << "\n  " << StageName(static_cast<Stage>(i)) << ": ";
+    if (stage.stalled) {
+      out << "STALLED, ";
+    } else if (stage.finished) {
+      out << "finished, ";
+    } else if (stage.idle) {
+      out << "idle, ";
+    }
+    out << "last progress " << stage.since_last_beat_ms << "ms ago";
+    out << ", last pts ";
+    if (stage.last_pts_ms >= 0) {
+      out << stage.last_pts_ms << "ms";
+    } else {
+      out << "n/a";
+    }
+    out << ", beats " << stage.beats;
+    out << ", input queue ";
+    if (stage.input_depth >= 0) {
+      out << stage.input_depth;
+    } else {
+      out << "n/a";
+    }
+  }
+  return out.str();
+}
+
+PipelineWatchdog::PipelineWatchdog(const Options& options)
+    : options_(options) {
+  RearmAt(std::chrono::steady_clock::now());
+}
+
+PipelineWatchdog::~PipelineWatchdog() {
+  Stop();
+}
+
+const char* PipelineWatchdog::StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kDemux:
+      return "Demux";
+    case Stage::kVideoDecode:
+      return "VideoDecode";
+    case Stage::kAudioDecode:
+      return "AudioDecode";
+    case Stage::kVideoRender:
+      return "VideoRender";
+    case Stage::kAudioOutput:
+      return "AudioOutput";
+    default:
+      return "Unknown";
+  }
+}
+
+void PipelineWatchdog::Start(ContextProvider provider,
+                             StallCallback on_stall) {
+  Stop();
+  provider_ = std::move(provider);
+  on_stall_ = std::move(on_stall);
+  timer_ = TimerFactory::CreateRepeating(
+      static_cast<int>(std::max<int64_t>(options_.check_interval_ms, 1)),
+      [this]() { OnTimer(); });
+  if (timer_) {
+    timer_->Start();
+  }
+}
+
+void PipelineWatchdog::Stop() {
+  if (timer_) {
+    timer_->Stop();
+    timer_.reset();
+  }
+}
+
+void PipelineWatchdog::Suspend() {
+  if (!timer_ || !timer_->IsRunning()) {
+    return;
+  }
+  timer_->Stop();
+
+  // 与离开播放状态相同：恢复后的第一次检查重新计时
+  std::lock_guard<std::mutex> lock(check_mutex_);
+  was_playing_ = false;
+  reported_mask_ = 0;
+}
+
+void PipelineWatchdog::Resume() {
+  if (timer_ && !timer_->IsRunning()) {
+    timer_->Start();
+  }
+}
+
+void PipelineWatchdog::EnableStage(Stage stage) {
+  StageState& state = stages_[static_cast<size_t>(stage)];
+  state.last_beat_ns.store(ToNs(std::chrono::steady_clock::now()));
+  state.enabled.store(true);
+}
+
+void PipelineWatchdog::Heartbeat(Stage stage, int64_t pts_ms) {
+  StageState& state = stages_[static_cast<size_t>(stage)];
+  state.last_beat_ns.store(ToNs(std::chrono::steady_clock::now()),
+                           std::memory_order_relaxed);
+  if (pts_ms >= 0) {
+    state.last_pts_ms.store(pts_ms, std::memory_order_relaxed);
+  }
+  state.beats.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PipelineWatchdog::MarkFinished(Stage stage) {
+  stages_[static_cast<size_t>(stage)].finished.store(true);
+}
+
+void PipelineWatchdog::SetIdle(Stage stage, bool idle) {
+  StageState& state = stages_[static_cast<size_t>(stage)];
+  // 空闲结束时重新计时，等待期间不算无进度
+  state.last_beat_ns.store(ToNs(std::chrono::steady_clock::now()));
+  state.idle.store(idle);
+}
+
+void PipelineWatchdog::Rearm() {
+  RearmAt(std::chrono::steady_clock::now());
+}
+
+void PipelineWatchdog::RearmAt(std::chrono::steady_clock::time_point now) {
+  int64_t now_ns = ToNs(now);
+  for (StageState& state : stages_) {
+    state.finished.store(false);
+    state.last_beat_ns.store(now_ns);
+  }
+}
+
+std::optional<PipelineWatchdog::Snapshot> PipelineWatchdog::Check(
+    const PipelineContext& context,
+    std::chrono::steady_clock::time_point now) {
+  std::lock_guard<std::mutex> lock(check_mutex_);
+
+  // 离开播放状态期间没有进度是正常的，回到播放后重新计时
+  if (!context.playing) {
+    was_playing_ = false;
+    reported_mask_ = 0;
+    return std::nullopt;
+  }
+  if (!was_playing_) {
+    was_playing_ = true;
+    int64_t now_ns = ToNs(now);
+    for (StageState& state : stages_) {
+      state.last_beat_ns.store(now_ns);
+    }
+    return std::nullopt;
+  }
+
+  Snapshot snapshot;
+  snapshot.state = context.state;
+  snapshot.clock_ms = context.clock_ms;
+
+  int64_t now_ns = ToNs(now);
+  for (size_t i = 0; i < kStageCount; ++i) {
+    const StageState& state = stages_[i];
+    StageSnapshot& stage = snapshot.stages[i];
+    stage.enabled = state.enabled.load();
+    stage.finished = state.finished.load();
+    stage.idle = state.idle.load();
+    stage.beats = state.beats.load(std::memory_order_relaxed);
+    stage.last_pts_ms = state.last_pts_ms.load(std::memory_order_relaxed);
+    stage.since_last_beat_ms =
+        std::max<int64_t>(0, (now_ns - state.last_beat_ns.load()) / 1000000);
+    stage.input_depth = context.input_depths[i];
+
+    bool has_input = static_cast<Stage>(i) == Stage::kDemux ||
+                     stage.input_depth != 0;
+    stage.stalled = stage.enabled && !stage.finished && !stage.idle &&
+                    has_input &&
+                    stage.since_last_beat_ms >= options_.stall_threshold_ms;
+  }
+
+  // 只报告新出现的卡死；已恢复的阶段清除标记
+  uint32_t stalled = snapshot.stalled_mask();
+  uint32_t new_stalls = stalled & ~reported_mask_;
+  reported_mask_ = stalled;
+  if (new_stalls == 0) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+int64_t PipelineWatchdog::ToNs(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void PipelineWatchdog::OnTimer() {
+  STATS_COUNT_WAKEUP(kWatchdog);
+  if (!provider_) {
+    return;
+  }
+  auto snapshot = Check(provider_(), std::chrono::steady_clock::now());
+  if (snapshot && on_stall_) {
+    on_stall_(*snapshot);
+  }
+}
+
+}  // namespace zenplay
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace zenplay {
+
+class Timer;
+
+/**
+ * @brief 播放流水线卡死检测
+ *
+ * 各阶段（解封装、解码、渲染、音频输出）每处理完一个包 / 帧调用一次
+ * Heartbeat()，记录进度时刻和 PTS（只写原子变量，可在音频回调中调用）。
+ * 定时检查时，若某阶段超过阈值没有进度、且输入队列中仍有待处理的数据，
+ * 即判定为卡死，生成包含所有阶段进度、队列深度和播放状态的快照。
+ *
+ * 判定规则：
+ * - 只在播放状态下检查；离开播放状态后重新计时（暂停不算卡死）
+ * - 输入队列为空的阶段是在等上游（饥饿），不算卡死；解封装没有上游，
+ *   只要没有结束就应有进度
+ * - 已结束（EOF）或主动空闲（A-B 缓存回放、倒放时的解封装）的阶段跳过
+ * - 同一次卡死只报告一次，恢复后再次卡死会重新报告
+ */
+class PipelineWatchdog {
+ public:
+  enum class Stage {
+    kDemux = 0,
+    kVideoDecode,
+    kAudioDecode,
+    kVideoRender,
+    kAudioOutput,
+    kCount
+  };
+
+  static constexpr size_t kStageCount = static_cast<size_t>(Stage::kCount);
+
+  struct Options {
+    int64_t stall_threshold_ms = 3000;  // 无进度多久判定为卡死
+    int64_t check_interval_ms = 500;    // 检查间隔
+  };
+
+  /**
+   * @brief 检查时由调用方提供的流水线状态
+   */
+  struct PipelineContext {
+    bool playing = false;
+    std::string state;     // 播放状态名称
+    int64_t clock_ms = 0;  // 当前播放位置
+    // 各阶段输入队列深度，-1 表示未知（按有待处理数据处理）
+    std::array<int64_t, kStageCount> input_depths;
+
+    PipelineContext() { input_depths.fill(-1); }
+  };
+
+  struct StageSnapshot {
+    bool enabled = false;
+    bool finished = false;
+    bool idle = false;
+    bool stalled = false;
+    uint64_t beats = 0;
+    int64_t last_pts_ms = -1;
+    int64_t since_last_beat_ms = 0;
+    int64_t input_depth = -1;
+  };
+
+  /**
+   * @brief 卡死时的诊断快照
+   */
+  struct Snapshot {
+    std::string state;
+    int64_t clock_ms = 0;
+    std::array<StageSnapshot, kStageCount> stages;
+
+    uint32_t stalled_mask() const;
+    std::string ToString() const;
+  };
+
+  using ContextProvider = std::function<PipelineContext()>;
+  using StallCallback = std::function<void(const Snapshot&)>;
+
+  explicit PipelineWatchdog(const Options& options);
+  ~PipelineWatchdog();
+
+  PipelineWatchdog(const PipelineWatchdog&) = delete;
+  PipelineWatchdog& operator=(const PipelineWatchdog&) = delete;
+
+  static const char* StageName(Stage stage);
+
+  /**
+   * @brief 启动定时检查
+   * @param provider 每次检查时获取队列深度和播放状态
+   * @param on_stall 检测到卡死时回调（在定时器线程）
+   */
+  void Start(ContextProvider provider, StallCallback on_stall);
+  void Stop();
+
+  /**
+   * @brief 暂停时停止定时检查，恢复后重新计时（暂停期间不被定时唤醒）
+   * @note 未 Start 时不做任何事
+   */
+  void Suspend();
+  void Resume();
+
+  /**
+   * @brief 登记参与检查的阶段（流不存在的阶段不登记）
+   */
+  void EnableStage(Stage stage);
+
+  /**
+   * @brief 记录一次进度
+   * @param pts_ms 刚处理完的包 / 帧的 PTS（毫秒），未知时传 -1
+   */
+  void Heartbeat(Stage stage, int64_t pts_ms);
+
+  /**
+   * @brief 阶段已正常结束（EOF），不再检查
+   */
+  void MarkFinished(Stage stage);
+
+  /**
+   * @brief 阶段主动空闲（如解封装等待 A-B 缓存回放结束）
+   */
+  void SetIdle(Stage stage, bool idle);
+
+  /**
+   * @brief 清除结束标记并重新计时（Seek 完成后调用）
+   */
+  void Rearm();
+
+  /**
+   * @brief 执行一次检查
+   * @return 出现新的卡死时返回快照
+   * @note 定时器线程调用；公开以便测试注入时间
+   */
+  std::optional<Snapshot> Check(const PipelineContext& context,
+                                std::chrono::steady_clock::time_point now);
+
+ private:
+  struct StageState {
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> finished{false};
+    std::atomic<bool> idle{false};
+    std::atomic<uint64_t> beats{0};
+    std::atomic<int64_t> last_pts_ms{-1};
+    std::atomic<int64_t> last_beat_ns{0};  // steady_clock 纳秒
+  };
+
+  static int64_t ToNs(std::chrono::steady_clock::time_point time);
+  void RearmAt(std::chrono::steady_clock::time_point now);
+  void OnTimer();
+
+  const Options options_;
+  std::array<StageState, kStageCount> stages_;
+
+  // 以下只在 Check 中访问（定时器线程）
+  std::mutex check_mutex_;
+  bool was_playing_ = false;
+  uint32_t reported_mask_ = 0;
+
+  ContextProvider provider_;
+  StallCallback on_stall_;
+  std::unique_ptr<Timer> timer_;
+};
+
+}  // namespace zenplay
@@ -51,6 +51,30 @@ bool PlayerStateManager::WaitForResume(int timeout_ms) {
   }
 }
 
+bool PlayerStateManager::WaitForResume(
+    const std::function<bool()>& interrupted) {
+  std::unique_lock<std::mutex> lock(pause_mutex_);
+  pause_cv_.wait(lock, [this, &interrupted]() {
+    return GetState() == PlayerState::kPlaying || ShouldStop() ||
+           interrupted();
+  });
+  return GetState() == PlayerState::kPlaying && !interrupted();
+}
+
+bool PlayerStateManager::WaitWhilePlaying(int timeout_ms) {
+  std::unique_lock<std::mutex> lock(pause_mutex_);
+  return !pause_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                             [this]() {
+                               return GetState() != PlayerState::kPlaying;
+                             });
+}
+
+void PlayerStateManager::WakeWaiters() {
+  // 先获取等待锁：等待方检查条件与进入等待之间不会错过这次通知
+  { std::lock_guard<std::mutex> lock(pause_mutex_); }
+  pause_cv_.notify_all();
+}
+
 // ========== 状态转换 ==========
 
 bool PlayerStateManager::RequestStateChange(PlayerState new_state) {
@@ -84,13 +108,9 @@ bool PlayerStateManager::RequestStateChange(PlayerState new_state) {
   NotifyStateChange(old_state, new_state);
 
   // ✅ 唤醒等待的线程（关键修复）
-  // 1. 转换到 Playing：恢复播放
-  // 2. 转换到 Stopped/Idle/Error：停止信号，让 WaitForResume() 返回
-  if (new_state == PlayerState::kPlaying ||
-      new_state == PlayerState::kStopped || new_state == PlayerState::kIdle ||
-      new_state == PlayerState::kError) {
-    pause_cv_.notify_all();
-  }
+  // 任何状态变化都唤醒：WaitForResume() 等待 Playing / 停止信号，
+  // WaitWhilePlaying() 等待离开 Playing
+  WakeWaiters();
 
   return true;
 }
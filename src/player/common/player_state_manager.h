@@ -92,6 +92,26 @@ class PlayerStateManager {
    */
   bool WaitForResume(int timeout_ms = 0);
 
+  /**
+   * @brief 无限等待非暂停状态，或 interrupted() 返回 true
+   * @param interrupted 调用方自己的停止条件（如循环 / 倒放线程的停止标志）
+   * @return true 表示已恢复，false 表示被中断或应该停止
+   * @note 改变 interrupted 条件后需调用 WakeWaiters()，等待期间不会定时唤醒
+   */
+  bool WaitForResume(const std::function<bool()>& interrupted);
+
+  /**
+   * @brief 在播放状态下最多等待 timeout_ms，状态一旦离开 Playing 立即返回
+   * @return true 表示仍在播放（超时），false 表示状态已改变
+   * @note 用于周期性任务的间隔等待，暂停 / 停止时不必等满整个间隔
+   */
+  bool WaitWhilePlaying(int timeout_ms);
+
+  /**
+   * @brief 唤醒所有等待中的线程，让它们重新检查条件
+   */
+  void WakeWaiters();
+
   // ========== 状态转换 ==========
 
   /**
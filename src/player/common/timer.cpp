@@ -49,7 +49,11 @@ Timer::Timer(Timer&& other) noexcept {
 
   // 移动运行状态
   bool was_running = other.running_.exchange(false);
-  other.should_stop_.store(true);
+  {
+    std::lock_guard<std::mutex> sleep_lock(other.sleep_mutex_);
+    other.should_stop_.store(true);
+  }
+  other.sleep_cv_.notify_all();
 
   // 等待其他线程结束
   if (other.timer_thread_ && other.timer_thread_->joinable()) {
@@ -82,7 +86,11 @@ Timer& Timer::operator=(Timer&& other) noexcept {
 
     // 移动运行状态
     bool was_running = other.running_.exchange(false);
-    other.should_stop_.store(true);
+    {
+      std::lock_guard<std::mutex> sleep_lock(other.sleep_mutex_);
+      other.should_stop_.store(true);
+    }
+    other.sleep_cv_.notify_all();
 
     // 等待其他线程结束
     if (other.timer_thread_ && other.timer_thread_->joinable()) {
@@ -179,7 +187,12 @@ bool Timer::Stop() {
     return false;  // 已经停止
   }
 
-  should_stop_.store(true);
+  {
+    // 持锁设置停止标志，睡眠中的定时器线程不会错过唤醒
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    should_stop_.store(true);
+  }
+  sleep_cv_.notify_all();
 
   if (timer_thread_ && timer_thread_->joinable()) {
     timer_thread_->join();
@@ -352,12 +365,9 @@ void Timer::StandardSleep(Duration duration) {
     return;
   }
 
-  // 标准睡眠：使用条件变量实现可中断的睡眠
-  std::mutex sleep_mutex;
-  std::condition_variable sleep_cv;
-  std::unique_lock<std::mutex> lock(sleep_mutex);
-
-  sleep_cv.wait_for(lock, duration, [this] { return should_stop_.load(); });
+  // 标准睡眠：使用条件变量实现可中断的睡眠，Stop() 立即唤醒
+  std::unique_lock<std::mutex> lock(sleep_mutex_);
+  sleep_cv_.wait_for(lock, duration, [this] { return should_stop_.load(); });
 }
 
 void Timer::ExecuteCallback() {
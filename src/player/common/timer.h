@@ -10,6 +10,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -217,6 +218,10 @@ class Timer {
 
   // 线程管理
   std::unique_ptr<std::thread> timer_thread_;
+
+  // 标准精度睡眠的等待，Stop() 通过它唤醒定时器线程
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
 };
 
 /**
@@ -0,0 +1,257 @@
+#include "player/compare_session.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "player/codec/hw_decoder_context.h"
+#include "player/common/log_manager.h"
+#include "player/config/global_config.h"
+#include "player/sync/av_sync_controller.h"
+#include "player/video/render/compare_compositor.h"
+#include "player/video/render/render_path_selector.h"
+#include "player/video/render/renderer.h"
+#include "player/zen_player.h"
+
+namespace zenplay {
+
+CompareSession::CompareSession()
+    : master_clock_(std::make_unique<AVSyncController>()),
+      clock_gate_(master_clock_.get()) {
+  master_clock_->SetSyncMode(AVSyncController::SyncMode::EXTERNAL_MASTER);
+}
+
+CompareSession::~CompareSession() {
+  Close();
+}
+
+Result<void> CompareSession::Open(const std::vector<std::string>& urls) {
+  if (is_opened_) {
+    Close();
+  }
+
+  if (urls.size() < 2 || urls.size() > kMaxFiles) {
+    return Result<void>::Err(
+        ErrorCode::kInvalidParameter,
+        "Compare mode needs 2-" + std::to_string(kMaxFiles) + " files, got " +
+            std::to_string(urls.size()));
+  }
+
+  auto* config = GlobalConfig::Instance();
+  const int count = static_cast<int>(urls.size());
+  auto layout = CompareCompositor::ParseLayout(
+      config->GetString("player.compare.layout", "auto"), count);
+  int max_cell_height = config->GetInt("player.compare.max_cell_height", 1080);
+  bool first_file_audio =
+      config->GetBool("player.compare.audio_from_first", true);
+
+  auto output = RenderPathSelector::CreateDefaultRenderer();
+  if (!output) {
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             "Failed to create compare output renderer");
+  }
+  compositor_ = std::make_unique<CompareCompositor>(count, layout,
+                                                    max_cell_height,
+                                                    std::move(output));
+
+  // 主时钟在 Play() 之前保持暂停
+  clock_gate_.Reset(urls.size());
+
+  for (size_t i = 0; i < urls.size(); ++i) {
+    auto player = std::make_unique<ZenPlayer>();
+    player->SetExternalPipeline(
+        compositor_->CreateTileRenderer(static_cast<int>(i)),
+        master_clock_.get(), first_file_audio && i == 0);
+
+    auto result = player->Open(urls[i]);
+    if (!result.IsOk()) {
+      MODULE_ERROR(LOG_MODULE_PLAYER, "Compare: failed to open '{}': {}",
+                   urls[i], result.FullMessage());
+      player.reset();
+      ReleasePipelines();
+      return Result<void>::Err(result.Code(), "Failed to open '" + urls[i] +
+                                                  "': " + result.Message());
+    }
+
+    ZenPlayer* pipeline = player.get();
+    callback_ids_.push_back(player->RegisterStateChangeCallback(
+        [this, i, pipeline](PlayerStateManager::PlayerState old_state,
+                            PlayerStateManager::PlayerState new_state) {
+          OnPlayerStateChanged(i, pipeline, old_state, new_state);
+        }));
+    players_.push_back(std::move(player));
+  }
+
+  is_opened_ = true;
+  MODULE_INFO(LOG_MODULE_PLAYER, "✅ Compare session opened with {} files",
+              players_.size());
+  return Result<void>::Ok();
+}
+
+void CompareSession::Close() {
+  if (!is_opened_) {
+    return;
+  }
+
+  Stop();
+  ReleasePipelines();
+  is_opened_ = false;
+  MODULE_INFO(LOG_MODULE_PLAYER, "Compare session closed");
+}
+
+void CompareSession::ReleasePipelines() {
+  for (size_t i = 0; i < callback_ids_.size() && i < players_.size(); ++i) {
+    players_[i]->UnregisterStateChangeCallback(callback_ids_[i]);
+  }
+  callback_ids_.clear();
+  players_.clear();
+  compositor_.reset();
+  clock_gate_.Reset(0);
+}
+
+Result<void> CompareSession::SetRenderWindow(void* window_handle,
+                                             int width,
+                                             int height) {
+  if (!is_opened_ || !compositor_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Compare session not opened");
+  }
+  if (!window_handle || width <= 0 || height <= 0) {
+    return Result<void>::Err(ErrorCode::kInvalidParameter,
+                             "Invalid render window");
+  }
+
+  // 与 ZenPlayer 一样异步初始化渲染器（避免阻塞 UI 线程）
+  CompareCompositor* compositor = compositor_.get();
+  std::thread init_thread([compositor, window_handle, width, height]() {
+    auto result = compositor->Init(window_handle, width, height);
+    if (!result.IsOk()) {
+      MODULE_ERROR(LOG_MODULE_PLAYER, "Compare renderer init failed: {}",
+                   result.Message());
+    }
+  });
+  init_thread.detach();
+  return Result<void>::Ok();
+}
+
+void CompareSession::OnWindowResize(int width, int height) {
+  if (compositor_) {
+    compositor_->OnResize(width, height);
+  }
+}
+
+Result<void> CompareSession::Play() {
+  if (!is_opened_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Compare session not opened");
+  }
+
+  clock_gate_.Play();
+
+  for (auto& player : players_) {
+    auto result = player->Play();
+    if (!result.IsOk()) {
+      return result;
+    }
+  }
+  return Result<void>::Ok();
+}
+
+Result<void> CompareSession::Pause() {
+  if (!is_opened_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Compare session not opened");
+  }
+
+  clock_gate_.Pause();
+
+  // 已经播完的文件不在播放状态，暂停失败不影响其它管线
+  for (auto& player : players_) {
+    player->Pause();
+  }
+  return Result<void>::Ok();
+}
+
+void CompareSession::Stop() {
+  if (!is_opened_) {
+    return;
+  }
+
+  for (auto& player : players_) {
+    player->Stop();
+  }
+
+  clock_gate_.Stop();
+}
+
+void CompareSession::SeekAsync(int64_t timestamp_ms) {
+  if (!is_opened_) {
+    return;
+  }
+  timestamp_ms = std::max<int64_t>(timestamp_ms, 0);
+
+  std::vector<bool> seeking(players_.size());
+  for (size_t i = 0; i < players_.size(); ++i) {
+    auto state = players_[i]->GetState();
+    seeking[i] = state == PlayerStateManager::PlayerState::kPlaying ||
+                 state == PlayerStateManager::PlayerState::kPaused ||
+                 state == PlayerStateManager::PlayerState::kSeeking;
+  }
+
+  clock_gate_.BeginSeek(timestamp_ms, seeking);
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "Compare: seeking {} pipelines to {}ms",
+              players_.size(), timestamp_ms);
+  for (size_t i = 0; i < players_.size(); ++i) {
+    ZenPlayer* player = players_[i].get();
+    int64_t target_ms = timestamp_ms;
+    int64_t duration = player->GetDuration();
+    if (duration > 0) {
+      target_ms = std::min(target_ms, duration);
+    }
+    uint64_t serial = player->SeekAsync(target_ms, true);
+    // 完成序号在拿到请求序号之后读取：Seek 可能已经在这之间结束
+    if (seeking[i]) {
+      clock_gate_.SetSeekSerial(i, serial, player->GetCompletedSeekSerial());
+    }
+  }
+}
+
+int64_t CompareSession::GetDuration() const {
+  int64_t duration = 0;
+  for (const auto& player : players_) {
+    duration = std::max(duration, player->GetDuration());
+  }
+  return duration;
+}
+
+int64_t CompareSession::GetCurrentPlayTime() const {
+  return static_cast<int64_t>(
+      master_clock_->GetMasterClock(std::chrono::steady_clock::now()));
+}
+
+bool CompareSession::IsSeeking() const {
+  return clock_gate_.IsSeeking();
+}
+
+bool CompareSession::IsPlaying() const {
+  return is_opened_ && clock_gate_.IsPlaying();
+}
+
+void CompareSession::OnPlayerStateChanged(
+    size_t index,
+    ZenPlayer* player,
+    PlayerStateManager::PlayerState old_state,
+    PlayerStateManager::PlayerState new_state) {
+  using PlayerState = PlayerStateManager::PlayerState;
+  // 只关心 Seek 结束（成功回到播放 / 暂停，或失败）
+  if (new_state == PlayerState::kError) {
+    clock_gate_.OnPipelineError(index);
+  } else if (old_state == PlayerState::kSeeking &&
+             new_state != PlayerState::kSeeking) {
+    // 完成序号在切换状态之前更新，这里读到的就是刚结束的请求
+    clock_gate_.OnSeekFinished(index, player->GetCompletedSeekSerial());
+  }
+}
+
+}  // namespace zenplay
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "player/common/error.h"
+#include "player/common/player_state_manager.h"
+#include "player/playback/compare_clock_gate.h"
+
+namespace zenplay {
+
+class AVSyncController;
+class CompareCompositor;
+class ZenPlayer;
+
+/**
+ * @brief 多文件同步对比播放
+ *
+ * 每个文件一条独立的 ZenPlayer 管线（解封装、解码、VideoPlayer 各自独立），
+ * 所有管线的视频都跟随本会话持有的同一个 EXTERNAL_MASTER 时钟，画面由
+ * CompareCompositor 合成到同一个窗口（并排或网格）。
+ *
+ * - 播放 / 暂停 / Seek 同时作用于所有管线，并同步暂停、移动主时钟
+ * - Seek 时主时钟停在目标位置，直到所有管线都完成跳转才继续走，
+ *   先到的管线不会跑在前面
+ * - 音频只来自第一个文件（可在配置中关闭），其它管线不打开音频
+ *
+ * 用法：
+ * @code
+ *   CompareSession session;
+ *   session.Open({"a.mp4", "b.mp4"});
+ *   session.SetRenderWindow(handle, width, height);
+ *   session.Play();
+ *   session.SeekAsync(60000);
+ * @endcode
+ */
+class CompareSession {
+ public:
+  static constexpr size_t kMaxFiles = 4;
+
+  CompareSession();
+  ~CompareSession();
+
+  CompareSession(const CompareSession&) = delete;
+  CompareSession& operator=(const CompareSession&) = delete;
+
+  /**
+   * @brief 打开要对比的文件（2 ~ kMaxFiles 个）
+   * @return 任一文件打开失败时关闭全部并返回该错误
+   */
+  Result<void> Open(const std::vector<std::string>& urls);
+
+  void Close();
+
+  /**
+   * @brief 设置渲染窗口（合成后的画布显示在这个窗口）
+   */
+  Result<void> SetRenderWindow(void* window_handle, int width, int height);
+
+  void OnWindowResize(int width, int height);
+
+  Result<void> Play();
+  Result<void> Pause();
+  void Stop();
+
+  /**
+   * @brief 所有管线同时跳转
+   * @note 超出较短文件时长的目标位置，该文件跳到结尾
+   */
+  void SeekAsync(int64_t timestamp_ms);
+
+  /**
+   * @brief 最长文件的时长（毫秒）
+   */
+  int64_t GetDuration() const;
+
+  /**
+   * @brief 共享主时钟的当前位置（毫秒）
+   */
+  int64_t GetCurrentPlayTime() const;
+
+  /**
+   * @brief 是否还有管线没有完成最近一次 Seek
+   */
+  bool IsSeeking() const;
+
+  /**
+   * @brief 是否在播放中（已开始播放且没有被用户暂停）
+   */
+  bool IsPlaying() const;
+
+  bool IsOpened() const { return is_opened_; }
+  size_t GetFileCount() const { return players_.size(); }
+
+ private:
+  /**
+   * @brief 管线状态变化：Seek 结束或出错时交给主时钟门控
+   */
+  void OnPlayerStateChanged(size_t index,
+                            ZenPlayer* player,
+                            PlayerStateManager::PlayerState old_state,
+                            PlayerStateManager::PlayerState new_state);
+
+  /**
+   * @brief 释放所有管线和合成器（管线先于合成器销毁，分块渲染器引用它）
+   */
+  void ReleasePipelines();
+
+  std::unique_ptr<AVSyncController> master_clock_;
+  CompareClockGate clock_gate_;  // 主时钟的启停（Seek 等待所有管线）
+  std::unique_ptr<CompareCompositor> compositor_;
+  std::vector<std::unique_ptr<ZenPlayer>> players_;
+  std::vector<int> callback_ids_;
+
+  bool is_opened_ = false;
+};
+
+}  // namespace zenplay
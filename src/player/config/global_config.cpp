@@ -53,7 +53,9 @@ GlobalConfig* GlobalConfig::Instance() {
 nlohmann::json GlobalConfig::CreateDefaultConfig() const {
   return nlohmann::json{
       {"player",
-       {{"audio",
+       {{"profile", "balanced"},
+        {"profiles", nlohmann::json::object()},
+        {"audio",
          {{"buffer_size", 4096},
           {"sample_rate", 48000},
           {"channels", 2},
@@ -63,17 +65,40 @@ nlohmann::json GlobalConfig::CreateDefaultConfig() const {
            nlohmann::json::array({"h264_cuvid", "h264_qsv", "h264"})},
           {"max_width", 3840},
           {"max_height", 2160}}},
-        {"sync", {{"method", "audio"}, {"correction_threshold_ms", 100}}}}},
+        {"sync", {{"method", "audio"}, {"correction_threshold_ms", 100}}},
+        {"ab_loop", {{"max_cache_mb", 512}}},
+        {"reverse",
+         {{"max_cache_mb", 256}, {"max_hw_frames_per_chunk", 4}}},
+        {"scrub", {{"preview_interval_ms", 50}}},
+        {"hover_prefetch",
+         {{"enabled", true}, {"max_frames", 8}, {"debounce_ms", 150}}},
+        {"raw_video",
+         {{"width", 0},
+          {"height", 0},
+          {"pixel_format", "yuv420p"},
+          {"fps", 25.0}}},
+        {"watchdog",
+         {{"enabled", true},
+          {"stall_threshold_ms", 3000},
+          {"check_interval_ms", 500}}},
+        {"compare",
+         {{"layout", "auto"},
+          {"max_cell_height", 1080},
+          {"audio_from_first", true}}}}},
       {"render",
        {{"use_hardware_acceleration", true},
         {"backend_priority",
          nlohmann::json::array({"d3d11", "opengl", "software"})},
         {"vsync", true},
         {"max_fps", 60},
+        {"static_frame_detection", true},
         {"hardware",
          {{"allow_d3d11va", true},
           {"allow_dxva2", true},
-          {"allow_fallback", true}}}}},
+          {"allow_fallback", true}}},
+        {"opengl", {{"surfaceless", false}}},
+        {"stats_overlay",
+         {{"enabled", false}, {"update_interval_ms", 250}}}}},
       {"log",
        {{"level", "info"},
         {"outputs",
@@ -102,6 +127,7 @@ nlohmann::json GlobalConfig::CreateDefaultConfig() const {
                                  {"path", "logs/statistics.csv"}}})}}},
       {"network",
        {{"timeout_ms", 5000},
+        {"open_timeout_ms", 15000},
         {"buffer_size_kb", 1024},
         {"user_agent", "ZenPlay/1.0"},
         {"proxy",
@@ -112,7 +138,14 @@ nlohmann::json GlobalConfig::CreateDefaultConfig() const {
       {"cache",
        {{"enabled", true},
         {"max_size_mb", 500},
-        {"directory", "cache/zenplay"}}}};
+        {"directory", "cache/zenplay"}}},
+      {"debug",
+       {{"packet_capture", {{"enabled", false}, {"directory", "captures"}}}}},
+      {"export",
+       {{"frame_export",
+         {{"enabled", false},
+          {"socket_path", "/tmp/zenplay_frames.sock"},
+          {"slot_count", 8}}}}}};
 }
 
 Result<void> GlobalConfig::Load(const std::string& config_path) {
@@ -0,0 +1,106 @@
+#include "player/config/pipeline_profile.h"
+
+#include <algorithm>
+
+#include "player/common/log_manager.h"
+#include "player/config/global_config.h"
+
+namespace zenplay {
+
+namespace {
+
+PipelineProfile MakeProfile(const std::string& name,
+                            size_t video_packet_queue,
+                            size_t audio_packet_queue,
+                            int video_frame_queue,
+                            size_t audio_frame_queue,
+                            int audio_period_frames,
+                            int decoder_threads,
+                            const std::string& decoder_thread_type,
+                            int64_t stats_report_interval_ms) {
+  PipelineProfile profile;
+  profile.name = name;
+  profile.video_packet_queue = video_packet_queue;
+  profile.audio_packet_queue = audio_packet_queue;
+  profile.video_frame_queue = video_frame_queue;
+  profile.audio_frame_queue = audio_frame_queue;
+  profile.audio_period_frames = audio_period_frames;
+  profile.decoder_threads = decoder_threads;
+  profile.decoder_thread_type = decoder_thread_type;
+  profile.stats_report_interval_ms = stats_report_interval_ms;
+  return profile;
+}
+
+}  // namespace
+
+const std::vector<std::string>& PipelineProfile::BuiltinNames() {
+  static const std::vector<std::string> names = {
+      "low_latency", "balanced", "high_throughput", "power_save"};
+  return names;
+}
+
+PipelineProfile PipelineProfile::Builtin(const std::string& name) {
+  if (name == "low_latency") {
+    return MakeProfile(name, 16, 24, 3, 8, 256, 0, "slice", 1000);
+  }
+  if (name == "high_throughput") {
+    return MakeProfile(name, 256, 384, 30, 150, 2048, 0, "frame+slice", 5000);
+  }
+  if (name == "power_save") {
+    return MakeProfile(name, 128, 192, 8, 100, 4096, 2, "frame+slice", 10000);
+  }
+  return PipelineProfile();
+}
+
+PipelineProfile PipelineProfile::Load(const std::string& name) {
+  auto* config = GlobalConfig::Instance();
+  std::string profile_name =
+      name.empty() ? config->GetString("player.profile", "balanced") : name;
+
+  const std::string prefix = "player.profiles." + profile_name;
+  const auto& builtin = BuiltinNames();
+  bool is_builtin = std::find(builtin.begin(), builtin.end(), profile_name) !=
+                    builtin.end();
+  if (!is_builtin && !config->Has(prefix)) {
+    MODULE_WARN(LOG_MODULE_PLAYER,
+                "Unknown pipeline profile '{}', falling back to balanced",
+                profile_name);
+    profile_name = "balanced";
+  }
+
+  // 自定义配置档以 balanced 为基础，再用配置文件中的字段覆盖
+  PipelineProfile profile = Builtin(profile_name);
+  profile.name = profile_name;
+
+  auto read_size = [&](const char* field, size_t& value) {
+    int64_t v = config->GetInt64(prefix + "." + field,
+                                 static_cast<int64_t>(value));
+    if (v > 0) {
+      value = static_cast<size_t>(v);
+    }
+  };
+  auto read_int = [&](const char* field, int& value, int min_value) {
+    int v = config->GetInt(prefix + "." + field, value);
+    if (v >= min_value) {
+      value = v;
+    }
+  };
+
+  read_size("video_packet_queue", profile.video_packet_queue);
+  read_size("audio_packet_queue", profile.audio_packet_queue);
+  read_int("video_frame_queue", profile.video_frame_queue, 1);
+  read_size("audio_frame_queue", profile.audio_frame_queue);
+  read_int("audio_period_frames", profile.audio_period_frames, 1);
+  read_int("decoder_threads", profile.decoder_threads, 0);
+  profile.decoder_thread_type = config->GetString(
+      prefix + ".decoder_thread_type", profile.decoder_thread_type);
+  int64_t interval = config->GetInt64(prefix + ".stats_report_interval_ms",
+                                      profile.stats_report_interval_ms);
+  if (interval > 0) {
+    profile.stats_report_interval_ms = interval;
+  }
+
+  return profile;
+}
+
+}  // namespace zenplay
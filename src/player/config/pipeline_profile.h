@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zenplay {
+
+/**
+ * @brief 播放流水线性能配置档
+ *
+ * 把分散在各组件中的调优参数（包队列、帧队列、PCM 队列、解码线程、
+ * 音频周期、渲染预取、统计报告间隔）集中在一处，按名称整体选择：
+ * - low_latency：小队列、小音频周期、仅片级多线程解码（帧级多线程会
+ *   额外延迟 线程数-1 帧），适合直播 / 交互
+ * - balanced：默认，与以往的硬编码参数一致，解码线程数自动
+ * - high_throughput：大队列吸收网络 / 解码抖动，适合高码率本地文件
+ * - power_save：大音频周期、较少解码线程，减少唤醒次数
+ *
+ * 除统计报告间隔外都按播放器生效（见 stats_report_interval_ms）。
+ *
+ * 内置配置档的取值只定义在 Builtin() 中；配置文件 player.profiles.<name>
+ * 下只写需要覆盖的字段，也可定义新的配置档（以 balanced 为基础）；
+ * player.profile 指定默认配置档。
+ */
+struct PipelineProfile {
+  std::string name = "balanced";
+
+  size_t video_packet_queue = 64;  // 视频包队列容量
+  size_t audio_packet_queue = 96;  // 音频包队列容量
+  int video_frame_queue = 15;      // 视频帧队列（渲染预取帧数）
+  size_t audio_frame_queue = 50;   // 重采样后 PCM 帧队列容量
+  int audio_period_frames = 1024;  // 音频输出周期（每声道采样数）
+
+  int decoder_threads = 0;                          // 解码线程数，0 为自动
+  std::string decoder_thread_type = "frame+slice";  // FFmpeg thread_type
+
+  // 统计报告间隔。进程级设置：统计管理器是单例，只采用进程内第一个
+  // 播放流水线的配置档（对比模式的其他流水线、之后重新打开都不改变）
+  int64_t stats_report_interval_ms = 5000;
+
+  /**
+   * @brief 内置配置档名称
+   */
+  static const std::vector<std::string>& BuiltinNames();
+
+  /**
+   * @brief 获取内置配置档
+   * @return 未知名称返回 balanced（name 保持为 balanced）
+   */
+  static PipelineProfile Builtin(const std::string& name);
+
+  /**
+   * @brief 按名称加载配置档：内置值 + 配置文件覆盖
+   * @param name 配置档名称，空字符串表示使用 player.profile
+   * @note 既不是内置名称、配置文件中也没有定义时回退到 balanced
+   */
+  static PipelineProfile Load(const std::string& name = "");
+};
+
+}  // namespace zenplay
@@ -0,0 +1,178 @@
+#include "player/demuxer/abr_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace zenplay {
+
+// ============================================================================
+// ThroughputEstimator
+// ============================================================================
+
+ThroughputEstimator::Ewma::Ewma(double half_life_s)
+    : alpha_(std::exp(std::log(0.5) / half_life_s)) {}
+
+void ThroughputEstimator::Ewma::Add(double weight_s, double value) {
+  double adjusted_alpha = std::pow(alpha_, weight_s);
+  estimate_ = value * (1.0 - adjusted_alpha) + adjusted_alpha * estimate_;
+  total_weight_ += weight_s;
+}
+
+double ThroughputEstimator::Ewma::Estimate() const {
+  // 零偏修正：estimate_ 初值为 0，样本总权重较小时会被低估
+  double zero_factor = 1.0 - std::pow(alpha_, total_weight_);
+  return zero_factor > 0.0 ? estimate_ / zero_factor : 0.0;
+}
+
+ThroughputEstimator::ThroughputEstimator(double fast_half_life_s,
+                                         double slow_half_life_s)
+    : fast_(fast_half_life_s),
+      slow_(slow_half_life_s),
+      fast_half_life_s_(fast_half_life_s),
+      slow_half_life_s_(slow_half_life_s) {}
+
+void ThroughputEstimator::AddSample(uint64_t bytes, double duration_ms) {
+  if (duration_ms <= 0.0) {
+    return;
+  }
+
+  double bandwidth_bps = bytes * 8.0 * 1000.0 / duration_ms;
+  double weight_s = duration_ms / 1000.0;
+  fast_.Add(weight_s, bandwidth_bps);
+  slow_.Add(weight_s, bandwidth_bps);
+
+  total_duration_ms_ += duration_ms;
+  total_bytes_ += bytes;
+}
+
+double ThroughputEstimator::GetEstimateKbps() const {
+  if (total_duration_ms_ <= 0.0) {
+    return 0.0;
+  }
+  return std::min(fast_.Estimate(), slow_.Estimate()) / 1000.0;
+}
+
+bool ThroughputEstimator::HasEstimate() const {
+  return total_duration_ms_ > 0.0;
+}
+
+void ThroughputEstimator::Reset() {
+  fast_ = Ewma(fast_half_life_s_);
+  slow_ = Ewma(slow_half_life_s_);
+  total_duration_ms_ = 0.0;
+  total_bytes_ = 0;
+}
+
+// ============================================================================
+// AbrController
+// ============================================================================
+
+AbrController::AbrController() : AbrController(Config{}) {}
+
+AbrController::AbrController(const Config& config) : config_(config) {}
+
+void AbrController::SetVariants(std::vector<Variant> variants,
+                                int current_id) {
+  std::stable_sort(variants.begin(), variants.end(),
+                   [](const Variant& a, const Variant& b) {
+                     return a.bandwidth_bps < b.bandwidth_bps;
+                   });
+  variants_ = std::move(variants);
+  current_id_ = current_id;
+  pending_bytes_ = 0;
+  pending_read_time_ms_ = 0.0;
+  last_switch_time_ = {};
+}
+
+void AbrController::OnPacketRead(uint64_t bytes, double read_time_ms) {
+  pending_bytes_ += bytes;
+  pending_read_time_ms_ += std::max(0.0, read_time_ms);
+}
+
+int AbrController::OnSegmentBoundary(
+    double buffer_level_ms,
+    std::chrono::steady_clock::time_point now) {
+  // 1. 提交本分片的吞吐量样本
+  //    太小的样本（例如数据全部来自 FFmpeg 内部缓冲）不能反映真实带宽
+  if (pending_bytes_ >= config_.min_sample_bytes &&
+      pending_read_time_ms_ >= config_.min_sample_duration_ms) {
+    estimator_.AddSample(pending_bytes_, pending_read_time_ms_);
+    pending_bytes_ = 0;
+    pending_read_time_ms_ = 0.0;
+  }
+
+  if (variants_.size() < 2 || !estimator_.HasEstimate()) {
+    return current_id_;
+  }
+
+  size_t current_index = IndexOf(current_id_);
+  if (current_index >= variants_.size()) {
+    return current_id_;
+  }
+
+  // 2. 缓冲告急：直接降到最低档，优先保证不卡顿
+  if (buffer_level_ms < config_.panic_buffer_ms) {
+    return variants_.front().id;
+  }
+
+  double usable_bps =
+      estimator_.GetEstimateKbps() * 1000.0 * config_.safety_factor;
+  size_t target_index = SelectIndexForBandwidth(usable_bps);
+
+  // 3. 降档立即生效
+  if (target_index < current_index) {
+    return variants_[target_index].id;
+  }
+
+  // 4. 升档需要足够的缓冲，并且距离上次切换有一定间隔（避免来回抖动）
+  if (target_index > current_index) {
+    bool buffer_ok = buffer_level_ms >= config_.min_buffer_for_upswitch_ms;
+    double since_last_switch_ms =
+        std::chrono::duration<double, std::milli>(now - last_switch_time_)
+            .count();
+    bool interval_ok = switch_count_ == 0 ||
+                       since_last_switch_ms >= config_.min_switch_interval_ms;
+    if (buffer_ok && interval_ok) {
+      // 每次只升一档，逐步试探带宽
+      return variants_[current_index + 1].id;
+    }
+  }
+
+  return current_id_;
+}
+
+void AbrController::OnSeek() {
+  pending_bytes_ = 0;
+  pending_read_time_ms_ = 0.0;
+}
+
+void AbrController::CommitSwitch(int variant_id,
+                                 std::chrono::steady_clock::time_point now) {
+  if (variant_id == current_id_) {
+    return;
+  }
+  current_id_ = variant_id;
+  last_switch_time_ = now;
+  ++switch_count_;
+}
+
+size_t AbrController::SelectIndexForBandwidth(double usable_bps) const {
+  size_t index = 0;
+  for (size_t i = 0; i < variants_.size(); ++i) {
+    if (variants_[i].bandwidth_bps <= usable_bps) {
+      index = i;
+    }
+  }
+  return index;
+}
+
+size_t AbrController::IndexOf(int variant_id) const {
+  for (size_t i = 0; i < variants_.size(); ++i) {
+    if (variants_[i].id == variant_id) {
+      return i;
+    }
+  }
+  return variants_.size();
+}
+
+}  // namespace zenplay
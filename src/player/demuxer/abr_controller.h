@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace zenplay {
+
+/**
+ * @brief 网络吞吐量估计器（双 EWMA）
+ *
+ * 以"下载字节数 / 下载耗时"为样本，维护快、慢两个指数加权平均，
+ * 取二者较小值作为估计结果：
+ * - 快速 EWMA：带宽下降时迅速反应，避免缓冲耗尽
+ * - 慢速 EWMA：带宽短暂抖高时不急于升档
+ *
+ * 权重按样本时长计算（时长越长的样本影响越大），并做零偏修正，
+ * 所以前几个样本也能给出可用的估计。
+ */
+class ThroughputEstimator {
+ public:
+  /**
+   * @param fast_half_life_s 快速 EWMA 半衰期（秒）
+   * @param slow_half_life_s 慢速 EWMA 半衰期（秒）
+   */
+  explicit ThroughputEstimator(double fast_half_life_s = 2.0,
+                               double slow_half_life_s = 5.0);
+
+  /**
+   * @brief 添加一个下载样本
+   * @param bytes 本次下载的字节数
+   * @param duration_ms 本次下载耗时（毫秒），<=0 的样本会被忽略
+   */
+  void AddSample(uint64_t bytes, double duration_ms);
+
+  /**
+   * @brief 获取估计吞吐量（kbps，1 kbps = 1000 bit/s）
+   * @return 没有任何样本时返回 0
+   */
+  double GetEstimateKbps() const;
+
+  /**
+   * @brief 是否已有足够的样本给出估计
+   */
+  bool HasEstimate() const;
+
+  uint64_t total_bytes() const { return total_bytes_; }
+
+  void Reset();
+
+ private:
+  /**
+   * @brief 带零偏修正的指数加权平均
+   */
+  class Ewma {
+   public:
+    explicit Ewma(double half_life_s);
+    void Add(double weight_s, double value);
+    double Estimate() const;
+
+   private:
+    double alpha_;
+    double estimate_ = 0.0;
+    double total_weight_ = 0.0;
+  };
+
+  Ewma fast_;
+  Ewma slow_;
+  double fast_half_life_s_;
+  double slow_half_life_s_;
+  double total_duration_ms_ = 0.0;
+  uint64_t total_bytes_ = 0;
+};
+
+/**
+ * @brief 自适应码率（ABR）控制器
+ *
+ * 针对 HLS 等多码率流，根据吞吐量估计和缓冲水位选择 variant：
+ * - 下载侧：DemuxTask 每读到一个包调用 OnPacketRead() 累计字节和耗时
+ * - 分片边界：当前 variant 的视频关键帧到达时调用 OnSegmentBoundary()，
+ *   累计量作为一个吞吐量样本，然后给出下一个分片应使用的 variant
+ *
+ * 切换策略：
+ * - 升档：估计带宽 * safety_factor 足以支撑更高码率，且缓冲充足、
+ *   距离上次切换超过 min_switch_interval_ms
+ * - 降档：估计带宽不足以支撑当前码率，或缓冲低于 panic_buffer_ms，立即降档
+ *
+ * @note 只包含决策逻辑，不依赖 FFmpeg；实际切换由 Demuxer::SelectVariant 完成
+ * @note 非线程安全，所有调用都应在 DemuxTask 线程中进行
+ */
+class AbrController {
+ public:
+  /**
+   * @brief 一个可选的码率档位
+   */
+  struct Variant {
+    int id = -1;                // Demuxer 的 variant 序号
+    int64_t bandwidth_bps = 0;  // 播放列表声明的带宽（bit/s）
+    int width = 0;
+    int height = 0;
+  };
+
+  struct Config {
+    double safety_factor = 0.8;              // 只使用估计带宽的 80%
+    double min_buffer_for_upswitch_ms = 8000.0;  // 升档所需最低缓冲
+    double panic_buffer_ms = 3000.0;         // 低于此缓冲直接降到最低档
+    double min_switch_interval_ms = 4000.0;  // 两次升档的最小间隔
+    uint64_t min_sample_bytes = 16 * 1024;   // 小于此字节数的样本不计入
+    double min_sample_duration_ms = 5.0;     // 小于此耗时的样本不计入
+  };
+
+  AbrController();
+  explicit AbrController(const Config& config);
+
+  /**
+   * @brief 设置可选档位和当前档位
+   * @param variants 档位列表（顺序任意，内部按带宽排序）
+   * @param current_id 当前正在播放的档位 id
+   */
+  void SetVariants(std::vector<Variant> variants, int current_id);
+
+  /**
+   * @brief 累计一次读包的字节数和耗时
+   */
+  void OnPacketRead(uint64_t bytes, double read_time_ms);
+
+  /**
+   * @brief 分片边界：提交吞吐量样本并决定下一分片的档位
+   * @param buffer_level_ms 当前已缓冲但未播放的媒体时长（毫秒）
+   * @param now 当前时间
+   * @return 下一分片应使用的档位 id（与 current_variant() 不同表示需要切换）
+   */
+  int OnSegmentBoundary(double buffer_level_ms,
+                        std::chrono::steady_clock::time_point now =
+                            std::chrono::steady_clock::now());
+
+  /**
+   * @brief Seek 后丢弃尚未成为样本的累计量
+   * @note 跨越 Seek 读到的字节不属于同一个分片；吞吐量估计保留
+   */
+  void OnSeek();
+
+  /**
+   * @brief 通知控制器切换已生效
+   */
+  void CommitSwitch(int variant_id,
+                    std::chrono::steady_clock::time_point now =
+                        std::chrono::steady_clock::now());
+
+  int current_variant() const { return current_id_; }
+  double throughput_kbps() const { return estimator_.GetEstimateKbps(); }
+  uint64_t total_bytes() const { return estimator_.total_bytes(); }
+  size_t variant_count() const { return variants_.size(); }
+  uint64_t switch_count() const { return switch_count_; }
+
+ private:
+  /**
+   * @brief 查找估计带宽能支撑的最高档位在 variants_ 中的下标
+   */
+  size_t SelectIndexForBandwidth(double usable_bps) const;
+  size_t IndexOf(int variant_id) const;
+
+  Config config_;
+  ThroughputEstimator estimator_;
+  std::vector<Variant> variants_;  // 按 bandwidth_bps 升序
+  int current_id_ = -1;
+
+  // 当前分片累计量
+  uint64_t pending_bytes_ = 0;
+  double pending_read_time_ms_ = 0.0;
+
+  std::chrono::steady_clock::time_point last_switch_time_{};
+  uint64_t switch_count_ = 0;
+};
+
+}  // namespace zenplay
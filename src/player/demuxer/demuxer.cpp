@@ -1,11 +1,37 @@
 #include "player/demuxer/demuxer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
 #include "demuxer.h"
 #include "player/common/ffmpeg_error_utils.h"
 #include "player/common/log_manager.h"
+#include "player/demuxer/packet_capture.h"
 
 namespace zenplay {
 
+namespace {
+
+// 暂存的新档位音频包上限：旧档位音频不再前进时不会无限增长
+constexpr size_t kMaxHeldAudioPackets = 512;
+
+int64_t SteadyNowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void FreePackets(std::deque<AVPacket*>* packets) {
+  for (AVPacket*& packet : *packets) {
+    av_packet_free(&packet);
+  }
+  packets->clear();
+}
+
+}  // namespace
+
 std::once_flag Demuxer::init_once_flag_;
 
 Demuxer::Demuxer() : format_context_(nullptr) {
@@ -21,10 +47,27 @@ Result<void> Demuxer::Open(const std::string& url) {
     Close();
   }
 
+  // ✅ 数据包抓取文件：按原始到达时间回放
+  const std::string kCaptureSuffix = ".zpcap";
+  if (url.size() > kCaptureSuffix.size() &&
+      url.compare(url.size() - kCaptureSuffix.size(), kCaptureSuffix.size(),
+                  kCaptureSuffix) == 0) {
+    return OpenReplay(url);
+  }
+
+  // ✅ 未压缩视频（Y4M / 裸 YUV）：内存映射，不经过 FFmpeg 解封装和解码
+  if (RawVideoSource::IsRawVideoPath(url)) {
+    return OpenRawVideo(url);
+  }
+
+  // 上一次播放停止时留下的中断请求不影响新的打开
+  interrupt_requested_.store(false);
+
   AVDictionary* options = nullptr;
 
   // ✅ 通用网络选项（仅对网络流生效）
-  if (IsNetworkProtocol(url)) {
+  is_network_ = IsNetworkProtocol(url);
+  if (is_network_) {
     av_dict_set(&options, "reconnect", "1", 0);
     av_dict_set(&options, "reconnect_delay_max", "5", 0);
     av_dict_set(&options, "reconnect_streamed", "1", 0);
@@ -58,28 +101,73 @@ Result<void> Demuxer::Open(const std::string& url) {
     MODULE_DEBUG(LOG_MODULE_DEMUXER, "UDP stream: buffer=1MB, timeout=1s");
   }
 
-  int ret =
-      avformat_open_input(&format_context_, url.c_str(), nullptr, &options);
-  if (ret < 0) {
+  // ✅ 安装中断回调：Stop / Seek 和单次操作截止时间都能让阻塞的
+  // 网络 I/O 立即返回，而不是等协议自己的超时
+  format_context_ = avformat_alloc_context();
+  if (!format_context_) {
     av_dict_free(&options);
-    avformat_free_context(format_context_);
-    format_context_ = nullptr;
-    return FFmpegErrorToResult(ret, "Open input: " + url);
+    return Result<void>::Err(ErrorCode::kOutOfMemory,
+                             "Failed to allocate AVFormatContext");
   }
+  format_context_->interrupt_callback.callback = &Demuxer::InterruptCallback;
+  format_context_->interrupt_callback.opaque = this;
 
+  BeginIo(open_timeout_ms_);
+  int ret =
+      avformat_open_input(&format_context_, url.c_str(), nullptr, &options);
   av_dict_free(&options);
+  if (ret < 0) {
+    // avformat_open_input 失败时已释放上下文并置空
+    return Result<void>::Err(MapIoError(ret),
+                             FormatFFmpegError(ret, "Open input: " + url));
+  }
 
   ret = avformat_find_stream_info(format_context_, nullptr);
   if (ret < 0) {
+    ErrorCode code = MapIoError(ret);
     Close();
-    return FFmpegErrorToResult(ret, "Find stream info: " + url);
+    return Result<void>::Err(
+        code, FormatFFmpegError(ret, "Find stream info: " + url));
+  }
+
+  probeStreams();
+  probeVariants();
+  return Result<void>::Ok();
+}
+
+Result<void> Demuxer::OpenReplay(const std::string& path) {
+  auto source = std::make_unique<PacketReplaySource>();
+  auto result = source->Open(path, &format_context_);
+  if (!result.IsOk()) {
+    return result;
+  }
+  replay_source_ = std::move(source);
+
+  probeStreams();
+  // 抓取时的活动流可能不是第一个流（例如 ABR 切换过档位）
+  if (findStreamByIndex(replay_source_->active_video_stream())) {
+    active_video_stream_index_ = replay_source_->active_video_stream();
+  }
+  if (findStreamByIndex(replay_source_->active_audio_stream())) {
+    active_audio_stream_index_ = replay_source_->active_audio_stream();
   }
+  return Result<void>::Ok();
+}
 
+Result<void> Demuxer::OpenRawVideo(const std::string& path) {
+  auto source = std::make_unique<RawVideoSource>();
+  auto result = source->Open(path, &format_context_, raw_video_options_);
+  if (!result.IsOk()) {
+    return result;
+  }
+  raw_video_source_ = std::move(source);
   probeStreams();
   return Result<void>::Ok();
 }
 
 void Demuxer::Close() {
+  replay_source_.reset();
+  raw_video_source_.reset();
   if (format_context_) {
     avformat_free_context(format_context_);
     format_context_ = nullptr;
@@ -87,16 +175,47 @@ void Demuxer::Close() {
     audio_streams_.clear();
     active_video_stream_index_ = -1;
     active_audio_stream_index_ = -1;
+    variants_.clear();
+    current_variant_ = -1;
+    pending_variant_ = -1;
+    last_video_pts_us_ = AV_NOPTS_VALUE;
+    last_audio_end_us_ = AV_NOPTS_VALUE;
+    FreePackets(&held_audio_packets_);
+    FreePackets(&spliced_audio_packets_);
+    audio_splicing_ = false;
   }
+  is_network_ = false;
 }
 
 Result<AVPacket*> Demuxer::ReadPacket() {
+  return ReadPacket(io_cancel_generation());
+}
+
+Result<AVPacket*> Demuxer::ReadPacket(uint64_t cancel_generation) {
+  if (replay_source_) {
+    return ReadReplayPacket();
+  }
+  if (raw_video_source_) {
+    return Result<AVPacket*>::Ok(nullptr);  // 只有帧，没有数据包
+  }
+
+  // 档位切换时接上的新档位音频先于新读取的包输出
+  while (!spliced_audio_packets_.empty()) {
+    AVPacket* packet = spliced_audio_packets_.front();
+    spliced_audio_packets_.pop_front();
+    if (AcceptAudioPacket(packet)) {
+      return Result<AVPacket*>::Ok(packet);
+    }
+    av_packet_free(&packet);
+  }
+
   AVPacket* packet = av_packet_alloc();
   if (!packet) {
     return Result<AVPacket*>::Err(ErrorCode::kOutOfMemory,
                                   "Failed to allocate AVPacket");
   }
 
+  BeginIo(io_timeout_ms_, cancel_generation);
   int ret = av_read_frame(format_context_, packet);
 
   if (ret == AVERROR_EOF) {
@@ -105,21 +224,60 @@ Result<AVPacket*> Demuxer::ReadPacket() {
     return Result<AVPacket*>::Ok(nullptr);
   } else if (ret < 0) {
     av_packet_free(&packet);
-    return Result<AVPacket*>::Err(MapFFmpegError(ret),
+    return Result<AVPacket*>::Err(MapIoError(ret),
                                   FormatFFmpegError(ret, "Read packet"));
   }
 
+  // ✅ ABR：新档位的视频关键帧到达（分片边界），在此处完成切换
+  if (pending_variant_ >= 0 &&
+      packet->stream_index ==
+          variants_[pending_variant_].video_stream_index &&
+      (packet->flags & AV_PKT_FLAG_KEY)) {
+    AVStream* stream = format_context_->streams[packet->stream_index];
+    int64_t pts_us = packet->pts != AV_NOPTS_VALUE
+                         ? av_rescale_q(packet->pts, stream->time_base,
+                                        AVRational{1, AV_TIME_BASE})
+                         : AV_NOPTS_VALUE;
+    // 新播放列表可能从较早的分片开始，等到时间上能接上旧档位再切换
+    if (last_video_pts_us_ == AV_NOPTS_VALUE || pts_us == AV_NOPTS_VALUE ||
+        pts_us >= last_video_pts_us_) {
+      CommitVariantSwitch();
+    }
+  }
+
+  // 切换中旧档位的音频仍在输出，新档位的音频暂存到提交时接续
+  if (pending_variant_ >= 0 &&
+      packet->stream_index == variants_[pending_variant_].audio_stream_index &&
+      packet->stream_index != active_audio_stream_index_) {
+    if (held_audio_packets_.size() >= kMaxHeldAudioPackets) {
+      av_packet_free(&held_audio_packets_.front());
+      held_audio_packets_.pop_front();
+    }
+    held_audio_packets_.push_back(packet);
+    return ReadPacket(cancel_generation);
+  }
+
   // 跳过非活动流的数据包
   if (packet->stream_index != active_audio_stream_index_ &&
       packet->stream_index != active_video_stream_index_) {
     av_packet_unref(packet);
     av_packet_free(&packet);
-    return ReadPacket();  // 递归读取下一个数据包
+    return ReadPacket(cancel_generation);  // 递归读取下一个数据包
+  }
+
+  if (packet->stream_index == active_audio_stream_index_ &&
+      !AcceptAudioPacket(packet)) {
+    av_packet_free(&packet);
+    return ReadPacket(cancel_generation);
   }
 
   // ✅ 添加调试日志：输出 demuxer 读取的 packet PTS/DTS
   if (packet->stream_index == active_video_stream_index_) {
     AVStream* stream = format_context_->streams[packet->stream_index];
+    if (packet->pts != AV_NOPTS_VALUE) {
+      last_video_pts_us_ = av_rescale_q(packet->pts, stream->time_base,
+                                        AVRational{1, AV_TIME_BASE});
+    }
     double pts_ms = packet->pts != AV_NOPTS_VALUE
                         ? packet->pts * av_q2d(stream->time_base) * 1000.0
                         : -1.0;
@@ -137,11 +295,52 @@ Result<AVPacket*> Demuxer::ReadPacket() {
   return Result<AVPacket*>::Ok(packet);
 }
 
+Result<AVPacket*> Demuxer::ReadReplayPacket() {
+  auto result = replay_source_->ReadPacket();
+  if (!result.IsOk() || !result.Value()) {
+    return result;
+  }
+
+  // 抓取文件只包含当时活动流的数据包；活动流索引变化说明抓取期间
+  // 发生过 ABR 档位切换，跟随切换
+  AVPacket* packet = result.Value();
+  AVStream* stream = findStreamByIndex(packet->stream_index);
+  if (stream && packet->stream_index != active_video_stream_index_ &&
+      packet->stream_index != active_audio_stream_index_) {
+    if (stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+      active_video_stream_index_ = packet->stream_index;
+    } else if (stream->codecpar->codec_type == AVMEDIA_TYPE_AUDIO) {
+      active_audio_stream_index_ = packet->stream_index;
+    }
+  }
+  return result;
+}
+
+bool Demuxer::TakeReplaySeek(int64_t* timestamp_us, bool* backward) {
+  return replay_source_ &&
+         replay_source_->TakeRecordedSeek(timestamp_us, backward);
+}
+
 bool Demuxer::Seek(int64_t timestamp, bool backward) {
   if (!format_context_) {
     return false;  // Not opened
   }
 
+  if (replay_source_) {
+    return replay_source_->Seek(timestamp, backward);
+  }
+  if (raw_video_source_) {
+    return raw_video_source_->Seek(timestamp, backward);
+  }
+
+  // Seek 后旧档位的时间线失效，放弃尚未完成的档位切换
+  CancelVariantSwitch();
+  last_video_pts_us_ = AV_NOPTS_VALUE;
+  last_audio_end_us_ = AV_NOPTS_VALUE;
+  FreePackets(&spliced_audio_packets_);
+  audio_splicing_ = false;
+
+  BeginIo(io_timeout_ms_);
   int ret = av_seek_frame(format_context_, -1, timestamp,
                           backward ? AVSEEK_FLAG_BACKWARD : 0);
 
@@ -155,6 +354,76 @@ bool Demuxer::Seek(int64_t timestamp, bool backward) {
   return true;  // Seek successful
 }
 
+void Demuxer::Interrupt() {
+  interrupt_requested_.store(true);
+  if (replay_source_) {
+    replay_source_->Interrupt();
+  }
+}
+
+void Demuxer::ResetInterrupt() {
+  interrupt_requested_.store(false);
+  if (replay_source_) {
+    replay_source_->ResetInterrupt();
+  }
+}
+
+void Demuxer::CancelPendingIo() {
+  cancel_generation_.fetch_add(1);
+}
+
+void Demuxer::SetIoTimeouts(int64_t open_timeout_ms, int64_t io_timeout_ms) {
+  open_timeout_ms_ = open_timeout_ms;
+  io_timeout_ms_ = io_timeout_ms;
+}
+
+void Demuxer::BeginIo(int64_t timeout_ms) {
+  BeginIo(timeout_ms, cancel_generation_.load());
+}
+
+void Demuxer::BeginIo(int64_t timeout_ms, uint64_t cancel_generation) {
+  io_abort_.store(IoAbort::kNone);
+  io_generation_.store(cancel_generation);
+  // 本地文件不会无限阻塞，只给网络流设置截止时间
+  io_deadline_us_.store(is_network_ && timeout_ms > 0
+                            ? SteadyNowUs() + timeout_ms * 1000
+                            : 0);
+}
+
+int Demuxer::InterruptCallback(void* opaque) {
+  auto* self = static_cast<Demuxer*>(opaque);
+
+  IoAbort abort = IoAbort::kNone;
+  if (self->interrupt_requested_.load()) {
+    abort = IoAbort::kInterrupted;
+  } else if (self->cancel_generation_.load() != self->io_generation_.load()) {
+    abort = IoAbort::kCancelled;
+  } else {
+    int64_t deadline_us = self->io_deadline_us_.load();
+    if (deadline_us > 0 && SteadyNowUs() > deadline_us) {
+      abort = IoAbort::kTimedOut;
+    }
+  }
+
+  if (abort == IoAbort::kNone) {
+    return 0;
+  }
+  self->io_abort_.store(abort);
+  return 1;
+}
+
+ErrorCode Demuxer::MapIoError(int av_error) const {
+  switch (io_abort_.load()) {
+    case IoAbort::kInterrupted:
+    case IoAbort::kCancelled:
+      return ErrorCode::kCancelled;
+    case IoAbort::kTimedOut:
+      return ErrorCode::kNetworkTimeout;
+    default:
+      return MapFFmpegError(av_error);
+  }
+}
+
 AVDictionary* Demuxer::GetMetadata() const {
   if (!format_context_) {
     return nullptr;  // Not opened
@@ -201,6 +470,281 @@ void Demuxer::probeStreams() {
               video_streams_.size(), audio_streams_.size());
 }
 
+void Demuxer::probeVariants() {
+  variants_.clear();
+  current_variant_ = -1;
+  pending_variant_ = -1;
+
+  // 只有 HLS 会把每个 variant 导出为一个 AVProgram
+  if (!format_context_->iformat ||
+      std::strcmp(format_context_->iformat->name, "hls") != 0 ||
+      format_context_->nb_programs < 2) {
+    return;
+  }
+
+  std::vector<VariantStreams> candidates;
+  for (unsigned int i = 0; i < format_context_->nb_programs; ++i) {
+    AVProgram* program = format_context_->programs[i];
+    VariantStreams variant;
+
+    AVDictionaryEntry* bitrate =
+        av_dict_get(program->metadata, "variant_bitrate", nullptr, 0);
+    if (bitrate) {
+      variant.bandwidth_bps = std::strtoll(bitrate->value, nullptr, 10);
+    }
+
+    for (unsigned int j = 0; j < program->nb_stream_indexes; ++j) {
+      int index = static_cast<int>(program->stream_index[j]);
+      AVCodecParameters* par = format_context_->streams[index]->codecpar;
+      if (par->codec_type == AVMEDIA_TYPE_VIDEO &&
+          variant.video_stream_index < 0) {
+        variant.video_stream_index = index;
+        variant.width = par->width;
+        variant.height = par->height;
+      } else if (par->codec_type == AVMEDIA_TYPE_AUDIO &&
+                 variant.audio_stream_index < 0) {
+        variant.audio_stream_index = index;
+      }
+    }
+
+    if (variant.video_stream_index >= 0 && variant.bandwidth_bps > 0) {
+      candidates.push_back(variant);
+    }
+  }
+
+  if (candidates.size() < 2) {
+    return;
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const VariantStreams& a, const VariantStreams& b) {
+                     return a.bandwidth_bps < b.bandwidth_bps;
+                   });
+
+  // ✅ 只有编码参数一致的档位才能在不 flush、不重建解码器的情况下切换：
+  // 视频的编码器、profile、像素格式和分辨率（硬件解码的表面池按分辨率
+  // 分配），音频的编码器、profile、采样率和声道数都要相同
+  auto compatible = [this](const VariantStreams& a, const VariantStreams& b) {
+    const AVCodecParameters* video_a =
+        format_context_->streams[a.video_stream_index]->codecpar;
+    const AVCodecParameters* video_b =
+        format_context_->streams[b.video_stream_index]->codecpar;
+    if (video_a->codec_id != video_b->codec_id ||
+        video_a->profile != video_b->profile ||
+        video_a->format != video_b->format ||
+        video_a->width != video_b->width ||
+        video_a->height != video_b->height) {
+      return false;
+    }
+    if ((a.audio_stream_index < 0) != (b.audio_stream_index < 0)) {
+      return false;
+    }
+    if (a.audio_stream_index >= 0) {
+      const AVCodecParameters* audio_a =
+          format_context_->streams[a.audio_stream_index]->codecpar;
+      const AVCodecParameters* audio_b =
+          format_context_->streams[b.audio_stream_index]->codecpar;
+      if (audio_a->codec_id != audio_b->codec_id ||
+          audio_a->profile != audio_b->profile ||
+          audio_a->sample_rate != audio_b->sample_rate ||
+          audio_a->ch_layout.nb_channels != audio_b->ch_layout.nb_channels) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // 取可互相切换的档位最多的一组（相同时取码率较低的一组），从组内最低
+  // 码率起播（首屏更快）
+  size_t base = 0;
+  size_t base_group_size = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    size_t group_size = static_cast<size_t>(
+        std::count_if(candidates.begin(), candidates.end(),
+                      [&](const VariantStreams& v) {
+                        return compatible(candidates[i], v);
+                      }));
+    if (group_size > base_group_size) {
+      base = i;
+      base_group_size = group_size;
+    }
+  }
+
+  for (const auto& candidate : candidates) {
+    if (compatible(candidates[base], candidate)) {
+      variants_.push_back(candidate);
+    }
+  }
+
+  if (variants_.size() < 2) {
+    variants_.clear();
+    return;
+  }
+
+  // 只保留当前档位的流，其余档位的播放列表不再下载
+  for (unsigned int i = 0; i < format_context_->nb_streams; ++i) {
+    format_context_->streams[i]->discard = AVDISCARD_ALL;
+  }
+  current_variant_ = 0;
+  SetVariantDiscard(current_variant_, AVDISCARD_DEFAULT);
+  active_video_stream_index_ = variants_[0].video_stream_index;
+  active_audio_stream_index_ = variants_[0].audio_stream_index;
+
+  MODULE_INFO(LOG_MODULE_DEMUXER,
+              "HLS adaptive stream: {} of {} variants compatible, starting "
+              "at {} kbps ({}x{})",
+              variants_.size(), candidates.size(),
+              variants_[0].bandwidth_bps / 1000,
+              variants_[0].width, variants_[0].height);
+}
+
+std::vector<AbrController::Variant> Demuxer::GetVariants() const {
+  std::vector<AbrController::Variant> result;
+  result.reserve(variants_.size());
+  for (size_t i = 0; i < variants_.size(); ++i) {
+    AbrController::Variant variant;
+    variant.id = static_cast<int>(i);
+    variant.bandwidth_bps = variants_[i].bandwidth_bps;
+    variant.width = variants_[i].width;
+    variant.height = variants_[i].height;
+    result.push_back(variant);
+  }
+  return result;
+}
+
+bool Demuxer::RequestVariantSwitch(int variant_id) {
+  if (!format_context_ || variant_id < 0 ||
+      variant_id >= static_cast<int>(variants_.size())) {
+    return false;
+  }
+  if (variant_id == current_variant_) {
+    CancelVariantSwitch();
+    return true;
+  }
+  if (variant_id == pending_variant_) {
+    return true;
+  }
+
+  CancelVariantSwitch();
+  pending_variant_ = variant_id;
+  // 打开新档位的流，hls demuxer 会开始下载它的分片
+  SetVariantDiscard(pending_variant_, AVDISCARD_DEFAULT);
+
+  MODULE_DEBUG(LOG_MODULE_DEMUXER,
+               "ABR switch requested: variant {} -> {} ({} kbps)",
+               current_variant_, variant_id,
+               variants_[variant_id].bandwidth_bps / 1000);
+  return true;
+}
+
+void Demuxer::SetVariantDiscard(int variant_id, AVDiscard discard) {
+  const VariantStreams& variant = variants_[variant_id];
+  for (int index : {variant.video_stream_index, variant.audio_stream_index}) {
+    if (index >= 0) {
+      format_context_->streams[index]->discard = discard;
+    }
+  }
+}
+
+void Demuxer::CommitVariantSwitch() {
+  int old_variant = current_variant_;
+  current_variant_ = pending_variant_;
+  pending_variant_ = -1;
+
+  int old_audio_index = active_audio_stream_index_;
+  active_video_stream_index_ = variants_[current_variant_].video_stream_index;
+  active_audio_stream_index_ = variants_[current_variant_].audio_stream_index;
+
+  // 新档位暂存的音频接在旧档位已输出的音频之后；之后读到的新档位音频
+  // 也要跳过已输出的部分（共享音频流时不需要接续）
+  while (!held_audio_packets_.empty() &&
+         !ExtendsOutputAudio(held_audio_packets_.front())) {
+    av_packet_free(&held_audio_packets_.front());
+    held_audio_packets_.pop_front();
+  }
+  size_t spliced = held_audio_packets_.size();
+  spliced_audio_packets_.insert(spliced_audio_packets_.end(),
+                                held_audio_packets_.begin(),
+                                held_audio_packets_.end());
+  held_audio_packets_.clear();
+  audio_splicing_ = active_audio_stream_index_ != old_audio_index;
+
+  // 关闭旧档位（与新档位共享的音频流除外）
+  SetVariantDiscard(old_variant, AVDISCARD_ALL);
+  SetVariantDiscard(current_variant_, AVDISCARD_DEFAULT);
+
+  MODULE_INFO(LOG_MODULE_DEMUXER,
+              "ABR switched at segment boundary: variant {} -> {} "
+              "({} kbps, {}x{}, {} audio packets spliced)",
+              old_variant, current_variant_,
+              variants_[current_variant_].bandwidth_bps / 1000,
+              variants_[current_variant_].width,
+              variants_[current_variant_].height, spliced);
+}
+
+void Demuxer::CancelVariantSwitch() {
+  if (pending_variant_ < 0) {
+    return;
+  }
+  SetVariantDiscard(pending_variant_, AVDISCARD_ALL);
+  SetVariantDiscard(current_variant_, AVDISCARD_DEFAULT);
+  pending_variant_ = -1;
+  FreePackets(&held_audio_packets_);
+}
+
+bool Demuxer::PacketTimeUs(const AVPacket* packet,
+                           int64_t* pts_us,
+                           int64_t* end_us) const {
+  if (packet->pts == AV_NOPTS_VALUE) {
+    return false;
+  }
+  AVRational time_base = format_context_->streams[packet->stream_index]
+                             ->time_base;
+  *pts_us = av_rescale_q(packet->pts, time_base, AVRational{1, AV_TIME_BASE});
+  *end_us = *pts_us;
+  if (packet->duration > 0) {
+    *end_us += av_rescale_q(packet->duration, time_base,
+                            AVRational{1, AV_TIME_BASE});
+  }
+  return true;
+}
+
+bool Demuxer::AcceptAudioPacket(const AVPacket* packet) {
+  int64_t pts_us = 0;
+  int64_t end_us = 0;
+  if (!PacketTimeUs(packet, &pts_us, &end_us)) {
+    return true;
+  }
+  // 切换后新档位可能从较早的位置开始：跳过旧档位已经输出的部分
+  if (audio_splicing_) {
+    if (!ExtendsOutputAudio(packet)) {
+      return false;
+    }
+    audio_splicing_ = false;
+  }
+  last_audio_end_us_ = end_us;
+
+  // 暂存的新档位音频中已被旧档位覆盖的部分不再需要
+  while (!held_audio_packets_.empty() &&
+         !ExtendsOutputAudio(held_audio_packets_.front())) {
+    av_packet_free(&held_audio_packets_.front());
+    held_audio_packets_.pop_front();
+  }
+  return true;
+}
+
+bool Demuxer::ExtendsOutputAudio(const AVPacket* packet) const {
+  int64_t pts_us = 0;
+  int64_t end_us = 0;
+  if (last_audio_end_us_ == AV_NOPTS_VALUE ||
+      !PacketTimeUs(packet, &pts_us, &end_us)) {
+    return true;
+  }
+  // 两个档位的音频帧边界可能错开：包的中点在已输出部分之后才保留，
+  // 接缝处的重叠或空档不超过半个包
+  return pts_us + (end_us - pts_us) / 2 > last_audio_end_us_;
+}
+
 bool Demuxer::IsNetworkProtocol(const std::string& url) const {
   return url.find("http://") == 0 || url.find("https://") == 0 ||
          url.find("rtsp://") == 0 || url.find("rtmp://") == 0 ||
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "player/common/error.h"
+#include "player/demuxer/abr_controller.h"
+#include "player/demuxer/raw_video_source.h"
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -15,6 +20,8 @@ extern "C" {
 
 namespace zenplay {
 
+class PacketReplaySource;
+
 class Demuxer {
  public:
   Demuxer();
@@ -22,7 +29,8 @@ class Demuxer {
 
   /**
    * @brief 打开媒体文件或流
-   * @param url 文件路径或网络 URL
+   * @param url 文件路径或网络 URL；以 .zpcap 结尾时作为数据包抓取文件回放，
+   *        .y4m / .yuv 作为未压缩视频源内存映射（见 raw_video_source()）
    * @return Result<void> 成功返回 Ok()，失败返回详细错误信息
    */
   Result<void> Open(const std::string& url);
@@ -39,6 +47,15 @@ class Demuxer {
    */
   Result<AVPacket*> ReadPacket();
 
+  /**
+   * @brief 读取下一个数据包，以调用方事先取得的取消代数判断是否被打断
+   * @param cancel_generation 调用方获取 demux 锁之前由
+   *        io_cancel_generation() 取得的代数
+   * @note 取得代数之后、开始读取之前发生的 CancelPendingIo() 同样会打断
+   *       这次读取（无参版本在开始读取时才取代数，会漏掉这次取消）
+   */
+  Result<AVPacket*> ReadPacket(uint64_t cancel_generation);
+
   /**
    * @brief 跳转到指定时间戳
    * @param timestamp 目标时间戳（微秒）
@@ -47,6 +64,61 @@ class Demuxer {
    */
   bool Seek(int64_t timestamp, bool backward = false);
 
+  /**
+   * @brief 唤醒阻塞中的 Open() / ReadPacket() / Seek()（停止播放时调用）
+   * @note 网络 I/O 经 AVIOInterruptCB 立即返回 kCancelled，回放源停止等待；
+   *       之后的操作都立即失败，直到调用 ResetInterrupt()
+   */
+  void Interrupt();
+  void ResetInterrupt();
+
+  /**
+   * @brief 只打断当前正在阻塞的那一次 I/O 操作（Seek 时调用）
+   * @note 被打断的 ReadPacket() 返回 kCancelled，之后的操作不受影响；
+   *       调用方随后获取 demux 锁时不必等待网络超时
+   */
+  void CancelPendingIo();
+
+  /**
+   * @brief 当前的取消代数（每次 CancelPendingIo() 递增）
+   */
+  uint64_t io_cancel_generation() const { return cancel_generation_.load(); }
+
+  /**
+   * @brief 设置单次 I/O 操作的截止时间（仅网络流，Open() 之前调用）
+   * @param open_timeout_ms 打开和探测流信息的截止时间，<=0 表示不限制
+   * @param io_timeout_ms 单次读包 / Seek 的截止时间，<=0 表示不限制
+   * @note 超时的操作返回 kNetworkTimeout，不依赖各协议自己的超时选项
+   */
+  void SetIoTimeouts(int64_t open_timeout_ms, int64_t io_timeout_ms);
+
+  /**
+   * @brief 是否正在回放数据包抓取文件
+   */
+  bool IsReplay() const { return replay_source_ != nullptr; }
+
+  /**
+   * @brief 回放时取出抓取期间记录的 Seek
+   * @note ReadPacket() 读到 Seek 记录时返回 kCancelled，调用方随后
+   *       调用本函数，按取出的目标照常执行 Seek（清空队列、刷新解码器）
+   * @return 不是回放或没有待执行的 Seek 时返回 false
+   */
+  bool TakeReplaySeek(int64_t* timestamp_us, bool* backward);
+
+  /**
+   * @brief 设置裸 YUV 的帧格式（Open() 之前调用，Y4M 不需要）
+   */
+  void SetRawVideoOptions(const RawVideoSource::Options& options) {
+    raw_video_options_ = options;
+  }
+
+  /**
+   * @brief 未压缩视频源（仅打开 .y4m / .yuv 时存在）
+   * @note 此时没有数据包，ReadPacket() 直接返回 EOF；调用方用
+   *       ReadFrame() 取帧，不经过解码器。Seek() 同样作用于它
+   */
+  RawVideoSource* raw_video_source() const { return raw_video_source_.get(); }
+
   AVDictionary* GetMetadata() const;
   int64_t GetDuration() const;  // 返回总时长（毫秒）
 
@@ -55,16 +127,135 @@ class Demuxer {
 
   AVStream* findStreamByIndex(int index) const;
 
+  /**
+   * @brief 获取可切换的码率档位（仅 HLS 多码率流）
+   * @return 档位列表；单码率流返回空列表
+   * @note 只包含与起播档位编码参数（编码器、profile、像素格式、分辨率，
+   *       音频的采样率和声道数）一致的档位，切换时无需重建或 flush 解码器
+   */
+  std::vector<AbrController::Variant> GetVariants() const;
+
+  /**
+   * @brief 当前正在输出的档位 id，非多码率流返回 -1
+   */
+  int current_variant() const { return current_variant_; }
+
+  /**
+   * @brief 请求切换到指定档位
+   *
+   * 立即开始下载新档位的分片，但在新档位的第一个视频关键帧
+   * （即分片边界）到达之前仍然输出旧档位的数据包，保证切换无缝。
+   * 新档位的音频在此期间暂存，切换时接在旧档位最后输出的音频之后，
+   * 不会因为旧档位音频停止下载而留下空档。
+   *
+   * @param variant_id GetVariants() 返回的档位 id
+   * @return 请求被接受返回 true
+   * @note 只能在调用 ReadPacket() 的线程中调用
+   */
+  bool RequestVariantSwitch(int variant_id);
+
+  bool IsVariantSwitchPending() const { return pending_variant_ >= 0; }
+
  private:
+  /**
+   * @brief 一个 HLS variant 对应的流
+   */
+  struct VariantStreams {
+    int64_t bandwidth_bps = 0;
+    int video_stream_index = -1;
+    int audio_stream_index = -1;
+    int width = 0;
+    int height = 0;
+  };
+
+  // I/O 被打断的原因（中断回调记录，用于区分 FFmpeg 返回的 AVERROR_EXIT）
+  enum class IoAbort { kNone, kInterrupted, kCancelled, kTimedOut };
+
+  /**
+   * @brief 开始一次可能阻塞的 I/O 操作：记录取消代数和截止时间
+   * @param cancel_generation 与当前代数不同时操作立即被打断
+   */
+  void BeginIo(int64_t timeout_ms);
+  void BeginIo(int64_t timeout_ms, uint64_t cancel_generation);
+
+  /**
+   * @brief AVIOInterruptCB 回调，FFmpeg 在阻塞 I/O 期间周期性调用
+   */
+  static int InterruptCallback(void* opaque);
+
+  /**
+   * @brief 失败的 I/O 操作对应的错误码：被打断为 kCancelled，
+   *        超时为 kNetworkTimeout，其余按 FFmpeg 错误映射
+   */
+  ErrorCode MapIoError(int av_error) const;
+
+  Result<void> OpenReplay(const std::string& path);
+  Result<AVPacket*> ReadReplayPacket();
+  Result<void> OpenRawVideo(const std::string& path);
+
   void probeStreams();
+  void probeVariants();
+  void SetVariantDiscard(int variant_id, AVDiscard discard);
+  void CommitVariantSwitch();
+  void CancelVariantSwitch();
+
+  /**
+   * @brief 数据包的 PTS 及结束时间（微秒），没有 PTS 时返回 false
+   */
+  bool PacketTimeUs(const AVPacket* packet,
+                    int64_t* pts_us,
+                    int64_t* end_us) const;
+
+  /**
+   * @brief 活动音频包即将输出：切换后丢弃与已输出音频重叠的包，
+   *        记录输出到的位置，并丢弃已被旧档位覆盖的暂存音频
+   * @return 包应当丢弃时返回 false
+   */
+  bool AcceptAudioPacket(const AVPacket* packet);
+
+  /**
+   * @brief 包的后半段是否在已输出音频之后（接续时保留）
+   */
+  bool ExtendsOutputAudio(const AVPacket* packet) const;
   bool IsNetworkProtocol(const std::string& url) const;
 
   AVFormatContext* format_context_;
   std::vector<int> video_streams_;
   std::vector<int> audio_streams_;
 
-  int active_video_stream_index_ = -1;
-  int active_audio_stream_index_ = -1;
+  // 解码线程也会读取活动流索引，ABR 切换时在 demux 线程修改
+  std::atomic<int> active_video_stream_index_{-1};
+  std::atomic<int> active_audio_stream_index_{-1};
+
+  // ✅ HLS 多码率档位（按带宽升序，下标即档位 id）
+  std::vector<VariantStreams> variants_;
+  int current_variant_ = -1;
+  int pending_variant_ = -1;
+  int64_t last_video_pts_us_ = AV_NOPTS_VALUE;  // 最近输出的视频包 PTS
+  int64_t last_audio_end_us_ = AV_NOPTS_VALUE;  // 最近输出的音频包结束时间
+  // 切换中新档位的音频包，提交时接在旧档位已输出的音频之后
+  std::deque<AVPacket*> held_audio_packets_;
+  // 已提交切换、先于新读取输出的音频包
+  std::deque<AVPacket*> spliced_audio_packets_;
+  bool audio_splicing_ = false;  // 切换后还没有输出接续的音频
+
+  // ✅ 可打断的网络 I/O（AVIOInterruptCB）
+  // 中断回调可能在 FFmpeg 的协议线程（如 async:）中调用，状态均为原子变量
+  std::atomic<bool> interrupt_requested_{false};   // Interrupt()，持续生效
+  std::atomic<uint64_t> cancel_generation_{0};     // CancelPendingIo() 递增
+  std::atomic<uint64_t> io_generation_{0};         // 当前操作开始时的代数
+  std::atomic<int64_t> io_deadline_us_{0};         // 当前操作截止时间，0 无
+  std::atomic<IoAbort> io_abort_{IoAbort::kNone};  // 当前操作被打断的原因
+  bool is_network_ = false;
+  int64_t open_timeout_ms_ = 15000;
+  int64_t io_timeout_ms_ = 5000;
+
+  // ✅ 数据包抓取文件回放源（仅回放 .zpcap 时存在）
+  std::unique_ptr<PacketReplaySource> replay_source_;
+
+  // ✅ 未压缩视频源（仅打开 .y4m / .yuv 时存在）
+  std::unique_ptr<RawVideoSource> raw_video_source_;
+  RawVideoSource::Options raw_video_options_;
 
   static std::once_flag init_once_flag_;
 };
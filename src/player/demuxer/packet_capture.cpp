@@ -0,0 +1,745 @@
+#include "player/demuxer/packet_capture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/mem.h>
+}
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+// 调用方阻塞（暂停、队列满）导致回放落后超过该值时，重新对齐时间基准
+constexpr int64_t kMaxReplayLagUs = 200 * 1000;
+
+// Seek 目标与抓取时记录的 Seek 相差在该范围内视为同一次 Seek
+// （调用方以毫秒发起 Seek，会丢失微秒精度）
+constexpr int64_t kSeekMatchToleranceUs = 1000;
+
+constexpr size_t kWriteBufferSize = 1 << 20;  // 1MB stdio 缓冲
+
+int64_t FileTell(std::FILE* file) {
+#ifdef OS_WIN
+  return _ftelli64(file);
+#else
+  return ftello(file);
+#endif
+}
+
+bool FileSeek(std::FILE* file, int64_t offset) {
+#ifdef OS_WIN
+  return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+template <typename T>
+bool ReadPod(std::FILE* file, T* value) {
+  return std::fread(value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+bool WritePod(std::FILE* file, const T& value) {
+  return std::fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+capture::StreamRecord MakeStreamRecord(const AVStream* stream) {
+  capture::StreamRecord record{};
+  const AVCodecParameters* par = stream->codecpar;
+  record.codec_type = par->codec_type;
+  record.codec_id = par->codec_id;
+  record.codec_tag = par->codec_tag;
+  record.format = par->format;
+  record.bit_rate = par->bit_rate;
+  record.profile = par->profile;
+  record.level = par->level;
+  record.width = par->width;
+  record.height = par->height;
+  record.sample_aspect_num = par->sample_aspect_ratio.num;
+  record.sample_aspect_den = par->sample_aspect_ratio.den;
+  record.field_order = par->field_order;
+  record.color_range = par->color_range;
+  record.color_primaries = par->color_primaries;
+  record.color_trc = par->color_trc;
+  record.color_space = par->color_space;
+  record.chroma_location = par->chroma_location;
+  record.sample_rate = par->sample_rate;
+  record.channels = par->ch_layout.nb_channels;
+  record.block_align = par->block_align;
+  record.frame_size = par->frame_size;
+  record.initial_padding = par->initial_padding;
+  record.channel_mask = par->ch_layout.order == AV_CHANNEL_ORDER_NATIVE
+                            ? par->ch_layout.u.mask
+                            : 0;
+  record.time_base_num = stream->time_base.num;
+  record.time_base_den = stream->time_base.den;
+  record.avg_frame_rate_num = stream->avg_frame_rate.num;
+  record.avg_frame_rate_den = stream->avg_frame_rate.den;
+  record.r_frame_rate_num = stream->r_frame_rate.num;
+  record.r_frame_rate_den = stream->r_frame_rate.den;
+  record.start_time = stream->start_time;
+  record.duration = stream->duration;
+  record.extradata_size =
+      par->extradata && par->extradata_size > 0 ? par->extradata_size : 0;
+  return record;
+}
+
+void ApplyStreamRecord(const capture::StreamRecord& record, AVStream* stream) {
+  AVCodecParameters* par = stream->codecpar;
+  par->codec_type = static_cast<AVMediaType>(record.codec_type);
+  par->codec_id = static_cast<AVCodecID>(record.codec_id);
+  par->codec_tag = record.codec_tag;
+  par->format = record.format;
+  par->bit_rate = record.bit_rate;
+  par->profile = record.profile;
+  par->level = record.level;
+  par->width = record.width;
+  par->height = record.height;
+  par->sample_aspect_ratio = {record.sample_aspect_num,
+                              record.sample_aspect_den};
+  par->field_order = static_cast<AVFieldOrder>(record.field_order);
+  par->color_range = static_cast<AVColorRange>(record.color_range);
+  par->color_primaries =
+      static_cast<AVColorPrimaries>(record.color_primaries);
+  par->color_trc = static_cast<AVColorTransferCharacteristic>(record.color_trc);
+  par->color_space = static_cast<AVColorSpace>(record.color_space);
+  par->chroma_location = static_cast<AVChromaLocation>(record.chroma_location);
+  par->sample_rate = record.sample_rate;
+  par->block_align = record.block_align;
+  par->frame_size = record.frame_size;
+  par->initial_padding = record.initial_padding;
+  if (record.channels > 0) {
+    av_channel_layout_uninit(&par->ch_layout);
+    if (record.channel_mask != 0) {
+      av_channel_layout_from_mask(&par->ch_layout, record.channel_mask);
+    } else {
+      av_channel_layout_default(&par->ch_layout, record.channels);
+    }
+  }
+
+  stream->time_base = {record.time_base_num, record.time_base_den};
+  stream->avg_frame_rate = {record.avg_frame_rate_num,
+                            record.avg_frame_rate_den};
+  stream->r_frame_rate = {record.r_frame_rate_num, record.r_frame_rate_den};
+  stream->start_time = record.start_time;
+  stream->duration = record.duration;
+}
+
+}  // namespace
+
+// ============================================================================
+// PacketCaptureWriter
+// ============================================================================
+
+PacketCaptureWriter::~PacketCaptureWriter() {
+  Close();
+}
+
+Result<void> PacketCaptureWriter::Open(
+    const std::string& path,
+    const std::vector<const AVStream*>& streams,
+    int64_t duration_us,
+    int active_video_stream,
+    int active_audio_stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Close_Locked();
+
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    return Result<void>::Err(ErrorCode::kFileError,
+                             "Failed to create capture file: " + path);
+  }
+  file_buffer_.resize(kWriteBufferSize);
+  std::setvbuf(file_, file_buffer_.data(), _IOFBF, file_buffer_.size());
+
+  capture::FileHeader header{};
+  std::memcpy(header.magic, capture::kMagic, sizeof(header.magic));
+  header.version = capture::kVersion;
+  header.stream_count = static_cast<uint32_t>(streams.size());
+  header.start_wall_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  header.duration_us = duration_us;
+  header.active_video_stream = active_video_stream;
+  header.active_audio_stream = active_audio_stream;
+
+  bool ok = WritePod(file_, header);
+  for (const AVStream* stream : streams) {
+    if (!ok) {
+      break;
+    }
+    capture::StreamRecord record = MakeStreamRecord(stream);
+    ok = WritePod(file_, record);
+    if (ok && record.extradata_size > 0) {
+      ok = std::fwrite(stream->codecpar->extradata, 1, record.extradata_size,
+                       file_) == record.extradata_size;
+    }
+  }
+  if (!ok) {
+    Close_Locked();
+    return Result<void>::Err(ErrorCode::kFileError,
+                             "Failed to write capture header: " + path);
+  }
+
+  path_ = path;
+  start_time_ = std::chrono::steady_clock::now();
+  packet_count_ = 0;
+  bytes_written_ = 0;
+  MODULE_INFO(LOG_MODULE_DEMUXER, "Packet capture started: {} ({} streams)",
+              path_, streams.size());
+  return Result<void>::Ok();
+}
+
+Result<void> PacketCaptureWriter::WritePacket(const AVPacket* packet) {
+  return WritePacket(packet, ElapsedUs());
+}
+
+Result<void> PacketCaptureWriter::WritePacket(const AVPacket* packet,
+                                              int64_t arrival_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capture::RecordHeader header{};
+  header.type = static_cast<uint32_t>(capture::RecordType::kPacket);
+  header.stream_index = packet->stream_index;
+  header.arrival_us = arrival_us;
+  header.pts = packet->pts;
+  header.dts = packet->dts;
+  header.duration = packet->duration;
+  header.flags = packet->flags;
+  header.value = packet->size;
+  auto result = WriteRecord_Locked(header, packet->data);
+  if (result.IsOk()) {
+    ++packet_count_;
+  }
+  return result;
+}
+
+Result<void> PacketCaptureWriter::WriteEndOfStream() {
+  return WriteEvent(capture::RecordType::kEndOfStream, ElapsedUs());
+}
+
+Result<void> PacketCaptureWriter::WriteError(ErrorCode code) {
+  return WriteEvent(capture::RecordType::kError, ElapsedUs(), AV_NOPTS_VALUE,
+                    0, static_cast<int32_t>(code));
+}
+
+Result<void> PacketCaptureWriter::WritePause() {
+  return WritePause(ElapsedUs());
+}
+
+Result<void> PacketCaptureWriter::WritePause(int64_t arrival_us) {
+  return WriteEvent(capture::RecordType::kPause, arrival_us);
+}
+
+Result<void> PacketCaptureWriter::WriteResume() {
+  return WriteResume(ElapsedUs());
+}
+
+Result<void> PacketCaptureWriter::WriteResume(int64_t arrival_us) {
+  return WriteEvent(capture::RecordType::kResume, arrival_us);
+}
+
+Result<void> PacketCaptureWriter::WriteSeek(int64_t timestamp_us,
+                                            bool backward) {
+  return WriteSeek(timestamp_us, backward, ElapsedUs());
+}
+
+Result<void> PacketCaptureWriter::WriteSeek(int64_t timestamp_us,
+                                            bool backward,
+                                            int64_t arrival_us) {
+  return WriteEvent(capture::RecordType::kSeek, arrival_us, timestamp_us,
+                    backward ? 1 : 0);
+}
+
+Result<void> PacketCaptureWriter::WriteEvent(capture::RecordType type,
+                                             int64_t arrival_us,
+                                             int64_t timestamp_us,
+                                             int32_t flags,
+                                             int32_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capture::RecordHeader header{};
+  header.type = static_cast<uint32_t>(type);
+  header.stream_index = -1;
+  header.arrival_us = arrival_us;
+  header.pts = timestamp_us;
+  header.dts = AV_NOPTS_VALUE;
+  header.flags = flags;
+  header.value = value;
+  return WriteRecord_Locked(header, nullptr);
+}
+
+Result<void> PacketCaptureWriter::WriteRecord_Locked(
+    const capture::RecordHeader& header,
+    const uint8_t* payload) {
+  if (!file_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Capture file not open");
+  }
+
+  size_t payload_size = 0;
+  if (header.type == static_cast<uint32_t>(capture::RecordType::kPacket)) {
+    payload_size = static_cast<size_t>(header.value);
+  }
+
+  bool ok = WritePod(file_, header);
+  if (ok && payload_size > 0) {
+    ok = std::fwrite(payload, 1, payload_size, file_) == payload_size;
+  }
+  if (!ok) {
+    // 写入失败后关闭文件，之后的写入返回 kNotInitialized
+    Close_Locked();
+    return Result<void>::Err(ErrorCode::kFileError,
+                             "Failed to write capture record: " + path_);
+  }
+  bytes_written_ += sizeof(header) + payload_size;
+  return Result<void>::Ok();
+}
+
+void PacketCaptureWriter::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Close_Locked();
+}
+
+bool PacketCaptureWriter::IsOpen() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return file_ != nullptr;
+}
+
+uint64_t PacketCaptureWriter::packet_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return packet_count_;
+}
+
+uint64_t PacketCaptureWriter::bytes_written() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_written_;
+}
+
+void PacketCaptureWriter::Close_Locked() {
+  if (!file_) {
+    return;
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+  file_buffer_.clear();
+  file_buffer_.shrink_to_fit();
+  MODULE_INFO(LOG_MODULE_DEMUXER,
+              "Packet capture finished: {} ({} packets, {} bytes)", path_,
+              packet_count_, bytes_written_);
+}
+
+int64_t PacketCaptureWriter::ElapsedUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start_time_)
+      .count();
+}
+
+// ============================================================================
+// PacketReplaySource
+// ============================================================================
+
+PacketReplaySource::~PacketReplaySource() {
+  Close();
+}
+
+Result<void> PacketReplaySource::Open(const std::string& path,
+                                      AVFormatContext** format_context) {
+  return Open(path, format_context, Options{});
+}
+
+Result<void> PacketReplaySource::Open(const std::string& path,
+                                      AVFormatContext** format_context,
+                                      const Options& options) {
+  Close();
+
+  file_ = std::fopen(path.c_str(), "rb");
+  if (!file_) {
+    return Result<void>::Err(ErrorCode::kFileNotFound,
+                             "Failed to open capture file: " + path);
+  }
+
+  capture::FileHeader header{};
+  if (!ReadPod(file_, &header) ||
+      std::memcmp(header.magic, capture::kMagic, sizeof(header.magic)) != 0) {
+    Close();
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Not a packet capture file: " + path);
+  }
+  if (header.version < capture::kMinVersion ||
+      header.version > capture::kVersion) {
+    Close();
+    return Result<void>::Err(
+        ErrorCode::kInvalidFormat,
+        "Unsupported capture version " + std::to_string(header.version));
+  }
+
+  AVFormatContext* context = avformat_alloc_context();
+  if (!context) {
+    Close();
+    return Result<void>::Err(ErrorCode::kOutOfMemory,
+                             "Failed to allocate AVFormatContext");
+  }
+  auto streams_result = ReadStreams(context, header.stream_count);
+  if (!streams_result.IsOk()) {
+    avformat_free_context(context);
+    Close();
+    return streams_result;
+  }
+  context->duration = header.duration_us;
+
+  options_ = options;
+  if (options_.speed <= 0.0) {
+    options_.speed = 1.0;
+  }
+  records_offset_ = FileTell(file_);
+  start_wall_time_us_ = header.start_wall_time_us;
+  active_video_stream_ = header.active_video_stream;
+  active_audio_stream_ = header.active_audio_stream;
+  BuildSeekIndex();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    interrupted_ = false;
+    has_epoch_ = false;
+    paused_us_ = 0;
+    pause_start_us_ = AV_NOPTS_VALUE;
+    recorded_seek_ = RecordedSeek{};
+  }
+
+  *format_context = context;
+  MODULE_INFO(LOG_MODULE_DEMUXER,
+              "Packet replay opened: {} ({} streams, {} seek points, "
+              "timing: {})",
+              path, header.stream_count, seek_points_.size(),
+              options_.honor_arrival_timing ? "original" : "unpaced");
+  return Result<void>::Ok();
+}
+
+Result<void> PacketReplaySource::ReadStreams(AVFormatContext* format_context,
+                                             uint32_t stream_count) {
+  time_bases_.clear();
+  for (uint32_t i = 0; i < stream_count; ++i) {
+    capture::StreamRecord record{};
+    if (!ReadPod(file_, &record)) {
+      return Result<void>::Err(ErrorCode::kInvalidFormat,
+                               "Truncated capture stream table");
+    }
+
+    AVStream* stream = avformat_new_stream(format_context, nullptr);
+    if (!stream) {
+      return Result<void>::Err(ErrorCode::kOutOfMemory,
+                               "Failed to allocate AVStream");
+    }
+    ApplyStreamRecord(record, stream);
+
+    if (record.extradata_size > 0) {
+      AVCodecParameters* par = stream->codecpar;
+      par->extradata = static_cast<uint8_t*>(
+          av_mallocz(record.extradata_size + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (!par->extradata) {
+        return Result<void>::Err(ErrorCode::kOutOfMemory,
+                                 "Failed to allocate extradata");
+      }
+      par->extradata_size = static_cast<int>(record.extradata_size);
+      if (std::fread(par->extradata, 1, record.extradata_size, file_) !=
+          record.extradata_size) {
+        return Result<void>::Err(ErrorCode::kInvalidFormat,
+                                 "Truncated capture extradata");
+      }
+    }
+    time_bases_.push_back(stream->time_base);
+  }
+  return Result<void>::Ok();
+}
+
+void PacketReplaySource::BuildSeekIndex() {
+  // 一次性扫描记录头（跳过负载），收集视频关键帧位置；
+  // 没有视频流时退化为所有关键帧
+  seek_points_.clear();
+  std::vector<SeekPoint> any_key_points;
+
+  FileSeek(file_, records_offset_);
+  capture::RecordHeader header{};
+  while (true) {
+    int64_t offset = FileTell(file_);
+    if (!ReadPod(file_, &header) || !IsValidRecord(header)) {
+      break;
+    }
+    bool is_packet =
+        header.type == static_cast<uint32_t>(capture::RecordType::kPacket);
+    if (is_packet && (header.flags & AV_PKT_FLAG_KEY) &&
+        header.pts != AV_NOPTS_VALUE) {
+      SeekPoint point;
+      point.offset = offset;
+      point.pts_us = ToMicroseconds(header.stream_index, header.pts);
+      any_key_points.push_back(point);
+      if (header.stream_index == active_video_stream_) {
+        seek_points_.push_back(point);
+      }
+    }
+    if (is_packet && header.value > 0 &&
+        !FileSeek(file_, FileTell(file_) + header.value)) {
+      break;
+    }
+  }
+
+  if (seek_points_.empty()) {
+    seek_points_ = std::move(any_key_points);
+  }
+  FileSeek(file_, records_offset_);
+}
+
+bool PacketReplaySource::IsValidRecord(
+    const capture::RecordHeader& header) const {
+  if (header.type != static_cast<uint32_t>(capture::RecordType::kPacket)) {
+    return true;
+  }
+  return header.value >= 0 && header.value <= capture::kMaxPayloadBytes &&
+         header.stream_index >= 0 &&
+         header.stream_index < static_cast<int>(time_bases_.size());
+}
+
+void PacketReplaySource::ApplyPauseEvent(const capture::RecordHeader& header) {
+  if (header.type == static_cast<uint32_t>(capture::RecordType::kPause)) {
+    if (pause_start_us_ == AV_NOPTS_VALUE) {
+      pause_start_us_ = header.arrival_us;
+    }
+    return;
+  }
+  // 没有对应暂停记录的恢复（例如 Seek 落在暂停期间）忽略
+  if (pause_start_us_ != AV_NOPTS_VALUE) {
+    paused_us_ += std::max<int64_t>(0, header.arrival_us - pause_start_us_);
+    pause_start_us_ = AV_NOPTS_VALUE;
+  }
+}
+
+int64_t PacketReplaySource::ToMicroseconds(int stream_index,
+                                           int64_t ts) const {
+  return av_rescale_q(ts, time_bases_[stream_index],
+                      AVRational{1, AV_TIME_BASE});
+}
+
+Result<AVPacket*> PacketReplaySource::ReadPacket() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!file_) {
+    return Result<AVPacket*>::Err(ErrorCode::kNotInitialized,
+                                  "Replay source not open");
+  }
+
+  while (true) {
+    capture::RecordHeader header{};
+    if (!ReadPod(file_, &header)) {
+      // 文件结束（抓取被中途截断时没有 EOF 记录）
+      return Result<AVPacket*>::Ok(nullptr);
+    }
+    if (!IsValidRecord(header)) {
+      return Result<AVPacket*>::Err(
+          ErrorCode::kInvalidFormat,
+          "Corrupt capture record (size " + std::to_string(header.value) +
+              ", stream " + std::to_string(header.stream_index) + ")");
+    }
+
+    auto type = static_cast<capture::RecordType>(header.type);
+    if (type == capture::RecordType::kPause ||
+        type == capture::RecordType::kResume) {
+      ApplyPauseEvent(header);
+      continue;
+    }
+
+    AVPacket* packet = nullptr;
+    if (type == capture::RecordType::kPacket) {
+      packet = av_packet_alloc();
+      if (!packet || av_new_packet(packet, header.value) < 0) {
+        av_packet_free(&packet);
+        return Result<AVPacket*>::Err(ErrorCode::kOutOfMemory,
+                                      "Failed to allocate replay packet");
+      }
+      if (header.value > 0 &&
+          std::fread(packet->data, 1, header.value, file_) !=
+              static_cast<size_t>(header.value)) {
+        av_packet_free(&packet);
+        return Result<AVPacket*>::Ok(nullptr);  // 截断的最后一个包
+      }
+      packet->stream_index = header.stream_index;
+      packet->pts = header.pts;
+      packet->dts = header.dts;
+      packet->duration = header.duration;
+      packet->flags = header.flags;
+    }
+
+    int64_t arrival_us = header.arrival_us - paused_us_;
+    if (!WaitForArrival(lock, arrival_us)) {
+      av_packet_free(&packet);  // 等待期间发生 Seek，读取新位置的记录
+      continue;
+    }
+
+    switch (type) {
+      case capture::RecordType::kPacket:
+        return Result<AVPacket*>::Ok(packet);
+      case capture::RecordType::kEndOfStream:
+        return Result<AVPacket*>::Ok(nullptr);
+      case capture::RecordType::kError:
+        return Result<AVPacket*>::Err(static_cast<ErrorCode>(header.value),
+                                      "Replayed read error");
+      case capture::RecordType::kSeek:
+        recorded_seek_.valid = true;
+        recorded_seek_.notified = false;
+        recorded_seek_.timestamp_us = header.pts;
+        recorded_seek_.backward = (header.flags & 1) != 0;
+        recorded_seek_.offset = FileTell(file_);
+        recorded_seek_.arrival_us = arrival_us;
+        return Result<AVPacket*>::Err(ErrorCode::kCancelled,
+                                      "Replayed seek");
+      default:
+        return Result<AVPacket*>::Err(
+            ErrorCode::kInvalidFormat,
+            "Unknown capture record type " + std::to_string(header.type));
+    }
+  }
+}
+
+bool PacketReplaySource::WaitForArrival(std::unique_lock<std::mutex>& lock,
+                                        int64_t arrival_us) {
+  if (!options_.honor_arrival_timing || interrupted_) {
+    return true;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto scaled = std::chrono::microseconds(
+      static_cast<int64_t>(arrival_us / options_.speed));
+  auto now = Clock::now();
+  if (!has_epoch_) {
+    // 第一条记录（或 Seek 后第一条）立即返回，以它为时间基准
+    epoch_ = now - scaled;
+    has_epoch_ = true;
+    return true;
+  }
+
+  auto target = epoch_ + scaled;
+  if (now - target > std::chrono::microseconds(kMaxReplayLagUs)) {
+    // 调用方阻塞过久，平移基准，保持后续记录之间的原始间隔
+    epoch_ += now - target;
+    return true;
+  }
+
+  uint64_t generation = seek_generation_;
+  wait_cv_.wait_until(lock, target, [this, generation]() {
+    return interrupted_ || seek_generation_ != generation;
+  });
+  return seek_generation_ == generation;
+}
+
+bool PacketReplaySource::TakeRecordedSeek(int64_t* timestamp_us,
+                                          bool* backward) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!recorded_seek_.valid || recorded_seek_.notified) {
+    return false;
+  }
+  recorded_seek_.notified = true;
+  *timestamp_us = recorded_seek_.timestamp_us;
+  *backward = recorded_seek_.backward;
+  return true;
+}
+
+bool PacketReplaySource::Seek(int64_t timestamp_us, bool backward) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_) {
+    return false;
+  }
+
+  RecordedSeek recorded = recorded_seek_;
+  recorded_seek_ = RecordedSeek{};
+  pause_start_us_ = AV_NOPTS_VALUE;
+  if (recorded.valid && recorded.backward == backward &&
+      std::abs(recorded.timestamp_us - timestamp_us) < kSeekMatchToleranceUs) {
+    // 重现抓取时的 Seek：从记录之后继续，Seek 之后的到达间隔
+    // （重新缓冲等）以 Seek 记录的时间为基准原样重现
+    if (!FileSeek(file_, recorded.offset)) {
+      return false;
+    }
+    epoch_ = std::chrono::steady_clock::now() -
+             std::chrono::microseconds(static_cast<int64_t>(
+                 recorded.arrival_us / options_.speed));
+    has_epoch_ = true;
+    ++seek_generation_;
+    wait_cv_.notify_all();
+    MODULE_DEBUG(LOG_MODULE_DEMUXER, "Replay seek to {}us (recorded)",
+                 timestamp_us);
+    return true;
+  }
+
+  if (seek_points_.empty()) {
+    return false;
+  }
+
+  // 会话中可能发生过 Seek，时间戳不保证单调，线性查找最接近的关键帧
+  const SeekPoint* best = nullptr;
+  for (const auto& point : seek_points_) {
+    bool candidate =
+        backward ? point.pts_us <= timestamp_us : point.pts_us >= timestamp_us;
+    if (!candidate) {
+      continue;
+    }
+    if (!best || (backward ? point.pts_us > best->pts_us
+                           : point.pts_us < best->pts_us)) {
+      best = &point;
+    }
+  }
+  if (!best) {
+    // 目标超出范围：向后找不到取最早的关键帧，向前找不到取最晚的
+    best = &*std::min_element(
+        seek_points_.begin(), seek_points_.end(),
+        [backward](const SeekPoint& a, const SeekPoint& b) {
+          return backward ? a.pts_us < b.pts_us : a.pts_us > b.pts_us;
+        });
+  }
+
+  if (!FileSeek(file_, best->offset)) {
+    return false;
+  }
+  has_epoch_ = false;
+  ++seek_generation_;
+  wait_cv_.notify_all();
+
+  MODULE_DEBUG(LOG_MODULE_DEMUXER, "Replay seek to {}us -> keyframe at {}us",
+               timestamp_us, best->pts_us);
+  return true;
+}
+
+void PacketReplaySource::Interrupt() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  interrupted_ = true;
+  wait_cv_.notify_all();
+}
+
+void PacketReplaySource::ResetInterrupt() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  interrupted_ = false;
+  has_epoch_ = false;
+}
+
+void PacketReplaySource::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+  time_bases_.clear();
+  seek_points_.clear();
+  active_video_stream_ = -1;
+  active_audio_stream_ = -1;
+  has_epoch_ = false;
+  paused_us_ = 0;
+  pause_start_us_ = AV_NOPTS_VALUE;
+  recorded_seek_ = RecordedSeek{};
+}
+
+}  // namespace zenplay
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "player/common/error.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 数据包抓取文件格式（.zpcap，小端）
+ *
+ * [FileHeader][StreamRecord + extradata] x stream_count
+ * [RecordHeader + payload] ...
+ *
+ * 每条记录保存 DemuxTask 从 Demuxer 读到的一个数据包（数据、时间戳、
+ * 标志）以及它的到达时间（相对抓取开始的单调时钟微秒数），EOF 和读取
+ * 错误也作为记录保存，回放时按原样返回给调用方。暂停 / 恢复和 Demuxer
+ * Seek 作为事件记录保存：回放时扣除暂停的时长，并在 Seek 处让播放器
+ * 同样执行一次 Seek（清空队列、刷新解码器）。
+ */
+namespace capture {
+
+constexpr char kMagic[8] = {'Z', 'P', 'C', 'A', 'P', '\0', '\0', '\0'};
+constexpr uint32_t kVersion = 2;     // 版本 2 增加暂停 / 恢复 / Seek 事件
+constexpr uint32_t kMinVersion = 1;  // 版本 1 没有事件记录，仍可回放
+
+// 单个数据包负载的上限，超出视为文件损坏
+constexpr int32_t kMaxPayloadBytes = 64 << 20;
+
+enum class RecordType : uint32_t {
+  kPacket = 0,       // 数据包
+  kEndOfStream = 1,  // ReadPacket 返回 EOF
+  kError = 2,        // ReadPacket 返回错误（value = ErrorCode）
+  kPause = 3,        // 播放暂停
+  kResume = 4,       // 播放恢复
+  kSeek = 5,         // Demuxer Seek（pts = 目标微秒，flags = 1 向后）
+};
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t stream_count;
+  int64_t start_wall_time_us;  // 抓取开始的系统时间（Unix 微秒）
+  int64_t duration_us;         // 源的总时长，未知为 AV_NOPTS_VALUE
+  int32_t active_video_stream;
+  int32_t active_audio_stream;
+};
+
+/**
+ * @brief 重建 AVStream 所需的编码参数和时间基
+ */
+struct StreamRecord {
+  int32_t codec_type;
+  int32_t codec_id;
+  uint32_t codec_tag;
+  int32_t format;
+  int64_t bit_rate;
+  int32_t profile;
+  int32_t level;
+  int32_t width;
+  int32_t height;
+  int32_t sample_aspect_num;
+  int32_t sample_aspect_den;
+  int32_t field_order;
+  int32_t color_range;
+  int32_t color_primaries;
+  int32_t color_trc;
+  int32_t color_space;
+  int32_t chroma_location;
+  int32_t sample_rate;
+  int32_t channels;
+  int32_t block_align;
+  int32_t frame_size;
+  int32_t initial_padding;
+  int32_t reserved0;
+  uint64_t channel_mask;  // 0 表示非 native 布局，回放时使用默认布局
+  int32_t time_base_num;
+  int32_t time_base_den;
+  int32_t avg_frame_rate_num;
+  int32_t avg_frame_rate_den;
+  int32_t r_frame_rate_num;
+  int32_t r_frame_rate_den;
+  int64_t start_time;
+  int64_t duration;
+  uint32_t extradata_size;
+  uint32_t reserved1;
+};
+
+struct RecordHeader {
+  uint32_t type;  // RecordType
+  int32_t stream_index;
+  int64_t arrival_us;  // 相对抓取开始的到达时间
+  int64_t pts;
+  int64_t dts;
+  int64_t duration;
+  int32_t flags;
+  int32_t value;  // kPacket: 负载字节数；kError: ErrorCode
+};
+
+static_assert(sizeof(FileHeader) == 40, "FileHeader layout changed");
+static_assert(sizeof(StreamRecord) == 152, "StreamRecord layout changed");
+static_assert(sizeof(RecordHeader) == 48, "RecordHeader layout changed");
+
+}  // namespace capture
+
+/**
+ * @brief 数据包抓取写入器
+ *
+ * 网络流引起的卡顿无法复现，因为数据到达的时间信息丢失了。写入器在
+ * DemuxTask 中记录每个数据包及其到达时间，配合 PacketReplaySource
+ * 可以按原始节奏重放整个会话。
+ *
+ * 写入使用带大缓冲的 stdio，单个包的开销只是一次内存拷贝。
+ *
+ * @note 线程安全：数据包由 DemuxTask 写入，暂停 / 恢复由调用
+ *       PlaybackController::Pause() / Resume() 的线程写入，Seek 由
+ *       执行 Demuxer Seek 的线程写入
+ */
+class PacketCaptureWriter {
+ public:
+  PacketCaptureWriter() = default;
+  ~PacketCaptureWriter();
+
+  PacketCaptureWriter(const PacketCaptureWriter&) = delete;
+  PacketCaptureWriter& operator=(const PacketCaptureWriter&) = delete;
+
+  /**
+   * @brief 创建抓取文件并写入流信息
+   * @param path 输出文件路径
+   * @param streams 源的全部流（下标即 stream_index）
+   * @param duration_us 源总时长（微秒），未知传 AV_NOPTS_VALUE
+   * @param active_video_stream 当前活动视频流，没有传 -1
+   * @param active_audio_stream 当前活动音频流，没有传 -1
+   */
+  Result<void> Open(const std::string& path,
+                    const std::vector<const AVStream*>& streams,
+                    int64_t duration_us,
+                    int active_video_stream,
+                    int active_audio_stream);
+
+  /**
+   * @brief 记录一个数据包，到达时间取当前时刻
+   */
+  Result<void> WritePacket(const AVPacket* packet);
+
+  /**
+   * @brief 记录一个数据包，使用指定的到达时间（测试用）
+   */
+  Result<void> WritePacket(const AVPacket* packet, int64_t arrival_us);
+
+  /**
+   * @brief 记录 EOF
+   */
+  Result<void> WriteEndOfStream();
+
+  /**
+   * @brief 记录一次读取错误
+   */
+  Result<void> WriteError(ErrorCode code);
+
+  /**
+   * @brief 记录播放暂停 / 恢复（带 arrival_us 的版本用于测试）
+   */
+  Result<void> WritePause();
+  Result<void> WritePause(int64_t arrival_us);
+  Result<void> WriteResume();
+  Result<void> WriteResume(int64_t arrival_us);
+
+  /**
+   * @brief 记录一次 Demuxer Seek，之后的数据包来自新位置
+   * @param timestamp_us Seek 目标（微秒）
+   * @param backward 是否向后搜索关键帧
+   * @param arrival_us 指定记录时间（测试用）
+   */
+  Result<void> WriteSeek(int64_t timestamp_us, bool backward);
+  Result<void> WriteSeek(int64_t timestamp_us,
+                         bool backward,
+                         int64_t arrival_us);
+
+  /**
+   * @brief 刷新并关闭文件（写入失败后也可以继续调用各 Write*，返回错误）
+   */
+  void Close();
+
+  bool IsOpen() const;
+  const std::string& path() const { return path_; }
+  uint64_t packet_count() const;
+  uint64_t bytes_written() const;
+
+  /**
+   * @brief 自 Open() 起经过的微秒数
+   */
+  int64_t ElapsedUs() const;
+
+ private:
+  Result<void> WriteEvent(capture::RecordType type,
+                          int64_t arrival_us,
+                          int64_t timestamp_us = AV_NOPTS_VALUE,
+                          int32_t flags = 0,
+                          int32_t value = 0);
+  Result<void> WriteRecord_Locked(const capture::RecordHeader& header,
+                                  const uint8_t* payload);
+  void Close_Locked();
+
+  mutable std::mutex mutex_;
+  std::FILE* file_ = nullptr;
+  std::string path_;
+  std::vector<char> file_buffer_;
+  std::chrono::steady_clock::time_point start_time_;
+  uint64_t packet_count_ = 0;
+  uint64_t bytes_written_ = 0;
+};
+
+/**
+ * @brief 抓取文件回放源
+ *
+ * 读取 .zpcap 文件，重建 AVFormatContext（只包含流信息，不含 demuxer），
+ * 并按记录的到达时间依次返回数据包：
+ * - 到达时间间隔按原样重现，网络抖动造成的卡顿可以稳定复现
+ * - 调用方阻塞（暂停、队列满）导致回放落后过多时重新对齐时间基准，
+ *   避免恢复后一次性灌入大量数据包
+ * - 抓取期间的暂停不重现为卡顿：扣除暂停到恢复之间的时长
+ * - 抓取期间的 Seek：ReadPacket() 返回 kCancelled，调用方用
+ *   TakeRecordedSeek() 取出目标并照常执行 Seek；目标相同的 Seek() 从
+ *   记录之后继续读取（原样重现 Seek 之后的数据包和到达间隔）
+ * - Seek 定位到目标时间之前（或之后）最近的视频关键帧记录
+ *
+ * @note ReadPacket() 与 Seek() 可以在不同线程调用
+ */
+class PacketReplaySource {
+ public:
+  struct Options {
+    bool honor_arrival_timing = true;  // false：尽快返回（确定性测试）
+    double speed = 1.0;                // 回放速度倍率
+  };
+
+  PacketReplaySource() = default;
+  ~PacketReplaySource();
+
+  PacketReplaySource(const PacketReplaySource&) = delete;
+  PacketReplaySource& operator=(const PacketReplaySource&) = delete;
+
+  /**
+   * @brief 打开抓取文件
+   * @param path 文件路径
+   * @param format_context 输出：重建的格式上下文，由调用方负责
+   *        avformat_free_context()
+   */
+  Result<void> Open(const std::string& path,
+                    AVFormatContext** format_context,
+                    const Options& options);
+  Result<void> Open(const std::string& path, AVFormatContext** format_context);
+
+  /**
+   * @brief 读取下一个数据包（必要时等待到其原始到达时刻）
+   * @return 数据包；EOF 返回 nullptr；抓取到的读取错误原样返回；
+   *         读到抓取时的 Seek 返回 kCancelled（见 TakeRecordedSeek()）；
+   *         记录损坏返回 kInvalidFormat
+   */
+  Result<AVPacket*> ReadPacket();
+
+  /**
+   * @brief 取出 ReadPacket() 刚读到的抓取时的 Seek（每次只返回一次）
+   * @return 没有待执行的 Seek 时返回 false
+   */
+  bool TakeRecordedSeek(int64_t* timestamp_us, bool* backward);
+
+  /**
+   * @brief 定位到指定时间
+   * @param timestamp_us 目标时间（微秒）
+   * @param backward true：目标之前最近的关键帧；false：之后最近的关键帧
+   * @note 与刚读到的抓取时的 Seek 目标相同时，从该记录之后继续读取
+   */
+  bool Seek(int64_t timestamp_us, bool backward);
+
+  /**
+   * @brief 唤醒正在等待到达时刻的 ReadPacket()（停止播放时调用）
+   *
+   * 之后的 ReadPacket() 不再等待，直到调用 ResetInterrupt()。
+   */
+  void Interrupt();
+  void ResetInterrupt();
+
+  void Close();
+
+  bool IsOpen() const { return file_ != nullptr; }
+  int active_video_stream() const { return active_video_stream_; }
+  int active_audio_stream() const { return active_audio_stream_; }
+  int64_t start_wall_time_us() const { return start_wall_time_us_; }
+
+ private:
+  /**
+   * @brief 可作为 Seek 目标的视频关键帧记录
+   */
+  struct SeekPoint {
+    int64_t offset = 0;  // 记录在文件中的偏移
+    int64_t pts_us = 0;
+  };
+
+  /**
+   * @brief 读到的抓取时的 Seek，等待调用方执行
+   */
+  struct RecordedSeek {
+    bool valid = false;
+    bool notified = false;   // TakeRecordedSeek() 已取出
+    int64_t timestamp_us = 0;
+    bool backward = true;
+    int64_t offset = 0;      // Seek 记录之后的文件偏移
+    int64_t arrival_us = 0;  // 扣除暂停后的记录时间
+  };
+
+  /**
+   * @brief 检查记录头：负载大小和流索引必须有效
+   */
+  bool IsValidRecord(const capture::RecordHeader& header) const;
+
+  /**
+   * @brief 处理暂停 / 恢复事件，更新需要扣除的暂停时长
+   */
+  void ApplyPauseEvent(const capture::RecordHeader& header);
+
+  Result<void> ReadStreams(AVFormatContext* format_context,
+                           uint32_t stream_count);
+  void BuildSeekIndex();
+  int64_t ToMicroseconds(int stream_index, int64_t ts) const;
+
+  /**
+   * @brief 等待到记录的到达时刻
+   * @return 等待期间发生了 Seek 返回 false（当前记录作废）
+   */
+  bool WaitForArrival(std::unique_lock<std::mutex>& lock, int64_t arrival_us);
+
+  std::FILE* file_ = nullptr;
+  Options options_;
+  int64_t records_offset_ = 0;  // 第一条记录的偏移
+  int64_t start_wall_time_us_ = 0;
+  int active_video_stream_ = -1;
+  int active_audio_stream_ = -1;
+  std::vector<AVRational> time_bases_;
+  std::vector<SeekPoint> seek_points_;
+
+  // 文件读取位置和回放时间基准（第一条记录返回时建立，Seek 后重建）
+  std::mutex mutex_;
+  std::condition_variable wait_cv_;
+  bool interrupted_ = false;
+  uint64_t seek_generation_ = 0;
+  bool has_epoch_ = false;
+  std::chrono::steady_clock::time_point epoch_;
+  int64_t paused_us_ = 0;                     // 已扣除的暂停总时长
+  int64_t pause_start_us_ = AV_NOPTS_VALUE;   // 暂停记录的时间
+  RecordedSeek recorded_seek_;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,452 @@
+#include "player/demuxer/raw_video_source.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/mathematics.h>
+}
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+constexpr char kY4mMagic[] = "YUV4MPEG2";
+constexpr char kY4mFrameTag[] = "FRAME";
+constexpr size_t kMaxY4mHeader = 4096;  // 文件头 / FRAME 头的最大长度
+
+/**
+ * @brief 映射缓冲区的释放回调：最后一个引用释放时解除映射
+ */
+void UnmapFile(void* opaque, uint8_t* data) {
+#ifdef OS_WIN
+  (void)opaque;
+  UnmapViewOfFile(data);
+#else
+  munmap(data, reinterpret_cast<uintptr_t>(opaque));
+#endif
+}
+
+bool EndsWithIgnoreCase(const std::string& text, const char* suffix) {
+  size_t length = std::strlen(suffix);
+  if (text.size() < length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    auto c = static_cast<unsigned char>(text[text.size() - length + i]);
+    if (std::tolower(c) != suffix[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Y4M 色度格式（C 参数）对应的像素格式
+ */
+AVPixelFormat Y4mPixelFormat(const std::string& chroma) {
+  // 420jpeg / 420mpeg2 / 420paldv 只是色度采样位置不同
+  if (chroma == "420" || chroma == "420jpeg" || chroma == "420mpeg2" ||
+      chroma == "420paldv") {
+    return AV_PIX_FMT_YUV420P;
+  }
+  if (chroma == "422") {
+    return AV_PIX_FMT_YUV422P;
+  }
+  if (chroma == "444") {
+    return AV_PIX_FMT_YUV444P;
+  }
+  if (chroma == "mono") {
+    return AV_PIX_FMT_GRAY8;
+  }
+  if (chroma == "420p10") {
+    return AV_PIX_FMT_YUV420P10LE;
+  }
+  if (chroma == "422p10") {
+    return AV_PIX_FMT_YUV422P10LE;
+  }
+  if (chroma == "444p10") {
+    return AV_PIX_FMT_YUV444P10LE;
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/**
+ * @brief 解析 "num:den" 形式的比值
+ */
+bool ParseRatio(const std::string& text, AVRational* ratio) {
+  size_t colon = text.find(':');
+  if (colon == std::string::npos) {
+    return false;
+  }
+  ratio->num = std::atoi(text.substr(0, colon).c_str());
+  ratio->den = std::atoi(text.substr(colon + 1).c_str());
+  return ratio->num > 0 && ratio->den > 0;
+}
+
+}  // namespace
+
+RawVideoSource::~RawVideoSource() {
+  Close();
+}
+
+bool RawVideoSource::IsRawVideoPath(const std::string& path) {
+  return EndsWithIgnoreCase(path, ".y4m") || EndsWithIgnoreCase(path, ".yuv");
+}
+
+Result<void> RawVideoSource::Open(const std::string& path,
+                                  AVFormatContext** format_context,
+                                  const Options& options) {
+  Close();
+
+  auto map_result = MapFile(path);
+  if (!map_result.IsOk()) {
+    return map_result;
+  }
+
+  auto layout_result = EndsWithIgnoreCase(path, ".y4m")
+                           ? ParseY4m()
+                           : LayoutRawYuv(options);
+  if (!layout_result.IsOk()) {
+    Close();
+    return Result<void>::Err(layout_result.Code(),
+                             layout_result.Message() + ": " + path);
+  }
+
+  AVFormatContext* context = avformat_alloc_context();
+  AVStream* stream = context ? avformat_new_stream(context, nullptr) : nullptr;
+  if (!stream) {
+    avformat_free_context(context);
+    Close();
+    return Result<void>::Err(ErrorCode::kOutOfMemory,
+                             "Failed to allocate raw video stream");
+  }
+
+  AVCodecParameters* par = stream->codecpar;
+  par->codec_type = AVMEDIA_TYPE_VIDEO;
+  par->codec_id = AV_CODEC_ID_RAWVIDEO;
+  par->format = pixel_format_;
+  par->width = width_;
+  par->height = height_;
+  par->color_range = color_range_;
+  stream->time_base = av_inv_q(frame_rate_);
+  stream->avg_frame_rate = frame_rate_;
+  stream->r_frame_rate = frame_rate_;
+  stream->start_time = 0;
+  stream->duration = static_cast<int64_t>(frame_offsets_.size());
+  stream->nb_frames = stream->duration;
+  context->duration =
+      av_rescale_q(stream->duration, stream->time_base, AV_TIME_BASE_Q);
+
+  *format_context = context;
+  MODULE_INFO(LOG_MODULE_DEMUXER,
+              "Raw video opened: {} ({}x{} {}, {}/{} fps, {} frames, "
+              "{} bytes/frame, memory-mapped)",
+              path, width_, height_, av_get_pix_fmt_name(pixel_format_),
+              frame_rate_.num, frame_rate_.den, frame_offsets_.size(),
+              frame_size_);
+  return Result<void>::Ok();
+}
+
+Result<AVFramePtr> RawVideoSource::ReadFrame() {
+  if (!mapping_) {
+    return Result<AVFramePtr>::Err(ErrorCode::kNotInitialized,
+                                   "Raw video source not open");
+  }
+  if (next_frame_ >= frame_offsets_.size()) {
+    return Result<AVFramePtr>::Ok(nullptr);  // EOF
+  }
+
+  AVFramePtr frame(av_frame_alloc());
+  if (!frame) {
+    return Result<AVFramePtr>::Err(ErrorCode::kOutOfMemory,
+                                   "Failed to allocate AVFrame");
+  }
+  // 帧引用整个映射，各平面指向映射中这一帧的数据（行宽不补齐）
+  frame->buf[0] = av_buffer_ref(mapping_);
+  if (!frame->buf[0]) {
+    return Result<AVFramePtr>::Err(ErrorCode::kOutOfMemory,
+                                   "Failed to reference raw video mapping");
+  }
+  const uint8_t* frame_data = data() + frame_offsets_[next_frame_];
+  int ret = av_image_fill_arrays(frame->data, frame->linesize, frame_data,
+                                 pixel_format_, width_, height_, 1);
+  if (ret < 0) {
+    return Result<AVFramePtr>::Err(ErrorCode::kInvalidFormat,
+                                   "Failed to set up raw video planes");
+  }
+
+  frame->format = pixel_format_;
+  frame->width = width_;
+  frame->height = height_;
+  frame->color_range = color_range_;
+  frame->pts = static_cast<int64_t>(next_frame_);
+  frame->pkt_dts = frame->pts;
+  frame->duration = 1;
+  frame->time_base = av_inv_q(frame_rate_);
+  frame->pict_type = AV_PICTURE_TYPE_I;
+  frame->flags |= AV_FRAME_FLAG_KEY;
+  ++next_frame_;
+  return Result<AVFramePtr>::Ok(std::move(frame));
+}
+
+bool RawVideoSource::Seek(int64_t timestamp_us, bool backward) {
+  if (!mapping_) {
+    return false;
+  }
+  // 帧序号 = 时间 × 帧率；目标落在两帧之间时按方向取整
+  int64_t index = av_rescale_rnd(
+      std::max<int64_t>(timestamp_us, 0), frame_rate_.num,
+      static_cast<int64_t>(frame_rate_.den) * AV_TIME_BASE,
+      backward ? AV_ROUND_DOWN : AV_ROUND_UP);
+  next_frame_ = std::min(static_cast<size_t>(index), frame_offsets_.size());
+  return true;
+}
+
+void RawVideoSource::Close() {
+  // 队列中的帧仍持有映射的引用，映射在它们全部释放后才解除
+  av_buffer_unref(&mapping_);
+  width_ = 0;
+  height_ = 0;
+  pixel_format_ = AV_PIX_FMT_NONE;
+  color_range_ = AVCOL_RANGE_UNSPECIFIED;
+  frame_size_ = 0;
+  frame_offsets_.clear();
+  next_frame_ = 0;
+}
+
+#ifdef OS_WIN
+
+Result<void> RawVideoSource::MapFile(const std::string& path) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return Result<void>::Err(ErrorCode::kFileNotFound,
+                             "Failed to open raw video file: " + path);
+  }
+  LARGE_INTEGER file_size{};
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+    CloseHandle(file);
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Empty raw video file: " + path);
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);  // 映射对象持有文件
+  if (!mapping) {
+    return Result<void>::Err(ErrorCode::kSystemError,
+                             "CreateFileMapping failed: " + path);
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);  // 视图持有映射对象
+  if (!view) {
+    return Result<void>::Err(ErrorCode::kSystemError,
+                             "MapViewOfFile failed: " + path);
+  }
+
+  size_t size = static_cast<size_t>(file_size.QuadPart);
+  mapping_ = av_buffer_create(static_cast<uint8_t*>(view), size, &UnmapFile,
+                              nullptr, AV_BUFFER_FLAG_READONLY);
+  if (!mapping_) {
+    UnmapViewOfFile(view);
+    return Result<void>::Err(ErrorCode::kOutOfMemory,
+                             "Failed to wrap raw video mapping");
+  }
+  return Result<void>::Ok();
+}
+
+#else
+
+Result<void> RawVideoSource::MapFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Result<void>::Err(
+        ErrorCode::kFileNotFound,
+        "Failed to open raw video file: " + path + ": " +
+            std::strerror(errno));
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Empty raw video file: " + path);
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // 映射建立后 fd 不再需要
+  if (addr == MAP_FAILED) {
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "mmap failed: " + path + ": " + std::strerror(errno));
+  }
+  // 按顺序播放：让内核提前读入后续页面
+  madvise(addr, size, MADV_SEQUENTIAL);
+
+  mapping_ = av_buffer_create(static_cast<uint8_t*>(addr), size, &UnmapFile,
+                              reinterpret_cast<void*>(size),
+                              AV_BUFFER_FLAG_READONLY);
+  if (!mapping_) {
+    munmap(addr, size);
+    return Result<void>::Err(ErrorCode::kOutOfMemory,
+                             "Failed to wrap raw video mapping");
+  }
+  return Result<void>::Ok();
+}
+
+#endif
+
+Result<void> RawVideoSource::ParseY4m() {
+  const char* begin = reinterpret_cast<const char*>(data());
+  const char* header_end = static_cast<const char*>(
+      std::memchr(begin, '\n', std::min(size(), kMaxY4mHeader)));
+  if (size() < sizeof(kY4mMagic) ||
+      std::memcmp(begin, kY4mMagic, sizeof(kY4mMagic) - 1) != 0 ||
+      !header_end) {
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Not a YUV4MPEG2 file");
+  }
+
+  // 文件头参数：W 宽 H 高 F 帧率 C 色度格式 X 扩展（其余忽略）
+  std::string chroma = "420jpeg";
+  std::string header(begin + sizeof(kY4mMagic) - 1, header_end);
+  size_t pos = 0;
+  while (pos < header.size()) {
+    size_t end = header.find(' ', pos);
+    if (end == std::string::npos) {
+      end = header.size();
+    }
+    std::string token = header.substr(pos, end - pos);
+    pos = end + 1;
+    if (token.empty()) {
+      continue;
+    }
+    std::string value = token.substr(1);
+    switch (token[0]) {
+      case 'W':
+        width_ = std::atoi(value.c_str());
+        break;
+      case 'H':
+        height_ = std::atoi(value.c_str());
+        break;
+      case 'F':
+        if (!ParseRatio(value, &frame_rate_)) {
+          return Result<void>::Err(ErrorCode::kInvalidFormat,
+                                   "Invalid Y4M frame rate '" + value + "'");
+        }
+        break;
+      case 'C':
+        chroma = value;
+        break;
+      case 'X':
+        if (value == "COLORRANGE=FULL") {
+          color_range_ = AVCOL_RANGE_JPEG;
+        } else if (value == "COLORRANGE=LIMITED") {
+          color_range_ = AVCOL_RANGE_MPEG;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  pixel_format_ = Y4mPixelFormat(chroma);
+  if (pixel_format_ == AV_PIX_FMT_NONE) {
+    return Result<void>::Err(ErrorCode::kUnsupportedCodec,
+                             "Unsupported Y4M chroma format C" + chroma);
+  }
+  int frame_size = av_image_get_buffer_size(pixel_format_, width_, height_, 1);
+  if (width_ <= 0 || height_ <= 0 || frame_size <= 0) {
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Invalid Y4M frame size " +
+                                 std::to_string(width_) + "x" +
+                                 std::to_string(height_));
+  }
+  frame_size_ = static_cast<size_t>(frame_size);
+
+  // 每帧 "FRAME[ 参数]\n" + 数据；参数可选，帧头长度不一定相同
+  size_t offset = static_cast<size_t>(header_end - begin) + 1;
+  const size_t tag_length = sizeof(kY4mFrameTag) - 1;
+  while (offset + tag_length <= size() &&
+         std::memcmp(begin + offset, kY4mFrameTag, tag_length) == 0) {
+    const char* frame_header_end = static_cast<const char*>(std::memchr(
+        begin + offset, '\n', std::min(size() - offset, kMaxY4mHeader)));
+    if (!frame_header_end) {
+      break;
+    }
+    size_t data_offset = static_cast<size_t>(frame_header_end - begin) + 1;
+    if (data_offset + frame_size_ > size()) {
+      break;  // 最后一帧不完整（文件被截断）
+    }
+    frame_offsets_.push_back(data_offset);
+    offset = data_offset + frame_size_;
+  }
+
+  if (frame_offsets_.empty()) {
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Y4M file contains no complete frame");
+  }
+  if (offset < size()) {
+    MODULE_WARN(LOG_MODULE_DEMUXER,
+                "Y4M: {} trailing bytes after frame {} ignored",
+                size() - offset, frame_offsets_.size());
+  }
+  return Result<void>::Ok();
+}
+
+Result<void> RawVideoSource::LayoutRawYuv(const Options& options) {
+  width_ = options.width;
+  height_ = options.height;
+  pixel_format_ = options.pixel_format;
+  frame_rate_ = options.frame_rate;
+  if (frame_rate_.num <= 0 || frame_rate_.den <= 0) {
+    frame_rate_ = AVRational{25, 1};
+  }
+
+  int frame_size =
+      width_ > 0 && height_ > 0 && pixel_format_ != AV_PIX_FMT_NONE
+          ? av_image_get_buffer_size(pixel_format_, width_, height_, 1)
+          : -1;
+  if (frame_size <= 0) {
+    return Result<void>::Err(
+        ErrorCode::kInvalidParameter,
+        "Raw YUV needs player.raw_video.width / height / pixel_format");
+  }
+  frame_size_ = static_cast<size_t>(frame_size);
+
+  size_t count = size() / frame_size_;
+  if (count == 0) {
+    return Result<void>::Err(ErrorCode::kInvalidFormat,
+                             "Raw YUV file is smaller than one frame");
+  }
+  frame_offsets_.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    frame_offsets_.push_back(i * frame_size_);
+  }
+  if (size() % frame_size_ != 0) {
+    MODULE_WARN(LOG_MODULE_DEMUXER,
+                "Raw YUV: file size is not a multiple of {} bytes/frame, "
+                "{} trailing bytes ignored",
+                frame_size_, size() % frame_size_);
+  }
+  return Result<void>::Ok();
+}
+
+}  // namespace zenplay
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "player/common/common_def.h"
+#include "player/common/error.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavutil/buffer.h>
+#include <libavutil/pixfmt.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 未压缩视频源（.y4m / 裸 .yuv），整个文件只读内存映射
+ *
+ * 用于渲染和同步的基准测试：每一帧的各平面直接指向映射区域，帧的
+ * buf[0] 是整个映射的一个引用，不经过 Decoder，上游没有任何拷贝，
+ * 渲染路径可以跑到数百 fps。映射随最后一个引用它的帧释放，源关闭后
+ * 队列、A-B 循环缓存中的帧仍然有效。
+ *
+ * - Y4M：尺寸、帧率、色度格式取自文件头，每帧前的 FRAME 头打开时
+ *   一次性扫描，记录各帧数据的偏移
+ * - 裸 YUV：没有文件头，尺寸、像素格式和帧率由 Options 给出
+ *
+ * 每一帧都是关键帧，PTS 为帧序号，时间基为帧率的倒数，Seek 精确到帧。
+ *
+ * @note 非线程安全：ReadFrame() 与 Seek() 由调用方互斥（demux 锁）
+ */
+class RawVideoSource {
+ public:
+  /**
+   * @brief 裸 YUV 的帧格式（Y4M 忽略）
+   */
+  struct Options {
+    int width = 0;
+    int height = 0;
+    AVPixelFormat pixel_format = AV_PIX_FMT_YUV420P;
+    AVRational frame_rate{25, 1};
+  };
+
+  RawVideoSource() = default;
+  ~RawVideoSource();
+
+  RawVideoSource(const RawVideoSource&) = delete;
+  RawVideoSource& operator=(const RawVideoSource&) = delete;
+
+  /**
+   * @brief 扩展名是否为 .y4m / .yuv（不区分大小写）
+   */
+  static bool IsRawVideoPath(const std::string& path);
+
+  /**
+   * @brief 映射文件并解析帧布局
+   * @param path 文件路径
+   * @param format_context 输出：只含一个 rawvideo 流的格式上下文（仅流
+   *        信息，不含 demuxer），由调用方负责 avformat_free_context()
+   * @param options 裸 YUV 的帧格式
+   */
+  Result<void> Open(const std::string& path,
+                    AVFormatContext** format_context,
+                    const Options& options);
+
+  /**
+   * @brief 返回下一帧，平面指向映射区域
+   * @return 帧；EOF 返回 nullptr
+   */
+  Result<AVFramePtr> ReadFrame();
+
+  /**
+   * @brief 定位到指定时间
+   * @param timestamp_us 目标时间（微秒）
+   * @param backward true：目标处或之前的帧；false：目标处或之后的帧
+   */
+  bool Seek(int64_t timestamp_us, bool backward);
+
+  void Close();
+
+  bool IsOpen() const { return mapping_ != nullptr; }
+  int width() const { return width_; }
+  int height() const { return height_; }
+  AVPixelFormat pixel_format() const { return pixel_format_; }
+  AVRational frame_rate() const { return frame_rate_; }
+  size_t frame_count() const { return frame_offsets_.size(); }
+  size_t frame_size() const { return frame_size_; }
+
+ private:
+  Result<void> MapFile(const std::string& path);
+
+  /**
+   * @brief 解析 Y4M 文件头并扫描各帧的 FRAME 头
+   */
+  Result<void> ParseY4m();
+
+  /**
+   * @brief 按固定帧大小切分裸 YUV
+   */
+  Result<void> LayoutRawYuv(const Options& options);
+
+  const uint8_t* data() const { return mapping_->data; }
+  size_t size() const { return mapping_->size; }
+
+  AVBufferRef* mapping_ = nullptr;  // 整个文件的映射（只读）
+  int width_ = 0;
+  int height_ = 0;
+  AVPixelFormat pixel_format_ = AV_PIX_FMT_NONE;
+  AVColorRange color_range_ = AVCOL_RANGE_UNSPECIFIED;
+  AVRational frame_rate_{25, 1};
+  size_t frame_size_ = 0;              // 一帧的数据字节数
+  std::vector<size_t> frame_offsets_;  // 各帧数据在文件中的偏移
+  size_t next_frame_ = 0;
+};
+
+}  // namespace zenplay
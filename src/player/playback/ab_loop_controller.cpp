@@ -0,0 +1,308 @@
+#include "player/playback/ab_loop_controller.h"
+
+#include <chrono>
+#include <utility>
+
+#include "player/common/log_manager.h"
+#include "player/common/player_state_manager.h"
+#include "player/stats/alloc_tracker.h"
+#include "player/stats/statistics_manager.h"
+
+namespace zenplay {
+
+AbLoopController::AbLoopController(PlayerStateManager* state_manager,
+                                   size_t max_cache_bytes,
+                                   bool has_video,
+                                   bool has_audio,
+                                   Callbacks callbacks)
+    : state_manager_(state_manager),
+      has_video_(has_video),
+      has_audio_(has_audio),
+      callbacks_(std::move(callbacks)),
+      cache_(max_cache_bytes) {}
+
+AbLoopController::~AbLoopController() {
+  Disable();
+}
+
+void AbLoopController::SetRange(int64_t start_ms, int64_t end_ms) {
+  MODULE_INFO(LOG_MODULE_PLAYER, "A-B loop set: {}ms - {}ms", start_ms,
+              end_ms);
+
+  // 重新设置区间：先停掉上一次的循环线程
+  StopTask();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.Clear();
+    cache_disabled_ = false;
+    start_ms_.store(start_ms);
+    end_ms_.store(end_ms);
+    phase_.store(Phase::kWaitingSeek);
+    task_stop_.store(false);
+  }
+  callbacks_.replay_changed();  // 解封装线程可能在等待上一次回放结束
+
+  thread_ = std::make_unique<std::thread>(&AbLoopController::LoopTask, this);
+}
+
+bool AbLoopController::ClearRange() {
+  Phase previous;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    previous = phase_.load();
+  }
+  if (previous == Phase::kOff) {
+    return false;
+  }
+  // 缓存完整（或某一路已越过 B 点）时对应的解码线程已停止推送
+  bool decoding_stopped =
+      previous == Phase::kReplaying ||
+      (previous == Phase::kRecording &&
+       ((has_video_ && cache_.IsComplete(true, false)) ||
+        (has_audio_ && cache_.IsComplete(false, true))));
+  Disable();
+  MODULE_INFO(LOG_MODULE_PLAYER, "A-B loop cleared");
+  return decoding_stopped;
+}
+
+void AbLoopController::Disable() {
+  StopTask();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (phase_.exchange(Phase::kOff) == Phase::kOff) {
+      return;
+    }
+  }
+  callbacks_.replay_changed();  // 唤醒等待回放结束的解封装线程
+  cache_.Clear();
+}
+
+void AbLoopController::StopTask() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_stop_.store(true);
+  }
+  cv_.notify_all();
+  if (!thread_) {
+    return;
+  }
+  state_manager_->WakeWaiters();  // 回放线程可能在暂停等待中
+
+  if (thread_->joinable()) {
+    thread_->join();
+  }
+  thread_.reset();
+}
+
+void AbLoopController::BeginPass() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (phase_.load() != Phase::kWaitingSeek) {
+      return;  // 跳转期间循环已被退出
+    }
+    if (cache_disabled_) {
+      phase_.store(Phase::kSeekFallback);
+    } else {
+      cache_.Reset(start_ms_.load(), end_ms_.load());
+      phase_.store(Phase::kRecording);
+    }
+  }
+  cv_.notify_all();
+}
+
+bool AbLoopController::AcceptVideoFrame(const AVFrame* frame,
+                                        const MediaTimestamp& timestamp) {
+  Phase phase = phase_.load();
+  if (phase == Phase::kReplaying) {
+    return false;  // 缓存回放期间残留包解码出的帧
+  }
+  if (phase != Phase::kRecording) {
+    return true;
+  }
+
+  auto result = cache_.AddVideoFrame(frame, timestamp);
+  if (result != LoopFrameCache::AddResult::kPastEnd) {
+    return true;
+  }
+  CheckPassComplete();
+  // 缓存失效时照常播放，由循环线程在 B 点跳回
+  return cache_.overflowed();
+}
+
+bool AbLoopController::AcceptAudioFrame(const ResampledAudioFrame& frame) {
+  Phase phase = phase_.load();
+  if (phase == Phase::kReplaying) {
+    return false;
+  }
+  if (phase != Phase::kRecording) {
+    return true;
+  }
+
+  auto result = cache_.AddAudioFrame(frame);
+  if (result != LoopFrameCache::AddResult::kPastEnd) {
+    return true;
+  }
+  CheckPassComplete();
+  return cache_.overflowed();
+}
+
+void AbLoopController::FinishStream(bool video) {
+  if (phase_.load() != Phase::kRecording) {
+    return;
+  }
+  if (video) {
+    cache_.MarkVideoComplete();
+  } else {
+    cache_.MarkAudioComplete();
+  }
+  CheckPassComplete();
+}
+
+int64_t AbLoopController::MapReplayClock(int64_t clock_ms) const {
+  if (phase_.load() != Phase::kReplaying) {
+    return clock_ms;
+  }
+  int64_t start_ms = start_ms_.load();
+  int64_t period_ms = end_ms_.load() - start_ms;
+  if (period_ms > 0 && clock_ms >= start_ms) {
+    return start_ms + (clock_ms - start_ms) % period_ms;
+  }
+  return clock_ms;
+}
+
+void AbLoopController::CheckPassComplete() {
+  bool replaying = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (phase_.load() != Phase::kRecording ||
+        !cache_.IsComplete(has_video_, has_audio_)) {
+      return;
+    }
+
+    if (cache_.IsReplayable(has_video_, has_audio_)) {
+      MODULE_INFO(LOG_MODULE_PLAYER,
+                  "A-B loop cached: {} video / {} audio frames, {} MB",
+                  cache_.video_frame_count(), cache_.audio_frame_count(),
+                  cache_.bytes_used() / (1024 * 1024));
+      phase_.store(Phase::kReplaying);
+      replaying = true;
+    } else {
+      MODULE_WARN(LOG_MODULE_PLAYER,
+                  "A-B loop cache unavailable, falling back to seeking");
+      cache_disabled_ = true;
+      cache_.Clear();
+      phase_.store(Phase::kSeekFallback);
+    }
+  }
+  cv_.notify_all();
+  if (replaying) {
+    callbacks_.replay_changed();
+  }
+}
+
+void AbLoopController::LoopTask() {
+  STATS_ALLOC_THREAD(kLoop);
+  MODULE_INFO(LOG_MODULE_PLAYER, "LoopTask started");
+  int64_t iteration = 0;
+
+  while (!task_stop_.load() && !state_manager_->ShouldStop()) {
+    Phase phase;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() {
+        Phase current = phase_.load();
+        return task_stop_.load() || current == Phase::kReplaying ||
+               current == Phase::kSeekFallback;
+      });
+      if (task_stop_.load()) {
+        break;
+      }
+      phase = phase_.load();
+    }
+    STATS_COUNT_WAKEUP(kLoop);
+
+    // 暂停时阻塞等待恢复（StopTask 会唤醒），不再定时检查
+    if (state_manager_->ShouldPause()) {
+      state_manager_->WaitForResume([this]() { return task_stop_.load(); });
+      continue;
+    }
+
+    if (phase == Phase::kReplaying) {
+      // 第一遍已在队列中，从第 1 轮开始
+      if (FeedIteration(++iteration)) {
+        MODULE_DEBUG(LOG_MODULE_PLAYER, "A-B loop iteration {} queued",
+                     iteration);
+      }
+      continue;
+    }
+
+    // 退回模式：播放到 B 点时跳回 A 点
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait_for(lock, std::chrono::milliseconds(10),
+                   [this]() { return task_stop_.load(); });
+    }
+    if (phase_.load() == Phase::kSeekFallback &&
+        callbacks_.current_time_ms() >= end_ms_.load()) {
+      phase_.store(Phase::kWaitingSeek);
+      callbacks_.seek_to_start(start_ms_.load());
+    }
+  }
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "LoopTask stopped");
+}
+
+bool AbLoopController::FeedIteration(int64_t iteration) {
+  constexpr int kPushFrameTimeoutMs = 100;
+
+  size_t video_count = has_video_ ? cache_.video_frame_count() : 0;
+  size_t audio_count = has_audio_ ? cache_.audio_frame_count() : 0;
+  size_t video_index = 0;
+  size_t audio_index = 0;
+
+  // 按 PTS 交错推送，两个队列同时保持充盈
+  while (video_index < video_count || audio_index < audio_count) {
+    if (!IsFeedActive()) {
+      return false;
+    }
+    if (state_manager_->ShouldPause()) {
+      state_manager_->WaitForResume([this]() { return !IsFeedActive(); });
+      continue;
+    }
+
+    bool take_video =
+        video_index < video_count &&
+        (audio_index >= audio_count ||
+         cache_.VideoFramePtsMs(video_index) <=
+             static_cast<double>(cache_.AudioFramePtsMs(audio_index)));
+
+    // 推送失败时帧已被释放，重新生成后再试（生成只是增加引用 / 拷贝 PCM）
+    if (take_video) {
+      MediaTimestamp timestamp;
+      AVFramePtr frame =
+          cache_.MakeVideoFrame(video_index, iteration, &timestamp);
+      if (!frame) {
+        MODULE_ERROR(LOG_MODULE_PLAYER, "A-B loop: failed to reference frame");
+        return false;
+      }
+      if (callbacks_.push_video(std::move(frame), timestamp,
+                                kPushFrameTimeoutMs)) {
+        ++video_index;
+      }
+    } else {
+      if (callbacks_.push_audio(cache_.MakeAudioFrame(audio_index, iteration),
+                                kPushFrameTimeoutMs)) {
+        ++audio_index;
+      }
+    }
+  }
+  return true;
+}
+
+bool AbLoopController::IsFeedActive() const {
+  return !task_stop_.load() && phase_.load() == Phase::kReplaying &&
+         !state_manager_->ShouldStop();
+}
+
+}  // namespace zenplay
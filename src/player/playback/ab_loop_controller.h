@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "player/audio/resampled_audio_frame.h"
+#include "player/common/common_def.h"
+#include "player/common/loop_frame_cache.h"
+
+namespace zenplay {
+
+class PlayerStateManager;
+
+/**
+ * @brief A-B 循环
+ *
+ * SetRange() 之后由调用方跳转到 A 点，跳转完成时调用 BeginPass() 开始
+ * 第一遍：解码线程把区间内的帧交给 Accept*Frame() 缓存，各路都到达
+ * B 点后切换到回放，循环线程每一轮从缓存推送帧（时间戳逐轮递增），
+ * 解封装和解码空闲。缓存超出上限或不可用时退回到每轮 Seek：循环线程在
+ * 播放到 B 点时请求跳回 A 点，跳转完成后调用方再次调用 BeginPass()。
+ *
+ * @note 阶段只在持有内部锁时切换；Accept* / FinishStream 可在不同解码
+ *       线程并发调用
+ */
+class AbLoopController {
+ public:
+  /**
+   * @brief 循环阶段
+   */
+  enum class Phase {
+    kOff,          // 未开启
+    kWaitingSeek,  // 等待跳转到 A 点
+    kRecording,    // 第一遍：正常解码，同时缓存区间内的帧
+    kReplaying,    // 从缓存回放，解封装和解码空闲
+    kSeekFallback  // 缓存不可用：播放到 B 点时跳回 A 点
+  };
+
+  // 推送一帧缓存的视频 / 音频；超时或被打断返回 false（帧已释放）
+  using VideoSink = std::function<
+      bool(AVFramePtr frame, const MediaTimestamp& timestamp, int timeout_ms)>;
+  using AudioSink =
+      std::function<bool(ResampledAudioFrame frame, int timeout_ms)>;
+
+  struct Callbacks {
+    VideoSink push_video;
+    AudioSink push_audio;
+    std::function<int64_t()> current_time_ms;  // 当前播放位置
+    // 退回模式播放到 B 点：请求跳回 A 点（跳转完成后调用 BeginPass）
+    std::function<void(int64_t start_ms)> seek_to_start;
+    // 进入 / 离开缓存回放：唤醒停下的解封装线程
+    std::function<void()> replay_changed;
+  };
+
+  /**
+   * @param max_cache_bytes 缓存上限（开启循环前不占内存）
+   * @param has_video / has_audio 需要缓存的流，各路都到达 B 点才算完整
+   */
+  AbLoopController(PlayerStateManager* state_manager,
+                   size_t max_cache_bytes,
+                   bool has_video,
+                   bool has_audio,
+                   Callbacks callbacks);
+  ~AbLoopController();
+
+  AbLoopController(const AbLoopController&) = delete;
+  AbLoopController& operator=(const AbLoopController&) = delete;
+
+  /**
+   * @brief 设置循环区间并启动循环线程，之后由调用方跳转到 A 点
+   */
+  void SetRange(int64_t start_ms, int64_t end_ms);
+
+  /**
+   * @brief 退出循环，从当前位置继续正常播放
+   * @return 解码已停在 B 点（正在回放缓存，或某一路第一遍已结束），
+   *         调用方需要从当前位置重新跳转
+   */
+  bool ClearRange();
+
+  /**
+   * @brief 退出循环状态并释放缓存（不跳转）
+   */
+  void Disable();
+
+  /**
+   * @brief 停止并等待循环线程（阶段不变）
+   */
+  void StopTask();
+
+  /**
+   * @brief 跳转到 A 点完成后开始新一遍（SeekTask 线程调用）
+   */
+  void BeginPass();
+
+  /**
+   * @brief 解码线程：第一遍中缓存帧
+   * @return false 表示该帧已越过 B 点（或正在回放缓存），不应推送
+   */
+  bool AcceptVideoFrame(const AVFrame* frame, const MediaTimestamp& timestamp);
+  bool AcceptAudioFrame(const ResampledAudioFrame& frame);
+
+  /**
+   * @brief 解码线程遇到 EOF 时结束该路的第一遍
+   */
+  void FinishStream(bool video);
+
+  /**
+   * @brief 回放缓存时时间戳逐轮递增，把时钟映射回 A-B 区间
+   */
+  int64_t MapReplayClock(int64_t clock_ms) const;
+
+  bool IsActive() const { return phase_.load() != Phase::kOff; }
+  bool IsReplaying() const { return phase_.load() == Phase::kReplaying; }
+  Phase phase() const { return phase_.load(); }
+
+ private:
+  /**
+   * @brief 循环线程：缓存完整后按轮次推送缓存帧；退回模式下监视 B 点
+   */
+  void LoopTask();
+
+  /**
+   * @brief 推送第 iteration 轮的缓存帧（音视频按 PTS 交错）
+   * @return 循环被退出或播放停止时返回 false
+   */
+  bool FeedIteration(int64_t iteration);
+
+  /**
+   * @brief 循环回放是否应继续（LoopTask 线程调用）
+   */
+  bool IsFeedActive() const;
+
+  /**
+   * @brief 各路第一遍都结束后切换到回放（或退回模式）
+   */
+  void CheckPassComplete();
+
+  PlayerStateManager* state_manager_;
+  const bool has_video_;
+  const bool has_audio_;
+  Callbacks callbacks_;
+
+  LoopFrameCache cache_;
+  std::atomic<Phase> phase_{Phase::kOff};
+  std::atomic<int64_t> start_ms_{0};
+  std::atomic<int64_t> end_ms_{0};
+  bool cache_disabled_ = false;  // 本次循环已退回到每轮 Seek
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<bool> task_stop_{false};
+  std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace zenplay
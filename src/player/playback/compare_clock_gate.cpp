@@ -0,0 +1,143 @@
+#include "player/playback/compare_clock_gate.h"
+
+#include <algorithm>
+
+#include "player/common/log_manager.h"
+#include "player/sync/av_sync_controller.h"
+
+namespace zenplay {
+
+CompareClockGate::CompareClockGate(AVSyncController* master_clock)
+    : master_clock_(master_clock) {}
+
+void CompareClockGate::Reset(size_t pipeline_count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  master_clock_->Reset();
+  master_clock_->Pause();
+  master_paused_ = true;
+  started_ = false;
+  user_paused_ = false;
+  pending_serials_.assign(pipeline_count, 0);
+}
+
+void CompareClockGate::Play() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!started_) {
+    // 从头开始：主时钟清零，所有管线从各自的第一帧对齐
+    master_clock_->Reset();
+    master_paused_ = false;
+    started_ = true;
+  }
+  user_paused_ = false;
+  UpdateMasterClock_Locked();
+}
+
+void CompareClockGate::Pause() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  user_paused_ = true;
+  UpdateMasterClock_Locked();
+}
+
+void CompareClockGate::Stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::fill(pending_serials_.begin(), pending_serials_.end(), 0);
+  started_ = false;
+  user_paused_ = false;
+  master_clock_->Reset();
+  master_paused_ = false;
+  UpdateMasterClock_Locked();
+}
+
+void CompareClockGate::BeginSeek(int64_t target_ms,
+                                 const std::vector<bool>& seeking) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 先让主时钟走起来再重定位，否则暂停的时长会被算进新位置
+  if (master_paused_) {
+    master_clock_->Resume();
+    master_paused_ = false;
+  }
+  master_clock_->ResetForSeek(target_ms);
+  for (size_t i = 0; i < pending_serials_.size(); ++i) {
+    pending_serials_[i] =
+        i < seeking.size() && seeking[i] ? kSerialUnknown : 0;
+  }
+  UpdateMasterClock_Locked();
+}
+
+void CompareClockGate::SetSeekSerial(size_t index,
+                                     uint64_t serial,
+                                     uint64_t completed_serial) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 出错或停止时已经不再等待
+  if (index >= pending_serials_.size() ||
+      pending_serials_[index] != kSerialUnknown) {
+    return;
+  }
+  if (serial == 0 || completed_serial >= serial) {
+    FinishSeek_Locked(index);
+    return;
+  }
+  pending_serials_[index] = serial;
+}
+
+void CompareClockGate::OnSeekFinished(size_t index, uint64_t completed_serial) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index >= pending_serials_.size()) {
+    return;
+  }
+  // 序号未知时由 SetSeekSerial() 补判；之前的 Seek 结束不放行新的 Seek
+  uint64_t pending = pending_serials_[index];
+  if (pending == 0 || pending == kSerialUnknown || completed_serial < pending) {
+    return;
+  }
+  FinishSeek_Locked(index);
+}
+
+void CompareClockGate::OnPipelineError(size_t index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index < pending_serials_.size() && pending_serials_[index] != 0) {
+    FinishSeek_Locked(index);
+  }
+}
+
+bool CompareClockGate::IsSeeking() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return AnySeekPending_Locked();
+}
+
+bool CompareClockGate::IsPlaying() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return started_ && !user_paused_;
+}
+
+bool CompareClockGate::IsClockRunning() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !master_paused_;
+}
+
+void CompareClockGate::FinishSeek_Locked(size_t index) {
+  pending_serials_[index] = 0;
+  if (!AnySeekPending_Locked()) {
+    MODULE_INFO(LOG_MODULE_PLAYER,
+                "Compare: all pipelines finished seeking, clock resumes");
+  }
+  UpdateMasterClock_Locked();
+}
+
+void CompareClockGate::UpdateMasterClock_Locked() {
+  bool should_run = started_ && !user_paused_ && !AnySeekPending_Locked();
+  if (should_run && master_paused_) {
+    master_clock_->Resume();
+    master_paused_ = false;
+  } else if (!should_run && !master_paused_) {
+    master_clock_->Pause();
+    master_paused_ = true;
+  }
+}
+
+bool CompareClockGate::AnySeekPending_Locked() const {
+  return std::any_of(pending_serials_.begin(), pending_serials_.end(),
+                     [](uint64_t serial) { return serial != 0; });
+}
+
+}  // namespace zenplay
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace zenplay {
+
+class AVSyncController;
+
+/**
+ * @brief 对比播放共享主时钟的启停
+ *
+ * 只有已开始播放、未被用户暂停、且所有管线都完成了最近一次 Seek 时主时钟
+ * 才走；Seek 期间主时钟停在目标位置，先到的管线不会跑在前面。
+ *
+ * 每条管线按 Seek 请求序号等待，而不是一个标志：管线在上一次 Seek 尚未
+ * 结束时再次跳转，上一次的结束通知（完成序号小于新请求）不会提前放行。
+ * 发出请求到拿到序号之间管线处于 kSerialUnknown，这段时间内的结束通知
+ * 由 SetSeekSerial() 按完成序号补判。
+ *
+ * @note 线程安全：UI 线程发起操作，管线的状态回调在播放器线程上通知结束
+ */
+class CompareClockGate {
+ public:
+  explicit CompareClockGate(AVSyncController* master_clock);
+
+  CompareClockGate(const CompareClockGate&) = delete;
+  CompareClockGate& operator=(const CompareClockGate&) = delete;
+
+  /**
+   * @brief 重新设置管线数量（打开 / 关闭），主时钟清零并暂停到 Play()
+   */
+  void Reset(size_t pipeline_count);
+
+  /**
+   * @brief 开始 / 继续播放；第一次调用时主时钟从 0 开始
+   */
+  void Play();
+
+  /**
+   * @brief 用户暂停：主时钟停住，Seek 结束后也不会继续走
+   */
+  void Pause();
+
+  /**
+   * @brief 停止：放弃所有等待中的 Seek，下次 Play() 从头开始
+   */
+  void Stop();
+
+  /**
+   * @brief 主时钟跳到 target_ms 并停住，seeking[i] 为 true 的管线开始等待
+   * @note 随后对每条等待的管线发出 Seek，并用 SetSeekSerial() 交回序号
+   */
+  void BeginSeek(int64_t target_ms, const std::vector<bool>& seeking);
+
+  /**
+   * @brief 记录管线 index 刚发出的 Seek 请求序号
+   * @param serial 播放器返回的序号，0 表示请求被拒绝（不再等待）
+   * @param completed_serial 播放器已执行完的最新序号（可能已经结束）
+   */
+  void SetSeekSerial(size_t index, uint64_t serial, uint64_t completed_serial);
+
+  /**
+   * @brief 管线 index 的一次 Seek 结束（离开 kSeeking）
+   * @param completed_serial 刚结束的请求序号，小于等待的序号时继续等待
+   */
+  void OnSeekFinished(size_t index, uint64_t completed_serial);
+
+  /**
+   * @brief 管线 index 出错：不再等待它的 Seek
+   */
+  void OnPipelineError(size_t index);
+
+  /**
+   * @brief 是否还有管线没有完成最近一次 Seek
+   */
+  bool IsSeeking() const;
+
+  /**
+   * @brief 是否已开始播放且没有被用户暂停
+   */
+  bool IsPlaying() const;
+
+  /**
+   * @brief 主时钟是否在走
+   */
+  bool IsClockRunning() const;
+
+ private:
+  // 已发出 Seek、还不知道请求序号
+  static constexpr uint64_t kSerialUnknown = UINT64_MAX;
+
+  void FinishSeek_Locked(size_t index);
+
+  /**
+   * @brief 按当前状态暂停 / 恢复主时钟
+   */
+  void UpdateMasterClock_Locked();
+
+  bool AnySeekPending_Locked() const;
+
+  AVSyncController* master_clock_;
+
+  mutable std::mutex mutex_;
+  std::vector<uint64_t> pending_serials_;  // 0 表示没有等待中的 Seek
+  bool started_ = false;
+  bool user_paused_ = false;
+  bool master_paused_ = false;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,132 @@
+#include "player/playback/hover_seek_prefetch.h"
+
+#include <utility>
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+// 包的排序时间戳（dts，缺失时用 pts）
+int64_t PacketOrderTs(const AVPacket* packet) {
+  return packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts;
+}
+
+// 一组包中最晚的排序时间戳，没有时返回 AV_NOPTS_VALUE
+int64_t LastPacketTs(const std::vector<AVPacket*>& packets) {
+  int64_t last = AV_NOPTS_VALUE;
+  for (const AVPacket* packet : packets) {
+    int64_t ts = PacketOrderTs(packet);
+    if (ts != AV_NOPTS_VALUE && (last == AV_NOPTS_VALUE || ts > last)) {
+      last = ts;
+    }
+  }
+  return last;
+}
+
+bool SkipStreamPacket(const AVPacket* packet,
+                      int stream_index,
+                      int64_t* last_ts) {
+  if (packet->stream_index != stream_index || *last_ts == AV_NOPTS_VALUE) {
+    return false;
+  }
+  int64_t ts = PacketOrderTs(packet);
+  if (ts != AV_NOPTS_VALUE && ts > *last_ts) {
+    *last_ts = AV_NOPTS_VALUE;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void HoverSeekPrefetch::Enable(std::unique_ptr<SeekPrefetchSource> source) {
+  source_ = std::move(source);
+}
+
+void HoverSeekPrefetch::Request(int64_t timestamp_ms) {
+  if (source_) {
+    source_->Request(timestamp_ms);
+  }
+}
+
+void HoverSeekPrefetch::Cancel() {
+  if (source_) {
+    source_->Cancel();
+  }
+}
+
+std::unique_ptr<HoverSeekPrefetch::Prefetch> HoverSeekPrefetch::TakeForSeek(
+    int64_t target_ms,
+    const StreamLayout& layout) {
+  if (!source_) {
+    return nullptr;
+  }
+  source_->Cancel();
+  auto prefetch = source_->Take(target_ms);
+  if (!prefetch) {
+    return nullptr;
+  }
+
+  // 打开文件后切换过音轨等：两个 Demuxer 的流不再对应
+  if (prefetch->video_stream_index != layout.video_stream_index ||
+      prefetch->audio_stream_index != layout.audio_stream_index ||
+      av_cmp_q(prefetch->video_time_base, layout.video_time_base) != 0) {
+    MODULE_DEBUG(LOG_MODULE_PLAYER,
+                 "Seek prefetch discarded: stream layout changed");
+    return nullptr;
+  }
+  if (!layout.decode_audio) {
+    for (AVPacket*& packet : prefetch->audio_packets) {
+      av_packet_free(&packet);
+    }
+    prefetch->audio_packets.clear();
+    prefetch->audio_stream_index = -1;
+  }
+  return prefetch;
+}
+
+void HoverSeekPrefetch::DeferSeek(const Prefetch& prefetch, uint64_t serial) {
+  DeferredSeek deferred;
+  deferred.timestamp_us = prefetch.seek_us;
+  deferred.serial = serial;
+  deferred.video_stream_index = prefetch.video_stream_index;
+  deferred.video_last_ts = LastPacketTs(prefetch.video_packets);
+  deferred.audio_stream_index = prefetch.audio_stream_index;
+  deferred.audio_last_ts = LastPacketTs(prefetch.audio_packets);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  deferred_ = deferred;
+}
+
+void HoverSeekPrefetch::DropDeferredSeek() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  deferred_ = DeferredSeek{};
+}
+
+bool HoverSeekPrefetch::TakeDeferredSeek(DeferredSeek* skip,
+                                         uint64_t* seek_serial) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (deferred_.timestamp_us < 0) {
+    if (skip->serial != *seek_serial) {
+      *skip = DeferredSeek{};  // 之后又 Seek 过，已预取的包已被清空
+    }
+    return false;
+  }
+
+  // 这批包从推迟的跳转之后读出，属于它所在的那次 Seek
+  *skip = std::exchange(deferred_, DeferredSeek{});
+  *seek_serial = skip->serial;
+  return true;
+}
+
+bool HoverSeekPrefetch::SkipPrefetchedPacket(const AVPacket* packet,
+                                             DeferredSeek* skip) {
+  return SkipStreamPacket(packet, skip->video_stream_index,
+                          &skip->video_last_ts) ||
+         SkipStreamPacket(packet, skip->audio_stream_index,
+                          &skip->audio_last_ts);
+}
+
+}  // namespace zenplay
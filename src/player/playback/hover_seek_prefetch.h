@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "player/codec/seek_prefetcher.h"
+
+extern "C" {
+#include <libavcodec/packet.h>
+#include <libavutil/rational.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 悬停预取在播放侧的一半：把预取结果交给 Seek，并推迟 Demuxer Seek
+ *
+ * 鼠标悬停时 Request() 交给预取来源在后台完成到这个位置的 Seek；点击
+ * 时 TakeForSeek() 取走覆盖目标位置的结果，预取的包和帧由调用方推入
+ * 队列，Demuxer Seek 推迟到解封装线程（TakeDeferredSeek），之后重新读出
+ * 的已预取包用 SkipPrefetchedPacket() 跳过。
+ *
+ * @note 推迟的跳转由内部锁保护，调用方另外用 Demuxer 锁保证它与
+ *       Demuxer 上的其他操作不交叠
+ */
+class HoverSeekPrefetch {
+ public:
+  using Prefetch = SeekPrefetchSource::Prefetch;
+
+  /**
+   * @brief 主 Demuxer 当前的流布局，与之不符的预取结果不可用
+   */
+  struct StreamLayout {
+    int video_stream_index = -1;
+    int audio_stream_index = -1;
+    AVRational video_time_base{0, 1};
+    bool decode_audio = false;  // 音频解码器未打开时丢弃预取的音频包
+  };
+
+  /**
+   * @brief 悬停预取命中后推迟到解封装线程执行的 Demuxer Seek
+   *
+   * 预取的包已经推入队列，跳转后按流跳过时间戳不晚于最后一个预取包的包
+   * （dts，缺失时用 pts）。
+   */
+  struct DeferredSeek {
+    int64_t timestamp_us = -1;  // -1 表示没有待执行的跳转
+    uint64_t serial = 0;        // 所属 Seek 的序号
+    int video_stream_index = -1;
+    int64_t video_last_ts = AV_NOPTS_VALUE;
+    int audio_stream_index = -1;
+    int64_t audio_last_ts = AV_NOPTS_VALUE;
+  };
+
+  HoverSeekPrefetch() = default;
+
+  HoverSeekPrefetch(const HoverSeekPrefetch&) = delete;
+  HoverSeekPrefetch& operator=(const HoverSeekPrefetch&) = delete;
+
+  /**
+   * @brief 启用悬停预取（未调用时 Request / TakeForSeek 不做任何事）
+   */
+  void Enable(std::unique_ptr<SeekPrefetchSource> source);
+
+  bool enabled() const { return source_ != nullptr; }
+
+  /**
+   * @brief 鼠标悬停在 timestamp_ms
+   */
+  void Request(int64_t timestamp_ms);
+
+  /**
+   * @brief 鼠标离开进度条：放弃尚未开始的预取
+   */
+  void Cancel();
+
+  /**
+   * @brief Seek 开始：取走覆盖 target_ms 且与当前流布局匹配的预取结果
+   *
+   * 无论是否命中都放弃尚未完成的悬停请求：点击之后悬停位置已过时，
+   * 工作线程不再为它占用网络和解码。
+   * @return 没有可用结果时返回 nullptr
+   */
+  std::unique_ptr<Prefetch> TakeForSeek(int64_t target_ms,
+                                        const StreamLayout& layout);
+
+  /**
+   * @brief 命中后记录推迟的 Demuxer Seek，替换之前未执行的跳转
+   * @param serial 这次 Seek 的序号
+   */
+  void DeferSeek(const Prefetch& prefetch, uint64_t serial);
+
+  /**
+   * @brief 主 Demuxer 已直接跳转：丢弃未执行的推迟跳转
+   */
+  void DropDeferredSeek();
+
+  /**
+   * @brief 解封装线程读包前：取出推迟的跳转
+   * @param skip 输入输出：之后要跳过的已预取包；Seek 序号变化后清空
+   * @param seek_serial 输入输出：取出跳转时改为它所属的序号
+   * @return 有待执行的跳转（目标为 skip->timestamp_us）时返回 true
+   */
+  bool TakeDeferredSeek(DeferredSeek* skip, uint64_t* seek_serial);
+
+  /**
+   * @brief 推迟的跳转会重新读出已推入队列的包：跳过不晚于最后一个预取包
+   *        的包，越过之后这个流不再检查
+   */
+  static bool SkipPrefetchedPacket(const AVPacket* packet, DeferredSeek* skip);
+
+ private:
+  std::unique_ptr<SeekPrefetchSource> source_;
+
+  std::mutex mutex_;
+  DeferredSeek deferred_;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,194 @@
+#include "player/playback/reverse_playback.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "player/common/log_manager.h"
+#include "player/common/player_state_manager.h"
+#include "player/stats/alloc_tracker.h"
+#include "player/stats/statistics_manager.h"
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+namespace zenplay {
+
+ReversePlayback::ReversePlayback(PlayerStateManager* state_manager,
+                                 AVSyncController* sync_controller,
+                                 Callbacks callbacks)
+    : state_manager_(state_manager),
+      sync_controller_(sync_controller),
+      callbacks_(std::move(callbacks)) {}
+
+ReversePlayback::~ReversePlayback() {
+  Stop();
+}
+
+double ReversePlayback::ClampRate(double rate) {
+  return -std::clamp(-rate, kMinSpeed, kMaxSpeed);
+}
+
+bool ReversePlayback::BeginSeek(double playback_rate, int64_t target_ms) {
+  bool was_active = active_.load();
+  bool reverse = playback_rate != 0.0 ? playback_rate < 0.0 : was_active;
+  if (was_active) {
+    Stop();
+  }
+
+  if (!reverse) {
+    if (was_active) {
+      RestoreForward();
+    }
+    return false;
+  }
+
+  if (playback_rate < 0.0) {
+    speed_.store(-playback_rate);
+  }
+  if (!was_active) {
+    // 音频不倒放，改用系统时钟驱动视频
+    if (sync_controller_) {
+      forward_sync_mode_ = sync_controller_->GetSyncMode();
+      sync_controller_->SetSyncMode(
+          AVSyncController::SyncMode::EXTERNAL_MASTER);
+    }
+    active_.store(true);
+  }
+  origin_ms_.store(target_ms);
+  return true;
+}
+
+Result<void> ReversePlayback::Start() {
+  int64_t origin_ms = origin_ms_.load();
+  auto result = callbacks_.create_source(origin_ms);
+  if (!result.IsOk()) {
+    RestoreForward();
+    return Result<void>::Err(result.Code(), result.Message());
+  }
+  source_ = result.TakeValue();
+
+  task_stop_.store(false);
+  thread_ = std::make_unique<std::thread>(&ReversePlayback::PresentTask, this);
+  return Result<void>::Ok();
+}
+
+void ReversePlayback::Stop() {
+  task_stop_.store(true);
+  if (!thread_ && !source_) {
+    return;
+  }
+  state_manager_->WakeWaiters();  // 呈现线程可能在暂停等待中
+  if (source_) {
+    source_->Stop();  // 唤醒等待帧块的呈现线程
+  }
+  if (thread_ && thread_->joinable()) {
+    thread_->join();
+  }
+  thread_.reset();
+  source_.reset();
+}
+
+void ReversePlayback::Reset() {
+  Stop();
+  if (active_.load()) {
+    RestoreForward();
+  }
+}
+
+int64_t ReversePlayback::MapClock(int64_t clock_ms) const {
+  if (!active_.load()) {
+    return clock_ms;
+  }
+  int64_t origin_ms = origin_ms_.load();
+  return std::max<int64_t>(
+      0, origin_ms - static_cast<int64_t>((clock_ms - origin_ms) *
+                                          speed_.load()));
+}
+
+double ReversePlayback::PlaybackRate() const {
+  return active_.load() ? -speed_.load() : 1.0;
+}
+
+void ReversePlayback::RestoreForward() {
+  if (sync_controller_) {
+    sync_controller_->SetSyncMode(forward_sync_mode_);
+  }
+  active_.store(false);
+  callbacks_.active_changed();
+}
+
+void ReversePlayback::PresentTask() {
+  STATS_ALLOC_THREAD(kReverse);
+  constexpr int kPushFrameTimeoutMs = 100;
+  const double speed = speed_.load();
+  const int64_t origin_us = origin_ms_.load() * 1000;
+  MODULE_INFO(LOG_MODULE_PLAYER, "ReverseTask started at {}ms, speed {:.2f}",
+              origin_us / 1000, speed);
+
+  auto is_active = [this]() {
+    return !task_stop_.load() && !state_manager_->ShouldStop();
+  };
+
+  auto is_stopped = [this]() { return task_stop_.load(); };
+
+  std::unique_ptr<ReverseFrameSource::FrameChunk> chunk;
+  while (is_active()) {
+    STATS_COUNT_WAKEUP(kReverse);
+    if (state_manager_->ShouldPause()) {
+      state_manager_->WaitForResume(is_stopped);
+      continue;
+    }
+
+    if (!source_->PopChunk(&chunk, kPushFrameTimeoutMs)) {
+      if (source_->finished()) {
+        MODULE_INFO(LOG_MODULE_PLAYER, "Reverse playback reached the start");
+        break;
+      }
+      continue;
+    }
+
+    // 帧块按 PTS 升序，从末尾开始呈现
+    size_t index = chunk->frames.size();
+    while (index > 0 && is_active()) {
+      if (state_manager_->ShouldPause()) {
+        state_manager_->WaitForResume(is_stopped);
+        continue;
+      }
+
+      const AVFrame* source = chunk->frames[index - 1].get();
+      int64_t pts = source->pts != AV_NOPTS_VALUE
+                        ? source->pts
+                        : source->best_effort_timestamp;
+      int64_t pts_us =
+          av_rescale_q(pts, chunk->time_base, AVRational{1, 1000000});
+
+      // 越早的帧时间戳越大，时钟和 VideoPlayer 照常按正向时间工作
+      int64_t virtual_us =
+          origin_us + static_cast<int64_t>((origin_us - pts_us) / speed);
+
+      // 推送失败时帧会被释放，每次推送新引用，原帧留在块中以便重试
+      AVFramePtr frame(av_frame_clone(source));
+      if (!frame) {
+        MODULE_ERROR(LOG_MODULE_PLAYER, "Reverse: failed to reference frame");
+        return;
+      }
+      frame->pts = virtual_us;
+      frame->pkt_dts = virtual_us;
+
+      MediaTimestamp timestamp;
+      timestamp.pts = virtual_us;
+      timestamp.dts = virtual_us;
+      timestamp.time_base = AVRational{1, 1000000};
+      if (callbacks_.push_video(std::move(frame), timestamp,
+                                kPushFrameTimeoutMs)) {
+        --index;
+      }
+    }
+    chunk.reset();  // 尽早释放，给工作线程的下一块腾出内存
+  }
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "ReverseTask stopped");
+}
+
+}  // namespace zenplay
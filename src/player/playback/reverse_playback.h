@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "player/codec/reverse_decoder.h"
+#include "player/common/common_def.h"
+#include "player/common/error.h"
+#include "player/sync/av_sync_controller.h"
+
+namespace zenplay {
+
+class PlayerStateManager;
+
+/**
+ * @brief 倒放：切换播放方向并呈现倒序帧块
+ *
+ * 帧来源按 GOP 交付帧块（块内 PTS 升序，块间时间倒退），呈现线程从每块
+ * 末尾开始推送。越早的帧映射到越大的虚拟时间戳：
+ *   virtual = origin + (origin - pts) / speed
+ * 时钟和 VideoPlayer 照常按正向时间工作；音频不倒放，倒放期间改用系统
+ * 时钟驱动视频。
+ *
+ * @note 方向只在 SeekTask 线程切换：BeginSeek() 在清空队列之前调用，
+ *       Start() 在同步控制器重置到目标位置之后调用
+ */
+class ReversePlayback {
+ public:
+  // 推送一帧；超时或被打断返回 false（帧已释放）
+  using FrameSink = std::function<
+      bool(AVFramePtr frame, const MediaTimestamp& timestamp, int timeout_ms)>;
+  // 从 origin_ms 开始倒序产出帧块（已启动）
+  using SourceFactory =
+      std::function<Result<std::unique_ptr<ReverseFrameSource>>(
+          int64_t origin_ms)>;
+
+  struct Callbacks {
+    FrameSink push_video;
+    SourceFactory create_source;
+    // 进入 / 离开倒放：唤醒停下的解封装线程
+    std::function<void()> active_changed;
+  };
+
+  static constexpr double kMinSpeed = 0.25;
+  static constexpr double kMaxSpeed = 4.0;
+
+  ReversePlayback(PlayerStateManager* state_manager,
+                  AVSyncController* sync_controller,
+                  Callbacks callbacks);
+  ~ReversePlayback();
+
+  ReversePlayback(const ReversePlayback&) = delete;
+  ReversePlayback& operator=(const ReversePlayback&) = delete;
+
+  /**
+   * @brief 把负的播放速率限制到支持的倒放速度范围
+   */
+  static double ClampRate(double rate);
+
+  /**
+   * @brief Seek 开始时确定方向并停止上一次的呈现
+   * @param playback_rate 负数切换到倒放，正数切回正放，0 保持当前方向
+   * @param target_ms 跳转目标，倒放时作为新的起点
+   * @return 本次 Seek 之后是否倒放
+   */
+  bool BeginSeek(double playback_rate, int64_t target_ms);
+
+  /**
+   * @brief 从 BeginSeek 记录的起点开始倒放；失败时恢复正放
+   */
+  Result<void> Start();
+
+  /**
+   * @brief 停止帧来源和呈现线程（不改变方向）
+   */
+  void Stop();
+
+  /**
+   * @brief 停止并恢复正放（下次 Start 从正放开始）
+   */
+  void Reset();
+
+  /**
+   * @brief 倒放时时钟照常前进，映射回倒退的媒体位置
+   */
+  int64_t MapClock(int64_t clock_ms) const;
+
+  /**
+   * @brief 当前播放速率：正放 1.0，倒放为负的倒放速度
+   */
+  double PlaybackRate() const;
+
+  bool IsActive() const { return active_.load(); }
+
+ private:
+  /**
+   * @brief 倒放呈现线程：取帧块，按倒序映射时间戳后推送
+   */
+  void PresentTask();
+
+  /**
+   * @brief 切回正放并恢复原来的同步模式
+   */
+  void RestoreForward();
+
+  PlayerStateManager* state_manager_;
+  AVSyncController* sync_controller_;
+  Callbacks callbacks_;
+
+  std::atomic<bool> active_{false};
+  std::atomic<double> speed_{1.0};  // 倒放速度（正数）
+  std::atomic<int64_t> origin_ms_{0};
+  AVSyncController::SyncMode forward_sync_mode_ =
+      AVSyncController::SyncMode::AUDIO_MASTER;
+
+  std::unique_ptr<ReverseFrameSource> source_;
+  std::atomic<bool> task_stop_{false};
+  std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace zenplay
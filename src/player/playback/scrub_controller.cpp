@@ -0,0 +1,141 @@
+#include "player/playback/scrub_controller.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "player/common/log_manager.h"
+
+extern "C" {
+#include <libavcodec/packet.h>
+}
+
+namespace zenplay {
+
+ScrubController::ScrubController(Callbacks callbacks)
+    : callbacks_(std::move(callbacks)) {}
+
+void ScrubController::Begin(bool preview, std::chrono::milliseconds interval) {
+  interval_ms_.store(std::max<int64_t>(interval.count(), 0));
+  preview_enabled_.store(preview);
+
+  bool resume_after = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 上一次松开的 Seek 还没执行完：恢复播放的责任交给这一次拖动
+    resume_after_ = resume_pending_;
+    resume_pending_ = false;
+    PauseIfPlaying_Locked();
+    resume_after = resume_after_;
+  }
+  scrubbing_.store(true);
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "Scrub started (preview: {}, resume: {})",
+              preview, resume_after);
+}
+
+void ScrubController::MoveTo(int64_t timestamp_ms) {
+  if (!scrubbing_.load() || !preview_enabled_.load()) {
+    return;
+  }
+  // 不阻塞 UI 线程：队列满说明预览跟不上，丢掉这一个位置，松开时会
+  // 精确跳转到最终位置
+  if (!callbacks_.queue_preview(timestamp_ms)) {
+    MODULE_DEBUG(LOG_MODULE_PLAYER, "Scrub preview dropped: {}ms",
+                 timestamp_ms);
+  }
+}
+
+void ScrubController::End(int64_t timestamp_ms) {
+  if (!scrubbing_.exchange(false)) {
+    callbacks_.seek(timestamp_ms);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    resume_pending_ = resume_after_;
+    resume_after_ = false;
+  }
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "Scrub released at {}ms", timestamp_ms);
+  callbacks_.queue_release(timestamp_ms);
+}
+
+int64_t ScrubController::PreviewWaitMs() const {
+  auto due = last_preview_ + std::chrono::milliseconds(interval_ms_.load());
+  auto now = std::chrono::steady_clock::now();
+  if (now >= due) {
+    return 0;
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(due - now)
+             .count() +
+         1;
+}
+
+void ScrubController::ShowPreview(int64_t target_ms) {
+  last_preview_ = std::chrono::steady_clock::now();
+  if (!scrubbing_.load()) {
+    return;  // 拖动已结束，松开时的 Seek 会跳到最终位置
+  }
+  {
+    // 开始拖动时上一次 Seek 可能还在执行，完成后又恢复了播放
+    std::lock_guard<std::mutex> lock(mutex_);
+    PauseIfPlaying_Locked();
+  }
+
+  AVFramePtr frame = callbacks_.decode_keyframe(target_ms);
+  if (!frame) {
+    MODULE_DEBUG(LOG_MODULE_PLAYER, "Scrub preview: no frame at {}ms",
+                 target_ms);
+    return;
+  }
+  callbacks_.show_frame(frame.get());
+  MODULE_DEBUG(LOG_MODULE_PLAYER, "Scrub preview shown for {}ms", target_ms);
+}
+
+void ScrubController::OnSeekCompleted(bool success) {
+  // 拖动前在播放：松开时的 Seek 完成后恢复（与 ZenPlayer::Play 从暂停
+  // 恢复的步骤相同）
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!resume_pending_) {
+    return;
+  }
+  resume_pending_ = false;
+  if (success) {
+    callbacks_.resume_playback();
+  }
+}
+
+AVFramePtr ScrubController::DecodeFirstVideoFrame(
+    int video_stream_index,
+    const ReadPacket& read_packet,
+    const DecodePacket& decode,
+    size_t max_packets) {
+  std::vector<AVFramePtr> frames;
+  for (size_t i = 0; i < max_packets && frames.empty(); ++i) {
+    AVPacket* packet = read_packet();
+    if (!packet) {
+      break;
+    }
+    if (packet->stream_index == video_stream_index) {
+      decode(packet, &frames);
+      if (frames.empty()) {
+        // 解码器有输出延迟（帧级多线程等）：送入结束标记取出这一帧
+        decode(nullptr, &frames);
+      }
+    }
+    av_packet_free(&packet);
+  }
+
+  if (frames.empty()) {
+    return nullptr;
+  }
+  return std::move(frames.front());
+}
+
+void ScrubController::PauseIfPlaying_Locked() {
+  if (callbacks_.pause_if_playing()) {
+    resume_after_ = true;
+  }
+}
+
+}  // namespace zenplay
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "player/common/common_def.h"
+
+struct AVPacket;
+
+namespace zenplay {
+
+/**
+ * @brief 拖动进度条
+ *
+ * Begin() 时正在播放则暂停；拖动中 MoveTo() 把位置交给调用方排队，
+ * 由 SeekTask 按 PreviewWaitMs() 限频后调用 ShowPreview()：只跳到关键帧
+ * 并解码这一帧显示，不切换播放状态。End() 请求精确跳转到松开的位置，
+ * 该 Seek 完成（OnSeekCompleted）后按 Begin() 时的状态恢复播放。
+ *
+ * @note UI 线程调用 Begin / MoveTo / End，SeekTask 线程调用 ShowPreview /
+ *       OnSeekCompleted；恢复播放的责任由内部锁在两者之间交接
+ */
+class ScrubController {
+ public:
+  // 读取下一个包，出错或结束时返回 nullptr（调用方负责释放返回的包）
+  using ReadPacket = std::function<AVPacket*()>;
+  // 送入一个包；packet 为 nullptr 时送入结束标记取出剩余帧并重置解码器
+  using DecodePacket =
+      std::function<void(AVPacket* packet, std::vector<AVFramePtr>* frames)>;
+
+  struct Callbacks {
+    // 正在播放则暂停并返回 true
+    std::function<bool()> pause_if_playing;
+    // 松开时的 Seek 完成后恢复播放
+    std::function<void()> resume_playback;
+    // 排队一个预览位置；队列满时返回 false（丢弃这一个位置）
+    std::function<bool(int64_t timestamp_ms)> queue_preview;
+    // 排队松开时的精确 Seek
+    std::function<void(int64_t timestamp_ms)> queue_release;
+    // 未在拖动时松开：普通 Seek
+    std::function<void(int64_t timestamp_ms)> seek;
+    // 丢弃旧位置的帧和包，跳到 timestamp_ms 之前的关键帧并解码这一帧
+    std::function<AVFramePtr(int64_t timestamp_ms)> decode_keyframe;
+    // 显示预览帧（不进入播放队列）
+    std::function<void(AVFrame* frame)> show_frame;
+  };
+
+  explicit ScrubController(Callbacks callbacks);
+
+  ScrubController(const ScrubController&) = delete;
+  ScrubController& operator=(const ScrubController&) = delete;
+
+  /**
+   * @brief 开始拖动：播放中则暂停，松开后恢复
+   * @param preview 拖动中是否预览（倒放和 A-B 循环占用着解码器时关闭）
+   * @param interval 相邻两次预览的最小间隔
+   */
+  void Begin(bool preview, std::chrono::milliseconds interval);
+
+  /**
+   * @brief 拖动到 timestamp_ms：排队一次预览（不阻塞，积压时丢弃）
+   */
+  void MoveTo(int64_t timestamp_ms);
+
+  /**
+   * @brief 结束拖动：排队精确跳转到松开的位置
+   */
+  void End(int64_t timestamp_ms);
+
+  /**
+   * @brief 距离下一次允许预览还需等待的时间，0 表示可以立即预览
+   */
+  int64_t PreviewWaitMs() const;
+
+  /**
+   * @brief SeekTask：显示 target_ms 附近关键帧的预览
+   */
+  void ShowPreview(int64_t target_ms);
+
+  /**
+   * @brief SeekTask：普通 / 精确 Seek 执行完成，松开后的 Seek 完成时恢复播放
+   */
+  void OnSeekCompleted(bool success);
+
+  bool IsScrubbing() const { return scrubbing_.load(); }
+
+  /**
+   * @brief 从关键帧开始读包，解码出第一帧视频
+   *
+   * 跳过其他流的包；解码器有输出延迟（帧级多线程等）时送入结束标记
+   * 取出这一帧。最多读取 max_packets 个包。
+   *
+   * @return 没有解码出帧时返回 nullptr
+   */
+  static AVFramePtr DecodeFirstVideoFrame(int video_stream_index,
+                                          const ReadPacket& read_packet,
+                                          const DecodePacket& decode,
+                                          size_t max_packets);
+
+ private:
+  /**
+   * @brief 播放中则暂停，拖动结束后恢复播放（调用方持有 mutex_）
+   */
+  void PauseIfPlaying_Locked();
+
+  Callbacks callbacks_;
+
+  // 预览开关和间隔在 Begin() 时确定；last_preview_ 只在 SeekTask 线程访问
+  std::atomic<bool> scrubbing_{false};
+  std::atomic<bool> preview_enabled_{false};
+  std::atomic<int64_t> interval_ms_{50};
+  std::chrono::steady_clock::time_point last_preview_{};
+
+  // 拖动前在播放：松开时的 Seek 完成后恢复播放
+  std::mutex mutex_;
+  bool resume_after_ = false;    // 本次拖动结束后恢复播放
+  bool resume_pending_ = false;  // 松开时的 Seek 尚未执行完
+};
+
+}  // namespace zenplay
@@ -1,17 +1,26 @@
 #include "player/playback_controller.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <mutex>
+#include <utility>
 
 #include "loki/src/bind_util.h"
 #include "loki/src/location.h"
 #include "player/audio/audio_player.h"
 #include "player/audio/audio_resampler.h"
 #include "player/codec/audio_decoder.h"
+#include "player/codec/reverse_decoder.h"
 #include "player/codec/video_decoder.h"
 #include "player/common/log_manager.h"
 #include "player/common/player_state_manager.h"
 #include "player/common/timer_util.h"
+#include "player/config/global_config.h"
 #include "player/demuxer/demuxer.h"
+#include "player/stats/alloc_tracker.h"
 #include "player/stats/statistics_manager.h"
 #include "player/sync/av_sync_controller.h"
 #include "player/video/render/renderer.h"
@@ -20,43 +29,151 @@
 
 namespace zenplay {
 
+namespace {
+
+// 数据包 PTS（毫秒），用于卡死检测上报进度；未知时返回 -1
+int64_t PacketPtsMs(const Demuxer* demuxer, const AVPacket* packet) {
+  if (!packet || packet->pts == AV_NOPTS_VALUE) {
+    return -1;
+  }
+  AVStream* stream = demuxer->findStreamByIndex(packet->stream_index);
+  if (!stream) {
+    return -1;
+  }
+  return av_rescale_q(packet->pts, stream->time_base, AVRational{1, 1000});
+}
+
+// 视频流的标称帧率：优先 avg_frame_rate，无效时用 r_frame_rate；
+// 未知（或 VFR 流给出的时间基式帧率）返回 0
+double NominalFrameRate(const Demuxer* demuxer) {
+  AVStream* stream =
+      demuxer->findStreamByIndex(demuxer->active_video_stream_index());
+  if (!stream) {
+    return 0.0;
+  }
+  constexpr double kMaxPlausibleFps = 1000.0;
+  for (AVRational rate : {stream->avg_frame_rate, stream->r_frame_rate}) {
+    if (rate.num > 0 && rate.den > 0 && av_q2d(rate) <= kMaxPlausibleFps) {
+      return av_q2d(rate);
+    }
+  }
+  return 0.0;
+}
+
+// 音频输出格式：固定使用常见的 CD 音质配置，周期和队列容量取自配置档
+AudioPlayer::AudioConfig MakeAudioOutputConfig(const PipelineProfile& profile) {
+  AudioPlayer::AudioConfig audio_config;
+  audio_config.target_sample_rate = 44100;         // CD 音质标准
+  audio_config.target_channels = 2;                // 立体声
+  audio_config.target_format = AV_SAMPLE_FMT_S16;  // 16位整数
+  audio_config.target_bits_per_sample = 16;
+  audio_config.buffer_size = profile.audio_period_frames;  // 音频周期
+  audio_config.max_frame_queue_size = profile.audio_frame_queue;
+  return audio_config;
+}
+
+// Seek 后回填时一次读取的最大包数
+constexpr size_t kDemuxRefillPackets = 32;
+
+// 两个包队列都满时，轮流等待其中一个的时长
+constexpr int64_t kDemuxPushWaitMs = 5;
+
+// 拖动预览时最多读取的包数，读完仍没有视频帧则放弃这次预览
+constexpr size_t kScrubMaxPackets = 256;
+
+// 精确 Seek 未设置目标位置
+constexpr int64_t kNoSeekTarget = INT64_MIN;
+
+// 精确 Seek：目标位置之前的帧丢弃；到达目标（或时间戳未知）后解除
+bool ReachedSeekTarget(std::atomic<int64_t>* target, int64_t position) {
+  int64_t value = target->load(std::memory_order_relaxed);
+  if (value == kNoSeekTarget) {
+    return true;
+  }
+  if (position != kNoSeekTarget && position < value) {
+    return false;
+  }
+  target->compare_exchange_strong(value, kNoSeekTarget);
+  return true;
+}
+
+void FreePacketBatch(std::vector<AVPacket*>* packets) {
+  for (AVPacket*& packet : *packets) {
+    av_packet_free(&packet);
+  }
+  packets->clear();
+}
+
+// 统计管理器是进程内单例：报告间隔和报告头部的配置档名称只由进程内
+// 第一个播放流水线设置一次，对比模式下后打开的流水线不会覆盖
+void ApplyStatsProfileOnce(const PipelineProfile& profile) {
+  static std::once_flag applied;
+  auto* stats_manager = stats::StatisticsManager::GetInstance();
+  if (!stats_manager) {
+    return;
+  }
+  std::call_once(applied, [stats_manager, &profile]() {
+    stats_manager->SetPipelineProfile(profile.name);
+    stats_manager->SetReportInterval(
+        std::chrono::milliseconds(profile.stats_report_interval_ms));
+  });
+}
+
+// 整批推入包队列；队列停止时释放未推入的包
+bool PushPacketBatch(BlockingQueue<AVPacket*>* queue,
+                     std::vector<AVPacket*>* packets) {
+  if (!packets->empty()) {
+    queue->PushBatch(*packets);  // 推入的包从 packets 头部移除
+  }
+  bool ok = packets->empty();
+  FreePacketBatch(packets);
+  return ok;
+}
+
+}  // namespace
+
 PlaybackController::PlaybackController(
     std::shared_ptr<PlayerStateManager> state_manager,
     Demuxer* demuxer,
     VideoDecoder* video_decoder,
     AudioDecoder* audio_decoder,
-    Renderer* renderer)
+    Renderer* renderer,
+    const PipelineProfile& profile,
+    std::unique_ptr<AudioPlayer> audio_player)
     : demuxer_(demuxer),
       video_decoder_(video_decoder),
       audio_decoder_(audio_decoder),
       renderer_(renderer),
-      state_manager_(state_manager) {
+      state_manager_(state_manager),
+      profile_(profile) {
   MODULE_INFO(LOG_MODULE_PLAYER,
               "PlaybackController created with unified state management");
+  raw_video_source_ = demuxer_ ? demuxer_->raw_video_source() : nullptr;
+  MODULE_INFO(LOG_MODULE_PLAYER,
+              "Pipeline profile '{}': packet queues {}/{}, frame queues "
+              "{}/{}, audio period {}, decoder threads {} ({})",
+              profile_.name, profile_.video_packet_queue,
+              profile_.audio_packet_queue, profile_.video_frame_queue,
+              profile_.audio_frame_queue, profile_.audio_period_frames,
+              profile_.decoder_threads, profile_.decoder_thread_type);
+  video_packet_queue_.SetMaxSize(profile_.video_packet_queue);
+  audio_packet_queue_.SetMaxSize(profile_.audio_packet_queue);
+
+  ApplyStatsProfileOnce(profile_);
   // 初始化音视频同步控制器
   av_sync_controller_ = std::make_unique<AVSyncController>();
 
   // ✅ 初始化音频播放器（先初始化，获取硬件支持的格式）
-  audio_player_ = std::make_unique<AudioPlayer>(state_manager_.get(),
-                                                av_sync_controller_.get());
+  // ZenPlayer 在探测文件的同时已经打开了设备，这里只接上同步控制器
+  audio_player_ = audio_player
+                      ? std::move(audio_player)
+                      : OpenAudioPlayer(state_manager_.get(), profile_);
+  if (audio_player_) {
+    audio_player_->SetSyncController(av_sync_controller_.get());
+  }
 
   // ✅ 使用 AudioPlayer 的配置来设置重采样器
-  // 原因：AudioPlayer::Init() 会根据硬件能力选择最佳配置
-  AudioPlayer::AudioConfig audio_config;
-  // 注意：这里可以从配置文件或用户设置中读取
-  // 默认使用常见的 CD 音质配置
-  audio_config.target_sample_rate = 44100;         // CD 音质标准
-  audio_config.target_channels = 2;                // 立体声
-  audio_config.target_format = AV_SAMPLE_FMT_S16;  // 16位整数
-  audio_config.target_bits_per_sample = 16;
-  audio_config.buffer_size = 1024;  // 缓冲区大小
-
-  auto audio_init_result = audio_player_->Init(audio_config);
-  if (!audio_init_result.IsOk()) {
-    MODULE_ERROR(LOG_MODULE_PLAYER, "Failed to initialize audio player: {}",
-                 audio_init_result.FullMessage());
-    audio_player_.reset();
-  }
+  AudioPlayer::AudioConfig audio_config = MakeAudioOutputConfig(profile_);
 
   // ✅ 初始化音频重采样器（使用与 AudioPlayer 一致的配置）
   audio_resampler_ = std::make_unique<AudioResampler>();
@@ -76,7 +193,8 @@ PlaybackController::PlaybackController(
 
   // 根据音视频流的存在情况智能选择同步模式
   bool has_audio = audio_decoder_ && audio_decoder_->opened();
-  bool has_video = video_decoder_ && video_decoder_->opened();
+  bool has_video =
+      (video_decoder_ && video_decoder_->opened()) || raw_video_source_;
 
   if (has_audio && has_video) {
     // 场景 1：音视频都有 → 使用音频主时钟（标准播放）
@@ -110,16 +228,27 @@ PlaybackController::PlaybackController(
   }
 
   // 初始化视频播放器 (如果有视频流)
-  if (video_decoder_ && video_decoder_->opened()) {
+  if (has_video) {
     MODULE_INFO(LOG_MODULE_PLAYER,
-                "Video decoder is opened, creating VideoPlayer");
+                "Video stream available, creating VideoPlayer");
 
     // 创建VideoPlayer并传递state_manager和AVSyncController
     video_player_ = std::make_unique<VideoPlayer>(state_manager_.get(),
                                                   av_sync_controller_.get());
 
     // 创建线程安全的渲染代理
-    if (!video_player_->Init(renderer_)) {
+    VideoPlayer::VideoConfig video_config;
+    video_config.max_frame_queue_size = profile_.video_frame_queue;
+    double nominal_fps = demuxer_ ? NominalFrameRate(demuxer_) : 0.0;
+    if (nominal_fps > 0.0) {
+      video_config.target_fps = nominal_fps;
+    }
+    auto* config = GlobalConfig::Instance();
+    video_config.stats_overlay =
+        config->GetBool("render.stats_overlay.enabled", false);
+    video_config.stats_overlay_interval_ms =
+        config->GetInt("render.stats_overlay.update_interval_ms", 250);
+    if (!video_player_->Init(renderer_, video_config)) {
       MODULE_ERROR(LOG_MODULE_PLAYER, "Failed to initialize video player");
       video_player_.reset();
     } else {
@@ -128,12 +257,45 @@ PlaybackController::PlaybackController(
   } else {
     MODULE_WARN(LOG_MODULE_PLAYER, "Video decoder not opened or not available");
   }
+
+  // ✅ HLS 多码率流：启用自适应码率
+  if (demuxer_) {
+    auto variants = demuxer_->GetVariants();
+    if (variants.size() > 1) {
+      abr_controller_ = std::make_unique<AbrController>();
+      abr_controller_->SetVariants(std::move(variants),
+                                   demuxer_->current_variant());
+      MODULE_INFO(LOG_MODULE_PLAYER, "Adaptive bitrate enabled, {} variants",
+                  abr_controller_->variant_count());
+    }
+  }
+
+  InitAbLoop();
+  InitReverse();
+  InitScrub();
+  InitWatchdog();
+  StartPacketCapture();
+  StartFrameExport();
 }
 
 PlaybackController::~PlaybackController() {
   Stop();
 }
 
+std::unique_ptr<AudioPlayer> PlaybackController::OpenAudioPlayer(
+    PlayerStateManager* state_manager,
+    const PipelineProfile& profile) {
+  auto audio_player = std::make_unique<AudioPlayer>(state_manager);
+  auto result = audio_player->Init(MakeAudioOutputConfig(profile),
+                                   AudioOutput::Create());
+  if (!result.IsOk()) {
+    MODULE_ERROR(LOG_MODULE_PLAYER, "Failed to initialize audio player: {}",
+                 result.FullMessage());
+    return nullptr;
+  }
+  return audio_player;
+}
+
 Result<void> PlaybackController::Start() {
   // 注意：不再需要 state_mutex_，状态由 PlayerStateManager 管理
 
@@ -141,10 +303,17 @@ Result<void> PlaybackController::Start() {
   video_packet_queue_.Reset();
   audio_packet_queue_.Reset();
   seek_request_queue_.Reset();
+  demux_refill_.store(true);
+  if (demuxer_) {
+    demuxer_->ResetInterrupt();
+  }
 
   // 启动解封装线程 - 使用专门的工作线程
-  demux_thread_ =
-      std::make_unique<std::thread>(&PlaybackController::DemuxTask, this);
+  // 未压缩视频源没有数据包，由同一线程直接推送帧
+  demux_thread_ = std::make_unique<std::thread>(
+      raw_video_source_ ? &PlaybackController::RawVideoTask
+                        : &PlaybackController::DemuxTask,
+      this);
 
   // 启动视频解码线程
   if (video_decoder_ && video_decoder_->opened()) {
@@ -192,6 +361,19 @@ Result<void> PlaybackController::Start() {
   seek_thread_ =
       std::make_unique<std::thread>(&PlaybackController::SeekTask, this);
 
+  // 启动卡死检测
+  if (watchdog_) {
+    watchdog_->Rearm();
+    watchdog_->Start([this]() { return CaptureWatchdogContext(); },
+                     [](const PipelineWatchdog::Snapshot& snapshot) {
+                       std::string text = snapshot.ToString();
+                       MODULE_ERROR(LOG_MODULE_PLAYER,
+                                    "Pipeline stall detected: {}", text);
+                       STATS_UPDATE_STALL(snapshot.stalled_mask(), text);
+                     });
+  }
+  SetStatsPipelineActive(true);
+
   MODULE_INFO(LOG_MODULE_PLAYER, "PlaybackController started");
   return Result<void>::Ok();
 }
@@ -202,6 +384,11 @@ void PlaybackController::Stop() {
   // ✅ StopAllThreads 内部会调用 audio_player_->Stop() 和 video_player_->Stop()
   // 这样可以确保在 join 之前，播放器的队列已经停止
   StopAllThreads();
+  ab_loop_->Disable();
+  SetStatsPipelineActive(false);
+
+  // 下次 Start 从正放开始
+  reverse_->Reset();
 
   // 清空所有队列（packet 队列需要手动清空）
   ClearAllQueues();
@@ -226,6 +413,17 @@ void PlaybackController::Pause() {
   if (av_sync_controller_) {
     av_sync_controller_->Pause();
   }
+
+  // 步骤 3：暂停期间不需要卡死检测和统计定时器，避免空闲时被定时唤醒
+  if (watchdog_) {
+    watchdog_->Suspend();
+  }
+  SetStatsPipelineActive(false);
+
+  // 暂停写入抓取文件，回放时扣除暂停时长，不重现为卡顿
+  if (packet_capture_) {
+    CheckCaptureWrite(packet_capture_->WritePause());
+  }
 }
 
 void PlaybackController::Resume() {
@@ -245,6 +443,23 @@ void PlaybackController::Resume() {
   if (video_player_) {
     video_player_->Resume();  // 唤醒渲染线程
   }
+
+  if (watchdog_) {
+    watchdog_->Resume();
+  }
+  SetStatsPipelineActive(true);
+
+  if (packet_capture_) {
+    CheckCaptureWrite(packet_capture_->WriteResume());
+  }
+}
+
+void PlaybackController::SetStatsPipelineActive(bool active) {
+  if (stats_pipeline_active_ == active) {
+    return;
+  }
+  stats_pipeline_active_ = active;
+  STATS_PIPELINE_ACTIVE(active);
 }
 
 bool zenplay::PlaybackController::Seek(int64_t timestamp_ms) {
@@ -254,10 +469,16 @@ bool zenplay::PlaybackController::Seek(int64_t timestamp_ms) {
   return false;
 }
 
-void PlaybackController::SeekAsync(int64_t timestamp_ms, bool backward) {
+uint64_t PlaybackController::SeekAsync(int64_t timestamp_ms, bool backward) {
   MODULE_INFO(LOG_MODULE_PLAYER, "SeekAsync requested: {}ms (backward: {})",
               timestamp_ms, backward);
 
+  return QueueSeekRequest(timestamp_ms, backward, false);
+}
+
+PlaybackController::SeekRequest PlaybackController::MakeSeekRequest(
+    int64_t timestamp_ms,
+    bool backward) {
   // 保存当前状态，用于 Seek 完成后恢复
   auto current_state = state_manager_->GetState();
   auto restore_state = PlayerStateManager::PlayerState::kStopped;
@@ -268,17 +489,110 @@ void PlaybackController::SeekAsync(int64_t timestamp_ms, bool backward) {
     restore_state = PlayerStateManager::PlayerState::kPaused;
   }
 
-  // 创建 Seek 请求
   SeekRequest request(timestamp_ms, backward, restore_state);
+  request.serial = seek_request_serial_.fetch_add(1) + 1;
+  return request;
+}
+
+void PlaybackController::SupersedeSeekRequest(SeekRequest* latest,
+                                              SeekRequest pending) {
+  MODULE_DEBUG(LOG_MODULE_PLAYER, "Discarding old seek request: {}ms",
+               latest->timestamp_ms);
+  // 只切速率的请求沿用之前的目标位置，只跳转的请求沿用之前的速率切换
+  if (pending.timestamp_ms < 0) {
+    pending.timestamp_ms = latest->timestamp_ms;
+  }
+  if (pending.playback_rate == 0.0) {
+    pending.playback_rate = latest->playback_rate;
+  }
+  // 松开进度条的精确 Seek 被后续普通 Seek 替代时仍然精确
+  if (!pending.scrub_preview) {
+    pending.accurate = pending.accurate || latest->accurate;
+  }
+  *latest = pending;
+}
+
+uint64_t PlaybackController::QueueSeekRequest(int64_t timestamp_ms,
+                                              bool backward,
+                                              bool from_loop,
+                                              double playback_rate) {
+  // 创建 Seek 请求
+  SeekRequest request = MakeSeekRequest(timestamp_ms, backward);
+  request.from_loop = from_loop;
+  request.playback_rate = playback_rate;
 
   // 添加到请求队列（如果队列中已有请求，新请求会替代旧请求）
   if (!seek_request_queue_.Push(request)) {
     MODULE_ERROR(LOG_MODULE_PLAYER,
                  "Failed to queue seek request (queue stopped)");
-    return;
+    return 0;
   }
 
-  MODULE_INFO(LOG_MODULE_PLAYER, "Seek request queued");
+  MODULE_INFO(LOG_MODULE_PLAYER, "Seek request {} queued", request.serial);
+  return request.serial;
+}
+
+void PlaybackController::BeginScrub() {
+  int64_t interval_ms = GlobalConfig::Instance()->GetInt(
+      "player.scrub.preview_interval_ms", 50);
+  // 倒放解码器和循环缓存占用着 Demuxer / 解码器，拖动时只在松开后跳转
+  bool preview = video_player_ && video_decoder_ &&
+                 video_decoder_->opened() && !reverse_->IsActive() &&
+                 !ab_loop_->IsActive();
+  scrub_->Begin(preview, std::chrono::milliseconds(interval_ms));
+}
+
+void PlaybackController::ScrubTo(int64_t timestamp_ms) {
+  scrub_->MoveTo(timestamp_ms);
+}
+
+void PlaybackController::EndScrub(int64_t timestamp_ms) {
+  scrub_->End(timestamp_ms);
+}
+
+void PlaybackController::SetLoopRange(int64_t start_ms, int64_t end_ms) {
+  ab_loop_->SetRange(start_ms, end_ms);
+  // A-B 循环总是正放
+  QueueSeekRequest(start_ms, true, true, 1.0);
+}
+
+void PlaybackController::ClearLoopRange() {
+  // 回放缓存时解码已停在 B 点，需要从当前位置重新开始解码
+  int64_t resume_ms = GetCurrentTime();
+  if (ab_loop_->ClearRange()) {
+    QueueSeekRequest(resume_ms, true, false);
+  }
+}
+
+bool PlaybackController::IsLooping() const {
+  return ab_loop_->IsActive();
+}
+
+Result<void> PlaybackController::SetPlaybackRate(double rate) {
+  // 正向变速需要音频时间伸缩，当前只支持正常正放和倒放
+  if (rate != 1.0 && !(rate < 0.0)) {
+    return Result<void>::Err(ErrorCode::kNotSupported,
+                             "Unsupported playback rate " +
+                                 std::to_string(rate) +
+                                 " (only 1.0 and negative rates)");
+  }
+  if (rate < 0.0 && !video_player_) {
+    return Result<void>::Err(ErrorCode::kNotSupported,
+                             "Reverse playback requires a video stream");
+  }
+
+  if (rate < 0.0) {
+    rate = ReversePlayback::ClampRate(rate);
+  }
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "Playback rate requested: {:.2f}", rate);
+  // 从执行时的当前位置切换方向
+  QueueSeekRequest(-1, true, false, rate);
+  return Result<void>::Ok();
+}
+
+double PlaybackController::GetPlaybackRate() const {
+  return reverse_->PlaybackRate();
 }
 
 void PlaybackController::ClearAllQueues() {
@@ -308,84 +622,325 @@ void PlaybackController::ClearAllQueues() {
   MODULE_DEBUG(LOG_MODULE_PLAYER, "All queues cleared");
 }
 
+bool PlaybackController::PushEndOfStream() {
+  if (video_decoder_ && video_decoder_->opened()) {
+    if (!video_packet_queue_.Push(nullptr)) {
+      return false;  // 队列已停止
+    }
+  }
+  if (audio_decoder_ && audio_decoder_->opened()) {
+    if (!audio_packet_queue_.Push(nullptr)) {
+      return false;  // 队列已停止
+    }
+  }
+  return true;
+}
+
 void PlaybackController::DemuxTask() {
+  STATS_ALLOC_THREAD(kDemux);
   if (!demuxer_) {
     return;
   }
 
+  std::vector<AVPacket*> video_batch;
+  std::vector<AVPacket*> audio_batch;
+  // 悬停预取命中后仍要跳过的已预取包
+  HoverSeekPrefetch::DeferredSeek skip;
+
   while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kDemux);
     // 检查暂停状态
     if (state_manager_->ShouldPause()) {
       state_manager_->WaitForResume();
       continue;
     }
 
+    // ✅ A-B 循环从缓存回放、倒放时不需要读包，等待结束
+    if (ShouldParkDemux()) {
+      WaitWhileDemuxParked();
+      continue;
+    }
+
     // ✅ 移除队列大小检查和 sleep，BlockingQueue 会自动阻塞
 
-    // 计算一下读取时间
-    TIMER_START(demux_read);
+    // ✅ Seek / 启动后两个包队列都是空的：连续读一批包，按流整批推入，
+    // 每个队列只加锁、唤醒解码线程一次；平时逐包读取、逐包推入
+    size_t read_limit =
+        demux_refill_.exchange(false) ? kDemuxRefillPackets : 1;
+    // 先取取消代数、再取 Seek 序号（Seek 按相反顺序递增两者）：拿到旧
+    // 序号时代数也是旧的，获取 demux 锁之前发生的取消同样打断这次读取
+    uint64_t io_generation = demuxer_->io_cancel_generation();
+    uint64_t seek_serial = demux_seek_serial_.load();
+    bool end_of_stream = !ApplyDeferredDemuxSeek(&skip, &seek_serial);
+
+    for (size_t i = 0; i < read_limit && !end_of_stream; ++i) {
+      if (i > 0 && state_manager_->ShouldPause()) {
+        break;  // 回填途中开始 Seek / 暂停，先交付已读出的包
+      }
+
+      std::unique_lock<std::mutex> demux_lock(demux_mutex_);
+      if (reverse_->IsActive()) {
+        break;  // 倒放已接管 Demuxer，回到循环开头停下
+      }
+
+      // 计算一下读取时间
+      TIMER_START(demux_read);
 
-    auto packet_result = demuxer_->ReadPacket();
-    if (!packet_result.IsOk()) {
-      // 读取失败，发送EOF信号
-      if (video_decoder_ && video_decoder_->opened()) {
-        if (!video_packet_queue_.Push(nullptr)) {
-          break;  // 队列已停止
+      auto packet_result = demuxer_->ReadPacket(io_generation);
+      demux_lock.unlock();
+      // 被打断的读取不属于流本身，不写入抓取文件
+      if (packet_capture_ && packet_result.Code() != ErrorCode::kCancelled) {
+        CapturePacketResult(packet_result);
+      }
+      if (!packet_result.IsOk()) {
+        // Seek / 停止打断了阻塞中的网络读取：不是流结束，回到循环开头
+        // 重新检查状态（Seek 序号已变化，这批包会被丢弃）。回放读到
+        // 抓取时的 Seek 也返回 kCancelled：照常执行一次 Seek
+        if (packet_result.Code() == ErrorCode::kCancelled) {
+          int64_t replay_seek_us = 0;
+          bool replay_backward = true;
+          if (demuxer_->TakeReplaySeek(&replay_seek_us, &replay_backward)) {
+            SeekAsync(replay_seek_us / 1000, replay_backward);
+          }
+          break;
         }
+        // 读取失败，发送EOF信号
+        end_of_stream = true;
+        break;
       }
-      if (audio_decoder_ && audio_decoder_->opened()) {
-        if (!audio_packet_queue_.Push(nullptr)) {
-          break;  // 队列已停止
+
+      AVPacket* packet = packet_result.Value();
+
+      // ReadPacket 返回 nullptr 表示 EOF（不是错误）
+      if (!packet) {
+        if (watchdog_) {
+          watchdog_->MarkFinished(PipelineWatchdog::Stage::kDemux);
         }
+        end_of_stream = true;
+        break;
+      }
+
+      auto demux_time_ms = TIMER_END_MS_INT(demux_read);
+
+      if (HoverSeekPrefetch::SkipPrefetchedPacket(packet, &skip)) {
+        av_packet_free(&packet);
+        continue;
+      }
+
+      if (abr_controller_) {
+        UpdateAdaptiveBitrate(packet, TIMER_END_MS(demux_read), seek_serial);
+      }
+
+      STATS_UPDATE_DEMUX(
+          1, packet->size, demux_time_ms,
+          packet->stream_index == demuxer_->active_video_stream_index());
+
+      WatchdogHeartbeat(PipelineWatchdog::Stage::kDemux,
+                        PacketPtsMs(demuxer_, packet));
+
+      // 分发packet到对应的解码队列
+      if (packet->stream_index == demuxer_->active_video_stream_index() &&
+          video_decoder_ && video_decoder_->opened()) {
+        video_batch.push_back(packet);
+      } else if (packet->stream_index ==
+                     demuxer_->active_audio_stream_index() &&
+                 audio_decoder_ && audio_decoder_->opened()) {
+        audio_batch.push_back(packet);
+      } else {
+        av_packet_free(&packet);
+      }
+    }
+
+    // 读取期间发生了 Seek：这批包（以及 EOF）属于旧位置，丢弃
+    if (demux_seek_serial_.load() != seek_serial) {
+      FreePacketBatch(&video_batch);
+      FreePacketBatch(&audio_batch);
+      continue;
+    }
+
+    // ✅ 队列满时阻塞，推入途中 Seek 则丢弃剩余的包（EOF 也属于旧位置）
+    if (!PushDemuxedPackets(&video_batch, &audio_batch, seek_serial)) {
+      if (video_packet_queue_.Stopped() || audio_packet_queue_.Stopped()) {
+        break;  // 队列已停止
       }
+      continue;
+    }
+
+    if (end_of_stream) {
+      PushEndOfStream();
       break;
     }
+  }
+}
 
-    AVPacket* packet = packet_result.Value();
+bool PlaybackController::PushDemuxedPackets(
+    std::vector<AVPacket*>* video_batch,
+    std::vector<AVPacket*>* audio_batch,
+    uint64_t seek_serial) {
+  // ExecuteSeek 先递增序号再清空队列：队列锁内检查序号，
+  // 清空之后不会再有旧位置的包进入队列
+  auto seek_changed = [this, seek_serial]() {
+    return demux_seek_serial_.load() != seek_serial;
+  };
+
+  while (!video_batch->empty() || !audio_batch->empty()) {
+    // 1. 不等待地推入两个队列当前能容纳的部分
+    size_t pushed =
+        video_packet_queue_.PushBatchFor(*video_batch, 0, seek_changed) +
+        audio_packet_queue_.PushBatchFor(*audio_batch, 0, seek_changed);
+    if (seek_changed() || video_packet_queue_.Stopped() ||
+        audio_packet_queue_.Stopped()) {
+      FreePacketBatch(video_batch);
+      FreePacketBatch(audio_batch);
+      return false;
+    }
+    if (pushed > 0) {
+      continue;
+    }
 
-    // ReadPacket 返回 nullptr 表示 EOF（不是错误）
-    if (!packet) {
-      // 发送EOF信号
-      if (video_decoder_ && video_decoder_->opened()) {
-        if (!video_packet_queue_.Push(nullptr)) {
-          break;  // 队列已停止
+    // 2. 都推不进去：只剩一个流时一直等它的队列；两个队列都满时
+    //    短暂等待视频队列，回到第 1 步，音频队列腾出空间也能及时推入
+    if (audio_batch->empty()) {
+      video_packet_queue_.PushBatchFor(*video_batch, -1, seek_changed);
+    } else if (video_batch->empty()) {
+      audio_packet_queue_.PushBatchFor(*audio_batch, -1, seek_changed);
+    } else {
+      video_packet_queue_.PushBatchFor(*video_batch, kDemuxPushWaitMs,
+                                       seek_changed);
+    }
+  }
+  return true;
+}
+
+bool PlaybackController::ApplyDeferredDemuxSeek(
+    HoverSeekPrefetch::DeferredSeek* skip,
+    uint64_t* seek_serial) {
+  std::lock_guard<std::mutex> lock(demux_mutex_);
+  if (!hover_prefetch_.TakeDeferredSeek(skip, seek_serial)) {
+    return true;
+  }
+  if (!demuxer_->Seek(skip->timestamp_us, true)) {
+    MODULE_ERROR(LOG_MODULE_PLAYER, "Deferred demuxer seek failed: {}us",
+                 skip->timestamp_us);
+    return false;
+  }
+  CaptureSeek(skip->timestamp_us, true);
+  return true;
+}
+
+void PlaybackController::WaitWhileDemuxParked() {
+  if (watchdog_) {
+    watchdog_->SetIdle(PipelineWatchdog::Stage::kDemux, true);
+  }
+  {
+    std::unique_lock<std::mutex> lock(demux_park_mutex_);
+    demux_park_cv_.wait(lock, [this]() {
+      return !ShouldParkDemux() || state_manager_->ShouldStop();
+    });
+  }
+  if (watchdog_) {
+    watchdog_->SetIdle(PipelineWatchdog::Stage::kDemux, false);
+  }
+}
+
+void PlaybackController::RawVideoTask() {
+  STATS_ALLOC_THREAD(kDemux);
+  if (!raw_video_source_ || !video_player_) {
+    return;
+  }
+
+  constexpr int kPushFrameTimeoutMs = 100;
+  const AVRational time_base = av_inv_q(raw_video_source_->frame_rate());
+
+  // 推送超时（队列满、暂停）时保留这一帧，下一轮重试
+  AVFramePtr pending;
+  VideoPlayer::FrameTimestamp pending_timestamp;
+  uint64_t pending_serial = 0;
+
+  while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kDemux);
+    if (state_manager_->ShouldPause()) {
+      state_manager_->WaitForResume();
+      video_player_->Resume();  // 唤醒等待的 PushFrameBlocking
+      continue;
+    }
+
+    if (ShouldParkDemux()) {
+      pending.reset();  // 回放缓存期间读取位置不再有效
+      WaitWhileDemuxParked();
+      continue;
+    }
+
+    // 等待期间发生了 Seek：这一帧属于旧位置
+    if (pending && demux_seek_serial_.load() != pending_serial) {
+      pending.reset();
+    }
+
+    if (!pending) {
+      uint64_t seek_serial = demux_seek_serial_.load();
+      std::unique_lock<std::mutex> demux_lock(demux_mutex_);
+      TIMER_START(raw_read);
+      auto frame_result = raw_video_source_->ReadFrame();
+      auto read_time = TIMER_END_MS(raw_read);
+      demux_lock.unlock();
+
+      if (!frame_result.IsOk() || !frame_result.Value()) {
+        if (!frame_result.IsOk()) {
+          MODULE_ERROR(LOG_MODULE_PLAYER, "Raw video read failed: {}",
+                       frame_result.FullMessage());
         }
-      }
-      if (audio_decoder_ && audio_decoder_->opened()) {
-        if (!audio_packet_queue_.Push(nullptr)) {
-          break;  // 队列已停止
+        ab_loop_->FinishStream(true);
+        if (watchdog_) {
+          watchdog_->MarkFinished(PipelineWatchdog::Stage::kDemux);
         }
+        MODULE_INFO(LOG_MODULE_PLAYER, "RawVideoTask: end of stream");
+        break;
+      }
+      if (demux_seek_serial_.load() != seek_serial) {
+        continue;  // 读取期间发生了 Seek
       }
-      break;
-    }
 
-    auto demux_time_ms = TIMER_END_MS_INT(demux_read);
+      AVFramePtr frame = std::move(frame_result.Value());
+      STATS_UPDATE_DECODE(true, true, read_time,
+                          video_player_->GetQueueSize());
 
-    STATS_UPDATE_DEMUX(
-        1, packet->size, demux_time_ms,
-        packet->stream_index == demuxer_->active_video_stream_index());
+      VideoPlayer::FrameTimestamp timestamp;
+      timestamp.pts = frame->pts;
+      timestamp.dts = frame->pkt_dts;
+      timestamp.time_base = time_base;
+      int64_t pts_us =
+          av_rescale_q(frame->pts, time_base, AVRational{1, 1000000});
+      WatchdogHeartbeat(PipelineWatchdog::Stage::kDemux, pts_us / 1000);
 
-    // ✅ BlockingQueue::Push 会自动阻塞直到有空间，无需手动检查
-    // 分发packet到对应的解码队列
-    if (packet->stream_index == demuxer_->active_video_stream_index() &&
-        video_decoder_ && video_decoder_->opened()) {
-      if (!video_packet_queue_.Push(packet)) {
-        av_packet_free(&packet);
-        break;  // 队列已停止
+      if (!ab_loop_->AcceptVideoFrame(frame.get(), timestamp)) {
+        continue;
       }
-    } else if (packet->stream_index == demuxer_->active_audio_stream_index() &&
-               audio_decoder_ && audio_decoder_->opened()) {
-      if (!audio_packet_queue_.Push(packet)) {
-        av_packet_free(&packet);
-        break;  // 队列已停止
+      if (frame_export_) {
+        frame_export_->Publish(frame.get(), pts_us);
       }
-    } else {
-      av_packet_free(&packet);
+
+      pending = std::move(frame);
+      pending_timestamp = timestamp;
+      pending_serial = seek_serial;
+    }
+
+    // 推送的是新引用（不拷贝像素），失败时 pending 仍可重试
+    AVFramePtr ref(av_frame_clone(pending.get()));
+    if (!ref) {
+      MODULE_ERROR(LOG_MODULE_PLAYER, "Failed to reference raw video frame");
+      break;
+    }
+    if (video_player_->PushFrameBlocking(std::move(ref), pending_timestamp,
+                                         kPushFrameTimeoutMs)) {
+      pending.reset();
     }
   }
+
+  MODULE_INFO(LOG_MODULE_PLAYER, "RawVideoTask: Thread exiting");
 }
 
 void PlaybackController::VideoDecodeTask() {
+  STATS_ALLOC_THREAD(kVideoDecode);
   if (!video_decoder_ || !video_decoder_->opened()) {
     return;
   }
@@ -401,6 +956,7 @@ void PlaybackController::VideoDecodeTask() {
   constexpr int kPushFrameTimeoutMs = 100;
 
   while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kVideoDecode);
     // ========================================
     // 检查暂停状态
     // ========================================
@@ -427,6 +983,15 @@ void PlaybackController::VideoDecodeTask() {
     // ========================================
     // 处理 Flush 或解码
     // ========================================
+    std::unique_lock<std::mutex> decode_lock(video_decode_mutex_);
+    if (reverse_->IsActive()) {
+      // 倒放已接管解码器：丢弃切换前残留的包
+      if (packet) {
+        av_packet_free(&packet);
+      }
+      continue;
+    }
+
     if (!packet) {
       // Flush 信号
       MODULE_DEBUG(LOG_MODULE_PLAYER, "VideoDecodeTask: Flushing decoder");
@@ -436,6 +1001,8 @@ void PlaybackController::VideoDecodeTask() {
       TIMER_START(video_decode);
       bool decode_success = video_decoder_->Decode(packet, &frames);
       auto decode_time = TIMER_END_MS(video_decode);
+      WatchdogHeartbeat(PipelineWatchdog::Stage::kVideoDecode,
+                        PacketPtsMs(demuxer_, packet));
 
       // 统计
       uint32_t frame_queue_size =
@@ -479,6 +1046,7 @@ void PlaybackController::VideoDecodeTask() {
             video_queue_size, packet_queue_size);
       }
     }
+    decode_lock.unlock();
 
     // ========================================
     // 推送所有解码得到的帧
@@ -496,6 +1064,22 @@ void PlaybackController::VideoDecodeTask() {
           }
         }
 
+        int64_t pts_us = frame->pts == AV_NOPTS_VALUE
+                             ? INT64_MIN
+                             : av_rescale_q(frame->pts, timestamp.time_base,
+                                            AVRational{1, 1000000});
+        if (!ReachedSeekTarget(&video_seek_target_us_, pts_us)) {
+          continue;  // 精确 Seek：目标位置之前的帧只解码不显示
+        }
+
+        if (!ab_loop_->AcceptVideoFrame(frame.get(), timestamp)) {
+          continue;
+        }
+
+        if (frame_export_) {
+          frame_export_->Publish(frame.get(), pts_us);
+        }
+
         // ========================================
         // 关键：推送帧，但有超时
         // ========================================
@@ -521,6 +1105,10 @@ void PlaybackController::VideoDecodeTask() {
 
     // Flush 时退出
     if (!packet) {
+      ab_loop_->FinishStream(true);
+      if (watchdog_) {
+        watchdog_->MarkFinished(PipelineWatchdog::Stage::kVideoDecode);
+      }
       MODULE_INFO(LOG_MODULE_PLAYER, "VideoDecodeTask: Exiting after flush");
       break;
     }
@@ -530,14 +1118,17 @@ void PlaybackController::VideoDecodeTask() {
 }
 
 void PlaybackController::AudioDecodeTask() {
+  STATS_ALLOC_THREAD(kAudioDecode);
   if (!audio_decoder_ || !audio_decoder_->opened()) {
     return;
   }
 
   AVPacket* packet = nullptr;
   std::vector<AVFramePtr> frames;
+  std::vector<ResampledAudioFrame> resampled_frames;
 
   while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kAudioDecode);
     // 检查暂停状态
     if (state_manager_->ShouldPause()) {
       state_manager_->WaitForResume();
@@ -572,16 +1163,27 @@ void PlaybackController::AudioDecodeTask() {
 
           // ✅ Flush时也使用相同的重采样流程
           ResampledAudioFrame resampled;
-          if (audio_resampler_->Resample(frame.get(), timestamp, resampled)) {
-            audio_player_->PushFrame(std::move(resampled));
+          if (audio_resampler_->Resample(frame.get(), timestamp, resampled) &&
+              ab_loop_->AcceptAudioFrame(resampled)) {
+            resampled_frames.push_back(std::move(resampled));
           }
         }
       }
+      // ✅ Flush 一次取出的剩余帧整批推入
+      if (audio_player_ && !resampled_frames.empty()) {
+        audio_player_->PushFrames(resampled_frames);
+      }
+      ab_loop_->FinishStream(false);
+      if (watchdog_) {
+        watchdog_->MarkFinished(PipelineWatchdog::Stage::kAudioDecode);
+      }
       break;
     }
 
     TIMER_START(audio_decode);
     bool decode_success = audio_decoder_->Decode(packet, &frames);
+    WatchdogHeartbeat(PipelineWatchdog::Stage::kAudioDecode,
+                      PacketPtsMs(demuxer_, packet));
 
     STATS_UPDATE_DECODE(false, decode_success, TIMER_END_MS(audio_decode),
                         audio_packet_queue_.Size());
@@ -611,10 +1213,27 @@ void PlaybackController::AudioDecodeTask() {
             continue;
           }
 
-          // Step 2: AudioPlayer 管理播放队列（BlockingQueue自动流控）
-          audio_player_->PushFrame(std::move(resampled));
+          // 精确 Seek：丢弃在目标位置之前就结束的音频帧
+          int64_t end_ms = resampled.pts_ms +
+                           static_cast<int64_t>(resampled.GetDurationMs());
+          if (!ReachedSeekTarget(&audio_seek_target_ms_, end_ms)) {
+            continue;
+          }
+
+          if (!ab_loop_->AcceptAudioFrame(resampled)) {
+            continue;
+          }
+
+          resampled_frames.push_back(std::move(resampled));
         }
       }
+
+      // Step 2: AudioPlayer 管理播放队列（BlockingQueue自动流控）
+      // 一个包可能解码出多帧，整批推入只加一次锁、唤醒一次
+      if (audio_player_ && !resampled_frames.empty()) {
+        audio_player_->PushFrames(resampled_frames);
+        resampled_frames.clear();
+      }
     }
 
     av_packet_free(&packet);
@@ -622,7 +1241,9 @@ void PlaybackController::AudioDecodeTask() {
 }
 
 void PlaybackController::SyncControlTask() {
+  STATS_ALLOC_THREAD(kSyncControl);
   while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kSyncControl);
     // 检查暂停状态
     if (state_manager_->ShouldPause()) {
       state_manager_->WaitForResume();
@@ -648,17 +1269,356 @@ void PlaybackController::SyncControlTask() {
       }
     }
 
-    // 100Hz更新频率
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    // 每秒检查一次；暂停 / 停止时立即返回，由上面的 WaitForResume 阻塞
+    state_manager_->WaitWhilePlaying(1000);
+  }
+}
+
+void PlaybackController::UpdateAdaptiveBitrate(const AVPacket* packet,
+                                               double read_time_ms,
+                                               uint64_t seek_serial) {
+  // ✅ Seek 之后队列已清空：缓冲估计从 Seek 后的第一个视频包重新开始，
+  // 跨越 Seek 的下载累计量也不能算作一个分片样本
+  if (seek_serial != abr_seek_serial_) {
+    abr_seek_serial_ = seek_serial;
+    abr_first_video_pts_ms_ = -1;
+    abr_last_video_pts_ms_ = -1;
+    abr_controller_->OnSeek();
   }
+
+  abr_controller_->OnPacketRead(packet->size, read_time_ms);
+
+  if (packet->stream_index != demuxer_->active_video_stream_index() ||
+      packet->pts == AV_NOPTS_VALUE) {
+    return;
+  }
+
+  AVStream* stream = demuxer_->findStreamByIndex(packet->stream_index);
+  if (!stream) {
+    return;
+  }
+  int64_t pts_ms = av_rescale_q(packet->pts, stream->time_base, {1, 1000});
+  int64_t now_ms = GetCurrentTime();
+  if (abr_first_video_pts_ms_ < 0) {
+    abr_first_video_pts_ms_ = pts_ms;
+    abr_first_clock_ms_ = now_ms;
+  }
+  abr_last_video_pts_ms_ = pts_ms;
+
+  // 缓冲水位 = 本段已解封装的媒体时长 - 本段已播放的时长
+  double buffer_ms = std::max<double>(
+      0.0, static_cast<double>((abr_last_video_pts_ms_ -
+                                abr_first_video_pts_ms_) -
+                               (now_ms - abr_first_clock_ms_)));
+  const double kTargetBufferMs = 10000.0;
+  uint32_t buffer_health = static_cast<uint32_t>(
+      std::min(100.0, buffer_ms * 100.0 / kTargetBufferMs));
+
+  // HLS 分片总是以关键帧开始，当前档位的关键帧即分片边界
+  if ((packet->flags & AV_PKT_FLAG_KEY) &&
+      !demuxer_->IsVariantSwitchPending()) {
+    abr_controller_->CommitSwitch(demuxer_->current_variant());
+    int target = abr_controller_->OnSegmentBoundary(buffer_ms);
+    if (target != demuxer_->current_variant()) {
+      MODULE_INFO(LOG_MODULE_PLAYER,
+                  "ABR: throughput {:.0f} kbps, buffer {:.0f} ms, "
+                  "switching variant {} -> {}",
+                  abr_controller_->throughput_kbps(), buffer_ms,
+                  demuxer_->current_variant(), target);
+      // 编码参数一致，旧档位的包继续解码，无需 flush 解码器
+      demuxer_->RequestVariantSwitch(target);
+    }
+  }
+
+  STATS_UPDATE_NETWORK(abr_controller_->throughput_kbps(),
+                       abr_controller_->total_bytes(), buffer_health);
+}
+
+void PlaybackController::InitAbLoop() {
+  // 缓存帧在回放时推给播放器，对应的播放器和解码器都在才需要等这一路
+  bool has_video = video_player_ && video_decoder_ && video_decoder_->opened();
+  bool has_audio = audio_player_ && audio_resampler_ && audio_decoder_ &&
+                   audio_decoder_->opened();
+
+  AbLoopController::Callbacks callbacks;
+  callbacks.push_video = [this](AVFramePtr frame,
+                                const MediaTimestamp& timestamp,
+                                int timeout_ms) {
+    return video_player_->PushFrameBlocking(std::move(frame), timestamp,
+                                            timeout_ms);
+  };
+  callbacks.push_audio = [this](ResampledAudioFrame frame, int timeout_ms) {
+    return audio_player_->PushFrameTimeout(std::move(frame), timeout_ms);
+  };
+  callbacks.current_time_ms = [this]() { return GetCurrentTime(); };
+  callbacks.seek_to_start = [this](int64_t start_ms) {
+    QueueSeekRequest(start_ms, true, true);
+  };
+  callbacks.replay_changed = [this]() { NotifyDemuxParkChanged(); };
+
+  // 开启循环前不占内存
+  int64_t max_cache_mb =
+      GlobalConfig::Instance()->GetInt("player.ab_loop.max_cache_mb", 512);
+  ab_loop_ = std::make_unique<AbLoopController>(
+      state_manager_.get(),
+      static_cast<size_t>(std::max<int64_t>(max_cache_mb, 0)) * 1024 * 1024,
+      has_video, has_audio, std::move(callbacks));
+}
+
+void PlaybackController::InitReverse() {
+  ReversePlayback::Callbacks callbacks;
+  callbacks.push_video = [this](AVFramePtr frame,
+                                const MediaTimestamp& timestamp,
+                                int timeout_ms) {
+    return video_player_->PushFrameBlocking(std::move(frame), timestamp,
+                                            timeout_ms);
+  };
+  callbacks.active_changed = [this]() { NotifyDemuxParkChanged(); };
+  callbacks.create_source = [this](int64_t origin_ms)
+      -> Result<std::unique_ptr<ReverseFrameSource>> {
+    using SourceResult = Result<std::unique_ptr<ReverseFrameSource>>;
+    if (!video_player_ || !video_decoder_ || !video_decoder_->opened()) {
+      return SourceResult::Err(ErrorCode::kNotSupported,
+                               "Reverse playback requires a video stream");
+    }
+
+    auto* config = GlobalConfig::Instance();
+    ReverseDecoder::Options options;
+    int64_t max_cache_mb = config->GetInt("player.reverse.max_cache_mb", 256);
+    options.max_bytes =
+        static_cast<size_t>(std::max<int64_t>(max_cache_mb, 16)) * 1024 * 1024;
+    // 硬件帧占用解码器固定大小的表面池，每块只能持有少量帧
+    if (video_decoder_->IsHardwareDecoding()) {
+      options.max_frames_per_chunk = static_cast<size_t>(std::max<int64_t>(
+          config->GetInt("player.reverse.max_hw_frames_per_chunk", 4), 1));
+    }
+
+    auto decoder = std::make_unique<ReverseDecoder>(
+        demuxer_, &demux_mutex_, video_decoder_, &video_decode_mutex_);
+    auto result = decoder->Start(origin_ms, options);
+    if (!result.IsOk()) {
+      return SourceResult::Err(result.Code(), result.Message());
+    }
+    return SourceResult::Ok(std::move(decoder));
+  };
+
+  reverse_ = std::make_unique<ReversePlayback>(
+      state_manager_.get(), av_sync_controller_.get(), std::move(callbacks));
+}
+
+void PlaybackController::InitScrub() {
+  ScrubController::Callbacks callbacks;
+  callbacks.pause_if_playing = [this]() {
+    if (!state_manager_->IsPlaying()) {
+      return false;
+    }
+    Pause();
+    state_manager_->TransitionToPaused();
+    return true;
+  };
+  // 与 ZenPlayer::Play 从暂停恢复的步骤相同
+  callbacks.resume_playback = [this]() {
+    if (state_manager_->IsPaused()) {
+      Resume();
+      state_manager_->TransitionToPlaying();
+    }
+  };
+  callbacks.queue_preview = [this](int64_t timestamp_ms) {
+    SeekRequest request = MakeSeekRequest(timestamp_ms, true);
+    request.scrub_preview = true;
+    return seek_request_queue_.TryPush(request);
+  };
+  callbacks.queue_release = [this](int64_t timestamp_ms) {
+    SeekRequest request = MakeSeekRequest(timestamp_ms, true);
+    request.accurate = true;
+    if (!seek_request_queue_.Push(request)) {
+      MODULE_ERROR(LOG_MODULE_PLAYER,
+                   "Failed to queue seek request (queue stopped)");
+    }
+  };
+  callbacks.seek = [this](int64_t timestamp_ms) { SeekAsync(timestamp_ms); };
+  callbacks.decode_keyframe = [this](int64_t timestamp_ms) {
+    return DecodeScrubKeyframe(timestamp_ms);
+  };
+  callbacks.show_frame = [this](AVFrame* frame) {
+    video_player_->RenderStill(frame);
+  };
+
+  scrub_ = std::make_unique<ScrubController>(std::move(callbacks));
+}
+
+void PlaybackController::InitWatchdog() {
+  auto* config = GlobalConfig::Instance();
+  if (!config->GetBool("player.watchdog.enabled", true)) {
+    return;
+  }
+
+  PipelineWatchdog::Options options;
+  options.stall_threshold_ms =
+      config->GetInt("player.watchdog.stall_threshold_ms", 3000);
+  options.check_interval_ms =
+      config->GetInt("player.watchdog.check_interval_ms", 500);
+  watchdog_ = std::make_unique<PipelineWatchdog>(options);
+
+  using Stage = PipelineWatchdog::Stage;
+  if (demuxer_) {
+    watchdog_->EnableStage(Stage::kDemux);
+  }
+  if (video_decoder_ && video_decoder_->opened()) {
+    watchdog_->EnableStage(Stage::kVideoDecode);
+  }
+  if (audio_decoder_ && audio_decoder_->opened()) {
+    watchdog_->EnableStage(Stage::kAudioDecode);
+  }
+  if (video_player_) {
+    watchdog_->EnableStage(Stage::kVideoRender);
+    video_player_->SetWatchdog(watchdog_.get());
+  }
+  if (audio_player_) {
+    watchdog_->EnableStage(Stage::kAudioOutput);
+    audio_player_->SetWatchdog(watchdog_.get());
+  }
+}
+
+PipelineWatchdog::PipelineContext PlaybackController::CaptureWatchdogContext()
+    const {
+  using Stage = PipelineWatchdog::Stage;
+  PipelineWatchdog::PipelineContext context;
+  auto state = state_manager_->GetState();
+  context.playing = state == PlayerStateManager::PlayerState::kPlaying;
+  context.state = PlayerStateManager::GetStateName(state);
+  context.clock_ms = GetCurrentTime();
+
+  context.input_depths[static_cast<size_t>(Stage::kVideoDecode)] =
+      static_cast<int64_t>(video_packet_queue_.Size());
+  context.input_depths[static_cast<size_t>(Stage::kAudioDecode)] =
+      static_cast<int64_t>(audio_packet_queue_.Size());
+  if (video_player_) {
+    context.input_depths[static_cast<size_t>(Stage::kVideoRender)] =
+        static_cast<int64_t>(video_player_->GetQueueSize());
+  }
+  if (audio_player_) {
+    context.input_depths[static_cast<size_t>(Stage::kAudioOutput)] =
+        static_cast<int64_t>(audio_player_->GetQueueSize());
+  }
+  return context;
+}
+
+void PlaybackController::StartPacketCapture() {
+  auto* config = GlobalConfig::Instance();
+  if (!demuxer_ || demuxer_->IsReplay() || raw_video_source_ ||
+      !config->GetBool("debug.packet_capture.enabled", false)) {
+    return;
+  }
+
+  std::filesystem::path directory =
+      config->GetString("debug.packet_capture.directory", "captures");
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+
+  std::time_t now = std::time(nullptr);
+  char name[64];
+  std::strftime(name, sizeof(name), "capture_%Y%m%d_%H%M%S.zpcap",
+                std::localtime(&now));
+
+  std::vector<const AVStream*> streams;
+  for (int i = 0; AVStream* stream = demuxer_->findStreamByIndex(i); ++i) {
+    streams.push_back(stream);
+  }
+
+  auto writer = std::make_unique<PacketCaptureWriter>();
+  auto result = writer->Open(
+      (directory / name).string(), streams,
+      demuxer_->GetDuration() > 0 ? demuxer_->GetDuration() * 1000
+                                  : AV_NOPTS_VALUE,
+      demuxer_->active_video_stream_index(),
+      demuxer_->active_audio_stream_index());
+  if (!result.IsOk()) {
+    MODULE_WARN(LOG_MODULE_PLAYER, "Packet capture disabled: {}",
+                result.FullMessage());
+    return;
+  }
+  packet_capture_ = std::move(writer);
+}
+
+void PlaybackController::StartFrameExport() {
+  auto* config = GlobalConfig::Instance();
+  if (!video_decoder_ || !video_decoder_->opened() ||
+      !config->GetBool("export.frame_export.enabled", false)) {
+    return;
+  }
+
+  std::string socket_path = config->GetString(
+      "export.frame_export.socket_path", kDefaultFrameExportSocket);
+  int64_t slot_count = config->GetInt("export.frame_export.slot_count", 8);
+
+  auto sink = std::make_unique<FrameExportSink>();
+  auto result = sink->Open(
+      socket_path, static_cast<uint32_t>(std::clamp<int64_t>(slot_count, 2,
+                                                             256)));
+  if (!result.IsOk()) {
+    MODULE_WARN(LOG_MODULE_PLAYER, "Frame export disabled: {}",
+                result.FullMessage());
+    return;
+  }
+  frame_export_ = std::move(sink);
+}
+
+void PlaybackController::CapturePacketResult(
+    const Result<AVPacket*>& result) {
+  Result<void> write_result = Result<void>::Ok();
+  if (!result.IsOk()) {
+    write_result = packet_capture_->WriteError(result.Code());
+  } else if (!result.Value()) {
+    write_result = packet_capture_->WriteEndOfStream();
+  } else {
+    write_result = packet_capture_->WritePacket(result.Value());
+  }
+  CheckCaptureWrite(write_result);
+}
+
+void PlaybackController::CaptureSeek(int64_t timestamp_us, bool backward) {
+  if (packet_capture_) {
+    CheckCaptureWrite(packet_capture_->WriteSeek(timestamp_us, backward));
+  }
+}
+
+void PlaybackController::CheckCaptureWrite(const Result<void>& write_result) {
+  // 写入器在写入失败时关闭文件（Pause / Seek 可能在其他线程写入，
+  // 不能在这里释放写入器），之后的写入返回 kNotInitialized
+  if (!write_result.IsOk() &&
+      write_result.Code() != ErrorCode::kNotInitialized) {
+    MODULE_WARN(LOG_MODULE_PLAYER, "Packet capture stopped: {}",
+                write_result.FullMessage());
+  }
+}
+
+bool PlaybackController::ShouldParkDemux() const {
+  return ab_loop_->IsReplaying() || reverse_->IsActive();
+}
+
+void PlaybackController::NotifyDemuxParkChanged() {
+  // 加锁后通知：等待方检查条件与进入等待之间不会漏掉唤醒
+  std::lock_guard<std::mutex> lock(demux_park_mutex_);
+  demux_park_cv_.notify_all();
 }
 
 void PlaybackController::StopAllThreads() {
+  // 停止过程中各阶段不再有进度，先停掉卡死检测
+  if (watchdog_) {
+    watchdog_->Stop();
+  }
+
   // ✅ 第一步：停止所有队列（唤醒阻塞的线程）
   // 注意：必须在 join 之前停止，否则会死锁
   video_packet_queue_.Stop();
   audio_packet_queue_.Stop();
   seek_request_queue_.Stop();
+  if (demuxer_) {
+    demuxer_->Interrupt();  // 回放源可能正在等待数据包的到达时刻
+  }
+  // DemuxTask 可能停在 A-B 缓存回放 / 倒放中
+  NotifyDemuxParkChanged();
 
   // ✅ 第二步：停止播放器的队列（解码线程可能在 PushFrame 时阻塞）
   // 这一步非常关键！否则解码线程会在 Push 时永久阻塞
@@ -670,6 +1630,9 @@ void PlaybackController::StopAllThreads() {
   }
 
   // ✅ 第三步：等待所有线程退出
+  ab_loop_->StopTask();
+  reverse_->Stop();
+
   if (seek_thread_ && seek_thread_->joinable()) {
     seek_thread_->join();
     seek_thread_.reset();
@@ -709,14 +1672,75 @@ int64_t PlaybackController::GetCurrentTime() const {
 
   auto current_time = std::chrono::steady_clock::now();
   double master_clock_ms = av_sync_controller_->GetMasterClock(current_time);
+  int64_t time_ms = static_cast<int64_t>(master_clock_ms);
 
-  // 直接返回毫秒
-  return static_cast<int64_t>(master_clock_ms);
+  // ✅ 倒放时时钟照常前进，映射回倒退的媒体位置
+  if (reverse_->IsActive()) {
+    return reverse_->MapClock(time_ms);
+  }
+
+  // ✅ 缓存回放时时间戳逐轮递增，映射回 A-B 区间
+  return ab_loop_->MapReplayClock(time_ms);
+}
+
+void PlaybackController::SetMasterClock(const AVSyncController* master) {
+  if (av_sync_controller_) {
+    av_sync_controller_->SetMasterSource(master);
+  }
+}
+
+void PlaybackController::SetStatsOverlayEnabled(bool enabled) {
+  if (video_player_) {
+    video_player_->SetStatsOverlayEnabled(enabled);
+  }
+}
+
+void PlaybackController::EnableSeekPrefetch(const std::string& url) {
+  auto* config = GlobalConfig::Instance();
+  if (!config->GetBool("player.hover_prefetch.enabled", true)) {
+    return;
+  }
+  // 预取只对可随机访问、流布局固定的视频有意义
+  if (!demuxer_ || !video_player_ || !video_decoder_ ||
+      !video_decoder_->opened() || raw_video_source_ ||
+      demuxer_->IsReplay() || demuxer_->GetDuration() <= 0 ||
+      abr_controller_) {
+    return;
+  }
+
+  SeekPrefetcher::Options options;
+  options.max_frames = static_cast<size_t>(std::clamp<int64_t>(
+      config->GetInt("player.hover_prefetch.max_frames", 8), 1,
+      std::max(profile_.video_frame_queue, 1)));
+  options.debounce_ms = std::max<int64_t>(
+      config->GetInt("player.hover_prefetch.debounce_ms", 150), 0);
+  // 点击时预取的包一次推入包队列，不能超过队列容量
+  options.max_video_packets = profile_.video_packet_queue;
+  options.max_audio_packets = profile_.audio_packet_queue;
+  options.open_timeout_ms = config->GetInt64("network.open_timeout_ms", 15000);
+  options.io_timeout_ms = config->GetInt64("network.timeout_ms", 5000);
+
+  hover_prefetch_.Enable(std::make_unique<SeekPrefetcher>(url, options));
+  MODULE_INFO(LOG_MODULE_PLAYER,
+              "Hover seek prefetch enabled ({} frames, debounce {}ms)",
+              options.max_frames, options.debounce_ms);
+}
+
+void PlaybackController::PrefetchSeek(int64_t timestamp_ms) {
+  if (!reverse_->IsActive()) {
+    hover_prefetch_.Request(timestamp_ms);
+  }
+}
+
+void PlaybackController::CancelSeekPrefetch() {
+  hover_prefetch_.Cancel();
 }
 
 void PlaybackController::SeekTask() {
+  STATS_ALLOC_THREAD(kSeek);
   MODULE_INFO(LOG_MODULE_PLAYER, "SeekTask started");
 
+  std::vector<SeekRequest> pending_seeks;
   while (!state_manager_->ShouldStop()) {
     SeekRequest request(0, false, PlayerStateManager::PlayerState::kStopped);
 
@@ -724,13 +1748,27 @@ void PlaybackController::SeekTask() {
     if (!seek_request_queue_.Pop(request)) {
       break;  // 队列已停止，退出循环
     }
+    STATS_COUNT_WAKEUP(kSeek);
 
     // 清空队列中的旧请求，只执行最新的
+    // 被替代的请求中的目标位置和速率切换不能丢：只切速率的请求沿用之前的
+    // 目标位置，只跳转的请求沿用之前的速率切换
+    // 拖动进度条时请求成串到达，一次加锁取走全部积压
+    pending_seeks.clear();
+    seek_request_queue_.DrainAll(pending_seeks);
     SeekRequest latest_request = request;
-    while (seek_request_queue_.TryPop(request)) {
-      MODULE_DEBUG(LOG_MODULE_PLAYER, "Discarding old seek request: {}ms",
-                   request.timestamp_ms);
-      latest_request = request;
+    for (SeekRequest& pending : pending_seeks) {
+      SupersedeSeekRequest(&latest_request, std::move(pending));
+    }
+
+    // 拖动预览限制频率，等待期间到达的位置只预览最新的一个
+    if (latest_request.scrub_preview &&
+        !ThrottleScrubPreview(&latest_request)) {
+      break;  // 队列已停止
+    }
+    if (latest_request.scrub_preview) {
+      scrub_->ShowPreview(latest_request.timestamp_ms);
+      continue;
     }
 
     // 执行 Seek
@@ -744,11 +1782,135 @@ void PlaybackController::SeekTask() {
     } else {
       MODULE_ERROR(LOG_MODULE_PLAYER, "Seek failed");
     }
+
+    // 拖动前在播放：松开时的 Seek 完成后恢复
+    scrub_->OnSeekCompleted(success);
   }
 
   MODULE_INFO(LOG_MODULE_PLAYER, "SeekTask stopped");
 }
 
+bool PlaybackController::ThrottleScrubPreview(SeekRequest* request) {
+  while (request->scrub_preview) {
+    int64_t wait_ms = scrub_->PreviewWaitMs();
+    if (wait_ms <= 0) {
+      return true;
+    }
+
+    // 等待期间松开进度条：精确 Seek 替代预览，立即执行
+    SeekRequest next(0, false, PlayerStateManager::PlayerState::kStopped);
+    if (seek_request_queue_.PopTimeout(next, wait_ms)) {
+      SupersedeSeekRequest(request, std::move(next));
+    } else if (seek_request_queue_.Stopped()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+AVFramePtr PlaybackController::DecodeScrubKeyframe(int64_t target_ms) {
+  // 丢弃旧位置的帧和包（同时归还帧占用的硬件解码表面）；解封装线程
+  // 可能阻塞在网络读取中，打断它以便取得 demux 锁
+  video_player_->ClearFrames();
+  demux_seek_serial_.fetch_add(1);
+  ClearAllQueues();
+  demuxer_->CancelPendingIo();
+
+  std::scoped_lock lock(demux_mutex_, video_decode_mutex_);
+  demux_refill_.store(true);
+  hover_prefetch_.DropDeferredSeek();
+  // 只跳到关键帧，不向前解码到目标位置
+  if (!demuxer_->Seek(target_ms * 1000, true)) {
+    MODULE_WARN(LOG_MODULE_PLAYER, "Scrub preview seek failed: {}ms",
+                target_ms);
+    return nullptr;
+  }
+  video_decoder_->FlushBuffers();
+
+  AVFramePtr frame = ScrubController::DecodeFirstVideoFrame(
+      demuxer_->active_video_stream_index(),
+      [this]() -> AVPacket* {
+        auto packet_result = demuxer_->ReadPacket();
+        return packet_result.IsOk() ? packet_result.Value() : nullptr;
+      },
+      [this](AVPacket* packet, std::vector<AVFramePtr>* frames) {
+        if (packet) {
+          video_decoder_->Decode(packet, frames);
+        } else {
+          video_decoder_->Flush(frames);
+          video_decoder_->FlushBuffers();
+        }
+      },
+      kScrubMaxPackets);
+  video_decoder_->FlushBuffers();
+  return frame;
+}
+
+std::unique_ptr<HoverSeekPrefetch::Prefetch>
+PlaybackController::TakeSeekPrefetch(int64_t target_ms) {
+  if (!hover_prefetch_.enabled()) {
+    return nullptr;
+  }
+  HoverSeekPrefetch::StreamLayout layout;
+  layout.video_stream_index = demuxer_->active_video_stream_index();
+  layout.audio_stream_index = demuxer_->active_audio_stream_index();
+  AVStream* stream = demuxer_->findStreamByIndex(layout.video_stream_index);
+  if (stream) {
+    layout.video_time_base = stream->time_base;
+  }
+  layout.decode_audio = audio_decoder_ && audio_decoder_->opened();
+  return hover_prefetch_.TakeForSeek(target_ms, layout);
+}
+
+void PlaybackController::SwapInPrefetch(HoverSeekPrefetch::Prefetch* prefetch,
+                                        int64_t target_ms) {
+  size_t video_packets = prefetch->video_packets.size();
+  size_t audio_packets = prefetch->audio_packets.size();
+  PushPacketBatch(&video_packet_queue_, &prefetch->video_packets);
+  PushPacketBatch(&audio_packet_queue_, &prefetch->audio_packets);
+
+  // 预解码的是软件帧：硬件解码时渲染器可能只接受硬件帧，只复用包
+  size_t pushed_frames = 0;
+  int64_t last_pts_us = kNoSeekTarget;
+  if (video_player_ && !video_decoder_->IsHardwareDecoding()) {
+    for (auto& frame : prefetch->frames) {
+      if (pushed_frames >= static_cast<size_t>(profile_.video_frame_queue)) {
+        break;
+      }
+      if (frame->pts == AV_NOPTS_VALUE) {
+        continue;
+      }
+      VideoPlayer::FrameTimestamp timestamp;
+      timestamp.pts = frame->pts;
+      timestamp.dts = frame->pkt_dts;
+      timestamp.time_base = prefetch->video_time_base;
+      int64_t pts_us = av_rescale_q(frame->pts, timestamp.time_base,
+                                    AVRational{1, 1000000});
+      if (pts_us < target_ms * 1000) {
+        continue;
+      }
+      if (frame_export_) {
+        frame_export_->Publish(frame.get(), pts_us);
+      }
+      if (!video_player_->PushFrame(std::move(frame), timestamp)) {
+        break;
+      }
+      last_pts_us = pts_us;
+      ++pushed_frames;
+    }
+  }
+
+  // 主解码器仍从关键帧解码这些包（建立参考帧），已推入的帧丢弃
+  video_seek_target_us_.store(
+      last_pts_us != kNoSeekTarget ? last_pts_us + 1 : target_ms * 1000);
+  audio_seek_target_ms_.store(target_ms);
+
+  MODULE_INFO(LOG_MODULE_PLAYER,
+              "Seek to {}ms served from hover prefetch: {} video / {} audio "
+              "packets, {} frames",
+              target_ms, video_packets, audio_packets, pushed_frames);
+}
+
 bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
   // 防止并发
   if (seeking_.exchange(true)) {
@@ -757,13 +1919,28 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
   }
 
   try {
+    // 外部跳转退出 A-B 循环（必须在清空队列之前停止缓存回放）
+    if (!request.from_loop && ab_loop_->IsActive()) {
+      MODULE_INFO(LOG_MODULE_PLAYER, "Seek requested, leaving A-B loop");
+      ab_loop_->Disable();
+    }
+
+    // 速率切换请求在执行时才确定位置（倒放时按倒放时钟换算）
+    int64_t target_ms = request.timestamp_ms >= 0 ? request.timestamp_ms
+                                                  : GetCurrentTime();
+
     // === 步骤1: 转换到 Seeking 状态 ===
     if (!state_manager_->TransitionToSeeking()) {
       MODULE_ERROR(LOG_MODULE_PLAYER, "Failed to transition to Seeking state");
+      completed_seek_serial_.store(request.serial);
       seeking_.store(false);
       return false;
     }
 
+    // 切换播放方向：倒放期间 DemuxTask 停下，Demuxer 和视频解码器交给
+    // 倒放解码器；倒放中的普通 Seek 从新位置继续倒放
+    bool reverse = reverse_->BeginSeek(request.playback_rate, target_ms);
+
     // === 步骤2-7: PreSeek ===
     // 职责说明：只调用 PreSeek，不直接操作 renderer
     // VideoPlayer 自己负责通知 renderer 清理缓存
@@ -776,17 +1953,38 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
       audio_player_->PreSeek();
     }
 
+    demux_seek_serial_.fetch_add(1);
     ClearAllQueues();
+    // DemuxTask 可能持有 demux 锁阻塞在网络读取中，打断它以便立即 Seek
+    demuxer_->CancelPendingIo();
 
     // === 步骤8: Demuxer Seek ===
-    MODULE_DEBUG(LOG_MODULE_PLAYER, "Demuxer seeking to {}ms",
-                 request.timestamp_ms);
+    MODULE_DEBUG(LOG_MODULE_PLAYER, "Demuxer seeking to {}ms", target_ms);
 
     // FFmpeg 使用微秒为单位
-    int64_t timestamp_us = request.timestamp_ms * 1000;
+    int64_t timestamp_us = target_ms * 1000;
+
+    // 悬停预取命中：包和帧已经就绪，Demuxer Seek 推迟到 DemuxTask，
+    // 由它跳过已预取的包
+    std::unique_ptr<HoverSeekPrefetch::Prefetch> prefetch =
+        reverse || request.from_loop ? nullptr : TakeSeekPrefetch(target_ms);
 
-    if (!demuxer_->Seek(timestamp_us, request.backward)) {
+    std::unique_lock<std::mutex> demux_lock(demux_mutex_);
+    bool seek_ok = true;
+    if (prefetch) {
+      hover_prefetch_.DeferSeek(*prefetch, demux_seek_serial_.load());
+    } else {
+      hover_prefetch_.DropDeferredSeek();
+      seek_ok = demuxer_->Seek(timestamp_us, request.backward);
+      if (seek_ok) {
+        CaptureSeek(timestamp_us, request.backward);
+      }
+    }
+    demux_lock.unlock();
+    demux_refill_.store(true);
+    if (!seek_ok) {
       MODULE_ERROR(LOG_MODULE_PLAYER, "Demuxer seek failed");
+      completed_seek_serial_.store(request.serial);
       state_manager_->TransitionToError();
       seeking_.store(false);
       return false;
@@ -796,6 +1994,7 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
     MODULE_DEBUG(LOG_MODULE_PLAYER, "Flushing decoders");
 
     if (video_decoder_ && video_decoder_->opened()) {
+      std::lock_guard<std::mutex> decode_lock(video_decode_mutex_);
       video_decoder_->FlushBuffers();
     }
     if (audio_decoder_ && audio_decoder_->opened()) {
@@ -808,13 +2007,37 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
 
     if (av_sync_controller_) {
       // ✅ 使用新的 ResetForSeek，传入目标位置
-      av_sync_controller_->ResetForSeek(request.timestamp_ms);
+      av_sync_controller_->ResetForSeek(target_ms);
+    }
+
+    if (reverse) {
+      auto reverse_result = reverse_->Start();
+      if (!reverse_result.IsOk()) {
+        MODULE_ERROR(LOG_MODULE_PLAYER,
+                     "Reverse playback failed, continuing forward: {}",
+                     reverse_result.FullMessage());
+      }
+    }
+
+    // 精确 Seek：从关键帧解码到目标位置，之前的帧由解码线程丢弃
+    bool accurate = request.accurate && !reverse_->IsActive();
+    video_seek_target_us_.store(accurate ? target_ms * 1000 : kNoSeekTarget);
+    audio_seek_target_ms_.store(accurate ? target_ms : kNoSeekTarget);
+    if (prefetch) {
+      SwapInPrefetch(prefetch.get(), target_ms);
+    }
+
+    // A-B 循环：在恢复播放、解码线程产出新帧之前进入新一遍
+    if (request.from_loop) {
+      ab_loop_->BeginPass();
     }
 
     // === 步骤11: 恢复状态 ===
     MODULE_DEBUG(LOG_MODULE_PLAYER, "Restoring state: {}",
                  PlayerStateManager::GetStateName(request.restore_state));
 
+    // 先记录序号：状态回调据此判断结束的是哪一次 Seek
+    completed_seek_serial_.store(request.serial);
     if (request.restore_state == PlayerStateManager::PlayerState::kPlaying) {
       // 1. 先转换状态，唤醒 DemuxTask 和 AudioDecodeTask
       state_manager_->TransitionToPlaying();
@@ -828,7 +2051,8 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
     // === 步骤12: PostSeek ===
     MODULE_DEBUG(LOG_MODULE_PLAYER, "Executing PostSeek");
 
-    if (audio_player_) {
+    // 倒放时音频保持静音
+    if (audio_player_ && !reverse_->IsActive()) {
       audio_player_->PostSeek(request.restore_state);
     }
 
@@ -836,13 +2060,19 @@ bool PlaybackController::ExecuteSeek(const SeekRequest& request) {
       video_player_->PostSeek(request.restore_state);
     }
 
+    // 解封装和解码从新位置重新开始
+    if (watchdog_) {
+      watchdog_->Rearm();
+    }
+
     MODULE_INFO(LOG_MODULE_PLAYER, "✅ Seek completed successfully to {}ms",
-                request.timestamp_ms);
+                target_ms);
     seeking_.store(false);
     return true;
 
   } catch (const std::exception& e) {
     MODULE_ERROR(LOG_MODULE_PLAYER, "Seek exception: {}", e.what());
+    completed_seek_serial_.store(request.serial);
     state_manager_->TransitionToError();
     seeking_.store(false);
     return false;
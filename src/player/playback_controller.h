@@ -3,9 +3,11 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 
 #include "loki/src/callback.h"
@@ -13,8 +15,17 @@
 #include "player/codec/decode.h"
 #include "player/common/blocking_queue.h"
 #include "player/common/error.h"
+#include "player/common/pipeline_watchdog.h"
 #include "player/common/player_state_manager.h"
+#include "player/config/pipeline_profile.h"
+#include "player/demuxer/abr_controller.h"
+#include "player/demuxer/packet_capture.h"
+#include "player/playback/ab_loop_controller.h"
+#include "player/playback/hover_seek_prefetch.h"
+#include "player/playback/reverse_playback.h"
+#include "player/playback/scrub_controller.h"
 #include "player/sync/av_sync_controller.h"
+#include "player/video/export/frame_export_sink.h"
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -23,6 +34,7 @@ extern "C" {
 namespace zenplay {
 
 class Demuxer;
+class RawVideoSource;
 class VideoDecoder;
 class AudioDecoder;
 class Renderer;
@@ -43,13 +55,28 @@ class PlayerStateManager;
 // 播放控制器，管理所有播放线程
 class PlaybackController {
  public:
+  /**
+   * @param audio_player 已由 OpenAudioPlayer 打开设备的音频播放器；
+   *        nullptr 时在构造函数中打开
+   */
   PlaybackController(std::shared_ptr<PlayerStateManager> state_manager,
                      Demuxer* demuxer,
                      VideoDecoder* video_decoder,
                      AudioDecoder* audio_decoder,
-                     Renderer* renderer);
+                     Renderer* renderer,
+                     const PipelineProfile& profile = PipelineProfile(),
+                     std::unique_ptr<AudioPlayer> audio_player = nullptr);
   ~PlaybackController();
 
+  /**
+   * @brief 按配置档打开音频输出设备
+   * @return 打开失败返回 nullptr
+   * @note 输出格式固定，与文件无关，可以在解封装器探测的同时调用
+   */
+  static std::unique_ptr<AudioPlayer> OpenAudioPlayer(
+      PlayerStateManager* state_manager,
+      const PipelineProfile& profile);
+
   /**
    * @brief 启动播放
    * @return Result<void> 成功返回Ok，失败返回错误码
@@ -88,8 +115,76 @@ class PlaybackController {
    *       - kSeeking: 开始跳转
    *       - kPlaying/kPaused: 跳转成功
    *       - kError: 跳转失败
+   * @return 请求序号（递增），队列已停止时返回 0
+   */
+  uint64_t SeekAsync(int64_t timestamp_ms, bool backward = true);
+
+  /**
+   * @brief 最近一次执行完（成功或失败）的 Seek 请求序号
+   * @note 在切换到结束状态之前更新，状态回调中读取到的就是刚结束的请求；
+   *       被后到请求替代的请求不单独执行，以替代它的请求序号为准
+   */
+  uint64_t completed_seek_serial() const {
+    return completed_seek_serial_.load();
+  }
+
+  /**
+   * @brief 开始拖动进度条：播放中则先暂停，松开后恢复
+   * @note 拖动期间 ScrubTo 只跳到关键帧并解码这一帧显示，不切换播放状态；
+   *       预览频率受 player.scrub.preview_interval_ms 限制，积压的位置
+   *       只预览最新的一个。倒放和 A-B 循环中不预览，松开后再跳转。
+   */
+  void BeginScrub();
+
+  /**
+   * @brief 拖动到指定位置，显示其之前最近的关键帧
+   */
+  void ScrubTo(int64_t timestamp_ms);
+
+  /**
+   * @brief 结束拖动：精确跳转到松开的位置，再按 BeginScrub 恢复播放
+   */
+  void EndScrub(int64_t timestamp_ms);
+
+  /**
+   * @brief 是否正在拖动进度条
+   */
+  bool IsScrubbing() const { return scrub_->IsScrubbing(); }
+
+  /**
+   * @brief 开启 A-B 循环
+   * @param start_ms A 点（毫秒）
+   * @param end_ms B 点（毫秒）
+   * @note 立即跳转到 A 点。第一遍播放时缓存区间内的解码帧，之后每一轮
+   *       直接从内存回放，循环衔接没有 Seek 和解码开销；缓存超出上限
+   *       （player.ab_loop.max_cache_mb）时退回到每轮 Seek。
+   *       任何外部 Seek 都会退出循环。
+   */
+  void SetLoopRange(int64_t start_ms, int64_t end_ms);
+
+  /**
+   * @brief 退出 A-B 循环，从当前位置继续正常播放
+   */
+  void ClearLoopRange();
+
+  /**
+   * @brief 是否处于 A-B 循环中
+   */
+  bool IsLooping() const;
+
+  /**
+   * @brief 设置播放速率
+   * @param rate 1.0 为正常正放；负数为倒放，绝对值为倒放速度
+   * @note 异步执行（与 Seek 共用 SeekTask 线程）。倒放时按 GOP 向前跳转、
+   *       解码整组帧后倒序呈现，同时在后台解码更早的一组；音频静音，
+   *       同步切换到外部时钟。倒放中的 Seek 从新位置继续倒放。
    */
-  void SeekAsync(int64_t timestamp_ms, bool backward = true);
+  Result<void> SetPlaybackRate(double rate);
+
+  /**
+   * @brief 当前播放速率（倒放时为负数）
+   */
+  double GetPlaybackRate() const;
 
   /**
    * @brief 设置音量
@@ -108,6 +203,36 @@ class PlaybackController {
    */
   int64_t GetCurrentTime() const;
 
+  /**
+   * @brief 视频跟随共享主时钟（多文件对比播放）
+   * @param master CompareSession 持有的外部时钟，nullptr 恢复本管线时钟
+   * @note 音频（如有）仍按硬件节奏播放，只更新本管线的音频时钟
+   */
+  void SetMasterClock(const AVSyncController* master);
+
+  /**
+   * @brief 显示 / 隐藏屏幕统计浮层（下一帧生效）
+   */
+  void SetStatsOverlayEnabled(bool enabled);
+
+  /**
+   * @brief 按 player.hover_prefetch 配置启用悬停预取
+   * @param url 当前文件，预取使用独立打开的 Demuxer
+   * @note 未压缩视频源、数据包回放、直播和 HLS 多码率流不启用
+   */
+  void EnableSeekPrefetch(const std::string& url);
+
+  /**
+   * @brief 鼠标悬停在进度条 timestamp_ms 处：在后台预取这个位置
+   * @note 随后在这个位置的 Seek 直接使用预取的包和帧
+   */
+  void PrefetchSeek(int64_t timestamp_ms);
+
+  /**
+   * @brief 鼠标离开进度条：放弃尚未开始的预取
+   */
+  void CancelSeekPrefetch();
+
  private:
   /**
    * @brief Seek 请求结构
@@ -116,11 +241,37 @@ class PlaybackController {
     int64_t timestamp_ms;
     bool backward;
     PlayerStateManager::PlayerState restore_state;
+    bool from_loop = false;  // A-B 循环内部发起的跳转，不退出循环
+    double playback_rate = 0.0;  // 非 0 时同时切换播放速率
+    bool scrub_preview = false;  // 拖动中的关键帧预览，不切换播放状态
+    bool accurate = false;       // 丢弃目标位置之前解码出的帧
+    uint64_t serial = 0;         // 请求序号，替代时取后到请求的序号
 
     SeekRequest(int64_t ts, bool bw, PlayerStateManager::PlayerState state)
         : timestamp_ms(ts), backward(bw), restore_state(state) {}
   };
 
+  /**
+   * @brief 创建 Seek 请求，记录当前状态用于 Seek 完成后恢复，分配请求序号
+   */
+  SeekRequest MakeSeekRequest(int64_t timestamp_ms, bool backward);
+
+  /**
+   * @brief 用后到的请求替代积压的请求，保留被替代请求中不能丢的部分
+   */
+  static void SupersedeSeekRequest(SeekRequest* latest, SeekRequest pending);
+
+  /**
+   * @brief 把 Seek 请求放入队列（保存当前状态用于恢复）
+   * @param timestamp_ms 目标位置，负数表示执行时的当前位置
+   * @param playback_rate 非 0 时同时切换播放速率
+   * @return 请求序号，队列已停止时返回 0
+   */
+  uint64_t QueueSeekRequest(int64_t timestamp_ms,
+                            bool backward,
+                            bool from_loop,
+                            double playback_rate = 0.0);
+
   /**
    * @brief Seek 执行线程
    */
@@ -131,15 +282,82 @@ class PlaybackController {
    */
   bool ExecuteSeek(const SeekRequest& request);
 
+  /**
+   * @brief 拖动预览：丢弃旧位置的帧和包，跳到目标位置之前的关键帧，
+   *        只解码这一帧
+   * @note 仅在 SeekTask 线程调用，此时处于暂停状态，解封装和解码线程
+   *       停在等待中；松开时的精确 Seek 会重新清空队列和解码器
+   */
+  AVFramePtr DecodeScrubKeyframe(int64_t target_ms);
+
+  /**
+   * @brief 取走覆盖 target_ms 且与当前流布局匹配的悬停预取结果
+   */
+  std::unique_ptr<HoverSeekPrefetch::Prefetch> TakeSeekPrefetch(
+      int64_t target_ms);
+
+  /**
+   * @brief 把预取的包推入包队列、帧推入帧队列，并设置 Seek 目标
+   * @note 仅在 SeekTask 线程调用，此时队列已清空、解码器已刷新
+   */
+  void SwapInPrefetch(HoverSeekPrefetch::Prefetch* prefetch,
+                      int64_t target_ms);
+
+  /**
+   * @brief 把 DemuxTask 读出的一批包推入视频 / 音频包队列
+   *
+   * 两个队列互不等待：一个队列满时另一个照常推入。推入途中发生 Seek
+   * （demux_seek_serial_ 变化）时立即停止，旧位置的包不会进入刚清空的
+   * 队列；批量可以超过队列容量
+   * @param seek_serial 这批包所属的 Seek 序号
+   * @return Seek 序号已变化或队列已停止时返回 false，剩余的包已释放
+   */
+  bool PushDemuxedPackets(std::vector<AVPacket*>* video_batch,
+                          std::vector<AVPacket*>* audio_batch,
+                          uint64_t seek_serial);
+
+  /**
+   * @brief DemuxTask 读包前执行推迟的 Demuxer Seek
+   * @param skip 输出：之后要跳过的已预取包；Seek 序号变化后清空
+   * @param seek_serial 输入输出：执行了推迟的跳转时改为它所属的序号
+   * @return 跳转失败返回 false
+   */
+  bool ApplyDeferredDemuxSeek(HoverSeekPrefetch::DeferredSeek* skip,
+                              uint64_t* seek_serial);
+
+  /**
+   * @brief 等到距上一次预览满 preview_interval_ms，期间到达的请求合并
+   * @param request 输入输出：当前要执行的请求
+   * @return 队列已停止时返回 false
+   */
+  bool ThrottleScrubPreview(SeekRequest* request);
+
   /**
    * @brief 清空所有队列（packet 和 frame）
    * @note 用于 Seek、Stop 等需要清空缓冲的场景
    */
   void ClearAllQueues();
 
+  /**
+   * @brief 向已打开流的解码队列发送 EOF 标记（nullptr）
+   * @return 队列已停止时返回 false
+   */
+  bool PushEndOfStream();
+
   // 解封装任务 - 在专门的工作线程执行
   void DemuxTask();
 
+  /**
+   * @brief 未压缩视频源任务：代替解封装和视频解码线程，直接把映射中的
+   *        帧推送给 VideoPlayer（不经过 Decoder，没有拷贝）
+   */
+  void RawVideoTask();
+
+  /**
+   * @brief A-B 循环从缓存回放、倒放期间停下读取线程，直到恢复或停止
+   */
+  void WaitWhileDemuxParked();
+
   // 视频解码任务 - 在专门的解码线程执行
   void VideoDecodeTask();
 
@@ -149,12 +367,101 @@ class PlaybackController {
   // 同步控制任务 - 定期更新时钟同步
   void SyncControlTask();
 
+  /**
+   * @brief 自适应码率：统计下载吞吐量，在分片边界决定是否切换档位
+   * @param packet 刚读到的数据包
+   * @param read_time_ms 本次 ReadPacket 耗时
+   * @param seek_serial 这个包所属的 demux_seek_serial_，变化时重置缓冲估计
+   * @note 仅在 DemuxTask 线程调用
+   */
+  void UpdateAdaptiveBitrate(const AVPacket* packet,
+                             double read_time_ms,
+                             uint64_t seek_serial);
+
+  /**
+   * @brief 按配置创建 A-B 循环（player.ab_loop）
+   */
+  void InitAbLoop();
+
+  /**
+   * @brief 解封装线程是否应停下（A-B 缓存回放、倒放）
+   */
+  bool ShouldParkDemux() const;
+
+  /**
+   * @brief 停下条件变化后唤醒 WaitWhileDemuxParked
+   */
+  void NotifyDemuxParkChanged();
+
+  /**
+   * @brief 创建倒放：帧来源由倒放解码器按配置（player.reverse）提供
+   */
+  void InitReverse();
+
+  /**
+   * @brief 创建拖动进度条控制：预览和松开时的跳转都经 Seek 请求队列
+   */
+  void InitScrub();
+
+  /**
+   * @brief 按配置创建卡死检测器（player.watchdog）并登记存在的阶段
+   */
+  void InitWatchdog();
+
+  /**
+   * @brief 卡死检测器定时获取的队列深度和播放状态
+   */
+  PipelineWatchdog::PipelineContext CaptureWatchdogContext() const;
+
+  /**
+   * @brief 上报一次进度（未开启检测时为空操作）
+   */
+  void WatchdogHeartbeat(PipelineWatchdog::Stage stage, int64_t pts_ms) {
+    if (watchdog_) {
+      watchdog_->Heartbeat(stage, pts_ms);
+    }
+  }
+
+  /**
+   * @brief 按配置开启数据包抓取（debug.packet_capture）
+   */
+  void StartPacketCapture();
+
+  /**
+   * @brief 记录一次 ReadPacket 的结果到抓取文件
+   * @note 仅在 DemuxTask 线程调用；写入失败时关闭抓取
+   */
+  void CapturePacketResult(const Result<AVPacket*>& result);
+
+  /**
+   * @brief 记录一次成功的 Demuxer Seek 到抓取文件（持有 demux 锁调用）
+   */
+  void CaptureSeek(int64_t timestamp_us, bool backward);
+
+  /**
+   * @brief 检查抓取文件的写入结果
+   * @note 写入失败时写入器已关闭文件，只在第一次失败时记录日志
+   */
+  void CheckCaptureWrite(const Result<void>& write_result);
+
+  /**
+   * @brief 按配置开启解码帧共享内存导出（export.frame_export）
+   */
+  void StartFrameExport();
+
   // 停止所有线程
   void StopAllThreads();
 
+  /**
+   * @brief 向统计模块登记流水线是否活跃（暂停、停止时为空闲）
+   * @note 空闲时统计定时器停止；重复登记同一状态为空操作
+   */
+  void SetStatsPipelineActive(bool active);
+
  private:
   // 组件引用
   Demuxer* demuxer_;
+  RawVideoSource* raw_video_source_ = nullptr;  // 属于 demuxer_，可能为空
   VideoDecoder* video_decoder_;
   AudioDecoder* audio_decoder_;
   Renderer* renderer_;
@@ -167,13 +474,57 @@ class PlaybackController {
   // ✅ 音频重采样器（在解码线程中使用）
   std::unique_ptr<class AudioResampler> audio_resampler_;
 
+  // ✅ 自适应码率控制（仅 HLS 多码率流，DemuxTask 线程独占）
+  std::unique_ptr<AbrController> abr_controller_;
+  int64_t abr_first_video_pts_ms_ = -1;  // 本段第一个视频包 PTS（毫秒）
+  int64_t abr_last_video_pts_ms_ = -1;   // 最近一个视频包 PTS（毫秒）
+  int64_t abr_first_clock_ms_ = 0;       // 本段第一个视频包时的播放位置
+  uint64_t abr_seek_serial_ = 0;         // 缓冲估计所属的 Seek 序号
+
+  // ✅ 流水线卡死检测（各阶段上报进度，定时器线程检查）
+  std::unique_ptr<PipelineWatchdog> watchdog_;
+
+  // ✅ 是否已向统计模块登记为活跃流水线（控制线程访问）
+  bool stats_pipeline_active_ = false;
+
+  // ✅ 数据包抓取（用于离线回放复现卡顿，DemuxTask 线程独占）
+  std::unique_ptr<PacketCaptureWriter> packet_capture_;
+
+  // ✅ 解码帧导出到外部进程（VideoDecodeTask 线程独占发布）
+  std::unique_ptr<FrameExportSink> frame_export_;
+
+  // ✅ A-B 循环（从缓存回放时解封装线程停下）
+  std::unique_ptr<AbLoopController> ab_loop_;
+
+  // ✅ 解封装线程停下期间在 demux_park_cv_ 上等待
+  std::mutex demux_park_mutex_;
+  std::condition_variable demux_park_cv_;
+
+  // ✅ 倒放（状态只在 SeekTask 线程切换）
+  // demux_mutex_ / video_decode_mutex_ 让倒放解码器与正向线程互斥访问
+  // Demuxer 和视频解码器；正向播放时无竞争
+  std::mutex demux_mutex_;
+  std::mutex video_decode_mutex_;
+  std::unique_ptr<ReversePlayback> reverse_;
+
+  // ✅ 悬停预取；推迟的 Demuxer Seek 在 demux_mutex_ 内设置和执行
+  HoverSeekPrefetch hover_prefetch_;
+
   // 状态管理器（共享）
   std::shared_ptr<PlayerStateManager> state_manager_;
 
+  // 流水线配置档（队列容量、音频周期、统计间隔）
+  PipelineProfile profile_;
+
   // 数据队列（使用 BlockingQueue 替代轮询）
-  // ✅ 网络流优化：增大队列容量以应对网络抖动
-  BlockingQueue<AVPacket*> video_packet_queue_{64};  // 视频包队列，容量增至 64
-  BlockingQueue<AVPacket*> audio_packet_queue_{96};  // 音频包队列，容量增至 96
+  // ✅ 容量由 profile_ 设置，默认值与 balanced 配置档一致
+  BlockingQueue<AVPacket*> video_packet_queue_{64};  // 视频包队列
+  BlockingQueue<AVPacket*> audio_packet_queue_{96};  // 音频包队列
+
+  // ✅ Seek / 启动后队列为空，DemuxTask 一次读一批包并按流整批推入
+  std::atomic<bool> demux_refill_{true};
+  // 每次 Seek 递增，DemuxTask 据此丢弃 Seek 之前读出的整批包
+  std::atomic<uint64_t> demux_seek_serial_{0};
 
   // 解码线程（使用std::thread，因为需要持续运行）
   std::unique_ptr<std::thread> demux_thread_;
@@ -185,6 +536,16 @@ class PlaybackController {
   std::unique_ptr<std::thread> seek_thread_;
   BlockingQueue<SeekRequest> seek_request_queue_{10};  // Seek 请求队列，容量 10
   std::atomic<bool> seeking_{false};
+  std::atomic<uint64_t> seek_request_serial_{0};    // 最近分配的请求序号
+  std::atomic<uint64_t> completed_seek_serial_{0};  // 最近执行完的请求序号
+
+  // ✅ 拖动进度条（预览位置经 Seek 请求队列交给 SeekTask）
+  std::unique_ptr<ScrubController> scrub_;
+
+  // ✅ 精确 Seek 的目标位置：解码线程丢弃之前的帧，到达后解除
+  // （INT64_MIN 表示不丢弃）
+  std::atomic<int64_t> video_seek_target_us_{INT64_MIN};
+  std::atomic<int64_t> audio_seek_target_ms_{INT64_MIN};
 };
 
 }  // namespace zenplay
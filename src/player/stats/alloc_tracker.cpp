@@ -0,0 +1,164 @@
+#include "player/stats/alloc_tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace zenplay {
+namespace stats {
+
+namespace {
+
+// 计数器只用常量初始化的原子变量和 thread_local 整数：operator new 可能在
+// 静态初始化之前或线程退出时被调用，这里不能有动态初始化或分配
+std::atomic<bool> g_enabled{false};
+std::array<std::atomic<uint64_t>, AllocTracker::kSlotCount> g_allocs{};
+std::array<std::atomic<uint64_t>, AllocTracker::kSlotCount> g_bytes{};
+std::array<std::atomic<uint64_t>, AllocTracker::kSlotCount> g_frees{};
+
+thread_local size_t t_slot = AllocTracker::kUntagged;
+
+}  // namespace
+
+bool AllocTracker::IsCompiledIn() {
+#if defined(ZENPLAY_ALLOC_TRACKING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AllocTracker::SetEnabled(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AllocTracker::IsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void AllocTracker::SetCurrentThread(WakeupStats::Thread thread) {
+  auto slot = static_cast<size_t>(thread);
+  t_slot = slot < WakeupStats::kThreadCount ? slot : kUntagged;
+}
+
+void AllocTracker::RecordAlloc(size_t bytes) {
+  if (!g_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  size_t slot = t_slot;
+  g_allocs[slot].fetch_add(1, std::memory_order_relaxed);
+  g_bytes[slot].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::RecordFree() {
+  if (!g_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  g_frees[t_slot].fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocTracker::Snapshot AllocTracker::GetSnapshot() {
+  Snapshot snapshot;
+  for (size_t i = 0; i < kSlotCount; ++i) {
+    snapshot.allocs[i] = g_allocs[i].load(std::memory_order_relaxed);
+    snapshot.bytes[i] = g_bytes[i].load(std::memory_order_relaxed);
+    snapshot.frees[i] = g_frees[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void AllocTracker::Reset() {
+  for (size_t i = 0; i < kSlotCount; ++i) {
+    g_allocs[i].store(0, std::memory_order_relaxed);
+    g_bytes[i].store(0, std::memory_order_relaxed);
+    g_frees[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace stats
+}  // namespace zenplay
+
+#if defined(ZENPLAY_ALLOC_TRACKING)
+
+// ============================================================================
+// 全局 operator new/delete 替换（只替换非对齐版本，对齐版本仍成对使用默认
+// 实现）
+// ============================================================================
+
+namespace {
+
+void* TrackedAlloc(std::size_t size) {
+  zenplay::stats::AllocTracker::RecordAlloc(size);
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    if (void* ptr = std::malloc(size)) {
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void TrackedFree(void* ptr) noexcept {
+  if (ptr) {
+    zenplay::stats::AllocTracker::RecordFree();
+    std::free(ptr);
+  }
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return TrackedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+  return TrackedAlloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return TrackedAlloc(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return TrackedAlloc(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  TrackedFree(ptr);
+}
+
+#endif  // ZENPLAY_ALLOC_TRACKING
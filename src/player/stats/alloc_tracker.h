@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "player/stats/stats_types.h"
+
+namespace zenplay {
+namespace stats {
+
+/**
+ * @brief 堆分配跟踪器 - 按线程（流水线阶段）统计 operator new 次数和字节数
+ *
+ * 两级开关：
+ * 1. 编译期：CMake 选项 ZENPLAY_ALLOC_TRACKING=ON 才替换全局 operator
+ *    new/delete，关闭时没有任何额外开销
+ * 2. 运行期：SetEnabled(true) 后才计数（环境变量 ZENPLAY_ALLOC_TRACKING=1）
+ *
+ * 流水线线程启动时用 STATS_ALLOC_THREAD 标记自己的阶段，之后该线程上的分配
+ * （包括日志字符串、std::vector 扩容等）都计入这个阶段；未标记的线程
+ * （UI、Loki 等）计入 kUntagged。
+ *
+ * @note FFmpeg 没有可替换的分配钩子（av_malloc 直接调用 malloc /
+ *       posix_memalign），AVPacket / AVFrame 缓冲区不在统计范围内
+ */
+class AllocTracker {
+ public:
+  static constexpr size_t kUntagged = WakeupStats::kThreadCount;
+  static constexpr size_t kSlotCount = WakeupStats::kThreadCount + 1;
+
+  struct Snapshot {
+    std::array<uint64_t, kSlotCount> allocs{};  // 分配次数
+    std::array<uint64_t, kSlotCount> bytes{};   // 分配字节数
+    std::array<uint64_t, kSlotCount> frees{};   // 释放次数
+  };
+
+  /**
+   * @brief 是否编译了 operator new/delete 钩子
+   */
+  static bool IsCompiledIn();
+
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+
+  /**
+   * @brief 标记当前线程所属的流水线阶段
+   */
+  static void SetCurrentThread(WakeupStats::Thread thread);
+
+  /**
+   * @brief 记录一次分配 / 释放（由 operator new/delete 调用，不会分配内存）
+   */
+  static void RecordAlloc(size_t bytes);
+  static void RecordFree();
+
+  static Snapshot GetSnapshot();
+  static void Reset();
+};
+
+}  // namespace stats
+}  // namespace zenplay
+
+// 标记当前线程的分配归属（thread 为 WakeupStats::Thread 枚举名，如 kDemux）
+#define STATS_ALLOC_THREAD(thread)                 \
+  zenplay::stats::AllocTracker::SetCurrentThread(  \
+      zenplay::stats::WakeupStats::Thread::thread)
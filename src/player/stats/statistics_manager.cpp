@@ -7,6 +7,8 @@
 #include <iomanip>
 #include <sstream>
 
+#include "player/stats/alloc_tracker.h"
+
 namespace zenplay {
 namespace stats {
 
@@ -20,6 +22,17 @@ StatisticsManager::StatisticsManager(const StatsConfig& config)
       last_report_time_(std::chrono::steady_clock::now()),
       start_time_(std::chrono::steady_clock::now()) {
   InitializeStatsLogger();
+
+  if (config_.alloc_tracking_enabled) {
+    if (AllocTracker::IsCompiledIn()) {
+      AllocTracker::SetEnabled(true);
+      alloc_stats_.enabled.store(true);
+    } else {
+      MODULE_WARN(LOG_MODULE_STATS,
+                  "Allocation tracking requested but not compiled in, "
+                  "rebuild with -DZENPLAY_ALLOC_TRACKING=ON");
+    }
+  }
 }
 
 StatisticsManager::~StatisticsManager() {
@@ -175,6 +188,35 @@ void StatisticsManager::UpdateRenderStats(bool is_video,
   }
 }
 
+void StatisticsManager::UpdateTextureUploadStats(uint64_t bytes_uploaded,
+                                                 uint64_t bytes_saved,
+                                                 bool upload_skipped) {
+  if (!global_enabled_.load() || !config_.enabled) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  auto& render_stats = pipeline_stats_.video_render;
+  render_stats.bytes_uploaded.fetch_add(bytes_uploaded);
+  render_stats.bytes_upload_saved.fetch_add(bytes_saved);
+  if (upload_skipped) {
+    render_stats.frames_upload_skipped.fetch_add(1);
+  }
+}
+
+void StatisticsManager::UpdateFrameRateStats(double content_fps,
+                                             bool variable_frame_rate) {
+  if (!global_enabled_.load() || !config_.enabled) {
+    return;
+  }
+
+  // 每帧调用：只写原子变量，不加锁
+  auto& render_stats = pipeline_stats_.video_render;
+  render_stats.content_fps.store(content_fps, std::memory_order_relaxed);
+  render_stats.variable_frame_rate.store(variable_frame_rate,
+                                         std::memory_order_relaxed);
+}
+
 void StatisticsManager::UpdateSyncStats(double audio_clock_ms,
                                         double video_clock_ms,
                                         double sync_offset_ms,
@@ -227,7 +269,8 @@ void StatisticsManager::UpdateSystemStats(double cpu_percent,
 }
 
 void StatisticsManager::UpdateNetworkStats(double download_kbps,
-                                           uint64_t bytes_downloaded) {
+                                           uint64_t bytes_downloaded,
+                                           uint32_t buffer_health_percent) {
   if (!global_enabled_.load() || !config_.enabled) {
     return;
   }
@@ -235,6 +278,31 @@ void StatisticsManager::UpdateNetworkStats(double download_kbps,
   std::lock_guard<std::mutex> lock(stats_mutex_);
   network_stats_.download_rate_kbps.store(download_kbps);
   network_stats_.bytes_downloaded.store(bytes_downloaded);
+  network_stats_.buffer_health_percent.store(buffer_health_percent);
+}
+
+void StatisticsManager::UpdateStallStats(uint32_t stalled_stage_mask,
+                                         const std::string& snapshot) {
+  if (!global_enabled_.load() || !config_.enabled) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stall_stats_.stall_events.fetch_add(1);
+  stall_stats_.stalled_stage_mask.store(stalled_stage_mask);
+  stall_stats_.last_snapshot = snapshot;
+}
+
+void StatisticsManager::CountWakeup(WakeupStats::Thread thread) {
+  if (!global_enabled_.load() || !config_.enabled) {
+    return;
+  }
+
+  // 只有原子计数，不加 stats_mutex_，音频回调线程也可以调用
+  size_t index = static_cast<size_t>(thread);
+  wakeup_stats_.wakeups_total[index].fetch_add(1, std::memory_order_relaxed);
+  wakeup_stats_.wakeups_in_interval[index].fetch_add(
+      1, std::memory_order_relaxed);
 }
 
 // === 统计数据获取接口 ===
@@ -258,6 +326,48 @@ const NetworkStats& StatisticsManager::GetNetworkStats() const {
   return network_stats_;
 }
 
+const StallStats& StatisticsManager::GetStallStats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stall_stats_;
+}
+
+const WakeupStats& StatisticsManager::GetWakeupStats() const {
+  return wakeup_stats_;
+}
+
+const AllocStats& StatisticsManager::GetAllocStats() const {
+  return alloc_stats_;
+}
+
+const char* StatisticsManager::WakeupThreadName(WakeupStats::Thread thread) {
+  switch (thread) {
+    case WakeupStats::Thread::kDemux:
+      return "Demux";
+    case WakeupStats::Thread::kVideoDecode:
+      return "VideoDec";
+    case WakeupStats::Thread::kAudioDecode:
+      return "AudioDec";
+    case WakeupStats::Thread::kVideoRender:
+      return "VideoRnd";
+    case WakeupStats::Thread::kAudioOutput:
+      return "AudioOut";
+    case WakeupStats::Thread::kSyncControl:
+      return "Sync";
+    case WakeupStats::Thread::kSeek:
+      return "Seek";
+    case WakeupStats::Thread::kLoop:
+      return "Loop";
+    case WakeupStats::Thread::kReverse:
+      return "Reverse";
+    case WakeupStats::Thread::kWatchdog:
+      return "Watchdog";
+    case WakeupStats::Thread::kStatsTimer:
+      return "StatsTimer";
+    default:
+      return "Unknown";
+  }
+}
+
 // === 问题诊断接口 ===
 PerformanceBottleneck StatisticsManager::AnalyzeBottlenecks() const {
   // TODO: 实现瓶颈检测算法
@@ -279,6 +389,9 @@ std::string StatisticsManager::GenerateReport() const {
 
   report << "===== ZenPlay Performance Report (Runtime: " << elapsed.count()
          << "ms) =====\n";
+  if (!pipeline_profile_.empty()) {
+    report << "Profile: " << pipeline_profile_ << "\n";
+  }
 
   // Pipeline Stats
   report << "Pipeline Stats:\n";
@@ -315,7 +428,21 @@ std::string StatisticsManager::GenerateReport() const {
          << "Rendered: " << vrnd.render_rate_fps.load() << "fps, "
          << "Dropped: " << vrnd.frames_dropped.load() << " ("
          << std::setprecision(1) << vrnd.frame_drop_rate.load() << "%), "
-         << "AvgTime: " << vrnd.avg_render_time_ms.load() << "ms\n";
+         << "AvgTime: " << vrnd.avg_render_time_ms.load() << "ms, "
+         << "Content: " << std::setprecision(2) << vrnd.content_fps.load()
+         << "fps" << std::setprecision(1)
+         << (vrnd.variable_frame_rate.load() ? " (VFR)" : "") << "\n";
+
+  // Texture Upload（静态帧检测节省的带宽）
+  uint64_t uploaded = vrnd.bytes_uploaded.load();
+  uint64_t saved = vrnd.bytes_upload_saved.load();
+  if (uploaded + saved > 0) {
+    report << "  Upload   -> Uploaded: " << std::setprecision(1)
+           << (uploaded / 1024.0 / 1024.0) << "MB, "
+           << "Saved: " << (saved / 1024.0 / 1024.0) << "MB ("
+           << (saved * 100.0 / (uploaded + saved)) << "%), "
+           << "StaticFrames: " << vrnd.frames_upload_skipped.load() << "\n";
+  }
 
   // Audio Render
   const auto& arnd = pipeline_stats_.audio_render;
@@ -347,6 +474,59 @@ std::string StatisticsManager::GenerateReport() const {
          << "GPU: " << sys.gpu_memory_mb.load() << "MB, "
          << "Threads: " << sys.thread_count.load() << "\n";
 
+  // Network Stats（仅网络流有数据）
+  const auto& net = network_stats_;
+  if (net.bytes_downloaded.load() > 0) {
+    report << "Network Stats:\n";
+    report << "  Download: " << std::setprecision(1)
+           << net.download_rate_kbps.load() << "kbps, "
+           << "Total: " << (net.bytes_downloaded.load() / 1024.0 / 1024.0)
+           << "MB, "
+           << "Buffer: " << net.buffer_health_percent.load() << "%, "
+           << "Errors: " << net.network_errors.load() << "\n";
+  }
+
+  // Stall Stats（仅发生过卡死时输出）
+  if (stall_stats_.stall_events.load() > 0) {
+    report << "Stall Stats:\n";
+    report << "  Events: " << stall_stats_.stall_events.load()
+           << ", Last: " << stall_stats_.last_snapshot << "\n";
+  }
+
+  // Wakeup Stats（各线程唤醒速率，暂停时应接近 0）
+  report << "Wakeup Stats (/s):\n ";
+  double total_rate = 0.0;
+  for (size_t i = 0; i < WakeupStats::kThreadCount; ++i) {
+    double rate = wakeup_stats_.wakeup_rate[i].load();
+    total_rate += rate;
+    report << " " << WakeupThreadName(static_cast<WakeupStats::Thread>(i))
+           << ": " << std::setprecision(1) << rate;
+  }
+  report << ", Total: " << total_rate << "\n";
+
+  // Alloc Stats（各线程每帧堆分配次数 / 字节数）
+  if (alloc_stats_.enabled.load()) {
+    report << "Alloc Stats (/frame):\n ";
+    for (size_t i = 0; i < AllocStats::kSlotCount; ++i) {
+      double allocs = alloc_stats_.allocs_per_frame[i].load();
+      if (allocs <= 0.0) {
+        continue;
+      }
+      const char* name =
+          i < WakeupStats::kThreadCount
+              ? WakeupThreadName(static_cast<WakeupStats::Thread>(i))
+              : "Other";
+      report << " " << name << ": " << std::setprecision(1) << allocs << " ("
+             << std::setprecision(0) << alloc_stats_.bytes_per_frame[i].load()
+             << "B)";
+    }
+    report << ", Total: " << std::setprecision(1)
+           << alloc_stats_.total_allocs_per_frame.load() << " ("
+           << std::setprecision(0)
+           << alloc_stats_.total_bytes_per_frame.load() << "B)\n";
+    report << std::setprecision(1);
+  }
+
   // Bottleneck Analysis
   auto bottleneck = AnalyzeBottlenecks();
   report << "Bottleneck Analysis: Primary="
@@ -379,6 +559,11 @@ StatsConfig StatisticsManager::GetConfig() const {
   return config_;
 }
 
+void StatisticsManager::SetPipelineProfile(const std::string& name) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  pipeline_profile_ = name;
+}
+
 // === 控制接口 ===
 void StatisticsManager::Start() {
   if (running_.exchange(true)) {
@@ -387,15 +572,14 @@ void StatisticsManager::Start() {
 
   last_report_time_ = std::chrono::steady_clock::now();
 
-  if (config_.auto_logging) {
-    // 使用Timer替代手动线程管理
-    int interval_ms = static_cast<int>(config_.report_interval.count());
-    report_timer_ = TimerFactory::CreateRepeating(
-        interval_ms, [this]() { OnReportTimer(); });
+  if (config_.shm_publish_enabled) {
+    StartShmPublisher();
+  }
 
-    if (report_timer_) {
-      report_timer_->Start();
-    }
+  // 定时器只在有活跃流水线时运行
+  std::lock_guard<std::mutex> lock(timer_mutex_);
+  if (active_pipelines_ > 0) {
+    StartTimers_Locked();
   }
 
   MODULE_INFO(LOG_MODULE_STATS, "Statistics Manager started");
@@ -406,10 +590,10 @@ void StatisticsManager::Stop() {
     return;
   }
 
-  // 停止Timer（自动清理线程资源）
-  if (report_timer_) {
-    report_timer_->Stop();
-    report_timer_.reset();
+  {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    StopTimers_Locked();
+    StopShmPublisher();
   }
 
   // 输出最终报告
@@ -446,6 +630,11 @@ void StatisticsManager::Reset() {
     stats.frame_drop_rate.store(0.0);
     stats.avg_render_time_ms.store(0.0);
     stats.total_render_time_ms.store(0.0);
+    stats.bytes_uploaded.store(0);
+    stats.bytes_upload_saved.store(0);
+    stats.frames_upload_skipped.store(0);
+    stats.content_fps.store(0.0);
+    stats.variable_frame_rate.store(false);
   };
 
   // Reset demux stats
@@ -490,6 +679,30 @@ void StatisticsManager::Reset() {
   network_stats_.download_rate_kbps.store(0.0);
   network_stats_.bytes_downloaded.store(0);
   network_stats_.bytes_in_interval.store(0);
+  network_stats_.buffer_health_percent.store(100);
+
+  // Reset stall stats
+  stall_stats_.stall_events.store(0);
+  stall_stats_.stalled_stage_mask.store(0);
+  stall_stats_.last_snapshot.clear();
+
+  // Reset wakeup stats
+  for (size_t i = 0; i < WakeupStats::kThreadCount; ++i) {
+    wakeup_stats_.wakeups_total[i].store(0);
+    wakeup_stats_.wakeups_in_interval[i].store(0);
+    wakeup_stats_.wakeup_rate[i].store(0.0);
+  }
+
+  // Reset alloc stats（从当前累计值重新开始计算区间）
+  auto alloc_snapshot = AllocTracker::GetSnapshot();
+  for (size_t i = 0; i < AllocStats::kSlotCount; ++i) {
+    alloc_stats_.allocs_per_frame[i].store(0.0);
+    alloc_stats_.bytes_per_frame[i].store(0.0);
+    alloc_stats_.last_allocs[i] = alloc_snapshot.allocs[i];
+    alloc_stats_.last_bytes[i] = alloc_snapshot.bytes[i];
+  }
+  alloc_stats_.total_allocs_per_frame.store(0.0);
+  alloc_stats_.total_bytes_per_frame.store(0.0);
 
   start_time_ = std::chrono::steady_clock::now();
   last_report_time_ = start_time_;
@@ -497,7 +710,66 @@ void StatisticsManager::Reset() {
   MODULE_INFO(LOG_MODULE_STATS, "Statistics data reset");
 }
 
+void StatisticsManager::SetPipelineActive(bool active) {
+  std::lock_guard<std::mutex> lock(timer_mutex_);
+  if (active) {
+    if (++active_pipelines_ == 1 && running_.load()) {
+      StartTimers_Locked();
+    }
+    return;
+  }
+
+  if (active_pipelines_ == 0) {
+    return;
+  }
+  if (--active_pipelines_ == 0) {
+    StopTimers_Locked();
+    // 空闲前发布最终值，读端看到的是暂停时刻的数据
+    OnShmPublishTimer();
+  }
+}
+
 // === 私有方法 ===
+void StatisticsManager::StartTimers_Locked() {
+  // 空闲期间不计入速率区间
+  last_report_time_ = std::chrono::steady_clock::now();
+
+  if (config_.auto_logging && !report_timer_) {
+    // 使用Timer替代手动线程管理
+    int interval_ms = static_cast<int>(config_.report_interval.count());
+    report_timer_ = TimerFactory::CreateRepeating(
+        interval_ms, [this]() { OnReportTimer(); });
+
+    if (report_timer_) {
+      report_timer_->Start();
+    }
+  }
+
+  if (shm_publisher_ && !shm_publish_timer_) {
+    int interval_ms = static_cast<int>(config_.shm_publish_interval.count());
+    shm_publish_timer_ = TimerFactory::CreateRepeating(
+        std::max(interval_ms, 1), [this]() {
+          CountWakeup(WakeupStats::Thread::kStatsTimer);
+          OnShmPublishTimer();
+        });
+    if (shm_publish_timer_) {
+      shm_publish_timer_->Start();
+    }
+  }
+}
+
+void StatisticsManager::StopTimers_Locked() {
+  // 停止Timer（自动清理线程资源）
+  if (report_timer_) {
+    report_timer_->Stop();
+    report_timer_.reset();
+  }
+  if (shm_publish_timer_) {
+    shm_publish_timer_->Stop();
+    shm_publish_timer_.reset();
+  }
+}
+
 void StatisticsManager::CalculateRates() {
   auto current_time = std::chrono::steady_clock::now();
   auto interval_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -536,11 +808,41 @@ void StatisticsManager::CalculateRates() {
   uint64_t arendered_in_interval = arnd.frames_rendered_in_interval.exchange(0);
   arnd.render_rate_fps.store(arendered_in_interval / interval_seconds);
 
-  // 计算网络速率
-  auto& net = network_stats_;
-  uint64_t net_bytes_in_interval = net.bytes_in_interval.exchange(0);
-  net.download_rate_kbps.store((net_bytes_in_interval / interval_seconds) /
-                               1024.0);
+  // 计算线程唤醒速率
+  for (size_t i = 0; i < WakeupStats::kThreadCount; ++i) {
+    uint64_t wakeups = wakeup_stats_.wakeups_in_interval[i].exchange(0);
+    wakeup_stats_.wakeup_rate[i].store(wakeups / interval_seconds);
+  }
+
+  // 每帧分配：有视频按视频渲染帧归一化，纯音频按音频帧
+  if (alloc_stats_.enabled.load()) {
+    CalculateAllocRates(vrendered_in_interval > 0 ? vrendered_in_interval
+                                                  : arendered_in_interval);
+  }
+
+  // 网络速率由 ABR 吞吐量估计器直接写入（UpdateNetworkStats），
+  // 这里不再用区间字节数覆盖
+}
+
+void StatisticsManager::CalculateAllocRates(uint64_t frames) {
+  auto snapshot = AllocTracker::GetSnapshot();
+  double total_allocs = 0.0;
+  double total_bytes = 0.0;
+  for (size_t i = 0; i < AllocStats::kSlotCount; ++i) {
+    uint64_t allocs = snapshot.allocs[i] - alloc_stats_.last_allocs[i];
+    uint64_t bytes = snapshot.bytes[i] - alloc_stats_.last_bytes[i];
+    alloc_stats_.last_allocs[i] = snapshot.allocs[i];
+    alloc_stats_.last_bytes[i] = snapshot.bytes[i];
+
+    double allocs_per_frame = frames > 0 ? double(allocs) / frames : 0.0;
+    double bytes_per_frame = frames > 0 ? double(bytes) / frames : 0.0;
+    alloc_stats_.allocs_per_frame[i].store(allocs_per_frame);
+    alloc_stats_.bytes_per_frame[i].store(bytes_per_frame);
+    total_allocs += allocs_per_frame;
+    total_bytes += bytes_per_frame;
+  }
+  alloc_stats_.total_allocs_per_frame.store(total_allocs);
+  alloc_stats_.total_bytes_per_frame.store(total_bytes);
 }
 
 void StatisticsManager::DetectBottlenecks() {
@@ -573,6 +875,7 @@ void StatisticsManager::OnReportTimer() {
     return;  // 已停止，不处理回调
   }
 
+  CountWakeup(WakeupStats::Thread::kStatsTimer);
   CalculateRates();
 
   if (config_.enable_bottleneck_detection) {
@@ -584,6 +887,107 @@ void StatisticsManager::OnReportTimer() {
   last_report_time_ = std::chrono::steady_clock::now();
 }
 
+// === 共享内存发布 ===
+void StatisticsManager::StartShmPublisher() {
+  auto publisher = std::make_unique<StatsShmPublisher>();
+  auto result = publisher->Open(config_.shm_name);
+  if (!result.IsOk()) {
+    MODULE_WARN(LOG_MODULE_STATS, "Stats shm publishing disabled: {}",
+                result.Message());
+    return;
+  }
+  shm_publisher_ = std::move(publisher);
+
+  // 先发布一份，读端附加后立即可读；发布定时器由 StartTimers_Locked 启动
+  OnShmPublishTimer();
+}
+
+void StatisticsManager::StopShmPublisher() {
+  // 调用前发布定时器已经停止
+  if (shm_publisher_) {
+    // 停止前发布最终值
+    shm_publisher_->Publish(CaptureShmSnapshot());
+    shm_publisher_->Close();
+    shm_publisher_.reset();
+  }
+}
+
+void StatisticsManager::OnShmPublishTimer() {
+  if (!shm_publisher_) {
+    return;
+  }
+  shm_publisher_->Publish(CaptureShmSnapshot());
+}
+
+StatsShmSnapshot StatisticsManager::CaptureShmSnapshot() const {
+  // 所有字段都是原子变量，逐个读取即可，不占用 stats_mutex_，
+  // 避免发布线程与各更新路径竞争
+  StatsShmSnapshot snap;
+  auto now = std::chrono::steady_clock::now();
+  snap.timestamp_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  snap.uptime_ms = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_)
+          .count());
+
+  const auto& demux = pipeline_stats_.demux;
+  snap.demux_packets_total = demux.packets_read_total.load();
+  snap.demux_packets_video = demux.packets_read_video.load();
+  snap.demux_packets_audio = demux.packets_read_audio.load();
+  snap.demux_bytes_total = demux.bytes_read_total.load();
+  snap.demux_read_errors = demux.read_errors.load();
+  snap.demux_read_rate_pps = demux.read_rate_pps.load();
+  snap.demux_read_rate_bps = demux.read_rate_bps.load();
+  snap.demux_avg_read_time_ms = demux.avg_read_time_ms.load();
+
+  const auto& video_decode = pipeline_stats_.video_decode;
+  snap.video_frames_decoded = video_decode.frames_decoded.load();
+  snap.video_decode_errors = video_decode.decode_errors.load();
+  snap.video_decode_fps = video_decode.decode_rate_fps.load();
+  snap.video_avg_decode_time_ms = video_decode.avg_decode_time_ms.load();
+  snap.video_decode_queue_size = video_decode.queue_size.load();
+
+  const auto& audio_decode = pipeline_stats_.audio_decode;
+  snap.audio_frames_decoded = audio_decode.frames_decoded.load();
+  snap.audio_decode_errors = audio_decode.decode_errors.load();
+  snap.audio_decode_fps = audio_decode.decode_rate_fps.load();
+  snap.audio_avg_decode_time_ms = audio_decode.avg_decode_time_ms.load();
+  snap.audio_decode_queue_size = audio_decode.queue_size.load();
+
+  const auto& video_render = pipeline_stats_.video_render;
+  snap.video_frames_rendered = video_render.frames_rendered.load();
+  snap.video_frames_dropped = video_render.frames_dropped.load();
+  snap.video_render_fps = video_render.render_rate_fps.load();
+  snap.video_avg_render_time_ms = video_render.avg_render_time_ms.load();
+  snap.video_frame_drop_rate = video_render.frame_drop_rate.load();
+  snap.video_bytes_uploaded = video_render.bytes_uploaded.load();
+  snap.video_bytes_upload_saved = video_render.bytes_upload_saved.load();
+  snap.video_frames_upload_skipped = video_render.frames_upload_skipped.load();
+
+  const auto& audio_render = pipeline_stats_.audio_render;
+  snap.audio_frames_rendered = audio_render.frames_rendered.load();
+  snap.audio_frames_dropped = audio_render.frames_dropped.load();
+
+  snap.audio_clock_ms = sync_stats_.audio_clock_ms.load();
+  snap.video_clock_ms = sync_stats_.video_clock_ms.load();
+  snap.av_sync_offset_ms = sync_stats_.av_sync_offset_ms.load();
+  snap.avg_sync_offset_ms = sync_stats_.avg_sync_offset_ms.load();
+  snap.max_sync_error_ms = sync_stats_.max_sync_error_ms.load();
+  snap.sync_corrections = sync_stats_.sync_corrections.load();
+  snap.is_in_sync = sync_stats_.is_in_sync.load() ? 1 : 0;
+
+  snap.cpu_usage_percent = system_stats_.cpu_usage_percent.load();
+  snap.memory_usage_mb = system_stats_.memory_usage_mb.load();
+
+  snap.download_rate_kbps = network_stats_.download_rate_kbps.load();
+  snap.bytes_downloaded = network_stats_.bytes_downloaded.load();
+  snap.buffer_health_percent = network_stats_.buffer_health_percent.load();
+  snap.network_errors = network_stats_.network_errors.load();
+  return snap;
+}
+
 void StatisticsManager::InitializeStatsLogger() {
   try {
     if (config_.separate_log_file) {
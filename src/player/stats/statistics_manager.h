@@ -8,6 +8,7 @@
 
 #include "player/common/log_manager.h"
 #include "player/common/timer.h"
+#include "player/stats/stats_shm_publisher.h"
 #include "stats_types.h"
 
 namespace zenplay {
@@ -38,6 +39,10 @@ class StatisticsManager {
                          bool frame_rendered,
                          bool frame_dropped,
                          double render_time_ms);
+  void UpdateTextureUploadStats(uint64_t bytes_uploaded,
+                                uint64_t bytes_saved,
+                                bool upload_skipped);
+  void UpdateFrameRateStats(double content_fps, bool variable_frame_rate);
   void UpdateSyncStats(double audio_clock_ms,
                        double video_clock_ms,
                        double sync_offset_ms,
@@ -45,13 +50,28 @@ class StatisticsManager {
                        double max_sync_error_ms,
                        int64_t sync_corrections);
   void UpdateSystemStats(double cpu_percent, uint64_t memory_mb);
-  void UpdateNetworkStats(double download_kbps, uint64_t bytes_downloaded);
+  void UpdateNetworkStats(double download_kbps,
+                          uint64_t bytes_downloaded,
+                          uint32_t buffer_health_percent = 100);
+  void UpdateStallStats(uint32_t stalled_stage_mask,
+                        const std::string& snapshot);
+  void CountWakeup(WakeupStats::Thread thread);
 
   // === 统计数据获取接口 ===
   const PipelineStats& GetPipelineStats() const;
   const SyncQualityStats& GetSyncStats() const;
   const SystemResourceStats& GetSystemStats() const;
   const NetworkStats& GetNetworkStats() const;
+  const StallStats& GetStallStats() const;
+  const WakeupStats& GetWakeupStats() const;
+  const AllocStats& GetAllocStats() const;
+  static const char* WakeupThreadName(WakeupStats::Thread thread);
+
+  /**
+   * @brief 当前统计的一份快照（逐个读取原子变量，不加锁）
+   * @note 共享内存发布和屏幕统计浮层共用
+   */
+  StatsShmSnapshot CaptureShmSnapshot() const;
 
   // === 问题诊断接口 ===
   PerformanceBottleneck AnalyzeBottlenecks() const;
@@ -63,11 +83,23 @@ class StatisticsManager {
   void SetConfig(const StatsConfig& config);
   StatsConfig GetConfig() const;
 
+  /**
+   * @brief 记录当前使用的流水线配置档名称，显示在报告头部
+   */
+  void SetPipelineProfile(const std::string& name);
+
   // === 控制接口 ===
   void Start();
   void Stop();
   void Reset();
 
+  /**
+   * @brief 播放流水线进入 / 离开活跃状态（播放中为活跃，暂停、停止为空闲）
+   * @note 按引用计数：多条流水线（对比播放）都空闲时才停止报告和共享内存
+   *       发布定时器，空闲播放器不再被定时唤醒；重新活跃时恢复
+   */
+  void SetPipelineActive(bool active);
+
  private:
   void CalculateRates();         // 计算各种速率
   void DetectBottlenecks();      // 检测性能瓶颈
@@ -75,6 +107,14 @@ class StatisticsManager {
   void ResetCounters();          // 重置区间计数器
   void OnReportTimer();          // Timer回调函数
   void InitializeStatsLogger();  // 初始化统计日志记录器
+  void StartShmPublisher();      // 创建共享内存段和发布定时器
+  void StopShmPublisher();       // 停止发布并删除共享内存段
+  void OnShmPublishTimer();      // 发布一次快照
+  void StartTimers_Locked();     // 启动报告 / 发布定时器
+  void StopTimers_Locked();      // 停止定时器（空闲或停止时）
+
+  // 按区间内渲染帧数计算各线程每帧分配次数 / 字节数
+  void CalculateAllocRates(uint64_t frames);
 
   // 全局控制
   static std::atomic<bool> global_enabled_;
@@ -91,14 +131,24 @@ class StatisticsManager {
   SyncQualityStats sync_stats_;
   SystemResourceStats system_stats_;
   NetworkStats network_stats_;
+  StallStats stall_stats_;
+  WakeupStats wakeup_stats_;
+  AllocStats alloc_stats_;
   PerformanceBottleneck last_bottleneck_;
+  std::string pipeline_profile_;  // 流水线配置档名称
 
   // 时间管理
   std::chrono::steady_clock::time_point last_report_time_;
   std::chrono::steady_clock::time_point start_time_;
 
-  // Timer管理
+  // Timer管理（timer_mutex_ 保护定时器和活跃流水线计数）
+  std::mutex timer_mutex_;
+  int active_pipelines_ = 0;
   std::unique_ptr<Timer> report_timer_;
+  std::unique_ptr<Timer> shm_publish_timer_;
+
+  // 共享内存发布（发布定时器线程中访问，定时器停止后持有 timer_mutex_ 访问）
+  std::unique_ptr<StatsShmPublisher> shm_publisher_;
 
   // 日志管理
   std::shared_ptr<spdlog::logger> stats_logger_;
@@ -135,6 +185,15 @@ class StatisticsManager {
     }                                                                     \
   } while (0)
 
+#define STATS_UPDATE_FRAME_RATE(content_fps, variable)                  \
+  do {                                                                  \
+    if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {         \
+      auto* manager = zenplay::stats::StatisticsManager::GetInstance(); \
+      if (manager)                                                      \
+        manager->UpdateFrameRateStats(content_fps, variable);           \
+    }                                                                   \
+  } while (0)
+
 #define STATS_UPDATE_SYNC(audio_clock, video_clock, sync_offset, avg_error, \
                           max_error, corrections)                           \
   do {                                                                      \
@@ -146,6 +205,16 @@ class StatisticsManager {
     }                                                                       \
   } while (0)
 
+#define STATS_UPDATE_TEXTURE_UPLOAD(bytes_uploaded, bytes_saved, skipped) \
+  do {                                                                     \
+    if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {            \
+      auto* manager = zenplay::stats::StatisticsManager::GetInstance();    \
+      if (manager)                                                         \
+        manager->UpdateTextureUploadStats(bytes_uploaded, bytes_saved,     \
+                                          skipped);                        \
+    }                                                                      \
+  } while (0)
+
 #define STATS_UPDATE_SYSTEM(cpu_percent, memory_mb)                     \
   do {                                                                  \
     if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {         \
@@ -155,11 +224,37 @@ class StatisticsManager {
     }                                                                   \
   } while (0)
 
-#define STATS_UPDATE_NETWORK(download_kbps, bytes_total)                \
+#define STATS_UPDATE_STALL(stalled_mask, snapshot)                      \
   do {                                                                  \
     if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {         \
       auto* manager = zenplay::stats::StatisticsManager::GetInstance(); \
       if (manager)                                                      \
-        manager->UpdateNetworkStats(download_kbps, bytes_total);        \
+        manager->UpdateStallStats(stalled_mask, snapshot);              \
     }                                                                   \
   } while (0)
+
+#define STATS_COUNT_WAKEUP(thread)                                         \
+  do {                                                                     \
+    if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {            \
+      auto* manager = zenplay::stats::StatisticsManager::GetInstance();    \
+      if (manager)                                                         \
+        manager->CountWakeup(zenplay::stats::WakeupStats::Thread::thread); \
+    }                                                                      \
+  } while (0)
+
+#define STATS_PIPELINE_ACTIVE(active)                                 \
+  do {                                                                \
+    auto* manager = zenplay::stats::StatisticsManager::GetInstance(); \
+    if (manager)                                                      \
+      manager->SetPipelineActive(active);                             \
+  } while (0)
+
+#define STATS_UPDATE_NETWORK(download_kbps, bytes_total, buffer_health)   \
+  do {                                                                    \
+    if (zenplay::stats::StatisticsManager::IsGlobalEnabled()) {           \
+      auto* manager = zenplay::stats::StatisticsManager::GetInstance();   \
+      if (manager)                                                        \
+        manager->UpdateNetworkStats(download_kbps, bytes_total,           \
+                                    buffer_health);                       \
+    }                                                                     \
+  } while (0)
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <string>
+
 #include "player/stats/statistics_manager.h"
 
 namespace zenplay {
@@ -28,6 +31,23 @@ inline StatsConfig CreateRecommendedConfig() {
   // 高级功能
   config.enable_bottleneck_detection = true;  // 启用瓶颈检测
 
+  // 共享内存发布：统计系统早于配置系统初始化，因此通过环境变量开启
+  // ZENPLAY_STATS_SHM=1 使用默认段名，其他非空值作为段名（以 '/' 开头）
+  if (const char* shm = std::getenv("ZENPLAY_STATS_SHM")) {
+    std::string value = shm;
+    if (!value.empty() && value != "0") {
+      config.shm_publish_enabled = true;
+      if (value[0] == '/') {
+        config.shm_name = value;
+      }
+    }
+  }
+
+  // 堆分配统计：同样通过环境变量开启（需 ZENPLAY_ALLOC_TRACKING 编译选项）
+  if (const char* alloc = std::getenv("ZENPLAY_ALLOC_TRACKING")) {
+    config.alloc_tracking_enabled = std::string(alloc) == "1";
+  }
+
   return config;
 }
 
@@ -48,8 +68,10 @@ inline bool InitializeStatsSystem() {
     MODULE_INFO(
         LOG_MODULE_STATS,
         "Statistics system initialized with config: "
-        "enabled=true, interval={}s, auto_logging=true, separate_log=true",
-        config.report_interval.count());
+        "enabled=true, interval={}s, auto_logging=true, separate_log=true, "
+        "shm={}",
+        config.report_interval.count(),
+        config.shm_publish_enabled ? config.shm_name : "off");
     return true;
   } catch (const std::exception& e) {
     ZENPLAY_ERROR("Failed to initialize statistics system: {}", e.what());
@@ -0,0 +1,175 @@
+/**
+ * @file stats_shm_layout.h
+ * @brief 共享内存统计段的内存布局（播放器与外部监控工具共用）
+ *
+ * 段结构：[StatsShmHeader][StatsShmSnapshot]
+ *
+ * 写端（播放器）使用 seqlock 发布快照：
+ *   sequence 置为奇数 -> 写入快照 -> sequence 置为偶数
+ * 读端（任意进程）只读映射，读取前后 sequence 相同且为偶数即为一致快照，
+ * 否则重试。写端从不等待读端，读端数量和采样频率不影响播放器。
+ *
+ * 兼容规则：
+ * - 只在 StatsShmSnapshot 末尾追加字段，snapshot_size 随之增大
+ * - 字段语义变化或删除字段时递增 kStatsShmVersion
+ *
+ * 本文件只依赖标准库，外部工具可以直接包含。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace zenplay {
+namespace stats {
+
+constexpr uint32_t kStatsShmMagic = 0x5453505A;  // "ZPST"
+constexpr uint32_t kStatsShmVersion = 1;
+constexpr const char* kDefaultStatsShmName = "/zenplay_stats";
+
+/**
+ * @brief 统计快照（纯 POD，按 8 字节对齐，不含指针）
+ */
+struct StatsShmSnapshot {
+  // 时间
+  uint64_t timestamp_us = 0;  // 发布时刻（CLOCK_REALTIME，微秒）
+  uint64_t uptime_ms = 0;     // 统计系统运行时长
+
+  // 解封装
+  uint64_t demux_packets_total = 0;
+  uint64_t demux_packets_video = 0;
+  uint64_t demux_packets_audio = 0;
+  uint64_t demux_bytes_total = 0;
+  uint64_t demux_read_errors = 0;
+  double demux_read_rate_pps = 0.0;
+  double demux_read_rate_bps = 0.0;
+  double demux_avg_read_time_ms = 0.0;
+
+  // 视频解码
+  uint64_t video_frames_decoded = 0;
+  uint64_t video_decode_errors = 0;
+  double video_decode_fps = 0.0;
+  double video_avg_decode_time_ms = 0.0;
+  uint32_t video_decode_queue_size = 0;
+  uint32_t audio_decode_queue_size = 0;
+
+  // 音频解码
+  uint64_t audio_frames_decoded = 0;
+  uint64_t audio_decode_errors = 0;
+  double audio_decode_fps = 0.0;
+  double audio_avg_decode_time_ms = 0.0;
+
+  // 视频渲染
+  uint64_t video_frames_rendered = 0;
+  uint64_t video_frames_dropped = 0;
+  double video_render_fps = 0.0;
+  double video_avg_render_time_ms = 0.0;
+  double video_frame_drop_rate = 0.0;
+  uint64_t video_bytes_uploaded = 0;
+  uint64_t video_bytes_upload_saved = 0;
+  uint64_t video_frames_upload_skipped = 0;
+
+  // 音频渲染
+  uint64_t audio_frames_rendered = 0;
+  uint64_t audio_frames_dropped = 0;
+
+  // 同步
+  double audio_clock_ms = 0.0;
+  double video_clock_ms = 0.0;
+  double av_sync_offset_ms = 0.0;
+  double avg_sync_offset_ms = 0.0;
+  double max_sync_error_ms = 0.0;
+  uint64_t sync_corrections = 0;
+  uint32_t is_in_sync = 1;
+  uint32_t reserved0 = 0;
+
+  // 系统资源
+  double cpu_usage_percent = 0.0;
+  uint64_t memory_usage_mb = 0;
+
+  // 网络
+  double download_rate_kbps = 0.0;
+  uint64_t bytes_downloaded = 0;
+  uint32_t buffer_health_percent = 100;
+  uint32_t reserved1 = 0;
+  uint64_t network_errors = 0;
+};
+
+/**
+ * @brief 段头部
+ *
+ * magic 最后写入（release），读端看到正确的 magic 即说明其余头部字段
+ * 已经初始化完毕。
+ */
+struct StatsShmHeader {
+  std::atomic<uint32_t> magic{0};
+  uint32_t version = 0;
+  uint32_t header_size = 0;    // sizeof(StatsShmHeader)
+  uint32_t snapshot_size = 0;  // 写端的 sizeof(StatsShmSnapshot)
+  uint32_t writer_pid = 0;
+  uint32_t reserved = 0;
+  std::atomic<uint64_t> sequence{0};       // seqlock 序号，奇数表示写入中
+  std::atomic<uint64_t> publish_count{0};  // 已发布快照数
+};
+
+struct StatsShmSegment {
+  StatsShmHeader header;
+  StatsShmSnapshot snapshot;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "seqlock requires lock-free 64-bit atomics in shared memory");
+static_assert(sizeof(StatsShmSnapshot) % 8 == 0,
+              "StatsShmSnapshot must stay 8-byte aligned");
+
+/**
+ * @brief 写端：发布一份快照（单写者）
+ */
+inline void WriteStatsShmSnapshot(StatsShmSegment* segment,
+                                  const StatsShmSnapshot& snapshot) {
+  auto& header = segment->header;
+  uint64_t seq = header.sequence.load(std::memory_order_relaxed);
+  header.sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(&segment->snapshot, &snapshot, sizeof(StatsShmSnapshot));
+
+  header.sequence.store(seq + 2, std::memory_order_release);
+  header.publish_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 读端：读取一份一致的快照
+ * @param max_retries 写端正在写入时的最大重试次数
+ * @return 成功返回 true；头部无效或多次重试仍不一致返回 false
+ */
+inline bool ReadStatsShmSnapshot(const StatsShmSegment* segment,
+                                 StatsShmSnapshot* out,
+                                 int max_retries = 64) {
+  const auto& header = segment->header;
+  if (header.magic.load(std::memory_order_acquire) != kStatsShmMagic ||
+      header.version != kStatsShmVersion ||
+      header.snapshot_size < sizeof(StatsShmSnapshot)) {
+    return false;
+  }
+
+  for (int attempt = 0; attempt < max_retries; ++attempt) {
+    uint64_t begin = header.sequence.load(std::memory_order_acquire);
+    if (begin & 1) {
+      continue;  // 写入中
+    }
+
+    std::memcpy(out, &segment->snapshot, sizeof(StatsShmSnapshot));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header.sequence.load(std::memory_order_relaxed) == begin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace stats
+}  // namespace zenplay
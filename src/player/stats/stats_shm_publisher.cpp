@@ -0,0 +1,159 @@
+#include "player/stats/stats_shm_publisher.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(OS_LINUX) || defined(OS_MAC)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+namespace stats {
+
+StatsShmPublisher::~StatsShmPublisher() {
+  Close();
+}
+
+#if defined(OS_LINUX) || defined(OS_MAC)
+
+namespace {
+
+/**
+ * @brief 读取已有同名段的写端进程号
+ * @return 段不存在或头部未初始化返回 0
+ */
+uint32_t ReadSegmentOwner(const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  struct stat st {};
+  void* addr = MAP_FAILED;
+  if (fstat(fd, &st) == 0 &&
+      st.st_size >= static_cast<off_t>(sizeof(StatsShmHeader))) {
+    addr = mmap(nullptr, sizeof(StatsShmHeader), PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return 0;
+  }
+
+  const auto* header = static_cast<const StatsShmHeader*>(addr);
+  uint32_t pid = 0;
+  if (header->magic.load(std::memory_order_acquire) == kStatsShmMagic) {
+    pid = header->writer_pid;
+  }
+  munmap(addr, sizeof(StatsShmHeader));
+  return pid;
+}
+
+bool IsProcessAlive(uint32_t pid) {
+  return pid != 0 &&
+         (kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+}  // namespace
+
+Result<void> StatsShmPublisher::Open(const std::string& name) {
+  if (segment_) {
+    return Result<void>::Err(ErrorCode::kAlreadyRunning,
+                             "Stats shm segment already open: " + name_);
+  }
+  if (name.size() < 2 || name[0] != '/') {
+    return Result<void>::Err(ErrorCode::kInvalidParameter,
+                             "Invalid stats shm name: " + name);
+  }
+
+  // 同名段仍有写端在发布（另一个播放器进程）时不能删除它
+  uint32_t owner_pid = ReadSegmentOwner(name);
+  if (IsProcessAlive(owner_pid)) {
+    return Result<void>::Err(ErrorCode::kAlreadyRunning,
+                             "Stats shm segment " + name +
+                                 " is published by pid " +
+                                 std::to_string(owner_pid));
+  }
+
+  // 上次异常退出留下的旧段：先删除再创建，避免读端看到旧布局
+  shm_unlink(name.c_str());
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0644);
+  if (fd < 0) {
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "shm_open(" + name + ") failed: " + std::strerror(errno));
+  }
+
+  const size_t size = sizeof(StatsShmSegment);
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    int err = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "ftruncate failed: " + std::string(std::strerror(err)));
+  }
+
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);  // 映射建立后 fd 不再需要
+  if (addr == MAP_FAILED) {
+    int err = errno;
+    shm_unlink(name.c_str());
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "mmap failed: " + std::string(std::strerror(err)));
+  }
+
+  // ftruncate 后内容全为 0，magic 为 0 时读端不会读取
+  segment_ = new (addr) StatsShmSegment();
+  auto& header = segment_->header;
+  header.version = kStatsShmVersion;
+  header.header_size = sizeof(StatsShmHeader);
+  header.snapshot_size = sizeof(StatsShmSnapshot);
+  header.writer_pid = static_cast<uint32_t>(getpid());
+  header.magic.store(kStatsShmMagic, std::memory_order_release);
+
+  name_ = name;
+  MODULE_INFO(LOG_MODULE_STATS, "Stats shm segment published: {} ({} bytes)",
+              name_, size);
+  return Result<void>::Ok();
+}
+
+void StatsShmPublisher::Close() {
+  if (!segment_) {
+    return;
+  }
+
+  segment_->~StatsShmSegment();
+  munmap(segment_, sizeof(StatsShmSegment));
+  segment_ = nullptr;
+  shm_unlink(name_.c_str());
+  MODULE_INFO(LOG_MODULE_STATS, "Stats shm segment removed: {}", name_);
+  name_.clear();
+}
+
+#else
+
+Result<void> StatsShmPublisher::Open(const std::string& name) {
+  return Result<void>::Err(ErrorCode::kNotSupported,
+                           "Stats shm publishing requires POSIX: " + name);
+}
+
+void StatsShmPublisher::Close() {}
+
+#endif
+
+void StatsShmPublisher::Publish(const StatsShmSnapshot& snapshot) {
+  if (segment_) {
+    WriteStatsShmSnapshot(segment_, snapshot);
+  }
+}
+
+}  // namespace stats
+}  // namespace zenplay
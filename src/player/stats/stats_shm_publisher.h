@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+
+#include "player/common/error.h"
+#include "player/stats/stats_shm_layout.h"
+
+namespace zenplay {
+namespace stats {
+
+/**
+ * @brief 共享内存统计发布器
+ *
+ * 创建一个 POSIX 共享内存段（shm_open + mmap），按 stats_shm_layout.h
+ * 的布局以 seqlock 方式发布统计快照。发布只是一次 memcpy 加两次原子写，
+ * 外部监控进程只读映射后可以任意频率采样，不需要任何 IPC 往返。
+ *
+ * @note 仅支持 POSIX 平台（Linux / macOS），其他平台 Open() 返回
+ *       kNotSupported
+ * @note 单写者：Publish() 只能在同一线程中调用
+ */
+class StatsShmPublisher {
+ public:
+  StatsShmPublisher() = default;
+  ~StatsShmPublisher();
+
+  StatsShmPublisher(const StatsShmPublisher&) = delete;
+  StatsShmPublisher& operator=(const StatsShmPublisher&) = delete;
+
+  /**
+   * @brief 创建共享内存段并初始化头部
+   * @param name 段名称，POSIX 要求以 '/' 开头，例如 "/zenplay_stats"
+   * @return 同名段的写端进程仍在运行时返回 kAlreadyRunning（不删除
+   *         别人正在发布的段）；写端已退出的旧段删除后重新创建
+   */
+  Result<void> Open(const std::string& name);
+
+  /**
+   * @brief 发布一份快照
+   */
+  void Publish(const StatsShmSnapshot& snapshot);
+
+  /**
+   * @brief 解除映射并删除段（已经映射的读端仍可读到最后一份快照）
+   */
+  void Close();
+
+  bool IsOpen() const { return segment_ != nullptr; }
+  const std::string& name() const { return name_; }
+
+ private:
+  std::string name_;
+  StatsShmSegment* segment_ = nullptr;
+};
+
+}  // namespace stats
+}  // namespace zenplay
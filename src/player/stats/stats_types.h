@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <string>
@@ -54,6 +55,15 @@ struct PipelineStats {
     std::atomic<double> avg_render_time_ms{0.0};  // 平均渲染耗时(毫秒)
     std::atomic<double> frame_drop_rate{0.0};     // 丢帧率(%)
 
+    // 纹理上传（静态帧检测）
+    std::atomic<uint64_t> bytes_uploaded{0};         // 实际上传字节数
+    std::atomic<uint64_t> bytes_upload_saved{0};     // 跳过上传节省的字节数
+    std::atomic<uint64_t> frames_upload_skipped{0};  // 完全跳过上传的帧数
+
+    // 内容帧率（按实际帧时长，仅视频）
+    std::atomic<double> content_fps{0.0};          // 最近帧时长的平均帧率
+    std::atomic<bool> variable_frame_rate{false};  // 检测到可变帧率
+
     // 内部计算用
     std::atomic<uint64_t> frames_rendered_in_interval{0};  // 区间内渲染帧数
     std::atomic<uint64_t> frames_received_in_interval{0};  // 区间内接收帧数
@@ -106,6 +116,56 @@ struct NetworkStats {
   std::atomic<uint64_t> bytes_in_interval{0};  // 区间内下载字节
 };
 
+// === 流水线卡死统计 (PipelineWatchdog) ===
+struct StallStats {
+  std::atomic<uint64_t> stall_events{0};        // 卡死事件次数
+  std::atomic<uint32_t> stalled_stage_mask{0};  // 最近一次卡死的阶段位掩码
+  std::string last_snapshot;                    // 最近一次诊断快照
+};
+
+// === 线程唤醒统计 ===
+// 流水线线程每开始一轮处理（从阻塞等待返回）计数一次；暂停 / 停止时各线程
+// 都阻塞在条件等待上，唤醒速率应接近 0
+struct WakeupStats {
+  enum class Thread {
+    kDemux = 0,
+    kVideoDecode,
+    kAudioDecode,
+    kVideoRender,
+    kAudioOutput,
+    kSyncControl,
+    kSeek,
+    kLoop,
+    kReverse,
+    kWatchdog,
+    kStatsTimer,
+    kCount
+  };
+  static constexpr size_t kThreadCount = static_cast<size_t>(Thread::kCount);
+
+  std::array<std::atomic<uint64_t>, kThreadCount> wakeups_total{};  // 总次数
+  std::array<std::atomic<double>, kThreadCount> wakeup_rate{};      // 次/秒
+
+  // 内部计算用
+  std::array<std::atomic<uint64_t>, kThreadCount> wakeups_in_interval{};
+};
+
+// === 堆分配统计 (AllocTracker) ===
+// 按线程（流水线阶段）统计，末位为未标记线程；以区间内渲染帧数归一化
+struct AllocStats {
+  static constexpr size_t kSlotCount = WakeupStats::kThreadCount + 1;
+
+  std::atomic<bool> enabled{false};                                // 是否在统计
+  std::array<std::atomic<double>, kSlotCount> allocs_per_frame{};  // 次/帧
+  std::array<std::atomic<double>, kSlotCount> bytes_per_frame{};   // 字节/帧
+  std::atomic<double> total_allocs_per_frame{0.0};                 // 合计次/帧
+  std::atomic<double> total_bytes_per_frame{0.0};  // 合计字节/帧
+
+  // 内部计算用：上次计算时的累计值
+  std::array<uint64_t, kSlotCount> last_allocs{};
+  std::array<uint64_t, kSlotCount> last_bytes{};
+};
+
 // 性能瓶颈检测
 struct PerformanceBottleneck {
   enum class BottleneckType {
@@ -137,6 +197,14 @@ struct StatsConfig {
   bool enable_bottleneck_detection = true;               // 是否开启瓶颈检测
   double target_video_fps = 30.0;                        // 目标视频帧率
   double target_audio_sample_rate = 44100.0;             // 目标音频采样率
+
+  // 共享内存发布（供外部监控工具实时读取，仅 POSIX）
+  bool shm_publish_enabled = false;                      // 是否发布到共享内存
+  std::string shm_name = "/zenplay_stats";               // 共享内存段名称
+  std::chrono::milliseconds shm_publish_interval{100};   // 发布间隔
+
+  // 堆分配统计（需编译选项 ZENPLAY_ALLOC_TRACKING，否则计数恒为 0）
+  bool alloc_tracking_enabled = false;
 };
 
 }  // namespace stats
@@ -27,6 +27,13 @@ AVSyncController::SyncMode AVSyncController::GetSyncMode() const {
   return sync_mode_;
 }
 
+void AVSyncController::SetMasterSource(const AVSyncController* master) {
+  if (master == this) {
+    return;
+  }
+  master_source_.store(master, std::memory_order_release);
+}
+
 double AVSyncController::NormalizeAudioPTS(double raw_pts_ms) {
   // 必须在clock_mutex_保护下调用
 
@@ -126,6 +133,12 @@ void AVSyncController::UpdateVideoClock(
 
 double AVSyncController::GetMasterClock(
     std::chrono::steady_clock::time_point current_time) const {
+  // ✅ 对比播放：所有管线读同一个主时钟，不会各自漂移
+  if (const AVSyncController* master =
+          master_source_.load(std::memory_order_acquire)) {
+    return master->GetMasterClock(current_time);
+  }
+
   std::lock_guard<std::mutex> lock(clock_mutex_);
 
   // ✅ 暂停期间冻结时钟：使用暂停时刻作为当前时间
@@ -210,13 +223,17 @@ double AVSyncController::CalculateAudioAdjustment(
 
 bool AVSyncController::ShouldDropVideoFrame(
     double video_pts_ms,
-    std::chrono::steady_clock::time_point current_time) const {
+    std::chrono::steady_clock::time_point current_time,
+    double frame_duration_ms) const {
   if (!sync_params_.enable_frame_drop) {
     return false;
   }
 
+  // 下一帧到期之前不丢：阈值至少为这一帧的时长
+  double threshold =
+      std::max(sync_params_.drop_frame_threshold_ms, frame_duration_ms);
   double delay = CalculateVideoDelay(video_pts_ms, current_time);
-  return delay < -sync_params_.drop_frame_threshold_ms;
+  return delay < -threshold;
 }
 
 bool AVSyncController::ShouldRepeatVideoFrame(
@@ -133,6 +133,18 @@ class AVSyncController {
    */
   SyncMode GetSyncMode() const;
 
+  /**
+   * @brief 把主时钟委托给另一个同步控制器（多文件对比播放）
+   *
+   * 设置后 GetMasterClock() 直接返回 master 的主时钟，本控制器的同步模式、
+   * 暂停状态不再影响视频显示时间；PTS 归一化仍按本管线的第一帧计算，
+   * 因此起始时间不同的文件也能按各自的第一帧对齐。
+   *
+   * @param master 共享主时钟，传 nullptr 取消委托；生命周期需覆盖本控制器
+   * @thread_safety 线程安全
+   */
+  void SetMasterSource(const AVSyncController* master);
+
   /**
    * @brief 更新音频时钟
    *
@@ -228,11 +240,13 @@ class AVSyncController {
    * @brief 检查是否需要丢帧
    * @param video_pts_ms 视频帧PTS
    * @param current_time 当前时间
+   * @param frame_duration_ms 这一帧的时长；落后不超过一帧时长时不丢帧
+   *        （低帧率 / VFR 长帧），0 表示未知
    * @return true表示应该丢帧
    */
-  bool ShouldDropVideoFrame(
-      double video_pts_ms,
-      std::chrono::steady_clock::time_point current_time) const;
+  bool ShouldDropVideoFrame(double video_pts_ms,
+                            std::chrono::steady_clock::time_point current_time,
+                            double frame_duration_ms = 0.0) const;
 
   /**
    * @brief 检查是否需要重复帧
@@ -335,6 +349,9 @@ class AVSyncController {
   SyncMode sync_mode_;
   SyncParams sync_params_;
 
+  // 共享主时钟（对比播放时指向 CompareSession 的控制器）
+  std::atomic<const AVSyncController*> master_source_{nullptr};
+
   // === 时钟管理 ===
   mutable std::mutex clock_mutex_;
   ClockInfo audio_clock_;     // 音频时钟
@@ -0,0 +1,217 @@
+/**
+ * @file frame_export_layout.h
+ * @brief 解码帧共享内存导出的内存布局（播放器与外部消费进程共用）
+ *
+ * 段结构（memfd，经 Unix 域套接字传递 fd）：
+ *   [FrameExportHeader]
+ *   [FrameExportDescriptor x queue_capacity]   描述符环形队列
+ *   [FrameExportSlotState x slot_count]        帧槽位状态
+ *   [帧槽位 x slot_count]                       从 slots_offset 开始，页对齐
+ *
+ * 写端（播放器解码线程）单写者，从不等待读端：
+ * 1. 取槽位 frame_number % slot_count，generation 置为奇数后写入像素，
+ *    写完置为偶数
+ * 2. 描述符 frame_number % queue_capacity 以 seqlock 方式写入，
+ *    sequence 为 2 * (frame_number + 1) 时表示发布完成
+ * 3. write_index 递增（release）
+ *
+ * 读端（任意数量）只读映射，直接在槽位内读取像素（零拷贝）。处理完后比较
+ * 槽位 generation 与描述符中记录的值，不同说明读端落后、槽位已被覆盖，
+ * 本帧结果应丢弃。
+ *
+ * 兼容规则：
+ * - 只在结构末尾追加字段，header_size / descriptor_size 随之增大
+ * - 字段语义变化或删除字段时递增 kFrameExportVersion
+ *
+ * 本文件只依赖标准库，外部工具可以直接包含。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace zenplay {
+
+constexpr uint32_t kFrameExportMagic = 0x5846505A;  // "ZPFX"
+constexpr uint32_t kFrameExportVersion = 1;
+constexpr uint32_t kFrameExportMaxPlanes = 4;
+constexpr uint32_t kFrameExportQueueCapacity = 64;  // 2 的幂
+constexpr size_t kFrameExportPlaneAlignment = 64;   // 行与平面对齐（SIMD）
+constexpr size_t kFrameExportPageSize = 4096;
+constexpr const char* kDefaultFrameExportSocket = "/tmp/zenplay_frames.sock";
+
+/**
+ * @brief 一帧的描述（纯 POD，按 8 字节对齐，不含指针）
+ */
+struct FrameExportFrameInfo {
+  uint64_t frame_number = 0;     // 从 0 开始连续编号
+  uint64_t slot_generation = 0;  // 写完时槽位的 generation
+  int64_t pts_us = 0;            // 显示时间戳（微秒），未知时为 INT64_MIN
+  uint32_t slot = 0;
+  int32_t format = -1;  // AVPixelFormat
+  int32_t width = 0;
+  int32_t height = 0;
+  uint32_t plane_count = 0;
+  uint32_t reserved = 0;
+  uint64_t plane_offset[kFrameExportMaxPlanes] = {};  // 相对槽位起点
+  uint32_t linesize[kFrameExportMaxPlanes] = {};
+};
+
+/**
+ * @brief 描述符队列元素
+ *
+ * sequence：0 未使用；奇数写入中；2 * (frame_number + 1) 已发布
+ */
+struct FrameExportDescriptor {
+  std::atomic<uint64_t> sequence{0};
+  FrameExportFrameInfo info;
+};
+
+/**
+ * @brief 槽位状态（generation 奇数表示写端正在写入）
+ */
+struct alignas(64) FrameExportSlotState {
+  std::atomic<uint64_t> generation{0};
+};
+
+/**
+ * @brief 段头部
+ *
+ * magic 最后写入（release），读端看到正确的 magic 即说明布局字段已经
+ * 初始化完毕。
+ */
+struct FrameExportHeader {
+  std::atomic<uint32_t> magic{0};
+  uint32_t version = 0;
+  uint32_t header_size = 0;      // sizeof(FrameExportHeader)
+  uint32_t descriptor_size = 0;  // sizeof(FrameExportDescriptor)
+  uint32_t queue_capacity = 0;
+  uint32_t slot_count = 0;
+  uint64_t slot_size = 0;     // 每个槽位字节数（页对齐）
+  uint64_t slots_offset = 0;  // 第一个槽位相对段起点的偏移
+  uint64_t segment_size = 0;
+  uint32_t writer_pid = 0;
+  std::atomic<uint32_t> closed{0};  // 写端已停止导出
+
+  alignas(64) std::atomic<uint64_t> write_index{0};  // 已发布帧数
+};
+
+/**
+ * @brief 连接握手消息（与 memfd 一起通过 SCM_RIGHTS 发送）
+ */
+struct FrameExportHello {
+  uint32_t magic = kFrameExportMagic;
+  uint32_t version = kFrameExportVersion;
+  uint64_t segment_size = 0;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "frame export requires lock-free 64-bit atomics");
+static_assert((kFrameExportQueueCapacity & (kFrameExportQueueCapacity - 1)) ==
+                  0,
+              "kFrameExportQueueCapacity must be a power of two");
+static_assert(sizeof(FrameExportFrameInfo) % 8 == 0,
+              "FrameExportFrameInfo must stay 8-byte aligned");
+
+// ============================================================================
+// 段内寻址
+// ============================================================================
+
+inline size_t FrameExportAlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+inline size_t FrameExportDescriptorsOffset() {
+  return FrameExportAlignUp(sizeof(FrameExportHeader), 64);
+}
+
+inline size_t FrameExportSlotStatesOffset(uint32_t queue_capacity) {
+  return FrameExportDescriptorsOffset() +
+         FrameExportAlignUp(queue_capacity * sizeof(FrameExportDescriptor), 64);
+}
+
+inline size_t FrameExportSlotsOffset(uint32_t queue_capacity,
+                                     uint32_t slot_count) {
+  return FrameExportAlignUp(FrameExportSlotStatesOffset(queue_capacity) +
+                                slot_count * sizeof(FrameExportSlotState),
+                            kFrameExportPageSize);
+}
+
+inline FrameExportDescriptor* FrameExportDescriptorAt(void* base,
+                                                      uint64_t frame_number) {
+  auto* header = static_cast<FrameExportHeader*>(base);
+  auto* ring = reinterpret_cast<FrameExportDescriptor*>(
+      static_cast<uint8_t*>(base) + FrameExportDescriptorsOffset());
+  return &ring[frame_number & (header->queue_capacity - 1)];
+}
+
+inline FrameExportSlotState* FrameExportSlotStateAt(void* base,
+                                                    uint32_t slot) {
+  auto* header = static_cast<FrameExportHeader*>(base);
+  auto* states = reinterpret_cast<FrameExportSlotState*>(
+      static_cast<uint8_t*>(base) +
+      FrameExportSlotStatesOffset(header->queue_capacity));
+  return &states[slot];
+}
+
+inline uint8_t* FrameExportSlotData(void* base, uint32_t slot) {
+  auto* header = static_cast<FrameExportHeader*>(base);
+  return static_cast<uint8_t*>(base) + header->slots_offset +
+         slot * header->slot_size;
+}
+
+// ============================================================================
+// 读端
+// ============================================================================
+
+enum class FrameExportReadStatus {
+  kReady,     // 读到了请求的帧
+  kNotReady,  // 写端还没有发布这一帧
+  kOverrun,   // 描述符已被更新的帧覆盖，读端需要追赶
+};
+
+/**
+ * @brief 读端：读取第 frame_number 帧的描述
+ */
+inline FrameExportReadStatus ReadFrameExportDescriptor(
+    const void* base,
+    uint64_t frame_number,
+    FrameExportFrameInfo* out) {
+  const auto* descriptor =
+      FrameExportDescriptorAt(const_cast<void*>(base), frame_number);
+  const uint64_t expected = 2 * (frame_number + 1);
+
+  uint64_t begin = descriptor->sequence.load(std::memory_order_acquire);
+  if (begin < expected) {
+    return FrameExportReadStatus::kNotReady;
+  }
+  if (begin != expected) {
+    return FrameExportReadStatus::kOverrun;
+  }
+
+  std::memcpy(out, &descriptor->info, sizeof(FrameExportFrameInfo));
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (descriptor->sequence.load(std::memory_order_relaxed) != begin) {
+    return FrameExportReadStatus::kOverrun;
+  }
+  return FrameExportReadStatus::kReady;
+}
+
+/**
+ * @brief 读端：检查槽位在读取期间是否仍然保存着这一帧
+ * @note 在读完像素之后调用；返回 false 时本帧读到的数据可能被撕裂
+ */
+inline bool IsFrameExportSlotIntact(const void* base,
+                                    const FrameExportFrameInfo& info) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const auto* state =
+      FrameExportSlotStateAt(const_cast<void*>(base), info.slot);
+  return state->generation.load(std::memory_order_relaxed) ==
+         info.slot_generation;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,247 @@
+#include "player/video/export/frame_export_reader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace zenplay {
+
+namespace {
+
+// 等待新帧时的轮询间隔（写端不做任何通知，读端不影响播放器）
+constexpr auto kPollInterval = std::chrono::microseconds(500);
+
+}  // namespace
+
+FrameExportReader::~FrameExportReader() {
+  Disconnect();
+}
+
+bool FrameExportReader::Fail(const std::string& message) {
+  last_error_ = message;
+  return false;
+}
+
+#if defined(__linux__)
+
+bool FrameExportReader::Connect(const std::string& socket_path,
+                                int timeout_ms) {
+  Disconnect();
+
+  sockaddr_un address{};
+  if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+    return Fail("invalid socket path: " + socket_path);
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_ms);
+  auto remaining_ms = [&deadline]() {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    return static_cast<int>(std::max<int64_t>(left.count(), 0));
+  };
+
+  // 播放器可能还没开始监听，在超时前重试
+  int fd = -1;
+  while (true) {
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      return Fail(std::string("socket failed: ") + std::strerror(errno));
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) ==
+        0) {
+      break;
+    }
+    int err = errno;
+    close(fd);
+    if (remaining_ms() == 0) {
+      return Fail("connect(" + socket_path + ") failed: " +
+                  std::strerror(err));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  // 写端在第一帧解码后才发送 memfd
+  pollfd pfd{fd, POLLIN, 0};
+  if (poll(&pfd, 1, remaining_ms()) <= 0) {
+    close(fd);
+    return Fail("timed out waiting for the frame segment");
+  }
+
+  FrameExportHello hello;
+  iovec iov{&hello, sizeof(hello)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t received = recvmsg(fd, &message, MSG_CMSG_CLOEXEC);
+  close(fd);
+
+  int memfd = -1;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  if (cmsg && cmsg->cmsg_level == SOL_SOCKET &&
+      cmsg->cmsg_type == SCM_RIGHTS) {
+    std::memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+  }
+  if (received != static_cast<ssize_t>(sizeof(hello)) || memfd < 0) {
+    if (memfd >= 0) {
+      close(memfd);
+    }
+    return Fail("invalid handshake from frame export socket");
+  }
+  if (hello.magic != kFrameExportMagic ||
+      hello.version != kFrameExportVersion) {
+    close(memfd);
+    return Fail("frame export version mismatch");
+  }
+
+  struct stat st {};
+  if (fstat(memfd, &st) != 0 ||
+      static_cast<uint64_t>(st.st_size) < hello.segment_size) {
+    close(memfd);
+    return Fail("frame segment is smaller than announced");
+  }
+
+  size_t size = static_cast<size_t>(hello.segment_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, memfd, 0);
+  close(memfd);  // 映射建立后 fd 不再需要
+  if (addr == MAP_FAILED) {
+    return Fail(std::string("mmap failed: ") + std::strerror(errno));
+  }
+
+  const auto* header = static_cast<const FrameExportHeader*>(addr);
+  if (header->magic.load(std::memory_order_acquire) != kFrameExportMagic ||
+      header->version != kFrameExportVersion ||
+      header->header_size != sizeof(FrameExportHeader) ||
+      header->descriptor_size != sizeof(FrameExportDescriptor) ||
+      header->queue_capacity == 0 ||
+      (header->queue_capacity & (header->queue_capacity - 1)) != 0 ||
+      header->slot_count == 0 ||
+      header->slots_offset + header->slot_size * header->slot_count > size) {
+    munmap(addr, size);
+    return Fail("invalid frame segment header");
+  }
+
+  segment_ = addr;
+  segment_size_ = size;
+  next_frame_ = header->write_index.load(std::memory_order_acquire);
+  frames_read_ = 0;
+  frames_missed_ = 0;
+  last_error_.clear();
+  return true;
+}
+
+void FrameExportReader::Disconnect() {
+  if (segment_) {
+    munmap(segment_, segment_size_);
+    segment_ = nullptr;
+    segment_size_ = 0;
+  }
+}
+
+#else
+
+bool FrameExportReader::Connect(const std::string& socket_path,
+                                int timeout_ms) {
+  (void)timeout_ms;
+  return Fail("frame export requires Linux: " + socket_path);
+}
+
+void FrameExportReader::Disconnect() {}
+
+#endif
+
+bool FrameExportReader::Acquire(FrameExportFrame* frame) {
+  if (!segment_) {
+    return false;
+  }
+  const FrameExportHeader* segment_header = header();
+
+  while (true) {
+    uint64_t write_index =
+        segment_header->write_index.load(std::memory_order_acquire);
+    if (next_frame_ >= write_index) {
+      return false;
+    }
+
+    // 落后太多：更早的槽位已被覆盖，跳到较新的帧，留一半槽位作为余量
+    uint64_t max_lag = std::max<uint64_t>(segment_header->slot_count / 2, 1);
+    if (write_index - next_frame_ > max_lag) {
+      frames_missed_ += write_index - max_lag - next_frame_;
+      next_frame_ = write_index - max_lag;
+    }
+
+    FrameExportFrameInfo& info = frame->info;
+    auto status = ReadFrameExportDescriptor(segment_, next_frame_, &info);
+    if (status == FrameExportReadStatus::kNotReady) {
+      return false;
+    }
+    if (status == FrameExportReadStatus::kOverrun ||
+        info.slot >= segment_header->slot_count ||
+        info.plane_count > kFrameExportMaxPlanes) {
+      ++frames_missed_;
+      ++next_frame_;
+      continue;
+    }
+
+    const uint8_t* slot_data = FrameExportSlotData(segment_, info.slot);
+    for (uint32_t i = 0; i < kFrameExportMaxPlanes; ++i) {
+      bool valid = i < info.plane_count &&
+                   info.plane_offset[i] < segment_header->slot_size;
+      frame->data[i] = valid ? slot_data + info.plane_offset[i] : nullptr;
+      frame->linesize[i] = valid ? static_cast<int>(info.linesize[i]) : 0;
+    }
+    ++next_frame_;
+    ++frames_read_;
+    return true;
+  }
+}
+
+bool FrameExportReader::WaitForFrame(FrameExportFrame* frame, int timeout_ms) {
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_ms);
+  while (segment_) {
+    if (Acquire(frame)) {
+      return true;
+    }
+    if (IsWriterClosed() || std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(kPollInterval);
+  }
+  return false;
+}
+
+bool FrameExportReader::Release(const FrameExportFrame& frame) {
+  if (!segment_) {
+    return false;
+  }
+  if (!IsFrameExportSlotIntact(segment_, frame.info)) {
+    ++frames_missed_;
+    return false;
+  }
+  return true;
+}
+
+bool FrameExportReader::IsWriterClosed() const {
+  return !segment_ ||
+         header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+}  // namespace zenplay
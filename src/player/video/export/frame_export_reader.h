@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "player/video/export/frame_export_layout.h"
+
+namespace zenplay {
+
+/**
+ * @brief 读端看到的一帧（像素指针直接指向共享内存槽位）
+ */
+struct FrameExportFrame {
+  FrameExportFrameInfo info;
+  const uint8_t* data[kFrameExportMaxPlanes] = {};
+  int linesize[kFrameExportMaxPlanes] = {};
+};
+
+/**
+ * @brief 解码帧导出的读端（外部消费进程使用）
+ *
+ * 连接播放器的 Unix 域套接字，接收 memfd 后只读映射。Acquire() 返回的
+ * 像素指针直接指向槽位，不做任何拷贝；处理完调用 Release() 确认槽位在
+ * 处理期间没有被写端覆盖。
+ *
+ * 只依赖标准库和 POSIX，外部工具可以单独编译本文件。
+ *
+ * 用法：
+ * @code
+ *   FrameExportReader reader;
+ *   if (!reader.Connect("/tmp/zenplay_frames.sock", 5000)) { ... }
+ *   FrameExportFrame frame;
+ *   while (reader.WaitForFrame(&frame, 1000)) {
+ *     Analyze(frame.data[0], frame.linesize[0], ...);
+ *     if (!reader.Release(frame)) {
+ *       // 处理太慢，槽位已被覆盖，丢弃本帧结果
+ *     }
+ *   }
+ * @endcode
+ */
+class FrameExportReader {
+ public:
+  FrameExportReader() = default;
+  ~FrameExportReader();
+
+  FrameExportReader(const FrameExportReader&) = delete;
+  FrameExportReader& operator=(const FrameExportReader&) = delete;
+
+  /**
+   * @brief 连接并映射共享内存段
+   * @param timeout_ms 等待写端发送 memfd 的最长时间（写端在第一帧解码后
+   *        才创建段）
+   * @note 从连接时的最新帧开始读取，不回放更早的帧
+   */
+  bool Connect(const std::string& socket_path, int timeout_ms);
+
+  void Disconnect();
+
+  /**
+   * @brief 取下一帧（不阻塞）
+   * @return 没有新帧时返回 false
+   * @note 读端落后超过描述符队列长度时跳到最新帧，跳过的帧计入
+   *       frames_missed()
+   */
+  bool Acquire(FrameExportFrame* frame);
+
+  /**
+   * @brief 等待下一帧
+   * @return 超时或写端已关闭时返回 false
+   */
+  bool WaitForFrame(FrameExportFrame* frame, int timeout_ms);
+
+  /**
+   * @brief 结束对一帧的访问
+   * @return 槽位在访问期间未被覆盖返回 true；false 表示数据可能被撕裂，
+   *         同时计入 frames_missed()
+   */
+  bool Release(const FrameExportFrame& frame);
+
+  /**
+   * @brief 写端是否已经停止导出
+   */
+  bool IsWriterClosed() const;
+
+  bool IsConnected() const { return segment_ != nullptr; }
+  const FrameExportHeader* header() const {
+    return static_cast<const FrameExportHeader*>(segment_);
+  }
+  uint64_t frames_read() const { return frames_read_; }
+  uint64_t frames_missed() const { return frames_missed_; }
+  const std::string& last_error() const { return last_error_; }
+
+ private:
+  bool Fail(const std::string& message);
+
+  void* segment_ = nullptr;
+  size_t segment_size_ = 0;
+  uint64_t next_frame_ = 0;
+  uint64_t frames_read_ = 0;
+  uint64_t frames_missed_ = 0;
+  std::string last_error_;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,433 @@
+#include "player/video/export/frame_export_sink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(OS_LINUX)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "player/common/log_manager.h"
+
+extern "C" {
+#include <libavutil/common.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace zenplay {
+
+namespace {
+
+/**
+ * @brief 一帧在槽位内的平面布局（行按 kFrameExportPlaneAlignment 对齐）
+ */
+struct SlotLayout {
+  uint32_t plane_count = 0;
+  uint64_t offset[kFrameExportMaxPlanes] = {};
+  uint32_t linesize[kFrameExportMaxPlanes] = {};
+  int row_bytes[kFrameExportMaxPlanes] = {};
+  int rows[kFrameExportMaxPlanes] = {};
+  size_t total_bytes = 0;
+};
+
+/**
+ * @brief 计算槽位布局；硬件帧、码流和调色板格式返回 false
+ */
+bool ComputeSlotLayout(const AVFrame* frame, SlotLayout* layout) {
+  auto format = static_cast<AVPixelFormat>(frame->format);
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (!desc || frame->width <= 0 || frame->height <= 0 ||
+      (desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_BITSTREAM |
+                      AV_PIX_FMT_FLAG_PAL))) {
+    return false;
+  }
+
+  int plane_count = av_pix_fmt_count_planes(format);
+  if (plane_count <= 0 ||
+      plane_count > static_cast<int>(kFrameExportMaxPlanes)) {
+    return false;
+  }
+
+  *layout = SlotLayout{};
+  layout->plane_count = static_cast<uint32_t>(plane_count);
+  for (int i = 0; i < plane_count; ++i) {
+    int row_bytes = av_image_get_linesize(format, frame->width, i);
+    if (row_bytes <= 0) {
+      return false;
+    }
+    // 平面 1、2 是色度；平面 0、3 是亮度和 alpha
+    int rows = (i == 1 || i == 2)
+                   ? AV_CEIL_RSHIFT(frame->height, desc->log2_chroma_h)
+                   : frame->height;
+    size_t linesize =
+        FrameExportAlignUp(static_cast<size_t>(row_bytes),
+                           kFrameExportPlaneAlignment);
+
+    layout->offset[i] = layout->total_bytes;
+    layout->linesize[i] = static_cast<uint32_t>(linesize);
+    layout->row_bytes[i] = row_bytes;
+    layout->rows[i] = rows;
+    layout->total_bytes += FrameExportAlignUp(linesize * rows,
+                                              kFrameExportPlaneAlignment);
+  }
+  return true;
+}
+
+}  // namespace
+
+FrameExportSink::~FrameExportSink() {
+  Close();
+}
+
+#if defined(OS_LINUX)
+
+Result<void> FrameExportSink::Open(const std::string& socket_path,
+                                   uint32_t slot_count) {
+  if (IsOpen()) {
+    return Result<void>::Err(ErrorCode::kAlreadyRunning,
+                             "Frame export already open: " + socket_path_);
+  }
+
+  sockaddr_un address{};
+  if (slot_count < 2 || socket_path.empty() ||
+      socket_path.size() >= sizeof(address.sun_path)) {
+    return Result<void>::Err(ErrorCode::kInvalidParameter,
+                             "Invalid frame export socket or slot count: " +
+                                 socket_path);
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "socket failed: " + std::string(std::strerror(errno)));
+  }
+
+  // 上次异常退出可能留下旧套接字文件
+  unlink(socket_path.c_str());
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+      listen(fd, 8) != 0) {
+    int err = errno;
+    close(fd);
+    return Result<void>::Err(ErrorCode::kSystemError,
+                             "bind/listen(" + socket_path +
+                                 ") failed: " + std::strerror(err));
+  }
+
+  wake_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (wake_fd_ < 0) {
+    int err = errno;
+    close(fd);
+    unlink(socket_path.c_str());
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "eventfd failed: " + std::string(std::strerror(err)));
+  }
+
+  listen_fd_ = fd;
+  socket_path_ = socket_path;
+  slot_count_ = slot_count;
+  next_frame_number_ = 0;
+  warned_skip_ = false;
+  accept_thread_ =
+      std::make_unique<std::thread>(&FrameExportSink::AcceptLoop, this);
+
+  MODULE_INFO(LOG_MODULE_VIDEO, "Frame export listening on {} ({} slots)",
+              socket_path_, slot_count_);
+  return Result<void>::Ok();
+}
+
+void FrameExportSink::Close() {
+  if (!IsOpen()) {
+    return;
+  }
+
+  uint64_t one = 1;
+  ssize_t written = write(wake_fd_, &one, sizeof(one));
+  (void)written;
+  if (accept_thread_ && accept_thread_->joinable()) {
+    accept_thread_->join();
+  }
+  accept_thread_.reset();
+
+  close(listen_fd_);
+  close(wake_fd_);
+  listen_fd_ = -1;
+  wake_fd_ = -1;
+  unlink(socket_path_.c_str());
+
+  std::lock_guard<std::mutex> lock(clients_mutex_);
+  for (int client : pending_clients_) {
+    close(client);
+  }
+  pending_clients_.clear();
+
+  if (segment_) {
+    // 读端看到 closed 后停止等待新帧
+    auto* header = static_cast<FrameExportHeader*>(segment_);
+    header->closed.store(1, std::memory_order_release);
+    munmap(segment_, segment_size_);
+    segment_ = nullptr;
+    segment_size_ = 0;
+  }
+  if (memfd_ >= 0) {
+    close(memfd_);
+    memfd_ = -1;
+  }
+
+  MODULE_INFO(LOG_MODULE_VIDEO,
+              "Frame export closed: {} frames published, {} skipped, "
+              "{} consumers",
+              frames_published_.load(), frames_skipped_.load(),
+              consumers_served_.load());
+  socket_path_.clear();
+}
+
+Result<void> FrameExportSink::CreateSegment(const AVFrame* frame) {
+  SlotLayout layout;
+  if (!ComputeSlotLayout(frame, &layout)) {
+    return Result<void>::Err(ErrorCode::kNotSupported,
+                             "Frame format cannot be exported");
+  }
+
+  const size_t slot_size =
+      FrameExportAlignUp(layout.total_bytes, kFrameExportPageSize);
+  const size_t slots_offset =
+      FrameExportSlotsOffset(kFrameExportQueueCapacity, slot_count_);
+  const size_t size = slots_offset + slot_size * slot_count_;
+
+  int fd = memfd_create("zenplay_frames", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "memfd_create failed: " + std::string(std::strerror(errno)));
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    int err = errno;
+    close(fd);
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "ftruncate failed: " + std::string(std::strerror(err)));
+  }
+  // 固定大小：读端可以放心按 fstat 的大小映射
+  fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    int err = errno;
+    close(fd);
+    return Result<void>::Err(
+        ErrorCode::kSystemError,
+        "mmap failed: " + std::string(std::strerror(err)));
+  }
+
+  // ftruncate 后内容全为 0，magic 为 0 时读端不会读取
+  auto* header = new (addr) FrameExportHeader();
+  header->version = kFrameExportVersion;
+  header->header_size = sizeof(FrameExportHeader);
+  header->descriptor_size = sizeof(FrameExportDescriptor);
+  header->queue_capacity = kFrameExportQueueCapacity;
+  header->slot_count = slot_count_;
+  header->slot_size = slot_size;
+  header->slots_offset = slots_offset;
+  header->segment_size = size;
+  header->writer_pid = static_cast<uint32_t>(getpid());
+  for (uint32_t i = 0; i < kFrameExportQueueCapacity; ++i) {
+    new (FrameExportDescriptorAt(addr, i)) FrameExportDescriptor();
+  }
+  for (uint32_t i = 0; i < slot_count_; ++i) {
+    new (FrameExportSlotStateAt(addr, i)) FrameExportSlotState();
+  }
+  header->magic.store(kFrameExportMagic, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(clients_mutex_);
+  memfd_ = fd;
+  segment_ = addr;
+  segment_size_ = size;
+  for (int client : pending_clients_) {
+    SendSegment_Locked(client);
+  }
+  pending_clients_.clear();
+
+  MODULE_INFO(LOG_MODULE_VIDEO,
+              "Frame export segment created: {} {}x{}, {} slots x {} KB",
+              av_get_pix_fmt_name(static_cast<AVPixelFormat>(frame->format)),
+              frame->width, frame->height, slot_count_, slot_size / 1024);
+  return Result<void>::Ok();
+}
+
+void FrameExportSink::AcceptLoop() {
+  pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      MODULE_ERROR(LOG_MODULE_VIDEO, "Frame export poll failed: {}",
+                   std::strerror(errno));
+      break;
+    }
+    if (fds[1].revents) {
+      break;
+    }
+    if (!(fds[0].revents & POLLIN)) {
+      continue;
+    }
+
+    int client = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    if (memfd_ >= 0) {
+      SendSegment_Locked(client);
+    } else {
+      pending_clients_.push_back(client);
+    }
+  }
+}
+
+void FrameExportSink::SendSegment_Locked(int client_fd) {
+  FrameExportHello hello;
+  hello.segment_size = segment_size_;
+
+  iovec iov{&hello, sizeof(hello)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  std::memcpy(CMSG_DATA(cmsg), &memfd_, sizeof(int));
+
+  if (sendmsg(client_fd, &message, MSG_NOSIGNAL) < 0) {
+    MODULE_WARN(LOG_MODULE_VIDEO, "Frame export sendmsg failed: {}",
+                std::strerror(errno));
+  } else {
+    consumers_served_.fetch_add(1);
+    MODULE_INFO(LOG_MODULE_VIDEO, "Frame export consumer attached");
+  }
+  // fd 传递完成后连接不再需要，读端只通过共享内存访问
+  close(client_fd);
+}
+
+#else
+
+Result<void> FrameExportSink::Open(const std::string& socket_path,
+                                   uint32_t slot_count) {
+  (void)slot_count;
+  return Result<void>::Err(ErrorCode::kNotSupported,
+                           "Frame export requires Linux: " + socket_path);
+}
+
+void FrameExportSink::Close() {}
+
+Result<void> FrameExportSink::CreateSegment(const AVFrame* frame) {
+  (void)frame;
+  return Result<void>::Err(ErrorCode::kNotSupported,
+                           "Frame export requires Linux");
+}
+
+void FrameExportSink::AcceptLoop() {}
+
+void FrameExportSink::SendSegment_Locked(int client_fd) {
+  (void)client_fd;
+}
+
+#endif
+
+bool FrameExportSink::Publish(const AVFrame* frame, int64_t pts_us) {
+  if (!IsOpen() || !frame) {
+    return false;
+  }
+
+  if (!segment_) {
+    auto result = CreateSegment(frame);
+    if (!result.IsOk()) {
+      frames_skipped_.fetch_add(1);
+      if (!warned_skip_) {
+        warned_skip_ = true;
+        MODULE_WARN(LOG_MODULE_VIDEO, "Frame export skipped frame: {}",
+                    result.FullMessage());
+      }
+      return false;
+    }
+  }
+
+  auto* header = static_cast<FrameExportHeader*>(segment_);
+  SlotLayout layout;
+  if (!ComputeSlotLayout(frame, &layout) ||
+      layout.total_bytes > header->slot_size) {
+    frames_skipped_.fetch_add(1);
+    if (!warned_skip_) {
+      warned_skip_ = true;
+      MODULE_WARN(LOG_MODULE_VIDEO,
+                  "Frame export skipped frame: {}x{} format {} does not fit "
+                  "the export slots",
+                  frame->width, frame->height, frame->format);
+    }
+    return false;
+  }
+
+  const uint64_t frame_number = next_frame_number_++;
+  const auto slot = static_cast<uint32_t>(frame_number % slot_count_);
+
+  // 1. 槽位：generation 奇数期间写入像素
+  FrameExportSlotState* state = FrameExportSlotStateAt(segment_, slot);
+  uint64_t generation = state->generation.load(std::memory_order_relaxed);
+  state->generation.store(generation + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  uint8_t* slot_data = FrameExportSlotData(segment_, slot);
+  for (uint32_t i = 0; i < layout.plane_count; ++i) {
+    av_image_copy_plane(slot_data + layout.offset[i],
+                        static_cast<int>(layout.linesize[i]), frame->data[i],
+                        frame->linesize[i], layout.row_bytes[i],
+                        layout.rows[i]);
+  }
+  state->generation.store(generation + 2, std::memory_order_release);
+
+  // 2. 描述符：seqlock 发布
+  FrameExportDescriptor* descriptor =
+      FrameExportDescriptorAt(segment_, frame_number);
+  const uint64_t sequence = 2 * (frame_number + 1);
+  descriptor->sequence.store(sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  FrameExportFrameInfo& info = descriptor->info;
+  info.frame_number = frame_number;
+  info.slot_generation = generation + 2;
+  info.pts_us = pts_us;
+  info.slot = slot;
+  info.format = frame->format;
+  info.width = frame->width;
+  info.height = frame->height;
+  info.plane_count = layout.plane_count;
+  for (uint32_t i = 0; i < kFrameExportMaxPlanes; ++i) {
+    info.plane_offset[i] = layout.offset[i];
+    info.linesize[i] = layout.linesize[i];
+  }
+  descriptor->sequence.store(sequence, std::memory_order_release);
+
+  // 3. 队列尾
+  header->write_index.store(frame_number + 1, std::memory_order_release);
+  frames_published_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "player/common/error.h"
+#include "player/video/export/frame_export_layout.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 解码帧共享内存导出（供外部分析进程使用，无需重新解码）
+ *
+ * 帧数据写入 memfd 中的槽位环，描述符经无锁队列发布（布局见
+ * frame_export_layout.h）。消费进程连接 Unix 域套接字，通过 SCM_RIGHTS
+ * 拿到 memfd 后只读映射，直接在槽位内访问像素，不再有任何拷贝。
+ *
+ * 写端每帧只做一次拷贝（解码器输出 → 槽位），从不等待读端；读端落后超过
+ * 槽位数时由 generation 检测到覆盖并自行丢帧。
+ *
+ * 段在第一帧到达时按其格式和尺寸创建（槽位大小固定）；之后放不下的帧
+ * （分辨率变大）和硬件帧不导出，只计数。
+ *
+ * @note 仅支持 Linux（memfd_create），其他平台 Open() 返回 kNotSupported
+ * @note 单写者：Publish() 只能在同一线程中调用
+ */
+class FrameExportSink {
+ public:
+  FrameExportSink() = default;
+  ~FrameExportSink();
+
+  FrameExportSink(const FrameExportSink&) = delete;
+  FrameExportSink& operator=(const FrameExportSink&) = delete;
+
+  /**
+   * @brief 监听 Unix 域套接字，开始接受消费者连接
+   * @param socket_path 套接字路径（已存在的旧文件会被删除）
+   * @param slot_count 帧槽位数，决定读端最多可以落后多少帧
+   */
+  Result<void> Open(const std::string& socket_path, uint32_t slot_count);
+
+  /**
+   * @brief 发布一帧
+   * @param pts_us 显示时间戳（微秒），未知时传 INT64_MIN
+   * @return 帧已写入共享内存返回 true；被跳过返回 false
+   */
+  bool Publish(const AVFrame* frame, int64_t pts_us);
+
+  /**
+   * @brief 停止接受连接并释放段（已映射的读端仍可读取已发布的帧）
+   */
+  void Close();
+
+  bool IsOpen() const { return listen_fd_ >= 0; }
+  const std::string& socket_path() const { return socket_path_; }
+
+  uint64_t frames_published() const { return frames_published_.load(); }
+  uint64_t frames_skipped() const { return frames_skipped_.load(); }
+  uint64_t consumers_served() const { return consumers_served_.load(); }
+
+ private:
+  /**
+   * @brief 按第一帧创建 memfd 段并映射
+   */
+  Result<void> CreateSegment(const AVFrame* frame);
+
+  /**
+   * @brief 接受连接线程：把 memfd 发给每个新连接的消费者
+   */
+  void AcceptLoop();
+
+  /**
+   * @brief 向消费者发送握手消息和 memfd，然后关闭连接
+   * @note 调用者持有 clients_mutex_
+   */
+  void SendSegment_Locked(int client_fd);
+
+  std::string socket_path_;
+  uint32_t slot_count_ = 0;
+  int listen_fd_ = -1;
+  int wake_fd_ = -1;  // eventfd，唤醒 AcceptLoop 退出
+  std::unique_ptr<std::thread> accept_thread_;
+
+  // 段（创建后只读布局字段；memfd_ 与 pending_clients_ 受锁保护）
+  std::mutex clients_mutex_;
+  int memfd_ = -1;
+  std::vector<int> pending_clients_;  // 段创建前连接的消费者
+  void* segment_ = nullptr;
+  size_t segment_size_ = 0;
+
+  uint64_t next_frame_number_ = 0;
+  bool warned_skip_ = false;
+
+  std::atomic<uint64_t> frames_published_{0};
+  std::atomic<uint64_t> frames_skipped_{0};
+  std::atomic<uint64_t> consumers_served_{0};
+};
+
+}  // namespace zenplay
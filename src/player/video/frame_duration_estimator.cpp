@@ -0,0 +1,85 @@
+#include "player/video/frame_duration_estimator.h"
+
+#include <algorithm>
+
+namespace zenplay {
+
+FrameDurationEstimator::FrameDurationEstimator(double nominal_fps)
+    : nominal_fps_(nominal_fps > 0.0 ? nominal_fps : 30.0) {}
+
+double FrameDurationEstimator::OnFrame(int64_t pts_us,
+                                       int64_t duration_us,
+                                       double* previous_duration_ms) {
+  int64_t delta_us = 0;
+  if (pts_us != kUnknown && last_pts_us_ != kUnknown) {
+    delta_us = pts_us - last_pts_us_;
+    if (delta_us <= 0 || delta_us > kMaxDeltaUs) {
+      delta_us = 0;  // 乱序、重复或断点，不计入统计
+    }
+  }
+  if (pts_us != kUnknown) {
+    last_pts_us_ = pts_us;
+  }
+
+  bool has_duration = duration_us > 0 && duration_us <= kMaxDeltaUs;
+  if (delta_us > 0) {
+    AddDelta(delta_us);
+    // PTS 差是上一帧的时长
+    if (previous_duration_ms && !last_had_duration_) {
+      *previous_duration_ms = delta_us / 1000.0;
+    }
+  } else if (has_duration && pts_us == kUnknown) {
+    AddDelta(duration_us);  // 没有 PTS 时用帧时长统计帧率
+  }
+  last_had_duration_ = has_duration;
+
+  if (has_duration) {
+    return duration_us / 1000.0;
+  }
+  if (delta_us > 0) {
+    return delta_us / 1000.0;  // 预测值，下一帧到来时修正
+  }
+  return TypicalDurationMs();
+}
+
+double FrameDurationEstimator::TypicalDurationMs() const {
+  if (delta_count_ == 0) {
+    return 1000.0 / nominal_fps_;
+  }
+  return median_us_ / 1000.0;
+}
+
+double FrameDurationEstimator::ContentFps() const {
+  if (delta_count_ == 0 || mean_us_ <= 0.0) {
+    return nominal_fps_;
+  }
+  return 1'000'000.0 / mean_us_;
+}
+
+void FrameDurationEstimator::AddDelta(int64_t delta_us) {
+  deltas_[delta_next_] = delta_us;
+  delta_next_ = (delta_next_ + 1) % kWindow;
+  delta_count_ = std::min(delta_count_ + 1, kWindow);
+
+  std::array<int64_t, kWindow> sorted = deltas_;
+  std::sort(sorted.begin(), sorted.begin() + delta_count_);
+  median_us_ = sorted[delta_count_ / 2];
+
+  int64_t sum = 0;
+  for (size_t i = 0; i < delta_count_; ++i) {
+    sum += sorted[i];
+  }
+  mean_us_ = static_cast<double>(sum) / delta_count_;
+
+  if (variable_ || delta_count_ < kMinSamplesForVfr) {
+    return;
+  }
+  size_t trim = delta_count_ / 8;
+  int64_t spread = sorted[delta_count_ - 1 - trim] - sorted[trim];
+  int64_t tolerance = std::max<int64_t>(
+      kJitterToleranceUs,
+      static_cast<int64_t>(median_us_ * kVfrRelativeSpread));
+  variable_ = spread > tolerance;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace zenplay {
+
+/**
+ * @brief 视频帧时长估计：按呈现顺序喂入帧，给出每一帧的实际时长
+ *
+ * 每帧时长依次取：
+ * 1. 解码器给出的帧时长（AVFrame::duration，来自容器的包时长）
+ * 2. 与上一帧的 PTS 差（预测值：帧间隔通常延续，下一帧到来时修正）
+ * 3. 最近 PTS 差的中位数；还没有 PTS 差时用流的标称帧率
+ *
+ * 一帧与下一帧的 PTS 差才是这一帧的时长，因此没有帧时长的帧要等到
+ * 下一帧到来才能确定；OnFrame() 同时给出上一帧修正后的时长，VFR 切换
+ * 处不会把新间隔错算到后一帧上。
+ *
+ * 最近一段 PTS 差（去掉两端各 1/8 的离群值，如偶发的丢帧空洞）的
+ * 离散程度超过容差时判定为可变帧率（VFR），之后不再回到恒定帧率。
+ * 毫秒时间基容器中 23.976 / 29.97fps 的 ±1ms 取整抖动不算 VFR。
+ *
+ * @note 非线程安全，由调用方加锁
+ */
+class FrameDurationEstimator {
+ public:
+  static constexpr int64_t kUnknown = INT64_MIN;
+
+  /**
+   * @param nominal_fps 流的标称帧率（avg_frame_rate / r_frame_rate）
+   */
+  explicit FrameDurationEstimator(double nominal_fps = 30.0);
+
+  /**
+   * @brief 喂入一帧（按呈现顺序），返回这一帧的时长（毫秒）
+   * @param pts_us 帧 PTS（微秒），未知时为 kUnknown
+   * @param duration_us 解码器给出的帧时长（微秒），<= 0 表示未知
+   * @param previous_duration_ms 可选：上一帧没有帧时长、且这一帧给出了
+   *        与它的 PTS 差时，写入上一帧的实际时长（毫秒），否则不写入
+   * @return 有帧时长时为帧时长，否则为预测值
+   */
+  double OnFrame(int64_t pts_us,
+                 int64_t duration_us,
+                 double* previous_duration_ms = nullptr);
+
+  /**
+   * @brief Seek 后调用：PTS 不再连续，保留已有的帧率统计
+   */
+  void ResetTimeline() { last_pts_us_ = kUnknown; }
+
+  /**
+   * @brief 典型帧时长（毫秒）：最近 PTS 差的中位数
+   */
+  double TypicalDurationMs() const;
+
+  /**
+   * @brief 实际内容帧率：按最近 PTS 差的平均值计算
+   */
+  double ContentFps() const;
+
+  bool IsVariableFrameRate() const { return variable_; }
+
+ private:
+  static constexpr size_t kWindow = 32;
+  static constexpr size_t kMinSamplesForVfr = 8;
+  static constexpr int64_t kMaxDeltaUs = 5'000'000;   // 更大的差视为断点
+  static constexpr int64_t kJitterToleranceUs = 2000;  // 时间基取整抖动
+  static constexpr double kVfrRelativeSpread = 0.2;
+
+  void AddDelta(int64_t delta_us);
+
+  double nominal_fps_;
+  int64_t last_pts_us_ = kUnknown;
+  bool last_had_duration_ = false;  // 上一帧是否有解码器给出的帧时长
+  std::array<int64_t, kWindow> deltas_{};
+  size_t delta_count_ = 0;  // 窗口内的 PTS 差个数（最多 kWindow）
+  size_t delta_next_ = 0;   // 下一个写入位置
+  int64_t median_us_ = 0;
+  double mean_us_ = 0.0;
+  bool variable_ = false;
+};
+
+}  // namespace zenplay
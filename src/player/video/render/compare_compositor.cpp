@@ -0,0 +1,351 @@
+#include "player/video/render/compare_compositor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "player/common/log_manager.h"
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+namespace zenplay {
+
+namespace {
+
+// 超过这个时间没交帧的分块不再参与等待（暂停、播完或解码卡顿）
+constexpr auto kTileIdleTimeout = std::chrono::milliseconds(250);
+
+// 配对窗口：取最小帧间隔的一半，限制在这个范围内（帧间隔未知时取上限）
+constexpr auto kMinPairWindow = std::chrono::milliseconds(4);
+constexpr auto kMaxPairWindow = std::chrono::milliseconds(20);
+
+// 画布背景（YUV 有限范围黑色）
+constexpr uint8_t kBlackLuma = 16;
+constexpr uint8_t kBlackChroma = 128;
+
+/**
+ * @brief 对比播放的分块渲染器
+ *
+ * 不持有窗口，只把帧转交给合成器；窗口由合成器的输出渲染器持有。
+ */
+class CompareTileRenderer : public Renderer {
+ public:
+  CompareTileRenderer(CompareCompositor* compositor, int index)
+      : compositor_(compositor), index_(index) {}
+
+  Result<void> Init(void* /*window_handle*/,
+                    int /*width*/,
+                    int /*height*/) override {
+    return Result<void>::Ok();
+  }
+
+  bool RenderFrame(AVFrame* frame) override {
+    return compositor_->SubmitFrame(index_, frame);
+  }
+
+  void Clear() override {}
+  void Present() override {}
+  void OnResize(int /*width*/, int /*height*/) override {}
+  void Cleanup() override {}
+
+  const char* GetRendererName() const override { return "CompareTile"; }
+
+  void ClearCaches() override { compositor_->ResetTile(index_); }
+
+ private:
+  CompareCompositor* compositor_;
+  int index_;
+};
+
+/**
+ * @brief 帧的显示宽度（考虑像素宽高比）
+ */
+double DisplayWidth(const AVFrame* frame) {
+  const AVRational sar = frame->sample_aspect_ratio;
+  if (sar.num > 0 && sar.den > 0) {
+    return frame->width * static_cast<double>(sar.num) / sar.den;
+  }
+  return frame->width;
+}
+
+int EvenFloor(double value) {
+  return std::max(2, static_cast<int>(value) & ~1);
+}
+
+}  // namespace
+
+CompareCompositor::CompareCompositor(int tile_count,
+                                     Layout layout,
+                                     int max_cell_height,
+                                     std::unique_ptr<Renderer> output)
+    : layout_(layout),
+      max_cell_height_(std::max(max_cell_height, 2)),
+      tiles_(static_cast<size_t>(std::max(tile_count, 1))),
+      output_(std::move(output)) {
+  const int count = static_cast<int>(tiles_.size());
+  if (layout_ == Layout::kGrid) {
+    columns_ = static_cast<int>(std::ceil(std::sqrt(count)));
+    rows_ = (count + columns_ - 1) / columns_;
+  } else {
+    columns_ = count;
+    rows_ = 1;
+  }
+  MODULE_INFO(LOG_MODULE_RENDERER, "CompareCompositor created: {} tiles, {}x{}",
+              count, columns_, rows_);
+}
+
+CompareCompositor::~CompareCompositor() {
+  Cleanup();
+}
+
+CompareCompositor::Layout CompareCompositor::ParseLayout(
+    const std::string& name,
+    int tile_count) {
+  if (name == "side_by_side") {
+    return Layout::kSideBySide;
+  }
+  if (name == "grid") {
+    return Layout::kGrid;
+  }
+  return tile_count <= 2 ? Layout::kSideBySide : Layout::kGrid;
+}
+
+std::unique_ptr<Renderer> CompareCompositor::CreateTileRenderer(int index) {
+  if (index < 0 || index >= static_cast<int>(tiles_.size())) {
+    return nullptr;
+  }
+  return std::make_unique<CompareTileRenderer>(this, index);
+}
+
+Result<void> CompareCompositor::Init(void* window_handle,
+                                     int width,
+                                     int height) {
+  if (!output_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Compare output renderer not available");
+  }
+  return output_->Init(window_handle, width, height);
+}
+
+void CompareCompositor::OnResize(int width, int height) {
+  if (output_) {
+    output_->OnResize(width, height);
+  }
+}
+
+void CompareCompositor::Cleanup() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Tile& tile : tiles_) {
+    if (tile.sws_context) {
+      sws_freeContext(tile.sws_context);
+      tile.sws_context = nullptr;
+    }
+  }
+  if (canvas_) {
+    av_frame_free(&canvas_);
+  }
+  if (output_) {
+    output_->Cleanup();
+    output_.reset();
+  }
+}
+
+bool CompareCompositor::SubmitFrame(int index, const AVFrame* frame) {
+  // 到达时间在加锁前取：缩放在锁内串行执行，不能算进配对窗口
+  return SubmitFrame(index, frame, std::chrono::steady_clock::now());
+}
+
+bool CompareCompositor::SubmitFrame(
+    int index,
+    const AVFrame* frame,
+    std::chrono::steady_clock::time_point arrival) {
+  if (!frame || index < 0 || index >= static_cast<int>(tiles_.size())) {
+    return false;
+  }
+  if (frame->hw_frames_ctx) {
+    MODULE_WARN(LOG_MODULE_RENDERER,
+                "CompareCompositor: hardware frame on tile {} ignored", index);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!canvas_ && !AllocateCanvas_Locked(frame)) {
+    return false;
+  }
+
+  // 这一块抢先了一帧，或其它块等待中的帧属于上一轮：先呈现当前画布，
+  // 保证这些帧都被显示过，再开始新一轮
+  Tile& tile = tiles_[index];
+  if (tile.fresh || HasStaleFreshTile_Locked(index, arrival)) {
+    Present_Locked();
+  }
+
+  if (!ScaleIntoCell_Locked(index, frame)) {
+    return false;
+  }
+
+  if (tile.submitted && arrival > tile.last_submit) {
+    tile.interval = arrival - tile.last_submit;
+  }
+  tile.fresh = true;
+  tile.submitted = true;
+  tile.last_submit = arrival;
+
+  if (AllActiveTilesFresh_Locked(arrival)) {
+    Present_Locked();
+  }
+  return true;
+}
+
+void CompareCompositor::ResetTile(int index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index >= 0 && index < static_cast<int>(tiles_.size())) {
+    tiles_[index].fresh = false;
+  }
+}
+
+uint64_t CompareCompositor::frames_presented() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return frames_presented_;
+}
+
+bool CompareCompositor::AllocateCanvas_Locked(const AVFrame* frame) {
+  if (frame->width <= 0 || frame->height <= 0) {
+    return false;
+  }
+
+  // 格子尺寸取第一帧的显示宽高比，其它文件在格子里等比缩放居中
+  const double display_width = DisplayWidth(frame);
+  cell_height_ = EvenFloor(std::min(frame->height, max_cell_height_));
+  cell_width_ = EvenFloor(display_width * cell_height_ / frame->height);
+
+  canvas_ = av_frame_alloc();
+  if (!canvas_) {
+    return false;
+  }
+  canvas_->format = AV_PIX_FMT_YUV420P;
+  canvas_->width = cell_width_ * columns_;
+  canvas_->height = cell_height_ * rows_;
+  if (av_frame_get_buffer(canvas_, 32) < 0) {
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to allocate compare canvas");
+    av_frame_free(&canvas_);
+    return false;
+  }
+  FillRect_Locked(0, 0, canvas_->width, canvas_->height);
+
+  MODULE_INFO(LOG_MODULE_RENDERER, "Compare canvas {}x{} (cell {}x{})",
+              canvas_->width, canvas_->height, cell_width_, cell_height_);
+  return true;
+}
+
+bool CompareCompositor::ScaleIntoCell_Locked(int index, const AVFrame* frame) {
+  Tile& tile = tiles_[index];
+  const int cell_x = (index % columns_) * cell_width_;
+  const int cell_y = (index / columns_) * cell_height_;
+
+  const double display_width = DisplayWidth(frame);
+  const double scale = std::min(cell_width_ / display_width,
+                                static_cast<double>(cell_height_) /
+                                    frame->height);
+  const int dst_width = std::min(EvenFloor(display_width * scale), cell_width_);
+  const int dst_height =
+      std::min(EvenFloor(frame->height * scale), cell_height_);
+  const int dst_x = cell_x + (((cell_width_ - dst_width) / 2) & ~1);
+  const int dst_y = cell_y + (((cell_height_ - dst_height) / 2) & ~1);
+
+  // 分辨率变化后目标区域变小，先清掉格子里的旧画面
+  if (dst_width != tile.dst_width || dst_height != tile.dst_height) {
+    FillRect_Locked(cell_x, cell_y, cell_width_, cell_height_);
+  }
+
+  SwsContext* context = sws_getCachedContext(
+      tile.sws_context, frame->width, frame->height,
+      static_cast<AVPixelFormat>(frame->format), dst_width, dst_height,
+      AV_PIX_FMT_YUV420P, SWS_BILINEAR, nullptr, nullptr, nullptr);
+  if (!context) {
+    MODULE_ERROR(LOG_MODULE_RENDERER,
+                 "CompareCompositor: cannot scale {} on tile {}",
+                 av_get_pix_fmt_name(static_cast<AVPixelFormat>(frame->format)),
+                 index);
+    return false;
+  }
+  tile.sws_context = context;
+  tile.dst_width = dst_width;
+  tile.dst_height = dst_height;
+
+  // 直接缩放进画布中的目标区域，不经过中间帧
+  uint8_t* dst[4] = {
+      canvas_->data[0] + dst_y * canvas_->linesize[0] + dst_x,
+      canvas_->data[1] + (dst_y / 2) * canvas_->linesize[1] + dst_x / 2,
+      canvas_->data[2] + (dst_y / 2) * canvas_->linesize[2] + dst_x / 2,
+      nullptr};
+  int dst_stride[4] = {canvas_->linesize[0], canvas_->linesize[1],
+                       canvas_->linesize[2], 0};
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height, dst,
+            dst_stride);
+  return true;
+}
+
+void CompareCompositor::FillRect_Locked(int x, int y, int width, int height) {
+  for (int row = 0; row < height; ++row) {
+    std::memset(canvas_->data[0] + (y + row) * canvas_->linesize[0] + x,
+                kBlackLuma, width);
+  }
+  for (int row = 0; row < height / 2; ++row) {
+    for (int plane = 1; plane <= 2; ++plane) {
+      std::memset(canvas_->data[plane] +
+                      (y / 2 + row) * canvas_->linesize[plane] + x / 2,
+                  kBlackChroma, width / 2);
+    }
+  }
+}
+
+bool CompareCompositor::AllActiveTilesFresh_Locked(
+    std::chrono::steady_clock::time_point now) const {
+  for (const Tile& tile : tiles_) {
+    if (!tile.submitted || now - tile.last_submit > kTileIdleTimeout) {
+      continue;
+    }
+    if (!tile.fresh) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareCompositor::HasStaleFreshTile_Locked(
+    int index,
+    std::chrono::steady_clock::time_point now) const {
+  std::chrono::steady_clock::duration window = kMaxPairWindow;
+  for (const Tile& tile : tiles_) {
+    if (tile.interval.count() > 0) {
+      window = std::min(window, tile.interval / 2);
+    }
+  }
+  window = std::max<std::chrono::steady_clock::duration>(window,
+                                                         kMinPairWindow);
+
+  for (int i = 0; i < static_cast<int>(tiles_.size()); ++i) {
+    if (i != index && tiles_[i].fresh && now - tiles_[i].last_submit > window) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CompareCompositor::Present_Locked() {
+  // 输出渲染器是 RendererProxy，同步投递到 UI 线程；UI 线程不会回调
+  // 合成器，持锁呈现不会死锁，也保证呈现期间没有分块在写画布
+  if (output_) {
+    output_->RenderFrame(canvas_);
+  }
+  for (Tile& tile : tiles_) {
+    tile.fresh = false;
+  }
+  ++frames_presented_;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "player/common/error.h"
+#include "player/video/render/renderer.h"
+
+struct SwsContext;
+
+namespace zenplay {
+
+/**
+ * @brief 多文件对比播放的画面合成器
+ *
+ * 每条播放管线拿到一个分块渲染器（CreateTileRenderer），VideoPlayer 渲染
+ * 时把帧交给合成器，由 swscale 缩放进画布中对应的格子（保持宽高比居中）。
+ * 画布是一张 YUV420P 帧，交给真正的渲染器显示，因此任何渲染后端都可用。
+ *
+ * 呈现时机（各管线跟随同一主时钟，同一时刻的帧几乎同时到达）：
+ * - 所有活跃分块都交了新帧 → 呈现
+ * - 某块在上一帧呈现前又交了一帧，或其它块等待中的帧比配对窗口（约半个
+ *   帧间隔）更早 → 那些帧属于上一轮，先呈现当前画布再写入新帧；
+ *   任何一帧都不会被跳过，一次错位也会在下一轮自动纠正
+ * - 超过 kTileIdleTimeout 没交帧的分块（暂停、播完、解码卡顿）不参与等待
+ */
+class CompareCompositor {
+ public:
+  enum class Layout {
+    kSideBySide,  // 单行并排
+    kGrid,        // 网格，列数 = ceil(sqrt(n))
+  };
+
+  /**
+   * @param tile_count 分块数量（每个文件一块）
+   * @param layout 布局
+   * @param max_cell_height 格子最大高度，格子尺寸按第一帧的宽高比确定
+   * @param output 显示画布的渲染器（已包装为 RendererProxy）
+   */
+  CompareCompositor(int tile_count,
+                    Layout layout,
+                    int max_cell_height,
+                    std::unique_ptr<Renderer> output);
+  ~CompareCompositor();
+
+  CompareCompositor(const CompareCompositor&) = delete;
+  CompareCompositor& operator=(const CompareCompositor&) = delete;
+
+  /**
+   * @brief 解析配置中的布局名（"side_by_side" / "grid" / "auto"）
+   * @note auto：两个文件并排，更多时用网格
+   */
+  static Layout ParseLayout(const std::string& name, int tile_count);
+
+  /**
+   * @brief 创建第 index 块的渲染器（交给对应的 ZenPlayer）
+   * @note 合成器的生命周期需覆盖所有分块渲染器
+   */
+  std::unique_ptr<Renderer> CreateTileRenderer(int index);
+
+  Result<void> Init(void* window_handle, int width, int height);
+  void OnResize(int width, int height);
+  void Cleanup();
+
+  /**
+   * @brief 提交一块的新帧（各管线的渲染线程调用）
+   * @return 帧无法合成（硬件帧、格式不支持）时返回 false
+   */
+  bool SubmitFrame(int index, const AVFrame* frame);
+
+  /**
+   * @brief 提交一块的新帧，使用指定的到达时间（测试用）
+   */
+  bool SubmitFrame(int index,
+                   const AVFrame* frame,
+                   std::chrono::steady_clock::time_point arrival);
+
+  /**
+   * @brief Seek 时清除分块的新帧标记，旧帧不再参与配对
+   */
+  void ResetTile(int index);
+
+  uint64_t frames_presented() const;
+
+ private:
+  struct Tile {
+    SwsContext* sws_context = nullptr;
+    int dst_width = 0;
+    int dst_height = 0;
+    bool fresh = false;      // 有尚未呈现的新帧
+    bool submitted = false;  // 至少交过一帧
+    std::chrono::steady_clock::time_point last_submit;  // 到达时间（加锁前）
+    std::chrono::steady_clock::duration interval{};     // 最近的帧间隔
+  };
+
+  bool AllocateCanvas_Locked(const AVFrame* frame);
+  bool ScaleIntoCell_Locked(int index, const AVFrame* frame);
+  void FillRect_Locked(int x, int y, int width, int height);
+  bool AllActiveTilesFresh_Locked(
+      std::chrono::steady_clock::time_point now) const;
+  bool HasStaleFreshTile_Locked(
+      int index,
+      std::chrono::steady_clock::time_point now) const;
+  void Present_Locked();
+
+  const Layout layout_;
+  const int max_cell_height_;
+  int columns_ = 1;
+  int rows_ = 1;
+  int cell_width_ = 0;
+  int cell_height_ = 0;
+
+  mutable std::mutex mutex_;
+  std::vector<Tile> tiles_;
+  AVFrame* canvas_ = nullptr;
+  std::unique_ptr<Renderer> output_;
+  uint64_t frames_presented_ = 0;
+};
+
+}  // namespace zenplay
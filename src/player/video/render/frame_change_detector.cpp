@@ -0,0 +1,130 @@
+#include "player/video/render/frame_change_detector.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace zenplay {
+
+const FrameChangeDetector::ChangeInfo& FrameChangeDetector::Analyze(
+    const AVFrame* frame) {
+  info_.full_update = true;
+  info_.dirty_tiles = 0;
+  info_.dirty_rects.clear();
+
+  if (!frame || !SetupLayout(frame)) {
+    Reset();
+    return info_;
+  }
+
+  info_.total_tiles = tiles_x_ * tiles_y_;
+
+  // 1. 计算当前帧每个图块的哈希（所有平面累加到同一个图块状态）
+  std::memset(states_.data(), 0, states_.size() * sizeof(TileHashState));
+  for (int plane = 0; plane < plane_count_; ++plane) {
+    int row_bytes = plane_row_bytes_[plane];
+    int rows = plane_rows_[plane];
+    int tile_bytes = std::max(
+        1, static_cast<int>(static_cast<int64_t>(kTileSize) * row_bytes /
+                            width_));
+    int tile_rows = std::max(
+        1, static_cast<int>(static_cast<int64_t>(kTileSize) * rows / height_));
+
+    const uint8_t* data = frame->data[plane];
+    for (int row = 0; row < rows; ++row) {
+      int tile_y = std::min(row / tile_rows, tiles_y_ - 1);
+      const uint8_t* row_data =
+          data + static_cast<ptrdiff_t>(row) * frame->linesize[plane];
+      AccumulateTileRow(row_data, row_bytes, tile_bytes, tiles_x_,
+                        &states_[tile_y * tiles_x_]);
+    }
+  }
+
+  // 2. 与上一帧比较，同一行相邻的变化图块合并为一个矩形
+  bool compare = has_history_;
+  for (int ty = 0; ty < tiles_y_; ++ty) {
+    int run_start = -1;
+    for (int tx = 0; tx <= tiles_x_; ++tx) {
+      bool dirty = false;
+      if (tx < tiles_x_) {
+        int index = ty * tiles_x_ + tx;
+        uint64_t hash = FinalizeTileHash(states_[index]);
+        dirty = !compare || hash != tile_hashes_[index];
+        tile_hashes_[index] = hash;
+        if (dirty) {
+          ++info_.dirty_tiles;
+        }
+      }
+
+      if (dirty && run_start < 0) {
+        run_start = tx;
+      } else if (!dirty && run_start >= 0) {
+        DirtyRect rect;
+        rect.x = run_start * kTileSize;
+        rect.y = ty * kTileSize;
+        rect.w = std::min(tx * kTileSize, width_) - rect.x;
+        rect.h = std::min((ty + 1) * kTileSize, height_) - rect.y;
+        info_.dirty_rects.push_back(rect);
+        run_start = -1;
+      }
+    }
+  }
+
+  info_.full_update = !has_history_;
+  has_history_ = true;
+  return info_;
+}
+
+void FrameChangeDetector::Reset() {
+  has_history_ = false;
+}
+
+bool FrameChangeDetector::SetupLayout(const AVFrame* frame) {
+  AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+  if (frame->width <= 0 || frame->height <= 0) {
+    return false;
+  }
+  if (format == format_ && frame->width == width_ &&
+      frame->height == height_) {
+    return true;
+  }
+
+  has_history_ = false;
+  width_ = frame->width;
+  height_ = frame->height;
+  format_ = format;
+
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL) ||
+      (desc->flags & AV_PIX_FMT_FLAG_PAL)) {
+    format_ = AV_PIX_FMT_NONE;
+    return false;
+  }
+
+  int linesizes[4] = {};
+  if (av_image_fill_linesizes(linesizes, format, width_) < 0) {
+    format_ = AV_PIX_FMT_NONE;
+    return false;
+  }
+
+  plane_count_ = av_pix_fmt_count_planes(format);
+  for (int plane = 0; plane < plane_count_; ++plane) {
+    bool is_chroma = (plane == 1 || plane == 2) &&
+                     !(desc->flags & AV_PIX_FMT_FLAG_RGB);
+    plane_row_bytes_[plane] = linesizes[plane];
+    plane_rows_[plane] =
+        is_chroma ? AV_CEIL_RSHIFT(height_, desc->log2_chroma_h) : height_;
+  }
+
+  tiles_x_ = (width_ + kTileSize - 1) / kTileSize;
+  tiles_y_ = (height_ + kTileSize - 1) / kTileSize;
+  states_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, TileHashState{});
+  tile_hashes_.assign(states_.size(), 0);
+  return true;
+}
+
+}  // namespace zenplay
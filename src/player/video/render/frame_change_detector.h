@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "player/video/render/tile_hash.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 静态帧检测器 - 按图块哈希比较相邻两帧
+ *
+ * 录屏、幻灯片等内容大量连续帧完全相同或只有小块区域变化，
+ * 每帧整幅上传纹理浪费带宽。检测器把画面切成 kTileSize 见方的图块，
+ * 对每个图块的所有平面数据计算 SIMD 哈希，与上一帧比较得到：
+ * - 完全未变化：渲染器可以跳过纹理上传
+ * - 部分变化：只上传变化的图块（同一行相邻图块合并为一个矩形）
+ *
+ * @note 仅支持 CPU 内存中的帧，硬件帧总是返回需要整帧更新
+ * @note 非线程安全，应在渲染线程中使用
+ */
+class FrameChangeDetector {
+ public:
+  static constexpr int kTileSize = 64;
+
+  /**
+   * @brief 变化区域（亮度平面像素坐标）
+   */
+  struct DirtyRect {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+  };
+
+  struct ChangeInfo {
+    bool full_update = true;  // 首帧、尺寸/格式变化或不支持的格式
+    int total_tiles = 0;
+    int dirty_tiles = 0;
+    std::vector<DirtyRect> dirty_rects;
+
+    bool IsUnchanged() const { return !full_update && dirty_tiles == 0; }
+  };
+
+  FrameChangeDetector() = default;
+
+  /**
+   * @brief 分析一帧相对上一帧的变化
+   * @return 变化信息，引用在下一次调用 Analyze() 前有效
+   */
+  const ChangeInfo& Analyze(const AVFrame* frame);
+
+  /**
+   * @brief 丢弃历史哈希（纹理重建、Seek 等场景），下一帧视为整帧更新
+   */
+  void Reset();
+
+ private:
+  bool SetupLayout(const AVFrame* frame);
+
+  // 当前帧布局
+  int width_ = 0;
+  int height_ = 0;
+  AVPixelFormat format_ = AV_PIX_FMT_NONE;
+  int tiles_x_ = 0;
+  int tiles_y_ = 0;
+  int plane_count_ = 0;
+  int plane_row_bytes_[4] = {};
+  int plane_rows_[4] = {};
+
+  std::vector<TileHashState> states_;  // 当前帧累加状态
+  std::vector<uint64_t> tile_hashes_;  // 上一帧图块哈希
+  bool has_history_ = false;
+
+  ChangeInfo info_;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,277 @@
+#include "player/video/render/impl/opengl/gl_context.h"
+
+#include <EGL/eglext.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+Result<void> EGLErrorToResult(const std::string& operation) {
+  EGLint error = eglGetError();
+  char code[16];
+  std::snprintf(code, sizeof(code), "0x%04X", static_cast<unsigned>(error));
+  return Result<void>::Err(ErrorCode::kRenderError,
+                           operation + " failed (EGL error " + code + ")");
+}
+
+bool HasExtension(const char* extensions, const char* name) {
+  if (!extensions) {
+    return false;
+  }
+  size_t length = std::strlen(name);
+  for (const char* p = std::strstr(extensions, name); p;
+       p = std::strstr(p + length, name)) {
+    bool starts = p == extensions || p[-1] == ' ';
+    bool ends = p[length] == ' ' || p[length] == '\0';
+    if (starts && ends) {
+      return true;
+    }
+  }
+  return false;
+}
+
+EGLDisplay GetSurfacelessDisplay() {
+  const char* client_extensions =
+      eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (!HasExtension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+    return EGL_NO_DISPLAY;
+  }
+  auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+      eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (!get_platform_display) {
+    return EGL_NO_DISPLAY;
+  }
+  return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA,
+                              EGL_DEFAULT_DISPLAY, nullptr);
+}
+
+}  // namespace
+
+GLContext::GLContext() = default;
+
+GLContext::~GLContext() {
+  Cleanup();
+}
+
+bool GLContext::IsAvailable(bool surfaceless) {
+  EGLDisplay display = surfaceless ? GetSurfacelessDisplay()
+                                   : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (display == EGL_NO_DISPLAY) {
+    return false;
+  }
+  EGLint major = 0;
+  EGLint minor = 0;
+  if (!eglInitialize(display, &major, &minor)) {
+    return false;
+  }
+
+  const EGLint attribs[] = {EGL_SURFACE_TYPE,
+                            surfaceless ? 0 : EGL_WINDOW_BIT,
+                            EGL_RENDERABLE_TYPE,
+                            EGL_OPENGL_ES3_BIT,
+                            EGL_NONE};
+  EGLConfig config = nullptr;
+  EGLint count = 0;
+  bool available =
+      eglChooseConfig(display, attribs, &config, 1, &count) && count > 0;
+  if (available && surfaceless) {
+    available = HasExtension(eglQueryString(display, EGL_EXTENSIONS),
+                             "EGL_KHR_surfaceless_context");
+  }
+  eglTerminate(display);
+  return available;
+}
+
+Result<void> GLContext::Initialize(void* window_handle,
+                                   int width,
+                                   int height,
+                                   bool surfaceless) {
+  surfaceless = surfaceless || !window_handle;
+
+  auto display_result = InitDisplay(surfaceless);
+  if (!display_result.IsOk()) {
+    return display_result;
+  }
+
+  // 窗口模式需要可绘制到窗口的配置；离屏模式只需要 ES3
+  const EGLint surface_type = surfaceless ? 0 : EGL_WINDOW_BIT;
+  const EGLint config_attribs[] = {EGL_SURFACE_TYPE,
+                                   surface_type,
+                                   EGL_RENDERABLE_TYPE,
+                                   EGL_OPENGL_ES3_BIT,
+                                   EGL_RED_SIZE,
+                                   8,
+                                   EGL_GREEN_SIZE,
+                                   8,
+                                   EGL_BLUE_SIZE,
+                                   8,
+                                   EGL_NONE};
+  EGLint count = 0;
+  if (!eglChooseConfig(display_, config_attribs, &config_, 1, &count) ||
+      count == 0) {
+    return EGLErrorToResult("eglChooseConfig (OpenGL ES 3.0)");
+  }
+
+  if (!eglBindAPI(EGL_OPENGL_ES_API)) {
+    return EGLErrorToResult("eglBindAPI");
+  }
+
+  const EGLint context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION, 3,
+                                    EGL_CONTEXT_MINOR_VERSION, 0, EGL_NONE};
+  context_ =
+      eglCreateContext(display_, config_, EGL_NO_CONTEXT, context_attribs);
+  if (context_ == EGL_NO_CONTEXT) {
+    return EGLErrorToResult("eglCreateContext");
+  }
+
+  if (!surfaceless) {
+    auto native_window = static_cast<EGLNativeWindowType>(
+        reinterpret_cast<uintptr_t>(window_handle));
+    surface_ =
+        eglCreateWindowSurface(display_, config_, native_window, nullptr);
+    if (surface_ == EGL_NO_SURFACE) {
+      return EGLErrorToResult("eglCreateWindowSurface");
+    }
+  }
+
+  if (!MakeCurrent()) {
+    return EGLErrorToResult("eglMakeCurrent");
+  }
+
+  if (surfaceless) {
+    auto target_result = CreateOffscreenTarget(width, height);
+    if (!target_result.IsOk()) {
+      return target_result;
+    }
+  }
+
+  MODULE_INFO(LOG_MODULE_RENDERER, "OpenGL context ready: {} / {} ({})",
+              reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+              reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+              surfaceless ? "surfaceless" : "window");
+  return Result<void>::Ok();
+}
+
+Result<void> GLContext::InitDisplay(bool surfaceless) {
+  display_ = surfaceless ? GetSurfacelessDisplay()
+                         : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (display_ == EGL_NO_DISPLAY) {
+    return Result<void>::Err(
+        ErrorCode::kRenderError,
+        surfaceless ? "EGL surfaceless platform not supported"
+                    : "No default EGL display");
+  }
+
+  EGLint major = 0;
+  EGLint minor = 0;
+  if (!eglInitialize(display_, &major, &minor)) {
+    display_ = EGL_NO_DISPLAY;
+    return EGLErrorToResult("eglInitialize");
+  }
+
+  if (surfaceless &&
+      !HasExtension(eglQueryString(display_, EGL_EXTENSIONS),
+                    "EGL_KHR_surfaceless_context")) {
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             "EGL_KHR_surfaceless_context not supported");
+  }
+
+  MODULE_DEBUG(LOG_MODULE_RENDERER, "EGL {}.{} initialized ({})", major, minor,
+               eglQueryString(display_, EGL_VENDOR));
+  return Result<void>::Ok();
+}
+
+bool GLContext::MakeCurrent() {
+  if (context_ == EGL_NO_CONTEXT) {
+    return false;
+  }
+  if (eglGetCurrentContext() == context_) {
+    return true;
+  }
+  return eglMakeCurrent(display_, surface_, surface_, context_) == EGL_TRUE;
+}
+
+void GLContext::BindDrawTarget() {
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo_);  // 窗口模式下 fbo_ 为 0
+}
+
+bool GLContext::Resize(int width, int height) {
+  if (!is_surfaceless()) {
+    return true;  // 窗口表面随窗口大小变化
+  }
+  DestroyOffscreenTarget();
+  return CreateOffscreenTarget(width, height).IsOk();
+}
+
+void GLContext::SwapBuffers() {
+  if (is_surfaceless()) {
+    glFlush();
+  } else {
+    eglSwapBuffers(display_, surface_);
+  }
+}
+
+void GLContext::SetSwapInterval(int interval) {
+  if (!is_surfaceless()) {
+    eglSwapInterval(display_, interval);
+  }
+}
+
+Result<void> GLContext::CreateOffscreenTarget(int width, int height) {
+  glGenRenderbuffers(1, &color_buffer_);
+  glBindRenderbuffer(GL_RENDERBUFFER, color_buffer_);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+  glGenFramebuffers(1, &fbo_);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, color_buffer_);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    DestroyOffscreenTarget();
+    return Result<void>::Err(ErrorCode::kInvalidRenderTarget,
+                             "Offscreen framebuffer incomplete");
+  }
+  return Result<void>::Ok();
+}
+
+void GLContext::DestroyOffscreenTarget() {
+  if (fbo_) {
+    glDeleteFramebuffers(1, &fbo_);
+    fbo_ = 0;
+  }
+  if (color_buffer_) {
+    glDeleteRenderbuffers(1, &color_buffer_);
+    color_buffer_ = 0;
+  }
+}
+
+void GLContext::Cleanup() {
+  if (display_ == EGL_NO_DISPLAY) {
+    return;
+  }
+
+  if (context_ != EGL_NO_CONTEXT) {
+    MakeCurrent();
+    DestroyOffscreenTarget();
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display_, context_);
+    context_ = EGL_NO_CONTEXT;
+  }
+  if (surface_ != EGL_NO_SURFACE) {
+    eglDestroySurface(display_, surface_);
+    surface_ = EGL_NO_SURFACE;
+  }
+  eglTerminate(display_);
+  display_ = EGL_NO_DISPLAY;
+
+  MODULE_DEBUG(LOG_MODULE_RENDERER, "GLContext cleaned up");
+}
+
+}  // namespace zenplay
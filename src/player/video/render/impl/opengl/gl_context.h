@@ -0,0 +1,91 @@
+#pragma once
+
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+
+#include "player/common/error.h"
+
+namespace zenplay {
+
+/**
+ * @brief EGL + OpenGL ES 3.0 上下文
+ *
+ * 两种绘制目标：
+ * 1. 窗口：从原生窗口句柄（X11 Window）创建 EGL 窗口表面，SwapBuffers 呈现
+ * 2. 无表面（surfaceless）：EGL_MESA_platform_surfaceless 平台，不需要
+ *    显示服务器；绘制到离屏 FBO，用于 CI（Mesa llvmpipe）和无窗口渲染
+ *
+ * @note 所有方法须在同一线程调用（RendererProxy 保证在 UI 线程）
+ */
+class GLContext {
+ public:
+  GLContext();
+  ~GLContext();
+
+  GLContext(const GLContext&) = delete;
+  GLContext& operator=(const GLContext&) = delete;
+
+  /**
+   * @brief 检测本机能否创建 OpenGL ES 3.0 上下文（不创建窗口）
+   * @param surfaceless 是否检测无表面平台
+   */
+  static bool IsAvailable(bool surfaceless);
+
+  /**
+   * @brief 创建上下文并设为当前
+   * @param window_handle 原生窗口句柄；为 nullptr 或 surfaceless 为 true 时
+   *                      使用无表面平台 + 离屏 FBO
+   * @param width 绘制目标宽度（离屏 FBO 大小）
+   * @param height 绘制目标高度
+   */
+  Result<void> Initialize(void* window_handle,
+                          int width,
+                          int height,
+                          bool surfaceless);
+
+  /**
+   * @brief 确保上下文在当前线程为当前上下文
+   */
+  bool MakeCurrent();
+
+  /**
+   * @brief 绑定绘制目标（窗口默认帧缓冲或离屏 FBO）
+   */
+  void BindDrawTarget();
+
+  /**
+   * @brief 调整离屏 FBO 大小（窗口模式下由窗口系统处理）
+   */
+  bool Resize(int width, int height);
+
+  /**
+   * @brief 呈现：窗口模式交换缓冲区，离屏模式等待绘制提交
+   */
+  void SwapBuffers();
+
+  /**
+   * @brief 设置垂直同步（仅窗口模式有效）
+   */
+  void SetSwapInterval(int interval);
+
+  void Cleanup();
+
+  bool is_surfaceless() const { return surface_ == EGL_NO_SURFACE; }
+  bool is_initialized() const { return context_ != EGL_NO_CONTEXT; }
+
+ private:
+  Result<void> InitDisplay(bool surfaceless);
+  Result<void> CreateOffscreenTarget(int width, int height);
+  void DestroyOffscreenTarget();
+
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  EGLConfig config_ = nullptr;
+  EGLContext context_ = EGL_NO_CONTEXT;
+  EGLSurface surface_ = EGL_NO_SURFACE;
+
+  // 离屏绘制目标（surfaceless 模式）
+  GLuint fbo_ = 0;
+  GLuint color_buffer_ = 0;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,180 @@
+#include "player/video/render/impl/opengl/gl_frame_uploader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "player/common/log_manager.h"
+
+extern "C" {
+#include <libavutil/common.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace zenplay {
+
+GLFrameUploader::~GLFrameUploader() {
+  Cleanup();
+}
+
+bool GLFrameUploader::IsSupportedFormat(AVPixelFormat format) {
+  switch (format) {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_YUV422P:
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUVJ444P:
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_NV21:
+      return true;
+    default:
+      return false;
+  }
+}
+
+Result<void> GLFrameUploader::Configure(AVPixelFormat format,
+                                        int width,
+                                        int height) {
+  Cleanup();
+
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (!desc || !IsSupportedFormat(format)) {
+    return Result<void>::Err(ErrorCode::kNotSupported,
+                             "Unsupported upload format");
+  }
+
+  const int chroma_width = AV_CEIL_RSHIFT(width, desc->log2_chroma_w);
+  const int chroma_height = AV_CEIL_RSHIFT(height, desc->log2_chroma_h);
+  const bool semi_planar =
+      format == AV_PIX_FMT_NV12 || format == AV_PIX_FMT_NV21;
+
+  layout_ = format == AV_PIX_FMT_NV12   ? GLPlaneLayout::kNV12
+            : format == AV_PIX_FMT_NV21 ? GLPlaneLayout::kNV21
+                                        : GLPlaneLayout::kPlanar;
+  plane_count_ = semi_planar ? 2 : 3;
+
+  frame_bytes_ = 0;
+  for (int i = 0; i < plane_count_; ++i) {
+    Plane& plane = planes_[i];
+    const int channels = semi_planar && i == 1 ? 2 : 1;
+    plane.width = i == 0 ? width : chroma_width;
+    plane.height = i == 0 ? height : chroma_height;
+    plane.row_bytes = plane.width * channels;
+    plane.offset = frame_bytes_;
+    frame_bytes_ += static_cast<size_t>(plane.row_bytes) * plane.height;
+
+    glGenTextures(1, &plane.texture);
+    glBindTexture(GL_TEXTURE_2D, plane.texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, channels == 2 ? GL_RG8 : GL_R8,
+                   plane.width, plane.height);
+    // GPU 缩放：双线性采样
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  }
+
+  glGenBuffers(static_cast<GLsizei>(kPboCount), pbos_.data());
+  for (GLuint pbo : pbos_) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(frame_bytes_),
+                 nullptr, GL_STREAM_DRAW);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  pbo_index_ = 0;
+
+  GLenum error = glGetError();
+  if (error != GL_NO_ERROR) {
+    Cleanup();
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             "Failed to create upload textures (GL error " +
+                                 std::to_string(error) + ")");
+  }
+
+  MODULE_INFO(LOG_MODULE_RENDERER,
+              "OpenGL upload configured: {} {}x{}, {} planes, {} KB x {} PBOs",
+              av_get_pix_fmt_name(format), width, height, plane_count_,
+              frame_bytes_ / 1024, kPboCount);
+  return Result<void>::Ok();
+}
+
+bool GLFrameUploader::Upload(const AVFrame* frame) {
+  if (plane_count_ == 0) {
+    return false;
+  }
+
+  GLuint pbo = pbos_[pbo_index_];
+  pbo_index_ = (pbo_index_ + 1) % kPboCount;
+
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+  // 丢弃旧内容：驱动可直接换一块存储，不等待仍在进行的传输
+  auto* mapped = static_cast<uint8_t*>(glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(frame_bytes_),
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  if (!mapped) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to map PBO");
+    return false;
+  }
+
+  for (int i = 0; i < plane_count_; ++i) {
+    const Plane& plane = planes_[i];
+    const uint8_t* src = frame->data[i];
+    uint8_t* dst = mapped + plane.offset;
+    if (frame->linesize[i] == plane.row_bytes) {
+      std::memcpy(dst, src,
+                  static_cast<size_t>(plane.row_bytes) * plane.height);
+      continue;
+    }
+    for (int row = 0; row < plane.height; ++row) {
+      std::memcpy(dst, src, plane.row_bytes);
+      dst += plane.row_bytes;
+      src += frame->linesize[i];
+    }
+  }
+
+  if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_TRUE) {
+    // 映射期间存储内容失效（极少见），本帧放弃
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return false;
+  }
+
+  // PBO 中按行紧密排列；数据指针参数是 PBO 内偏移
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  for (int i = 0; i < plane_count_; ++i) {
+    const Plane& plane = planes_[i];
+    glBindTexture(GL_TEXTURE_2D, plane.texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, plane.width, plane.height,
+                    plane.row_bytes == plane.width ? GL_RED : GL_RG,
+                    GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void*>(plane.offset));
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  return true;
+}
+
+void GLFrameUploader::BindTextures() const {
+  for (int i = 0; i < plane_count_; ++i) {
+    glActiveTexture(GL_TEXTURE0 + i);
+    glBindTexture(GL_TEXTURE_2D, planes_[i].texture);
+  }
+  glActiveTexture(GL_TEXTURE0);
+}
+
+void GLFrameUploader::Cleanup() {
+  for (Plane& plane : planes_) {
+    if (plane.texture) {
+      glDeleteTextures(1, &plane.texture);
+    }
+    plane = Plane{};
+  }
+  if (pbos_[0]) {
+    glDeleteBuffers(static_cast<GLsizei>(kPboCount), pbos_.data());
+    pbos_.fill(0);
+  }
+  plane_count_ = 0;
+  frame_bytes_ = 0;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include <array>
+#include <cstddef>
+
+#include "player/common/error.h"
+#include "player/video/render/impl/opengl/gl_shader.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief 通过像素缓冲对象（PBO）流式上传 YUV 平面
+ *
+ * 每个平面一张 GL_R8 / GL_RG8 纹理，尺寸按色度采样计算。上传时把帧数据
+ * 拷贝进映射的 PBO，再由 glTexSubImage2D 从 PBO 读取：拷贝由驱动异步完成，
+ * 渲染线程不等待 GPU。多个 PBO 轮流使用，映射的总是 GPU 已经用完的那个，
+ * 避免与上一帧的传输同步。
+ *
+ * @note OpenGL ES 3.0 没有持久映射（需要 EXT_buffer_storage），
+ *       这里用轮换 + GL_MAP_INVALIDATE_BUFFER_BIT 达到同样的无等待效果
+ */
+class GLFrameUploader {
+ public:
+  static constexpr size_t kPboCount = 2;
+  static constexpr int kMaxPlanes = 3;
+
+  GLFrameUploader() = default;
+  ~GLFrameUploader();
+
+  GLFrameUploader(const GLFrameUploader&) = delete;
+  GLFrameUploader& operator=(const GLFrameUploader&) = delete;
+
+  /**
+   * @brief 是否可以直接上传（8 位平面 YUV、NV12、NV21）
+   */
+  static bool IsSupportedFormat(AVPixelFormat format);
+
+  /**
+   * @brief 按格式和尺寸创建纹理与 PBO
+   */
+  Result<void> Configure(AVPixelFormat format, int width, int height);
+
+  /**
+   * @brief 上传一帧（格式和尺寸须与 Configure 一致）
+   */
+  bool Upload(const AVFrame* frame);
+
+  /**
+   * @brief 把平面纹理绑定到纹理单元 0..2
+   */
+  void BindTextures() const;
+
+  void Cleanup();
+
+  GLPlaneLayout layout() const { return layout_; }
+  size_t frame_bytes() const { return frame_bytes_; }
+
+ private:
+  struct Plane {
+    GLuint texture = 0;
+    int width = 0;       // 纹素
+    int height = 0;      // 行数
+    int row_bytes = 0;   // 每行有效字节
+    size_t offset = 0;   // 在 PBO 中的偏移
+  };
+
+  GLPlaneLayout layout_ = GLPlaneLayout::kPlanar;
+  int plane_count_ = 0;
+  std::array<Plane, kMaxPlanes> planes_;
+  std::array<GLuint, kPboCount> pbos_ = {};
+  size_t pbo_index_ = 0;
+  size_t frame_bytes_ = 0;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,127 @@
+#include "player/video/render/impl/opengl/gl_overlay.h"
+
+#include <string>
+
+#include "player/common/log_manager.h"
+#include "player/video/render/impl/opengl/gl_shader.h"
+#include "player/video/render/stats_overlay.h"
+
+namespace zenplay {
+
+namespace {
+
+constexpr const char* kFragmentShaderSource = R"(#version 300 es
+precision mediump float;
+in vec2 v_texcoord;
+out vec4 frag_color;
+uniform sampler2D u_overlay;
+void main() {
+  frag_color = texture(u_overlay, v_texcoord);
+}
+)";
+
+// 距绘制目标左上角的边距（像素，与 SDLRenderer 一致）
+constexpr int kMargin = 8;
+
+}  // namespace
+
+GLOverlay::~GLOverlay() {
+  Cleanup();
+}
+
+Result<void> GLOverlay::Initialize() {
+  GLuint vertex_shader = GLShader::CompileShader(
+      GL_VERTEX_SHADER, GLShader::VertexShaderSource());
+  GLuint fragment_shader =
+      GLShader::CompileShader(GL_FRAGMENT_SHADER, kFragmentShaderSource);
+  if (!vertex_shader || !fragment_shader) {
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             "Failed to compile overlay shaders");
+  }
+
+  program_ = glCreateProgram();
+  glAttachShader(program_, vertex_shader);
+  glAttachShader(program_, fragment_shader);
+  glLinkProgram(program_);
+  glDeleteShader(vertex_shader);
+  glDeleteShader(fragment_shader);
+
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program_, GL_LINK_STATUS, &linked);
+  if (!linked) {
+    char log[512] = {};
+    glGetProgramInfoLog(program_, sizeof(log), nullptr, log);
+    Cleanup();
+    return Result<void>::Err(
+        ErrorCode::kRenderError,
+        std::string("Failed to link overlay program: ") + log);
+  }
+
+  glUseProgram(program_);
+  glUniform1i(glGetUniformLocation(program_, "u_overlay"), 0);
+  return Result<void>::Ok();
+}
+
+void GLOverlay::Upload(const OverlayImage& image) {
+  if (!program_ || image.pixels.empty()) {
+    visible_ = false;
+    return;
+  }
+
+  glActiveTexture(GL_TEXTURE0);
+  if (!texture_) {
+    glGenTextures(1, &texture_);
+  }
+  glBindTexture(GL_TEXTURE_2D, texture_);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  if (width_ != image.width || height_ != image.height) {
+    // 像素与屏幕一一对应，最近邻采样保持点阵字形清晰
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+    width_ = image.width;
+    height_ = image.height;
+  } else {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RGBA,
+                    GL_UNSIGNED_BYTE, image.pixels.data());
+  }
+  visible_ = glGetError() == GL_NO_ERROR;
+}
+
+void GLOverlay::Draw(int target_width, int target_height) {
+  if (!visible_) {
+    return;
+  }
+
+  // OpenGL 原点在左下角
+  glViewport(kMargin, target_height - kMargin - height_, width_, height_);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glUseProgram(program_);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, texture_);
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  glDisable(GL_BLEND);
+  glViewport(0, 0, target_width, target_height);
+}
+
+void GLOverlay::Cleanup() {
+  if (texture_) {
+    glDeleteTextures(1, &texture_);
+    texture_ = 0;
+  }
+  if (program_) {
+    glDeleteProgram(program_);
+    program_ = 0;
+  }
+  width_ = 0;
+  height_ = 0;
+  visible_ = false;
+}
+
+}  // namespace zenplay
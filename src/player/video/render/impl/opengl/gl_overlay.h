@@ -0,0 +1,55 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include "player/common/error.h"
+
+namespace zenplay {
+
+struct OverlayImage;
+
+/**
+ * @brief 叠加层（屏幕统计浮层）的纹理与绘制程序
+ *
+ * 图像变化时（每秒至多几次）整张上传到一个 RGBA 纹理；每帧在绘制目标
+ * 左上角开一个与图像等大的视口，按 alpha 混合画一个矩形。
+ */
+class GLOverlay {
+ public:
+  GLOverlay() = default;
+  ~GLOverlay();
+
+  GLOverlay(const GLOverlay&) = delete;
+  GLOverlay& operator=(const GLOverlay&) = delete;
+
+  /**
+   * @brief 编译并链接着色器程序
+   * @note 需要当前线程已有 OpenGL ES 3.0 上下文
+   */
+  Result<void> Initialize();
+
+  /**
+   * @brief 上传新图像并显示；尺寸不变时只更新纹理内容
+   */
+  void Upload(const OverlayImage& image);
+
+  void Hide() { visible_ = false; }
+  bool visible() const { return visible_; }
+
+  /**
+   * @brief 混合绘制到当前绘制目标左上角
+   * @note 调用方已绑定绘制目标和顶点数组；返回时恢复整个目标的视口
+   */
+  void Draw(int target_width, int target_height);
+
+  void Cleanup();
+
+ private:
+  GLuint program_ = 0;
+  GLuint texture_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  bool visible_ = false;
+};
+
+}  // namespace zenplay
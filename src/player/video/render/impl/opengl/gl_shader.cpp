@@ -0,0 +1,177 @@
+#include "player/video/render/impl/opengl/gl_shader.h"
+
+#include <string>
+
+#include "player/common/log_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+// 两个三角形（三角形带）覆盖整个视口；纹理第 0 行在画面顶部
+constexpr const char* kVertexShaderSource = R"(#version 300 es
+out vec2 v_texcoord;
+void main() {
+  vec2 pos = vec2(float(gl_VertexID & 1), float((gl_VertexID >> 1) & 1));
+  v_texcoord = vec2(pos.x, 1.0 - pos.y);
+  gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+constexpr const char* kFragmentShaderSource = R"(#version 300 es
+precision highp float;
+in vec2 v_texcoord;
+out vec4 frag_color;
+uniform sampler2D u_plane0;
+uniform sampler2D u_plane1;
+uniform sampler2D u_plane2;
+uniform int u_layout;
+uniform mat3 u_yuv_to_rgb;
+uniform vec3 u_offset;
+void main() {
+  float y = texture(u_plane0, v_texcoord).r;
+  vec2 uv;
+  if (u_layout == 0) {
+    uv = vec2(texture(u_plane1, v_texcoord).r, texture(u_plane2, v_texcoord).r);
+  } else if (u_layout == 1) {
+    uv = texture(u_plane1, v_texcoord).rg;
+  } else {
+    uv = texture(u_plane1, v_texcoord).gr;
+  }
+  vec3 rgb = u_yuv_to_rgb * (vec3(y, uv) - u_offset);
+  frag_color = vec4(clamp(rgb, 0.0, 1.0), 1.0);
+}
+)";
+
+}  // namespace
+
+GLShader::~GLShader() {
+  Cleanup();
+}
+
+Result<void> GLShader::Initialize() {
+  GLuint vertex_shader = CompileShader(GL_VERTEX_SHADER, kVertexShaderSource);
+  GLuint fragment_shader =
+      CompileShader(GL_FRAGMENT_SHADER, kFragmentShaderSource);
+  if (!vertex_shader || !fragment_shader) {
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             "Failed to compile YUV shaders");
+  }
+
+  program_ = glCreateProgram();
+  glAttachShader(program_, vertex_shader);
+  glAttachShader(program_, fragment_shader);
+  glLinkProgram(program_);
+  glDeleteShader(vertex_shader);
+  glDeleteShader(fragment_shader);
+
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program_, GL_LINK_STATUS, &linked);
+  if (!linked) {
+    char log[512] = {};
+    glGetProgramInfoLog(program_, sizeof(log), nullptr, log);
+    Cleanup();
+    return Result<void>::Err(ErrorCode::kRenderError,
+                             std::string("Failed to link YUV program: ") + log);
+  }
+
+  // 纹理单元固定：0=Y，1=U / UV，2=V
+  glUseProgram(program_);
+  glUniform1i(glGetUniformLocation(program_, "u_plane0"), 0);
+  glUniform1i(glGetUniformLocation(program_, "u_plane1"), 1);
+  glUniform1i(glGetUniformLocation(program_, "u_plane2"), 2);
+  layout_location_ = glGetUniformLocation(program_, "u_layout");
+  matrix_location_ = glGetUniformLocation(program_, "u_yuv_to_rgb");
+  offset_location_ = glGetUniformLocation(program_, "u_offset");
+
+  MODULE_DEBUG(LOG_MODULE_RENDERER, "OpenGL YUV shader program linked");
+  return Result<void>::Ok();
+}
+
+void GLShader::Use(GLPlaneLayout layout,
+                   AVColorSpace color_space,
+                   bool full_range,
+                   int height) {
+  // 亮度系数 Kr / Kb
+  float kr = 0.299f;
+  float kb = 0.114f;
+  switch (color_space) {
+    case AVCOL_SPC_BT709:
+      kr = 0.2126f;
+      kb = 0.0722f;
+      break;
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL:
+      kr = 0.2627f;
+      kb = 0.0593f;
+      break;
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M:
+      break;
+    default:
+      // 未标注：高清内容通常是 BT.709
+      if (height >= 720) {
+        kr = 0.2126f;
+        kb = 0.0722f;
+      }
+      break;
+  }
+  const float kg = 1.0f - kr - kb;
+
+  // limited range：Y 16-235，UV 16-240
+  const float y_scale = full_range ? 1.0f : 255.0f / 219.0f;
+  const float c_scale = full_range ? 1.0f : 255.0f / 224.0f;
+  const float y_offset = full_range ? 0.0f : 16.0f / 255.0f;
+  const float c_offset = 128.0f / 255.0f;
+
+  // 列主序：每列对应 Y / U / V 对 RGB 的贡献
+  const GLfloat matrix[9] = {
+      y_scale,
+      y_scale,
+      y_scale,
+      0.0f,
+      -2.0f * (1.0f - kb) * kb / kg * c_scale,
+      2.0f * (1.0f - kb) * c_scale,
+      2.0f * (1.0f - kr) * c_scale,
+      -2.0f * (1.0f - kr) * kr / kg * c_scale,
+      0.0f,
+  };
+
+  glUseProgram(program_);
+  glUniform1i(layout_location_, static_cast<GLint>(layout));
+  glUniformMatrix3fv(matrix_location_, 1, GL_FALSE, matrix);
+  glUniform3f(offset_location_, y_offset, c_offset, c_offset);
+}
+
+const char* GLShader::VertexShaderSource() {
+  return kVertexShaderSource;
+}
+
+void GLShader::Cleanup() {
+  if (program_) {
+    glDeleteProgram(program_);
+    program_ = 0;
+  }
+}
+
+GLuint GLShader::CompileShader(GLenum type, const char* source) {
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &source, nullptr);
+  glCompileShader(shader);
+
+  GLint compiled = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+  if (!compiled) {
+    char log[512] = {};
+    glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+    MODULE_ERROR(LOG_MODULE_RENDERER, "{} shader compile error: {}",
+                 type == GL_VERTEX_SHADER ? "Vertex" : "Fragment", log);
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+
+#include "player/common/error.h"
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+namespace zenplay {
+
+/**
+ * @brief YUV 平面布局（决定片元着色器如何取色度）
+ */
+enum class GLPlaneLayout {
+  kPlanar,  // Y + U + V 三个单通道纹理（任意色度采样）
+  kNV12,    // Y + UV 交错双通道纹理
+  kNV21,    // Y + VU 交错双通道纹理
+};
+
+/**
+ * @brief YUV→RGB 转换的 OpenGL ES 3.0 着色器
+ *
+ * 顶点着色器按 gl_VertexID 生成覆盖视口的矩形（不需要顶点缓冲），
+ * 缩放由视口和纹理双线性采样完成；片元着色器按帧的色彩空间
+ * （BT.601 / BT.709 / BT.2020）和取值范围（limited / full）做矩阵转换。
+ */
+class GLShader {
+ public:
+  GLShader() = default;
+  ~GLShader();
+
+  GLShader(const GLShader&) = delete;
+  GLShader& operator=(const GLShader&) = delete;
+
+  /**
+   * @brief 编译并链接着色器程序
+   * @note 需要当前线程已有 OpenGL ES 3.0 上下文
+   */
+  Result<void> Initialize();
+
+  /**
+   * @brief 启用程序并设置平面布局与色彩转换矩阵
+   * @param color_space 帧的色彩空间，未指定时按 height 推断
+   * @param full_range 是否为全范围（JPEG）取值
+   * @param height 帧高度（720 及以上默认 BT.709，否则 BT.601）
+   */
+  void Use(GLPlaneLayout layout,
+           AVColorSpace color_space,
+           bool full_range,
+           int height);
+
+  void Cleanup();
+
+  /**
+   * @brief 编译单个着色器，失败时记录日志并返回 0
+   */
+  static GLuint CompileShader(GLenum type, const char* source);
+
+  /**
+   * @brief 覆盖视口的矩形顶点着色器源码（输出 v_texcoord，纹理第 0 行
+   *        在顶部），叠加层等其它程序共用
+   */
+  static const char* VertexShaderSource();
+
+ private:
+
+  GLuint program_ = 0;
+  GLint layout_location_ = -1;
+  GLint matrix_location_ = -1;
+  GLint offset_location_ = -1;
+};
+
+}  // namespace zenplay
@@ -0,0 +1,371 @@
+#include "player/video/render/impl/opengl/opengl_renderer.h"
+
+#include <algorithm>
+#include <string>
+
+#include "player/common/log_manager.h"
+#include "player/config/global_config.h"
+#include "player/stats/statistics_manager.h"
+#include "player/video/render/impl/opengl/gl_context.h"
+#include "player/video/render/impl/opengl/gl_frame_uploader.h"
+#include "player/video/render/impl/opengl/gl_overlay.h"
+#include "player/video/render/impl/opengl/gl_shader.h"
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+namespace zenplay {
+
+namespace {
+
+bool IsFullRange(const AVFrame* frame) {
+  switch (static_cast<AVPixelFormat>(frame->format)) {
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUVJ444P:
+      return true;
+    default:
+      return frame->color_range == AVCOL_RANGE_JPEG;
+  }
+}
+
+}  // namespace
+
+OpenGLRenderer::OpenGLRenderer()
+    : context_(std::make_unique<GLContext>()),
+      shader_(std::make_unique<GLShader>()),
+      uploader_(std::make_unique<GLFrameUploader>()),
+      overlay_(std::make_unique<GLOverlay>()) {
+  MODULE_INFO(LOG_MODULE_RENDERER, "OpenGLRenderer created");
+}
+
+OpenGLRenderer::~OpenGLRenderer() {
+  Cleanup();
+}
+
+Result<void> OpenGLRenderer::Init(void* window_handle, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return Result<void>::Err(ErrorCode::kInvalidParameter,
+                             "Invalid dimensions: " + std::to_string(width) +
+                                 "x" + std::to_string(height));
+  }
+
+  window_width_ = width;
+  window_height_ = height;
+
+  auto* config = GlobalConfig::Instance();
+  static_frame_detection_ =
+      config->GetBool("render.static_frame_detection", true);
+  bool surfaceless = config->GetBool("render.opengl.surfaceless", false);
+
+  auto context_result =
+      context_->Initialize(window_handle, width, height, surfaceless);
+  if (!context_result.IsOk()) {
+    context_->Cleanup();
+    return context_result;
+  }
+
+  auto shader_result = shader_->Initialize();
+  if (!shader_result.IsOk()) {
+    context_->Cleanup();
+    return shader_result;
+  }
+
+  // 浮层是可选的，失败时只是不显示
+  auto overlay_result = overlay_->Initialize();
+  if (!overlay_result.IsOk()) {
+    MODULE_WARN(LOG_MODULE_RENDERER, "Stats overlay unavailable: {}",
+                overlay_result.FullMessage());
+  }
+
+  // ES 3.0 允许使用默认顶点数组，这里显式创建以兼容严格的驱动
+  glGenVertexArrays(1, &vertex_array_);
+  context_->SetSwapInterval(config->GetBool("render.vsync", true) ? 1 : 0);
+
+  initialized_ = true;
+  MODULE_INFO(LOG_MODULE_RENDERER, "OpenGLRenderer initialized: {}x{} ({})",
+              width, height,
+              context_->is_surfaceless() ? "offscreen" : "window");
+  return Result<void>::Ok();
+}
+
+bool OpenGLRenderer::RenderFrame(AVFrame* frame) {
+  if (!initialized_ || !frame) {
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Cannot render: initialized={}, frame={}",
+                 initialized_, frame ? "valid" : "null");
+    return false;
+  }
+  if (!context_->MakeCurrent()) {
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to make OpenGL context current");
+    return false;
+  }
+
+  if (frame_width_ != frame->width || frame_height_ != frame->height ||
+      src_pixel_format_ != static_cast<AVPixelFormat>(frame->format)) {
+    MODULE_INFO(LOG_MODULE_RENDERER,
+                "Frame properties changed, recreating textures: {}x{} -> {}x{}",
+                frame_width_, frame_height_, frame->width, frame->height);
+    if (!ConfigureUpload(frame)) {
+      return false;
+    }
+  }
+
+  // ✅ 与上一帧完全相同：纹理内容仍然有效，跳过上传
+  bool unchanged = static_frame_detection_ &&
+                   change_detector_.Analyze(frame).IsUnchanged();
+  if (unchanged) {
+    STATS_UPDATE_TEXTURE_UPLOAD(0, uploader_->frame_bytes(), true);
+  } else {
+    AVFrame* upload_frame = PrepareUploadFrame(frame);
+    if (!upload_frame || !uploader_->Upload(upload_frame)) {
+      MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to upload frame");
+      return false;
+    }
+    STATS_UPDATE_TEXTURE_UPLOAD(uploader_->frame_bytes(), 0, false);
+  }
+
+  Clear();
+  DrawFrame(frame);
+  if (overlay_->visible()) {
+    glBindVertexArray(vertex_array_);
+    overlay_->Draw(window_width_, window_height_);
+    glBindVertexArray(0);
+  }
+  Present();
+  return true;
+}
+
+void OpenGLRenderer::Clear() {
+  if (!initialized_) {
+    return;
+  }
+  context_->BindDrawTarget();
+  glViewport(0, 0, window_width_, window_height_);
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);  // Black background
+  glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void OpenGLRenderer::Present() {
+  if (initialized_) {
+    context_->SwapBuffers();
+  }
+}
+
+void OpenGLRenderer::OnResize(int width, int height) {
+  if (width <= 0 || height <= 0) {
+    MODULE_WARN(LOG_MODULE_RENDERER, "Invalid resize dimensions: {}x{}", width,
+                height);
+    return;
+  }
+
+  MODULE_DEBUG(LOG_MODULE_RENDERER, "Renderer resize: {}x{} -> {}x{}",
+               window_width_, window_height_, width, height);
+
+  window_width_ = width;
+  window_height_ = height;
+  if (initialized_ && context_->MakeCurrent()) {
+    context_->Resize(width, height);
+  }
+}
+
+void OpenGLRenderer::Cleanup() {
+  if (converted_frame_) {
+    av_frame_free(&converted_frame_);
+  }
+  if (sws_context_) {
+    sws_freeContext(sws_context_);
+    sws_context_ = nullptr;
+  }
+
+  if (context_->is_initialized() && context_->MakeCurrent()) {
+    uploader_->Cleanup();
+    shader_->Cleanup();
+    overlay_->Cleanup();
+    if (vertex_array_) {
+      glDeleteVertexArrays(1, &vertex_array_);
+      vertex_array_ = 0;
+    }
+  }
+  context_->Cleanup();
+
+  frame_width_ = 0;
+  frame_height_ = 0;
+  src_pixel_format_ = AV_PIX_FMT_NONE;
+  initialized_ = false;
+}
+
+const char* OpenGLRenderer::GetRendererName() const {
+  return "OpenGL Renderer";
+}
+
+void OpenGLRenderer::ClearCaches() {
+  change_detector_.Reset();
+}
+
+void OpenGLRenderer::SetOverlay(const OverlayImage* image) {
+  if (!image) {
+    overlay_->Hide();
+    return;
+  }
+  if (initialized_ && context_->MakeCurrent()) {
+    overlay_->Upload(*image);
+  }
+}
+
+bool OpenGLRenderer::ReadPixels(std::vector<uint8_t>* rgba) {
+  if (!initialized_ || !context_->MakeCurrent()) {
+    return false;
+  }
+
+  const size_t row_bytes = static_cast<size_t>(window_width_) * 4;
+  rgba->resize(row_bytes * window_height_);
+  context_->BindDrawTarget();
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, window_width_, window_height_, GL_RGBA, GL_UNSIGNED_BYTE,
+               rgba->data());
+
+  // OpenGL 原点在左下角，翻转为从上到下
+  std::vector<uint8_t> row(row_bytes);
+  for (int top = 0, bottom = window_height_ - 1; top < bottom;
+       ++top, --bottom) {
+    uint8_t* top_row = rgba->data() + top * row_bytes;
+    uint8_t* bottom_row = rgba->data() + bottom * row_bytes;
+    std::copy(top_row, top_row + row_bytes, row.begin());
+    std::copy(bottom_row, bottom_row + row_bytes, top_row);
+    std::copy(row.begin(), row.end(), bottom_row);
+  }
+  return glGetError() == GL_NO_ERROR;
+}
+
+bool OpenGLRenderer::ConfigureUpload(const AVFrame* frame) {
+  frame_width_ = frame->width;
+  frame_height_ = frame->height;
+  src_pixel_format_ = static_cast<AVPixelFormat>(frame->format);
+
+  // 新纹理内容未定义，下一帧必须整帧上传
+  change_detector_.Reset();
+
+  // 源格式变化后旧的转换上下文和缓冲区都不再适用
+  if (sws_context_) {
+    sws_freeContext(sws_context_);
+    sws_context_ = nullptr;
+  }
+  if (converted_frame_) {
+    av_frame_free(&converted_frame_);
+  }
+
+  fast_conversion_ = PixelConversion::kNone;
+  upload_pixel_format_ = src_pixel_format_;
+  switch (src_pixel_format_) {
+    // ✅ 10 位走 SIMD 快速转换（ES 3.0 没有 16 位归一化纹理）
+    case AV_PIX_FMT_YUV420P10LE:
+      upload_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv420p10ToYuv420p;
+      break;
+    case AV_PIX_FMT_YUV422P10LE:
+      upload_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv422p10ToYuv420p;
+      break;
+    case AV_PIX_FMT_P010LE:
+      upload_pixel_format_ = AV_PIX_FMT_NV12;
+      fast_conversion_ = PixelConversion::kP010ToNv12;
+      break;
+    default:
+      if (!GLFrameUploader::IsSupportedFormat(src_pixel_format_)) {
+        // For unsupported formats, convert to YUV420P
+        upload_pixel_format_ = AV_PIX_FMT_YUV420P;
+      }
+      break;
+  }
+
+  auto result = uploader_->Configure(upload_pixel_format_, frame->width,
+                                     frame->height);
+  if (!result.IsOk()) {
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to configure upload: {}",
+                 result.FullMessage());
+    src_pixel_format_ = AV_PIX_FMT_NONE;  // 下一帧重试
+    return false;
+  }
+
+  if (upload_pixel_format_ != src_pixel_format_) {
+    MODULE_INFO(LOG_MODULE_RENDERER, "Using {} conversion for {} -> {}",
+                fast_conversion_ != PixelConversion::kNone
+                    ? GetPixelConvertImplName()
+                    : "swscale",
+                av_get_pix_fmt_name(src_pixel_format_),
+                av_get_pix_fmt_name(upload_pixel_format_));
+  }
+  return true;
+}
+
+AVFrame* OpenGLRenderer::PrepareUploadFrame(AVFrame* frame) {
+  if (upload_pixel_format_ == src_pixel_format_) {
+    return frame;
+  }
+
+  if (fast_conversion_ == PixelConversion::kNone && !sws_context_) {
+    sws_context_ =
+        sws_getContext(frame->width, frame->height, src_pixel_format_,
+                       frame->width, frame->height, upload_pixel_format_,
+                       SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!sws_context_) {
+      MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to create SWS context");
+      return nullptr;
+    }
+  }
+
+  if (!converted_frame_) {
+    converted_frame_ = av_frame_alloc();
+    if (!converted_frame_) {
+      MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to allocate converted frame");
+      return nullptr;
+    }
+    converted_frame_->format = upload_pixel_format_;
+    converted_frame_->width = frame->width;
+    converted_frame_->height = frame->height;
+    if (av_frame_get_buffer(converted_frame_, 32) < 0) {
+      MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to allocate conversion buffer");
+      av_frame_free(&converted_frame_);
+      return nullptr;
+    }
+  }
+
+  if (fast_conversion_ != PixelConversion::kNone) {
+    ConvertPixels(fast_conversion_, frame->data, frame->linesize,
+                  converted_frame_->data, converted_frame_->linesize,
+                  frame->width, frame->height);
+  } else {
+    sws_scale(sws_context_, frame->data, frame->linesize, 0, frame->height,
+              converted_frame_->data, converted_frame_->linesize);
+  }
+  return converted_frame_;
+}
+
+void OpenGLRenderer::DrawFrame(const AVFrame* frame) {
+  // 保持宽高比居中（与 SDLRenderer::CalculateDisplayRect 一致）
+  float window_aspect = static_cast<float>(window_width_) / window_height_;
+  float frame_aspect = static_cast<float>(frame_width_) / frame_height_;
+  int x = 0;
+  int y = 0;
+  int w = window_width_;
+  int h = window_height_;
+  if (frame_aspect > window_aspect) {
+    h = static_cast<int>(window_width_ / frame_aspect);
+    y = (window_height_ - h) / 2;
+  } else {
+    w = static_cast<int>(window_height_ * frame_aspect);
+    x = (window_width_ - w) / 2;
+  }
+  glViewport(x, y, w, h);
+
+  shader_->Use(uploader_->layout(), frame->colorspace, IsFullRange(frame),
+               frame->height);
+  uploader_->BindTextures();
+  glBindVertexArray(vertex_array_);
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  glBindVertexArray(0);
+}
+
+}  // namespace zenplay
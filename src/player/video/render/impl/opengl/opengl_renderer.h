@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "player/video/render/frame_change_detector.h"
+#include "player/video/render/pixel_convert.h"
+#include "player/video/render/renderer.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+struct SwsContext;
+
+namespace zenplay {
+
+// 前置声明 - OpenGL 组件类（只用到指针，不需要完整定义）
+class GLContext;
+class GLShader;
+class GLFrameUploader;
+class GLOverlay;
+
+/**
+ * @brief OpenGL ES 3.0 渲染器（Linux，EGL）
+ *
+ * 特性：
+ * 1. PBO 流式上传：Y / UV 平面经轮换的像素缓冲对象异步传到纹理
+ * 2. GPU YUV→RGB 转换：片元着色器按帧的色彩空间和取值范围转换
+ * 3. GPU 缩放：视口保持宽高比，纹理双线性采样
+ * 4. 无表面模式：没有窗口句柄或 render.opengl.surfaceless 为 true 时
+ *    通过 EGL_MESA_platform_surfaceless 绘制到离屏 FBO（CI 使用 llvmpipe）
+ *
+ * 8 位 4:2:0 / 4:2:2 / 4:4:4 平面格式与 NV12 / NV21 直接上传；10 位格式
+ * 先经 SIMD 快速路径转为 8 位，其余格式由 swscale 转为 YUV420P。
+ */
+class OpenGLRenderer : public Renderer {
+ public:
+  OpenGLRenderer();
+  ~OpenGLRenderer() override;
+
+  /**
+   * @brief 初始化渲染器
+   * @param window_handle 原生窗口句柄（X11 Window），nullptr 表示离屏绘制
+   */
+  Result<void> Init(void* window_handle, int width, int height) override;
+
+  /**
+   * @brief 渲染一帧（上传、转换、缩放并呈现）
+   */
+  bool RenderFrame(AVFrame* frame) override;
+
+  void Clear() override;
+  void Present() override;
+  void OnResize(int width, int height) override;
+  void Cleanup() override;
+  const char* GetRendererName() const override;
+  void ClearCaches() override;
+
+  /**
+   * @brief 上传统计浮层纹理，之后每帧呈现前混合绘制到左上角
+   */
+  void SetOverlay(const OverlayImage* image) override;
+
+  /**
+   * @brief 读回当前绘制目标的像素（RGBA，按行从上到下）
+   * @note 用于离屏渲染的测试和截图
+   */
+  bool ReadPixels(std::vector<uint8_t>* rgba);
+
+ private:
+  /**
+   * @brief 帧格式或尺寸变化时重建上传纹理与转换路径
+   */
+  bool ConfigureUpload(const AVFrame* frame);
+
+  /**
+   * @brief 转换为可直接上传的格式，返回待上传的帧
+   */
+  AVFrame* PrepareUploadFrame(AVFrame* frame);
+
+  /**
+   * @brief 按宽高比计算视口并绘制
+   */
+  void DrawFrame(const AVFrame* frame);
+
+  std::unique_ptr<GLContext> context_;
+  std::unique_ptr<GLShader> shader_;
+  std::unique_ptr<GLFrameUploader> uploader_;
+  std::unique_ptr<GLOverlay> overlay_;
+  unsigned int vertex_array_ = 0;
+
+  int window_width_ = 0;
+  int window_height_ = 0;
+
+  // 当前帧布局
+  int frame_width_ = 0;
+  int frame_height_ = 0;
+  AVPixelFormat src_pixel_format_ = AV_PIX_FMT_NONE;
+  AVPixelFormat upload_pixel_format_ = AV_PIX_FMT_NONE;
+
+  // 格式转换（SIMD 快速路径优先，其次 swscale）
+  PixelConversion fast_conversion_ = PixelConversion::kNone;
+  SwsContext* sws_context_ = nullptr;
+  AVFrame* converted_frame_ = nullptr;
+
+  // 静态帧检测（render.static_frame_detection）
+  FrameChangeDetector change_detector_;
+  bool static_frame_detection_ = true;
+
+  bool initialized_ = false;
+};
+
+}  // namespace zenplay
@@ -4,11 +4,15 @@
 
 extern "C" {
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 }
 
 #include "player/common/log_manager.h"
 #include "player/common/sdl_error_utils.h"
+#include "player/config/global_config.h"
+#include "player/stats/statistics_manager.h"
 #include "player/video/render/impl/sdl/sdl_manager.h"
+#include "player/video/render/stats_overlay.h"
 
 #ifdef OS_WIN
 #include <windows.h>
@@ -24,6 +28,16 @@ extern "C" {
 
 namespace zenplay {
 
+namespace {
+
+// 变化图块超过一半或矩形过多时，整帧上传比多次局部上传更划算
+constexpr size_t kMaxDirtyRectUploads = 32;
+
+// 统计浮层距窗口左上角的边距（像素）
+constexpr int kOverlayMargin = 8;
+
+}  // namespace
+
 SDLRenderer::SDLRenderer()
     : renderer_(nullptr),
       window_(nullptr),
@@ -34,8 +48,14 @@ SDLRenderer::SDLRenderer()
       window_height_(0),
       src_pixel_format_(AV_PIX_FMT_NONE),
       dst_pixel_format_(AV_PIX_FMT_YUV420P),
+      fast_conversion_(PixelConversion::kNone),
       sws_context_(nullptr),
       converted_frame_(nullptr),
+      static_frame_detection_(true),
+      overlay_texture_(nullptr),
+      overlay_width_(0),
+      overlay_height_(0),
+      overlay_visible_(false),
       renderer_initialized_(false) {}
 
 SDLRenderer::~SDLRenderer() {
@@ -51,6 +71,8 @@ Result<void> SDLRenderer::Init(void* window_handle, int width, int height) {
 
   window_width_ = width;
   window_height_ = height;
+  static_frame_detection_ =
+      GlobalConfig::Instance()->GetBool("render.static_frame_detection", true);
 
   if (!InitSDL()) {
     return SDLErrorToResult("Initialize SDL");
@@ -84,7 +106,7 @@ bool SDLRenderer::RenderFrame(AVFrame* frame) {
   }
 
   // Update texture with frame data
-  if (!UpdateTexture(frame)) {
+  if (!UploadFrame(frame)) {
     MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to update texture");
     return false;
   }
@@ -101,6 +123,8 @@ bool SDLRenderer::RenderFrame(AVFrame* frame) {
     return false;
   }
 
+  DrawOverlay();
+
   // Present the frame
   Present();
   return true;
@@ -152,6 +176,12 @@ void SDLRenderer::Cleanup() {
     texture_ = nullptr;
   }
 
+  if (overlay_texture_) {
+    SDL_DestroyTexture(overlay_texture_);
+    overlay_texture_ = nullptr;
+  }
+  overlay_visible_ = false;
+
   if (renderer_) {
     SDL_DestroyRenderer(renderer_);
     renderer_ = nullptr;
@@ -172,7 +202,49 @@ const char* SDLRenderer::GetRendererName() const {
   return "SDL Renderer";
 }
 
-void SDLRenderer::ClearCaches() {}
+void SDLRenderer::ClearCaches() {
+  change_detector_.Reset();
+}
+
+void SDLRenderer::SetOverlay(const OverlayImage* image) {
+  if (!image || image->pixels.empty() || !renderer_) {
+    overlay_visible_ = false;
+    return;
+  }
+
+  if (!overlay_texture_ || overlay_width_ != image->width ||
+      overlay_height_ != image->height) {
+    if (overlay_texture_) {
+      SDL_DestroyTexture(overlay_texture_);
+    }
+    overlay_texture_ =
+        SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32,
+                          SDL_TEXTUREACCESS_STREAMING, image->width,
+                          image->height);
+    if (!overlay_texture_) {
+      MODULE_WARN(LOG_MODULE_RENDERER, "Failed to create overlay texture: {}",
+                  SDL_GetError());
+      overlay_visible_ = false;
+      return;
+    }
+    SDL_SetTextureBlendMode(overlay_texture_, SDL_BLENDMODE_BLEND);
+    overlay_width_ = image->width;
+    overlay_height_ = image->height;
+  }
+
+  overlay_visible_ = SDL_UpdateTexture(overlay_texture_, nullptr,
+                                       image->pixels.data(),
+                                       image->width * 4) == 0;
+}
+
+void SDLRenderer::DrawOverlay() {
+  if (!overlay_visible_) {
+    return;
+  }
+  SDL_Rect rect{kOverlayMargin, kOverlayMargin, overlay_width_,
+                overlay_height_};
+  SDL_RenderCopy(renderer_, overlay_texture_, nullptr, &rect);
+}
 
 bool SDLRenderer::InitSDL() {
   return SDLManager::Instance().Initialize();
@@ -233,6 +305,19 @@ bool SDLRenderer::CreateTexture(int width, int height, int pixel_format) {
   frame_height_ = height;
   src_pixel_format_ = static_cast<AVPixelFormat>(pixel_format);
 
+  // 新纹理内容未定义，下一帧必须整帧上传
+  change_detector_.Reset();
+
+  // 源格式变化后旧的转换上下文和缓冲区都不再适用
+  if (sws_context_) {
+    sws_freeContext(sws_context_);
+    sws_context_ = nullptr;
+  }
+  if (converted_frame_) {
+    av_frame_free(&converted_frame_);
+  }
+  fast_conversion_ = PixelConversion::kNone;
+
   // Determine SDL pixel format
   Uint32 sdl_format;
   switch (src_pixel_format_) {
@@ -256,6 +341,33 @@ bool SDLRenderer::CreateTexture(int width, int height, int pixel_format) {
       sdl_format = SDL_PIXELFORMAT_BGR24;
       dst_pixel_format_ = AV_PIX_FMT_BGR24;  // texture expects BGR24
       break;
+    // ✅ 10 位 / 4:2:2 / 4:4:4 走 SIMD 快速转换，不经过 swscale
+    // （YUVJ 全范围格式仍交给 swscale，由它转换到 IYUV 纹理的有限范围）
+    case AV_PIX_FMT_YUV420P10LE:
+      sdl_format = SDL_PIXELFORMAT_IYUV;
+      dst_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv420p10ToYuv420p;
+      break;
+    case AV_PIX_FMT_YUV422P:
+      sdl_format = SDL_PIXELFORMAT_IYUV;
+      dst_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv422pToYuv420p;
+      break;
+    case AV_PIX_FMT_YUV422P10LE:
+      sdl_format = SDL_PIXELFORMAT_IYUV;
+      dst_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv422p10ToYuv420p;
+      break;
+    case AV_PIX_FMT_YUV444P:
+      sdl_format = SDL_PIXELFORMAT_IYUV;
+      dst_pixel_format_ = AV_PIX_FMT_YUV420P;
+      fast_conversion_ = PixelConversion::kYuv444pToYuv420p;
+      break;
+    case AV_PIX_FMT_P010LE:
+      sdl_format = SDL_PIXELFORMAT_NV12;
+      dst_pixel_format_ = AV_PIX_FMT_NV12;
+      fast_conversion_ = PixelConversion::kP010ToNv12;
+      break;
     default:
       // For unsupported formats, convert to YUV420P
       sdl_format = SDL_PIXELFORMAT_IYUV;
@@ -271,6 +383,90 @@ bool SDLRenderer::CreateTexture(int width, int height, int pixel_format) {
     return false;
   }
 
+  if (fast_conversion_ != PixelConversion::kNone) {
+    MODULE_INFO(LOG_MODULE_RENDERER, "Using {} fast path for {} -> {}",
+                GetPixelConvertImplName(),
+                av_get_pix_fmt_name(src_pixel_format_),
+                av_get_pix_fmt_name(dst_pixel_format_));
+  }
+
+  return true;
+}
+
+bool SDLRenderer::UploadFrame(AVFrame* frame) {
+  if (!static_frame_detection_) {
+    return UpdateTexture(frame);
+  }
+
+  const auto& change = change_detector_.Analyze(frame);
+  uint64_t frame_bytes = static_cast<uint64_t>(av_image_get_buffer_size(
+      dst_pixel_format_, frame->width, frame->height, 1));
+
+  // ✅ 与上一帧完全相同：纹理内容仍然有效，跳过上传
+  if (change.IsUnchanged()) {
+    STATS_UPDATE_TEXTURE_UPLOAD(0, frame_bytes, true);
+    return true;
+  }
+
+  bool full_upload = change.full_update ||
+                     change.dirty_tiles * 2 > change.total_tiles ||
+                     change.dirty_rects.size() > kMaxDirtyRectUploads;
+  if (full_upload) {
+    STATS_UPDATE_TEXTURE_UPLOAD(frame_bytes, 0, false);
+    return UpdateTexture(frame);
+  }
+
+  // ✅ 局部变化：只上传变化的图块
+  AVFrame* upload_frame = PrepareUploadFrame(frame);
+  if (!upload_frame) {
+    return false;
+  }
+
+  uint64_t dirty_bytes = frame_bytes * change.dirty_tiles / change.total_tiles;
+  STATS_UPDATE_TEXTURE_UPLOAD(dirty_bytes, frame_bytes - dirty_bytes, false);
+
+  for (const auto& dirty : change.dirty_rects) {
+    SDL_Rect rect{dirty.x, dirty.y, dirty.w, dirty.h};
+    if (!UpdateTextureRect(upload_frame, rect)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SDLRenderer::UpdateTextureRect(AVFrame* frame, const SDL_Rect& rect) {
+  // 图块边长为偶数，矩形原点总是落在色度采样点上
+  const int x = rect.x;
+  const int y = rect.y;
+  int ret = 0;
+
+  if (dst_pixel_format_ == AV_PIX_FMT_YUV420P) {
+    ret = SDL_UpdateYUVTexture(
+        texture_, &rect, frame->data[0] + y * frame->linesize[0] + x,
+        frame->linesize[0],
+        frame->data[1] + (y / 2) * frame->linesize[1] + x / 2,
+        frame->linesize[1],
+        frame->data[2] + (y / 2) * frame->linesize[2] + x / 2,
+        frame->linesize[2]);
+  } else if (dst_pixel_format_ == AV_PIX_FMT_NV12 ||
+             dst_pixel_format_ == AV_PIX_FMT_NV21) {
+    // UV 交错平面：每个色度采样 2 字节，横向字节偏移等于 x
+    ret = SDL_UpdateNVTexture(
+        texture_, &rect, frame->data[0] + y * frame->linesize[0] + x,
+        frame->linesize[0], frame->data[1] + (y / 2) * frame->linesize[1] + x,
+        frame->linesize[1]);
+  } else {
+    // RGB24 / BGR24
+    ret = SDL_UpdateTexture(texture_, &rect,
+                            frame->data[0] + y * frame->linesize[0] + x * 3,
+                            frame->linesize[0]);
+  }
+
+  if (ret != 0) {
+    MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to update texture region: {}",
+                 SDL_GetError());
+    return false;
+  }
   return true;
 }
 
@@ -320,8 +516,22 @@ bool SDLRenderer::UpdateTexture(AVFrame* frame) {
 }
 
 bool SDLRenderer::UpdateTextureWithConversion(AVFrame* frame) {
+  AVFrame* converted = PrepareUploadFrame(frame);
+  if (!converted) {
+    return false;
+  }
+
+  // Update texture with converted frame
+  return UpdateTexture(converted);
+}
+
+AVFrame* SDLRenderer::PrepareUploadFrame(AVFrame* frame) {
+  if (static_cast<AVPixelFormat>(frame->format) == dst_pixel_format_) {
+    return frame;
+  }
+
   // Initialize conversion context if needed
-  if (!sws_context_) {
+  if (fast_conversion_ == PixelConversion::kNone && !sws_context_) {
     sws_context_ =
         sws_getContext(frame->width, frame->height, src_pixel_format_,
                        frame->width, frame->height, dst_pixel_format_,
@@ -329,7 +539,7 @@ bool SDLRenderer::UpdateTextureWithConversion(AVFrame* frame) {
 
     if (!sws_context_) {
       MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to create SWS context");
-      return false;
+      return nullptr;
     }
   }
 
@@ -338,7 +548,7 @@ bool SDLRenderer::UpdateTextureWithConversion(AVFrame* frame) {
     converted_frame_ = av_frame_alloc();
     if (!converted_frame_) {
       MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to allocate converted frame");
-      return false;
+      return nullptr;
     }
 
     converted_frame_->format = dst_pixel_format_;
@@ -348,17 +558,22 @@ bool SDLRenderer::UpdateTextureWithConversion(AVFrame* frame) {
     int ret = av_frame_get_buffer(converted_frame_, 32);
     if (ret < 0) {
       MODULE_ERROR(LOG_MODULE_RENDERER, "Failed to allocate conversion buffer");
-      return false;
+      return nullptr;
     }
   }
 
   // Convert frame
-  sws_scale(sws_context_, (const uint8_t* const*)frame->data, frame->linesize,
-            0, frame->height, converted_frame_->data,
-            converted_frame_->linesize);
+  if (fast_conversion_ != PixelConversion::kNone) {
+    ConvertPixels(fast_conversion_, frame->data, frame->linesize,
+                  converted_frame_->data, converted_frame_->linesize,
+                  frame->width, frame->height);
+  } else {
+    sws_scale(sws_context_, (const uint8_t* const*)frame->data,
+              frame->linesize, 0, frame->height, converted_frame_->data,
+              converted_frame_->linesize);
+  }
 
-  // Update texture with converted frame
-  return UpdateTexture(converted_frame_);
+  return converted_frame_;
 }
 
 SDL_Rect SDLRenderer::CalculateDisplayRect(int frame_width, int frame_height) {
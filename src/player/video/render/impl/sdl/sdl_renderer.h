@@ -4,6 +4,8 @@
 #include <string>
 
 #include "player/common/error.h"
+#include "player/video/render/frame_change_detector.h"
+#include "player/video/render/pixel_convert.h"
 #include "player/video/render/renderer.h"
 
 extern "C" {
@@ -29,6 +31,7 @@ class SDLRenderer : public Renderer {
   void Cleanup() override;
   const char* GetRendererName() const override;
   void ClearCaches() override;
+  void SetOverlay(const OverlayImage* image) override;
 
  private:
   // Initialize SDL subsystems
@@ -40,18 +43,30 @@ class SDLRenderer : public Renderer {
   // Create SDL texture for video frames
   bool CreateTexture(int width, int height, int format);
 
+  // Upload frame to texture, skipping unchanged tiles (static frame detection)
+  bool UploadFrame(AVFrame* frame);
+
   // Update texture with frame data
   bool UpdateTexture(AVFrame* frame);
 
+  // Update a sub-rectangle of the texture (frame must be in texture format)
+  bool UpdateTextureRect(AVFrame* frame, const SDL_Rect& rect);
+
   // Update texture with format conversion
   bool UpdateTextureWithConversion(AVFrame* frame);
 
+  // Convert frame to texture format if needed, returns frame ready to upload
+  AVFrame* PrepareUploadFrame(AVFrame* frame);
+
   // Convert frame format if necessary
   bool ConvertFrame(AVFrame* src_frame, AVFrame* dst_frame);
 
   // Calculate display rectangle with aspect ratio
   SDL_Rect CalculateDisplayRect(int frame_width, int frame_height);
 
+  // Draw the cached overlay texture at the top-left corner
+  void DrawOverlay();
+
  private:
   // SDL objects
   SDL_Window* window_;
@@ -66,7 +81,8 @@ class SDLRenderer : public Renderer {
   AVPixelFormat src_pixel_format_;
   AVPixelFormat dst_pixel_format_;
 
-  // Format conversion
+  // Format conversion (SIMD fast path first, swscale otherwise)
+  PixelConversion fast_conversion_;
   struct SwsContext* sws_context_;
   AVFrame* converted_frame_;
   uint8_t* converted_buffer_;
@@ -75,6 +91,16 @@ class SDLRenderer : public Renderer {
   // SDL pixel format
   Uint32 sdl_pixel_format_;
 
+  // Static frame detection (render.static_frame_detection)
+  FrameChangeDetector change_detector_;
+  bool static_frame_detection_;
+
+  // Stats overlay (RGBA texture, re-uploaded only when its content changes)
+  SDL_Texture* overlay_texture_;
+  int overlay_width_;
+  int overlay_height_;
+  bool overlay_visible_;
+
   // Initialization state
   bool sdl_initialized_;
   bool renderer_initialized_;
@@ -0,0 +1,455 @@
+#include "player/video/render/pixel_convert.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "player/common/cpu_features.h"
+
+#if defined(ZENPLAY_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace zenplay {
+
+namespace {
+
+// 2x2 Bayer 有序抖动（丢弃 2 位，抖动量 0~3），按 8 个元素展开便于 SIMD 加载
+alignas(16) constexpr uint16_t kDither[2][8] = {
+    {0, 2, 0, 2, 0, 2, 0, 2},
+    {3, 1, 3, 1, 3, 1, 3, 1},
+};
+
+/**
+ * @brief 行级转换内核，每种实现提供一组
+ */
+struct RowKernels {
+  const char* name;
+
+  // dst[i] = clamp(((src[i] >> pre_shift) + dither[i & 7]) >> 2)
+  void (*row_10_to_8)(const uint16_t* src,
+                      uint8_t* dst,
+                      int count,
+                      int pre_shift,
+                      const uint16_t* dither);
+
+  // dst[i] = (a[i] + b[i] + 1) >> 1
+  void (*avg_rows_8)(const uint8_t* a,
+                     const uint8_t* b,
+                     uint8_t* dst,
+                     int count);
+
+  // 两行 10 位取平均后抖动到 8 位
+  void (*avg_rows_10_to_8)(const uint16_t* a,
+                           const uint16_t* b,
+                           uint8_t* dst,
+                           int count,
+                           const uint16_t* dither);
+
+  // 2x2 取平均（先纵向再横向），src_count 为源行元素数
+  void (*downsample_2x2_8)(const uint8_t* a,
+                           const uint8_t* b,
+                           uint8_t* dst,
+                           int dst_count,
+                           int src_count);
+};
+
+// ============================================================================
+// 标量实现
+// ============================================================================
+
+inline uint8_t Dither10To8(uint32_t value, uint16_t dither) {
+  return static_cast<uint8_t>(std::min(255u, (value + dither) >> 2));
+}
+
+void Row10To8Scalar(const uint16_t* src,
+                    uint8_t* dst,
+                    int count,
+                    int pre_shift,
+                    const uint16_t* dither) {
+  for (int i = 0; i < count; ++i) {
+    dst[i] = Dither10To8(src[i] >> pre_shift, dither[i & 7]);
+  }
+}
+
+void AvgRows8Scalar(const uint8_t* a,
+                    const uint8_t* b,
+                    uint8_t* dst,
+                    int count) {
+  for (int i = 0; i < count; ++i) {
+    dst[i] = static_cast<uint8_t>((a[i] + b[i] + 1) >> 1);
+  }
+}
+
+void AvgRows10To8Scalar(const uint16_t* a,
+                        const uint16_t* b,
+                        uint8_t* dst,
+                        int count,
+                        const uint16_t* dither) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t avg = (static_cast<uint32_t>(a[i]) + b[i] + 1) >> 1;
+    dst[i] = Dither10To8(avg, dither[i & 7]);
+  }
+}
+
+void Downsample2x2Scalar(const uint8_t* a,
+                         const uint8_t* b,
+                         uint8_t* dst,
+                         int dst_count,
+                         int src_count) {
+  for (int i = 0; i < dst_count; ++i) {
+    int x = 2 * i;
+    int left = (a[x] + b[x] + 1) >> 1;
+    int right = left;
+    if (x + 1 < src_count) {
+      right = (a[x + 1] + b[x + 1] + 1) >> 1;
+    }
+    dst[i] = static_cast<uint8_t>((left + right + 1) >> 1);
+  }
+}
+
+constexpr RowKernels kScalarKernels = {
+    "scalar",
+    &Row10To8Scalar,
+    &AvgRows8Scalar,
+    &AvgRows10To8Scalar,
+    &Downsample2x2Scalar,
+};
+
+#if defined(ZENPLAY_ARCH_X86)
+// ============================================================================
+// SSE2 实现（x86-64 基线指令集）
+// ============================================================================
+
+inline __m128i Dither10To8Sse2(__m128i value, __m128i shift, __m128i dither) {
+  value = _mm_srl_epi16(value, shift);
+  // 饱和加法保证异常输入不会回绕，最终由 packus 钳位到 255
+  return _mm_srli_epi16(_mm_adds_epu16(value, dither), 2);
+}
+
+void Row10To8Sse2(const uint16_t* src,
+                  uint8_t* dst,
+                  int count,
+                  int pre_shift,
+                  const uint16_t* dither) {
+  const __m128i shift = _mm_cvtsi32_si128(pre_shift);
+  const __m128i d = _mm_load_si128(reinterpret_cast<const __m128i*>(dither));
+
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    lo = Dither10To8Sse2(lo, shift, d);
+    hi = Dither10To8Sse2(hi, shift, d);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+  for (; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    v = Dither10To8Sse2(v, shift, d);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(v, v));
+  }
+  for (; i < count; ++i) {
+    dst[i] = Dither10To8(src[i] >> pre_shift, dither[i & 7]);
+  }
+}
+
+void AvgRows8Sse2(const uint8_t* a, const uint8_t* b, uint8_t* dst, int count) {
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_avg_epu8(va, vb));
+  }
+  AvgRows8Scalar(a + i, b + i, dst + i, count - i);
+}
+
+void AvgRows10To8Sse2(const uint16_t* a,
+                      const uint16_t* b,
+                      uint8_t* dst,
+                      int count,
+                      const uint16_t* dither) {
+  const __m128i no_shift = _mm_setzero_si128();
+  const __m128i d = _mm_load_si128(reinterpret_cast<const __m128i*>(dither));
+
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i lo = _mm_avg_epu16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    __m128i hi = _mm_avg_epu16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 8)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 8)));
+    lo = Dither10To8Sse2(lo, no_shift, d);
+    hi = Dither10To8Sse2(hi, no_shift, d);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+  for (; i < count; ++i) {
+    uint32_t avg = (static_cast<uint32_t>(a[i]) + b[i] + 1) >> 1;
+    dst[i] = Dither10To8(avg, dither[i & 7]);
+  }
+}
+
+// 16 个源字节 -> 8 个 16 位结果
+inline __m128i Downsample16Sse2(const uint8_t* a, const uint8_t* b) {
+  const __m128i low_mask = _mm_set1_epi16(0x00FF);
+  __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  __m128i v = _mm_avg_epu8(va, vb);
+  __m128i even = _mm_and_si128(v, low_mask);
+  __m128i odd = _mm_srli_epi16(v, 8);
+  return _mm_avg_epu16(even, odd);
+}
+
+void Downsample2x2Sse2(const uint8_t* a,
+                       const uint8_t* b,
+                       uint8_t* dst,
+                       int dst_count,
+                       int src_count) {
+  int i = 0;
+  for (; i + 16 <= dst_count && 2 * (i + 16) <= src_count; i += 16) {
+    __m128i lo = Downsample16Sse2(a + 2 * i, b + 2 * i);
+    __m128i hi = Downsample16Sse2(a + 2 * i + 16, b + 2 * i + 16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+  Downsample2x2Scalar(a + 2 * i, b + 2 * i, dst + i, dst_count - i,
+                      src_count - 2 * i);
+}
+
+constexpr RowKernels kSse2Kernels = {
+    "sse2",
+    &Row10To8Sse2,
+    &AvgRows8Sse2,
+    &AvgRows10To8Sse2,
+    &Downsample2x2Sse2,
+};
+
+// ============================================================================
+// AVX2 实现（吞吐最大的两个内核，其余沿用 SSE2）
+// ============================================================================
+
+ZENPLAY_TARGET_AVX2 void Row10To8Avx2(const uint16_t* src,
+                                      uint8_t* dst,
+                                      int count,
+                                      int pre_shift,
+                                      const uint16_t* dither) {
+  const __m128i shift = _mm_cvtsi32_si128(pre_shift);
+  const __m256i d = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(dither)));
+
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i lo =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i hi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+    lo = _mm256_srli_epi16(_mm256_adds_epu16(_mm256_srl_epi16(lo, shift), d),
+                           2);
+    hi = _mm256_srli_epi16(_mm256_adds_epu16(_mm256_srl_epi16(hi, shift), d),
+                           2);
+    // packus 按 128 位通道交错，重新排列为顺序输出
+    __m256i packed =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+  }
+  // i 是 32 的倍数，抖动相位不变
+  Row10To8Sse2(src + i, dst + i, count - i, pre_shift, dither);
+}
+
+ZENPLAY_TARGET_AVX2 void AvgRows8Avx2(const uint8_t* a,
+                                      const uint8_t* b,
+                                      uint8_t* dst,
+                                      int count) {
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_avg_epu8(va, vb));
+  }
+  AvgRows8Sse2(a + i, b + i, dst + i, count - i);
+}
+
+constexpr RowKernels kAvx2Kernels = {
+    "avx2",
+    &Row10To8Avx2,
+    &AvgRows8Avx2,
+    &AvgRows10To8Sse2,
+    &Downsample2x2Sse2,
+};
+#endif
+
+const RowKernels& SelectKernels(PixelConvertPath path) {
+#if defined(ZENPLAY_ARCH_X86)
+  const CpuFeatures& features = GetCpuFeatures();
+  bool use_avx2 = features.avx2 && (path == PixelConvertPath::kAuto ||
+                                    path == PixelConvertPath::kAvx2);
+  bool use_sse2 = features.sse2 && (path == PixelConvertPath::kAuto ||
+                                    path == PixelConvertPath::kSse2);
+  if (use_avx2) {
+    return kAvx2Kernels;
+  }
+  if (use_sse2) {
+    return kSse2Kernels;
+  }
+#endif
+  return kScalarKernels;
+}
+
+const RowKernels& GetKernels(PixelConvertPath path) {
+  static const RowKernels& best = SelectKernels(PixelConvertPath::kAuto);
+  return path == PixelConvertPath::kAuto ? best : SelectKernels(path);
+}
+
+// ============================================================================
+// 平面级转换
+// ============================================================================
+
+inline const uint8_t* Row(const uint8_t* plane, int stride, int y) {
+  return plane + static_cast<ptrdiff_t>(y) * stride;
+}
+
+inline uint8_t* Row(uint8_t* plane, int stride, int y) {
+  return plane + static_cast<ptrdiff_t>(y) * stride;
+}
+
+inline const uint16_t* Row16(const uint8_t* plane, int stride, int y) {
+  return reinterpret_cast<const uint16_t*>(Row(plane, stride, y));
+}
+
+void CopyPlane(const uint8_t* src,
+               int src_stride,
+               uint8_t* dst,
+               int dst_stride,
+               int width,
+               int height) {
+  for (int y = 0; y < height; ++y) {
+    std::memcpy(Row(dst, dst_stride, y), Row(src, src_stride, y), width);
+  }
+}
+
+void Plane10To8(const RowKernels& k,
+                const uint8_t* src,
+                int src_stride,
+                uint8_t* dst,
+                int dst_stride,
+                int count,
+                int height,
+                int pre_shift) {
+  for (int y = 0; y < height; ++y) {
+    k.row_10_to_8(Row16(src, src_stride, y), Row(dst, dst_stride, y), count,
+                  pre_shift, kDither[y & 1]);
+  }
+}
+
+}  // namespace
+
+bool ConvertPixels(PixelConversion conversion,
+                   const uint8_t* const src[],
+                   const int src_stride[],
+                   uint8_t* const dst[],
+                   const int dst_stride[],
+                   int width,
+                   int height,
+                   PixelConvertPath path) {
+  if (conversion == PixelConversion::kNone || width <= 0 || height <= 0) {
+    return false;
+  }
+
+  const RowKernels& k = GetKernels(path);
+  const int chroma_width = (width + 1) / 2;
+  const int chroma_height = (height + 1) / 2;
+
+  switch (conversion) {
+    case PixelConversion::kYuv420p10ToYuv420p:
+      Plane10To8(k, src[0], src_stride[0], dst[0], dst_stride[0], width,
+                 height, 0);
+      for (int p = 1; p <= 2; ++p) {
+        Plane10To8(k, src[p], src_stride[p], dst[p], dst_stride[p],
+                   chroma_width, chroma_height, 0);
+      }
+      break;
+
+    case PixelConversion::kYuv422pToYuv420p:
+      CopyPlane(src[0], src_stride[0], dst[0], dst_stride[0], width, height);
+      for (int p = 1; p <= 2; ++p) {
+        for (int y = 0; y < chroma_height; ++y) {
+          int y0 = 2 * y;
+          int y1 = std::min(y0 + 1, height - 1);
+          k.avg_rows_8(Row(src[p], src_stride[p], y0),
+                       Row(src[p], src_stride[p], y1),
+                       Row(dst[p], dst_stride[p], y), chroma_width);
+        }
+      }
+      break;
+
+    case PixelConversion::kYuv422p10ToYuv420p:
+      Plane10To8(k, src[0], src_stride[0], dst[0], dst_stride[0], width,
+                 height, 0);
+      for (int p = 1; p <= 2; ++p) {
+        for (int y = 0; y < chroma_height; ++y) {
+          int y0 = 2 * y;
+          int y1 = std::min(y0 + 1, height - 1);
+          k.avg_rows_10_to_8(Row16(src[p], src_stride[p], y0),
+                             Row16(src[p], src_stride[p], y1),
+                             Row(dst[p], dst_stride[p], y), chroma_width,
+                             kDither[y & 1]);
+        }
+      }
+      break;
+
+    case PixelConversion::kYuv444pToYuv420p:
+      CopyPlane(src[0], src_stride[0], dst[0], dst_stride[0], width, height);
+      for (int p = 1; p <= 2; ++p) {
+        for (int y = 0; y < chroma_height; ++y) {
+          int y0 = 2 * y;
+          int y1 = std::min(y0 + 1, height - 1);
+          k.downsample_2x2_8(Row(src[p], src_stride[p], y0),
+                             Row(src[p], src_stride[p], y1),
+                             Row(dst[p], dst_stride[p], y), chroma_width,
+                             width);
+        }
+      }
+      break;
+
+    case PixelConversion::kP010ToNv12:
+      // P010 的 10 位数据存放在 16 位的高位
+      Plane10To8(k, src[0], src_stride[0], dst[0], dst_stride[0], width,
+                 height, 6);
+      Plane10To8(k, src[1], src_stride[1], dst[1], dst_stride[1],
+                 chroma_width * 2, chroma_height, 6);
+      break;
+
+    case PixelConversion::kNone:
+      return false;
+  }
+
+  return true;
+}
+
+bool IsPixelConvertPathSupported(PixelConvertPath path) {
+#if defined(ZENPLAY_ARCH_X86)
+  const CpuFeatures& features = GetCpuFeatures();
+  if (path == PixelConvertPath::kAvx2) {
+    return features.avx2;
+  }
+  if (path == PixelConvertPath::kSse2) {
+    return features.sse2;
+  }
+#else
+  if (path == PixelConvertPath::kAvx2 || path == PixelConvertPath::kSse2) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+const char* GetPixelConvertImplName() {
+  return GetKernels(PixelConvertPath::kAuto).name;
+}
+
+}  // namespace zenplay
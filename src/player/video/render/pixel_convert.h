@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zenplay {
+
+/**
+ * @brief 渲染前的快速像素格式转换
+ *
+ * SDL 纹理只支持 8 位 4:2:0（IYUV / NV12），10 位和 4:2:2 / 4:4:4
+ * 内容原本全部交给 swscale 的通用路径。这里为最常见的几种格式
+ * 提供手写 SIMD 转换（运行时按 CPU 能力选择 AVX2 / SSE2 / 标量）：
+ * - 10 位 → 8 位：2x2 Bayer 有序抖动，避免平滑渐变出现色带
+ * - 4:2:2 → 4:2:0：相邻两行色度取平均
+ * - 4:4:4 → 4:2:0：2x2 色度取平均
+ * - P010 → NV12：高 10 位有效数据抖动到 8 位
+ *
+ * 所有实现的输出逐位一致。
+ */
+enum class PixelConversion {
+  kNone,
+  kYuv420p10ToYuv420p,  // yuv420p10le -> yuv420p
+  kYuv422pToYuv420p,    // yuv422p     -> yuv420p
+  kYuv422p10ToYuv420p,  // yuv422p10le -> yuv420p
+  kYuv444pToYuv420p,    // yuv444p     -> yuv420p
+  kP010ToNv12,          // p010le      -> nv12
+};
+
+/**
+ * @brief 选择实现路径（kAuto 以外的取值用于测试对比和基准测试）
+ */
+enum class PixelConvertPath {
+  kAuto,
+  kScalar,
+  kSse2,
+  kAvx2,
+};
+
+/**
+ * @brief 执行像素格式转换
+ * @param conversion 转换类型
+ * @param src 源平面指针（与 AVFrame::data 一致）
+ * @param src_stride 源平面行字节数（与 AVFrame::linesize 一致）
+ * @param dst 目标平面指针，需已按目标格式分配
+ * @param dst_stride 目标平面行字节数
+ * @param width 亮度宽度
+ * @param height 亮度高度
+ * @param path 实现路径，kAuto 根据 CPU 能力在运行时选择，
+ *             当前 CPU 不支持的路径退回标量实现
+ * @return conversion 为 kNone 时返回 false
+ */
+bool ConvertPixels(PixelConversion conversion,
+                   const uint8_t* const src[],
+                   const int src_stride[],
+                   uint8_t* const dst[],
+                   const int dst_stride[],
+                   int width,
+                   int height,
+                   PixelConvertPath path = PixelConvertPath::kAuto);
+
+/**
+ * @brief 当前 CPU / 平台是否支持指定的实现路径
+ */
+bool IsPixelConvertPathSupported(PixelConvertPath path);
+
+/**
+ * @brief 当前 CPU 上 kAuto 使用的实现名（"avx2" / "sse2" / "scalar"）
+ */
+const char* GetPixelConvertImplName();
+
+}  // namespace zenplay
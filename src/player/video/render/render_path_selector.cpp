@@ -14,6 +14,10 @@
 #ifdef _WIN32
 #include "impl/d3d11/d3d11_renderer.h"
 #endif
+#ifdef ZENPLAY_HAS_OPENGL
+#include "impl/opengl/gl_context.h"
+#include "impl/opengl/opengl_renderer.h"
+#endif
 
 namespace zenplay {
 
@@ -143,6 +147,13 @@ RenderPathSelection RenderPathSelector::SelectForLinux(AVCodecID codec_id,
                                                        int width,
                                                        int height,
                                                        GlobalConfig* config) {
+  // OpenGL 渲染只负责上传、转换和缩放，与硬件解码无关：
+  // 按 render.backend_priority 排在 SDL 之前时优先使用
+  RenderPathSelection opengl = SelectOpenGL(config);
+  if (opengl.renderer) {
+    return opengl;
+  }
+
   RenderPathSelection result;
 
   // 检查是否启用硬件加速
@@ -183,6 +194,39 @@ RenderPathSelection RenderPathSelector::SelectForLinux(AVCodecID codec_id,
   }
 }
 
+RenderPathSelection RenderPathSelector::SelectOpenGL(GlobalConfig* config) {
+  RenderPathSelection result;
+
+#ifdef ZENPLAY_HAS_OPENGL
+  auto priority = config->GetStringArray("render.backend_priority");
+  for (const auto& backend : priority) {
+    if (backend == "software" || backend == "sdl") {
+      break;  // SDL 排在前面
+    }
+    if (backend != "opengl") {
+      continue;  // 本平台没有的后端（如 d3d11）
+    }
+
+    bool surfaceless = config->GetBool("render.opengl.surfaceless", false);
+    if (!GLContext::IsAvailable(surfaceless)) {
+      ZENPLAY_WARN("OpenGL ES 3.0 not available via EGL, skipping OpenGL");
+      break;
+    }
+
+    ZENPLAY_INFO("✅ Selected OpenGL renderer (PBO upload + shader YUV->RGB)");
+    result.renderer =
+        std::make_unique<RendererProxy>(std::make_unique<OpenGLRenderer>());
+    result.backend_name = "OpenGL";
+    result.reason = surfaceless ? "OpenGL ES 3.0 available (surfaceless)"
+                                : "OpenGL ES 3.0 available";
+    result.is_hardware = false;  // 不涉及硬件解码
+    return result;
+  }
+#endif
+
+  return result;  // renderer 为 nullptr
+}
+
 // ==================== macOS 平台 ====================
 
 RenderPathSelection RenderPathSelector::SelectForMacOS(AVCodecID codec_id,
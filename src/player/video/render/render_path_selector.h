@@ -99,6 +99,12 @@ class RenderPathSelector {
                                             GlobalConfig* config);
   static RenderPathSelection SelectSoftwareFallback(const std::string& reason);
 
+  /**
+   * @brief 按 render.backend_priority 尝试 OpenGL 渲染器（Linux）
+   * @return 不可用或优先级低于 SDL 时 renderer 为 nullptr
+   */
+  static RenderPathSelection SelectOpenGL(GlobalConfig* config);
+
   // 辅助函数
   static bool IsHardwareAccelerationEnabled(GlobalConfig* config);
   static bool IsFallbackAllowed(GlobalConfig* config);
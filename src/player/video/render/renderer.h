@@ -10,6 +10,8 @@ extern "C" {
 
 namespace zenplay {
 
+struct OverlayImage;
+
 class Renderer {
  public:
   Renderer() = default;
@@ -42,6 +44,14 @@ class Renderer {
    * 默认实现：空（do nothing）
    */
   virtual void ClearCaches() = 0;
+
+  /**
+   * @brief 设置叠加在画面左上角的图像（屏幕统计浮层），nullptr 移除
+   * 只在图像内容变化时调用（每秒至多几次），渲染器缓存为纹理，之后每次
+   * RenderFrame 呈现前绘制一次
+   * 默认实现：忽略（不支持叠加层的渲染器）
+   */
+  virtual void SetOverlay(const OverlayImage* /*image*/) {}
 };
 
 }  // namespace zenplay
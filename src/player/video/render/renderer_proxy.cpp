@@ -65,4 +65,9 @@ void RendererProxy::ClearCaches() {
   EnsureUIThreadVoid([this]() { actual_renderer_->ClearCaches(); });
 }
 
+void RendererProxy::SetOverlay(const OverlayImage* image) {
+  // 同步派发：返回前渲染器已拷贝到纹理，调用方可以继续修改图像
+  EnsureUIThreadVoid([this, image]() { actual_renderer_->SetOverlay(image); });
+}
+
 }  // namespace zenplay
@@ -40,6 +40,7 @@ class RendererProxy : public Renderer {
   void Cleanup() override;
   const char* GetRendererName() const override;
   virtual void ClearCaches() override;
+  void SetOverlay(const OverlayImage* image) override;
 
  private:
   /**
@@ -0,0 +1,340 @@
+#include "player/video/render/stats_overlay.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#ifdef OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "player/stats/statistics_manager.h"
+
+namespace zenplay {
+
+namespace {
+
+constexpr int kGlyphWidth = 5;
+constexpr int kGlyphHeight = 7;
+constexpr char kFirstGlyph = 0x20;
+constexpr int kGlyphCount = 95;  // 0x20-0x7E
+
+// 5x7 点阵，每个字形 5 列，每列一个字节，最低位是最上面一行
+constexpr uint8_t kFont5x7[kGlyphCount][kGlyphWidth] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // ' '
+    {0x00, 0x00, 0x5f, 0x00, 0x00},  // '!'
+    {0x00, 0x07, 0x00, 0x07, 0x00},  // '"'
+    {0x14, 0x7f, 0x14, 0x7f, 0x14},  // '#'
+    {0x24, 0x2a, 0x7f, 0x2a, 0x12},  // '$'
+    {0x23, 0x13, 0x08, 0x64, 0x62},  // '%'
+    {0x36, 0x49, 0x55, 0x22, 0x50},  // '&'
+    {0x00, 0x05, 0x03, 0x00, 0x00},  // '\''
+    {0x00, 0x1c, 0x22, 0x41, 0x00},  // '('
+    {0x00, 0x41, 0x22, 0x1c, 0x00},  // ')'
+    {0x14, 0x08, 0x3e, 0x08, 0x14},  // '*'
+    {0x08, 0x08, 0x3e, 0x08, 0x08},  // '+'
+    {0x00, 0x50, 0x30, 0x00, 0x00},  // ','
+    {0x08, 0x08, 0x08, 0x08, 0x08},  // '-'
+    {0x00, 0x60, 0x60, 0x00, 0x00},  // '.'
+    {0x20, 0x10, 0x08, 0x04, 0x02},  // '/'
+    {0x3e, 0x51, 0x49, 0x45, 0x3e},  // '0'
+    {0x00, 0x42, 0x7f, 0x40, 0x00},  // '1'
+    {0x42, 0x61, 0x51, 0x49, 0x46},  // '2'
+    {0x21, 0x41, 0x45, 0x4b, 0x31},  // '3'
+    {0x18, 0x14, 0x12, 0x7f, 0x10},  // '4'
+    {0x27, 0x45, 0x45, 0x45, 0x39},  // '5'
+    {0x3c, 0x4a, 0x49, 0x49, 0x30},  // '6'
+    {0x01, 0x71, 0x09, 0x05, 0x03},  // '7'
+    {0x36, 0x49, 0x49, 0x49, 0x36},  // '8'
+    {0x06, 0x49, 0x49, 0x29, 0x1e},  // '9'
+    {0x00, 0x36, 0x36, 0x00, 0x00},  // ':'
+    {0x00, 0x56, 0x36, 0x00, 0x00},  // ';'
+    {0x08, 0x14, 0x22, 0x41, 0x00},  // '<'
+    {0x14, 0x14, 0x14, 0x14, 0x14},  // '='
+    {0x00, 0x41, 0x22, 0x14, 0x08},  // '>'
+    {0x02, 0x01, 0x51, 0x09, 0x06},  // '?'
+    {0x32, 0x49, 0x79, 0x41, 0x3e},  // '@'
+    {0x7e, 0x11, 0x11, 0x11, 0x7e},  // 'A'
+    {0x7f, 0x49, 0x49, 0x49, 0x36},  // 'B'
+    {0x3e, 0x41, 0x41, 0x41, 0x22},  // 'C'
+    {0x7f, 0x41, 0x41, 0x22, 0x1c},  // 'D'
+    {0x7f, 0x49, 0x49, 0x49, 0x41},  // 'E'
+    {0x7f, 0x09, 0x09, 0x09, 0x01},  // 'F'
+    {0x3e, 0x41, 0x49, 0x49, 0x7a},  // 'G'
+    {0x7f, 0x08, 0x08, 0x08, 0x7f},  // 'H'
+    {0x00, 0x41, 0x7f, 0x41, 0x00},  // 'I'
+    {0x20, 0x40, 0x41, 0x3f, 0x01},  // 'J'
+    {0x7f, 0x08, 0x14, 0x22, 0x41},  // 'K'
+    {0x7f, 0x40, 0x40, 0x40, 0x40},  // 'L'
+    {0x7f, 0x02, 0x0c, 0x02, 0x7f},  // 'M'
+    {0x7f, 0x04, 0x08, 0x10, 0x7f},  // 'N'
+    {0x3e, 0x41, 0x41, 0x41, 0x3e},  // 'O'
+    {0x7f, 0x09, 0x09, 0x09, 0x06},  // 'P'
+    {0x3e, 0x41, 0x51, 0x21, 0x5e},  // 'Q'
+    {0x7f, 0x09, 0x19, 0x29, 0x46},  // 'R'
+    {0x46, 0x49, 0x49, 0x49, 0x31},  // 'S'
+    {0x01, 0x01, 0x7f, 0x01, 0x01},  // 'T'
+    {0x3f, 0x40, 0x40, 0x40, 0x3f},  // 'U'
+    {0x1f, 0x20, 0x40, 0x20, 0x1f},  // 'V'
+    {0x3f, 0x40, 0x38, 0x40, 0x3f},  // 'W'
+    {0x63, 0x14, 0x08, 0x14, 0x63},  // 'X'
+    {0x07, 0x08, 0x70, 0x08, 0x07},  // 'Y'
+    {0x61, 0x51, 0x49, 0x45, 0x43},  // 'Z'
+    {0x00, 0x7f, 0x41, 0x41, 0x00},  // '['
+    {0x02, 0x04, 0x08, 0x10, 0x20},  // '\\'
+    {0x00, 0x41, 0x41, 0x7f, 0x00},  // ']'
+    {0x04, 0x02, 0x01, 0x02, 0x04},  // '^'
+    {0x40, 0x40, 0x40, 0x40, 0x40},  // '_'
+    {0x00, 0x01, 0x02, 0x04, 0x00},  // '`'
+    {0x20, 0x54, 0x54, 0x54, 0x78},  // 'a'
+    {0x7f, 0x48, 0x44, 0x44, 0x38},  // 'b'
+    {0x38, 0x44, 0x44, 0x44, 0x20},  // 'c'
+    {0x38, 0x44, 0x44, 0x48, 0x7f},  // 'd'
+    {0x38, 0x54, 0x54, 0x54, 0x18},  // 'e'
+    {0x08, 0x7e, 0x09, 0x01, 0x02},  // 'f'
+    {0x0c, 0x52, 0x52, 0x52, 0x3e},  // 'g'
+    {0x7f, 0x08, 0x04, 0x04, 0x78},  // 'h'
+    {0x00, 0x44, 0x7d, 0x40, 0x00},  // 'i'
+    {0x20, 0x40, 0x44, 0x3d, 0x00},  // 'j'
+    {0x7f, 0x10, 0x28, 0x44, 0x00},  // 'k'
+    {0x00, 0x41, 0x7f, 0x40, 0x00},  // 'l'
+    {0x7c, 0x04, 0x18, 0x04, 0x78},  // 'm'
+    {0x7c, 0x08, 0x04, 0x04, 0x78},  // 'n'
+    {0x38, 0x44, 0x44, 0x44, 0x38},  // 'o'
+    {0x7c, 0x14, 0x14, 0x14, 0x08},  // 'p'
+    {0x08, 0x14, 0x14, 0x18, 0x7c},  // 'q'
+    {0x7c, 0x08, 0x04, 0x04, 0x08},  // 'r'
+    {0x48, 0x54, 0x54, 0x54, 0x20},  // 's'
+    {0x04, 0x3f, 0x44, 0x40, 0x20},  // 't'
+    {0x3c, 0x40, 0x40, 0x20, 0x7c},  // 'u'
+    {0x1c, 0x20, 0x40, 0x20, 0x1c},  // 'v'
+    {0x3c, 0x40, 0x30, 0x40, 0x3c},  // 'w'
+    {0x44, 0x28, 0x10, 0x28, 0x44},  // 'x'
+    {0x0c, 0x50, 0x50, 0x50, 0x3c},  // 'y'
+    {0x44, 0x64, 0x54, 0x4c, 0x44},  // 'z'
+    {0x00, 0x08, 0x36, 0x41, 0x00},  // '{'
+    {0x00, 0x00, 0x7f, 0x00, 0x00},  // '|'
+    {0x00, 0x41, 0x36, 0x08, 0x00},  // '}'
+    {0x10, 0x08, 0x08, 0x10, 0x08},  // '~'
+};
+
+// 半透明黑底、白字（直通 alpha）
+constexpr uint8_t kBackground[4] = {0x00, 0x00, 0x00, 0xA0};
+constexpr uint8_t kForeground[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+/**
+ * @brief 进程累计 CPU 时间（用户态 + 内核态，微秒），失败返回 -1
+ */
+int64_t ProcessCpuTimeUs() {
+#ifdef OS_WIN
+  FILETIME creation_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
+                       &kernel_time, &user_time)) {
+    return -1;
+  }
+  auto to_us = [](const FILETIME& time) {
+    ULARGE_INTEGER value;
+    value.LowPart = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return static_cast<int64_t>(value.QuadPart / 10);  // 100ns 单位
+  };
+  return to_us(kernel_time) + to_us(user_time);
+#else
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  return (static_cast<int64_t>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) *
+             1000000 +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+// 计数器差值；统计被重置（切换文件）时返回 0
+uint64_t CounterDelta(uint64_t current, uint64_t previous) {
+  return current >= previous ? current - previous : 0;
+}
+
+}  // namespace
+
+StatsOverlay::StatsOverlay(std::chrono::milliseconds update_interval,
+                           int scale)
+    : update_interval_(update_interval) {
+  scale = std::max(scale, 1);
+  cell_width_ = (kGlyphWidth + 1) * scale;
+  cell_height_ = (kGlyphHeight + 1) * scale;
+  padding_ = 3 * scale;
+  BuildAtlas(scale);
+}
+
+bool StatsOverlay::Update(std::chrono::steady_clock::time_point now) {
+  if (now < next_update_) {
+    return false;
+  }
+
+  stats::StatsShmSnapshot snapshot;
+  if (auto* manager = stats::StatisticsManager::GetInstance()) {
+    snapshot = manager->CaptureShmSnapshot();
+  }
+  return Update(snapshot, SampleCpuPercent(now), now);
+}
+
+bool StatsOverlay::Update(const stats::StatsShmSnapshot& snapshot,
+                          double cpu_percent,
+                          std::chrono::steady_clock::time_point now) {
+  next_update_ = now + update_interval_;
+
+  // 写入旧槽位后交换，另一个槽位保留上一次的快照
+  current_ ^= 1;
+  snapshots_[current_] = snapshot;
+  sample_times_[current_] = now;
+  samples_ = std::min(samples_ + 1, 2);
+
+  auto lines = FormatLines(cpu_percent);
+  if (!image_.pixels.empty() && lines == lines_) {
+    return false;  // 文字没变，纹理继续有效
+  }
+  lines_ = std::move(lines);
+  Rasterize();
+  return true;
+}
+
+void StatsOverlay::BuildAtlas(int scale) {
+  const size_t atlas_width = static_cast<size_t>(kGlyphCount) * cell_width_;
+  atlas_.assign(atlas_width * cell_height_, 0);
+
+  for (int glyph = 0; glyph < kGlyphCount; ++glyph) {
+    for (int col = 0; col < kGlyphWidth; ++col) {
+      const uint8_t bits = kFont5x7[glyph][col];
+      for (int row = 0; row < kGlyphHeight; ++row) {
+        if (!(bits & (1 << row))) {
+          continue;
+        }
+        for (int dy = 0; dy < scale; ++dy) {
+          uint8_t* dst = atlas_.data() +
+                         (row * scale + dy) * atlas_width +
+                         glyph * cell_width_ + col * scale;
+          std::fill_n(dst, scale, 0xFF);
+        }
+      }
+    }
+  }
+}
+
+std::array<std::string, StatsOverlay::kRows> StatsOverlay::FormatLines(
+    double cpu_percent) const {
+  const auto& current = snapshots_[current_];
+
+  // 第一次采样没有区间，帧率取统计报告算出的值
+  double render_fps = current.video_render_fps;
+  double decode_fps = current.video_decode_fps;
+  uint64_t new_drops = 0;
+  if (samples_ >= 2) {
+    const auto& previous = snapshots_[current_ ^ 1];
+    double seconds = std::chrono::duration<double>(
+                         sample_times_[current_] - sample_times_[current_ ^ 1])
+                         .count();
+    if (seconds > 0.0) {
+      render_fps = CounterDelta(current.video_frames_rendered,
+                                previous.video_frames_rendered) /
+                   seconds;
+      decode_fps = CounterDelta(current.video_frames_decoded,
+                                previous.video_frames_decoded) /
+                   seconds;
+    }
+    new_drops = CounterDelta(current.video_frames_dropped,
+                             previous.video_frames_dropped);
+  }
+
+  char buffer[64];
+  std::array<std::string, kRows> lines;
+  std::snprintf(buffer, sizeof(buffer), "fps   %5.1f  decode %5.1f",
+                render_fps, decode_fps);
+  lines[0] = buffer;
+  std::snprintf(buffer, sizeof(buffer), "drop  %" PRIu64 " (+%" PRIu64 ")",
+                current.video_frames_dropped, new_drops);
+  lines[1] = buffer;
+  std::snprintf(buffer, sizeof(buffer), "time  dec %.2f  rnd %.2f ms",
+                current.video_avg_decode_time_ms,
+                current.video_avg_render_time_ms);
+  lines[2] = buffer;
+  std::snprintf(buffer, sizeof(buffer), "queue video %u  audio %u",
+                current.video_decode_queue_size,
+                current.audio_decode_queue_size);
+  lines[3] = buffer;
+  std::snprintf(buffer, sizeof(buffer), "a-v   %+.1f ms",
+                current.av_sync_offset_ms);
+  lines[4] = buffer;
+  if (cpu_percent >= 0.0) {
+    std::snprintf(buffer, sizeof(buffer), "cpu   %.1f%%", cpu_percent);
+  } else {
+    std::snprintf(buffer, sizeof(buffer), "cpu   --");
+  }
+  lines[5] = buffer;
+  return lines;
+}
+
+void StatsOverlay::Rasterize() {
+  const size_t atlas_width = static_cast<size_t>(kGlyphCount) * cell_width_;
+  image_.width = kColumns * cell_width_ + 2 * padding_;
+  image_.height = kRows * cell_height_ + 2 * padding_;
+  image_.pixels.resize(static_cast<size_t>(image_.width) * image_.height * 4);
+
+  uint8_t* pixels = image_.pixels.data();
+  for (size_t i = 0; i < image_.pixels.size(); i += 4) {
+    std::memcpy(pixels + i, kBackground, 4);
+  }
+
+  const size_t stride = static_cast<size_t>(image_.width) * 4;
+  for (int row = 0; row < kRows; ++row) {
+    const std::string& line = lines_[row];
+    const int length = std::min<int>(static_cast<int>(line.size()), kColumns);
+    for (int col = 0; col < length; ++col) {
+      int glyph = static_cast<unsigned char>(line[col]) - kFirstGlyph;
+      if (glyph <= 0 || glyph >= kGlyphCount) {
+        continue;  // 空格和不可显示字符只留背景
+      }
+      const uint8_t* src = atlas_.data() + glyph * cell_width_;
+      uint8_t* dst = pixels + (padding_ + row * cell_height_) * stride +
+                     (padding_ + col * cell_width_) * 4;
+      for (int y = 0; y < cell_height_; ++y) {
+        for (int x = 0; x < cell_width_; ++x) {
+          if (src[x]) {
+            std::memcpy(dst + x * 4, kForeground, 4);
+          }
+        }
+        src += atlas_width;
+        dst += stride;
+      }
+    }
+  }
+}
+
+double StatsOverlay::SampleCpuPercent(
+    std::chrono::steady_clock::time_point now) {
+  int64_t cpu_time_us = ProcessCpuTimeUs();
+  if (cpu_time_us < 0) {
+    return -1.0;
+  }
+
+  double percent = -1.0;
+  if (last_cpu_time_us_ >= 0) {
+    double wall_us =
+        std::chrono::duration<double, std::micro>(now - last_cpu_sample_)
+            .count();
+    if (wall_us > 0.0) {
+      percent = 100.0 * (cpu_time_us - last_cpu_time_us_) / wall_us;
+    }
+  }
+  last_cpu_time_us_ = cpu_time_us;
+  last_cpu_sample_ = now;
+  return percent;
+}
+
+}  // namespace zenplay
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "player/stats/stats_shm_layout.h"
+
+namespace zenplay {
+
+/**
+ * @brief 叠加层图像（直通 alpha 的 RGBA，按行从上到下，行距 width * 4）
+ */
+struct OverlayImage {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+/**
+ * @brief 屏幕统计浮层：帧率、丢帧、解码 / 渲染耗时、队列深度、音视频
+ *        偏移和进程 CPU 占用
+ *
+ * 开销分三级，保证每帧远低于 0.1ms：
+ * - 每帧：渲染线程调用 Update(now)，未到刷新时间只做一次时间比较；渲染器
+ *   绘制已缓存的纹理（一次贴图）
+ * - 每个刷新间隔（默认 250ms）：读一份统计快照（全部是原子变量，不加锁），
+ *   格式化为固定的几行文字；文字与上次相同则到此为止
+ * - 文字变化时：从构造时烘焙好的字形图集逐行拷贝生成 RGBA 图像，渲染器
+ *   重新上传这一张小纹理
+ *
+ * 快照双缓冲：当前与上一次采样各占一个槽位，每次采样写入旧槽位后交换；
+ * 渲染帧率、解码帧率和区间丢帧按两份快照的计数差计算，不依赖统计报告
+ * 定时器的周期。
+ *
+ * 字体是内置的 5x7 点阵（ASCII 0x20-0x7E），按 scale 整数放大。
+ *
+ * @note 非线程安全：只由视频渲染线程使用
+ */
+class StatsOverlay {
+ public:
+  static constexpr int kRows = 6;
+  static constexpr int kColumns = 28;
+
+  /**
+   * @param update_interval 刷新间隔
+   * @param scale 字形放大倍数（1 为 6x8 像素的字符格）
+   */
+  explicit StatsOverlay(
+      std::chrono::milliseconds update_interval = std::chrono::milliseconds(
+          250),
+      int scale = 2);
+
+  /**
+   * @brief 每帧调用：到了刷新时间则采样全局统计和进程 CPU 时间
+   * @return 图像内容有变化（需要重新上传）时返回 true
+   */
+  bool Update(std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief 用给定快照刷新（不检查刷新时间）
+   * @param cpu_percent 进程 CPU 占用（100 表示占满一个核），负数表示未知
+   * @return 图像内容有变化时返回 true
+   */
+  bool Update(const stats::StatsShmSnapshot& snapshot,
+              double cpu_percent,
+              std::chrono::steady_clock::time_point now);
+
+  const OverlayImage& image() const { return image_; }
+  const std::array<std::string, kRows>& lines() const { return lines_; }
+
+ private:
+  /**
+   * @brief 把内置点阵放大烘焙为覆盖度图集（每个字符一格，横向排列）
+   */
+  void BuildAtlas(int scale);
+
+  /**
+   * @brief 按当前与上一次快照生成各行文字
+   */
+  std::array<std::string, kRows> FormatLines(double cpu_percent) const;
+
+  /**
+   * @brief 按 lines_ 从图集拷贝字形生成 image_
+   */
+  void Rasterize();
+
+  /**
+   * @brief 进程 CPU 占用（两次调用之间的平均值），首次调用返回 -1
+   */
+  double SampleCpuPercent(std::chrono::steady_clock::time_point now);
+
+  std::chrono::milliseconds update_interval_;
+  std::chrono::steady_clock::time_point next_update_{};
+
+  // 字形图集（每像素一个字节：0 背景，非 0 笔画）
+  int cell_width_;
+  int cell_height_;
+  int padding_;
+  std::vector<uint8_t> atlas_;
+
+  // 双缓冲快照
+  std::array<stats::StatsShmSnapshot, 2> snapshots_{};
+  std::array<std::chrono::steady_clock::time_point, 2> sample_times_{};
+  int current_ = 0;
+  int samples_ = 0;
+
+  // 进程 CPU 时间采样
+  int64_t last_cpu_time_us_ = -1;
+  std::chrono::steady_clock::time_point last_cpu_sample_{};
+
+  std::array<std::string, kRows> lines_;
+  OverlayImage image_;
+};
+
+}  // namespace zenplay
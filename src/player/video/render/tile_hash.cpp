@@ -0,0 +1,217 @@
+#include "player/video/render/tile_hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "player/common/cpu_features.h"
+
+#if defined(ZENPLAY_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace zenplay {
+
+namespace {
+
+constexpr int kStepBytes = 32;  // 8 路 x 4 字节
+constexpr int kLanes = 8;
+
+// xxHash32 的素数与轮函数
+constexpr uint32_t kPrime1 = 0x9e3779b1U;
+constexpr uint32_t kPrime2 = 0x85ebca77U;
+
+inline uint32_t Round(uint32_t acc, uint32_t word) {
+  acc += word * kPrime2;
+  acc = (acc << 13) | (acc >> 19);
+  return acc * kPrime1;
+}
+
+// 不足 32 字节的尾部按零填充成完整一步，所有实现共用
+inline void AccumulateTail(const uint8_t* data,
+                           int bytes,
+                           TileHashState* state) {
+  uint8_t block[kStepBytes] = {};
+  std::memcpy(block, data, bytes);
+  for (int lane = 0; lane < kLanes; ++lane) {
+    uint32_t word;
+    std::memcpy(&word, block + lane * 4, sizeof(word));
+    state->acc[lane] = Round(state->acc[lane], word);
+  }
+}
+
+inline void AccumulateChunkScalar(const uint8_t* data,
+                                  int bytes,
+                                  TileHashState* state) {
+  int offset = 0;
+  for (; offset + kStepBytes <= bytes; offset += kStepBytes) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+      uint32_t word;
+      std::memcpy(&word, data + offset + lane * 4, sizeof(word));
+      state->acc[lane] = Round(state->acc[lane], word);
+    }
+  }
+  if (offset < bytes) {
+    AccumulateTail(data + offset, bytes - offset, state);
+  }
+}
+
+#if defined(ZENPLAY_ARCH_X86)
+// SSE2 没有 32 位低位乘法（_mm_mullo_epi32 属于 SSE4.1）：
+// 用两次 32x32→64 乘法分别算偶数 / 奇数路，再取低 32 位交错回去
+inline __m128i MulLo32Sse2(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i RoundSse2(__m128i acc, __m128i word) {
+  const __m128i prime1 = _mm_set1_epi32(static_cast<int>(kPrime1));
+  const __m128i prime2 = _mm_set1_epi32(static_cast<int>(kPrime2));
+  acc = _mm_add_epi32(acc, MulLo32Sse2(word, prime2));
+  acc = _mm_or_si128(_mm_slli_epi32(acc, 13), _mm_srli_epi32(acc, 19));
+  return MulLo32Sse2(acc, prime1);
+}
+
+// SSE2 是 x86-64 的基线指令集，无需额外的 target 属性
+void AccumulateChunkSse2(const uint8_t* data,
+                         int bytes,
+                         TileHashState* state) {
+  __m128i acc_lo =
+      _mm_loadu_si128(reinterpret_cast<__m128i*>(&state->acc[0]));
+  __m128i acc_hi =
+      _mm_loadu_si128(reinterpret_cast<__m128i*>(&state->acc[4]));
+
+  int offset = 0;
+  for (; offset + kStepBytes <= bytes; offset += kStepBytes) {
+    __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + 16));
+    acc_lo = RoundSse2(acc_lo, lo);
+    acc_hi = RoundSse2(acc_hi, hi);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state->acc[0]), acc_lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state->acc[4]), acc_hi);
+
+  if (offset < bytes) {
+    AccumulateTail(data + offset, bytes - offset, state);
+  }
+}
+
+ZENPLAY_TARGET_AVX2 void AccumulateChunkAvx2(const uint8_t* data,
+                                             int bytes,
+                                             TileHashState* state) {
+  const __m256i prime1 = _mm256_set1_epi32(static_cast<int>(kPrime1));
+  const __m256i prime2 = _mm256_set1_epi32(static_cast<int>(kPrime2));
+  __m256i acc = _mm256_loadu_si256(reinterpret_cast<__m256i*>(state->acc));
+
+  int offset = 0;
+  for (; offset + kStepBytes <= bytes; offset += kStepBytes) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+    acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(v, prime2));
+    acc = _mm256_or_si256(_mm256_slli_epi32(acc, 13),
+                          _mm256_srli_epi32(acc, 19));
+    acc = _mm256_mullo_epi32(acc, prime1);
+  }
+
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(state->acc), acc);
+
+  if (offset < bytes) {
+    AccumulateTail(data + offset, bytes - offset, state);
+  }
+}
+#endif
+
+using ChunkFunc = void (*)(const uint8_t*, int, TileHashState*);
+
+template <ChunkFunc kChunk>
+void AccumulateRow(const uint8_t* row,
+                   int row_bytes,
+                   int tile_bytes,
+                   int num_tiles,
+                   TileHashState* states) {
+  int offset = 0;
+  for (int tile = 0; tile < num_tiles && offset < row_bytes; ++tile) {
+    int bytes = row_bytes - offset;
+    if (tile < num_tiles - 1) {
+      bytes = std::min(tile_bytes, bytes);
+    }
+    kChunk(row + offset, bytes, &states[tile]);
+    offset += bytes;
+  }
+}
+
+using RowFunc = void (*)(const uint8_t*, int, int, int, TileHashState*);
+
+RowFunc RowFuncFor(TileHashPath path) {
+#if defined(ZENPLAY_ARCH_X86)
+  const CpuFeatures& features = GetCpuFeatures();
+  bool use_avx2 = features.avx2 && (path == TileHashPath::kAuto ||
+                                    path == TileHashPath::kAvx2);
+  bool use_sse2 = features.sse2 && (path == TileHashPath::kAuto ||
+                                    path == TileHashPath::kSse2);
+  if (use_avx2) {
+    return &AccumulateRow<AccumulateChunkAvx2>;
+  }
+  if (use_sse2) {
+    return &AccumulateRow<AccumulateChunkSse2>;
+  }
+#endif
+  return &AccumulateRow<AccumulateChunkScalar>;
+}
+
+// splitmix64 终结函数
+inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+}  // namespace
+
+void AccumulateTileRow(const uint8_t* row,
+                       int row_bytes,
+                       int tile_bytes,
+                       int num_tiles,
+                       TileHashState* states,
+                       TileHashPath path) {
+  static const RowFunc auto_func = RowFuncFor(TileHashPath::kAuto);
+  RowFunc row_func =
+      path == TileHashPath::kAuto ? auto_func : RowFuncFor(path);
+  row_func(row, row_bytes, tile_bytes, num_tiles, states);
+}
+
+bool IsTileHashPathSupported(TileHashPath path) {
+#if defined(ZENPLAY_ARCH_X86)
+  const CpuFeatures& features = GetCpuFeatures();
+  if (path == TileHashPath::kAvx2) {
+    return features.avx2;
+  }
+  if (path == TileHashPath::kSse2) {
+    return features.sse2;
+  }
+#else
+  if (path == TileHashPath::kAvx2 || path == TileHashPath::kSse2) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+uint64_t FinalizeTileHash(const TileHashState& state) {
+  uint64_t hash = 0x9e3779b97f4a7c15ULL;
+  for (int lane = 0; lane < kLanes; lane += 2) {
+    uint64_t pair = (static_cast<uint64_t>(state.acc[lane + 1]) << 32) |
+                    state.acc[lane];
+    hash = Mix64(hash ^ pair);
+  }
+  return hash;
+}
+
+}  // namespace zenplay
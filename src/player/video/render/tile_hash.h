@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zenplay {
+
+/**
+ * @brief 单个图块的哈希累加状态
+ *
+ * 采用 8 路 32 位 xxHash32 轮函数：每 32 字节为一步，第 i 个 4 字节字
+ * 混入 acc[i]：acc = rotl(acc + word * P2, 13) * P1。轮函数对 acc 和 word
+ * 都是双射且非线性，任何单个字的变化都会改变结果，多处变化也不会像加法
+ * 校验和那样相互抵消。标量 / SSE2 / AVX2 实现的计算顺序完全一致，结果
+ * 逐位相同。全零即初始状态。
+ */
+struct TileHashState {
+  uint32_t acc[8];
+};
+
+/**
+ * @brief 选择实现路径（kAuto 以外的取值用于测试对比和基准测试）
+ */
+enum class TileHashPath {
+  kAuto,
+  kScalar,
+  kSse2,
+  kAvx2,
+};
+
+/**
+ * @brief 将一行像素数据按图块切分，累加到各图块的哈希状态
+ * @param row 行起始地址
+ * @param row_bytes 行有效字节数（不含 linesize 对齐填充）
+ * @param tile_bytes 每个图块在这一行中的字节数
+ * @param num_tiles 图块数量，最后一个图块吸收剩余字节
+ * @param states 长度为 num_tiles 的状态数组
+ * @param path 实现路径，kAuto 根据 CPU 能力在运行时选择，
+ *             当前 CPU 不支持的路径退回标量实现
+ */
+void AccumulateTileRow(const uint8_t* row,
+                       int row_bytes,
+                       int tile_bytes,
+                       int num_tiles,
+                       TileHashState* states,
+                       TileHashPath path = TileHashPath::kAuto);
+
+/**
+ * @brief 当前 CPU / 平台是否支持指定的实现路径
+ */
+bool IsTileHashPathSupported(TileHashPath path);
+
+/**
+ * @brief 将累加状态折叠为 64 位哈希
+ */
+uint64_t FinalizeTileHash(const TileHashState& state);
+
+}  // namespace zenplay
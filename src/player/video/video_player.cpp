@@ -4,6 +4,7 @@
 #include <cmath>
 
 #include "player/common/log_manager.h"
+#include "player/stats/alloc_tracker.h"
 #include "player/stats/statistics_manager.h"
 
 namespace zenplay {
@@ -25,8 +26,20 @@ bool VideoPlayer::Init(Renderer* renderer, const VideoConfig& config) {
     return false;
   }
 
+  // ✅ 预分配帧槽位，之后的入队 / 出队不再分配内存
+  {
+    std::lock_guard<std::mutex> lock(frame_queue_mutex_);
+    frame_slots_.clear();
+    frame_slots_.resize(
+        static_cast<size_t>(std::max(config_.max_frame_queue_size, 1)));
+    frame_head_ = 0;
+    frame_count_ = 0;
+    duration_estimator_ = FrameDurationEstimator(config_.target_fps);
+  }
+  stats_overlay_enabled_.store(config_.stats_overlay);
+
   MODULE_INFO(LOG_MODULE_VIDEO,
-              "VideoPlayer initialized: target_fps={}, max_queue_size={}, "
+              "VideoPlayer initialized: nominal_fps={:.3f}, max_queue_size={}, "
               "drop_frames={}",
               config_.target_fps, config_.max_frame_queue_size,
               config_.drop_frames);
@@ -101,11 +114,10 @@ bool VideoPlayer::PushFrame(AVFramePtr frame, const FrameTimestamp& timestamp) {
   std::lock_guard<std::mutex> lock(frame_queue_mutex_);
 
   // 检查队列大小，避免内存过度使用和延迟积累
-  if (frame_queue_.size() >=
-      static_cast<size_t>(config_.max_frame_queue_size)) {
-    if (config_.drop_frames) {
+  if (frame_count_ >= frame_slots_.size()) {
+    if (config_.drop_frames && frame_count_ > 0) {
       // 丢弃最老的帧以保持低延迟
-      frame_queue_.pop();
+      DropSlot_Locked();
       // 使用 StatisticsManager 统计丢帧
       STATS_UPDATE_RENDER(true, false, true, 0.0);
       MODULE_DEBUG(LOG_MODULE_VIDEO,
@@ -117,8 +129,7 @@ bool VideoPlayer::PushFrame(AVFramePtr frame, const FrameTimestamp& timestamp) {
     }
   }
 
-  auto media_frame = std::make_unique<MediaFrame>(std::move(frame), timestamp);
-  frame_queue_.push(std::move(media_frame));
+  PushSlot_Locked(std::move(frame), timestamp);
   frame_available_.notify_one();
 
   return true;
@@ -152,18 +163,69 @@ bool VideoPlayer::PushFrameBlocking(AVFramePtr frame,
     return false;
   }
 
-  // 推送帧
-  auto media_frame = std::make_unique<MediaFrame>(std::move(frame), timestamp);
-  frame_queue_.push(std::move(media_frame));
+  // 推送帧（背压水位低于容量，这里总有空槽位）
+  PushSlot_Locked(std::move(frame), timestamp);
   frame_available_.notify_one();
 
   MODULE_TRACE(LOG_MODULE_VIDEO,
                "Frame pushed via PushFrameBlocking, queue_size={}",
-               frame_queue_.size());
+               frame_count_);
 
   return true;
 }
 
+void VideoPlayer::PushSlot_Locked(AVFramePtr frame,
+                                  const FrameTimestamp& timestamp) {
+  VideoFrame& slot =
+      frame_slots_[(frame_head_ + frame_count_) % frame_slots_.size()];
+  int64_t pts_us = FrameDurationEstimator::kUnknown;
+  if (timestamp.pts != AV_NOPTS_VALUE) {
+    pts_us = av_rescale_q(timestamp.pts, timestamp.time_base,
+                          AVRational{1, 1000000});
+  }
+  int64_t duration_us = 0;
+  if (frame->duration > 0) {
+    duration_us = av_rescale_q(frame->duration, timestamp.time_base,
+                               AVRational{1, 1000000});
+  }
+  bool was_variable = duration_estimator_.IsVariableFrameRate();
+  double previous_duration_ms = 0.0;
+  slot.duration_ms =
+      duration_estimator_.OnFrame(pts_us, duration_us, &previous_duration_ms);
+  if (previous_duration_ms > 0.0 && frame_count_ > 0) {
+    // 与这一帧的 PTS 差才是上一帧的时长：上一帧还在队列中时修正它
+    frame_slots_[(frame_head_ + frame_count_ - 1) % frame_slots_.size()]
+        .duration_ms = previous_duration_ms;
+  }
+  if (duration_estimator_.IsVariableFrameRate() && !was_variable) {
+    MODULE_INFO(LOG_MODULE_VIDEO, "Variable frame rate detected ({:.2f}fps)",
+                duration_estimator_.ContentFps());
+  }
+  STATS_UPDATE_FRAME_RATE(duration_estimator_.ContentFps(),
+                          duration_estimator_.IsVariableFrameRate());
+
+  slot.frame = std::move(frame);
+  slot.timestamp = timestamp;
+  slot.receive_time = std::chrono::steady_clock::now();
+  ++frame_count_;
+}
+
+void VideoPlayer::PopSlot_Locked(VideoFrame* out) {
+  VideoFrame& slot = frame_slots_[frame_head_];
+  out->frame = std::move(slot.frame);
+  out->timestamp = slot.timestamp;
+  out->receive_time = slot.receive_time;
+  out->duration_ms = slot.duration_ms;
+  frame_head_ = (frame_head_ + 1) % frame_slots_.size();
+  --frame_count_;
+}
+
+void VideoPlayer::DropSlot_Locked() {
+  frame_slots_[frame_head_].frame.reset();
+  frame_head_ = (frame_head_ + 1) % frame_slots_.size();
+  --frame_count_;
+}
+
 bool VideoPlayer::WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
                                            int timeout_ms) {
   // ========================================
@@ -192,7 +254,7 @@ bool VideoPlayer::WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
     }
 
     // 3. 队列有空间？继续推送
-    if (frame_queue_.size() < high_watermark) {
+    if (frame_count_ < high_watermark) {
       return true;
     }
 
@@ -212,7 +274,7 @@ bool VideoPlayer::WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
     MODULE_TRACE(LOG_MODULE_VIDEO,
                  "Waiting for queue space (unlimited), "
                  "current={}/{}, threshold={}",
-                 frame_queue_.size(), max_queue, high_watermark);
+                 frame_count_, max_queue, high_watermark);
 
     frame_consumed_.wait(lock, has_space_or_interrupted);
 
@@ -224,7 +286,7 @@ bool VideoPlayer::WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
     MODULE_TRACE(LOG_MODULE_VIDEO,
                  "Waiting for queue space ({}ms), "
                  "current={}/{}, threshold={}",
-                 timeout_ms, frame_queue_.size(), max_queue, high_watermark);
+                 timeout_ms, frame_count_, max_queue, high_watermark);
 
     bool success = frame_consumed_.wait_for(
         lock, std::chrono::milliseconds(timeout_ms), has_space_or_interrupted);
@@ -241,7 +303,7 @@ bool VideoPlayer::WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
         MODULE_WARN(LOG_MODULE_VIDEO,
                     "Queue space wait timeout after {}ms, "
                     "queue_size={}, threshold={}",
-                    timeout_ms, frame_queue_.size(), high_watermark);
+                    timeout_ms, frame_count_, high_watermark);
         last_throttle_log_time_ = now;
       }
       return false;  // 超时
@@ -263,7 +325,7 @@ bool VideoPlayer::WaitForQueueBelow(size_t threshold, int timeout_ms) {
   std::unique_lock<std::mutex> lock(frame_queue_mutex_);
   auto queue_ready = [this, effective_threshold]() {
     return state_manager_->ShouldStop() ||
-           frame_queue_.size() < effective_threshold;
+           frame_count_ < effective_threshold;
   };
 
   if (timeout_ms < 0) {
@@ -279,17 +341,20 @@ bool VideoPlayer::WaitForQueueBelow(size_t threshold, int timeout_ms) {
     return false;
   }
 
-  return frame_queue_.size() < effective_threshold;
+  return frame_count_ < effective_threshold;
 }
 
 size_t VideoPlayer::GetMaxQueueSize() const {
-  return static_cast<size_t>(config_.max_frame_queue_size);
+  // 槽位数即队列容量（Init 之前为 0，不接收帧）
+  return frame_slots_.size();
 }
 
 void VideoPlayer::ClearFrames() {
   std::lock_guard<std::mutex> lock(frame_queue_mutex_);
-  std::queue<std::unique_ptr<MediaFrame>> empty_queue;
-  frame_queue_.swap(empty_queue);
+  while (frame_count_ > 0) {
+    DropSlot_Locked();
+  }
+  frame_head_ = 0;
 
   // ✅ 清空后通知等待的生产者：现在有大量空间了
   frame_consumed_.notify_all();
@@ -298,6 +363,11 @@ void VideoPlayer::ClearFrames() {
 void VideoPlayer::ResetTimestamps() {
   // 重置播放时间
   play_start_time_ = std::chrono::steady_clock::now();
+  {
+    // Seek 后 PTS 不连续，不能与上一帧求差
+    std::lock_guard<std::mutex> lock(frame_queue_mutex_);
+    duration_estimator_.ResetTimeline();
+  }
 
   MODULE_INFO(LOG_MODULE_VIDEO, "VideoPlayer timestamps reset");
 }
@@ -310,7 +380,7 @@ bool VideoPlayer::IsPlaying() const {
 
 size_t VideoPlayer::GetQueueSize() const {
   std::lock_guard<std::mutex> lock(frame_queue_mutex_);
-  return frame_queue_.size();
+  return frame_count_;
 }
 
 void VideoPlayer::Cleanup() {
@@ -319,9 +389,11 @@ void VideoPlayer::Cleanup() {
 }
 
 void VideoPlayer::VideoRenderThread() {
+  STATS_ALLOC_THREAD(kVideoRender);
   auto last_render_time = std::chrono::steady_clock::now();
 
   while (!state_manager_->ShouldStop()) {
+    STATS_COUNT_WAKEUP(kVideoRender);
     // 检查暂停状态
     if (state_manager_->ShouldPause()) {
       state_manager_->WaitForResume();
@@ -329,24 +401,23 @@ void VideoPlayer::VideoRenderThread() {
       continue;
     }
 
-    // 获取待渲染的帧
-    std::unique_ptr<VideoFrame> video_frame;
+    // 获取待渲染的帧（从槽位移出帧指针，不分配内存）
+    VideoFrame video_frame;
     {
       std::unique_lock<std::mutex> lock(frame_queue_mutex_);
       frame_available_.wait(lock, [this] {
-        return !frame_queue_.empty() || state_manager_->ShouldStop();
+        return frame_count_ > 0 || state_manager_->ShouldStop();
       });
 
       if (state_manager_->ShouldStop()) {
         break;
       }
 
-      if (frame_queue_.empty()) {
+      if (frame_count_ == 0) {
         continue;
       }
 
-      video_frame = std::move(frame_queue_.front());
-      frame_queue_.pop();
+      PopSlot_Locked(&video_frame);
 
       // ✅ 通知生产者：队列有空间了
       frame_consumed_.notify_one();
@@ -355,13 +426,17 @@ void VideoPlayer::VideoRenderThread() {
     auto current_time = std::chrono::steady_clock::now();
 
     // 计算帧应该显示的时间
-    auto target_display_time = CalculateFrameDisplayTime(*video_frame);
+    auto target_display_time = CalculateFrameDisplayTime(video_frame);
 
     // 检查是否需要丢帧
-    if (config_.drop_frames && ShouldDropFrame(*video_frame, current_time)) {
-      double video_pts_ms = video_frame->timestamp.ToMilliseconds();
+    if (config_.drop_frames && ShouldDropFrame(video_frame, current_time)) {
+      double video_pts_ms = video_frame.timestamp.ToMilliseconds();
       double sync_offset = CalculateAVSync(video_pts_ms);
       UpdateStats(true, 0.0, sync_offset);  // 记录丢帧
+      if (watchdog_) {
+        watchdog_->Heartbeat(PipelineWatchdog::Stage::kVideoRender,
+                             static_cast<int64_t>(video_pts_ms));
+      }
       continue;
     }
 
@@ -373,13 +448,14 @@ void VideoPlayer::VideoRenderThread() {
     // 渲染帧
     auto render_start = std::chrono::steady_clock::now();
     if (renderer_) {
+      UpdateStatsOverlay(render_start);
       // RenderFrame is expected to handle presenting internally when needed
-      renderer_->RenderFrame(video_frame->frame.get());
+      renderer_->RenderFrame(video_frame.frame.get());
     }
     auto render_end = std::chrono::steady_clock::now();
 
     // 更新视频时钟到同步控制器（传递原始PTS，由AVSyncController负责归一化）
-    double video_pts_ms = video_frame->timestamp.ToMilliseconds();
+    double video_pts_ms = video_frame.timestamp.ToMilliseconds();
 
     if (av_sync_controller_) {
       // 🔍 诊断日志：记录视频时钟更新（每30帧输出一次）
@@ -406,6 +482,10 @@ void VideoPlayer::VideoRenderThread() {
         std::chrono::duration<double, std::milli>(render_end - render_start)
             .count();
     UpdateStats(false, render_time_ms, sync_offset);
+    if (watchdog_) {
+      watchdog_->Heartbeat(PipelineWatchdog::Stage::kVideoRender,
+                           static_cast<int64_t>(video_pts_ms));
+    }
 
     last_render_time = current_time;
   }
@@ -433,10 +513,11 @@ std::chrono::steady_clock::time_point VideoPlayer::CalculateFrameDisplayTime(
 
   // 步骤1：检查PTS是否有效
   if (video_pts_ms < 0) {
-    // 无效时间戳：使用接收时间 + 固定帧间隔
-    double frame_duration_ms = 1000.0 / config_.target_fps;
+    // 无效时间戳：使用接收时间 + 这一帧的估计时长
     return frame_info.receive_time +
-           std::chrono::milliseconds(static_cast<int64_t>(frame_duration_ms));
+           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::duration<double, std::milli>(
+                   frame_info.duration_ms));
   }
 
   // 步骤2：检查是否有同步控制器
@@ -478,17 +559,16 @@ bool VideoPlayer::ShouldDropFrame(
                                                            target_display_time)
                      .count();
 
-    // 延迟超过5帧时间才丢帧
-    double frame_duration_ms = 1000.0 / config_.target_fps;
-    bool should_drop = delay > (frame_duration_ms * 5.0);
+    // 延迟超过5帧时间才丢帧（按这一帧的实际时长）
+    bool should_drop = delay > (frame_info.duration_ms * 5.0);
 
     return should_drop;
   }
 
   // 使用AVSyncController判断是否需要丢帧
   // ShouldDropVideoFrame内部会自动归一化PTS，直接传入原始PTS即可
-  bool should_drop =
-      av_sync_controller_->ShouldDropVideoFrame(video_pts_ms, current_time);
+  bool should_drop = av_sync_controller_->ShouldDropVideoFrame(
+      video_pts_ms, current_time, frame_info.duration_ms);
 
   return should_drop;
 }
@@ -568,4 +648,31 @@ void VideoPlayer::PostSeek(PlayerStateManager::PlayerState target_state) {
   }
 }
 
+void VideoPlayer::UpdateStatsOverlay(
+    std::chrono::steady_clock::time_point now) {
+  if (!stats_overlay_enabled_.load(std::memory_order_relaxed)) {
+    if (stats_overlay_) {
+      stats_overlay_.reset();
+      renderer_->SetOverlay(nullptr);
+    }
+    return;
+  }
+
+  if (!stats_overlay_) {
+    stats_overlay_ = std::make_unique<StatsOverlay>(
+        std::chrono::milliseconds(
+            std::max(config_.stats_overlay_interval_ms, 50)));
+  }
+  // ✅ 未到刷新时间或文字没变时不触碰渲染器，每帧只有一次时间比较
+  if (stats_overlay_->Update(now)) {
+    renderer_->SetOverlay(&stats_overlay_->image());
+  }
+}
+
+void VideoPlayer::RenderStill(AVFrame* frame) {
+  if (renderer_ && frame) {
+    renderer_->RenderFrame(frame);
+  }
+}
+
 }  // namespace zenplay
@@ -5,14 +5,17 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 #include "player/common/common_def.h"
 #include "player/common/error.h"
+#include "player/common/pipeline_watchdog.h"
 #include "player/common/player_state_manager.h"
 #include "player/sync/av_sync_controller.h"
+#include "player/video/frame_duration_estimator.h"
 #include "player/video/render/renderer.h"
+#include "player/video/render/stats_overlay.h"
 
 extern "C" {
 #include <libavutil/frame.h>
@@ -33,10 +36,12 @@ class VideoPlayer {
    * @brief 视频播放器配置
    */
   struct VideoConfig {
-    double target_fps = 30.0;       // 目标帧率
-    bool vsync_enabled = true;      // 垂直同步
-    int max_frame_queue_size = 15;  // 最大帧队列大小（匹配解码节流阈值）
-    bool drop_frames = true;        // 允许丢帧以维持同步
+    double target_fps = 30.0;             // 流的标称帧率（帧时长未知时使用）
+    bool vsync_enabled = true;            // 垂直同步
+    int max_frame_queue_size = 15;        // 最大帧队列大小（匹配解码节流阈值）
+    bool drop_frames = true;              // 允许丢帧以维持同步
+    bool stats_overlay = false;           // 屏幕统计浮层（可运行时切换）
+    int stats_overlay_interval_ms = 250;  // 浮层刷新间隔
   };
 
   /**
@@ -54,7 +59,7 @@ class VideoPlayer {
    * @param config 视频配置
    * @return 成功返回true
    */
-  bool Init(Renderer* renderer, const VideoConfig& config = VideoConfig{});
+  bool Init(Renderer* renderer, const VideoConfig& config);
 
   /**
    * @brief 开始播放
@@ -107,6 +112,25 @@ class VideoPlayer {
    */
   void PostSeek(PlayerStateManager::PlayerState target_state);
 
+  /**
+   * @brief 立即渲染一帧，不经过帧队列和音视频同步
+   * @note 拖动进度条时显示关键帧预览，渲染线程暂停时同样有效
+   */
+  void RenderStill(AVFrame* frame);
+
+  /**
+   * @brief 设置卡死检测器，每渲染（或丢弃）一帧上报一次进度
+   * @param watchdog 外部管理，需在 Start() 之前设置
+   */
+  void SetWatchdog(PipelineWatchdog* watchdog) { watchdog_ = watchdog; }
+
+  /**
+   * @brief 显示 / 隐藏屏幕统计浮层（任意线程调用，下一帧生效）
+   */
+  void SetStatsOverlayEnabled(bool enabled) {
+    stats_overlay_enabled_.store(enabled);
+  }
+
   /**
    * @brief 推送视频帧到播放队列
    * @param frame 视频帧
@@ -196,6 +220,25 @@ class VideoPlayer {
   bool WaitForQueueSpace_Locked(std::unique_lock<std::mutex>& lock,
                                 int timeout_ms);
 
+  // ========================================
+  // 帧槽位环（调用方持有 frame_queue_mutex_）
+  // ========================================
+
+  /**
+   * @brief 把帧写入队尾槽位（调用前确认有空槽位）
+   */
+  void PushSlot_Locked(AVFramePtr frame, const FrameTimestamp& timestamp);
+
+  /**
+   * @brief 把队首槽位的帧移到 out，槽位变为空闲
+   */
+  void PopSlot_Locked(VideoFrame* out);
+
+  /**
+   * @brief 释放队首槽位中的帧
+   */
+  void DropSlot_Locked();
+
   /**
    * @brief 计算帧显示时间
    * @param frame_info 帧信息
@@ -236,23 +279,40 @@ class VideoPlayer {
   double GetEffectiveElapsedTime(
       std::chrono::steady_clock::time_point current_time) const;
 
+  /**
+   * @brief 渲染线程每帧调用：按开关创建 / 销毁浮层，内容变化时交给渲染器
+   */
+  void UpdateStatsOverlay(std::chrono::steady_clock::time_point now);
+
   // 渲染器和同步控制器
   Renderer* renderer_;
   PlayerStateManager* state_manager_;     // 状态管理器
   AVSyncController* av_sync_controller_;  // 外部管理的同步控制器
+  PipelineWatchdog* watchdog_ = nullptr;  // 外部管理的卡死检测器
 
   // 配置
   VideoConfig config_;
 
   // 视频帧队列 (使用通用的 MediaFrame)
+  // 固定容量的槽位环，Init 时一次分配；入队、出队只移动下标和帧指针，
+  // 渲染路径上没有堆分配
   mutable std::mutex frame_queue_mutex_;
-  std::queue<std::unique_ptr<MediaFrame>> frame_queue_;
+  std::vector<VideoFrame> frame_slots_;
+  size_t frame_head_ = 0;   // 最早一帧所在槽位
+  size_t frame_count_ = 0;  // 已占用的槽位数
+  // 入队时估计每帧时长（PTS 差 / AVFrame::duration / 标称帧率），
+  // 用于调度、丢帧判断和统计；由 frame_queue_mutex_ 保护
+  FrameDurationEstimator duration_estimator_;
   std::condition_variable frame_available_;  // 通知消费者：有帧可用
   std::condition_variable frame_consumed_;   // 通知生产者：有空间可用
 
   // 渲染线程
   std::unique_ptr<std::thread> render_thread_;
 
+  // 屏幕统计浮层（stats_overlay_ 只由渲染线程访问）
+  std::atomic<bool> stats_overlay_enabled_{false};
+  std::unique_ptr<StatsOverlay> stats_overlay_;
+
   // 播放时间管理
   std::chrono::steady_clock::time_point play_start_time_;  // 播放开始时间
 
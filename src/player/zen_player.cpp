@@ -1,21 +1,62 @@
 #include "player/zen_player.h"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
+#include <string>
 #include <thread>
 
+#include "player/audio/audio_player.h"
 #include "player/codec/audio_decoder.h"
 #include "player/codec/hw_decoder_context.h"
 #include "player/codec/video_decoder.h"
 #include "player/common/log_manager.h"
 #include "player/common/player_state_manager.h"
+#include "player/common/timer_util.h"
+#include "player/config/global_config.h"
+#include "player/config/pipeline_profile.h"
 #include "player/demuxer/demuxer.h"
 #include "player/playback_controller.h"
 #include "player/video/render/render_path_selector.h"
 #include "player/video/render/renderer.h"
 
+extern "C" {
+#include <libavutil/dict.h>
+#include <libavutil/pixdesc.h>
+}
+
 namespace zenplay {
 
+namespace {
+
+// 按配置档生成解码线程选项（threads=0 由 FFmpeg 按 CPU 核数决定）
+// 调用方负责 av_dict_free
+AVDictionary* CreateDecoderThreadOptions(const PipelineProfile& profile) {
+  AVDictionary* options = nullptr;
+  av_dict_set_int(&options, "threads", profile.decoder_threads, 0);
+  if (!profile.decoder_thread_type.empty()) {
+    av_dict_set(&options, "thread_type", profile.decoder_thread_type.c_str(),
+                0);
+  }
+  return options;
+}
+
+// 裸 YUV 没有文件头，帧格式取自配置（player.raw_video）
+RawVideoSource::Options LoadRawVideoOptions(const GlobalConfig* config) {
+  RawVideoSource::Options options;
+  options.width = config->GetInt("player.raw_video.width", 0);
+  options.height = config->GetInt("player.raw_video.height", 0);
+  options.pixel_format = av_get_pix_fmt(
+      config->GetString("player.raw_video.pixel_format", "yuv420p").c_str());
+  double fps = config->GetDouble("player.raw_video.fps", 25.0);
+  if (fps > 0.0) {
+    options.frame_rate = av_d2q(fps, 100000);
+  }
+  return options;
+}
+
+}  // namespace
+
 // 直接返回 PlayerStateManager 的状态
 PlayerStateManager::PlayerState ZenPlayer::GetState() const {
   return state_manager_->GetState();
@@ -82,6 +123,27 @@ Result<void> ZenPlayer::InitializeVideoRenderingPipeline() {
     return Result<void>::Ok();
   }
 
+  // 未压缩视频源：帧就在内存映射中，不打开解码器，使用软件渲染路径
+  if (demuxer_->raw_video_source()) {
+    MODULE_INFO(LOG_MODULE_PLAYER,
+                "Raw video source, rendering mapped frames without decoder");
+    if (!renderer_) {
+      renderer_ = RenderPathSelector::CreateDefaultRenderer();
+    }
+    return Result<void>::Ok();
+  }
+
+  // 对比播放：渲染到合成器的分块，软件解码
+  if (external_renderer_) {
+    MODULE_INFO(LOG_MODULE_PLAYER,
+                "Using external renderer, opening software video decoder");
+    AVDictionary* options = CreateDecoderThreadOptions(pipeline_profile_);
+    auto result = video_decoder_->Open(video_stream->codecpar, &options,
+                                       nullptr);
+    av_dict_free(&options);
+    return result;
+  }
+
   // 有视频流，选择最佳渲染路径
   MODULE_INFO(LOG_MODULE_PLAYER,
               "Video stream found, selecting render path...");
@@ -108,8 +170,11 @@ Result<void> ZenPlayer::InitializeVideoRenderingPipeline() {
 
   // 打开视频解码器（可能使用硬件加速）
   MODULE_INFO(LOG_MODULE_PLAYER, "Opening video decoder...");
-  return video_decoder_->Open(video_stream->codecpar, nullptr,
-                              hw_decoder_context_.get());
+  AVDictionary* options = CreateDecoderThreadOptions(pipeline_profile_);
+  auto result = video_decoder_->Open(video_stream->codecpar, &options,
+                                     hw_decoder_context_.get());
+  av_dict_free(&options);
+  return result;
 }
 
 Result<void> ZenPlayer::InitializeAudioDecoder() {
@@ -120,6 +185,10 @@ Result<void> ZenPlayer::InitializeAudioDecoder() {
     MODULE_INFO(LOG_MODULE_PLAYER, "No audio stream found, skipping");
     return Result<void>::Ok();
   }
+  if (!audio_enabled_) {
+    MODULE_INFO(LOG_MODULE_PLAYER, "Audio disabled for this pipeline");
+    return Result<void>::Ok();
+  }
 
   MODULE_INFO(LOG_MODULE_PLAYER, "Opening audio decoder...");
   return audio_decoder_->Open(audio_stream->codecpar);
@@ -135,21 +204,84 @@ Result<void> ZenPlayer::Open(const std::string& url) {
 
   state_manager_->TransitionToOpening();
 
-  return demuxer_
-      ->Open(url)
+  // 解析流水线配置档（队列容量、解码线程、音频周期等）
+  pipeline_profile_ = PipelineProfile::Load(profile_name_);
+  MODULE_INFO(LOG_MODULE_PLAYER, "Using pipeline profile: {}",
+              pipeline_profile_.name);
+
+  // 网络流单次 I/O 截止时间（Stop / Seek 通过中断回调立即打断）
+  auto* config = GlobalConfig::Instance();
+  demuxer_->SetIoTimeouts(config->GetInt64("network.open_timeout_ms", 15000),
+                          config->GetInt64("network.timeout_ms", 5000));
+  demuxer_->SetRawVideoOptions(LoadRawVideoOptions(config));
+
+  // ✅ 互不依赖的步骤并行：音频输出格式固定、与文件无关，设备在探测文件
+  // 的同时打开；音频解码器在渲染路径选择和视频解码器打开的同时打开。
+  // 渲染路径选择留在调用线程（RendererProxy 析构时需要 UI 线程）
+  OpenTimings timings;
+  TimerUtil open_timer;
+  auto audio_player_future = std::async(std::launch::async, [this, &timings] {
+    TIMER_START(audio_device);
+    auto audio_player = PlaybackController::OpenAudioPlayer(
+        state_manager_.get(), pipeline_profile_);
+    timings.audio_device_ms = TIMER_END_MS(audio_device);
+    return audio_player;
+  });
+
+  TIMER_START(demuxer_open);
+  auto open_result = demuxer_->Open(url);
+  timings.demuxer_ms = TIMER_END_MS(demuxer_open);
+
+  return open_result
       // ✅ Step 1: Demuxer 已打开
-      .AndThen([this]() -> Result<void> {
-        return InitializeVideoRenderingPipeline();
+      .AndThen([this, &timings]() -> Result<void> {
+        auto audio_decoder_future =
+            std::async(std::launch::async, [this, &timings] {
+              TIMER_START(audio_decoder);
+              auto result = InitializeAudioDecoder();
+              timings.audio_decoder_ms = TIMER_END_MS(audio_decoder);
+              return result;
+            });
+
+        TIMER_START(video_pipeline);
+        auto video_result = InitializeVideoRenderingPipeline();
+        timings.video_ms = TIMER_END_MS(video_pipeline);
+
+        auto audio_result = audio_decoder_future.get();
+        return video_result.IsOk() ? std::move(audio_result)
+                                   : std::move(video_result);
       })
-      // ✅ Step 2: Video rendering pipeline 已初始化（或跳过）
-      .AndThen([this]() -> Result<void> { return InitializeAudioDecoder(); })
-      // ✅ Step 3: Audio Decoder 已打开（或跳过）
-      .AndThen([this]() -> Result<void> {
+      // ✅ Step 2: 渲染管线和音频解码器已初始化（或跳过）
+      .AndThen([this, &url, &timings, &open_timer,
+                &audio_player_future]() -> Result<void> {
         // 创建播放控制器
         MODULE_INFO(LOG_MODULE_PLAYER, "Creating playback controller...");
+        auto audio_player = audio_player_future.get();
+        TIMER_START(controller);
         playback_controller_ = std::make_unique<PlaybackController>(
             state_manager_, demuxer_.get(), video_decoder_.get(),
-            audio_decoder_.get(), renderer_.get());
+            audio_decoder_.get(), renderer_.get(), pipeline_profile_,
+            std::move(audio_player));
+        if (master_clock_) {
+          playback_controller_->SetMasterClock(master_clock_);
+        }
+        playback_controller_->EnableSeekPrefetch(url);
+        timings.controller_ms = TIMER_END_MS(controller);
+
+        timings.total_ms = open_timer.ElapsedMs();
+        timings.estimated_sequential_ms =
+            timings.demuxer_ms + timings.video_ms + timings.audio_decoder_ms +
+            timings.audio_device_ms + timings.controller_ms;
+        open_timings_ = timings;
+        MODULE_INFO(LOG_MODULE_PLAYER,
+                    "Open timing: demuxer {:.1f}ms, video {:.1f}ms, audio "
+                    "decoder {:.1f}ms, audio device {:.1f}ms, controller "
+                    "{:.1f}ms; total {:.1f}ms (sequential estimate "
+                    "{:.1f}ms)",
+                    timings.demuxer_ms, timings.video_ms,
+                    timings.audio_decoder_ms, timings.audio_device_ms,
+                    timings.controller_ms, timings.total_ms,
+                    timings.estimated_sequential_ms);
 
         is_opened_ = true;
         state_manager_->TransitionToStopped();
@@ -171,6 +303,19 @@ Result<void> ZenPlayer::Open(const std::string& url) {
       });
 }
 
+void ZenPlayer::SetPipelineProfile(const std::string& name) {
+  profile_name_ = name;
+}
+
+void ZenPlayer::SetExternalPipeline(std::unique_ptr<Renderer> renderer,
+                                    const AVSyncController* master_clock,
+                                    bool enable_audio) {
+  renderer_ = std::move(renderer);
+  external_renderer_ = renderer_ != nullptr;
+  master_clock_ = master_clock;
+  audio_enabled_ = enable_audio;
+}
+
 Result<void> ZenPlayer::SetRenderWindow(void* window_handle,
                                         int width,
                                         int height) {
@@ -323,7 +468,7 @@ bool ZenPlayer::Seek(int64_t timestamp, bool backward) {
   return true;  // 立即返回，不等待结果
 }
 
-void ZenPlayer::SeekAsync(int64_t timestamp_ms, bool backward) {
+uint64_t ZenPlayer::SeekAsync(int64_t timestamp_ms, bool backward) {
   MODULE_INFO(LOG_MODULE_PLAYER, "ZenPlayer::SeekAsync to {}ms", timestamp_ms);
 
   // 验证前提条件
@@ -331,7 +476,7 @@ void ZenPlayer::SeekAsync(int64_t timestamp_ms, bool backward) {
     MODULE_ERROR(LOG_MODULE_PLAYER, "Cannot seek: player not opened");
     // 通过状态通知错误
     state_manager_->TransitionToError();
-    return;
+    return 0;
   }
 
   // 验证时间戳范围
@@ -341,11 +486,126 @@ void ZenPlayer::SeekAsync(int64_t timestamp_ms, bool backward) {
                  "Invalid seek timestamp: {}ms (duration: {}ms)", timestamp_ms,
                  duration);
     state_manager_->TransitionToError();
-    return;
+    return 0;
   }
 
   // 调用 PlaybackController 的异步 Seek
-  playback_controller_->SeekAsync(timestamp_ms, backward);
+  return playback_controller_->SeekAsync(timestamp_ms, backward);
+}
+
+uint64_t ZenPlayer::GetCompletedSeekSerial() const {
+  return playback_controller_ ? playback_controller_->completed_seek_serial()
+                              : 0;
+}
+
+void ZenPlayer::BeginScrub() {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  playback_controller_->BeginScrub();
+}
+
+void ZenPlayer::ScrubTo(int64_t timestamp_ms) {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  int64_t duration = GetDuration();
+  if (duration > 0) {
+    timestamp_ms = std::min(timestamp_ms, duration);
+  }
+  playback_controller_->ScrubTo(std::max<int64_t>(timestamp_ms, 0));
+}
+
+void ZenPlayer::EndScrub(int64_t timestamp_ms) {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  int64_t duration = GetDuration();
+  if (duration > 0) {
+    timestamp_ms = std::min(timestamp_ms, duration);
+  }
+  playback_controller_->EndScrub(std::max<int64_t>(timestamp_ms, 0));
+}
+
+void ZenPlayer::PrefetchSeek(int64_t timestamp_ms) {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  int64_t duration = GetDuration();
+  if (timestamp_ms < 0 || (duration > 0 && timestamp_ms > duration)) {
+    return;
+  }
+  playback_controller_->PrefetchSeek(timestamp_ms);
+}
+
+void ZenPlayer::CancelSeekPrefetch() {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  playback_controller_->CancelSeekPrefetch();
+}
+
+Result<void> ZenPlayer::SetABLoop(int64_t start_ms, int64_t end_ms) {
+  if (!is_opened_ || !playback_controller_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Cannot set A-B loop: player not opened");
+  }
+
+  int64_t duration = GetDuration();
+  if (duration > 0) {
+    end_ms = std::min(end_ms, duration);
+  }
+
+  // 过短的区间每轮都在等待首帧，没有意义
+  constexpr int64_t kMinLoopLengthMs = 100;
+  if (start_ms < 0 || end_ms - start_ms < kMinLoopLengthMs) {
+    return Result<void>::Err(
+        ErrorCode::kInvalidParameter,
+        "Invalid A-B loop range: " + std::to_string(start_ms) + "ms - " +
+            std::to_string(end_ms) + "ms");
+  }
+
+  playback_controller_->SetLoopRange(start_ms, end_ms);
+  return Result<void>::Ok();
+}
+
+void ZenPlayer::ClearABLoop() {
+  if (!is_opened_ || !playback_controller_) {
+    return;
+  }
+  playback_controller_->ClearLoopRange();
+}
+
+bool ZenPlayer::IsABLooping() const {
+  return is_opened_ && playback_controller_ &&
+         playback_controller_->IsLooping();
+}
+
+Result<void> ZenPlayer::SetPlaybackRate(double rate) {
+  if (!is_opened_ || !playback_controller_) {
+    return Result<void>::Err(ErrorCode::kNotInitialized,
+                             "Cannot set playback rate: player not opened");
+  }
+  return playback_controller_->SetPlaybackRate(rate);
+}
+
+double ZenPlayer::GetPlaybackRate() const {
+  if (!is_opened_ || !playback_controller_) {
+    return 1.0;
+  }
+  return playback_controller_->GetPlaybackRate();
+}
+
+void ZenPlayer::SetStatsOverlayEnabled(bool enabled) {
+  GlobalConfig::Instance()->Set("render.stats_overlay.enabled", enabled);
+  if (is_opened_ && playback_controller_) {
+    playback_controller_->SetStatsOverlayEnabled(enabled);
+  }
+}
+
+bool ZenPlayer::IsStatsOverlayEnabled() const {
+  return GlobalConfig::Instance()->GetBool("render.stats_overlay.enabled",
+                                           false);
 }
 
 int ZenPlayer::RegisterStateChangeCallback(
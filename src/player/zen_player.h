@@ -5,6 +5,7 @@
 
 #include "player/common/error.h"
 #include "player/common/player_state_manager.h"
+#include "player/config/pipeline_profile.h"
 
 namespace zenplay {
 
@@ -14,9 +15,28 @@ class Demuxer;
 class Renderer;
 class PlaybackController;
 class HWDecoderContext;
+class AVSyncController;
 
 class ZenPlayer {
  public:
+  /**
+   * @brief Open 各步骤耗时（毫秒）
+   *
+   * 音频设备与解封装器探测并行，音频解码器与渲染路径选择、视频解码器
+   * 并行。estimated_sequential_ms 是并行运行时测得的各步骤耗时之和，
+   * 只是串行打开耗时的估计：并行时各步骤争用 CPU / 磁盘，
+   * 单步耗时可能比串行执行时更长。
+   */
+  struct OpenTimings {
+    double demuxer_ms = 0.0;        // 打开输入、探测流信息
+    double video_ms = 0.0;          // 渲染路径选择 + 视频解码器
+    double audio_decoder_ms = 0.0;  // 音频解码器
+    double audio_device_ms = 0.0;   // 音频输出设备
+    double controller_ms = 0.0;     // 创建 PlaybackController
+    double total_ms = 0.0;          // Open 实际耗时
+    double estimated_sequential_ms = 0.0;  // 各步骤耗时之和（估计值）
+  };
+
   ZenPlayer();
   ~ZenPlayer();
 
@@ -27,6 +47,37 @@ class ZenPlayer {
    */
   Result<void> Open(const std::string& url);
 
+  /**
+   * @brief 选择流水线配置档（low_latency / balanced / high_throughput /
+   *        power_save 或配置文件中自定义的名称），下次 Open 时生效
+   * @param name 配置档名称，空字符串表示使用配置文件的 player.profile
+   */
+  void SetPipelineProfile(const std::string& name);
+
+  /**
+   * @brief 获取当前打开的媒体使用的配置档（Open 时解析）
+   */
+  const PipelineProfile& GetPipelineProfile() const {
+    return pipeline_profile_;
+  }
+
+  /**
+   * @brief 最近一次成功 Open 的各步骤耗时
+   */
+  const OpenTimings& GetOpenTimings() const { return open_timings_; }
+
+  /**
+   * @brief 接入外部渲染目标和共享主时钟（多文件对比播放，在 Open 之前调用）
+   * @param renderer 外部渲染器（CompareCompositor 的分块），跳过渲染路径
+   *        选择；视频固定软件解码，合成时需要 CPU 可读的帧
+   * @param master_clock 共享主时钟，视频按它而不是本管线的时钟显示；
+   *        生命周期需覆盖本播放器
+   * @param enable_audio false 时不打开音频解码器
+   */
+  void SetExternalPipeline(std::unique_ptr<Renderer> renderer,
+                           const AVSyncController* master_clock,
+                           bool enable_audio);
+
   /**
    * @brief 关闭播放器，释放所有资源
    * @note void 返回类型，不会失败
@@ -81,8 +132,75 @@ class ZenPlayer {
    *       - kSeeking 状态：开始跳转
    *       - kPlaying/kPaused 状态：跳转成功
    *       - kError 状态：跳转失败
+   * @return Seek 请求序号，请求被拒绝时返回 0；与 GetCompletedSeekSerial()
+   *         比较可判断状态回调中结束的是不是这一次 Seek
+   */
+  uint64_t SeekAsync(int64_t timestamp_ms, bool backward = true);
+
+  /**
+   * @brief 最近一次执行完（成功或失败）的 Seek 请求序号
    */
-  void SeekAsync(int64_t timestamp_ms, bool backward = true);
+  uint64_t GetCompletedSeekSerial() const;
+
+  /**
+   * @brief 拖动进度条：按下时 BeginScrub，移动时 ScrubTo，松开时 EndScrub
+   * @note 拖动期间只跳到关键帧并显示这一帧（频率受限），不进入 kSeeking；
+   *       播放中会先暂停，松开时精确跳转到目标位置后恢复播放
+   */
+  void BeginScrub();
+  void ScrubTo(int64_t timestamp_ms);
+  void EndScrub(int64_t timestamp_ms);
+
+  /**
+   * @brief 鼠标悬停在进度条上：在后台预取悬停位置（player.hover_prefetch）
+   * @note 鼠标停留一小段时间后才开始；随后在同一位置 Seek 时直接使用
+   *       预取的包和帧。离开进度条时调用 CancelSeekPrefetch
+   */
+  void PrefetchSeek(int64_t timestamp_ms);
+  void CancelSeekPrefetch();
+
+  /**
+   * @brief 开启 A-B 循环
+   * @param start_ms A 点（毫秒）
+   * @param end_ms B 点（毫秒），超出时长时截断到结尾
+   * @return Result<void> 区间无效或播放器未打开时返回错误
+   * @note 第一遍之后循环区间从内存回放，衔接处不再 Seek / 解码；
+   *       调用 SeekAsync 会退出循环
+   */
+  Result<void> SetABLoop(int64_t start_ms, int64_t end_ms);
+
+  /**
+   * @brief 退出 A-B 循环，从当前位置继续播放
+   */
+  void ClearABLoop();
+
+  /**
+   * @brief 是否处于 A-B 循环中
+   */
+  bool IsABLooping() const;
+
+  /**
+   * @brief 设置播放速率
+   * @param rate 1.0 为正常正放；负数为倒放（-1.0 为原速倒放，
+   *             绝对值限制在 0.25 ~ 4.0）
+   * @return Result<void> 播放器未打开或速率不支持时返回错误
+   * @note 倒放时音频静音；倒放中调用 SeekAsync 会从新位置继续倒放
+   */
+  Result<void> SetPlaybackRate(double rate);
+
+  /**
+   * @brief 当前播放速率（倒放时为负数）
+   */
+  double GetPlaybackRate() const;
+
+  /**
+   * @brief 显示 / 隐藏屏幕统计浮层（帧率、丢帧、解码 / 渲染耗时、队列
+   *        深度、音视频偏移、CPU）
+   * @note 写入 render.stats_overlay.enabled（不保存到文件），之后打开的
+   *       文件沿用该设置
+   */
+  void SetStatsOverlayEnabled(bool enabled);
+  bool IsStatsOverlayEnabled() const;
 
   /**
    * @brief 注册状态变更回调
@@ -142,6 +260,17 @@ class ZenPlayer {
   // 新：统一的状态管理器
   std::shared_ptr<PlayerStateManager> state_manager_;
 
+  // 对比播放：外部渲染器 + 共享主时钟（SetExternalPipeline）
+  bool external_renderer_ = false;
+  const AVSyncController* master_clock_ = nullptr;
+  bool audio_enabled_ = true;
+
+  // 流水线配置档：profile_name_ 为用户选择，pipeline_profile_ 为 Open 时解析
+  std::string profile_name_;
+  PipelineProfile pipeline_profile_;
+
+  OpenTimings open_timings_;
+
   bool is_opened_ = false;
 };
 
@@ -7,7 +7,9 @@
 #include <QKeySequence>
 #include <QMessageBox>
 #include <QMetaObject>
+#include <QMouseEvent>
 #include <QScreen>
+#include <QStyle>
 #include <QUrl>
 #include <QWindow>
 #include <iostream>
@@ -22,6 +24,7 @@
 
 #include "player/common/log_manager.h"
 #include "player/common/player_state_manager.h"
+#include "player/compare_session.h"
 #include "player/zen_player.h"
 
 namespace zenplay {
@@ -44,6 +47,7 @@ MainWindow::MainWindow(QWidget* parent)
       fullscreenBtn_(nullptr),
       openFileAction_(nullptr),
       openUrlAction_(nullptr),
+      compareFilesAction_(nullptr),
       exitAction_(nullptr),
       aboutAction_(nullptr),
       statusLabel_(nullptr),
@@ -136,6 +140,15 @@ void MainWindow::setupMenuBar() {
           &MainWindow::openNetworkUrl);
   fileMenu->addAction(openUrlAction_);
 
+  compareFilesAction_ = new QAction(tr("&Compare Files..."), this);
+  compareFilesAction_->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT |
+                                                Qt::Key_O));
+  compareFilesAction_->setStatusTip(
+      tr("Play 2-4 media files side by side in sync"));
+  connect(compareFilesAction_, &QAction::triggered, this,
+          &MainWindow::openCompareFiles);
+  fileMenu->addAction(compareFilesAction_);
+
   fileMenu->addSeparator();
 
   exitAction_ = new QAction(tr("E&xit"), this);
@@ -184,7 +197,9 @@ void MainWindow::setupVideoArea() {
   connect(videoWidget_, &VideoDisplayWidget::resized,
           [this](int width, int height) {
             // 通知渲染器窗口大小变化
-            if (player_ && player_->IsOpened()) {
+            if (isComparing()) {
+              compareSession_->OnWindowResize(width, height);
+            } else if (player_ && player_->IsOpened()) {
               player_->OnWindowResize(width, height);
             }
           });
@@ -277,6 +292,9 @@ void MainWindow::setupControlBar() {
           &MainWindow::onProgressSliderReleased);
   connect(progressSlider_, &QSlider::valueChanged, this,
           &MainWindow::onProgressSliderValueChanged);
+  // 悬停在进度条上时后台预取该位置，点击后立即出画面
+  progressSlider_->setMouseTracking(true);
+  progressSlider_->installEventFilter(this);
   controlLayout_->addWidget(progressSlider_, 1);  // Take most of the space
 
   // Duration label
@@ -344,6 +362,93 @@ void MainWindow::openNetworkUrl() {
   }
 }
 
+void MainWindow::openCompareFiles() {
+  QStringList fileNames = QFileDialog::getOpenFileNames(
+      this, tr("Compare Media Files"), QString(),
+      tr("Video Files (*.mp4 *.avi *.mkv *.mov *.wmv *.flv *.webm *.m4v "
+         "*.3gp *.y4m);;All Files (*.*)"));
+  if (fileNames.isEmpty()) {
+    return;
+  }
+
+  const int max_files = static_cast<int>(CompareSession::kMaxFiles);
+  if (fileNames.size() < 2 || fileNames.size() > max_files) {
+    QMessageBox::warning(this, tr("Compare Files"),
+                         tr("Select between 2 and %1 files to compare.")
+                             .arg(max_files));
+    return;
+  }
+  setCompareFiles(fileNames);
+}
+
+void MainWindow::setCompareFiles(const QStringList& filePaths) {
+  // 对比会话自己持有输出渲染器，先释放单文件播放占用的窗口
+  stopPlayback();
+  closeCompare();
+  player_->Close();
+  progressSlider_->setValue(0);
+  timeLabel_->setText(formatTime(0));
+
+  std::vector<std::string> urls;
+  for (const QString& path : filePaths) {
+    urls.push_back(path.toStdString());
+  }
+  ZENPLAY_INFO("Opening {} files for compare playback", urls.size());
+
+  compareSession_ = std::make_unique<CompareSession>();
+  auto open_result = compareSession_->Open(urls);
+  if (open_result.IsOk()) {
+    void* handle = videoWidget_->getNativeHandle();
+    open_result = compareSession_->SetRenderWindow(
+        handle, videoWidget_->width(), videoWidget_->height());
+  }
+  if (!open_result.IsOk()) {
+    ZENPLAY_ERROR("Failed to start compare playback: {} (ErrorCode: {})",
+                  open_result.Message(), static_cast<int>(open_result.Code()));
+    statusLabel_->setText(
+        tr("Compare failed: %1")
+            .arg(QString::fromStdString(open_result.Message())));
+    QMessageBox::critical(
+        this, tr("Error"),
+        QString::fromStdString("Failed to start compare playback:\n" +
+                               open_result.Message()));
+    closeCompare();
+    updateControlBarState();
+    return;
+  }
+
+  totalDuration_ = compareSession_->GetDuration();
+  durationLabel_->setText(formatTime(totalDuration_));
+  progressSlider_->setMaximum(static_cast<int>(totalDuration_ / 1000));
+  setWindowTitle(tr("ZenPlay - Compare (%1 files)").arg(filePaths.size()));
+
+  auto play_result = compareSession_->Play();
+  if (play_result.IsOk()) {
+    updateTimer_->start();
+    statusLabel_->setText(tr("Comparing %1 files").arg(filePaths.size()));
+  } else {
+    ZENPLAY_ERROR("Compare play failed: {} (ErrorCode: {})",
+                  play_result.Message(), static_cast<int>(play_result.Code()));
+    statusLabel_->setText(
+        tr("Play failed: %1")
+            .arg(QString::fromStdString(play_result.Message())));
+  }
+
+  updateControlBarState();
+}
+
+void MainWindow::closeCompare() {
+  if (!compareSession_) {
+    return;
+  }
+
+  compareSession_->Close();
+  compareSession_.reset();
+  updateTimer_->stop();
+  totalDuration_ = 0;
+  setWindowTitle("ZenPlay Media Player");
+}
+
 void MainWindow::setMediaFile(const QString& filePath) {
   if (!player_) {
     return;
@@ -351,6 +456,7 @@ void MainWindow::setMediaFile(const QString& filePath) {
 
   // Stop current playback and reset progress
   stopPlayback();
+  closeCompare();
   progressSlider_->setValue(0);
   timeLabel_->setText(formatTime(0));  // 使用formatTime格式化0毫秒
 
@@ -424,6 +530,24 @@ void MainWindow::setMediaFile(const QString& filePath) {
 }
 
 void MainWindow::togglePlayPause() {
+  if (isComparing()) {
+    bool playing = compareSession_->IsPlaying();
+    auto result =
+        playing ? compareSession_->Pause() : compareSession_->Play();
+    if (result.IsOk() && playing) {
+      updateTimer_->stop();
+      statusLabel_->setText(tr("Paused"));
+    } else if (result.IsOk()) {
+      updateTimer_->start();
+      statusLabel_->setText(tr("Playing"));
+    } else {
+      statusLabel_->setText(
+          tr("Play failed: %1").arg(QString::fromStdString(result.Message())));
+    }
+    updateControlBarState();
+    return;
+  }
+
   if (!player_) {
     return;
   }
@@ -486,7 +610,11 @@ void MainWindow::stopPlayback() {
     return;
   }
 
-  player_->Stop();
+  if (isComparing()) {
+    compareSession_->Stop();
+  } else {
+    player_->Stop();
+  }
   updateTimer_->stop();
   statusLabel_->setText(tr("Stopped"));
 
@@ -499,6 +627,11 @@ void MainWindow::stopPlayback() {
 
 void MainWindow::onProgressSliderPressed() {
   isDraggingProgress_ = true;
+
+  // ✅ 拖动期间显示关键帧预览，松开时再精确跳转
+  if (player_ && player_->IsOpened()) {
+    player_->BeginScrub();
+  }
 }
 
 void MainWindow::onProgressSliderReleased() {
@@ -506,6 +639,14 @@ void MainWindow::onProgressSliderReleased() {
     return;
   }
 
+  if (isComparing()) {
+    // 对比播放没有拖动预览，松开时所有管线一起跳转
+    compareSession_->SeekAsync(
+        static_cast<int64_t>(progressSlider_->value()) * 1000);
+    isDraggingProgress_ = false;
+    return;
+  }
+
   if (!player_->IsOpened()) {
     isDraggingProgress_ = false;
     return;
@@ -514,8 +655,8 @@ void MainWindow::onProgressSliderReleased() {
   // 计算目标时间（秒转毫秒）
   int64_t seekTime = static_cast<int64_t>(progressSlider_->value()) * 1000;
 
-  // ✅ 异步 Seek，立即返回，不阻塞 UI
-  player_->SeekAsync(seekTime);
+  // ✅ 结束拖动：异步精确 Seek，立即返回，不阻塞 UI
+  player_->EndScrub(seekTime);
 
   // 注意：不在这里显示 "Seeking..." 状态
   // 状态更新由 handlePlayerStateChanged 回调处理
@@ -531,6 +672,10 @@ void MainWindow::onProgressSliderValueChanged(int value) {
   // Update time label while dragging - value是秒，需要转换为毫秒显示
   int64_t timeMs = static_cast<int64_t>(value) * 1000;
   timeLabel_->setText(formatTime(timeMs));
+
+  if (player_ && player_->IsOpened()) {
+    player_->ScrubTo(timeMs);
+  }
 }
 
 void MainWindow::onVolumeSliderValueChanged(int value) {
@@ -552,6 +697,15 @@ void MainWindow::updatePlaybackProgress() {
     return;
   }
 
+  if (isComparing()) {
+    if (compareSession_->IsPlaying()) {
+      updateProgressDisplay(
+          std::min(compareSession_->GetCurrentPlayTime(), totalDuration_),
+          totalDuration_);
+    }
+    return;
+  }
+
   using PlayerState = PlayerStateManager::PlayerState;
   if (player_->GetState() == PlayerState::kPlaying) {
     // 获取真实播放时间（毫秒）
@@ -578,9 +732,11 @@ void MainWindow::updateControlBarState() {
     return;
   }
 
-  bool hasMedia = player_->IsOpened();
   using PlayerState = PlayerStateManager::PlayerState;
-  bool isPlaying = (player_->GetState() == PlayerState::kPlaying);
+  bool hasMedia = player_->IsOpened() || isComparing();
+  bool isPlaying = isComparing()
+                       ? compareSession_->IsPlaying()
+                       : player_->GetState() == PlayerState::kPlaying;
 
   // Update play/pause button
   if (isPlaying) {
@@ -754,13 +910,17 @@ void MainWindow::resizeEvent(QResizeEvent* event) {
   QMainWindow::resizeEvent(event);
 
   // 通知 SDL 渲染器窗口大小变化
-  if (player_ && videoWidget_ && player_->IsOpened()) {
+  if (isComparing() && videoWidget_) {
+    compareSession_->OnWindowResize(videoWidget_->width(),
+                                    videoWidget_->height());
+  } else if (player_ && videoWidget_ && player_->IsOpened()) {
     player_->OnWindowResize(videoWidget_->width(), videoWidget_->height());
   }
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
   stopPlayback();
+  closeCompare();
   event->accept();
 }
 
@@ -951,6 +1111,12 @@ void MainWindow::keyPressEvent(QKeyEvent* event) {
 
     case Qt::Key_Left:
       // 左箭头后退5秒
+      if (isComparing()) {
+        compareSession_->SeekAsync(std::max<int64_t>(
+            0, compareSession_->GetCurrentPlayTime() - 5000));
+        event->accept();
+        return;
+      }
       if (player_ && player_->IsOpened()) {
         int64_t current = player_->GetCurrentPlayTime();
         int64_t target = std::max(0LL, current - 5000);  // 减5秒（毫秒）
@@ -962,6 +1128,12 @@ void MainWindow::keyPressEvent(QKeyEvent* event) {
 
     case Qt::Key_Right:
       // 右箭头前进5秒
+      if (isComparing()) {
+        compareSession_->SeekAsync(std::min(
+            totalDuration_, compareSession_->GetCurrentPlayTime() + 5000));
+        event->accept();
+        return;
+      }
       if (player_ && player_->IsOpened()) {
         int64_t current = player_->GetCurrentPlayTime();
         int64_t duration = player_->GetDuration();
@@ -972,6 +1144,15 @@ void MainWindow::keyPressEvent(QKeyEvent* event) {
       }
       break;
 
+    case Qt::Key_I:
+      // I 键显示/隐藏统计浮层
+      if (player_) {
+        player_->SetStatsOverlayEnabled(!player_->IsStatsOverlayEnabled());
+        event->accept();
+        return;
+      }
+      break;
+
     default:
       break;
   }
@@ -980,6 +1161,19 @@ void MainWindow::keyPressEvent(QKeyEvent* event) {
 }
 
 bool MainWindow::eventFilter(QObject* obj, QEvent* event) {
+  if (obj == progressSlider_ && player_ && player_->IsOpened()) {
+    if (event->type() == QEvent::MouseMove && !isDraggingProgress_) {
+      // 滑块值以秒为单位，与松开时 Seek 的目标位置一致
+      int x = static_cast<QMouseEvent*>(event)->position().toPoint().x();
+      int value = QStyle::sliderValueFromPosition(
+          progressSlider_->minimum(), progressSlider_->maximum(), x,
+          progressSlider_->width());
+      player_->PrefetchSeek(static_cast<int64_t>(value) * 1000);
+    } else if (event->type() == QEvent::Leave) {
+      player_->CancelSeekPrefetch();
+    }
+  }
+
   // 在全屏模式下，监听鼠标移动以显示/隐藏控制栏
   if (isFullscreen_ && event->type() == QEvent::MouseMove) {
     // 鼠标移动时显示控制栏
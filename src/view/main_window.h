@@ -25,6 +25,7 @@
 
 namespace zenplay {
 
+class CompareSession;
 class ZenPlayer;
 
 class VideoDisplayWidget;
@@ -43,6 +44,7 @@ class MainWindow : public QMainWindow {
  private slots:
   void openLocalFile();
   void openNetworkUrl();
+  void openCompareFiles();
   void togglePlayPause();
   void stopPlayback();
   void onProgressSliderPressed();
@@ -68,6 +70,14 @@ class MainWindow : public QMainWindow {
   void setupStatusBar();
   void updateControlBarState();
   void setMediaFile(const QString& filePath);
+
+  /**
+   * @brief 同步对比播放多个文件（2 ~ CompareSession::kMaxFiles 个）
+   * @note 对比期间播放控制、进度条和快捷键都作用于对比会话
+   */
+  void setCompareFiles(const QStringList& filePaths);
+  void closeCompare();
+  bool isComparing() const { return compareSession_ != nullptr; }
   void updateProgressDisplay(int64_t currentTimeMs, int64_t totalTimeMs);
   void resetProgress();
   QString formatTime(int64_t milliseconds) const;  // 格式化毫秒为 HH:MM:SS.mmm
@@ -109,6 +119,7 @@ class MainWindow : public QMainWindow {
   // Menu actions
   QAction* openFileAction_;
   QAction* openUrlAction_;
+  QAction* compareFilesAction_;
   QAction* exitAction_;
   QAction* aboutAction_;
 
@@ -117,6 +128,7 @@ class MainWindow : public QMainWindow {
 
   // Player and timer
   std::unique_ptr<ZenPlayer> player_;
+  std::unique_ptr<CompareSession> compareSession_;  // 对比播放时非空
   QTimer* updateTimer_;
   QTimer* controlBarHideTimer_;  // 全屏时自动隐藏控制栏的定时器
 
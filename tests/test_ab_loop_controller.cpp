@@ -0,0 +1,230 @@
+/**
+ * @file test_ab_loop_controller.cpp
+ * @brief 单元测试 - A-B 循环控制
+ *
+ * 测试目标：
+ * - 第一遍到达 B 点后切换到缓存回放，每一轮的时间戳按区间长度递增
+ * - 回放时把逐轮递增的时钟映射回 A-B 区间
+ * - 缓存超出上限时退回到每轮 Seek：播放到 B 点时请求跳回 A 点
+ * - 退出循环时只有解码已停在 B 点才需要重新跳转
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "player/common/player_state_manager.h"
+#include "player/playback/ab_loop_controller.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+using namespace zenplay;
+using Phase = AbLoopController::Phase;
+
+namespace {
+
+constexpr size_t kMegabyte = 1024 * 1024;
+
+// 64x64 YUV420P，时间基 1/1000
+AVFramePtr MakeVideoFrame(int64_t pts_ms, MediaTimestamp* timestamp) {
+  AVFramePtr frame(av_frame_alloc());
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = 64;
+  frame->height = 64;
+  EXPECT_EQ(av_frame_get_buffer(frame.get(), 0), 0);
+
+  timestamp->time_base = {1, 1000};
+  timestamp->pts = pts_ms;
+  timestamp->dts = pts_ms;
+  frame->pts = pts_ms;
+  frame->pkt_dts = pts_ms;
+  return frame;
+}
+
+/**
+ * @brief 记录循环线程推送的帧和跳转请求
+ */
+class LoopHarness {
+ public:
+  explicit LoopHarness(size_t max_cache_bytes) {
+    state_manager_.TransitionToOpening();
+    state_manager_.TransitionToStopped();
+    state_manager_.TransitionToPlaying();
+
+    AbLoopController::Callbacks callbacks;
+    callbacks.push_video = [this](AVFramePtr frame,
+                                  const MediaTimestamp& timestamp,
+                                  int /*timeout_ms*/) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (pushed_pts_.size() >= max_pushed_) {
+        // 模拟队列已满：短暂等待后让循环线程重试
+        cv_.wait_for(lock, std::chrono::milliseconds(5));
+        return false;
+      }
+      pushed_pts_.push_back(timestamp.pts);
+      cv_.notify_all();
+      return frame != nullptr;
+    };
+    callbacks.push_audio = [](ResampledAudioFrame, int) { return true; };
+    callbacks.current_time_ms = [this]() { return clock_ms_.load(); };
+    callbacks.seek_to_start = [this](int64_t start_ms) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      seek_requests_.push_back(start_ms);
+      cv_.notify_all();
+    };
+    callbacks.replay_changed = [this]() { ++replay_changes_; };
+
+    loop_ = std::make_unique<AbLoopController>(
+        &state_manager_, max_cache_bytes, true, false, std::move(callbacks));
+  }
+
+  ~LoopHarness() { loop_.reset(); }
+
+  AbLoopController& loop() { return *loop_; }
+
+  // 按解码线程的方式送入 [from_ms, to_ms] 的帧，返回应推送的帧数
+  int DecodeRange(int64_t from_ms, int64_t to_ms, int64_t step_ms) {
+    int accepted = 0;
+    for (int64_t pts = from_ms; pts <= to_ms; pts += step_ms) {
+      MediaTimestamp timestamp;
+      AVFramePtr frame = MakeVideoFrame(pts, &timestamp);
+      if (loop_->AcceptVideoFrame(frame.get(), timestamp)) {
+        ++accepted;
+      }
+    }
+    return accepted;
+  }
+
+  std::vector<int64_t> WaitForPushed(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    max_pushed_ = count;
+    cv_.wait_for(lock, std::chrono::seconds(5),
+                 [&]() { return pushed_pts_.size() >= count; });
+    return pushed_pts_;
+  }
+
+  std::vector<int64_t> WaitForSeekRequest() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, std::chrono::seconds(5),
+                 [&]() { return !seek_requests_.empty(); });
+    return seek_requests_;
+  }
+
+  void SetClock(int64_t clock_ms) { clock_ms_.store(clock_ms); }
+  int replay_changes() const { return replay_changes_.load(); }
+
+ private:
+  PlayerStateManager state_manager_;
+  std::unique_ptr<AbLoopController> loop_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t max_pushed_ = 0;
+  std::vector<int64_t> pushed_pts_;
+  std::vector<int64_t> seek_requests_;
+  std::atomic<int64_t> clock_ms_{0};
+  std::atomic<int> replay_changes_{0};
+};
+
+}  // namespace
+
+TEST(AbLoopControllerTest, ReplaysCachedPassWithIncreasingTimestamps) {
+  LoopHarness harness(64 * kMegabyte);
+  AbLoopController& loop = harness.loop();
+
+  loop.SetRange(1000, 1200);
+  EXPECT_EQ(loop.phase(), Phase::kWaitingSeek);
+  loop.BeginPass();
+  ASSERT_EQ(loop.phase(), Phase::kRecording);
+
+  // A 点之前的帧照常显示；1000..1160 缓存并显示；1200 越过 B 点
+  EXPECT_EQ(harness.DecodeRange(960, 1160, 40), 6);
+  EXPECT_EQ(harness.DecodeRange(1200, 1240, 40), 0);
+  ASSERT_EQ(loop.phase(), Phase::kReplaying);
+  EXPECT_EQ(harness.replay_changes(), 2);  // SetRange + 进入回放
+
+  // 第 1、2 轮：原始时间戳 + n * 200ms
+  std::vector<int64_t> pushed = harness.WaitForPushed(10);
+  ASSERT_GE(pushed.size(), 10u);
+  const int64_t expected[] = {1200, 1240, 1280, 1320, 1360,
+                              1400, 1440, 1480, 1520, 1560};
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(pushed[i], expected[i]) << "frame " << i;
+  }
+
+  // 回放中解码线程残留的帧不再推送
+  EXPECT_EQ(harness.DecodeRange(1000, 1040, 40), 0);
+
+  loop.Disable();
+  EXPECT_FALSE(loop.IsActive());
+  EXPECT_EQ(harness.replay_changes(), 3);
+}
+
+TEST(AbLoopControllerTest, MapsReplayClockIntoRange) {
+  LoopHarness harness(64 * kMegabyte);
+  AbLoopController& loop = harness.loop();
+
+  loop.SetRange(1000, 1200);
+  loop.BeginPass();
+  EXPECT_EQ(loop.MapReplayClock(1450), 1450);  // 第一遍不映射
+
+  harness.DecodeRange(1000, 1200, 40);
+  ASSERT_TRUE(loop.IsReplaying());
+  EXPECT_EQ(loop.MapReplayClock(900), 900);
+  EXPECT_EQ(loop.MapReplayClock(1150), 1150);
+  EXPECT_EQ(loop.MapReplayClock(1450), 1050);
+  EXPECT_EQ(loop.MapReplayClock(2000), 1000);
+}
+
+TEST(AbLoopControllerTest, FallsBackToSeekingWhenCacheOverflows) {
+  // 上限小于一帧：第一帧就使缓存失效
+  LoopHarness harness(1024);
+  AbLoopController& loop = harness.loop();
+
+  loop.SetRange(1000, 1200);
+  loop.BeginPass();
+  // 缓存失效后照常显示，包括越过 B 点的帧（由循环线程跳回）
+  EXPECT_EQ(harness.DecodeRange(1000, 1240, 40), 7);
+  ASSERT_EQ(loop.phase(), Phase::kSeekFallback);
+
+  harness.SetClock(1210);
+  std::vector<int64_t> seeks = harness.WaitForSeekRequest();
+  ASSERT_EQ(seeks.size(), 1u);
+  EXPECT_EQ(seeks[0], 1000);
+  EXPECT_EQ(loop.phase(), Phase::kWaitingSeek);
+
+  // 之后每一轮都直接进入退回模式，不再尝试缓存
+  harness.SetClock(1000);
+  loop.BeginPass();
+  EXPECT_EQ(loop.phase(), Phase::kSeekFallback);
+}
+
+TEST(AbLoopControllerTest, ClearRequestsReseekOnlyAfterDecodingStopped) {
+  LoopHarness harness(64 * kMegabyte);
+  AbLoopController& loop = harness.loop();
+
+  EXPECT_FALSE(loop.ClearRange());  // 未开启
+
+  // 第一遍中途退出：解码仍在进行，不需要跳转
+  loop.SetRange(1000, 1200);
+  loop.BeginPass();
+  harness.DecodeRange(1000, 1080, 40);
+  EXPECT_FALSE(loop.ClearRange());
+  EXPECT_FALSE(loop.IsActive());
+
+  // 回放中退出：解码停在 B 点，需要从当前位置重新跳转
+  loop.SetRange(1000, 1200);
+  loop.BeginPass();
+  harness.DecodeRange(1000, 1200, 40);
+  ASSERT_TRUE(loop.IsReplaying());
+  EXPECT_TRUE(loop.ClearRange());
+  EXPECT_FALSE(loop.IsActive());
+  EXPECT_FALSE(loop.IsReplaying());
+}
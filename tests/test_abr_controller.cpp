@@ -0,0 +1,174 @@
+/**
+ * @file test_abr_controller.cpp
+ * @brief 单元测试 - ThroughputEstimator / AbrController 自适应码率
+ *
+ * 测试目标：
+ * - 吞吐量估计（零偏修正、带宽下降时快速响应）
+ * - 小样本过滤、Seek 丢弃未成样本的累计量
+ * - 升档条件（缓冲水位、切换间隔、每次只升一档）
+ * - 降档条件（带宽不足立即降档、缓冲告急直接降到最低档）
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "player/demuxer/abr_controller.h"
+
+using namespace zenplay;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 三档：500k / 1500k / 4000k
+std::vector<AbrController::Variant> MakeVariants() {
+  return {{2, 4000000, 1920, 1080},
+          {0, 500000, 640, 360},
+          {1, 1500000, 1280, 720}};
+}
+
+// 模拟以指定带宽下载一个分片（2 秒耗时）
+void FeedSegment(AbrController& abr, double kbps) {
+  const double duration_ms = 2000.0;
+  uint64_t bytes =
+      static_cast<uint64_t>(kbps * 1000.0 / 8.0 * duration_ms / 1000.0);
+  abr.OnPacketRead(bytes, duration_ms);
+}
+
+}  // namespace
+
+// ============================================================================
+// 吞吐量估计
+// ============================================================================
+
+TEST(ThroughputEstimatorTest, NoSampleNoEstimate) {
+  ThroughputEstimator estimator;
+  EXPECT_FALSE(estimator.HasEstimate());
+  EXPECT_DOUBLE_EQ(estimator.GetEstimateKbps(), 0.0);
+}
+
+TEST(ThroughputEstimatorTest, FirstSampleIsUnbiased) {
+  ThroughputEstimator estimator;
+  // 125000 字节 / 1 秒 = 1000 kbps
+  estimator.AddSample(125000, 1000.0);
+  EXPECT_TRUE(estimator.HasEstimate());
+  EXPECT_NEAR(estimator.GetEstimateKbps(), 1000.0, 1.0);
+  EXPECT_EQ(estimator.total_bytes(), 125000u);
+}
+
+TEST(ThroughputEstimatorTest, ReactsQuicklyToBandwidthDrop) {
+  ThroughputEstimator estimator;
+  for (int i = 0; i < 10; ++i) {
+    estimator.AddSample(1250000, 1000.0);  // 10 Mbps
+  }
+  EXPECT_NEAR(estimator.GetEstimateKbps(), 10000.0, 10.0);
+
+  estimator.AddSample(125000, 1000.0);  // 1 Mbps
+  // 取快/慢 EWMA 的较小值，一个样本后估计值就应明显下降
+  EXPECT_LT(estimator.GetEstimateKbps(), 8000.0);
+}
+
+TEST(ThroughputEstimatorTest, IgnoresZeroDuration) {
+  ThroughputEstimator estimator;
+  estimator.AddSample(1000, 0.0);
+  EXPECT_FALSE(estimator.HasEstimate());
+}
+
+// ============================================================================
+// 档位决策
+// ============================================================================
+
+TEST(AbrControllerTest, NoSwitchWithoutEstimate) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+  EXPECT_EQ(abr.OnSegmentBoundary(20000.0), 0);
+}
+
+TEST(AbrControllerTest, SmallSamplesAreAccumulated) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+
+  // 小于 min_sample_bytes，不应形成样本
+  abr.OnPacketRead(1000, 1.0);
+  abr.OnSegmentBoundary(20000.0);
+  EXPECT_DOUBLE_EQ(abr.throughput_kbps(), 0.0);
+
+  // 继续累计到足够大
+  abr.OnPacketRead(100000, 100.0);
+  abr.OnSegmentBoundary(20000.0);
+  EXPECT_GT(abr.throughput_kbps(), 0.0);
+}
+
+TEST(AbrControllerTest, SeekDiscardsPartialSegment) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+
+  // Seek 前读到的半个分片不能和 Seek 后的数据拼成一个样本
+  abr.OnPacketRead(100000, 100.0);
+  abr.OnSeek();
+  abr.OnPacketRead(1000, 1.0);
+  abr.OnSegmentBoundary(20000.0);
+  EXPECT_DOUBLE_EQ(abr.throughput_kbps(), 0.0);
+}
+
+TEST(AbrControllerTest, UpswitchOneStepWithEnoughBuffer) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+  auto now = std::chrono::steady_clock::now();
+
+  FeedSegment(abr, 10000.0);
+  // 带宽足够支撑最高档，但每次只升一档
+  int target = abr.OnSegmentBoundary(20000.0, now);
+  EXPECT_EQ(target, 1);
+  abr.CommitSwitch(target, now);
+
+  // 切换间隔不足，保持不变
+  FeedSegment(abr, 10000.0);
+  EXPECT_EQ(abr.OnSegmentBoundary(20000.0, now + 1s), 1);
+
+  // 间隔满足后继续升档
+  FeedSegment(abr, 10000.0);
+  EXPECT_EQ(abr.OnSegmentBoundary(20000.0, now + 5s), 2);
+}
+
+TEST(AbrControllerTest, NoUpswitchWithLowBuffer) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+
+  FeedSegment(abr, 10000.0);
+  EXPECT_EQ(abr.OnSegmentBoundary(5000.0), 0);
+}
+
+TEST(AbrControllerTest, DownswitchWhenBandwidthDrops) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 2);
+  auto now = std::chrono::steady_clock::now();
+
+  // 1500 kbps * 0.8 = 1200 kbps，只能支撑 500k 档位
+  FeedSegment(abr, 1500.0);
+  EXPECT_EQ(abr.OnSegmentBoundary(20000.0, now), 0);
+
+  // 2500 kbps * 0.8 = 2000 kbps，可支撑 1500k 档位，降档无需等待间隔
+  AbrController abr2;
+  abr2.SetVariants(MakeVariants(), 2);
+  FeedSegment(abr2, 2500.0);
+  EXPECT_EQ(abr2.OnSegmentBoundary(20000.0, now), 1);
+}
+
+TEST(AbrControllerTest, PanicBufferDropsToLowest) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 2);
+
+  FeedSegment(abr, 10000.0);
+  EXPECT_EQ(abr.OnSegmentBoundary(1000.0), 0);
+}
+
+TEST(AbrControllerTest, CommitSwitchCounts) {
+  AbrController abr;
+  abr.SetVariants(MakeVariants(), 0);
+  abr.CommitSwitch(0);
+  EXPECT_EQ(abr.switch_count(), 0u);
+  abr.CommitSwitch(1);
+  EXPECT_EQ(abr.current_variant(), 1);
+  EXPECT_EQ(abr.switch_count(), 1u);
+}
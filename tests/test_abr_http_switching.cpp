@@ -0,0 +1,341 @@
+/**
+ * @file test_abr_http_switching.cpp
+ * @brief 集成测试 - 真实 HTTP 下载驱动的自适应码率切换
+ *
+ * 测试目标：
+ * - 链路带宽充足时逐档升到最高码率
+ * - 链路被限速后在一两个分片内降档
+ *
+ * 使用本地 HTTP 服务器提供三个码率档位的分片，按设定的链路速率限速发送；
+ * 下载侧与 DemuxTask 一致：每次读取调用 OnPacketRead()，
+ * 分片结束时调用 OnSegmentBoundary()
+ */
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "player/demuxer/abr_controller.h"
+
+using namespace zenplay;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int64_t kSegmentMs = 250;      // 每个分片的媒体时长
+constexpr double kFastLinkBytesPerSec = 2e6;    // 16 Mbps，足以支撑最高档
+constexpr double kSlowLinkBytesPerSec = 100e3;  // 800 kbps，撑不起最高档
+constexpr size_t kSendChunk = 4096;
+
+// 三档：400k / 1200k / 3200k
+std::vector<AbrController::Variant> MakeVariants() {
+  return {{0, 400000, 640, 360},
+          {1, 1200000, 1280, 720},
+          {2, 3200000, 1920, 1080}};
+}
+
+size_t SegmentBytes(int variant_id) {
+  for (const auto& variant : MakeVariants()) {
+    if (variant.id == variant_id) {
+      return static_cast<size_t>(variant.bandwidth_bps / 8 * kSegmentMs /
+                                 1000);
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief 按链路速率限速发送分片的 HTTP 服务器
+ *
+ * 路径形如 /v<id>/seg<n>.ts，分片大小 = 档位码率 * 分片时长
+ */
+class ThrottledSegmentServer {
+ public:
+  ~ThrottledSegmentServer() { Stop(); }
+
+  /**
+   * @return 监听端口，失败返回 0
+   */
+  int Start() {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) < 0 ||
+        listen(listen_fd_, 4) < 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) <
+            0) {
+      return 0;
+    }
+    thread_ = std::thread([this]() { Serve(); });
+    return ntohs(addr.sin_port);
+  }
+
+  void Stop() {
+    stop_.store(true);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+    }
+  }
+
+  void SetLinkRate(double bytes_per_second) {
+    link_bytes_per_s_.store(bytes_per_second);
+  }
+
+  std::set<int> served_variants() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return served_variants_;
+  }
+
+ private:
+  bool WaitReadable(int fd) {
+    while (!stop_.load()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (poll(&pfd, 1, 50) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Serve() {
+    while (WaitReadable(listen_fd_)) {
+      int client_fd = accept(listen_fd_, nullptr, nullptr);
+      if (client_fd < 0) {
+        continue;
+      }
+      HandleRequest(client_fd);
+      close(client_fd);
+    }
+  }
+
+  void HandleRequest(int client_fd) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           WaitReadable(client_fd)) {
+      ssize_t n = recv(client_fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        return;
+      }
+      request.append(buffer, static_cast<size_t>(n));
+    }
+
+    int variant_id = -1;
+    if (sscanf(request.c_str(), "GET /v%d/", &variant_id) != 1 ||
+        SegmentBytes(variant_id) == 0) {
+      SendAll(client_fd, "HTTP/1.1 404 Not Found\r\n"
+                         "Content-Length: 0\r\nConnection: close\r\n\r\n");
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      served_variants_.insert(variant_id);
+    }
+
+    size_t body_size = SegmentBytes(variant_id);
+    SendAll(client_fd, "HTTP/1.1 200 OK\r\nContent-Type: video/mp2t\r\n"
+                       "Content-Length: " + std::to_string(body_size) +
+                           "\r\nConnection: close\r\n\r\n");
+
+    // 令牌桶式限速：第 sent 字节不早于 start + sent / rate 发出
+    std::string chunk(kSendChunk, '\x47');
+    auto start = Clock::now();
+    size_t sent = 0;
+    while (sent < body_size && !stop_.load()) {
+      size_t n = std::min(kSendChunk, body_size - sent);
+      if (!SendAll(client_fd, chunk.substr(0, n))) {
+        return;
+      }
+      sent += n;
+      std::chrono::duration<double> due(sent / link_bytes_per_s_.load());
+      std::this_thread::sleep_until(
+          start + std::chrono::duration_cast<Clock::duration>(due));
+    }
+  }
+
+  static bool SendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n =
+          send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (n <= 0) {
+        return false;
+      }
+      sent += static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  int listen_fd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::atomic<double> link_bytes_per_s_{kFastLinkBytesPerSec};
+  mutable std::mutex mutex_;
+  std::set<int> served_variants_;
+  std::thread thread_;
+};
+
+AbrController::Config TestConfig() {
+  // 分片很短，按比例缩小缓冲门限；关闭缓冲告急，只验证带宽驱动的切换
+  AbrController::Config config;
+  config.min_buffer_for_upswitch_ms = 200.0;
+  config.panic_buffer_ms = 0.0;
+  config.min_switch_interval_ms = 0.0;
+  config.min_sample_bytes = 4096;
+  config.min_sample_duration_ms = 1.0;
+  return config;
+}
+
+/**
+ * @brief 播放会话：顺序下载分片，在分片边界做档位决策
+ */
+class AbrSession {
+ public:
+  explicit AbrSession(int port) : port_(port), abr_(TestConfig()) {
+    abr_.SetVariants(MakeVariants(), 0);
+  }
+
+  /**
+   * @brief 下载当前档位的下一个分片，返回分片边界决定的档位
+   * @return 下载失败返回 -1
+   */
+  int Step() {
+    if (!FetchSegment(abr_.current_variant(), segment_++)) {
+      return -1;
+    }
+    downloaded_ms_ += kSegmentMs;
+
+    // 缓冲水位 = 已下载的媒体时长 - 已播放的时长（从第一次下载开始计时）
+    double played_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start_)
+            .count();
+    double buffer_ms =
+        std::max(0.0, static_cast<double>(downloaded_ms_) - played_ms);
+    int target = abr_.OnSegmentBoundary(buffer_ms);
+    abr_.CommitSwitch(target);
+    return target;
+  }
+
+  const AbrController& abr() const { return abr_; }
+
+ private:
+  bool FetchSegment(int variant_id, int index) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+      return false;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(port_));
+    std::string request = "GET /v" + std::to_string(variant_id) + "/seg" +
+                          std::to_string(index) +
+                          ".ts HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        send(fd, request.data(), request.size(), MSG_NOSIGNAL) < 0) {
+      close(fd);
+      return false;
+    }
+
+    // 与 DemuxTask 一致：每次读取累计字节数和阻塞耗时
+    std::string response;
+    char buffer[16 * 1024];
+    while (true) {
+      auto read_start = Clock::now();
+      ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        break;
+      }
+      abr_.OnPacketRead(
+          static_cast<uint64_t>(n),
+          std::chrono::duration<double, std::milli>(Clock::now() - read_start)
+              .count());
+      response.append(buffer, static_cast<size_t>(n));
+    }
+    close(fd);
+
+    size_t header_end = response.find("\r\n\r\n");
+    return response.compare(0, 12, "HTTP/1.1 200") == 0 &&
+           header_end != std::string::npos &&
+           response.size() - header_end - 4 == SegmentBytes(variant_id);
+  }
+
+  int port_;
+  AbrController abr_;
+  int segment_ = 0;
+  int64_t downloaded_ms_ = 0;
+  Clock::time_point start_ = Clock::now();
+};
+
+}  // namespace
+
+TEST(AbrHttpSwitchingTest, ClimbsOneRenditionPerSegmentOnFastLink) {
+  ThrottledSegmentServer server;
+  int port = server.Start();
+  ASSERT_NE(port, 0);
+
+  AbrSession session(port);
+  std::vector<int> path = {0};
+  for (int i = 0; i < 6; ++i) {
+    int target = session.Step();
+    ASSERT_GE(target, 0);
+    path.push_back(target);
+  }
+
+  // 每个分片最多升一档，最终稳定在最高档
+  for (size_t i = 1; i < path.size(); ++i) {
+    EXPECT_GE(path[i], path[i - 1]);
+    EXPECT_LE(path[i], path[i - 1] + 1);
+  }
+  EXPECT_EQ(path.back(), 2);
+  EXPECT_EQ(session.abr().switch_count(), 2u);
+  EXPECT_EQ(server.served_variants(), (std::set<int>{0, 1, 2}));
+}
+
+TEST(AbrHttpSwitchingTest, FallsBackWhenLinkIsThrottled) {
+  ThrottledSegmentServer server;
+  int port = server.Start();
+  ASSERT_NE(port, 0);
+
+  AbrSession session(port);
+  for (int i = 0; i < 6 && session.abr().current_variant() != 2; ++i) {
+    ASSERT_GE(session.Step(), 0);
+  }
+  ASSERT_EQ(session.abr().current_variant(), 2);
+  uint64_t switches_before = session.abr().switch_count();
+
+  // 限速到 800 kbps：最高档一个分片要下载 1 秒，估计带宽随之下降
+  server.SetLinkRate(kSlowLinkBytesPerSec);
+  int target = 2;
+  for (int i = 0; i < 3 && target == 2; ++i) {
+    target = session.Step();
+    ASSERT_GE(target, 0);
+  }
+
+  EXPECT_LT(target, 2);
+  EXPECT_GT(session.abr().switch_count(), switches_before);
+  EXPECT_LT(session.abr().throughput_kbps(), 3200.0 / 0.8);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file test_alloc_tracker.cpp
+ * @brief 单元测试 - 堆分配跟踪
+ *
+ * 测试目标：
+ * - 分配计入当前线程标记的阶段，未标记线程计入 kUntagged
+ * - 运行期关闭时不计数
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "player/stats/alloc_tracker.h"
+
+using namespace zenplay::stats;
+using Thread = WakeupStats::Thread;
+
+namespace {
+
+class AllocTrackerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    AllocTracker::Reset();
+    AllocTracker::SetEnabled(true);
+  }
+
+  void TearDown() override {
+    AllocTracker::SetEnabled(false);
+    AllocTracker::Reset();
+  }
+};
+
+size_t Slot(Thread thread) {
+  return static_cast<size_t>(thread);
+}
+
+}  // namespace
+
+TEST_F(AllocTrackerTest, AttributesToTaggedThread) {
+  std::thread demux([] {
+    STATS_ALLOC_THREAD(kDemux);
+    AllocTracker::RecordAlloc(100);
+    AllocTracker::RecordAlloc(28);
+    AllocTracker::RecordFree();
+  });
+  demux.join();
+
+  std::thread untagged([] { AllocTracker::RecordAlloc(64); });
+  untagged.join();
+
+  auto snapshot = AllocTracker::GetSnapshot();
+  EXPECT_EQ(snapshot.allocs[Slot(Thread::kDemux)], 2u);
+  EXPECT_EQ(snapshot.bytes[Slot(Thread::kDemux)], 128u);
+  // 编译了 operator new 钩子时 std::thread 自身的分配 / 释放也会计入
+  EXPECT_GE(snapshot.frees[Slot(Thread::kDemux)], 1u);
+  EXPECT_GE(snapshot.allocs[AllocTracker::kUntagged], 1u);
+  EXPECT_GE(snapshot.bytes[AllocTracker::kUntagged], 64u);
+  EXPECT_EQ(snapshot.allocs[Slot(Thread::kVideoDecode)], 0u);
+}
+
+TEST_F(AllocTrackerTest, DisabledDoesNotCount) {
+  AllocTracker::SetEnabled(false);
+  std::thread worker([] {
+    STATS_ALLOC_THREAD(kVideoDecode);
+    AllocTracker::RecordAlloc(256);
+  });
+  worker.join();
+
+  auto snapshot = AllocTracker::GetSnapshot();
+  EXPECT_EQ(snapshot.allocs[Slot(Thread::kVideoDecode)], 0u);
+}
@@ -0,0 +1,429 @@
+/**
+ * @file test_av_sync_accuracy.cpp
+ * @brief 端到端测量 - 闪光 / 蜂鸣测试流的实际音视频偏差
+ *
+ * 测试目标：
+ * - 合成测试流每 500ms 一个事件：视频是一帧白场（闪光），音频是一段
+ *   1kHz 蜂鸣的起点
+ * - 帧和 PCM 经过真实的 VideoPlayer / AudioPlayer / AVSyncController；
+ *   捕获渲染器记录闪光帧的呈现时刻，捕获音频设备按声卡速率消费数据并
+ *   记录蜂鸣起点的输出时刻
+ * - 按同步模式统计每个事件的实际偏差（视频呈现 - 声音输出），要求落在
+ *   ITU-R BT.1359 的可接受范围内
+ *
+ * 不经过解封装 / 解码：测量的是同步控制和呈现路径本身的误差。
+ *
+ * ⏱️ 按真实时间播放。默认只运行一个短用例（音频主时钟，3 个事件，约
+ * 2 秒），只检查偏差中位数落在可接受范围内，容忍 CI 负载造成的个别
+ * 事件抖动；三种模式的完整测量（每种约 3.5 秒，按可察觉范围检查）
+ * 默认禁用（DISABLED_），手动运行：
+ *   zenplay_tests --gtest_also_run_disabled_tests
+ *                 --gtest_filter=*AVSyncAccuracyTest*
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include "player/audio/audio_output.h"
+#include "player/audio/audio_player.h"
+#include "player/common/player_state_manager.h"
+#include "player/sync/av_sync_controller.h"
+#include "player/video/render/renderer.h"
+#include "player/video/video_player.h"
+
+using namespace zenplay;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kFrameRate = 30;
+constexpr int kSampleRate = 44100;
+constexpr int kEventIntervalMs = 500;
+constexpr int kEventCount = 6;       // 完整测量的事件数
+constexpr int kShortEventCount = 3;  // 默认运行的短用例
+constexpr int kFramesPerEvent = kFrameRate * kEventIntervalMs / 1000;
+constexpr int kSamplesPerEvent = kSampleRate * kEventIntervalMs / 1000;
+constexpr int kBeepSamples = kSampleRate / 10;  // 蜂鸣持续 100ms
+constexpr int kSamplesPerFrame = 1024;          // 每个 PCM 帧的采样数
+constexpr int kFrameSize = 64;
+constexpr double kPi = 3.14159265358979323846;
+
+// ITU-R BT.1359：正值表示声音超前画面
+constexpr double kDetectableSoundEarlyMs = 45.0;
+constexpr double kDetectableSoundLateMs = -125.0;
+constexpr double kAcceptableSoundEarlyMs = 90.0;
+constexpr double kAcceptableSoundLateMs = -185.0;
+
+Clock::duration ToDuration(double seconds) {
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(seconds));
+}
+
+/**
+ * @brief 捕获渲染器：记录每个闪光帧的呈现时刻
+ */
+class CaptureRenderer : public Renderer {
+ public:
+  Result<void> Init(void* /*window_handle*/,
+                    int /*width*/,
+                    int /*height*/) override {
+    return Result<void>::Ok();
+  }
+
+  bool RenderFrame(AVFrame* frame) override {
+    auto now = Clock::now();
+    if (frame->data[0][0] > 128) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flashes_.emplace(frame->pts / kFramesPerEvent, now);
+    }
+    return true;
+  }
+
+  void Clear() override {}
+  void Present() override {}
+  void OnResize(int /*width*/, int /*height*/) override {}
+  void Cleanup() override {}
+  const char* GetRendererName() const override { return "Capture"; }
+  void ClearCaches() override {}
+
+  // 事件序号 → 闪光帧的呈现时刻（被丢弃的闪光帧没有记录）
+  std::map<int64_t, Clock::time_point> flashes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flashes_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<int64_t, Clock::time_point> flashes_;
+};
+
+/**
+ * @brief 捕获音频设备：按声卡速率拉取数据，记录蜂鸣起点的输出时刻
+ *
+ * 模拟双缓冲声卡：第 n 个周期的回调在 n * period 时刻触发，回调填充的
+ * 数据在上一个周期播完后（(n + 1) * period）开始输出。
+ */
+class CaptureAudioOutput : public AudioOutput {
+ public:
+  ~CaptureAudioOutput() override { Cleanup(); }
+
+  Result<void> Init(const AudioSpec& spec,
+                    AudioOutputCallback callback,
+                    void* user_data) override {
+    spec_ = spec;
+    callback_ = std::move(callback);
+    user_data_ = user_data;
+    return Result<void>::Ok();
+  }
+
+  Result<void> Start() override {
+    running_ = true;
+    thread_ = std::thread(&CaptureAudioOutput::DeviceThread, this);
+    return Result<void>::Ok();
+  }
+
+  void Stop() override {
+    running_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void Pause() override {}
+  void Resume() override {}
+  void SetVolume(float volume) override { volume_ = volume; }
+  float GetVolume() const override { return volume_; }
+  void Cleanup() override { Stop(); }
+  const char* GetDeviceName() const override { return "Capture"; }
+  bool IsPlaying() const override { return running_; }
+  void Flush() override {}
+
+  // 按出现顺序排列的蜂鸣起点输出时刻
+  std::vector<Clock::time_point> onsets() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return onsets_;
+  }
+
+ private:
+  void DeviceThread() {
+    const int frame_bytes = spec_.channels * (spec_.bits_per_sample / 8);
+    const double period_s =
+        static_cast<double>(spec_.buffer_size) / spec_.sample_rate;
+    std::vector<uint8_t> buffer(
+        static_cast<size_t>(spec_.buffer_size) * frame_bytes);
+
+    const auto start = Clock::now();
+    for (int64_t n = 0; running_; ++n) {
+      // 声卡按固定速率消费：回调迟到不改变数据的输出时刻
+      std::this_thread::sleep_until(start + ToDuration(period_s * n));
+      callback_(user_data_, buffer.data(), static_cast<int>(buffer.size()));
+      ScanForOnsets(buffer, start + ToDuration(period_s * (n + 1)));
+    }
+  }
+
+  // 检测左声道从静音进入蜂鸣的采样点
+  void ScanForOnsets(const std::vector<uint8_t>& buffer,
+                     Clock::time_point output_start) {
+    constexpr int kThreshold = 1000;
+    constexpr int kQuietToRearm = kSampleRate / 20;  // 50ms 静音后重新检测
+
+    const size_t frames = buffer.size() / (spec_.channels * sizeof(int16_t));
+    for (size_t i = 0; i < frames; ++i) {
+      int16_t sample = 0;
+      std::memcpy(&sample, buffer.data() + i * spec_.channels * sizeof(int16_t),
+                  sizeof(sample));
+      if (std::abs(sample) < kThreshold) {
+        ++quiet_run_;
+        continue;
+      }
+      if (quiet_run_ >= kQuietToRearm) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        onsets_.push_back(output_start +
+                          ToDuration(static_cast<double>(i) / kSampleRate));
+      }
+      quiet_run_ = 0;
+    }
+  }
+
+  AudioSpec spec_;
+  AudioOutputCallback callback_;
+  void* user_data_ = nullptr;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  float volume_ = 1.0f;
+
+  int quiet_run_ = kSampleRate;  // 开始时视为已静音足够久
+  mutable std::mutex mutex_;
+  std::vector<Clock::time_point> onsets_;
+};
+
+AVFramePtr MakeVideoFrame(int64_t index) {
+  AVFramePtr frame(av_frame_alloc());
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = kFrameSize;
+  frame->height = kFrameSize;
+  if (av_frame_get_buffer(frame.get(), 0) < 0) {
+    return nullptr;
+  }
+  // 事件帧为白场，其余为黑场
+  uint8_t luma = index % kFramesPerEvent == 0 ? 235 : 16;
+  for (int y = 0; y < kFrameSize; ++y) {
+    std::memset(frame->data[0] + y * frame->linesize[0], luma, kFrameSize);
+  }
+  for (int plane = 1; plane < 3; ++plane) {
+    for (int y = 0; y < kFrameSize / 2; ++y) {
+      std::memset(frame->data[plane] + y * frame->linesize[plane], 128,
+                  kFrameSize / 2);
+    }
+  }
+  frame->pts = index;
+  frame->duration = 1;
+  return frame;
+}
+
+ResampledAudioFrame MakeAudioFrame(int64_t index) {
+  ResampledAudioFrame frame;
+  frame.sample_rate = kSampleRate;
+  frame.channels = 2;
+  frame.bytes_per_sample = sizeof(int16_t);
+  frame.sample_count = kSamplesPerFrame;
+  frame.pts_ms = std::llround(index * kSamplesPerFrame * 1000.0 / kSampleRate);
+  frame.pcm_data.resize(kSamplesPerFrame * 2 * sizeof(int16_t));
+
+  auto* samples = reinterpret_cast<int16_t*>(frame.pcm_data.data());
+  for (int i = 0; i < kSamplesPerFrame; ++i) {
+    int64_t position = index * kSamplesPerFrame + i;
+    int64_t in_event = position % kSamplesPerEvent;
+    int16_t value = 0;
+    if (in_event < kBeepSamples) {
+      // 从正弦的峰值开始，起点落在第一个采样上
+      value = static_cast<int16_t>(
+          8000 * std::cos(2.0 * kPi * 1000.0 * in_event / kSampleRate));
+    }
+    samples[2 * i] = value;
+    samples[2 * i + 1] = value;
+  }
+  return frame;
+}
+
+struct OffsetStats {
+  std::vector<double> offsets_ms;  // 每个事件：正值表示声音超前画面
+  double mean_ms = 0.0;
+  double median_ms = 0.0;
+  double p95_abs_ms = 0.0;
+  double max_abs_ms = 0.0;
+};
+
+OffsetStats Summarize(std::vector<double> offsets_ms) {
+  OffsetStats stats;
+  stats.offsets_ms = offsets_ms;
+  if (offsets_ms.empty()) {
+    return stats;
+  }
+
+  double sum = 0.0;
+  std::vector<double> magnitudes;
+  for (double offset : offsets_ms) {
+    sum += offset;
+    magnitudes.push_back(std::abs(offset));
+  }
+  stats.mean_ms = sum / offsets_ms.size();
+
+  std::sort(offsets_ms.begin(), offsets_ms.end());
+  size_t mid = offsets_ms.size() / 2;
+  stats.median_ms = offsets_ms.size() % 2
+                        ? offsets_ms[mid]
+                        : (offsets_ms[mid - 1] + offsets_ms[mid]) / 2.0;
+
+  std::sort(magnitudes.begin(), magnitudes.end());
+  size_t p95 = static_cast<size_t>(std::ceil(0.95 * magnitudes.size())) - 1;
+  stats.p95_abs_ms = magnitudes[p95];
+  stats.max_abs_ms = magnitudes.back();
+  return stats;
+}
+
+/**
+ * @brief 以指定同步模式播放 event_count 个事件的测试流，返回每个事件的
+ *        实际偏差
+ */
+OffsetStats MeasureSyncAccuracy(AVSyncController::SyncMode mode,
+                                int event_count = kEventCount) {
+  PlayerStateManager state_manager;
+  state_manager.TransitionToOpening();
+  state_manager.TransitionToStopped();
+
+  AVSyncController sync_controller;
+  sync_controller.SetSyncMode(mode);
+
+  CaptureRenderer renderer;
+  auto output = std::make_unique<CaptureAudioOutput>();
+  CaptureAudioOutput* capture = output.get();
+
+  AudioPlayer audio_player(&state_manager, &sync_controller);
+  EXPECT_TRUE(
+      audio_player.Init(AudioPlayer::AudioConfig{}, std::move(output)).IsOk());
+
+  VideoPlayer video_player(&state_manager, &sync_controller);
+  VideoPlayer::VideoConfig video_config;
+  video_config.target_fps = kFrameRate;
+  EXPECT_TRUE(video_player.Init(&renderer, video_config));
+
+  state_manager.TransitionToPlaying();
+  EXPECT_TRUE(audio_player.Start().IsOk());
+  EXPECT_TRUE(video_player.Start().IsOk());
+
+  // 与解码线程一样各自推送，由队列背压限速
+  const int64_t stream_ms = int64_t{event_count} * kEventIntervalMs;
+  std::thread video_feeder([&] {
+    for (int64_t i = 0; i < stream_ms * kFrameRate / 1000; ++i) {
+      VideoPlayer::FrameTimestamp timestamp;
+      timestamp.pts = i;
+      timestamp.dts = i;
+      timestamp.time_base = AVRational{1, kFrameRate};
+      if (!video_player.PushFrameBlocking(MakeVideoFrame(i), timestamp, 0)) {
+        break;
+      }
+    }
+  });
+  std::thread audio_feeder([&] {
+    for (int64_t i = 0; i * kSamplesPerFrame < stream_ms * kSampleRate / 1000;
+         ++i) {
+      if (!audio_player.PushFrame(MakeAudioFrame(i))) {
+        break;
+      }
+    }
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(stream_ms + 500));
+  state_manager.TransitionToStopped();
+  video_player.Stop();
+  audio_player.Stop();
+  video_feeder.join();
+  audio_feeder.join();
+
+  auto flashes = renderer.flashes();
+  auto onsets = capture->onsets();
+  std::vector<double> offsets_ms;
+  for (const auto& [event, presented] : flashes) {
+    if (event < static_cast<int64_t>(onsets.size())) {
+      offsets_ms.push_back(std::chrono::duration<double, std::milli>(
+                               presented - onsets[event])
+                               .count());
+    }
+  }
+  return Summarize(std::move(offsets_ms));
+}
+
+void Report(const char* mode_name, const OffsetStats& stats) {
+  std::cout << std::fixed << std::setprecision(1) << mode_name
+            << ": events=" << stats.offsets_ms.size()
+            << " mean=" << stats.mean_ms << "ms median=" << stats.median_ms
+            << "ms p95|off|=" << stats.p95_abs_ms
+            << "ms max|off|=" << stats.max_abs_ms << "ms [";
+  for (double offset : stats.offsets_ms) {
+    std::cout << " " << offset;
+  }
+  std::cout << " ]" << std::endl;
+}
+
+void ExpectWithinBt1359(const OffsetStats& stats) {
+  // 个别闪光帧可能因同步被丢弃，但大部分事件必须测到
+  ASSERT_GE(stats.offsets_ms.size(), static_cast<size_t>(kEventCount - 2));
+
+  EXPECT_LE(stats.median_ms, kDetectableSoundEarlyMs);
+  EXPECT_GE(stats.median_ms, kDetectableSoundLateMs);
+  for (double offset : stats.offsets_ms) {
+    EXPECT_LE(offset, kAcceptableSoundEarlyMs);
+    EXPECT_GE(offset, kAcceptableSoundLateMs);
+  }
+}
+
+}  // namespace
+
+TEST(AVSyncAccuracyTest, AudioMasterShortRun) {
+  auto stats = MeasureSyncAccuracy(AVSyncController::SyncMode::AUDIO_MASTER,
+                                   kShortEventCount);
+  Report("AUDIO_MASTER (short)", stats);
+
+  // 负载高时个别闪光帧可能被丢弃或迟到：允许少测一个，只检查中位数
+  ASSERT_GE(stats.offsets_ms.size(),
+            static_cast<size_t>(kShortEventCount - 1));
+  EXPECT_LE(stats.median_ms, kAcceptableSoundEarlyMs);
+  EXPECT_GE(stats.median_ms, kAcceptableSoundLateMs);
+}
+
+TEST(AVSyncAccuracyTest, DISABLED_AudioMaster) {
+  auto stats = MeasureSyncAccuracy(AVSyncController::SyncMode::AUDIO_MASTER);
+  Report("AUDIO_MASTER", stats);
+  ExpectWithinBt1359(stats);
+}
+
+TEST(AVSyncAccuracyTest, DISABLED_ExternalMaster) {
+  auto stats =
+      MeasureSyncAccuracy(AVSyncController::SyncMode::EXTERNAL_MASTER);
+  Report("EXTERNAL_MASTER", stats);
+  ExpectWithinBt1359(stats);
+}
+
+TEST(AVSyncAccuracyTest, DISABLED_VideoMaster) {
+  auto stats = MeasureSyncAccuracy(AVSyncController::SyncMode::VIDEO_MASTER);
+  Report("VIDEO_MASTER", stats);
+  ExpectWithinBt1359(stats);
+}
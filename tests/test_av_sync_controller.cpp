@@ -388,6 +388,42 @@ TEST(AVSyncControllerTest, ExternalClockMode) {
   EXPECT_NEAR(clock, 100.0, 20.0);
 }
 
+TEST(AVSyncControllerTest, SharedMasterSource) {
+  // 对比播放：两条管线（起始 PTS 不同）跟随同一个外部主时钟
+  AVSyncController master;
+  master.SetSyncMode(AVSyncController::SyncMode::EXTERNAL_MASTER);
+  master.ResetForSeek(1000);
+
+  AVSyncController first;
+  AVSyncController second;
+  first.SetMasterSource(&master);
+  second.SetMasterSource(&master);
+
+  auto now = std::chrono::steady_clock::now();
+  first.UpdateVideoClock(0.0, now);      // 第一帧 PTS 0
+  second.UpdateVideoClock(1400.0, now);  // 第一帧 PTS 1400
+
+  EXPECT_NEAR(first.GetMasterClock(now), master.GetMasterClock(now), 0.1);
+  EXPECT_NEAR(second.GetMasterClock(now), master.GetMasterClock(now), 0.1);
+
+  // 归一化后位置相同的帧得到相同的显示延迟
+  double first_delay = first.CalculateVideoDelay(1040.0, now);
+  double second_delay = second.CalculateVideoDelay(2440.0, now);
+  EXPECT_NEAR(first_delay, second_delay, 0.1);
+
+  // 暂停主时钟即冻结所有管线，不受各自暂停状态影响
+  master.Pause();
+  auto paused_clock = first.GetMasterClock(std::chrono::steady_clock::now());
+  std::this_thread::sleep_for(50ms);
+  EXPECT_NEAR(second.GetMasterClock(std::chrono::steady_clock::now()),
+              paused_clock, 1.0);
+  master.Resume();
+
+  // 取消委托后恢复本控制器自己的时钟
+  first.SetMasterSource(nullptr);
+  EXPECT_NEAR(first.GetMasterClock(now), 0.0, 1.0);
+}
+
 // ============================================================================
 // 同步参数测试
 // ============================================================================
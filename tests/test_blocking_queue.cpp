@@ -426,6 +426,168 @@ TEST(BlockingQueueTest, PopFromEmptyQueueAfterStop) {
   EXPECT_FALSE(queue.Pop(val));  // 队列空且已停止
 }
 
+// ============================================================================
+// 批量操作测试
+// ============================================================================
+
+TEST(BlockingQueueTest, PushBatchPopBatchKeepOrder) {
+  BlockingQueue<int> queue(10);
+
+  std::vector<int> items = {1, 2, 3, 4, 5};
+  EXPECT_EQ(queue.PushBatch(items), 5u);
+  EXPECT_EQ(queue.Size(), 5);
+  EXPECT_TRUE(items.empty());  // 推入的元素从 items 中移除
+
+  std::vector<int> out;
+  EXPECT_EQ(queue.PopBatch(out, 3, 100), 3u);
+  EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+
+  // 追加到已有内容之后，max_n 大于队列大小时取出全部
+  EXPECT_EQ(queue.PopBatch(out, 100, 100), 2u);
+  EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+
+  // 空队列超时返回 0
+  EXPECT_EQ(queue.PopBatch(out, 4, 20), 0u);
+  EXPECT_EQ(out.size(), 5u);
+}
+
+TEST(BlockingQueueTest, PushBatchBlocksUntilAllPushed) {
+  BlockingQueue<int> queue(2);
+  std::vector<int> items = {1, 2, 3, 4, 5};
+
+  std::atomic<size_t> pushed{0};
+  std::thread producer([&]() { pushed = queue.PushBatch(items); });
+
+  // 消费者逐个取，生产者随空间释放继续推入
+  std::vector<int> received;
+  while (received.size() < 5) {
+    queue.PopBatch(received, 1, 1000);
+  }
+  producer.join();
+
+  EXPECT_EQ(pushed, 5u);
+  EXPECT_EQ(received, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(BlockingQueueTest, PushBatchStopsWithRemainder) {
+  BlockingQueue<int> queue(2);
+  std::vector<int> items = {1, 2, 3, 4};
+
+  std::atomic<size_t> pushed{0};
+  std::thread producer([&]() { pushed = queue.PushBatch(items); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.Stop();
+  producer.join();
+
+  // 只推入了容量以内的元素，其余留在 items 中由调用方处理
+  EXPECT_EQ(pushed, 2u);
+  EXPECT_EQ(items, (std::vector<int>{3, 4}));
+}
+
+TEST(BlockingQueueTest, PushBatchForTimesOutWithRemainder) {
+  BlockingQueue<int> queue(2);
+  std::vector<int> items = {1, 2, 3, 4, 5};
+  auto never = []() { return false; };
+
+  EXPECT_EQ(queue.PushBatchFor(items, 30, never), 2u);
+  EXPECT_EQ(items, (std::vector<int>{3, 4, 5}));
+
+  // 0 表示不等待：队列满时立即返回
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(queue.PushBatchFor(items, 0, never), 0u);
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  EXPECT_EQ(items.size(), 3u);
+}
+
+TEST(BlockingQueueTest, PushBatchForStopsOnSeekDuringOversizedBatch) {
+  // 批量大于队列容量，推入途中发生 Seek：与 ExecuteSeek 相同，
+  // 先递增序号再清空队列
+  BlockingQueue<int> queue(4);
+  std::vector<int> items;
+  for (int i = 1; i <= 32; ++i) {
+    items.push_back(i);
+  }
+
+  std::atomic<uint64_t> seek_serial{0};
+  std::atomic<size_t> pushed{0};
+  std::thread producer([&]() {
+    pushed = queue.PushBatchFor(items, -1, [&seek_serial]() {
+      return seek_serial.load() != 0;
+    });
+  });
+
+  std::vector<int> received;
+  while (received.size() < 6) {
+    queue.PopBatch(received, 1, 1000);
+  }
+  seek_serial.fetch_add(1);
+  queue.Clear();
+  producer.join();
+
+  // 清空之后旧位置的包不会再进入队列，未推入的留在 items 中
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_GE(pushed, 6u);
+  EXPECT_LE(pushed, 10u);
+  ASSERT_EQ(items.size(), 32u - pushed);
+  EXPECT_EQ(items.front(), static_cast<int>(pushed) + 1);
+  EXPECT_EQ(received, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+}
+
+TEST(BlockingQueueTest, DrainAllWakesProducer) {
+  BlockingQueue<int> queue(3);
+  for (int i = 0; i < 3; ++i) {
+    queue.Push(i);
+  }
+
+  std::atomic<bool> push_completed{false};
+  std::thread producer([&]() {
+    EXPECT_TRUE(queue.Push(3));
+    push_completed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(push_completed);
+
+  std::vector<int> out;
+  EXPECT_EQ(queue.DrainAll(out), 3u);
+  EXPECT_EQ(out, (std::vector<int>{0, 1, 2}));
+  producer.join();
+  EXPECT_TRUE(push_completed);
+
+  out.clear();
+  EXPECT_EQ(queue.DrainAll(out), 1u);
+  EXPECT_EQ(queue.DrainAll(out), 0u);
+  EXPECT_EQ(out, (std::vector<int>{3}));
+}
+
+TEST(BlockingQueueTest, SetMaxSizeWakesProducer) {
+  BlockingQueue<int> queue(2);
+  queue.Push(0);
+  queue.Push(1);
+
+  std::atomic<bool> push_completed{false};
+  std::thread producer([&]() {
+    EXPECT_TRUE(queue.Push(2));
+    push_completed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(push_completed);
+
+  // 扩容后阻塞的生产者无需等待消费即可推入
+  queue.SetMaxSize(4);
+  producer.join();
+  EXPECT_TRUE(push_completed);
+  EXPECT_EQ(queue.MaxSize(), 4u);
+  EXPECT_EQ(queue.Size(), 3u);
+
+  // 缩容不丢弃已有元素，只限制后续推入
+  queue.SetMaxSize(1);
+  EXPECT_EQ(queue.Size(), 3u);
+  EXPECT_FALSE(queue.TryPush(3));
+}
+
 // ============================================================================
 // 性能基准测试（DISABLED，手动运行）
 // ============================================================================
@@ -462,4 +624,44 @@ TEST(BlockingQueueTest, DISABLED_PerformanceBenchmark) {
   std::cout << "Elapsed time: " << elapsed << " ms" << std::endl;
 }
 
+TEST(BlockingQueueTest, DISABLED_BatchPerformanceBenchmark) {
+  BlockingQueue<int> queue(1000);
+  constexpr int kTotalItems = 1000000;
+  constexpr size_t kBatchSize = 32;
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::thread producer([&]() {
+    std::vector<int> batch;
+    for (int i = 0; i < kTotalItems; i += kBatchSize) {
+      batch.clear();
+      for (size_t j = 0; j < kBatchSize && i + j < kTotalItems; ++j) {
+        batch.push_back(static_cast<int>(i + j));
+      }
+      queue.PushBatch(batch);
+    }
+  });
+
+  std::thread consumer([&]() {
+    std::vector<int> out;
+    size_t received = 0;
+    while (received < kTotalItems) {
+      out.clear();
+      received += queue.PopBatch(out, kBatchSize, 1000);
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+
+  double throughput = kTotalItems / (elapsed / 1000.0);
+  std::cout << "BlockingQueue batch throughput: " << throughput
+            << " items/sec" << std::endl;
+  std::cout << "Elapsed time: " << elapsed << " ms" << std::endl;
+}
+
 }  // namespace zenplay
@@ -0,0 +1,163 @@
+/**
+ * @file test_compare_clock_gate.cpp
+ * @brief 单元测试 - 对比播放主时钟门控（CompareSession 的 Seek 等待）
+ *
+ * 测试目标：
+ * - Seek 时主时钟停在目标位置，直到所有等待的管线都完成跳转
+ * - 管线在 Seek 中再次跳转时，上一次 Seek 的结束不会提前放行
+ * - 拿到请求序号之前 Seek 已经结束、请求被拒绝、管线出错都不会卡住时钟
+ * - 用户暂停时 Seek 完成后主时钟仍保持暂停
+ *
+ * 管线的状态回调由测试直接调用门控的 OnSeekFinished / OnPipelineError
+ * 模拟，序号的含义与 ZenPlayer::SeekAsync / GetCompletedSeekSerial 相同。
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "player/playback/compare_clock_gate.h"
+#include "player/sync/av_sync_controller.h"
+
+using namespace zenplay;
+using namespace std::chrono_literals;
+
+namespace {
+
+class CompareClockGateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    clock_.SetSyncMode(AVSyncController::SyncMode::EXTERNAL_MASTER);
+    gate_.Reset(2);
+  }
+
+  double ClockMs() const {
+    return clock_.GetMasterClock(std::chrono::steady_clock::now());
+  }
+
+  // 两条管线都在播放，同时跳转，请求序号都是 serial
+  void SeekBoth(int64_t target_ms, uint64_t serial) {
+    gate_.BeginSeek(target_ms, {true, true});
+    gate_.SetSeekSerial(0, serial, serial - 1);
+    gate_.SetSeekSerial(1, serial, serial - 1);
+  }
+
+  AVSyncController clock_;
+  CompareClockGate gate_{&clock_};
+};
+
+}  // namespace
+
+TEST_F(CompareClockGateTest, ClockParkedUntilAllPipelinesFinishSeek) {
+  EXPECT_FALSE(gate_.IsClockRunning());
+  gate_.Play();
+  EXPECT_TRUE(gate_.IsClockRunning());
+
+  SeekBoth(5000, 1);
+  EXPECT_TRUE(gate_.IsSeeking());
+  EXPECT_FALSE(gate_.IsClockRunning());
+
+  // 停在目标位置，不随时间前进
+  double parked = ClockMs();
+  EXPECT_NEAR(parked, 5000.0, 5.0);
+  std::this_thread::sleep_for(30ms);
+  EXPECT_DOUBLE_EQ(ClockMs(), parked);
+
+  // 先完成的管线不会让时钟走起来
+  gate_.OnSeekFinished(0, 1);
+  EXPECT_TRUE(gate_.IsSeeking());
+  EXPECT_FALSE(gate_.IsClockRunning());
+  EXPECT_DOUBLE_EQ(ClockMs(), parked);
+
+  gate_.OnSeekFinished(1, 1);
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_TRUE(gate_.IsClockRunning());
+  std::this_thread::sleep_for(30ms);
+  EXPECT_GE(ClockMs(), parked + 20.0);
+}
+
+TEST_F(CompareClockGateTest, SeekWhileSeekingWaitsForNewerRequest) {
+  gate_.Play();
+  SeekBoth(1000, 1);
+
+  // 两条管线都还在 kSeeking 时再次跳转
+  gate_.BeginSeek(2000, {true, true});
+  gate_.SetSeekSerial(0, 2, 0);
+  gate_.SetSeekSerial(1, 2, 0);
+
+  // 第一次 Seek 的结束通知不能放行第二次
+  gate_.OnSeekFinished(0, 1);
+  gate_.OnSeekFinished(1, 1);
+  EXPECT_TRUE(gate_.IsSeeking());
+  EXPECT_FALSE(gate_.IsClockRunning());
+  EXPECT_NEAR(ClockMs(), 2000.0, 5.0);
+
+  gate_.OnSeekFinished(0, 2);
+  EXPECT_TRUE(gate_.IsSeeking());
+  gate_.OnSeekFinished(1, 2);
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_TRUE(gate_.IsClockRunning());
+}
+
+TEST_F(CompareClockGateTest, SeekFinishedBeforeSerialIsKnown) {
+  gate_.Play();
+  gate_.BeginSeek(3000, {true, true});
+
+  // 管线 0 的 Seek 在 SeekAsync 返回之前就结束了：通知时序号未知
+  gate_.OnSeekFinished(0, 1);
+  EXPECT_TRUE(gate_.IsSeeking());
+  gate_.SetSeekSerial(0, 1, 1);
+
+  // 管线 1 的请求被拒绝（返回 0），不再等待
+  gate_.SetSeekSerial(1, 0, 0);
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_TRUE(gate_.IsClockRunning());
+}
+
+TEST_F(CompareClockGateTest, PipelineErrorStopsWaiting) {
+  gate_.Play();
+  SeekBoth(4000, 1);
+
+  gate_.OnPipelineError(1);
+  EXPECT_TRUE(gate_.IsSeeking());
+  gate_.OnSeekFinished(0, 1);
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_TRUE(gate_.IsClockRunning());
+
+  // 序号未知时出错：之后交回的序号被忽略
+  gate_.BeginSeek(6000, {true, true});
+  gate_.OnPipelineError(1);
+  gate_.SetSeekSerial(1, 2, 1);
+  gate_.SetSeekSerial(0, 2, 1);
+  gate_.OnSeekFinished(0, 2);
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_TRUE(gate_.IsClockRunning());
+}
+
+TEST_F(CompareClockGateTest, IdlePipelineAndUserPause) {
+  gate_.Play();
+  gate_.Pause();
+
+  // 已播完的管线（不在播放 / 暂停）不参与等待
+  gate_.BeginSeek(1500, {true, false});
+  gate_.SetSeekSerial(0, 1, 0);
+  EXPECT_TRUE(gate_.IsSeeking());
+  gate_.OnSeekFinished(0, 1);
+  EXPECT_FALSE(gate_.IsSeeking());
+
+  // 用户暂停中：Seek 完成后时钟仍停在目标位置
+  EXPECT_FALSE(gate_.IsClockRunning());
+  EXPECT_NEAR(ClockMs(), 1500.0, 5.0);
+
+  gate_.Play();
+  EXPECT_TRUE(gate_.IsClockRunning());
+  EXPECT_TRUE(gate_.IsPlaying());
+
+  // 停止放弃等待中的 Seek
+  SeekBoth(2500, 2);
+  gate_.Stop();
+  EXPECT_FALSE(gate_.IsSeeking());
+  EXPECT_FALSE(gate_.IsPlaying());
+  EXPECT_FALSE(gate_.IsClockRunning());
+}
@@ -0,0 +1,235 @@
+/**
+ * @file test_compare_compositor.cpp
+ * @brief 单元测试 - 多文件对比播放的画面合成器
+ *
+ * 测试目标：
+ * - 所有活跃分块都交了新帧时呈现一次，配对窗口内到达的帧属于同一轮
+ * - 某块在上一轮呈现前又交了一帧：先呈现当前画布
+ * - 其它块等待中的帧超出配对窗口（属于上一轮）：先呈现再开始新一轮
+ * - 超过空闲时限没交帧（或从未交过帧）的分块不参与等待
+ * - ResetTile 后旧帧不再参与配对
+ *
+ * 帧的到达时间由测试指定（SubmitFrame 的测试重载），输出渲染器只记录
+ * 呈现次数和画布尺寸。
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include "player/common/common_def.h"
+#include "player/video/render/compare_compositor.h"
+#include "player/video/render/renderer.h"
+
+using namespace zenplay;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * @brief 输出渲染器：记录呈现次数和画布尺寸
+ */
+class CountingRenderer : public Renderer {
+ public:
+  struct Record {
+    int frames = 0;
+    int width = 0;
+    int height = 0;
+  };
+
+  explicit CountingRenderer(Record* record) : record_(record) {}
+
+  Result<void> Init(void* /*window_handle*/,
+                    int /*width*/,
+                    int /*height*/) override {
+    return Result<void>::Ok();
+  }
+
+  bool RenderFrame(AVFrame* frame) override {
+    ++record_->frames;
+    record_->width = frame->width;
+    record_->height = frame->height;
+    return true;
+  }
+
+  void Clear() override {}
+  void Present() override {}
+  void OnResize(int /*width*/, int /*height*/) override {}
+  void Cleanup() override {}
+  const char* GetRendererName() const override { return "Counting"; }
+  void ClearCaches() override {}
+
+ private:
+  Record* record_;
+};
+
+AVFramePtr MakeFrame(int width, int height) {
+  AVFramePtr frame(av_frame_alloc());
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = width;
+  frame->height = height;
+  if (av_frame_get_buffer(frame.get(), 32) < 0) {
+    return nullptr;
+  }
+  for (int plane = 0; plane < 3; ++plane) {
+    int rows = plane == 0 ? height : height / 2;
+    std::memset(frame->data[plane], 128, frame->linesize[plane] * rows);
+  }
+  return frame;
+}
+
+class CompareCompositorTest : public ::testing::Test {
+ protected:
+  void Create(int tile_count) {
+    compositor_ = std::make_unique<CompareCompositor>(
+        tile_count, CompareCompositor::Layout::kSideBySide, 1080,
+        std::make_unique<CountingRenderer>(&record_));
+    frame_ = MakeFrame(64, 48);
+    ASSERT_NE(frame_, nullptr);
+  }
+
+  // 分块 index 在 t0 + offset 交一帧
+  bool Submit(int index, std::chrono::milliseconds offset) {
+    return compositor_->SubmitFrame(index, frame_.get(), t0_ + offset);
+  }
+
+  /**
+   * @brief 创建合成器并交两轮帧（间隔 40ms），之后各块对齐、都没有新帧
+   * @note 第一轮里还没交过帧的块不参与等待，第二轮开头纠正错位
+   */
+  void CreateAligned(int tile_count) {
+    Create(tile_count);
+    for (int round = 0; round < 2; ++round) {
+      for (int i = 0; i < tile_count; ++i) {
+        ASSERT_TRUE(Submit(i, std::chrono::milliseconds(round * 40 + i)));
+      }
+    }
+    baseline_ = record_.frames;
+  }
+
+  // 对齐之后呈现的次数
+  int Presented() const { return record_.frames - baseline_; }
+
+  CountingRenderer::Record record_;
+  std::unique_ptr<CompareCompositor> compositor_;
+  AVFramePtr frame_;
+  int baseline_ = 0;
+  const std::chrono::steady_clock::time_point t0_ =
+      std::chrono::steady_clock::now();
+};
+
+}  // namespace
+
+TEST_F(CompareCompositorTest, PresentsWhenAllTilesFresh) {
+  Create(3);
+
+  // 其它块还没交过帧：第一帧不等待，直接呈现
+  ASSERT_TRUE(Submit(0, 0ms));
+  EXPECT_EQ(record_.frames, 1);
+  ASSERT_TRUE(Submit(1, 1ms));
+  ASSERT_TRUE(Submit(2, 2ms));
+  EXPECT_EQ(record_.frames, 1);
+
+  // 三块并排，格子取第一帧的尺寸
+  EXPECT_EQ(record_.width, 3 * 64);
+  EXPECT_EQ(record_.height, 48);
+
+  // 第一轮的错位在下一轮开头纠正，之后凑齐三块才呈现
+  ASSERT_TRUE(Submit(0, 40ms));
+  EXPECT_EQ(record_.frames, 2);
+  ASSERT_TRUE(Submit(1, 41ms));
+  EXPECT_EQ(record_.frames, 2);
+  ASSERT_TRUE(Submit(2, 42ms));
+  EXPECT_EQ(record_.frames, 3);
+
+  // 配对窗口内陆续到达的帧属于同一轮
+  ASSERT_TRUE(Submit(0, 80ms));
+  ASSERT_TRUE(Submit(1, 84ms));
+  EXPECT_EQ(record_.frames, 3);
+  ASSERT_TRUE(Submit(2, 85ms));
+  EXPECT_EQ(record_.frames, 4);
+  EXPECT_EQ(compositor_->frames_presented(), 4u);
+}
+
+TEST_F(CompareCompositorTest, TileSubmittingTwicePresentsFirst) {
+  CreateAligned(2);
+
+  // 分块 0 在分块 1 交下一帧之前又交了一帧：上一帧先呈现出去
+  ASSERT_TRUE(Submit(0, 80ms));
+  EXPECT_EQ(Presented(), 0);
+  ASSERT_TRUE(Submit(0, 82ms));
+  EXPECT_EQ(Presented(), 1);
+
+  // 错位在下一轮纠正：分块 1 到达即凑齐
+  ASSERT_TRUE(Submit(1, 83ms));
+  EXPECT_EQ(Presented(), 2);
+}
+
+TEST_F(CompareCompositorTest, StaleFreshTilePresentedBeforeNewRound) {
+  CreateAligned(3);
+
+  // 帧间隔 40ms，配对窗口为其一半（20ms）
+  ASSERT_TRUE(Submit(0, 80ms));
+  EXPECT_EQ(Presented(), 0);
+
+  // 分块 1 晚了 35ms：分块 0 等待中的帧属于上一轮，先呈现
+  ASSERT_TRUE(Submit(1, 115ms));
+  EXPECT_EQ(Presented(), 1);
+
+  // 分块 1 的帧留到新一轮，与窗口内到达的帧配对
+  ASSERT_TRUE(Submit(0, 120ms));
+  EXPECT_EQ(Presented(), 1);
+  ASSERT_TRUE(Submit(2, 121ms));
+  EXPECT_EQ(Presented(), 2);
+}
+
+TEST_F(CompareCompositorTest, IdleTileIsNotWaitedFor) {
+  CreateAligned(2);
+
+  // 分块 1 在空闲时限（250ms）内：分块 0 的帧等它
+  ASSERT_TRUE(Submit(0, 240ms));
+  EXPECT_EQ(Presented(), 0);
+  ASSERT_TRUE(Submit(1, 241ms));
+  EXPECT_EQ(Presented(), 1);
+
+  // 分块 1 超过空闲时限没有交帧（暂停、播完）：分块 0 单独呈现
+  ASSERT_TRUE(Submit(0, 540ms));
+  EXPECT_EQ(Presented(), 2);
+  ASSERT_TRUE(Submit(0, 580ms));
+  EXPECT_EQ(Presented(), 3);
+
+  // 分块 1 恢复交帧后重新参与配对
+  ASSERT_TRUE(Submit(1, 581ms));
+  EXPECT_EQ(Presented(), 3);
+  ASSERT_TRUE(Submit(0, 585ms));
+  EXPECT_EQ(Presented(), 4);
+}
+
+TEST_F(CompareCompositorTest, ResetTileDropsPendingFrame) {
+  CreateAligned(2);
+
+  // Seek：分块 0 等待中的旧帧不再参与配对
+  ASSERT_TRUE(Submit(0, 80ms));
+  compositor_->ResetTile(0);
+
+  // 分块 1 超出配对窗口到达，也不会为旧帧先呈现一次
+  ASSERT_TRUE(Submit(1, 115ms));
+  EXPECT_EQ(Presented(), 0);
+  ASSERT_TRUE(Submit(0, 120ms));
+  EXPECT_EQ(Presented(), 1);
+}
+
+TEST_F(CompareCompositorTest, RejectsInvalidInput) {
+  Create(2);
+  EXPECT_FALSE(Submit(2, 0ms));
+  EXPECT_FALSE(compositor_->SubmitFrame(0, nullptr, t0_));
+  EXPECT_EQ(compositor_->CreateTileRenderer(2), nullptr);
+  EXPECT_NE(compositor_->CreateTileRenderer(1), nullptr);
+  EXPECT_EQ(record_.frames, 0);
+}
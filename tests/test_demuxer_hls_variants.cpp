@@ -0,0 +1,561 @@
+/**
+ * @file test_demuxer_hls_variants.cpp
+ * @brief 集成测试 - 真实 Demuxer 打开多码率 HLS 并切换档位
+ *
+ * 测试目标：
+ * - 分辨率不同的档位不可切换；起播档位取可互相切换的最大一组中码率最低的
+ * - RequestVariantSwitch() 之后在新档位的视频关键帧处完成切换，
+ *   切换后不再输出旧档位的数据包
+ * - 切换前后音频连续：新档位的音频接在旧档位已输出的音频之后，
+ *   接缝处的空档或重叠不超过半个音频帧
+ *
+ * 分片在测试内用 libavcodec 编码（mpeg2video + mp2，1 秒一个分片，
+ * 每个分片以关键帧开始），由本地 HTTP 服务器提供
+ */
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+}
+
+#include "player/demuxer/demuxer.h"
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kFrameRate = 25;
+constexpr int kSampleRate = 48000;
+constexpr int kSegmentCount = 4;
+// 时间线从 1 秒开始：mpeg2video 的 DTS 比 PTS 早一帧，避免出现负时间戳
+// 被 mpegts 封装器平移，导致第一个分片与后面的分片对不上
+constexpr int64_t kStartUs = 1000000;
+constexpr int64_t kSegmentUs = 1000000;
+constexpr int64_t kAudioFrameUs = 1152 * 1000000LL / kSampleRate;  // 24ms
+
+struct Rendition {
+  int width;
+  int height;
+  int64_t bandwidth_bps;
+};
+
+/**
+ * @brief 同时服务多个连接的静态文件 HTTP 服务器（每个请求后关闭连接）
+ */
+class StaticHttpServer {
+ public:
+  ~StaticHttpServer() { Stop(); }
+
+  /**
+   * @return 监听端口，失败返回 0
+   */
+  int Start(std::map<std::string, std::string> files) {
+    files_ = std::move(files);
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) < 0 ||
+        listen(listen_fd_, 16) < 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) <
+            0) {
+      return 0;
+    }
+    accept_thread_ = std::thread([this]() { AcceptLoop(); });
+    return ntohs(addr.sin_port);
+  }
+
+  void Stop() {
+    stop_.store(true);
+    if (accept_thread_.joinable()) {
+      accept_thread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& thread : connection_threads_) {
+      thread.join();
+    }
+    connection_threads_.clear();
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+    }
+  }
+
+ private:
+  bool WaitReadable(int fd) {
+    while (!stop_.load()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (poll(&pfd, 1, 50) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void AcceptLoop() {
+    while (WaitReadable(listen_fd_)) {
+      int client_fd = accept(listen_fd_, nullptr, nullptr);
+      if (client_fd < 0) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      connection_threads_.emplace_back(
+          [this, client_fd]() { ServeConnection(client_fd); });
+    }
+  }
+
+  void ServeConnection(int client_fd) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           WaitReadable(client_fd)) {
+      ssize_t n = recv(client_fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        break;
+      }
+      request.append(buffer, static_cast<size_t>(n));
+    }
+
+    // "GET /path HTTP/1.1"
+    std::string path;
+    size_t begin = request.find(' ');
+    size_t end = request.find(' ', begin + 1);
+    if (begin != std::string::npos && end != std::string::npos) {
+      path = request.substr(begin + 1, end - begin - 1);
+    }
+
+    auto it = files_.find(path);
+    std::string response;
+    if (it == files_.end()) {
+      response =
+          "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n"
+          "Connection: close\r\n\r\n";
+    } else {
+      response = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                 std::to_string(it->second.size()) +
+                 "\r\nConnection: close\r\n\r\n" + it->second;
+    }
+    SendAll(client_fd, response);
+    close(client_fd);
+  }
+
+  void SendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size() && !stop_.load()) {
+      ssize_t n = send(fd, data.data() + sent, data.size() - sent,
+                       MSG_NOSIGNAL);
+      if (n <= 0) {
+        return;
+      }
+      sent += static_cast<size_t>(n);
+    }
+  }
+
+  std::map<std::string, std::string> files_;
+  int listen_fd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::thread accept_thread_;
+  std::mutex mutex_;
+  std::vector<std::thread> connection_threads_;
+};
+
+struct CodecContextDeleter {
+  void operator()(AVCodecContext* ctx) const { avcodec_free_context(&ctx); }
+};
+using CodecContextPtr = std::unique_ptr<AVCodecContext, CodecContextDeleter>;
+
+/**
+ * @brief 把一个档位编码成 kSegmentCount 个 TS 分片
+ *
+ * 每个分片新建视频编码器并在分片末尾冲刷，保证分片以关键帧开始且不缺帧；
+ * 音频编码器跨分片复用，音频时间线连续
+ */
+class RenditionEncoder {
+ public:
+  explicit RenditionEncoder(const Rendition& rendition)
+      : rendition_(rendition) {}
+
+  bool Encode(std::vector<std::string>* segments) {
+    audio_ = OpenAudioEncoder();
+    if (!audio_) {
+      return false;
+    }
+    for (int segment = 0; segment < kSegmentCount; ++segment) {
+      std::string data;
+      if (!EncodeSegment(&data)) {
+        return false;
+      }
+      segments->push_back(std::move(data));
+    }
+    return true;
+  }
+
+ private:
+  CodecContextPtr OpenVideoEncoder() {
+    const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MPEG2VIDEO);
+    if (!codec) {
+      return nullptr;
+    }
+    CodecContextPtr ctx(avcodec_alloc_context3(codec));
+    ctx->width = rendition_.width;
+    ctx->height = rendition_.height;
+    ctx->pix_fmt = AV_PIX_FMT_YUV420P;
+    ctx->time_base = AVRational{1, kFrameRate};
+    ctx->framerate = AVRational{kFrameRate, 1};
+    ctx->bit_rate = rendition_.bandwidth_bps * 3 / 4;
+    ctx->gop_size = kFrameRate;
+    ctx->max_b_frames = 0;
+    if (avcodec_open2(ctx.get(), codec, nullptr) < 0) {
+      return nullptr;
+    }
+    return ctx;
+  }
+
+  CodecContextPtr OpenAudioEncoder() {
+    const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MP2);
+    if (!codec) {
+      return nullptr;
+    }
+    CodecContextPtr ctx(avcodec_alloc_context3(codec));
+    ctx->sample_fmt = AV_SAMPLE_FMT_S16;
+    ctx->sample_rate = kSampleRate;
+    av_channel_layout_default(&ctx->ch_layout, 2);
+    ctx->time_base = AVRational{1, kSampleRate};
+    ctx->bit_rate = 128000;
+    if (avcodec_open2(ctx.get(), codec, nullptr) < 0) {
+      return nullptr;
+    }
+    return ctx;
+  }
+
+  bool EncodeSegment(std::string* data) {
+    CodecContextPtr video = OpenVideoEncoder();
+    AVFormatContext* muxer = nullptr;
+    if (!video || avformat_alloc_output_context2(&muxer, nullptr, "mpegts",
+                                                 nullptr) < 0) {
+      return false;
+    }
+    video_stream_ = avformat_new_stream(muxer, nullptr);
+    audio_stream_ = avformat_new_stream(muxer, nullptr);
+    avcodec_parameters_from_context(video_stream_->codecpar, video.get());
+    avcodec_parameters_from_context(audio_stream_->codecpar, audio_.get());
+    video_stream_->time_base = AVRational{1, 90000};
+    audio_stream_->time_base = AVRational{1, 90000};
+
+    bool ok = avio_open_dyn_buf(&muxer->pb) >= 0 &&
+              avformat_write_header(muxer, nullptr) >= 0;
+    for (int i = 0; ok && i < kFrameRate; ++i) {
+      ok = SendVideoFrame(muxer, video.get());
+      // 音频跟上已编码的视频
+      while (ok && audio_samples_ * kFrameRate <
+                       static_cast<int64_t>(video_frames_) * kSampleRate) {
+        ok = SendAudioFrame(muxer);
+      }
+    }
+    ok = ok && Drain(muxer, video.get(), nullptr, video_stream_);
+    ok = ok && av_write_trailer(muxer) >= 0;
+
+    if (muxer->pb) {
+      uint8_t* buffer = nullptr;
+      int size = avio_close_dyn_buf(muxer->pb, &buffer);
+      muxer->pb = nullptr;
+      data->assign(reinterpret_cast<char*>(buffer), size);
+      av_free(buffer);
+    }
+    avformat_free_context(muxer);
+    return ok;
+  }
+
+  bool SendVideoFrame(AVFormatContext* muxer, AVCodecContext* video) {
+    AVFrame* frame = av_frame_alloc();
+    frame->format = AV_PIX_FMT_YUV420P;
+    frame->width = rendition_.width;
+    frame->height = rendition_.height;
+    bool ok = av_frame_get_buffer(frame, 0) >= 0;
+    if (ok) {
+      // 每帧亮度不同，避免编码器把整段编成跳过的宏块
+      std::memset(frame->data[0], (video_frames_ * 7) & 0xff,
+                  frame->linesize[0] * frame->height);
+      std::memset(frame->data[1], 128, frame->linesize[1] * frame->height / 2);
+      std::memset(frame->data[2], 128, frame->linesize[2] * frame->height / 2);
+      frame->pts = kStartUs / 1000000 * kFrameRate + video_frames_;
+      ++video_frames_;
+      ok = Drain(muxer, video, frame, video_stream_);
+    }
+    av_frame_free(&frame);
+    return ok;
+  }
+
+  bool SendAudioFrame(AVFormatContext* muxer) {
+    AVFrame* frame = av_frame_alloc();
+    frame->format = AV_SAMPLE_FMT_S16;
+    frame->sample_rate = kSampleRate;
+    frame->nb_samples = audio_->frame_size;
+    av_channel_layout_copy(&frame->ch_layout, &audio_->ch_layout);
+    bool ok = av_frame_get_buffer(frame, 0) >= 0;
+    if (ok) {
+      auto* samples = reinterpret_cast<int16_t*>(frame->data[0]);
+      for (int i = 0; i < frame->nb_samples; ++i) {
+        double t = static_cast<double>(audio_samples_ + i) / kSampleRate;
+        auto value = static_cast<int16_t>(8000 * std::sin(2 * M_PI * 440 * t));
+        samples[2 * i] = value;
+        samples[2 * i + 1] = value;
+      }
+      frame->pts = kStartUs / 1000000 * kSampleRate + audio_samples_;
+      audio_samples_ += frame->nb_samples;
+      ok = Drain(muxer, audio_.get(), frame, audio_stream_);
+    }
+    av_frame_free(&frame);
+    return ok;
+  }
+
+  // 送入一帧（nullptr 表示冲刷），把编码出的数据包写入分片
+  bool Drain(AVFormatContext* muxer,
+             AVCodecContext* encoder,
+             const AVFrame* frame,
+             AVStream* stream) {
+    if (avcodec_send_frame(encoder, frame) < 0) {
+      return false;
+    }
+    AVPacket* packet = av_packet_alloc();
+    bool ok = true;
+    while (ok) {
+      int ret = avcodec_receive_packet(encoder, packet);
+      if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+        break;
+      }
+      ok = ret >= 0;
+      if (ok) {
+        av_packet_rescale_ts(packet, encoder->time_base, stream->time_base);
+        packet->stream_index = stream->index;
+        ok = av_interleaved_write_frame(muxer, packet) >= 0;
+      }
+    }
+    av_packet_free(&packet);
+    return ok;
+  }
+
+  Rendition rendition_;
+  CodecContextPtr audio_;
+  AVStream* video_stream_ = nullptr;
+  AVStream* audio_stream_ = nullptr;
+  int video_frames_ = 0;
+  int64_t audio_samples_ = 0;
+};
+
+/**
+ * @brief 生成主播放列表、各档位的媒体播放列表和分片
+ * @return 路径 -> 内容；编码器不可用时返回空表
+ */
+std::map<std::string, std::string> MakeHlsFiles(
+    const std::vector<Rendition>& renditions) {
+  std::map<std::string, std::string> files;
+  std::string master = "#EXTM3U\n";
+  for (size_t r = 0; r < renditions.size(); ++r) {
+    const Rendition& rendition = renditions[r];
+    std::vector<std::string> segments;
+    if (!RenditionEncoder(rendition).Encode(&segments)) {
+      return {};
+    }
+
+    std::string dir = "/v" + std::to_string(r);
+    std::string media =
+        "#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:1\n"
+        "#EXT-X-MEDIA-SEQUENCE:0\n";
+    for (size_t i = 0; i < segments.size(); ++i) {
+      std::string name = "seg" + std::to_string(i) + ".ts";
+      media += "#EXTINF:1.0,\n" + name + "\n";
+      files[dir + "/" + name] = std::move(segments[i]);
+    }
+    media += "#EXT-X-ENDLIST\n";
+    files[dir + "/index.m3u8"] = media;
+
+    master += "#EXT-X-STREAM-INF:BANDWIDTH=" +
+              std::to_string(rendition.bandwidth_bps) +
+              ",RESOLUTION=" + std::to_string(rendition.width) + "x" +
+              std::to_string(rendition.height) + "\n" + dir.substr(1) +
+              "/index.m3u8\n";
+  }
+  files["/master.m3u8"] = master;
+  return files;
+}
+
+std::string UrlFor(int port) {
+  return "http://127.0.0.1:" + std::to_string(port) + "/master.m3u8";
+}
+
+struct PacketInfo {
+  int stream_index;
+  int64_t pts_us;
+  int64_t end_us;
+  bool key;
+};
+
+PacketInfo Describe(const Demuxer& demuxer, const AVPacket* packet) {
+  AVStream* stream = demuxer.findStreamByIndex(packet->stream_index);
+  AVRational us{1, AV_TIME_BASE};
+  PacketInfo info;
+  info.stream_index = packet->stream_index;
+  info.pts_us = av_rescale_q(packet->pts, stream->time_base, us);
+  info.end_us = info.pts_us + av_rescale_q(packet->duration,
+                                           stream->time_base, us);
+  info.key = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+  return info;
+}
+
+class DemuxerHlsVariantsTest : public ::testing::Test {
+ protected:
+  void Serve(const std::vector<Rendition>& renditions) {
+    auto files = MakeHlsFiles(renditions);
+    if (files.empty()) {
+      GTEST_SKIP() << "mpeg2video / mp2 encoder not available";
+    }
+    port_ = server_.Start(std::move(files));
+    ASSERT_NE(port_, 0);
+  }
+
+  StaticHttpServer server_;
+  int port_ = 0;
+};
+
+}  // namespace
+
+TEST_F(DemuxerHlsVariantsTest, OnlyMatchingResolutionIsSwitchable) {
+  // 最低码率档位分辨率不同：起播档位取两个 160x120 档位中码率较低的
+  Serve({{320, 240, 300000}, {160, 120, 500000}, {160, 120, 900000}});
+  if (IsSkipped()) {
+    return;
+  }
+
+  Demuxer demuxer;
+  ASSERT_TRUE(demuxer.Open(UrlFor(port_)).IsOk());
+
+  auto variants = demuxer.GetVariants();
+  ASSERT_EQ(variants.size(), 2u);
+  EXPECT_EQ(variants[0].bandwidth_bps, 500000);
+  EXPECT_EQ(variants[1].bandwidth_bps, 900000);
+  for (const auto& variant : variants) {
+    EXPECT_EQ(variant.width, 160);
+    EXPECT_EQ(variant.height, 120);
+  }
+  EXPECT_EQ(demuxer.current_variant(), 0);
+  EXPECT_FALSE(demuxer.RequestVariantSwitch(2));
+}
+
+TEST_F(DemuxerHlsVariantsTest, SwitchCommitsOnKeyframeWithContinuousAudio) {
+  Serve({{160, 120, 300000}, {160, 120, 900000}});
+  if (IsSkipped()) {
+    return;
+  }
+
+  Demuxer demuxer;
+  ASSERT_TRUE(demuxer.Open(UrlFor(port_)).IsOk());
+  ASSERT_EQ(demuxer.GetVariants().size(), 2u);
+  ASSERT_EQ(demuxer.current_variant(), 0);
+  const int old_video = demuxer.active_video_stream_index();
+  const int old_audio = demuxer.active_audio_stream_index();
+  ASSERT_GE(old_video, 0);
+  ASSERT_GE(old_audio, 0);
+
+  // 读到第一个分片中间时请求切换，读到结束
+  std::vector<PacketInfo> packets;
+  bool requested = false;
+  for (int i = 0; i < 10000; ++i) {
+    auto result = demuxer.ReadPacket();
+    ASSERT_TRUE(result.IsOk()) << result.Message();
+    AVPacket* packet = result.Value();
+    if (!packet) {
+      break;
+    }
+    PacketInfo info = Describe(demuxer, packet);
+    av_packet_free(&packet);
+    packets.push_back(info);
+
+    if (!requested && info.stream_index == old_video &&
+        info.pts_us >= kStartUs + kSegmentUs / 2) {
+      ASSERT_TRUE(demuxer.RequestVariantSwitch(1));
+      EXPECT_TRUE(demuxer.IsVariantSwitchPending());
+      EXPECT_EQ(demuxer.current_variant(), 0);
+      requested = true;
+    }
+  }
+  ASSERT_TRUE(requested);
+
+  EXPECT_FALSE(demuxer.IsVariantSwitchPending());
+  EXPECT_EQ(demuxer.current_variant(), 1);
+  const int new_video = demuxer.active_video_stream_index();
+  const int new_audio = demuxer.active_audio_stream_index();
+  EXPECT_NE(new_video, old_video);
+  EXPECT_NE(new_audio, old_audio);
+
+  // 切换点：新档位的第一个视频包是关键帧，时间上接在旧档位之后
+  size_t first_new = packets.size();
+  int64_t last_old_video_us = AV_NOPTS_VALUE;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (packets[i].stream_index == new_video) {
+      first_new = i;
+      break;
+    }
+    if (packets[i].stream_index == old_video) {
+      last_old_video_us = packets[i].pts_us;
+    }
+  }
+  ASSERT_LT(first_new, packets.size());
+  EXPECT_TRUE(packets[first_new].key);
+  EXPECT_GE(packets[first_new].pts_us, last_old_video_us);
+  EXPECT_EQ((packets[first_new].pts_us - kStartUs) % kSegmentUs, 0);
+
+  // 切换之后只有新档位的数据包
+  for (size_t i = first_new; i < packets.size(); ++i) {
+    EXPECT_TRUE(packets[i].stream_index == new_video ||
+                packets[i].stream_index == new_audio)
+        << "packet " << i << " from stream " << packets[i].stream_index;
+  }
+
+  // 音频从头到尾连续，接缝处的空档或重叠不超过半个音频帧
+  int64_t audio_end_us = AV_NOPTS_VALUE;
+  bool old_audio_seen = false;
+  bool new_audio_seen = false;
+  for (const PacketInfo& info : packets) {
+    if (info.stream_index != old_audio && info.stream_index != new_audio) {
+      continue;
+    }
+    old_audio_seen = old_audio_seen || info.stream_index == old_audio;
+    new_audio_seen = new_audio_seen || info.stream_index == new_audio;
+    if (audio_end_us != AV_NOPTS_VALUE) {
+      EXPECT_LE(std::llabs(info.pts_us - audio_end_us), kAudioFrameUs / 2)
+          << "audio discontinuity at " << info.pts_us << "us, stream "
+          << info.stream_index;
+    }
+    audio_end_us = info.end_us;
+  }
+  EXPECT_TRUE(old_audio_seen);
+  EXPECT_TRUE(new_audio_seen);
+  EXPECT_GE(audio_end_us,
+            kStartUs + kSegmentCount * kSegmentUs - kAudioFrameUs);
+}
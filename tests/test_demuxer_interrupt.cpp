@@ -0,0 +1,288 @@
+/**
+ * @file test_demuxer_interrupt.cpp
+ * @brief 单元测试 - 可打断的解封装网络 I/O
+ *
+ * 测试目标：
+ * - 服务器不响应时，Open() 在截止时间到达后返回 kNetworkTimeout
+ * - Interrupt() 立即唤醒阻塞中的 Open()，返回 kCancelled
+ * - CancelPendingIo() 只打断当前阻塞的 ReadPacket()，之后的读取不受影响
+ * - 读取开始之前（已取得取消代数）发生的 CancelPendingIo() 不会丢失
+ *
+ * 使用本地 HTTP 服务器：发送完预设数据后保持连接但不再响应
+ */
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+
+#include "player/demuxer/demuxer.h"
+
+using namespace zenplay;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr auto kPromptWake = std::chrono::milliseconds(1500);
+
+/**
+ * @brief 发送完 payload 后停止响应的 HTTP 服务器（只接受一个连接）
+ */
+class StallingHttpServer {
+ public:
+  ~StallingHttpServer() { Stop(); }
+
+  /**
+   * @return 监听端口，失败返回 0
+   */
+  int Start(std::string payload) {
+    payload_ = std::move(payload);
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) < 0 ||
+        listen(listen_fd_, 1) < 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) <
+            0) {
+      return 0;
+    }
+    thread_ = std::thread([this]() { Serve(); });
+    return ntohs(addr.sin_port);
+  }
+
+  void Stop() {
+    stop_.store(true);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    if (client_fd_ >= 0) {
+      close(client_fd_);
+      client_fd_ = -1;
+    }
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+    }
+  }
+
+ private:
+  bool WaitReadable(int fd) {
+    while (!stop_.load()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (poll(&pfd, 1, 50) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Serve() {
+    if (!WaitReadable(listen_fd_)) {
+      return;
+    }
+    client_fd_ = accept(listen_fd_, nullptr, nullptr);
+    if (client_fd_ < 0) {
+      return;
+    }
+
+    // 读完请求头再应答
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           WaitReadable(client_fd_)) {
+      ssize_t n = recv(client_fd_, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        return;
+      }
+      request.append(buffer, static_cast<size_t>(n));
+    }
+
+    size_t sent = 0;
+    while (sent < payload_.size() && !stop_.load()) {
+      ssize_t n = send(client_fd_, payload_.data() + sent,
+                       payload_.size() - sent, MSG_NOSIGNAL);
+      if (n <= 0) {
+        return;
+      }
+      sent += static_cast<size_t>(n);
+    }
+    // 保持连接，不再发送任何数据，直到 Stop()
+  }
+
+  std::string payload_;
+  int listen_fd_ = -1;
+  int client_fd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+void AppendLE(std::string* out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+/**
+ * @brief HTTP 响应头 + WAV 头（声明 60 秒）+ 1 秒静音 PCM
+ * @note 不带 Content-Length，流不可 Seek，WAV 解封装器不会另开连接
+ *       去查找 data 块之后的块
+ */
+std::string StallingWavResponse() {
+  constexpr uint32_t kSampleRate = 48000;
+  constexpr uint32_t kChannels = 2;
+  constexpr uint32_t kBytesPerSecond = kSampleRate * kChannels * 2;
+  constexpr uint32_t kDeclaredBytes = kBytesPerSecond * 60;
+
+  std::string wav = "RIFF";
+  AppendLE(&wav, 36 + kDeclaredBytes, 4);
+  wav += "WAVEfmt ";
+  AppendLE(&wav, 16, 4);
+  AppendLE(&wav, 1, 2);  // PCM
+  AppendLE(&wav, kChannels, 2);
+  AppendLE(&wav, kSampleRate, 4);
+  AppendLE(&wav, kBytesPerSecond, 4);
+  AppendLE(&wav, kChannels * 2, 2);
+  AppendLE(&wav, 16, 2);
+  wav += "data";
+  AppendLE(&wav, kDeclaredBytes, 4);
+  wav.append(kBytesPerSecond, '\0');
+
+  return "HTTP/1.1 200 OK\r\nContent-Type: audio/wav\r\n"
+         "Connection: close\r\n\r\n" + wav;
+}
+
+std::string UrlFor(int port) {
+  return "http://127.0.0.1:" + std::to_string(port) + "/stall.wav";
+}
+
+}  // namespace
+
+TEST(DemuxerInterruptTest, OpenTimesOutWhenServerIsSilent) {
+  StallingHttpServer server;
+  int port = server.Start("");
+  ASSERT_NE(port, 0);
+
+  Demuxer demuxer;
+  demuxer.SetIoTimeouts(300, 300);
+
+  auto start = Clock::now();
+  auto result = demuxer.Open(UrlFor(port));
+  auto elapsed = Clock::now() - start;
+
+  ASSERT_FALSE(result.IsOk());
+  EXPECT_EQ(result.Code(), ErrorCode::kNetworkTimeout) << result.Message();
+  EXPECT_LT(elapsed, std::chrono::milliseconds(300) + kPromptWake);
+}
+
+TEST(DemuxerInterruptTest, InterruptWakesBlockedOpen) {
+  StallingHttpServer server;
+  int port = server.Start("");
+  ASSERT_NE(port, 0);
+
+  Demuxer demuxer;
+  demuxer.SetIoTimeouts(0, 0);  // 不设截止时间，只能被打断
+
+  auto open = std::async(std::launch::async,
+                         [&]() { return demuxer.Open(UrlFor(port)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_EQ(open.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+
+  demuxer.Interrupt();
+  ASSERT_EQ(open.wait_for(kPromptWake), std::future_status::ready);
+  auto result = open.get();
+  EXPECT_EQ(result.Code(), ErrorCode::kCancelled) << result.Message();
+}
+
+TEST(DemuxerInterruptTest, CancelPendingIoWakesOnlyBlockedRead) {
+  StallingHttpServer server;
+  int port = server.Start(StallingWavResponse());
+  ASSERT_NE(port, 0);
+
+  Demuxer demuxer;
+  demuxer.SetIoTimeouts(0, 0);
+  auto open_result = demuxer.Open(UrlFor(port));
+  ASSERT_TRUE(open_result.IsOk()) << open_result.Message();
+
+  // 读完服务器已发送的数据后阻塞在下一次读取上
+  auto read_until_error = [&demuxer]() {
+    while (true) {
+      auto result = demuxer.ReadPacket();
+      if (!result.IsOk()) {
+        return result.Code();
+      }
+      AVPacket* packet = result.Value();
+      if (!packet) {
+        return ErrorCode::kEndOfFile;
+      }
+      av_packet_free(&packet);
+    }
+  };
+
+  auto reader = std::async(std::launch::async, read_until_error);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_EQ(reader.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+
+  demuxer.CancelPendingIo();
+  ASSERT_EQ(reader.wait_for(kPromptWake), std::future_status::ready);
+  EXPECT_EQ(reader.get(), ErrorCode::kCancelled);
+
+  // 取消只作用于当时阻塞的那次读取：新的读取照常阻塞
+  auto next = std::async(std::launch::async, read_until_error);
+  EXPECT_EQ(next.wait_for(std::chrono::milliseconds(300)),
+            std::future_status::timeout);
+
+  demuxer.Interrupt();
+  ASSERT_EQ(next.wait_for(kPromptWake), std::future_status::ready);
+  EXPECT_EQ(next.get(), ErrorCode::kCancelled);
+}
+
+TEST(DemuxerInterruptTest, CancelBeforeReadStartsIsNotLost) {
+  StallingHttpServer server;
+  int port = server.Start(StallingWavResponse());
+  ASSERT_NE(port, 0);
+
+  Demuxer demuxer;
+  demuxer.SetIoTimeouts(0, 0);
+  auto open_result = demuxer.Open(UrlFor(port));
+  ASSERT_TRUE(open_result.IsOk()) << open_result.Message();
+
+  // 模拟 DemuxTask：取得代数后、开始读取前 Seek 线程已经发起取消
+  uint64_t generation = demuxer.io_cancel_generation();
+  demuxer.CancelPendingIo();
+
+  auto reader = std::async(std::launch::async, [&demuxer, generation]() {
+    while (true) {
+      auto result = demuxer.ReadPacket(generation);
+      if (!result.IsOk()) {
+        return result.Code();
+      }
+      AVPacket* packet = result.Value();
+      if (!packet) {
+        return ErrorCode::kEndOfFile;
+      }
+      av_packet_free(&packet);
+    }
+  });
+
+  // 读到需要等待网络的位置时立即被打断，不必等到下一次取消
+  ASSERT_EQ(reader.wait_for(kPromptWake), std::future_status::ready);
+  EXPECT_EQ(reader.get(), ErrorCode::kCancelled);
+}
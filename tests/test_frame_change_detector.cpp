@@ -0,0 +1,324 @@
+/**
+ * @file test_frame_change_detector.cpp
+ * @brief 单元测试 - 图块哈希与静态帧检测
+ *
+ * 测试目标：
+ * - AVX2 / SSE2 / 标量图块哈希逐位一致（随机尺寸，覆盖尾部处理）
+ * - 总和与加权和都不变的多处修改也会改变图块哈希
+ * - 首帧、Reset() 后整帧更新
+ * - 内容不变时判定为未变化（忽略 linesize 对齐填充）
+ * - 单个图块变化只报告该图块，整帧变化按行合并矩形
+ * - 只有色度平面变化也能检测到
+ * - 奇数尺寸的边缘图块被裁剪到画面范围内
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "player/video/render/frame_change_detector.h"
+#include "player/video/render/tile_hash.h"
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kTile = FrameChangeDetector::kTileSize;
+
+/**
+ * @brief 测试用的 YUV420P 帧，平面缓冲由测试持有
+ */
+class TestFrame {
+ public:
+  TestFrame(int width, int height, int padding = 16)
+      : frame_(av_frame_alloc()) {
+    frame_->format = AV_PIX_FMT_YUV420P;
+    frame_->width = width;
+    frame_->height = height;
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+    int widths[3] = {width, chroma_width, chroma_width};
+    int heights[3] = {height, chroma_height, chroma_height};
+    for (int p = 0; p < 3; ++p) {
+      frame_->linesize[p] = widths[p] + padding;
+      planes_[p].assign(static_cast<size_t>(frame_->linesize[p]) * heights[p],
+                        0x80);
+      frame_->data[p] = planes_[p].data();
+    }
+  }
+
+  ~TestFrame() { av_frame_free(&frame_); }
+
+  TestFrame(const TestFrame&) = delete;
+  TestFrame& operator=(const TestFrame&) = delete;
+
+  uint8_t& At(int plane, int x, int y) {
+    return planes_[plane][static_cast<size_t>(y) * frame_->linesize[plane] +
+                          x];
+  }
+
+  void FillRandom(std::mt19937& rng) {
+    for (auto& plane : planes_) {
+      for (auto& byte : plane) {
+        byte = static_cast<uint8_t>(rng());
+      }
+    }
+  }
+
+  /**
+   * @brief 只改写每行有效宽度之外的对齐填充
+   */
+  void ScramblePadding(int width, int height) {
+    int widths[3] = {width, (width + 1) / 2, (width + 1) / 2};
+    int heights[3] = {height, (height + 1) / 2, (height + 1) / 2};
+    for (int p = 0; p < 3; ++p) {
+      for (int y = 0; y < heights[p]; ++y) {
+        for (int x = widths[p]; x < frame_->linesize[p]; ++x) {
+          At(p, x, y) ^= 0xff;
+        }
+      }
+    }
+  }
+
+  const AVFrame* get() const { return frame_; }
+
+ private:
+  AVFrame* frame_;
+  std::vector<uint8_t> planes_[3];
+};
+
+void ExpectRect(const FrameChangeDetector::DirtyRect& rect,
+                int x,
+                int y,
+                int w,
+                int h) {
+  EXPECT_EQ(rect.x, x);
+  EXPECT_EQ(rect.y, y);
+  EXPECT_EQ(rect.w, w);
+  EXPECT_EQ(rect.h, h);
+}
+
+}  // namespace
+
+// ============================================================================
+// 图块哈希
+// ============================================================================
+
+TEST(TileHashTest, SimdMatchesScalar) {
+  const TileHashPath paths[] = {TileHashPath::kAuto, TileHashPath::kSse2,
+                                TileHashPath::kAvx2};
+
+  std::mt19937 rng(42);
+  for (int trial = 0; trial < 200; ++trial) {
+    int row_bytes = 1 + static_cast<int>(rng() % 700);
+    int num_tiles = 1 + static_cast<int>(rng() % 8);
+    int tile_bytes = std::max(1, row_bytes / num_tiles);
+    int rows = 1 + static_cast<int>(rng() % 4);
+
+    std::vector<uint8_t> data(static_cast<size_t>(row_bytes) * rows);
+    for (auto& byte : data) {
+      byte = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<TileHashState> scalar(num_tiles, TileHashState{});
+    for (int row = 0; row < rows; ++row) {
+      AccumulateTileRow(&data[static_cast<size_t>(row) * row_bytes],
+                        row_bytes, tile_bytes, num_tiles, scalar.data(),
+                        TileHashPath::kScalar);
+    }
+
+    for (TileHashPath path : paths) {
+      if (!IsTileHashPathSupported(path)) {
+        continue;
+      }
+      std::vector<TileHashState> simd(num_tiles, TileHashState{});
+      for (int row = 0; row < rows; ++row) {
+        AccumulateTileRow(&data[static_cast<size_t>(row) * row_bytes],
+                          row_bytes, tile_bytes, num_tiles, simd.data(),
+                          path);
+      }
+      for (int tile = 0; tile < num_tiles; ++tile) {
+        ASSERT_EQ(FinalizeTileHash(simd[tile]),
+                  FinalizeTileHash(scalar[tile]))
+            << "path=" << static_cast<int>(path)
+            << " row_bytes=" << row_bytes << " tiles=" << num_tiles
+            << " tile=" << tile;
+      }
+    }
+  }
+}
+
+TEST(TileHashTest, PositionSensitive) {
+  // 同一个字落在不同的步
+  std::vector<uint8_t> a(64, 0);
+  std::vector<uint8_t> b(64, 0);
+  a[0] = 1;
+  b[32] = 1;
+  TileHashState state_a{};
+  TileHashState state_b{};
+  AccumulateTileRow(a.data(), 64, 64, 1, &state_a);
+  AccumulateTileRow(b.data(), 64, 64, 1, &state_b);
+  EXPECT_NE(FinalizeTileHash(state_a), FinalizeTileHash(state_b));
+}
+
+TEST(TileHashTest, DetectsChangesThatCancelInSums) {
+  // 64x64 图块的同一列，第 10/11/12 行 128/128/128 → 138/108/138：
+  // 差值 +10/-20/+10 的总和与按行加权和都为 0，线性校验和无法区分
+  std::vector<uint8_t> a(static_cast<size_t>(kTile) * kTile, 128);
+  std::vector<uint8_t> b = a;
+  const int column = 5;
+  b[10 * kTile + column] = 138;
+  b[11 * kTile + column] = 108;
+  b[12 * kTile + column] = 138;
+
+  const TileHashPath paths[] = {TileHashPath::kScalar, TileHashPath::kSse2,
+                                TileHashPath::kAvx2};
+  for (TileHashPath path : paths) {
+    if (!IsTileHashPathSupported(path)) {
+      continue;
+    }
+    TileHashState state_a{};
+    TileHashState state_b{};
+    for (int row = 0; row < kTile; ++row) {
+      AccumulateTileRow(&a[static_cast<size_t>(row) * kTile], kTile, kTile,
+                        1, &state_a, path);
+      AccumulateTileRow(&b[static_cast<size_t>(row) * kTile], kTile, kTile,
+                        1, &state_b, path);
+    }
+    EXPECT_NE(FinalizeTileHash(state_a), FinalizeTileHash(state_b))
+        << "path=" << static_cast<int>(path);
+  }
+}
+
+TEST(TileHashTest, DetectsEverySingleByteChange) {
+  std::mt19937 rng(7);
+  std::vector<uint8_t> base(96);
+  for (auto& byte : base) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  TileHashState base_state{};
+  AccumulateTileRow(base.data(), 96, 96, 1, &base_state);
+  uint64_t base_hash = FinalizeTileHash(base_state);
+
+  for (size_t i = 0; i < base.size(); ++i) {
+    for (int delta : {1, 128, 255}) {
+      std::vector<uint8_t> changed = base;
+      changed[i] = static_cast<uint8_t>(changed[i] + delta);
+      TileHashState state{};
+      AccumulateTileRow(changed.data(), 96, 96, 1, &state);
+      ASSERT_NE(FinalizeTileHash(state), base_hash)
+          << "byte=" << i << " delta=" << delta;
+    }
+  }
+}
+
+// ============================================================================
+// 静态帧检测
+// ============================================================================
+
+TEST(FrameChangeDetectorTest, FirstFrameIsFullUpdate) {
+  TestFrame frame(256, 128);
+  FrameChangeDetector detector;
+
+  const auto& info = detector.Analyze(frame.get());
+  EXPECT_TRUE(info.full_update);
+  EXPECT_EQ(info.total_tiles, 4 * 2);
+  EXPECT_FALSE(info.IsUnchanged());
+}
+
+TEST(FrameChangeDetectorTest, UnchangedFrameIgnoresPadding) {
+  std::mt19937 rng(7);
+  TestFrame frame(256, 128);
+  frame.FillRandom(rng);
+  FrameChangeDetector detector;
+  detector.Analyze(frame.get());
+
+  frame.ScramblePadding(256, 128);
+  const auto& info = detector.Analyze(frame.get());
+  EXPECT_FALSE(info.full_update);
+  EXPECT_TRUE(info.IsUnchanged());
+  EXPECT_TRUE(info.dirty_rects.empty());
+}
+
+TEST(FrameChangeDetectorTest, SingleLumaTileChange) {
+  TestFrame frame(256, 192);
+  FrameChangeDetector detector;
+  detector.Analyze(frame.get());
+
+  frame.At(0, kTile + 10, kTile + 20) ^= 0x01;
+  const auto& info = detector.Analyze(frame.get());
+  EXPECT_FALSE(info.full_update);
+  EXPECT_EQ(info.dirty_tiles, 1);
+  ASSERT_EQ(info.dirty_rects.size(), 1u);
+  ExpectRect(info.dirty_rects[0], kTile, kTile, kTile, kTile);
+
+  // 恢复后相对上一帧又变化一次，再下一帧不变
+  frame.At(0, kTile + 10, kTile + 20) ^= 0x01;
+  EXPECT_EQ(detector.Analyze(frame.get()).dirty_tiles, 1);
+  EXPECT_TRUE(detector.Analyze(frame.get()).IsUnchanged());
+}
+
+TEST(FrameChangeDetectorTest, ChromaOnlyChange) {
+  TestFrame frame(256, 192);
+  FrameChangeDetector detector;
+  detector.Analyze(frame.get());
+
+  // 色度平面 (40, 70) 对应亮度图块 (1, 2)
+  frame.At(2, 40, 70) = 0x10;
+  const auto& info = detector.Analyze(frame.get());
+  EXPECT_EQ(info.dirty_tiles, 1);
+  ASSERT_EQ(info.dirty_rects.size(), 1u);
+  ExpectRect(info.dirty_rects[0], kTile, 2 * kTile, kTile, kTile);
+}
+
+TEST(FrameChangeDetectorTest, FullChangeMergesEachTileRow) {
+  std::mt19937 rng(11);
+  TestFrame frame(256, 192);
+  FrameChangeDetector detector;
+  detector.Analyze(frame.get());
+
+  frame.FillRandom(rng);
+  const auto& info = detector.Analyze(frame.get());
+  EXPECT_FALSE(info.full_update);
+  EXPECT_EQ(info.dirty_tiles, info.total_tiles);
+  ASSERT_EQ(info.dirty_rects.size(), 3u);
+  for (int ty = 0; ty < 3; ++ty) {
+    ExpectRect(info.dirty_rects[ty], 0, ty * kTile, 256, kTile);
+  }
+}
+
+TEST(FrameChangeDetectorTest, OddSizeEdgeTilesAreClipped) {
+  TestFrame frame(130, 67);
+  FrameChangeDetector detector;
+  EXPECT_EQ(detector.Analyze(frame.get()).total_tiles, 3 * 2);
+
+  // 右下角的亮度像素
+  frame.At(0, 129, 66) ^= 0x01;
+  const auto* info = &detector.Analyze(frame.get());
+  EXPECT_EQ(info->dirty_tiles, 1);
+  ASSERT_EQ(info->dirty_rects.size(), 1u);
+  ExpectRect(info->dirty_rects[0], 2 * kTile, kTile, 2, 3);
+
+  // 右下角的色度像素（色度 65x34）落在同一个边缘图块
+  frame.At(1, 64, 33) ^= 0x01;
+  info = &detector.Analyze(frame.get());
+  EXPECT_EQ(info->dirty_tiles, 1);
+  ASSERT_EQ(info->dirty_rects.size(), 1u);
+  ExpectRect(info->dirty_rects[0], 2 * kTile, kTile, 2, 3);
+}
+
+TEST(FrameChangeDetectorTest, ResetAndResizeForceFullUpdate) {
+  TestFrame frame(128, 128);
+  TestFrame resized(192, 128);
+  FrameChangeDetector detector;
+  detector.Analyze(frame.get());
+  ASSERT_TRUE(detector.Analyze(frame.get()).IsUnchanged());
+
+  detector.Reset();
+  EXPECT_TRUE(detector.Analyze(frame.get()).full_update);
+
+  EXPECT_TRUE(detector.Analyze(resized.get()).full_update);
+  EXPECT_TRUE(detector.Analyze(resized.get()).IsUnchanged());
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_frame_duration_estimator.cpp
+ * @brief 单元测试 - 视频帧时长估计
+ *
+ * 测试目标：
+ * - 恒定帧率（含毫秒时间基的取整抖动）不判定为 VFR，帧率按 PTS 差计算
+ * - 帧时长优先于 PTS 差，没有 PTS 时回退到典型时长
+ * - 帧间隔变化的内容判定为 VFR；Seek 后不跨断点求差
+ * - PTS 差修正上一帧的时长，VFR 切换处不错位到后一帧
+ */
+
+#include <gtest/gtest.h>
+
+#include "player/video/frame_duration_estimator.h"
+
+using namespace zenplay;
+
+TEST(FrameDurationEstimatorTest, ConstantRateWithMillisecondJitter) {
+  FrameDurationEstimator estimator(30.0);
+  EXPECT_DOUBLE_EQ(estimator.TypicalDurationMs(), 1000.0 / 30.0);
+
+  // 23.976fps 写入毫秒时间基的容器：41ms / 42ms 交替
+  int64_t pts_ms = 0;
+  for (int i = 0; i < 48; ++i) {
+    estimator.OnFrame(pts_ms * 1000, 0);
+    pts_ms += (i % 3 == 2) ? 41 : 42;
+  }
+
+  EXPECT_FALSE(estimator.IsVariableFrameRate());
+  EXPECT_NEAR(estimator.ContentFps(), 24.0, 0.3);
+  EXPECT_NEAR(estimator.TypicalDurationMs(), 42.0, 0.5);
+}
+
+TEST(FrameDurationEstimatorTest, PrefersFrameDurationAndFallsBack) {
+  FrameDurationEstimator estimator(50.0);
+
+  // 第一帧没有 PTS 差：有帧时长用帧时长，否则用标称帧率
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(0, 0), 20.0);
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(20'000, 8'333), 8.333);
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(28'333, 0), 8.333);
+
+  // 没有 PTS 的帧取最近 PTS 差的中位数
+  EXPECT_DOUBLE_EQ(
+      estimator.OnFrame(FrameDurationEstimator::kUnknown, 0),
+      estimator.TypicalDurationMs());
+}
+
+TEST(FrameDurationEstimatorTest, DetectsVariableFrameRate) {
+  FrameDurationEstimator estimator(30.0);
+
+  // 120fps 片段与 30fps 片段交替（如屏幕录制）
+  int64_t pts_us = 0;
+  for (int i = 0; i < 64; ++i) {
+    estimator.OnFrame(pts_us, 0);
+    pts_us += (i / 4) % 2 == 0 ? 8'333 : 33'333;
+  }
+  EXPECT_TRUE(estimator.IsVariableFrameRate());
+  EXPECT_NEAR(estimator.ContentFps(), 1e6 / 20'833.0, 0.5);
+
+  // 每帧时长跟随实际间隔（最后一段是 30fps），而不是平均帧率
+  double previous_ms = 0.0;
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(pts_us, 0, &previous_ms), 33.333);
+  EXPECT_DOUBLE_EQ(previous_ms, 33.333);
+
+  // Seek 后的第一帧不与 Seek 前的最后一帧求差
+  estimator.ResetTimeline();
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(600'000'000, 0),
+                   estimator.TypicalDurationMs());
+}
+
+TEST(FrameDurationEstimatorTest, PtsGapBelongsToPreviousFrame) {
+  FrameDurationEstimator estimator(30.0);
+  double previous_ms = 0.0;
+
+  // 120fps 切到 30fps：第三帧之后的间隔变为 33.333ms
+  estimator.OnFrame(0, 0, &previous_ms);
+  EXPECT_DOUBLE_EQ(previous_ms, 0.0);  // 第一帧没有上一帧
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(8'333, 0, &previous_ms), 8.333);
+  EXPECT_DOUBLE_EQ(previous_ms, 8.333);
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(16'666, 0, &previous_ms), 8.333);
+
+  // 与第四帧的 PTS 差是第三帧的时长，第四帧先按新间隔预测
+  EXPECT_DOUBLE_EQ(estimator.OnFrame(50'000, 0, &previous_ms), 33.334);
+  EXPECT_DOUBLE_EQ(previous_ms, 33.334);
+
+  // 上一帧有解码器给出的帧时长时不修正
+  previous_ms = 0.0;
+  estimator.OnFrame(60'000, 10'000, &previous_ms);
+  EXPECT_DOUBLE_EQ(previous_ms, 10.0);  // 第四帧没有帧时长，按 PTS 差修正
+  previous_ms = 0.0;
+  estimator.OnFrame(70'000, 0, &previous_ms);
+  EXPECT_DOUBLE_EQ(previous_ms, 0.0);
+}
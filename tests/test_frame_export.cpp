@@ -0,0 +1,264 @@
+/**
+ * @file test_frame_export.cpp
+ * @brief 单元测试 - 解码帧共享内存导出（memfd + SCM_RIGHTS）
+ *
+ * 测试目标：
+ * - 读端经套接字拿到 memfd 后读到的像素、尺寸、PTS 与写端一致
+ * - 读端落后时跳帧并计数，处理期间槽位被覆盖时 Release() 返回 false
+ * - 不支持的格式不导出
+ * - ⏱️ 1080p 导出吞吐量（DISABLED，手动运行）
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "player/video/export/frame_export_reader.h"
+#include "player/video/export/frame_export_sink.h"
+
+using namespace zenplay;
+
+namespace {
+
+/**
+ * @brief 测试用 YUV420P 帧（行跨度带填充，覆盖逐行拷贝）
+ */
+struct TestFrame {
+  std::vector<uint8_t> planes[3];
+  AVFrame frame = {};
+
+  TestFrame(int width, int height) {
+    frame.format = AV_PIX_FMT_YUV420P;
+    frame.width = width;
+    frame.height = height;
+    for (int i = 0; i < 3; ++i) {
+      int plane_width = i == 0 ? width : (width + 1) / 2;
+      int plane_height = i == 0 ? height : (height + 1) / 2;
+      frame.linesize[i] = plane_width + 32;
+      planes[i].resize(static_cast<size_t>(frame.linesize[i]) * plane_height);
+      frame.data[i] = planes[i].data();
+    }
+  }
+
+  void Fill(uint8_t value) {
+    for (int i = 0; i < 3; ++i) {
+      std::fill(planes[i].begin(), planes[i].end(),
+                static_cast<uint8_t>(value + i));
+    }
+  }
+};
+
+std::string TestSocketPath() {
+  return "/tmp/zenplay_frame_export_test_" + std::to_string(getpid()) +
+         ".sock";
+}
+
+class FrameExportTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kSlotCount = 4;
+
+  void SetUp() override {
+    auto result = sink_.Open(TestSocketPath(), kSlotCount);
+    if (result.Code() == ErrorCode::kNotSupported) {
+      GTEST_SKIP() << result.Message();
+    }
+    ASSERT_TRUE(result.IsOk()) << result.FullMessage();
+  }
+
+  /**
+   * @brief 写端先发布一帧（创建段），读端再连接
+   */
+  void PublishAndConnect(TestFrame& frame) {
+    frame.Fill(1);
+    ASSERT_TRUE(sink_.Publish(&frame.frame, 0));
+    ASSERT_TRUE(reader_.Connect(sink_.socket_path(), 2000))
+        << reader_.last_error();
+  }
+
+  FrameExportSink sink_;
+  FrameExportReader reader_;
+};
+
+}  // namespace
+
+// ============================================================================
+// 基本导出
+// ============================================================================
+
+TEST_F(FrameExportTest, ReaderSeesPublishedFrames) {
+  TestFrame frame(64, 36);
+  PublishAndConnect(frame);
+
+  // 连接时的最新帧之前的帧不回放
+  FrameExportFrame exported;
+  EXPECT_FALSE(reader_.Acquire(&exported));
+
+  for (int n = 0; n < 3; ++n) {
+    frame.Fill(static_cast<uint8_t>(10 * (n + 1)));
+    ASSERT_TRUE(sink_.Publish(&frame.frame, 40000 * n));
+
+    ASSERT_TRUE(reader_.Acquire(&exported));
+    EXPECT_EQ(exported.info.frame_number, static_cast<uint64_t>(n + 1));
+    EXPECT_EQ(exported.info.width, 64);
+    EXPECT_EQ(exported.info.height, 36);
+    EXPECT_EQ(exported.info.format, AV_PIX_FMT_YUV420P);
+    EXPECT_EQ(exported.info.pts_us, 40000 * n);
+    ASSERT_EQ(exported.info.plane_count, 3u);
+
+    // 行按 64 字节对齐，只比较有效宽度
+    const int widths[3] = {64, 32, 32};
+    const int heights[3] = {36, 18, 18};
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(exported.linesize[i] % 64, 0);
+      const uint8_t expected = static_cast<uint8_t>(10 * (n + 1) + i);
+      const uint8_t* last_row =
+          exported.data[i] + (heights[i] - 1) * exported.linesize[i];
+      EXPECT_EQ(exported.data[i][0], expected);
+      EXPECT_EQ(last_row[widths[i] - 1], expected);
+    }
+    EXPECT_TRUE(reader_.Release(exported));
+  }
+
+  EXPECT_FALSE(reader_.Acquire(&exported));
+  EXPECT_EQ(reader_.frames_missed(), 0u);
+  EXPECT_EQ(sink_.consumers_served(), 1u);
+
+  sink_.Close();
+  EXPECT_TRUE(reader_.IsWriterClosed());
+  EXPECT_FALSE(reader_.WaitForFrame(&exported, 100));
+}
+
+TEST_F(FrameExportTest, ReaderConnectedBeforeFirstFrame) {
+  TestFrame frame(32, 32);
+  frame.Fill(7);
+
+  // 段在第一帧到达时才创建，提前连接的读端等待 memfd
+  std::thread publisher([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sink_.Publish(&frame.frame, 0);
+  });
+  bool connected = reader_.Connect(sink_.socket_path(), 2000);
+  publisher.join();
+  ASSERT_TRUE(connected) << reader_.last_error();
+
+  ASSERT_TRUE(sink_.Publish(&frame.frame, 1000));
+  FrameExportFrame exported;
+  ASSERT_TRUE(reader_.WaitForFrame(&exported, 1000));
+  EXPECT_EQ(exported.data[0][0], 7);
+}
+
+// ============================================================================
+// 读端落后
+// ============================================================================
+
+TEST_F(FrameExportTest, SlowReaderDetectsOverwrite) {
+  TestFrame frame(64, 36);
+  PublishAndConnect(frame);
+
+  ASSERT_TRUE(sink_.Publish(&frame.frame, 0));
+  FrameExportFrame exported;
+  ASSERT_TRUE(reader_.Acquire(&exported));
+
+  // 读端持有这一帧期间写端绕回同一槽位
+  for (uint32_t i = 0; i < kSlotCount; ++i) {
+    ASSERT_TRUE(sink_.Publish(&frame.frame, 0));
+  }
+  EXPECT_FALSE(reader_.Release(exported));
+  EXPECT_EQ(reader_.frames_missed(), 1u);
+}
+
+TEST_F(FrameExportTest, LaggingReaderSkipsAhead) {
+  TestFrame frame(64, 36);
+  PublishAndConnect(frame);
+
+  constexpr int kBurst = 20;
+  for (int i = 0; i < kBurst; ++i) {
+    ASSERT_TRUE(sink_.Publish(&frame.frame, i));
+  }
+
+  // 只保留最近 kSlotCount / 2 帧，更早的帧已被覆盖
+  int read = 0;
+  FrameExportFrame exported;
+  while (reader_.Acquire(&exported)) {
+    EXPECT_TRUE(reader_.Release(exported));
+    ++read;
+  }
+  EXPECT_EQ(read, static_cast<int>(kSlotCount / 2));
+  EXPECT_EQ(reader_.frames_missed(),
+            static_cast<uint64_t>(kBurst - kSlotCount / 2));
+  EXPECT_EQ(exported.info.frame_number, static_cast<uint64_t>(kBurst));
+}
+
+TEST_F(FrameExportTest, UnsupportedFramesAreSkipped) {
+  TestFrame frame(64, 36);
+  PublishAndConnect(frame);
+
+  // 比第一帧大的帧放不进槽位
+  TestFrame large(128, 72);
+  large.Fill(3);
+  EXPECT_FALSE(sink_.Publish(&large.frame, 0));
+
+  AVFrame hardware = frame.frame;
+  hardware.format = AV_PIX_FMT_D3D11;
+  EXPECT_FALSE(sink_.Publish(&hardware, 0));
+
+  EXPECT_EQ(sink_.frames_skipped(), 2u);
+  EXPECT_EQ(sink_.frames_published(), 1u);
+}
+
+// ============================================================================
+// 性能
+// ============================================================================
+
+TEST_F(FrameExportTest, DISABLED_ThroughputBenchmark) {
+  FrameExportSink sink;
+  std::string socket_path = TestSocketPath() + ".bench";
+  ASSERT_TRUE(sink.Open(socket_path, 8).IsOk());
+
+  TestFrame frame(1920, 1080);
+  frame.Fill(16);
+  ASSERT_TRUE(sink.Publish(&frame.frame, 0));
+
+  FrameExportReader reader;
+  ASSERT_TRUE(reader.Connect(socket_path, 2000));
+
+  constexpr int kFrames = 2000;
+  uint64_t consumed = 0;
+  uint64_t checksum = 0;
+  std::thread consumer([&]() {
+    // 读端只读每行首字节，模拟就地分析
+    FrameExportFrame exported;
+    while (reader.WaitForFrame(&exported, 1000)) {
+      for (int y = 0; y < exported.info.height; ++y) {
+        checksum += exported.data[0][y * exported.linesize[0]];
+      }
+      if (reader.Release(exported)) {
+        ++consumed;
+      }
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kFrames; ++i) {
+    sink.Publish(&frame.frame, i);
+  }
+  auto elapsed = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  sink.Close();
+  consumer.join();
+
+  const double frame_mb = 1920 * 1080 * 1.5 / (1024.0 * 1024.0);
+  std::cout << "Frame export 1080p: " << kFrames / elapsed << " frames/sec, "
+            << kFrames * frame_mb / elapsed << " MB/s" << std::endl;
+  std::cout << "Consumer: " << consumed << " frames intact, "
+            << reader.frames_missed() << " missed (checksum " << checksum
+            << ")" << std::endl;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file test_hover_seek_prefetch.cpp
+ * @brief 单元测试 - 悬停预取在播放侧的交接
+ *
+ * 测试目标：
+ * - Seek 时放弃尚未完成的悬停请求（命中与否都放弃）
+ * - 流布局变化时丢弃预取结果，未解码音频时丢弃预取的音频包
+ * - 推迟的 Demuxer Seek 属于记录它的那次 Seek，之后的 Seek 使其作废
+ * - 推迟的跳转重新读出的已预取包只跳过到最后一个预取包为止
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "player/playback/hover_seek_prefetch.h"
+
+extern "C" {
+#include <libavcodec/packet.h>
+#include <libavutil/frame.h>
+}
+
+using namespace zenplay;
+using Prefetch = HoverSeekPrefetch::Prefetch;
+using DeferredSeek = HoverSeekPrefetch::DeferredSeek;
+
+namespace {
+
+constexpr int kVideo = 0;
+constexpr int kAudio = 1;
+constexpr AVRational kVideoTimeBase{1, 1000};
+
+AVPacket* MakePacket(int stream_index, int64_t dts, int64_t pts) {
+  AVPacket* packet = av_packet_alloc();
+  packet->stream_index = stream_index;
+  packet->dts = dts;
+  packet->pts = pts;
+  return packet;
+}
+
+// 悬停在 seek_ms：关键帧 0 起每 40ms 一个视频包，帧覆盖 [seek_ms, +120ms]
+std::unique_ptr<Prefetch> MakePrefetch(int64_t seek_ms) {
+  auto prefetch = std::make_unique<Prefetch>();
+  prefetch->seek_us = seek_ms * 1000;
+  prefetch->video_stream_index = kVideo;
+  prefetch->audio_stream_index = kAudio;
+  prefetch->video_time_base = kVideoTimeBase;
+  for (int64_t ts = 0; ts <= seek_ms + 120; ts += 40) {
+    prefetch->video_packets.push_back(MakePacket(kVideo, ts, ts));
+  }
+  prefetch->audio_packets.push_back(MakePacket(kAudio, 0, 0));
+  prefetch->audio_packets.push_back(MakePacket(kAudio, seek_ms, seek_ms));
+  prefetch->frames.emplace_back(av_frame_alloc());
+  prefetch->first_frame_us = seek_ms * 1000;
+  prefetch->last_frame_us = (seek_ms + 120) * 1000;
+  return prefetch;
+}
+
+HoverSeekPrefetch::StreamLayout MakeLayout() {
+  HoverSeekPrefetch::StreamLayout layout;
+  layout.video_stream_index = kVideo;
+  layout.audio_stream_index = kAudio;
+  layout.video_time_base = kVideoTimeBase;
+  layout.decode_audio = true;
+  return layout;
+}
+
+/**
+ * @brief 记录悬停请求，保存一个已就绪的预取结果
+ */
+class FakePrefetchSource : public SeekPrefetchSource {
+ public:
+  struct Log {
+    std::vector<int64_t> requests;
+    int cancels = 0;
+  };
+
+  explicit FakePrefetchSource(Log* log) : log_(log) {}
+
+  void SetReady(std::unique_ptr<Prefetch> prefetch) {
+    ready_ = std::move(prefetch);
+  }
+
+  void Request(int64_t timestamp_ms) override {
+    log_->requests.push_back(timestamp_ms);
+  }
+
+  void Cancel() override { ++log_->cancels; }
+
+  std::unique_ptr<Prefetch> Take(int64_t timestamp_ms) override {
+    if (!ready_ || !ready_->Covers(timestamp_ms)) {
+      return nullptr;
+    }
+    return std::move(ready_);
+  }
+
+ private:
+  Log* log_;
+  std::unique_ptr<Prefetch> ready_;
+};
+
+}  // namespace
+
+TEST(HoverSeekPrefetchTest, DisabledIsNoOp) {
+  HoverSeekPrefetch hover;
+  EXPECT_FALSE(hover.enabled());
+  hover.Request(1000);
+  hover.Cancel();
+  EXPECT_FALSE(hover.TakeForSeek(1000, MakeLayout()));
+}
+
+TEST(HoverSeekPrefetchTest, SeekCancelsPendingHoverRequest) {
+  FakePrefetchSource::Log log;
+  auto source = std::make_unique<FakePrefetchSource>(&log);
+  FakePrefetchSource* fake = source.get();
+  HoverSeekPrefetch hover;
+  hover.Enable(std::move(source));
+
+  // 悬停在 5000ms，尚未完成时点击别处：未命中，悬停请求作废
+  hover.Request(5000);
+  EXPECT_EQ(log.requests, std::vector<int64_t>{5000});
+  EXPECT_FALSE(hover.TakeForSeek(9000, MakeLayout()));
+  EXPECT_EQ(log.cancels, 1);
+
+  // 命中时同样放弃后续的悬停请求，结果只能取走一次
+  fake->SetReady(MakePrefetch(2000));
+  hover.Request(3000);
+  auto prefetch = hover.TakeForSeek(2040, MakeLayout());
+  ASSERT_TRUE(prefetch);
+  EXPECT_EQ(prefetch->seek_us, 2000 * 1000);
+  EXPECT_EQ(log.cancels, 2);
+  EXPECT_FALSE(hover.TakeForSeek(2040, MakeLayout()));
+}
+
+TEST(HoverSeekPrefetchTest, DiscardsPrefetchForChangedLayout) {
+  FakePrefetchSource::Log log;
+  auto source = std::make_unique<FakePrefetchSource>(&log);
+  FakePrefetchSource* fake = source.get();
+  HoverSeekPrefetch hover;
+  hover.Enable(std::move(source));
+
+  // 切换过音轨
+  HoverSeekPrefetch::StreamLayout layout = MakeLayout();
+  layout.audio_stream_index = 2;
+  fake->SetReady(MakePrefetch(1000));
+  EXPECT_FALSE(hover.TakeForSeek(1000, layout));
+
+  // 视频时间基不同（或主 Demuxer 找不到视频流）
+  layout = MakeLayout();
+  layout.video_time_base = AVRational{0, 1};
+  fake->SetReady(MakePrefetch(1000));
+  EXPECT_FALSE(hover.TakeForSeek(1000, layout));
+
+  // 音频解码器未打开：只复用视频包
+  layout = MakeLayout();
+  layout.decode_audio = false;
+  fake->SetReady(MakePrefetch(1000));
+  auto prefetch = hover.TakeForSeek(1000, layout);
+  ASSERT_TRUE(prefetch);
+  EXPECT_TRUE(prefetch->audio_packets.empty());
+  EXPECT_EQ(prefetch->audio_stream_index, -1);
+  EXPECT_FALSE(prefetch->video_packets.empty());
+}
+
+TEST(HoverSeekPrefetchTest, LaterSeekDropsDeferredSeek) {
+  HoverSeekPrefetch hover;
+  auto prefetch = MakePrefetch(1000);
+
+  hover.DeferSeek(*prefetch, 1);
+  // 解封装线程执行之前又直接跳转了一次
+  hover.DropDeferredSeek();
+
+  DeferredSeek skip;
+  skip.serial = 1;
+  skip.video_stream_index = kVideo;
+  skip.video_last_ts = 1120;
+  uint64_t seek_serial = 2;
+  EXPECT_FALSE(hover.TakeDeferredSeek(&skip, &seek_serial));
+  EXPECT_EQ(seek_serial, 2u);
+  // 上一次的跳过状态属于旧 Seek，已预取的包已被清空
+  EXPECT_EQ(skip.video_stream_index, -1);
+  EXPECT_EQ(skip.video_last_ts, AV_NOPTS_VALUE);
+
+  AVPacket* packet = MakePacket(kVideo, 40, 40);
+  EXPECT_FALSE(HoverSeekPrefetch::SkipPrefetchedPacket(packet, &skip));
+  av_packet_free(&packet);
+}
+
+TEST(HoverSeekPrefetchTest, SkipsPrefetchedPacketsOnlyUpToLastOne) {
+  HoverSeekPrefetch hover;
+  auto prefetch = MakePrefetch(1000);  // 视频包 0..1120，音频包 0、1000
+  hover.DeferSeek(*prefetch, 5);
+
+  DeferredSeek skip;
+  uint64_t seek_serial = 4;
+  ASSERT_TRUE(hover.TakeDeferredSeek(&skip, &seek_serial));
+  EXPECT_EQ(seek_serial, 5u);  // 之后读出的包属于命中的那次 Seek
+  EXPECT_EQ(skip.timestamp_us, 1000 * 1000);
+  EXPECT_EQ(skip.video_last_ts, 1120);
+  EXPECT_EQ(skip.audio_last_ts, 1000);
+  // 只执行一次
+  DeferredSeek again = skip;
+  EXPECT_FALSE(hover.TakeDeferredSeek(&again, &seek_serial));
+
+  struct Case {
+    int stream_index;
+    int64_t dts;
+    int64_t pts;
+    bool skipped;
+  };
+  const Case cases[] = {
+      {kVideo, 0, 0, true},
+      {kAudio, 0, 0, true},
+      {kVideo, AV_NOPTS_VALUE, 1120, true},  // dts 缺失时用 pts
+      {kVideo, 1160, 1160, false},           // 越过最后一个预取包
+      {kVideo, 1080, 1080, false},           // 该流不再检查
+      {kAudio, 1000, 1000, true},            // 音频单独判断
+      {kAudio, 1021, 1021, false},
+      {kAudio, 500, 500, false},
+      {2, 0, 0, false},  // 其他流
+  };
+  for (const Case& c : cases) {
+    AVPacket* packet = MakePacket(c.stream_index, c.dts, c.pts);
+    EXPECT_EQ(HoverSeekPrefetch::SkipPrefetchedPacket(packet, &skip),
+              c.skipped)
+        << "stream " << c.stream_index << " dts " << c.dts;
+    av_packet_free(&packet);
+  }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_loop_frame_cache.cpp
+ * @brief 单元测试 - A-B 循环帧缓存
+ *
+ * 测试目标：
+ * - 区间判定（A 点之前、B 点之后、跨越 A 点的音频帧）
+ * - 到达 B 点自动结束第一遍，两路都结束后缓存可回放
+ * - 超出内存上限时缓存失效并释放全部帧
+ * - 按轮次偏移时间戳，视频帧共享像素缓冲区
+ */
+
+#include <gtest/gtest.h>
+
+#include "player/common/loop_frame_cache.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+using namespace zenplay;
+using AddResult = LoopFrameCache::AddResult;
+
+namespace {
+
+constexpr size_t kMegabyte = 1024 * 1024;
+
+// 64x64 YUV420P，约 6KB
+AVFramePtr MakeVideoFrame(int64_t pts_ms, MediaTimestamp* timestamp) {
+  AVFramePtr frame(av_frame_alloc());
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = 64;
+  frame->height = 64;
+  EXPECT_EQ(av_frame_get_buffer(frame.get(), 0), 0);
+
+  timestamp->time_base = {1, 90000};
+  timestamp->pts = pts_ms * 90;
+  timestamp->dts = timestamp->pts;
+  frame->pts = timestamp->pts;
+  frame->pkt_dts = timestamp->dts;
+  return frame;
+}
+
+// 44.1kHz 立体声 S16，1024 个采样（约 23ms）
+ResampledAudioFrame MakeAudioFrame(int64_t pts_ms) {
+  ResampledAudioFrame frame;
+  frame.pts_ms = pts_ms;
+  frame.sample_rate = 44100;
+  frame.channels = 2;
+  frame.bytes_per_sample = 2;
+  frame.sample_count = 1024;
+  frame.pcm_data.assign(1024 * 2 * 2, static_cast<uint8_t>(pts_ms));
+  return frame;
+}
+
+}  // namespace
+
+TEST(LoopFrameCacheTest, ClassifiesFramesAgainstRange) {
+  LoopFrameCache cache(64 * kMegabyte);
+  cache.Reset(1000, 2000);
+
+  MediaTimestamp ts;
+  AVFramePtr before = MakeVideoFrame(960, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(before.get(), ts), AddResult::kBeforeStart);
+
+  AVFramePtr first = MakeVideoFrame(1000, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(first.get(), ts), AddResult::kCached);
+
+  // 990ms + 23ms 跨越 A 点，需要缓存；960ms 的帧在 A 点之前结束
+  EXPECT_EQ(cache.AddAudioFrame(MakeAudioFrame(960)), AddResult::kBeforeStart);
+  EXPECT_EQ(cache.AddAudioFrame(MakeAudioFrame(990)), AddResult::kCached);
+
+  EXPECT_EQ(cache.video_frame_count(), 1u);
+  EXPECT_EQ(cache.audio_frame_count(), 1u);
+  EXPECT_FALSE(cache.IsComplete(true, true));
+}
+
+TEST(LoopFrameCacheTest, PastEndCompletesStream) {
+  LoopFrameCache cache(64 * kMegabyte);
+  cache.Reset(0, 100);
+
+  MediaTimestamp ts;
+  for (int64_t pts = 0; pts < 100; pts += 40) {
+    AVFramePtr frame = MakeVideoFrame(pts, &ts);
+    ASSERT_EQ(cache.AddVideoFrame(frame.get(), ts), AddResult::kCached);
+  }
+  AVFramePtr past = MakeVideoFrame(120, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(past.get(), ts), AddResult::kPastEnd);
+  EXPECT_TRUE(cache.IsComplete(true, false));
+  EXPECT_FALSE(cache.IsComplete(true, true));
+
+  // 第一遍结束后，即使时间戳回到区间内也不再缓存
+  AVFramePtr late = MakeVideoFrame(50, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(late.get(), ts), AddResult::kPastEnd);
+
+  ASSERT_EQ(cache.AddAudioFrame(MakeAudioFrame(0)), AddResult::kCached);
+  cache.MarkAudioComplete();  // B 点在文件末尾之后
+  EXPECT_TRUE(cache.IsComplete(true, true));
+  EXPECT_TRUE(cache.IsReplayable(true, true));
+  EXPECT_EQ(cache.video_frame_count(), 3u);
+}
+
+TEST(LoopFrameCacheTest, OverflowReleasesEverything) {
+  MediaTimestamp ts;
+  AVFramePtr f0 = MakeVideoFrame(0, &ts);
+  size_t frame_bytes = 0;
+  for (int i = 0; i < AV_NUM_DATA_POINTERS && f0->buf[i]; ++i) {
+    frame_bytes += f0->buf[i]->size;
+  }
+
+  // 只容得下两帧视频
+  LoopFrameCache cache(frame_bytes * 5 / 2);
+  cache.Reset(0, 1000);
+
+  ASSERT_EQ(cache.AddVideoFrame(f0.get(), ts), AddResult::kCached);
+  AVFramePtr f1 = MakeVideoFrame(40, &ts);
+  ASSERT_EQ(cache.AddVideoFrame(f1.get(), ts), AddResult::kCached);
+  EXPECT_GT(cache.bytes_used(), 0u);
+
+  AVFramePtr f2 = MakeVideoFrame(80, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(f2.get(), ts), AddResult::kOverflow);
+  EXPECT_TRUE(cache.overflowed());
+  EXPECT_EQ(cache.bytes_used(), 0u);
+  EXPECT_EQ(cache.video_frame_count(), 0u);
+
+  // 失效后仍然报告 B 点，调用方据此决定何时跳回
+  AVFramePtr past = MakeVideoFrame(1000, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(past.get(), ts), AddResult::kPastEnd);
+  EXPECT_TRUE(cache.IsComplete(true, false));
+  EXPECT_FALSE(cache.IsReplayable(true, false));
+
+  // 新区间重新开始
+  cache.Reset(0, 1000);
+  EXPECT_FALSE(cache.overflowed());
+  AVFramePtr again = MakeVideoFrame(0, &ts);
+  EXPECT_EQ(cache.AddVideoFrame(again.get(), ts), AddResult::kCached);
+}
+
+TEST(LoopFrameCacheTest, IterationsOffsetTimestamps) {
+  LoopFrameCache cache(64 * kMegabyte);
+  cache.Reset(1000, 3000);
+
+  MediaTimestamp ts;
+  AVFramePtr source = MakeVideoFrame(1500, &ts);
+  ASSERT_EQ(cache.AddVideoFrame(source.get(), ts), AddResult::kCached);
+  ASSERT_EQ(cache.AddAudioFrame(MakeAudioFrame(1200)), AddResult::kCached);
+  cache.MarkVideoComplete();
+  cache.MarkAudioComplete();
+  ASSERT_TRUE(cache.IsReplayable(true, true));
+  EXPECT_DOUBLE_EQ(cache.VideoFramePtsMs(0), 1500.0);
+
+  // 第 2 轮：PTS + 2 × 2000ms
+  MediaTimestamp replay_ts;
+  AVFramePtr replay = cache.MakeVideoFrame(0, 2, &replay_ts);
+  ASSERT_NE(replay, nullptr);
+  EXPECT_EQ(replay_ts.pts, (1500 + 4000) * 90);
+  EXPECT_EQ(replay->pts, replay_ts.pts);
+  EXPECT_DOUBLE_EQ(replay_ts.ToMilliseconds(), 5500.0);
+  // 回放帧与缓存共享像素，不拷贝
+  EXPECT_EQ(replay->data[0], source->data[0]);
+
+  ResampledAudioFrame audio = cache.MakeAudioFrame(0, 3);
+  EXPECT_EQ(audio.pts_ms, 1200 + 6000);
+  EXPECT_EQ(audio.GetDataSize(), 1024u * 2 * 2);
+
+  // 缓存中的原始时间戳不受影响
+  EXPECT_EQ(cache.AudioFramePtsMs(0), 1200);
+  EXPECT_DOUBLE_EQ(cache.VideoFramePtsMs(0), 1500.0);
+}
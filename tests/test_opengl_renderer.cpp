@@ -0,0 +1,221 @@
+/**
+ * @file test_opengl_renderer.cpp
+ * @brief 单元测试 - OpenGL ES 渲染路径（EGL 无表面模式）
+ *
+ * 测试目标：
+ * - I420 / NV12 经 PBO 上传、着色器转换后颜色正确
+ * - limited / full range 与 BT.601 / BT.709 系数正确
+ * - 行跨度大于宽度的帧按行拷贝
+ * - 统计浮层按 alpha 混合绘制在左上角
+ *
+ * 在 CI 中使用 Mesa llvmpipe；没有可用的 EGL 驱动时跳过。
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "player/video/render/impl/opengl/gl_context.h"
+#include "player/video/render/impl/opengl/gl_frame_uploader.h"
+#include "player/video/render/impl/opengl/gl_overlay.h"
+#include "player/video/render/impl/opengl/gl_shader.h"
+#include "player/video/render/stats_overlay.h"
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kFrameWidth = 32;
+constexpr int kFrameHeight = 24;
+constexpr int kTargetWidth = 64;
+constexpr int kTargetHeight = 48;
+
+struct Rgb {
+  int r;
+  int g;
+  int b;
+};
+
+/**
+ * @brief 纯色 YUV 帧（平面数据由 std::vector 持有）
+ */
+struct SolidFrame {
+  std::vector<uint8_t> planes[3];
+  AVFrame frame = {};
+
+  SolidFrame(AVPixelFormat format,
+             uint8_t y,
+             uint8_t u,
+             uint8_t v,
+             int padding = 0) {
+    frame.format = format;
+    frame.width = kFrameWidth;
+    frame.height = kFrameHeight;
+
+    const int chroma_width = kFrameWidth / 2;
+    const int chroma_height = kFrameHeight / 2;
+    frame.linesize[0] = kFrameWidth + padding;
+    planes[0].assign(frame.linesize[0] * kFrameHeight, y);
+
+    if (format == AV_PIX_FMT_NV12) {
+      frame.linesize[1] = chroma_width * 2 + padding;
+      planes[1].resize(frame.linesize[1] * chroma_height);
+      for (size_t i = 0; i + 1 < planes[1].size(); i += 2) {
+        planes[1][i] = u;
+        planes[1][i + 1] = v;
+      }
+    } else {
+      frame.linesize[1] = chroma_width + padding;
+      frame.linesize[2] = chroma_width + padding;
+      planes[1].assign(frame.linesize[1] * chroma_height, u);
+      planes[2].assign(frame.linesize[2] * chroma_height, v);
+    }
+    for (int i = 0; i < 3; ++i) {
+      frame.data[i] = planes[i].empty() ? nullptr : planes[i].data();
+    }
+  }
+};
+
+class OpenGLRendererTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!GLContext::IsAvailable(true)) {
+      GTEST_SKIP() << "EGL surfaceless platform not available";
+    }
+    auto result =
+        context_.Initialize(nullptr, kTargetWidth, kTargetHeight, true);
+    if (!result.IsOk()) {
+      GTEST_SKIP() << result.FullMessage();
+    }
+    ASSERT_TRUE(shader_.Initialize().IsOk());
+    glGenVertexArrays(1, &vertex_array_);
+  }
+
+  void TearDown() override {
+    if (vertex_array_) {
+      glDeleteVertexArrays(1, &vertex_array_);
+    }
+    uploader_.Cleanup();
+    shader_.Cleanup();
+    context_.Cleanup();
+  }
+
+  /**
+   * @brief 上传并绘制一帧，返回画面中心像素
+   */
+  Rgb Render(SolidFrame& solid, AVColorSpace color_space, bool full_range) {
+    auto format = static_cast<AVPixelFormat>(solid.frame.format);
+    EXPECT_TRUE(
+        uploader_.Configure(format, kFrameWidth, kFrameHeight).IsOk());
+
+    // 多于 PBO 数量的帧，覆盖轮换路径
+    for (size_t i = 0; i <= GLFrameUploader::kPboCount; ++i) {
+      EXPECT_TRUE(uploader_.Upload(&solid.frame));
+      context_.BindDrawTarget();
+      glViewport(0, 0, kTargetWidth, kTargetHeight);
+      glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+      shader_.Use(uploader_.layout(), color_space, full_range, kFrameHeight);
+      uploader_.BindTextures();
+      glBindVertexArray(vertex_array_);
+      glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+      context_.SwapBuffers();
+    }
+
+    uint8_t pixel[4] = {};
+    glReadPixels(kTargetWidth / 2, kTargetHeight / 2, 1, 1, GL_RGBA,
+                 GL_UNSIGNED_BYTE, pixel);
+    EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+    return Rgb{pixel[0], pixel[1], pixel[2]};
+  }
+
+  GLContext context_;
+  GLShader shader_;
+  GLFrameUploader uploader_;
+  GLuint vertex_array_ = 0;
+};
+
+void ExpectColor(const Rgb& actual, const Rgb& expected) {
+  constexpr int kTolerance = 3;
+  EXPECT_LE(std::abs(actual.r - expected.r), kTolerance) << "r=" << actual.r;
+  EXPECT_LE(std::abs(actual.g - expected.g), kTolerance) << "g=" << actual.g;
+  EXPECT_LE(std::abs(actual.b - expected.b), kTolerance) << "b=" << actual.b;
+}
+
+}  // namespace
+
+// ============================================================================
+// 颜色转换
+// ============================================================================
+
+TEST_F(OpenGLRendererTest, PlanarLimitedRangeBt601) {
+  // BT.601 limited 红色：Y=81 U=90 V=240
+  SolidFrame red(AV_PIX_FMT_YUV420P, 81, 90, 240);
+  ExpectColor(Render(red, AVCOL_SPC_BT470BG, false), {255, 0, 0});
+}
+
+TEST_F(OpenGLRendererTest, SemiPlanarMatchesPlanar) {
+  SolidFrame planar(AV_PIX_FMT_YUV420P, 145, 54, 34);
+  SolidFrame nv12(AV_PIX_FMT_NV12, 145, 54, 34);
+  Rgb expected = Render(planar, AVCOL_SPC_BT470BG, false);
+  ExpectColor(Render(nv12, AVCOL_SPC_BT470BG, false), expected);
+  // BT.601 limited 绿色
+  ExpectColor(expected, {0, 255, 0});
+}
+
+TEST_F(OpenGLRendererTest, FullRangeAndBt709) {
+  SolidFrame white(AV_PIX_FMT_YUV420P, 255, 128, 128);
+  ExpectColor(Render(white, AVCOL_SPC_BT709, true), {255, 255, 255});
+
+  // BT.709 limited 蓝色：Y=32 U=240 V=118
+  SolidFrame blue(AV_PIX_FMT_YUV420P, 32, 240, 118);
+  ExpectColor(Render(blue, AVCOL_SPC_BT709, false), {0, 0, 255});
+}
+
+TEST_F(OpenGLRendererTest, PaddedLinesize) {
+  SolidFrame red(AV_PIX_FMT_NV12, 81, 90, 240, 16);
+  ExpectColor(Render(red, AVCOL_SPC_BT470BG, false), {255, 0, 0});
+}
+
+// ============================================================================
+// 统计浮层
+// ============================================================================
+
+TEST_F(OpenGLRendererTest, OverlayBlendsAtTopLeft) {
+  GLOverlay overlay;
+  ASSERT_TRUE(overlay.Initialize().IsOk());
+
+  // 半透明黑底（alpha 0xA0）盖在白色背景上
+  OverlayImage image;
+  image.width = 16;
+  image.height = 8;
+  image.pixels.assign(image.width * image.height * 4, 0);
+  for (size_t i = 3; i < image.pixels.size(); i += 4) {
+    image.pixels[i] = 0xA0;
+  }
+  overlay.Upload(image);
+  ASSERT_TRUE(overlay.visible());
+
+  context_.BindDrawTarget();
+  glViewport(0, 0, kTargetWidth, kTargetHeight);
+  glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glBindVertexArray(vertex_array_);
+  overlay.Draw(kTargetWidth, kTargetHeight);
+  context_.SwapBuffers();
+
+  // 读回坐标原点在左下角；浮层在距左上角 8 像素处
+  auto read = [](int x, int y_from_top) {
+    uint8_t pixel[4] = {};
+    glReadPixels(x, kTargetHeight - 1 - y_from_top, 1, 1, GL_RGBA,
+                 GL_UNSIGNED_BYTE, pixel);
+    return Rgb{pixel[0], pixel[1], pixel[2]};
+  };
+  ExpectColor(read(10, 10), {95, 95, 95});
+  ExpectColor(read(2, 2), {255, 255, 255});
+  ExpectColor(read(30, 10), {255, 255, 255});
+  EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+  overlay.Cleanup();
+}
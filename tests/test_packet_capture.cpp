@@ -0,0 +1,414 @@
+/**
+ * @file test_packet_capture.cpp
+ * @brief 单元测试 - 数据包抓取与回放
+ *
+ * 测试目标：
+ * - 流参数、数据包内容 / 时间戳 / 标志、EOF 和错误记录完整往返
+ * - 回放按原始到达时间间隔返回数据包
+ * - Seek 定位到最近的视频关键帧
+ * - Interrupt() 立即唤醒等待中的读取
+ * - 抓取期间的暂停不重现为卡顿；抓取期间的 Seek 通知调用方并从记录
+ *   之后继续读取
+ * - 负载大小或流索引损坏的记录返回 kInvalidFormat
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+#include "player/demuxer/packet_capture.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/channel_layout.h>
+}
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kVideoStream = 0;
+constexpr int kAudioStream = 1;
+
+/**
+ * @brief 写入抓取文件的测试夹具（一路 H.264 视频 + 一路 AAC 音频）
+ */
+class PacketCaptureTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = (std::filesystem::temp_directory_path() /
+             ("zenplay_capture_test_" +
+              std::to_string(reinterpret_cast<uintptr_t>(this)) + ".zpcap"))
+                .string();
+
+    source_context_ = avformat_alloc_context();
+    AVStream* video = avformat_new_stream(source_context_, nullptr);
+    video->time_base = {1, 90000};
+    video->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+    video->codecpar->codec_id = AV_CODEC_ID_H264;
+    video->codecpar->width = 1280;
+    video->codecpar->height = 720;
+    video->codecpar->format = AV_PIX_FMT_YUV420P;
+    const uint8_t extradata[] = {0x01, 0x64, 0x00, 0x1f};
+    video->codecpar->extradata = static_cast<uint8_t*>(
+        av_mallocz(sizeof(extradata) + AV_INPUT_BUFFER_PADDING_SIZE));
+    std::memcpy(video->codecpar->extradata, extradata, sizeof(extradata));
+    video->codecpar->extradata_size = sizeof(extradata);
+
+    AVStream* audio = avformat_new_stream(source_context_, nullptr);
+    audio->time_base = {1, 48000};
+    audio->codecpar->codec_type = AVMEDIA_TYPE_AUDIO;
+    audio->codecpar->codec_id = AV_CODEC_ID_AAC;
+    audio->codecpar->sample_rate = 48000;
+    av_channel_layout_default(&audio->codecpar->ch_layout, 2);
+  }
+
+  void TearDown() override {
+    avformat_free_context(source_context_);
+    avformat_free_context(replay_context_);
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+  }
+
+  void OpenWriter(PacketCaptureWriter& writer) {
+    std::vector<const AVStream*> streams = {source_context_->streams[0],
+                                            source_context_->streams[1]};
+    ASSERT_TRUE(writer.Open(path_, streams, 10 * AV_TIME_BASE, kVideoStream,
+                            kAudioStream)
+                    .IsOk());
+  }
+
+  static void WritePacket(PacketCaptureWriter& writer,
+                          int stream_index,
+                          int64_t pts,
+                          bool key,
+                          int64_t arrival_ms,
+                          uint8_t fill = 0xAB) {
+    AVPacket* packet = av_packet_alloc();
+    ASSERT_EQ(av_new_packet(packet, 16), 0);
+    std::memset(packet->data, fill, packet->size);
+    packet->stream_index = stream_index;
+    packet->pts = pts;
+    packet->dts = pts;
+    packet->duration = 3000;
+    packet->flags = key ? AV_PKT_FLAG_KEY : 0;
+    ASSERT_TRUE(writer.WritePacket(packet, arrival_ms * 1000).IsOk());
+    av_packet_free(&packet);
+  }
+
+  void OpenReplay(PacketReplaySource& replay, bool honor_timing) {
+    PacketReplaySource::Options options;
+    options.honor_arrival_timing = honor_timing;
+    ASSERT_TRUE(replay.Open(path_, &replay_context_, options).IsOk());
+  }
+
+  std::string path_;
+  AVFormatContext* source_context_ = nullptr;
+  AVFormatContext* replay_context_ = nullptr;
+};
+
+}  // namespace
+
+TEST_F(PacketCaptureTest, RoundTripPreservesStreamsAndPackets) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    WritePacket(writer, kVideoStream, 0, true, 0, 0x11);
+    WritePacket(writer, kAudioStream, 1024, false, 5, 0x22);
+    ASSERT_TRUE(writer.WriteError(ErrorCode::kNetworkError).IsOk());
+    ASSERT_TRUE(writer.WriteEndOfStream().IsOk());
+    EXPECT_EQ(writer.packet_count(), 2u);
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, false);
+
+  ASSERT_EQ(replay_context_->nb_streams, 2u);
+  EXPECT_EQ(replay_context_->duration, 10 * AV_TIME_BASE);
+  EXPECT_EQ(replay.active_video_stream(), kVideoStream);
+  EXPECT_EQ(replay.active_audio_stream(), kAudioStream);
+
+  const AVStream* video = replay_context_->streams[kVideoStream];
+  EXPECT_EQ(video->codecpar->codec_id, AV_CODEC_ID_H264);
+  EXPECT_EQ(video->codecpar->width, 1280);
+  EXPECT_EQ(video->codecpar->height, 720);
+  EXPECT_EQ(video->time_base.den, 90000);
+  ASSERT_EQ(video->codecpar->extradata_size, 4);
+  EXPECT_EQ(video->codecpar->extradata[1], 0x64);
+
+  const AVStream* audio = replay_context_->streams[kAudioStream];
+  EXPECT_EQ(audio->codecpar->sample_rate, 48000);
+  EXPECT_EQ(audio->codecpar->ch_layout.nb_channels, 2);
+
+  auto first = replay.ReadPacket();
+  ASSERT_TRUE(first.IsOk());
+  AVPacket* packet = first.Value();
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->stream_index, kVideoStream);
+  EXPECT_EQ(packet->pts, 0);
+  EXPECT_EQ(packet->duration, 3000);
+  EXPECT_TRUE(packet->flags & AV_PKT_FLAG_KEY);
+  ASSERT_EQ(packet->size, 16);
+  EXPECT_EQ(packet->data[15], 0x11);
+  av_packet_free(&packet);
+
+  auto second = replay.ReadPacket();
+  ASSERT_TRUE(second.IsOk());
+  packet = second.Value();
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->stream_index, kAudioStream);
+  EXPECT_EQ(packet->pts, 1024);
+  EXPECT_EQ(packet->data[0], 0x22);
+  av_packet_free(&packet);
+
+  auto error = replay.ReadPacket();
+  ASSERT_FALSE(error.IsOk());
+  EXPECT_EQ(error.Code(), ErrorCode::kNetworkError);
+
+  auto eof = replay.ReadPacket();
+  ASSERT_TRUE(eof.IsOk());
+  EXPECT_EQ(eof.Value(), nullptr);
+}
+
+TEST_F(PacketCaptureTest, ReplayReproducesArrivalGaps) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    WritePacket(writer, kVideoStream, 0, true, 0);
+    WritePacket(writer, kVideoStream, 3000, false, 10);
+    WritePacket(writer, kVideoStream, 6000, false, 130);  // 120ms 卡顿
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, true);
+
+  std::vector<double> arrivals_ms;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 3; ++i) {
+    auto result = replay.ReadPacket();
+    ASSERT_TRUE(result.IsOk());
+    AVPacket* packet = result.Value();
+    ASSERT_NE(packet, nullptr);
+    av_packet_free(&packet);
+    arrivals_ms.push_back(std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+  }
+
+  EXPECT_LT(arrivals_ms[0], 5.0);
+  EXPECT_GE(arrivals_ms[1], 9.0);
+  EXPECT_GE(arrivals_ms[2] - arrivals_ms[1], 115.0);
+  EXPECT_LT(arrivals_ms[2], 200.0);
+}
+
+TEST_F(PacketCaptureTest, SeekLandsOnVideoKeyframe) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    // 每 2 秒一个关键帧（90kHz 时间基）
+    for (int i = 0; i < 6; ++i) {
+      WritePacket(writer, kVideoStream, i * 90000, i % 2 == 0, i * 10);
+      WritePacket(writer, kAudioStream, i * 48000, true, i * 10 + 5);
+    }
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, false);
+
+  auto read_pts = [&replay]() {
+    auto result = replay.ReadPacket();
+    AVPacket* packet = result.IsOk() ? result.Value() : nullptr;
+    int64_t pts = packet ? packet->pts : AV_NOPTS_VALUE;
+    av_packet_free(&packet);
+    return pts;
+  };
+
+  ASSERT_TRUE(replay.Seek(3 * AV_TIME_BASE, true));
+  EXPECT_EQ(read_pts(), 2 * 90000);
+
+  ASSERT_TRUE(replay.Seek(3 * AV_TIME_BASE, false));
+  EXPECT_EQ(read_pts(), 4 * 90000);
+
+  // 超出范围：向前找不到时取最后一个关键帧
+  ASSERT_TRUE(replay.Seek(60 * AV_TIME_BASE, false));
+  EXPECT_EQ(read_pts(), 4 * 90000);
+}
+
+TEST_F(PacketCaptureTest, InterruptWakesPendingRead) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    WritePacket(writer, kVideoStream, 0, true, 0);
+    WritePacket(writer, kVideoStream, 3000, false, 10000);  // 10 秒后到达
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, true);
+
+  auto first = replay.ReadPacket();
+  ASSERT_TRUE(first.IsOk());
+  AVPacket* packet = first.Value();
+  av_packet_free(&packet);
+
+  std::thread interrupter([&replay]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    replay.Interrupt();
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  auto second = replay.ReadPacket();
+  auto waited = std::chrono::steady_clock::now() - start;
+  interrupter.join();
+
+  ASSERT_TRUE(second.IsOk());
+  packet = second.Value();
+  EXPECT_NE(packet, nullptr);
+  av_packet_free(&packet);
+  EXPECT_LT(waited, std::chrono::seconds(2));
+}
+
+TEST_F(PacketCaptureTest, PauseIsNotReplayedAsStall) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    WritePacket(writer, kVideoStream, 0, true, 0);
+    WritePacket(writer, kVideoStream, 3000, false, 10);
+    // 暂停 5 秒后恢复，恢复后 20ms 到达下一个包
+    ASSERT_TRUE(writer.WritePause(15 * 1000).IsOk());
+    ASSERT_TRUE(writer.WriteResume(5015 * 1000).IsOk());
+    WritePacket(writer, kVideoStream, 6000, false, 5035);
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, true);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 3; ++i) {
+    auto result = replay.ReadPacket();
+    ASSERT_TRUE(result.IsOk());
+    AVPacket* packet = result.Value();
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet->pts, i * 3000);
+    av_packet_free(&packet);
+  }
+  auto elapsed_ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+  // 只重现暂停前后的间隔（10ms + 5ms + 20ms）
+  EXPECT_GE(elapsed_ms, 30.0);
+  EXPECT_LT(elapsed_ms, 1000.0);
+}
+
+TEST_F(PacketCaptureTest, RecordedSeekIsReplayed) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    // 0 秒和 2 秒各一个关键帧；读到 1 秒处 Seek 到 4 秒
+    WritePacket(writer, kVideoStream, 0, true, 0);
+    WritePacket(writer, kVideoStream, 90000, false, 10);
+    ASSERT_TRUE(writer.WriteSeek(4 * AV_TIME_BASE, true, 20 * 1000).IsOk());
+    WritePacket(writer, kVideoStream, 4 * 90000, true, 30);
+    WritePacket(writer, kVideoStream, 5 * 90000, false, 40);
+  }
+
+  PacketReplaySource replay;
+  OpenReplay(replay, false);
+
+  auto read_pts = [&replay]() {
+    auto result = replay.ReadPacket();
+    AVPacket* packet = result.IsOk() ? result.Value() : nullptr;
+    int64_t pts = packet ? packet->pts : AV_NOPTS_VALUE;
+    av_packet_free(&packet);
+    return pts;
+  };
+
+  EXPECT_EQ(read_pts(), 0);
+  EXPECT_EQ(read_pts(), 90000);
+
+  int64_t seek_us = 0;
+  bool backward = false;
+  EXPECT_FALSE(replay.TakeRecordedSeek(&seek_us, &backward));
+
+  auto seek_record = replay.ReadPacket();
+  ASSERT_FALSE(seek_record.IsOk());
+  EXPECT_EQ(seek_record.Code(), ErrorCode::kCancelled);
+  ASSERT_TRUE(replay.TakeRecordedSeek(&seek_us, &backward));
+  EXPECT_EQ(seek_us, 4 * AV_TIME_BASE);
+  EXPECT_TRUE(backward);
+  EXPECT_FALSE(replay.TakeRecordedSeek(&seek_us, &backward));
+
+  // 调用方 Seek 前可能已经读走了 Seek 之后的包，Seek 后重新读取
+  EXPECT_EQ(read_pts(), 4 * 90000);
+
+  // 调用方以毫秒发起 Seek，目标在容差内仍从 Seek 记录之后继续
+  ASSERT_TRUE(replay.Seek(4 * AV_TIME_BASE + 500, true));
+  EXPECT_EQ(read_pts(), 4 * 90000);
+  EXPECT_EQ(read_pts(), 5 * 90000);
+
+  // 已经执行过的 Seek 不再匹配，之后的 Seek 走关键帧索引
+  ASSERT_TRUE(replay.Seek(4 * AV_TIME_BASE, true));
+  EXPECT_EQ(read_pts(), 4 * 90000);
+}
+
+TEST_F(PacketCaptureTest, CorruptRecordIsRejected) {
+  {
+    PacketCaptureWriter writer;
+    OpenWriter(writer);
+    WritePacket(writer, kVideoStream, 0, true, 0);
+    WritePacket(writer, kVideoStream, 3000, false, 10);
+    WritePacket(writer, kVideoStream, 6000, false, 20);
+  }
+
+  // 第二条记录的负载大小改为负数，第三条的流索引改为不存在的流
+  auto corrupt = [this](int record, size_t field_offset, int32_t value) {
+    std::FILE* file = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    size_t stream_table =
+        sizeof(capture::FileHeader) + 2 * sizeof(capture::StreamRecord) + 4;
+    size_t record_size = sizeof(capture::RecordHeader) + 16;
+    std::fseek(file,
+               static_cast<long>(stream_table + record * record_size +
+                                 field_offset),
+               SEEK_SET);
+    std::fwrite(&value, sizeof(value), 1, file);
+    std::fclose(file);
+  };
+  corrupt(1, offsetof(capture::RecordHeader, value), -1);
+  corrupt(2, offsetof(capture::RecordHeader, stream_index), 7);
+
+  PacketReplaySource replay;
+  OpenReplay(replay, false);
+
+  auto first = replay.ReadPacket();
+  ASSERT_TRUE(first.IsOk());
+  AVPacket* packet = first.Value();
+  EXPECT_NE(packet, nullptr);
+  av_packet_free(&packet);
+
+  auto second = replay.ReadPacket();
+  ASSERT_FALSE(second.IsOk());
+  EXPECT_EQ(second.Code(), ErrorCode::kInvalidFormat);
+
+  // 跳过损坏的负载大小后，流索引越界同样拒绝
+  corrupt(1, offsetof(capture::RecordHeader, value), 16);
+  replay.Close();
+  avformat_free_context(replay_context_);
+  replay_context_ = nullptr;
+  PacketReplaySource reopened;
+  OpenReplay(reopened, false);
+  first = reopened.ReadPacket();
+  packet = first.IsOk() ? first.Value() : nullptr;
+  av_packet_free(&packet);
+  second = reopened.ReadPacket();
+  packet = second.IsOk() ? second.Value() : nullptr;
+  av_packet_free(&packet);
+  auto third = reopened.ReadPacket();
+  ASSERT_FALSE(third.IsOk());
+  EXPECT_EQ(third.Code(), ErrorCode::kInvalidFormat);
+}
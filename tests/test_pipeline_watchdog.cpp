@@ -0,0 +1,151 @@
+/**
+ * @file test_pipeline_watchdog.cpp
+ * @brief 单元测试 - 流水线卡死检测
+ *
+ * 测试目标：
+ * - 有待处理输入且超过阈值无进度的阶段判定为卡死
+ * - 输入队列为空（饥饿）、已结束、主动空闲的阶段不算卡死
+ * - 非播放状态不检查，回到播放后重新计时
+ * - 同一次卡死只报告一次，恢复后再次卡死重新报告
+ */
+
+#include <gtest/gtest.h>
+
+#include "player/common/pipeline_watchdog.h"
+
+using namespace zenplay;
+using Stage = PipelineWatchdog::Stage;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+PipelineWatchdog::Options TestOptions() {
+  PipelineWatchdog::Options options;
+  options.stall_threshold_ms = 1000;
+  return options;
+}
+
+PipelineWatchdog::PipelineContext Playing(int64_t video_packets,
+                                          int64_t video_frames) {
+  PipelineWatchdog::PipelineContext context;
+  context.playing = true;
+  context.state = "Playing";
+  context.input_depths[static_cast<size_t>(Stage::kVideoDecode)] =
+      video_packets;
+  context.input_depths[static_cast<size_t>(Stage::kVideoRender)] =
+      video_frames;
+  return context;
+}
+
+const PipelineWatchdog::StageSnapshot& StageOf(
+    const PipelineWatchdog::Snapshot& snapshot,
+    Stage stage) {
+  return snapshot.stages[static_cast<size_t>(stage)];
+}
+
+// 第一次检查只开始计时（从非播放进入播放）
+void Arm(PipelineWatchdog* watchdog) {
+  EXPECT_FALSE(watchdog->Check(Playing(0, 0), Clock::now()).has_value());
+}
+
+}  // namespace
+
+TEST(PipelineWatchdogTest, DetectsStageWithPendingInput) {
+  PipelineWatchdog watchdog(TestOptions());
+  watchdog.EnableStage(Stage::kDemux);
+  watchdog.EnableStage(Stage::kVideoDecode);
+  watchdog.EnableStage(Stage::kVideoRender);
+  Arm(&watchdog);
+
+  watchdog.Heartbeat(Stage::kVideoRender, 1234);
+  auto now = Clock::now();
+  // 阈值内：正常
+  EXPECT_FALSE(watchdog.Check(Playing(0, 5), now).has_value());
+
+  // 渲染有 5 帧待处理却 2 秒无进度；解码输入为空只是饥饿
+  watchdog.Heartbeat(Stage::kDemux, 5000);
+  auto snapshot =
+      watchdog.Check(Playing(0, 5), now + std::chrono::milliseconds(2000));
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_TRUE(StageOf(*snapshot, Stage::kVideoRender).stalled);
+  EXPECT_EQ(StageOf(*snapshot, Stage::kVideoRender).last_pts_ms, 1234);
+  EXPECT_EQ(StageOf(*snapshot, Stage::kVideoRender).input_depth, 5);
+  EXPECT_FALSE(StageOf(*snapshot, Stage::kVideoDecode).stalled);
+  EXPECT_FALSE(StageOf(*snapshot, Stage::kAudioOutput).enabled);
+  EXPECT_EQ(snapshot->stalled_mask(),
+            1u << static_cast<size_t>(Stage::kVideoRender) |
+                1u << static_cast<size_t>(Stage::kDemux));
+
+  std::string text = snapshot->ToString();
+  EXPECT_NE(text.find("VideoRender: STALLED"), std::string::npos);
+  EXPECT_EQ(text.find("AudioOutput"), std::string::npos);
+}
+
+TEST(PipelineWatchdogTest, SkipsFinishedAndIdleStages) {
+  PipelineWatchdog watchdog(TestOptions());
+  watchdog.EnableStage(Stage::kDemux);
+  watchdog.EnableStage(Stage::kVideoDecode);
+  Arm(&watchdog);
+
+  auto later = Clock::now() + std::chrono::milliseconds(5000);
+
+  // 解封装等待缓存回放（空闲），解码已到 EOF（结束）
+  watchdog.SetIdle(Stage::kDemux, true);
+  watchdog.MarkFinished(Stage::kVideoDecode);
+  EXPECT_FALSE(watchdog.Check(Playing(3, 0), later).has_value());
+
+  // Seek 后重新计时并清除结束标记
+  watchdog.Rearm();
+  watchdog.SetIdle(Stage::kDemux, false);
+  auto snapshot = watchdog.Check(
+      Playing(3, 0), Clock::now() + std::chrono::milliseconds(5000));
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_TRUE(StageOf(*snapshot, Stage::kDemux).stalled);
+  EXPECT_TRUE(StageOf(*snapshot, Stage::kVideoDecode).stalled);
+}
+
+TEST(PipelineWatchdogTest, ReportsOncePerStallAndRestartsAfterPause) {
+  PipelineWatchdog watchdog(TestOptions());
+  watchdog.EnableStage(Stage::kVideoRender);
+  Arm(&watchdog);
+
+  auto base = Clock::now();
+  auto late = base + std::chrono::milliseconds(2000);
+  EXPECT_TRUE(watchdog.Check(Playing(0, 8), late).has_value());
+  // 仍然卡住：不重复报告
+  EXPECT_FALSE(
+      watchdog.Check(Playing(0, 8), late + std::chrono::milliseconds(500))
+          .has_value());
+
+  // 暂停期间不检查；恢复播放后重新计时
+  PipelineWatchdog::PipelineContext paused;
+  paused.state = "Paused";
+  EXPECT_FALSE(watchdog.Check(paused, late).has_value());
+  auto resumed = late + std::chrono::milliseconds(10000);
+  EXPECT_FALSE(watchdog.Check(Playing(0, 8), resumed).has_value());
+  EXPECT_FALSE(
+      watchdog.Check(Playing(0, 8), resumed + std::chrono::milliseconds(500))
+          .has_value());
+  EXPECT_TRUE(
+      watchdog.Check(Playing(0, 8), resumed + std::chrono::milliseconds(1500))
+          .has_value());
+}
+
+TEST(PipelineWatchdogTest, SuspendRestartsTimingOnResume) {
+  PipelineWatchdog watchdog(TestOptions());
+  watchdog.EnableStage(Stage::kVideoRender);
+  // 定时检查看到的是非播放状态，不影响下面手动注入时间的检查
+  watchdog.Start([]() { return PipelineWatchdog::PipelineContext(); },
+                 [](const PipelineWatchdog::Snapshot&) {});
+  Arm(&watchdog);
+
+  // 暂停期间定时检查停止；之后第一次检查只重新计时，不把暂停算作卡死
+  watchdog.Suspend();
+  auto resumed = Clock::now() + std::chrono::milliseconds(10000);
+  EXPECT_FALSE(watchdog.Check(Playing(0, 8), resumed).has_value());
+  EXPECT_TRUE(
+      watchdog.Check(Playing(0, 8), resumed + std::chrono::milliseconds(1500))
+          .has_value());
+  watchdog.Resume();
+  watchdog.Stop();
+}
@@ -0,0 +1,270 @@
+/**
+ * @file test_pixel_convert.cpp
+ * @brief 单元测试 - SIMD 像素格式快速转换
+ *
+ * 测试目标：
+ * - 10 位 → 8 位抖动结果正确（含饱和）
+ * - 4:2:2 / 4:4:4 → 4:2:0 色度平均正确
+ * - AVX2 / SSE2 / 自动选择的实现与标量实现逐位一致（随机尺寸，覆盖尾部
+ *   处理）
+ * - ⏱️ 与 swscale 的性能对比（DISABLED，手动运行）
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "player/video/render/pixel_convert.h"
+
+extern "C" {
+#include <libswscale/swscale.h>
+}
+
+using namespace zenplay;
+
+namespace {
+
+/**
+ * @brief 测试用的三平面图像缓冲
+ */
+struct TestImage {
+  // 与 AVFrame 一致保留 4 个平面槽位（swscale 会读取第 4 个）
+  std::vector<uint8_t> planes[3];
+  int stride[4] = {};
+  uint8_t* data[4] = {};
+
+  TestImage(int stride_bytes, int rows) {
+    for (int p = 0; p < 3; ++p) {
+      stride[p] = stride_bytes;
+      planes[p].assign(static_cast<size_t>(stride_bytes) * rows, 0);
+      data[p] = planes[p].data();
+    }
+  }
+
+  void FillRandom(std::mt19937& rng) {
+    for (auto& plane : planes) {
+      for (auto& byte : plane) {
+        byte = static_cast<uint8_t>(rng());
+      }
+    }
+  }
+
+  void Fill16(int plane, uint16_t value) {
+    auto* words = reinterpret_cast<uint16_t*>(planes[plane].data());
+    std::fill(words, words + planes[plane].size() / 2, value);
+  }
+};
+
+bool Convert(PixelConversion conversion,
+             const TestImage& src,
+             TestImage& dst,
+             int width,
+             int height,
+             PixelConvertPath path = PixelConvertPath::kAuto) {
+  const uint8_t* src_data[3] = {src.data[0], src.data[1], src.data[2]};
+  return ConvertPixels(conversion, src_data, src.stride, dst.data, dst.stride,
+                       width, height, path);
+}
+
+}  // namespace
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+TEST(PixelConvertTest, NoneConversionReturnsFalse) {
+  TestImage src(64, 4);
+  TestImage dst(64, 4);
+  EXPECT_FALSE(Convert(PixelConversion::kNone, src, dst, 16, 4));
+}
+
+TEST(PixelConvertTest, TenBitToEightBitDither) {
+  const int width = 16;
+  const int height = 2;
+  TestImage src(width * 2, height);
+  TestImage dst(width, height);
+
+  // 10 位 512 -> 8 位 128，抖动量 0~3 不会跨越量化台阶
+  for (int p = 0; p < 3; ++p) {
+    src.Fill16(p, 512);
+  }
+  ASSERT_TRUE(
+      Convert(PixelConversion::kYuv420p10ToYuv420p, src, dst, width, height));
+  for (int x = 0; x < width; ++x) {
+    EXPECT_EQ(dst.data[0][x], 128);
+  }
+
+  // 10 位 1023 加抖动后超过 255，必须饱和而不是回绕
+  src.Fill16(0, 1023);
+  ASSERT_TRUE(
+      Convert(PixelConversion::kYuv420p10ToYuv420p, src, dst, width, height));
+  for (int x = 0; x < width; ++x) {
+    EXPECT_EQ(dst.data[0][x], 255);
+    EXPECT_EQ(dst.data[0][dst.stride[0] + x], 255);
+  }
+
+  // 10 位 514 = 8 位 128.5，抖动后两种取值各占一半
+  src.Fill16(0, 514);
+  ASSERT_TRUE(
+      Convert(PixelConversion::kYuv420p10ToYuv420p, src, dst, width, height));
+  int sum = 0;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t value = dst.data[0][y * dst.stride[0] + x];
+      EXPECT_TRUE(value == 128 || value == 129);
+      sum += value;
+    }
+  }
+  EXPECT_EQ(sum, 128 * width * height + width * height / 2);
+}
+
+TEST(PixelConvertTest, P010UsesHighBits) {
+  const int width = 8;
+  const int height = 2;
+  TestImage src(width * 2, height);
+  TestImage dst(width, height);
+
+  // P010 中 10 位值 512 存为 512 << 6
+  src.Fill16(0, 512 << 6);
+  src.Fill16(1, 256 << 6);
+  ASSERT_TRUE(Convert(PixelConversion::kP010ToNv12, src, dst, width, height));
+  EXPECT_EQ(dst.data[0][0], 128);
+  EXPECT_EQ(dst.data[1][0], 64);
+}
+
+TEST(PixelConvertTest, ChromaDownsample) {
+  const int width = 4;
+  const int height = 2;
+  TestImage src(width, height);
+  TestImage dst(width, height);
+
+  // 4:2:2：色度宽 2，两行分别为 10 和 21，平均后四舍五入为 16
+  std::memset(src.data[1], 10, src.stride[1]);
+  std::memset(src.data[1] + src.stride[1], 21, src.stride[1]);
+  ASSERT_TRUE(
+      Convert(PixelConversion::kYuv422pToYuv420p, src, dst, width, height));
+  EXPECT_EQ(dst.data[1][0], 16);
+  EXPECT_EQ(dst.data[1][1], 16);
+
+  // 4:4:4：2x2 块 {0, 100; 200, 40} -> 纵向 (100, 70) -> 横向 85
+  uint8_t* row0 = src.data[2];
+  uint8_t* row1 = src.data[2] + src.stride[2];
+  row0[0] = 0;
+  row0[1] = 100;
+  row1[0] = 200;
+  row1[1] = 40;
+  ASSERT_TRUE(
+      Convert(PixelConversion::kYuv444pToYuv420p, src, dst, width, height));
+  EXPECT_EQ(dst.data[2][0], 85);
+}
+
+TEST(PixelConvertTest, SimdMatchesScalar) {
+  const PixelConversion conversions[] = {
+      PixelConversion::kYuv420p10ToYuv420p,
+      PixelConversion::kYuv422pToYuv420p,
+      PixelConversion::kYuv422p10ToYuv420p,
+      PixelConversion::kYuv444pToYuv420p,
+      PixelConversion::kP010ToNv12,
+  };
+  const PixelConvertPath paths[] = {PixelConvertPath::kAuto,
+                                    PixelConvertPath::kSse2,
+                                    PixelConvertPath::kAvx2};
+
+  std::mt19937 rng(42);
+  for (int trial = 0; trial < 100; ++trial) {
+    int width = 1 + static_cast<int>(rng() % 300);
+    int height = 1 + static_cast<int>(rng() % 20);
+    PixelConversion conversion = conversions[trial % 5];
+
+    TestImage src(width * 2 + 32, height);
+    src.FillRandom(rng);
+    TestImage scalar(width + 32, height);
+    ASSERT_TRUE(Convert(conversion, src, scalar, width, height,
+                        PixelConvertPath::kScalar));
+
+    for (PixelConvertPath path : paths) {
+      if (!IsPixelConvertPathSupported(path)) {
+        continue;
+      }
+      TestImage simd(width + 32, height);
+      ASSERT_TRUE(Convert(conversion, src, simd, width, height, path));
+      for (int p = 0; p < 3; ++p) {
+        ASSERT_EQ(simd.planes[p], scalar.planes[p])
+            << "path=" << static_cast<int>(path)
+            << " conversion=" << static_cast<int>(conversion)
+            << " size=" << width << "x" << height << " plane=" << p;
+      }
+    }
+  }
+}
+
+// ============================================================================
+// 性能基准测试（默认禁用）
+// ============================================================================
+
+TEST(PixelConvertTest, DISABLED_BenchmarkVsSwscale) {
+  const int width = 1920;
+  const int height = 1080;
+  const int iterations = 200;
+
+  struct Case {
+    const char* name;
+    PixelConversion conversion;
+    AVPixelFormat src_format;
+    AVPixelFormat dst_format;
+  };
+  const Case cases[] = {
+      {"yuv420p10->yuv420p", PixelConversion::kYuv420p10ToYuv420p,
+       AV_PIX_FMT_YUV420P10LE, AV_PIX_FMT_YUV420P},
+      {"yuv422p->yuv420p", PixelConversion::kYuv422pToYuv420p,
+       AV_PIX_FMT_YUV422P, AV_PIX_FMT_YUV420P},
+      {"yuv422p10->yuv420p", PixelConversion::kYuv422p10ToYuv420p,
+       AV_PIX_FMT_YUV422P10LE, AV_PIX_FMT_YUV420P},
+      {"yuv444p->yuv420p", PixelConversion::kYuv444pToYuv420p,
+       AV_PIX_FMT_YUV444P, AV_PIX_FMT_YUV420P},
+      {"p010->nv12", PixelConversion::kP010ToNv12, AV_PIX_FMT_P010LE,
+       AV_PIX_FMT_NV12},
+  };
+
+  std::mt19937 rng(7);
+  TestImage src(width * 2, height);
+  src.FillRandom(rng);
+  TestImage dst(width, height);
+
+  auto measure_ms = [&](auto&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() /
+           iterations;
+  };
+
+  for (const auto& c : cases) {
+    SwsContext* sws =
+        sws_getContext(width, height, c.src_format, width, height,
+                       c.dst_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
+    ASSERT_NE(sws, nullptr);
+
+    const uint8_t* src_data[4] = {src.data[0], src.data[1], src.data[2],
+                                  nullptr};
+    double sws_ms = measure_ms([&]() {
+      sws_scale(sws, src_data, src.stride, 0, height, dst.data, dst.stride);
+    });
+    double scalar_ms = measure_ms([&]() {
+      Convert(c.conversion, src, dst, width, height, PixelConvertPath::kScalar);
+    });
+    double simd_ms = measure_ms(
+        [&]() { Convert(c.conversion, src, dst, width, height); });
+    sws_freeContext(sws);
+
+    std::cout << c.name << ": swscale=" << sws_ms << "ms, scalar=" << scalar_ms
+              << "ms, " << GetPixelConvertImplName() << "=" << simd_ms
+              << "ms (x" << (sws_ms / simd_ms) << " vs swscale)" << std::endl;
+  }
+}
@@ -219,3 +219,59 @@ TEST(PlayerStateManagerTest, WaitForResumePredicateCorrect) {
   result = state_manager.WaitForResume(100);
   EXPECT_TRUE(result) << "Should return true immediately when Error";
 }
+
+TEST(PlayerStateManagerTest, InterruptibleWaitForResumeWakesOnWakeWaiters) {
+  PlayerStateManager state_manager;
+  state_manager.TransitionToOpening();
+  state_manager.TransitionToStopped();
+  state_manager.TransitionToPlaying();
+  state_manager.TransitionToPaused();
+
+  // 调用方自己的停止标志（如 A-B 循环线程），改变后由 WakeWaiters() 唤醒
+  std::atomic<bool> task_stop{false};
+  std::atomic<bool> result{true};
+  auto start_time = std::chrono::steady_clock::now();
+
+  std::thread waiter([&]() {
+    result.store(state_manager.WaitForResume(
+        [&task_stop]() { return task_stop.load(); }));
+  });
+
+  std::this_thread::sleep_for(50ms);
+  task_stop.store(true);
+  state_manager.WakeWaiters();
+  waiter.join();
+
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start_time)
+                      .count();
+  EXPECT_FALSE(result.load()) << "Interrupted wait should report not resumed";
+  EXPECT_LT(duration, 1000);
+  EXPECT_EQ(state_manager.GetState(), PlayerStateManager::PlayerState::kPaused);
+}
+
+TEST(PlayerStateManagerTest, WaitWhilePlayingReturnsOnPause) {
+  PlayerStateManager state_manager;
+  state_manager.TransitionToOpening();
+  state_manager.TransitionToStopped();
+  state_manager.TransitionToPlaying();
+
+  // 播放中等满超时
+  EXPECT_TRUE(state_manager.WaitWhilePlaying(20));
+
+  std::atomic<bool> result{true};
+  auto start_time = std::chrono::steady_clock::now();
+  std::thread waiter(
+      [&]() { result.store(state_manager.WaitWhilePlaying(5000)); });
+
+  std::this_thread::sleep_for(50ms);
+  state_manager.TransitionToPaused();
+  waiter.join();
+
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start_time)
+                      .count();
+  EXPECT_FALSE(result.load());
+  EXPECT_LT(duration, 1000) << "Pause should end the wait, took " << duration
+                            << "ms";
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_raw_video_source.cpp
+ * @brief 单元测试 - 内存映射的未压缩视频源
+ *
+ * 测试目标：
+ * - Y4M 文件头（尺寸、帧率、色度格式）和带参数的 FRAME 头解析正确
+ * - 帧平面直接指向映射区域，源关闭后帧仍然有效
+ * - 裸 YUV 按配置的帧格式切分，Seek 精确到帧
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "player/demuxer/raw_video_source.h"
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kWidth = 16;
+constexpr int kHeight = 8;
+constexpr size_t kFrameSize = kWidth * kHeight * 3 / 2;  // yuv420p
+
+class RawVideoSourceTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    if (format_context_) {
+      avformat_free_context(format_context_);
+    }
+    for (const auto& path : paths_) {
+      std::filesystem::remove(path);
+    }
+  }
+
+  /**
+   * @brief 写入临时文件；每帧填充为帧序号
+   * @param header Y4M 文件头（裸 YUV 传空）
+   * @param frame_header 返回第 i 帧的 FRAME 头（裸 YUV 返回空）
+   */
+  template <typename FrameHeader>
+  std::string WriteFile(const std::string& extension,
+                        const std::string& header,
+                        int frame_count,
+                        FrameHeader frame_header) {
+    std::string path =
+        (std::filesystem::temp_directory_path() /
+         ("zenplay_raw_video_test_" +
+          std::to_string(reinterpret_cast<uintptr_t>(this)) + extension))
+            .string();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fwrite(header.data(), 1, header.size(), file);
+    std::string frame(kFrameSize, '\0');
+    for (int i = 0; i < frame_count; ++i) {
+      std::string tag = frame_header(i);
+      std::fwrite(tag.data(), 1, tag.size(), file);
+      frame.assign(kFrameSize, static_cast<char>(i));
+      std::fwrite(frame.data(), 1, frame.size(), file);
+    }
+    std::fclose(file);
+    paths_.push_back(path);
+    return path;
+  }
+
+  AVFormatContext* format_context_ = nullptr;
+  std::vector<std::string> paths_;
+};
+
+}  // namespace
+
+TEST_F(RawVideoSourceTest, ParsesY4mAndMapsFramesWithoutCopy) {
+  std::string path = WriteFile(
+      ".y4m", "YUV4MPEG2 W16 H8 F30000:1001 Ip A1:1 C420jpeg\n", 3,
+      [](int i) { return i == 1 ? std::string("FRAME Ixyz\n") : "FRAME\n"; });
+
+  AVFramePtr first;
+  {
+    RawVideoSource source;
+    auto result = source.Open(path, &format_context_, {});
+    ASSERT_TRUE(result.IsOk()) << result.Message();
+    EXPECT_EQ(source.width(), kWidth);
+    EXPECT_EQ(source.height(), kHeight);
+    EXPECT_EQ(source.pixel_format(), AV_PIX_FMT_YUV420P);
+    EXPECT_EQ(source.frame_count(), 3u);
+
+    ASSERT_EQ(format_context_->nb_streams, 1u);
+    AVStream* stream = format_context_->streams[0];
+    EXPECT_EQ(stream->codecpar->codec_id, AV_CODEC_ID_RAWVIDEO);
+    EXPECT_EQ(stream->avg_frame_rate.num, 30000);
+    EXPECT_EQ(stream->avg_frame_rate.den, 1001);
+    EXPECT_EQ(format_context_->duration, 100100);  // 3 帧 @ 29.97fps
+
+    auto frame_result = source.ReadFrame();
+    ASSERT_TRUE(frame_result.IsOk());
+    first = std::move(frame_result.Value());
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->pts, 0);
+    EXPECT_TRUE(first->flags & AV_FRAME_FLAG_KEY);
+    EXPECT_EQ(first->linesize[0], kWidth);
+    // 平面指向映射区域：buf[0] 是整个文件，Y 平面紧跟在文件头之后
+    ASSERT_TRUE(first->buf[0]);
+    const size_t header_size = std::strlen(
+        "YUV4MPEG2 W16 H8 F30000:1001 Ip A1:1 C420jpeg\nFRAME\n");
+    EXPECT_EQ(first->data[0], first->buf[0]->data + header_size);
+    EXPECT_EQ(first->data[1], first->data[0] + kWidth * kHeight);
+
+    // 带参数的 FRAME 头
+    auto second = source.ReadFrame();
+    ASSERT_TRUE(second.IsOk() && second.Value());
+    EXPECT_EQ(second.Value()->pts, 1);
+    EXPECT_EQ(second.Value()->data[0][0], 1);
+  }
+
+  // 源已关闭：帧仍持有映射
+  EXPECT_EQ(first->data[0][0], 0);
+  EXPECT_EQ(first->data[2][kWidth * kHeight / 4 - 1], 0);
+}
+
+TEST_F(RawVideoSourceTest, RawYuvSeeksToExactFrame) {
+  std::string path =
+      WriteFile(".yuv", "", 10, [](int) { return std::string(); });
+
+  RawVideoSource::Options options;
+  options.width = kWidth;
+  options.height = kHeight;
+  options.frame_rate = {10, 1};
+  RawVideoSource source;
+  ASSERT_TRUE(source.Open(path, &format_context_, options).IsOk());
+  EXPECT_EQ(source.frame_count(), 10u);
+
+  // 0.45s 落在第 4、5 帧之间
+  ASSERT_TRUE(source.Seek(450000, true));
+  auto backward = source.ReadFrame();
+  ASSERT_TRUE(backward.IsOk() && backward.Value());
+  EXPECT_EQ(backward.Value()->pts, 4);
+  EXPECT_EQ(backward.Value()->data[0][0], 4);
+
+  ASSERT_TRUE(source.Seek(450000, false));
+  EXPECT_EQ(source.ReadFrame().Value()->pts, 5);
+
+  // 越过结尾：EOF
+  ASSERT_TRUE(source.Seek(5000000, true));
+  auto eof = source.ReadFrame();
+  ASSERT_TRUE(eof.IsOk());
+  EXPECT_FALSE(eof.Value());
+}
+
+TEST_F(RawVideoSourceTest, RawYuvRequiresFrameFormat) {
+  std::string path =
+      WriteFile(".yuv", "", 2, [](int) { return std::string(); });
+
+  RawVideoSource source;
+  auto result = source.Open(path, &format_context_, {});
+  EXPECT_EQ(result.Code(), ErrorCode::kInvalidParameter);
+  EXPECT_FALSE(source.IsOpen());
+  EXPECT_EQ(format_context_, nullptr);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file test_reverse_playback.cpp
+ * @brief 单元测试 - 倒放呈现
+ *
+ * 测试目标：
+ * - 按 GOP 交付的帧块逐块倒序呈现（块内从末尾开始，块间时间倒退）
+ * - 虚拟时间戳 origin + (origin - pts) / speed 严格递增
+ * - 到达文件开头的最后一块呈现完后呈现线程退出
+ * - 倒放期间切换到外部时钟，恢复正放时还原同步模式
+ * - 帧来源创建失败时退回正放
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "player/common/player_state_manager.h"
+#include "player/playback/reverse_playback.h"
+#include "player/sync/av_sync_controller.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+using namespace zenplay;
+using FrameChunk = ReverseFrameSource::FrameChunk;
+using SyncMode = AVSyncController::SyncMode;
+
+namespace {
+
+// 一个 GOP：[first_ms, last_ms] 每 step_ms 一帧，时间基 1/1000，PTS 升序
+std::unique_ptr<FrameChunk> MakeGop(int64_t first_ms,
+                                    int64_t last_ms,
+                                    int64_t step_ms,
+                                    bool reached_start) {
+  auto chunk = std::make_unique<FrameChunk>();
+  chunk->time_base = {1, 1000};
+  chunk->reached_start = reached_start;
+  for (int64_t pts = first_ms; pts <= last_ms; pts += step_ms) {
+    AVFramePtr frame(av_frame_alloc());
+    frame->pts = pts;
+    chunk->frames.push_back(std::move(frame));
+  }
+  return chunk;
+}
+
+/**
+ * @brief 依次交付预先准备的帧块（模拟倒放解码器）
+ */
+class FakeReverseSource : public ReverseFrameSource {
+ public:
+  explicit FakeReverseSource(std::deque<std::unique_ptr<FrameChunk>> chunks)
+      : chunks_(std::move(chunks)) {}
+
+  void Stop() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunks_.clear();
+  }
+
+  bool PopChunk(std::unique_ptr<FrameChunk>* chunk, int) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunks_.empty()) {
+      return false;
+    }
+    *chunk = std::move(chunks_.front());
+    chunks_.pop_front();
+    return true;
+  }
+
+  bool finished() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.empty();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<std::unique_ptr<FrameChunk>> chunks_;
+};
+
+/**
+ * @brief 记录呈现线程推送的虚拟时间戳
+ */
+class ReverseHarness {
+ public:
+  ReverseHarness() {
+    state_manager_.TransitionToOpening();
+    state_manager_.TransitionToStopped();
+    state_manager_.TransitionToPlaying();
+
+    ReversePlayback::Callbacks callbacks;
+    callbacks.push_video = [this](AVFramePtr frame,
+                                  const MediaTimestamp& timestamp,
+                                  int /*timeout_ms*/) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      EXPECT_EQ(frame->pts, timestamp.pts);
+      pushed_us_.push_back(timestamp.pts);
+      cv_.notify_all();
+      return true;
+    };
+    callbacks.create_source = [this](int64_t origin_ms)
+        -> Result<std::unique_ptr<ReverseFrameSource>> {
+      using SourceResult = Result<std::unique_ptr<ReverseFrameSource>>;
+      source_origins_.push_back(origin_ms);
+      if (gops_.empty()) {
+        return SourceResult::Err(ErrorCode::kNotSupported, "no video");
+      }
+      return SourceResult::Ok(
+          std::make_unique<FakeReverseSource>(std::move(gops_)));
+    };
+    callbacks.active_changed = [this]() { ++active_changes_; };
+
+    reverse_ = std::make_unique<ReversePlayback>(
+        &state_manager_, &sync_controller_, std::move(callbacks));
+  }
+
+  ~ReverseHarness() { reverse_.reset(); }
+
+  ReversePlayback& reverse() { return *reverse_; }
+  AVSyncController& sync() { return sync_controller_; }
+
+  void AddGop(std::unique_ptr<FrameChunk> chunk) {
+    gops_.push_back(std::move(chunk));
+  }
+
+  std::vector<int64_t> WaitForPushed(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, std::chrono::seconds(5),
+                 [&]() { return pushed_us_.size() >= count; });
+    return pushed_us_;
+  }
+
+  const std::vector<int64_t>& source_origins() const {
+    return source_origins_;
+  }
+  int active_changes() const { return active_changes_.load(); }
+
+ private:
+  PlayerStateManager state_manager_;
+  AVSyncController sync_controller_;
+  std::unique_ptr<ReversePlayback> reverse_;
+  std::deque<std::unique_ptr<FrameChunk>> gops_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<int64_t> pushed_us_;
+  std::vector<int64_t> source_origins_;
+  std::atomic<int> active_changes_{0};
+};
+
+}  // namespace
+
+TEST(ReversePlaybackTest, PresentsGopChunksBackward) {
+  ReverseHarness harness;
+  ReversePlayback& reverse = harness.reverse();
+
+  // 解码器先交付起点之前的 GOP，再交付更早的一个（文件开头）
+  harness.AddGop(MakeGop(1000, 1160, 40, false));
+  harness.AddGop(MakeGop(0, 160, 40, true));
+
+  ASSERT_TRUE(reverse.BeginSeek(-2.0, 1200));
+  EXPECT_TRUE(reverse.IsActive());
+  EXPECT_EQ(reverse.PlaybackRate(), -2.0);
+  EXPECT_EQ(harness.sync().GetSyncMode(), SyncMode::EXTERNAL_MASTER);
+  ASSERT_TRUE(reverse.Start().IsOk());
+  EXPECT_EQ(harness.source_origins(), std::vector<int64_t>{1200});
+
+  std::vector<int64_t> pushed = harness.WaitForPushed(10);
+  ASSERT_EQ(pushed.size(), 10u);
+
+  // 块内从末尾开始，块间时间倒退
+  const int64_t source_ms[] = {1160, 1120, 1080, 1040, 1000,
+                               160,  120,  80,   40,   0};
+  const int64_t origin_us = 1200 * 1000;
+  for (size_t i = 0; i < pushed.size(); ++i) {
+    int64_t expected_us = origin_us + (origin_us - source_ms[i] * 1000) / 2;
+    EXPECT_EQ(pushed[i], expected_us) << "frame " << i;
+    if (i > 0) {
+      EXPECT_GT(pushed[i], pushed[i - 1]) << "frame " << i;
+    }
+  }
+
+  // 最后一块（到达开头）呈现完后不再推送
+  reverse.Stop();
+  EXPECT_EQ(harness.WaitForPushed(10).size(), 10u);
+  EXPECT_TRUE(reverse.IsActive());  // Stop 不改变方向
+}
+
+TEST(ReversePlaybackTest, MapsClockBackwardFromOrigin) {
+  ReverseHarness harness;
+  ReversePlayback& reverse = harness.reverse();
+
+  EXPECT_EQ(reverse.MapClock(10500), 10500);  // 正放不映射
+
+  ASSERT_TRUE(reverse.BeginSeek(-2.0, 10000));
+  EXPECT_EQ(reverse.MapClock(10000), 10000);
+  EXPECT_EQ(reverse.MapClock(10500), 9000);
+  EXPECT_EQ(reverse.MapClock(20000), 0);  // 不早于文件开头
+
+  EXPECT_EQ(ReversePlayback::ClampRate(-10.0), -ReversePlayback::kMaxSpeed);
+  EXPECT_EQ(ReversePlayback::ClampRate(-0.1), -ReversePlayback::kMinSpeed);
+  EXPECT_EQ(ReversePlayback::ClampRate(-1.5), -1.5);
+}
+
+TEST(ReversePlaybackTest, SeekKeepsDirectionUntilForwardRate) {
+  ReverseHarness harness;
+  ReversePlayback& reverse = harness.reverse();
+  harness.sync().SetSyncMode(SyncMode::VIDEO_MASTER);
+
+  ASSERT_TRUE(reverse.BeginSeek(-1.0, 5000));
+  // 倒放中的普通 Seek（速率 0）从新位置继续倒放，速度不变
+  ASSERT_TRUE(reverse.BeginSeek(0.0, 3000));
+  EXPECT_EQ(reverse.PlaybackRate(), -1.0);
+  EXPECT_EQ(reverse.MapClock(3000), 3000);
+  EXPECT_EQ(harness.sync().GetSyncMode(), SyncMode::EXTERNAL_MASTER);
+
+  // 切回正放：还原倒放之前的同步模式并唤醒解封装线程
+  EXPECT_FALSE(reverse.BeginSeek(1.0, 3000));
+  EXPECT_FALSE(reverse.IsActive());
+  EXPECT_EQ(reverse.PlaybackRate(), 1.0);
+  EXPECT_EQ(harness.sync().GetSyncMode(), SyncMode::VIDEO_MASTER);
+  EXPECT_EQ(harness.active_changes(), 1);
+
+  // 正放中的普通 Seek 保持正放
+  EXPECT_FALSE(reverse.BeginSeek(0.0, 1000));
+}
+
+TEST(ReversePlaybackTest, FallsBackToForwardWhenSourceFails) {
+  ReverseHarness harness;
+  ReversePlayback& reverse = harness.reverse();
+
+  ASSERT_TRUE(reverse.BeginSeek(-1.0, 2000));
+  auto result = reverse.Start();
+  EXPECT_FALSE(result.IsOk());
+  EXPECT_EQ(result.Code(), ErrorCode::kNotSupported);
+  EXPECT_FALSE(reverse.IsActive());
+  EXPECT_EQ(harness.sync().GetSyncMode(), SyncMode::AUDIO_MASTER);
+  EXPECT_EQ(harness.active_changes(), 1);
+
+  // Reset 在正放时不再通知
+  reverse.Reset();
+  EXPECT_EQ(harness.active_changes(), 1);
+}
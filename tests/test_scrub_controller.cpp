@@ -0,0 +1,279 @@
+/**
+ * @file test_scrub_controller.cpp
+ * @brief 单元测试 - 拖动进度条
+ *
+ * 测试目标：
+ * - 拖动中只预览关键帧：跳过其他流的包，解码器有输出延迟时送入结束标记
+ *   取出第一帧，读包数量有上限
+ * - 预览限频，拖动结束后不再预览
+ * - 松开时精确跳转，完成后按拖动前的状态恢复播放
+ * - 松开的 Seek 执行前再次拖动，恢复播放的责任交给新的一次拖动
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "player/playback/scrub_controller.h"
+
+extern "C" {
+#include <libavcodec/packet.h>
+#include <libavutil/frame.h>
+}
+
+using namespace zenplay;
+
+namespace {
+
+AVPacket* MakePacket(int stream_index, int64_t pts) {
+  AVPacket* packet = av_packet_alloc();
+  packet->stream_index = stream_index;
+  packet->pts = pts;
+  return packet;
+}
+
+/**
+ * @brief 记录拖动控制发出的暂停 / 恢复 / 跳转 / 预览
+ */
+class ScrubHarness {
+ public:
+  ScrubHarness() {
+    ScrubController::Callbacks callbacks;
+    callbacks.pause_if_playing = [this]() {
+      if (!playing) {
+        return false;
+      }
+      playing = false;
+      return true;
+    };
+    callbacks.resume_playback = [this]() {
+      playing = true;
+      ++resumes;
+    };
+    callbacks.queue_preview = [this](int64_t timestamp_ms) {
+      previews.push_back(timestamp_ms);
+      return true;
+    };
+    callbacks.queue_release = [this](int64_t timestamp_ms) {
+      releases.push_back(timestamp_ms);
+    };
+    callbacks.seek = [this](int64_t timestamp_ms) {
+      seeks.push_back(timestamp_ms);
+    };
+    callbacks.decode_keyframe = [this](int64_t timestamp_ms) {
+      decoded.push_back(timestamp_ms);
+      AVFramePtr frame(av_frame_alloc());
+      // 预览显示目标位置之前的关键帧
+      frame->pts = timestamp_ms - timestamp_ms % 2000;
+      return frame;
+    };
+    callbacks.show_frame = [this](AVFrame* frame) {
+      shown.push_back(frame->pts);
+    };
+    scrub = std::make_unique<ScrubController>(std::move(callbacks));
+  }
+
+  std::unique_ptr<ScrubController> scrub;
+  bool playing = false;
+  int resumes = 0;
+  std::vector<int64_t> previews;
+  std::vector<int64_t> releases;
+  std::vector<int64_t> seeks;
+  std::vector<int64_t> decoded;
+  std::vector<int64_t> shown;
+};
+
+constexpr auto kInterval = std::chrono::milliseconds(200);
+
+}  // namespace
+
+TEST(ScrubControllerTest, PreviewsKeyframeWhileDragging) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+
+  scrub.MoveTo(1000);  // 未开始拖动
+  EXPECT_TRUE(harness.previews.empty());
+
+  scrub.Begin(true, kInterval);
+  EXPECT_TRUE(scrub.IsScrubbing());
+  scrub.MoveTo(3500);
+  scrub.MoveTo(4100);
+  EXPECT_EQ(harness.previews, (std::vector<int64_t>{3500, 4100}));
+
+  // SeekTask 合并积压后只预览最新位置，显示其之前的关键帧
+  EXPECT_EQ(scrub.PreviewWaitMs(), 0);
+  scrub.ShowPreview(4100);
+  EXPECT_EQ(harness.decoded, std::vector<int64_t>{4100});
+  EXPECT_EQ(harness.shown, std::vector<int64_t>{4000});
+
+  // 下一次预览至少间隔 interval
+  int64_t wait_ms = scrub.PreviewWaitMs();
+  EXPECT_GT(wait_ms, 0);
+  EXPECT_LE(wait_ms, kInterval.count() + 1);
+
+  // 松开：精确跳转到松开的位置，之后排队的预览不再解码
+  scrub.End(4321);
+  EXPECT_FALSE(scrub.IsScrubbing());
+  EXPECT_EQ(harness.releases, std::vector<int64_t>{4321});
+  scrub.ShowPreview(4200);
+  EXPECT_EQ(harness.decoded.size(), 1u);
+  scrub.MoveTo(5000);
+  EXPECT_EQ(harness.previews.size(), 2u);
+}
+
+TEST(ScrubControllerTest, PreviewDisabledOnlySeeksOnRelease) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+
+  // 倒放 / A-B 循环中不预览
+  scrub.Begin(false, kInterval);
+  scrub.MoveTo(2000);
+  EXPECT_TRUE(harness.previews.empty());
+  scrub.End(2500);
+  EXPECT_EQ(harness.releases, std::vector<int64_t>{2500});
+
+  // 没有按下就松开：普通 Seek
+  scrub.End(3000);
+  EXPECT_EQ(harness.seeks, std::vector<int64_t>{3000});
+  EXPECT_EQ(harness.releases.size(), 1u);
+}
+
+TEST(ScrubControllerTest, ResumesPlaybackAfterReleaseSeek) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+  harness.playing = true;
+
+  scrub.Begin(true, kInterval);
+  EXPECT_FALSE(harness.playing);
+
+  // 拖动中的预览和其他 Seek 不恢复播放
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 0);
+
+  scrub.End(1000);
+  scrub.OnSeekCompleted(true);
+  EXPECT_TRUE(harness.playing);
+  EXPECT_EQ(harness.resumes, 1);
+
+  // 只恢复一次
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 1);
+}
+
+TEST(ScrubControllerTest, StaysPausedWhenNotPlayingOrSeekFailed) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+
+  scrub.Begin(true, kInterval);
+  scrub.End(1000);
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 0);
+
+  harness.playing = true;
+  scrub.Begin(true, kInterval);
+  scrub.End(2000);
+  scrub.OnSeekCompleted(false);
+  EXPECT_EQ(harness.resumes, 0);
+  EXPECT_FALSE(harness.playing);
+}
+
+TEST(ScrubControllerTest, RegrabTakesOverResume) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+  harness.playing = true;
+
+  scrub.Begin(true, kInterval);
+  scrub.End(1000);
+  // 松开的 Seek 执行前再次按下：这一次 Seek 完成时不恢复
+  scrub.Begin(true, kInterval);
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 0);
+  EXPECT_FALSE(harness.playing);
+
+  scrub.End(2000);
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 1);
+}
+
+TEST(ScrubControllerTest, PreviewPausesPlaybackResumedMeanwhile) {
+  ScrubHarness harness;
+  ScrubController& scrub = *harness.scrub;
+
+  scrub.Begin(true, std::chrono::milliseconds(0));
+  // 上一次 Seek 完成后恢复了播放：预览时暂停，松开后再恢复
+  harness.playing = true;
+  scrub.ShowPreview(1500);
+  EXPECT_FALSE(harness.playing);
+  EXPECT_EQ(scrub.PreviewWaitMs(), 0);
+
+  scrub.End(1500);
+  scrub.OnSeekCompleted(true);
+  EXPECT_EQ(harness.resumes, 1);
+}
+
+TEST(ScrubControllerTest, DecodesFirstVideoFrameFromKeyframe) {
+  constexpr int kVideo = 0;
+  constexpr int kAudio = 1;
+  std::deque<AVPacket*> packets = {
+      MakePacket(kAudio, 0),     // 跳过
+      MakePacket(kVideo, 2000),  // 关键帧，解码器延迟一个包输出
+      MakePacket(kVideo, 2040),
+  };
+  size_t read_count = 0;
+  auto read_packet = [&]() -> AVPacket* {
+    if (packets.empty()) {
+      return nullptr;
+    }
+    ++read_count;
+    AVPacket* packet = packets.front();
+    packets.pop_front();
+    return packet;
+  };
+
+  std::vector<int64_t> decode_calls;  // -1 表示结束标记
+  int64_t delayed_pts = -1;
+  auto decode = [&](AVPacket* packet, std::vector<AVFramePtr>* frames) {
+    decode_calls.push_back(packet ? packet->pts : -1);
+    if (packet) {
+      delayed_pts = packet->pts;
+      return;
+    }
+    AVFramePtr frame(av_frame_alloc());
+    frame->pts = delayed_pts;
+    frames->push_back(std::move(frame));
+  };
+
+  AVFramePtr frame = ScrubController::DecodeFirstVideoFrame(
+      kVideo, read_packet, decode, 256);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->pts, 2000);
+  EXPECT_EQ(read_count, 2u);  // 取到第一帧后不再读包
+  EXPECT_EQ(decode_calls, (std::vector<int64_t>{2000, -1}));
+
+  for (AVPacket* packet : packets) {
+    av_packet_free(&packet);
+  }
+}
+
+TEST(ScrubControllerTest, GivesUpAfterMaxPackets) {
+  size_t read_count = 0;
+  auto read_audio = [&]() -> AVPacket* {
+    ++read_count;
+    return MakePacket(1, 0);
+  };
+  auto decode = [](AVPacket*, std::vector<AVFramePtr>*) {
+    ADD_FAILURE() << "non-video packets must not be decoded";
+  };
+
+  EXPECT_FALSE(
+      ScrubController::DecodeFirstVideoFrame(0, read_audio, decode, 8));
+  EXPECT_EQ(read_count, 8u);
+
+  // 读到结尾时停止
+  auto read_end = []() -> AVPacket* { return nullptr; };
+  EXPECT_FALSE(
+      ScrubController::DecodeFirstVideoFrame(0, read_end, decode, 8));
+}
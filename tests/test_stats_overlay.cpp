@@ -0,0 +1,112 @@
+/**
+ * @file test_stats_overlay.cpp
+ * @brief 单元测试 - 屏幕统计浮层
+ *
+ * 测试目标：
+ * - 帧率和区间丢帧按前后两份快照的计数差计算
+ * - 文字不变时不重新生成图像；未到刷新时间时 Update 直接返回
+ * - 图像尺寸固定，背景半透明，字形来自点阵图集
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "player/video/render/stats_overlay.h"
+
+using namespace zenplay;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+stats::StatsShmSnapshot MakeSnapshot(uint64_t rendered,
+                                     uint64_t decoded,
+                                     uint64_t dropped) {
+  stats::StatsShmSnapshot snapshot;
+  snapshot.video_frames_rendered = rendered;
+  snapshot.video_frames_decoded = decoded;
+  snapshot.video_frames_dropped = dropped;
+  snapshot.video_avg_decode_time_ms = 3.25;
+  snapshot.video_avg_render_time_ms = 0.5;
+  snapshot.video_decode_queue_size = 4;
+  snapshot.audio_decode_queue_size = 9;
+  snapshot.av_sync_offset_ms = -12.3;
+  return snapshot;
+}
+
+}  // namespace
+
+TEST(StatsOverlayTest, RatesFromSnapshotDeltas) {
+  StatsOverlay overlay;
+  auto start = Clock::now();
+
+  EXPECT_TRUE(overlay.Update(MakeSnapshot(100, 110, 5), -1.0, start));
+  EXPECT_EQ(overlay.lines()[5], "cpu   --");
+
+  // 0.5s 内渲染 30 帧、解码 31 帧、丢 2 帧
+  EXPECT_TRUE(overlay.Update(MakeSnapshot(130, 141, 7), 42.5,
+                             start + milliseconds(500)));
+  const auto& lines = overlay.lines();
+  EXPECT_EQ(lines[0], "fps    60.0  decode  62.0");
+  EXPECT_EQ(lines[1], "drop  7 (+2)");
+  EXPECT_EQ(lines[2], "time  dec 3.25  rnd 0.50 ms");
+  EXPECT_EQ(lines[3], "queue video 4  audio 9");
+  EXPECT_EQ(lines[4], "a-v   -12.3 ms");
+  EXPECT_EQ(lines[5], "cpu   42.5%");
+
+  // 统计被重置（切换文件）：计数回落不产生负的帧率
+  EXPECT_TRUE(overlay.Update(MakeSnapshot(0, 0, 0), 42.5,
+                             start + milliseconds(1000)));
+  EXPECT_EQ(overlay.lines()[0], "fps     0.0  decode   0.0");
+  EXPECT_EQ(overlay.lines()[1], "drop  0 (+0)");
+}
+
+TEST(StatsOverlayTest, RasterizesOnlyWhenTextChanges) {
+  constexpr int kScale = 2;
+  StatsOverlay overlay(milliseconds(250), kScale);
+  auto start = Clock::now();
+
+  // 计数不变：文字不变，不需要重新上传
+  ASSERT_TRUE(overlay.Update(MakeSnapshot(0, 0, 0), 10.0, start));
+  EXPECT_FALSE(overlay.Update(MakeSnapshot(0, 0, 0), 10.0,
+                              start + milliseconds(250)));
+  EXPECT_TRUE(overlay.Update(MakeSnapshot(0, 0, 1), 10.0,
+                             start + milliseconds(500)));
+
+  const OverlayImage& image = overlay.image();
+  const int padding = 3 * kScale;
+  EXPECT_EQ(image.width, StatsOverlay::kColumns * 6 * kScale + 2 * padding);
+  EXPECT_EQ(image.height, StatsOverlay::kRows * 8 * kScale + 2 * padding);
+  ASSERT_EQ(image.pixels.size(),
+            static_cast<size_t>(image.width) * image.height * 4);
+
+  auto pixel = [&](int x, int y) {
+    return image.pixels.data() + (static_cast<size_t>(y) * image.width + x) * 4;
+  };
+  // 边距是半透明黑底
+  EXPECT_EQ(pixel(0, 0)[0], 0);
+  EXPECT_EQ(pixel(0, 0)[3], 0xA0);
+
+  // 第一行第一个字符 'f' 的竖笔（点阵第 1 列，第 1-6 行）
+  const uint8_t* stroke = pixel(padding + 1 * kScale, padding + 3 * kScale);
+  EXPECT_EQ(stroke[0], 0xFF);
+  EXPECT_EQ(stroke[3], 0xFF);
+  // 字符格右侧的间隔列只有背景
+  EXPECT_EQ(pixel(padding + 5 * kScale, padding + 3 * kScale)[3], 0xA0);
+}
+
+TEST(StatsOverlayTest, UpdateIsThrottledToInterval) {
+  StatsOverlay overlay(milliseconds(250));
+  auto start = Clock::now();
+
+  // 采样全局统计（StatisticsManager 未初始化时为全零快照）
+  EXPECT_TRUE(overlay.Update(start));
+  EXPECT_FALSE(overlay.Update(start + milliseconds(100)));
+  EXPECT_FALSE(overlay.Update(start + milliseconds(249)));
+
+  // 到了刷新时间：第二次采样有了 CPU 占用，文字变化
+  EXPECT_TRUE(overlay.Update(start + milliseconds(250)));
+  EXPECT_NE(overlay.lines()[5], "cpu   --");
+}
@@ -0,0 +1,210 @@
+/**
+ * @file test_stats_shm.cpp
+ * @brief 单元测试 - 共享内存统计段（seqlock）
+ *
+ * 测试目标：
+ * - 发布器写入的快照经只读映射完整读回
+ * - 写端持续发布时，读端读到的快照从不出现新旧字段混杂（torn read）
+ * - 同名段的写端仍在运行时 Open() 失败；写端已退出的旧段被替换
+ */
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "player/stats/stats_shm_layout.h"
+#include "player/stats/stats_shm_publisher.h"
+
+using namespace zenplay;
+using namespace zenplay::stats;
+
+namespace {
+
+std::string TestSegmentName() {
+  return "/zenplay_stats_test_" + std::to_string(getpid());
+}
+
+/**
+ * @brief 只读映射一个已存在的段（模拟外部监控进程）
+ */
+class SegmentMapping {
+ public:
+  explicit SegmentMapping(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      return;
+    }
+    void* addr =
+        mmap(nullptr, sizeof(StatsShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr != MAP_FAILED) {
+      segment_ = static_cast<const StatsShmSegment*>(addr);
+    }
+  }
+
+  ~SegmentMapping() {
+    if (segment_) {
+      munmap(const_cast<StatsShmSegment*>(segment_), sizeof(StatsShmSegment));
+    }
+  }
+
+  const StatsShmSegment* get() const { return segment_; }
+
+ private:
+  const StatsShmSegment* segment_ = nullptr;
+};
+
+// 所有计数字段取同一个值，读端据此判断是否混杂了两次发布
+StatsShmSnapshot MakeSnapshot(uint64_t value) {
+  StatsShmSnapshot snapshot;
+  snapshot.timestamp_us = value;
+  snapshot.demux_packets_total = value;
+  snapshot.video_frames_decoded = value;
+  snapshot.video_frames_rendered = value;
+  snapshot.audio_frames_rendered = value;
+  snapshot.av_sync_offset_ms = static_cast<double>(value);
+  snapshot.network_errors = value;
+  return snapshot;
+}
+
+bool IsConsistent(const StatsShmSnapshot& snapshot) {
+  uint64_t value = snapshot.timestamp_us;
+  return snapshot.demux_packets_total == value &&
+         snapshot.video_frames_decoded == value &&
+         snapshot.video_frames_rendered == value &&
+         snapshot.audio_frames_rendered == value &&
+         snapshot.av_sync_offset_ms == static_cast<double>(value) &&
+         snapshot.network_errors == value;
+}
+
+}  // namespace
+
+TEST(StatsShmTest, PublishedSnapshotRoundTrips) {
+  const std::string name = TestSegmentName();
+  StatsShmPublisher publisher;
+  ASSERT_TRUE(publisher.Open(name).IsOk());
+
+  StatsShmSnapshot snapshot = MakeSnapshot(42);
+  snapshot.video_decode_queue_size = 7;
+  snapshot.buffer_health_percent = 63;
+  publisher.Publish(snapshot);
+
+  SegmentMapping mapping(name);
+  ASSERT_NE(mapping.get(), nullptr);
+  EXPECT_EQ(mapping.get()->header.writer_pid, static_cast<uint32_t>(getpid()));
+  EXPECT_EQ(mapping.get()->header.publish_count.load(), 1u);
+
+  StatsShmSnapshot read;
+  ASSERT_TRUE(ReadStatsShmSnapshot(mapping.get(), &read));
+  EXPECT_TRUE(IsConsistent(read));
+  EXPECT_EQ(read.timestamp_us, 42u);
+  EXPECT_EQ(read.video_decode_queue_size, 7u);
+  EXPECT_EQ(read.buffer_health_percent, 63u);
+
+  // 关闭后段被删除，已建立的映射仍可读到最后一份快照
+  publisher.Close();
+  EXPECT_LT(shm_open(name.c_str(), O_RDONLY, 0), 0);
+  ASSERT_TRUE(ReadStatsShmSnapshot(mapping.get(), &read));
+  EXPECT_EQ(read.timestamp_us, 42u);
+}
+
+TEST(StatsShmTest, ConcurrentReaderNeverSeesTornSnapshot) {
+  auto segment = std::make_unique<StatsShmSegment>();
+  segment->header.version = kStatsShmVersion;
+  segment->header.header_size = sizeof(StatsShmHeader);
+  segment->header.snapshot_size = sizeof(StatsShmSnapshot);
+  segment->header.magic.store(kStatsShmMagic, std::memory_order_release);
+
+  constexpr uint64_t kPublishCount = 200000;
+  std::atomic<bool> writer_done{false};
+  std::thread writer([&]() {
+    for (uint64_t i = 1; i <= kPublishCount; ++i) {
+      WriteStatsShmSnapshot(segment.get(), MakeSnapshot(i));
+    }
+    writer_done.store(true);
+  });
+
+  uint64_t reads = 0;
+  uint64_t torn = 0;
+  uint64_t last_value = 0;
+  bool monotonic = true;
+  while (!writer_done.load()) {
+    StatsShmSnapshot snapshot;
+    if (!ReadStatsShmSnapshot(segment.get(), &snapshot)) {
+      continue;  // 写入过于频繁时允许放弃，但不允许返回混杂的快照
+    }
+    ++reads;
+    if (!IsConsistent(snapshot)) {
+      ++torn;
+    }
+    monotonic = monotonic && snapshot.timestamp_us >= last_value;
+    last_value = snapshot.timestamp_us;
+  }
+  writer.join();
+
+  EXPECT_EQ(torn, 0u);
+  EXPECT_TRUE(monotonic);
+  EXPECT_GT(reads, 0u);
+  EXPECT_EQ(segment->header.publish_count.load(), kPublishCount);
+  EXPECT_EQ(segment->header.sequence.load(), 2 * kPublishCount);
+}
+
+TEST(StatsShmTest, OpenFailsWhileOwnerIsAlive) {
+  const std::string name = TestSegmentName();
+  StatsShmPublisher owner;
+  ASSERT_TRUE(owner.Open(name).IsOk());
+  owner.Publish(MakeSnapshot(5));
+
+  StatsShmPublisher second;
+  auto result = second.Open(name);
+  ASSERT_FALSE(result.IsOk());
+  EXPECT_EQ(result.Code(), ErrorCode::kAlreadyRunning);
+
+  // 原写端的段没有被删除或改写
+  SegmentMapping mapping(name);
+  ASSERT_NE(mapping.get(), nullptr);
+  StatsShmSnapshot read;
+  ASSERT_TRUE(ReadStatsShmSnapshot(mapping.get(), &read));
+  EXPECT_EQ(read.timestamp_us, 5u);
+}
+
+TEST(StatsShmTest, ReplacesSegmentOfExitedWriter) {
+  const std::string name = TestSegmentName();
+
+  // 已退出的子进程号，模拟异常退出后留下的旧段
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    _exit(0);
+  }
+  ASSERT_EQ(waitpid(child, nullptr, 0), child);
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, sizeof(StatsShmSegment)), 0);
+  void* addr = mmap(nullptr, sizeof(StatsShmSegment), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_NE(addr, MAP_FAILED);
+  auto* stale = new (addr) StatsShmSegment();
+  stale->header.version = kStatsShmVersion;
+  stale->header.writer_pid = static_cast<uint32_t>(child);
+  stale->header.magic.store(kStatsShmMagic, std::memory_order_release);
+  munmap(addr, sizeof(StatsShmSegment));
+
+  StatsShmPublisher publisher;
+  ASSERT_TRUE(publisher.Open(name).IsOk());
+  SegmentMapping mapping(name);
+  ASSERT_NE(mapping.get(), nullptr);
+  EXPECT_EQ(mapping.get()->header.writer_pid, static_cast<uint32_t>(getpid()));
+}
@@ -0,0 +1,171 @@
+/**
+ * @file test_video_player_slots.cpp
+ * @brief 单元测试 - VideoPlayer 预分配帧槽位
+ *
+ * 测试目标：
+ * - 队列满且允许丢帧时丢弃最老的帧，队列长度保持为容量
+ * - 写入位置绕回槽位开头后，渲染线程仍按推入顺序取帧
+ * - 不允许丢帧时队列满拒绝新帧；清空后槽位重新可用
+ *
+ * 除逐帧渲染的用例外，渲染线程在推帧之后才启动；队列里的帧使用无效
+ * 时间戳（不参与同步、不会被渲染线程丢弃），捕获渲染器按 AVFrame::pts
+ * 记录渲染顺序。
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+#include "player/common/player_state_manager.h"
+#include "player/video/render/renderer.h"
+#include "player/video/video_player.h"
+
+using namespace zenplay;
+
+namespace {
+
+constexpr int kCapacity = 3;
+
+/**
+ * @brief 捕获渲染器：按顺序记录渲染的帧序号
+ */
+class CaptureRenderer : public Renderer {
+ public:
+  Result<void> Init(void* /*window_handle*/,
+                    int /*width*/,
+                    int /*height*/) override {
+    return Result<void>::Ok();
+  }
+
+  bool RenderFrame(AVFrame* frame) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rendered_.push_back(frame->pts);
+    rendered_cv_.notify_all();
+    return true;
+  }
+
+  void Clear() override {}
+  void Present() override {}
+  void OnResize(int /*width*/, int /*height*/) override {}
+  void Cleanup() override {}
+  const char* GetRendererName() const override { return "Capture"; }
+  void ClearCaches() override {}
+
+  // 等待渲染了 count 帧，返回已渲染的帧序号
+  std::vector<int64_t> WaitForRendered(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    rendered_cv_.wait_for(lock, std::chrono::seconds(2),
+                          [&] { return rendered_.size() >= count; });
+    return rendered_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable rendered_cv_;
+  std::vector<int64_t> rendered_;
+};
+
+AVFramePtr MakeFrame(int64_t index) {
+  AVFramePtr frame(av_frame_alloc());
+  frame->pts = index;
+  return frame;
+}
+
+VideoPlayer::FrameTimestamp InvalidTimestamp() {
+  VideoPlayer::FrameTimestamp timestamp;
+  timestamp.pts = AV_NOPTS_VALUE;
+  timestamp.dts = AV_NOPTS_VALUE;
+  timestamp.time_base = AVRational{1, 1000};
+  return timestamp;
+}
+
+/**
+ * @brief 处于播放状态、尚未启动渲染线程的 VideoPlayer
+ */
+class VideoPlayerSlotsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    state_manager_.TransitionToOpening();
+    state_manager_.TransitionToStopped();
+    state_manager_.TransitionToPlaying();
+  }
+
+  void TearDown() override {
+    state_manager_.TransitionToStopped();
+    player_.Stop();
+  }
+
+  void InitPlayer(bool drop_frames) {
+    VideoPlayer::VideoConfig config;
+    config.target_fps = 1000.0;  // 每帧 1ms，渲染线程不必久等
+    config.max_frame_queue_size = kCapacity;
+    config.drop_frames = drop_frames;
+    ASSERT_TRUE(player_.Init(&renderer_, config));
+  }
+
+  bool Push(int64_t index) {
+    return player_.PushFrame(MakeFrame(index), InvalidTimestamp());
+  }
+
+  PlayerStateManager state_manager_;
+  CaptureRenderer renderer_;
+  VideoPlayer player_{&state_manager_};
+};
+
+}  // namespace
+
+TEST_F(VideoPlayerSlotsTest, DropsOldestFrameWhenFull) {
+  InitPlayer(true);
+
+  // 推入 8 帧：写入位置绕回两次，只留下最新的 3 帧
+  for (int64_t i = 0; i < 8; ++i) {
+    EXPECT_TRUE(Push(i));
+    EXPECT_LE(player_.GetQueueSize(), static_cast<size_t>(kCapacity));
+  }
+  EXPECT_EQ(player_.GetQueueSize(), static_cast<size_t>(kCapacity));
+
+  ASSERT_TRUE(player_.Start().IsOk());
+  EXPECT_EQ(renderer_.WaitForRendered(3), (std::vector<int64_t>{5, 6, 7}));
+}
+
+TEST_F(VideoPlayerSlotsTest, KeepsOrderAcrossWrap) {
+  InitPlayer(true);
+  ASSERT_TRUE(player_.Start().IsOk());
+
+  // 渲染线程逐帧取走：读写位置在槽位中多次绕回
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < 3 * kCapacity + 1; ++i) {
+    EXPECT_TRUE(Push(i));
+    expected.push_back(i);
+    EXPECT_EQ(renderer_.WaitForRendered(expected.size()), expected);
+  }
+  EXPECT_EQ(player_.GetQueueSize(), 0u);
+}
+
+TEST_F(VideoPlayerSlotsTest, RejectsFrameWhenFullWithoutDropping) {
+  InitPlayer(false);
+
+  for (int64_t i = 0; i < kCapacity; ++i) {
+    EXPECT_TRUE(Push(i));
+  }
+  EXPECT_FALSE(Push(kCapacity));
+  EXPECT_EQ(player_.GetQueueSize(), static_cast<size_t>(kCapacity));
+
+  // 清空后槽位重新可用，之前的帧不再渲染
+  player_.ClearFrames();
+  EXPECT_EQ(player_.GetQueueSize(), 0u);
+  for (int64_t i = 10; i < 10 + kCapacity; ++i) {
+    EXPECT_TRUE(Push(i));
+  }
+  EXPECT_FALSE(Push(10 + kCapacity));
+
+  ASSERT_TRUE(player_.Start().IsOk());
+  EXPECT_EQ(renderer_.WaitForRendered(3), (std::vector<int64_t>{10, 11, 12}));
+}
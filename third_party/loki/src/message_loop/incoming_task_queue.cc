@@ -45,20 +45,21 @@ bool IncomingTaskQueue::AddToIncomingQueue(const Location& from_here,
 
   PendingTask pending_task(from_here, std::move(task),
                            CalculateDelayedRuntime(delay), nestable);
+  pending_task.queue_time = std::chrono::steady_clock::now() + delay;
 
   return PostPendingTask(&pending_task);
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
-  std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-  return incoming_queue_.empty();
+  return !incoming_queue_.Peek();
+}
+
+void IncomingTaskQueue::GetStats(TaskQueueStats* stats) const {
+  stats_.Snapshot(stats);
 }
 
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
-  {
-    std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-    accept_new_tasks_ = false;
-  }
+  accept_new_tasks_.store(false, std::memory_order_seq_cst);
   {
     std::lock_guard<std::mutex> lock(message_loop_lock_);
     message_loop_ = nullptr;
@@ -66,15 +67,12 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 }
 
 void IncomingTaskQueue::StartScheduling() {
-  bool schedule_work;
-  {
-    std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-    DCHECK(!is_ready_for_schedulig_);
-    DCHECK(!message_loop_scheduled_);
-    is_ready_for_schedulig_ = true;
-    schedule_work = !incoming_queue_.empty();
-  }
-  if (schedule_work) {
+  DCHECK(!is_ready_for_schedulig_.load());
+  DCHECK(!message_loop_scheduled_.load());
+  is_ready_for_schedulig_.store(true, std::memory_order_seq_cst);
+
+  // 在这之前投递的任务没有唤醒message loop, 这里补一次.
+  if (incoming_queue_.Peek() && TryMarkScheduled()) {
     DCHECK_NOTNULL(message_loop_);
 
     // 这里不需要加锁，因为这个只会在自己的线程上调用.
@@ -83,6 +81,8 @@ void IncomingTaskQueue::StartScheduling() {
 }
 
 void IncomingTaskQueue::RunTask(PendingTask* pending_task) {
+  stats_.OnTaskRun(pending_task->queue_time);
+
   // 运行任务.
   std::move(pending_task->task).Run();
 }
@@ -93,25 +93,13 @@ IncomingTaskQueue::~IncomingTaskQueue() {
 }
 
 bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
-  bool accept_new_tasks;
-  bool schedule_work = false;
-
-  {
-    std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-    accept_new_tasks = accept_new_tasks_;
-    if (accept_new_tasks) {
-      schedule_work = PostPendingTaskLockRequired(pending_task);
-    }
-  }
-
-  if (!accept_new_tasks) {
-    DCHECK(!schedule_work);
+  if (!accept_new_tasks_.load(std::memory_order_acquire)) {
     pending_task->task.Reset();
     return false;
   }
 
   // 唤醒message loop 并且给他派遣工作
-  if (schedule_work) {
+  if (EnqueuePendingTask(pending_task)) {
     // 锁住message loop, 防止message loop被释放.
     std::lock_guard<std::mutex> lock(message_loop_lock_);
     if (message_loop_)
@@ -121,46 +109,48 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   return true;
 }
 
-bool IncomingTaskQueue::PostPendingTaskLockRequired(PendingTask* pending_task) {
-  // std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-
-  pending_task->sequence_num = next_sequence_num_++;
+bool IncomingTaskQueue::EnqueuePendingTask(PendingTask* pending_task) {
+  pending_task->sequence_num =
+      next_sequence_num_.fetch_add(1, std::memory_order_relaxed);
 
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(std::move(*pending_task));
+  stats_.OnTaskPosted();
+  incoming_queue_.Push(std::move(*pending_task));
 
   // 当is_ready_for_schedulig_为true时，代表是已经调用了StartScheulig,
   // 如果always_schedule_work_为true，表示可以一直派遣工作，并且唤醒message loop
-  // 那样可以返回true，如果是第一个派遣工作也可以直接返回true.
-  if (is_ready_for_schedulig_ &&
-      (always_schedule_work_ || (!message_loop_scheduled_ && was_empty))) {
-    message_loop_scheduled_ = true;
+  // 那样可以返回true，否则只有message loop 处于空闲(没有被scheduled)时，
+  // 第一个把标志改为true的投递方负责唤醒.
+  if (!is_ready_for_schedulig_.load(std::memory_order_seq_cst))
+    return false;
+
+  if (always_schedule_work_) {
+    message_loop_scheduled_.store(true, std::memory_order_seq_cst);
     return true;
   }
 
-  return false;
+  return TryMarkScheduled();
 }
 
-int IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
-  // work queue 必须为空
-  DCHECK(work_queue->empty());
-
-  // 加锁
-  std::lock_guard<std::mutex> lock(incoming_queue_lock_);
-  if (incoming_queue_.empty()) {
-    // 如果incoming queue为空的话，那么就代表这个incoming queue里面没有
-    // 任何的任务，这种情况意味着将需要sleep然后等待任务到来，如果这个
-    // incoming queue不是空的，那么就重新派遣任务, 这样就可以将
-    // message_loop_scheduled_ 设置为false，让incoming queue不为空时，
-    // 可以派遣任务.
-    message_loop_scheduled_ = false;
-  } else {
-    incoming_queue_.swap(*work_queue);
-  }
+bool IncomingTaskQueue::HasIncomingTasks() {
+  if (incoming_queue_.Peek())
+    return true;
 
-  int high_res_tasks = high_res_task_count_;
-  high_res_task_count_ = 0;
-  return high_res_tasks;
+  // 如果incoming queue为空的话，那么就代表这个incoming queue里面没有
+  // 任何的任务，这种情况意味着将需要sleep然后等待任务到来，这样就可以将
+  // message_loop_scheduled_ 设置为false，让incoming queue不为空时，
+  // 可以派遣任务.
+  message_loop_scheduled_.store(false, std::memory_order_seq_cst);
+
+  // 投递方可能在上面的Peek()之后入队，但看到的标志仍然是true 而没有唤醒，
+  // 清除标志之后再检查一次；有任务就重新标记为scheduled 继续处理.
+  if (!incoming_queue_.Peek())
+    return false;
+  TryMarkScheduled();
+  return true;
+}
+
+bool IncomingTaskQueue::TryMarkScheduled() {
+  return !message_loop_scheduled_.exchange(true, std::memory_order_seq_cst);
 }
 
 IncomingTaskQueue::TriageQueue::TriageQueue(IncomingTaskQueue* outer)
@@ -169,35 +159,28 @@ IncomingTaskQueue::TriageQueue::TriageQueue(IncomingTaskQueue* outer)
 IncomingTaskQueue::TriageQueue::~TriageQueue() = default;
 
 const PendingTask& IncomingTaskQueue::TriageQueue::Peek() {
-  ReloadFromIncomingQueueIfEmpty();
-  DCHECK(!queue_.empty());
-  return queue_.front();
+  PendingTask* pending_task = outer_->incoming_queue_.Peek();
+  DCHECK(pending_task);
+  return *pending_task;
 }
 
 PendingTask IncomingTaskQueue::TriageQueue::Pop() {
-  ReloadFromIncomingQueueIfEmpty();
-  DCHECK(!queue_.empty());
-  PendingTask pending_task = std::move(queue_.front());
-  queue_.pop();
-
-  if (pending_task.is_high_res)
-    --outer_->pending_high_res_tasks_;
+  PendingTask* front = outer_->incoming_queue_.Peek();
+  DCHECK(front);
+  PendingTask pending_task = std::move(*front);
+  outer_->incoming_queue_.Pop();
+  outer_->stats_.OnTaskDequeued();
 
   return pending_task;
 }
 
 bool IncomingTaskQueue::TriageQueue::HasTasks() {
-  ReloadFromIncomingQueueIfEmpty();
-  return !queue_.empty();
+  return outer_->HasIncomingTasks();
 }
 
 void IncomingTaskQueue::TriageQueue::Clear() {
-  while (!queue_.empty()) {
-    PendingTask pending_task = std::move(queue_.front());
-    queue_.pop();
-
-    if (pending_task.is_high_res)
-      --outer_->pending_high_res_tasks_;
+  while (outer_->incoming_queue_.Peek()) {
+    PendingTask pending_task = Pop();
 
     if (pending_task.delayed_run_time.count()) {
       outer_->delayed_tasks().Push(std::move(pending_task));
@@ -205,12 +188,6 @@ void IncomingTaskQueue::TriageQueue::Clear() {
   }
 }
 
-void IncomingTaskQueue::TriageQueue::ReloadFromIncomingQueueIfEmpty() {
-  if (queue_.empty()) {
-    outer_->pending_high_res_tasks_ += outer_->ReloadWorkQueue(&queue_);
-  }
-}
-
 IncomingTaskQueue::DelayedQueue::DelayedQueue(IncomingTaskQueue* outer)
     : outer_(outer) {}
 
@@ -7,6 +7,7 @@
 */
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <memory>
@@ -15,6 +16,8 @@
 #include "callback.h"
 #include "macor.h"
 #include "pending_task.h"
+#include "message_loop/mpsc_task_queue.h"
+#include "message_loop/task_queue_stats.h"
 
 namespace loki {
 
@@ -25,6 +28,8 @@ namespace internal {
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean sutdown.
+// 投递任务不加锁: incoming queue 是一个MPSC 无锁队列，只有在需要唤醒
+// message loop 时才会获取|message_loop_lock_|.
 class IncomingTaskQueue {
  public:
   // 提供一个用于读和删除的队列虚基类.
@@ -73,8 +78,13 @@ class IncomingTaskQueue {
                           Nestable nestable);
 
   // Returns true if the message loop is "idle".
+  // 只能在message loop 的线程上调用.
   bool IsIdleForTesting();
 
+  // 获取这个队列的统计快照(投递到运行的延迟直方图、队列深度)，
+  // 可以在任何线程调用.
+  void GetStats(TaskQueueStats* stats) const;
+
   // 将this从父消息循环断开.
   void WillDestroyCurrentMessageLoop();
 
@@ -110,7 +120,7 @@ class IncomingTaskQueue {
     ~TriageQueue() OVERRIDE;
 
     // ReadAndRemoveOnlyQueue:
-    // 如果队列时空的(调用clear除外), 那么下列方法就会从incoming 队列从新加载.
+    // 直接读取incoming queue(无锁队列)，不再把任务转移到另一个队列.
     const PendingTask& Peek() OVERRIDE;
     PendingTask Pop() OVERRIDE;
 
@@ -118,11 +128,7 @@ class IncomingTaskQueue {
     void Clear() OVERRIDE;
 
    private:
-    // 如果队列为空从incoming queue 重新加载.
-    void ReloadFromIncomingQueueIfEmpty();
-
     IncomingTaskQueue* const outer_;
-    TaskQueue queue_;
 
     DISALLOW_COPY_AND_ASSIGN(TriageQueue);
   };
@@ -176,11 +182,14 @@ class IncomingTaskQueue {
 
   // 这个函数作真正的posting a pending task, 如果返回true，这个调用一你应该在
   // 这个message loop 上面调用ScheduleWork() .
-  bool PostPendingTaskLockRequired(PendingTask* pending_task);
+  bool EnqueuePendingTask(PendingTask* pending_task);
 
-  // 加载任务，从incoming queue到work queue
-  // 返回|work_queue|中需要高分辨率计时器的任务数量。
-  int ReloadWorkQueue(TaskQueue* work_queue);
+  // incoming queue 中是否有任务，只能在message loop 的线程上调用.
+  // 队列为空时清除|message_loop_scheduled_|，之后的投递会重新唤醒.
+  bool HasIncomingTasks();
+
+  // 尝试占有|message_loop_scheduled_|，返回true 表示调用者负责唤醒.
+  bool TryMarkScheduled();
 
   // 如果设置为true，表示只要接受到任务就会调用ScheduleWork(),
   // 只要incoming queue 不是空.
@@ -201,35 +210,27 @@ class IncomingTaskQueue {
   // 指向拥有this的消息循环.
   MessageLoop* message_loop_;
 
-  // 用于同步访问该行一下的所有数据.
-  std::mutex incoming_queue_lock_;
-
-  // Number of tasks that require high resolution timing.This value is kept
-  // so that ReloadWorkQueue() completes in constant time.
-  int high_res_task_count_ = 0;
+  // 以下数据可以在多个线程上同时访问，全部是原子的.
 
   // 这个队列里面保存的任务是还没有放到message loop 中的.
-  TaskQueue incoming_queue_;
+  MpscTaskQueue incoming_queue_;
 
   // 如果应该接受新的任务就为true.
-  bool accept_new_tasks_ = true;
+  std::atomic<bool> accept_new_tasks_{true};
 
   // 用于延迟任务的下一个序列号.
-  int next_sequence_num_ = 0;
+  std::atomic<int> next_sequence_num_{0};
 
   // 如果我们的message loop 是已经scheduled并且不需要再一次scheduled时为true.
-  // 直到为空时在重新加载.
-  bool message_loop_scheduled_ = false;
+  // 直到为空时在重新加载. 投递方和HasIncomingTasks() 都用seq_cst 访问它和
+  // incoming queue 的head，保证不会出现有任务却没有人唤醒的情况.
+  std::atomic<bool> message_loop_scheduled_{false};
 
   // 直到StartScheduling()调用前都为false.
-  bool is_ready_for_schedulig_ = false;
-
-  // True if the outgoing queue (|triage_tasks_|) is empty. Toggled under
-  // |incoming_queue_lock_| in ReloadWorkQueue() so that
-  // PostPendingTaskLockRequired() can tell, without accessing the thread unsafe
-  // |triage_tasks_|, if the IncomingTaskQueue has been made non-empty by a
-  // PostTask() (and needs to inform its Observer).
-  bool triage_queue_empty_ = true;
+  std::atomic<bool> is_ready_for_schedulig_{false};
+
+  // 投递到运行的延迟和队列深度统计.
+  TaskQueueStatsRecorder stats_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
@@ -53,6 +53,12 @@ bool MessageLoopTaskRunner::RunsTasksInCurrentSequence() {
 	return valid_thread_id_ == PlatformThread::CurrentId();
 }
 
+bool MessageLoopTaskRunner::GetTaskQueueStats(TaskQueueStats* stats) {
+	DCHECK(stats);
+	incoming_queue_->GetStats(stats);
+	return true;
+}
+
 MessageLoopTaskRunner::~MessageLoopTaskRunner() = default;
 
 }	// namespace loki.
@@ -37,6 +37,9 @@ class LOKI_EXPORT MessageLoopTaskRunner : public SingleThreadTaskRunner {
                                   std::chrono::milliseconds delay) OVERRIDE;
 
   virtual bool RunsTasksInCurrentSequence() OVERRIDE;
+
+  bool GetTaskQueueStats(TaskQueueStats* stats) OVERRIDE;
+
   ~MessageLoopTaskRunner() OVERRIDE;
 
  private:
@@ -0,0 +1,84 @@
+﻿/**
+* @Author: YangGuang
+* @Date:   2026-10-18
+* @Email:  guang334419520@126.com
+* @Filename: mpsc_task_queue.cc
+* @Last modified by:  YangGuang
+*/
+
+#include "message_loop/mpsc_task_queue.h"
+
+#include <thread>
+
+#include "logging.h"
+
+namespace loki {
+
+namespace internal {
+
+MpscTaskQueue::MpscTaskQueue() : head_(&stub_), tail_(&stub_) {}
+
+MpscTaskQueue::~MpscTaskQueue() {
+  while (FrontNode())
+    Pop();
+}
+
+void MpscTaskQueue::Push(PendingTask pending_task) {
+  PushNode(new TaskNode(std::move(pending_task)));
+}
+
+PendingTask* MpscTaskQueue::Peek() {
+  TaskNode* node = FrontNode();
+  return node ? &node->task : nullptr;
+}
+
+void MpscTaskQueue::Pop() {
+  DCHECK(tail_ != &stub_);
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (!next) {
+    // |tail|是最后一个节点：把占位节点放到它后面，这样删除|tail|之后队列
+    // 仍然有一个节点. 如果已经有生产者在它后面入队，就等它链接完成.
+    if (head_.load(std::memory_order_acquire) == tail)
+      PushNode(&stub_);
+    next = WaitForNext(tail);
+  }
+
+  tail_ = next;
+  delete static_cast<TaskNode*>(tail);
+}
+
+void MpscTaskQueue::PushNode(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  // 交换之后|node|就是新的head，再把它链接到前一个节点后面.
+  Node* prev = head_.exchange(node, std::memory_order_seq_cst);
+  prev->next.store(node, std::memory_order_release);
+}
+
+MpscTaskQueue::TaskNode* MpscTaskQueue::FrontNode() {
+  if (tail_ != &stub_)
+    return static_cast<TaskNode*>(tail_);
+
+  Node* next = stub_.next.load(std::memory_order_acquire);
+  if (!next) {
+    if (head_.load(std::memory_order_seq_cst) == &stub_)
+      return nullptr;
+    next = WaitForNext(&stub_);
+  }
+  tail_ = next;
+  return static_cast<TaskNode*>(next);
+}
+
+// static
+MpscTaskQueue::Node* MpscTaskQueue::WaitForNext(Node* node) {
+  Node* next = node->next.load(std::memory_order_acquire);
+  while (!next) {
+    std::this_thread::yield();
+    next = node->next.load(std::memory_order_acquire);
+  }
+  return next;
+}
+
+}  // namespace internal.
+
+}  // namespace loki.
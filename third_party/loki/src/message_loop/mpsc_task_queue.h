@@ -0,0 +1,76 @@
+﻿/**
+* @Author: YangGuang
+* @Date:   2026-10-18
+* @Email:  guang334419520@126.com
+* @Filename: mpsc_task_queue.h
+* @Last modified by:  YangGuang
+*/
+#pragma once
+
+#include <atomic>
+
+#include "macor.h"
+#include "pending_task.h"
+
+namespace loki {
+
+namespace internal {
+
+// 多生产者单消费者的无锁任务队列(侵入式链表, Vyukov MPSC).
+//
+// Push() 可以在任何线程同时调用，只需要一次原子交换，不会阻塞；
+// Peek() 和 Pop() 只能在消费线程(消息循环自己的线程)上调用，消费者直接
+// 从链表上读取任务，不需要再拷贝到另一个队列.
+// 生产者交换完|head_|、还没有链接next 的那一小段时间里，消费者会
+// 让出CPU等待链接完成，所以任务始终按入队的顺序取出.
+class MpscTaskQueue {
+ public:
+  MpscTaskQueue();
+
+  // 销毁时不能再有生产者，剩下的任务会直接删除.
+  ~MpscTaskQueue();
+
+  void Push(PendingTask pending_task);
+
+  // 返回队首的任务，队列为空时返回nullptr.
+  // 使用seq_cst 读取|head_|，可以配合调用者的seq_cst 标志检查空队列.
+  PendingTask* Peek();
+
+  // 删除队首的任务，调用前Peek() 必须返回非空.
+  void Pop();
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+    std::atomic<Node*> next;
+  };
+
+  struct TaskNode : Node {
+    explicit TaskNode(PendingTask pending_task)
+        : task(std::move(pending_task)) {}
+    PendingTask task;
+  };
+
+  void PushNode(Node* node);
+
+  // 跳过占位节点，返回队首的任务节点，队列为空时返回nullptr.
+  TaskNode* FrontNode();
+
+  // 等待生产者把|node|的next 链接上.
+  static Node* WaitForNext(Node* node);
+
+  // 生产者一侧: 最后入队的节点.
+  std::atomic<Node*> head_;
+
+  // 消费者一侧: 队首节点(可能是占位节点), 只有消费线程访问.
+  Node* tail_;
+
+  // 队列为空时的占位节点.
+  Node stub_;
+
+  DISALLOW_COPY_AND_ASSIGN(MpscTaskQueue);
+};
+
+}  // namespace internal.
+
+}  // namespace loki.
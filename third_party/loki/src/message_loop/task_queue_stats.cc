@@ -0,0 +1,139 @@
+﻿/**
+* @Author: YangGuang
+* @Date:   2026-10-18
+* @Email:  guang334419520@126.com
+* @Filename: task_queue_stats.cc
+* @Last modified by:  YangGuang
+*/
+
+#include "message_loop/task_queue_stats.h"
+
+#include <algorithm>
+
+namespace loki {
+
+TaskQueueStats::TaskQueueStats()
+    : posted_tasks(0),
+      run_tasks(0),
+      incoming_depth(0),
+      peak_incoming_depth(0),
+      latency_sum_us(0),
+      max_latency_us(0) {
+  std::fill(latency_histogram, latency_histogram + kLatencyBuckets, 0);
+}
+
+double TaskQueueStats::MeanLatencyUs() const {
+  if (run_tasks == 0)
+    return 0.0;
+  return static_cast<double>(latency_sum_us) / run_tasks;
+}
+
+uint64_t TaskQueueStats::LatencyPercentileUs(double percentile) const {
+  uint64_t total = 0;
+  for (int i = 0; i < kLatencyBuckets; ++i)
+    total += latency_histogram[i];
+  if (total == 0)
+    return 0;
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = static_cast<uint64_t>(total * percentile / 100.0);
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (int i = 0; i < kLatencyBuckets; ++i) {
+    seen += latency_histogram[i];
+    if (seen >= rank) {
+      // 桶的上界不超过观察到的最大值(最后一个桶没有上界).
+      if (i == kLatencyBuckets - 1)
+        return max_latency_us;
+      return std::min(uint64_t(1) << i, max_latency_us);
+    }
+  }
+  return max_latency_us;
+}
+
+namespace internal {
+
+TaskQueueStatsRecorder::TaskQueueStatsRecorder()
+    : posted_tasks_(0),
+      dequeued_tasks_(0),
+      run_tasks_(0),
+      peak_incoming_depth_(0),
+      latency_sum_us_(0),
+      max_latency_us_(0) {
+  for (int i = 0; i < TaskQueueStats::kLatencyBuckets; ++i)
+    latency_histogram_[i].store(0, std::memory_order_relaxed);
+}
+
+void TaskQueueStatsRecorder::OnTaskPosted() {
+  // 在入队之前增加投递数，消息循环取走任务时深度不会变成负数.
+  uint64_t posted = posted_tasks_.fetch_add(1, std::memory_order_relaxed) + 1;
+  int64_t depth = static_cast<int64_t>(
+      posted - dequeued_tasks_.load(std::memory_order_relaxed));
+  int64_t peak = peak_incoming_depth_.load(std::memory_order_relaxed);
+  while (depth > peak &&
+         !peak_incoming_depth_.compare_exchange_weak(
+             peak, depth, std::memory_order_relaxed)) {
+  }
+}
+
+void TaskQueueStatsRecorder::OnTaskDequeued() {
+  dequeued_tasks_.store(dequeued_tasks_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+}
+
+void TaskQueueStatsRecorder::OnTaskRun(
+    std::chrono::steady_clock::time_point queue_time) {
+  std::chrono::steady_clock::duration waited =
+      std::chrono::steady_clock::now() - queue_time;
+  uint64_t latency_us = 0;
+  if (waited.count() > 0) {
+    latency_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(waited).count());
+  }
+
+  // 只有消息循环自己的线程会写下面这些值，不需要原子的读-改-写.
+  run_tasks_.store(run_tasks_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  latency_sum_us_.store(
+      latency_sum_us_.load(std::memory_order_relaxed) + latency_us,
+      std::memory_order_relaxed);
+  if (latency_us > max_latency_us_.load(std::memory_order_relaxed))
+    max_latency_us_.store(latency_us, std::memory_order_relaxed);
+
+  std::atomic<uint64_t>& bucket =
+      latency_histogram_[BucketForLatency(latency_us)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+}
+
+void TaskQueueStatsRecorder::Snapshot(TaskQueueStats* stats) const {
+  // 先读取走数再读投递数，两次读取之间有新的任务也不会得到负数.
+  uint64_t dequeued = dequeued_tasks_.load(std::memory_order_relaxed);
+  stats->posted_tasks = posted_tasks_.load(std::memory_order_relaxed);
+  stats->incoming_depth = std::max<int64_t>(
+      static_cast<int64_t>(stats->posted_tasks - dequeued), 0);
+  stats->run_tasks = run_tasks_.load(std::memory_order_relaxed);
+  stats->peak_incoming_depth =
+      peak_incoming_depth_.load(std::memory_order_relaxed);
+  stats->latency_sum_us = latency_sum_us_.load(std::memory_order_relaxed);
+  stats->max_latency_us = max_latency_us_.load(std::memory_order_relaxed);
+  for (int i = 0; i < TaskQueueStats::kLatencyBuckets; ++i) {
+    stats->latency_histogram[i] =
+        latency_histogram_[i].load(std::memory_order_relaxed);
+  }
+}
+
+// static
+int TaskQueueStatsRecorder::BucketForLatency(uint64_t latency_us) {
+  int bucket = 0;
+  while (latency_us > 0 && bucket < TaskQueueStats::kLatencyBuckets - 1) {
+    latency_us >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace internal.
+
+}  // namespace loki.
@@ -0,0 +1,93 @@
+﻿/**
+* @Author: YangGuang
+* @Date:   2026-10-18
+* @Email:  guang334419520@126.com
+* @Filename: task_queue_stats.h
+* @Last modified by:  YangGuang
+*/
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+
+#include "loki_export.h"
+#include "macor.h"
+
+namespace loki {
+
+// 一个消息循环（也就是一个线程）的任务队列统计快照.
+//
+// 延迟（latency）指任务从进入incoming queue 到开始运行之间等待的时间，
+// 延迟任务从它的预期运行时间开始算，所以只反映它被推迟了多久.
+struct LOKI_EXPORT TaskQueueStats {
+  // 延迟直方图按2的幂分桶(微秒): 桶0 是 < 1us, 桶k(k >= 1) 是
+  // [2^(k-1), 2^k) us, 最后一个桶包含所有更大的值(>= ~4.2s).
+  enum { kLatencyBuckets = 24 };
+
+  TaskQueueStats();
+
+  // 平均延迟(微秒)，没有运行过任务时返回0.
+  double MeanLatencyUs() const;
+
+  // 返回|percentile|(0 ~ 100)所在桶的上界(微秒)，没有运行过任务时返回0.
+  uint64_t LatencyPercentileUs(double percentile) const;
+
+  // 已经投递到这个队列的任务数.
+  uint64_t posted_tasks;
+
+  // 已经运行的任务数.
+  uint64_t run_tasks;
+
+  // 当前还在incoming queue 里、没有被消息循环取走的任务数.
+  int64_t incoming_depth;
+
+  // incoming queue 出现过的最大深度.
+  int64_t peak_incoming_depth;
+
+  uint64_t latency_sum_us;
+  uint64_t max_latency_us;
+  uint64_t latency_histogram[kLatencyBuckets];
+};
+
+namespace internal {
+
+// 记录一个IncomingTaskQueue 的统计数据.
+// OnTaskPosted() 可以在任何线程调用，OnTaskDequeued() 和 OnTaskRun() 只会
+// 在消息循环自己的线程上调用，Snapshot() 可以在任何线程调用(各个字段分别
+// 读取，彼此之间不保证是同一时刻的值).
+class TaskQueueStatsRecorder {
+ public:
+  TaskQueueStatsRecorder();
+
+  void OnTaskPosted();
+
+  // 消息循环从incoming queue 取走了一个任务.
+  void OnTaskDequeued();
+
+  // |queue_time| 是任务进入队列(或者延迟任务到期)的时间.
+  void OnTaskRun(std::chrono::steady_clock::time_point queue_time);
+
+  void Snapshot(TaskQueueStats* stats) const;
+
+  // 延迟(微秒)对应的直方图桶.
+  static int BucketForLatency(uint64_t latency_us);
+
+ private:
+  // 队列深度 = 投递数 - 取走数，取走数只有消息循环线程会写，这样消费
+  // 一侧不需要和投递方竞争同一个原子变量.
+  std::atomic<uint64_t> posted_tasks_;
+  std::atomic<uint64_t> dequeued_tasks_;
+  std::atomic<uint64_t> run_tasks_;
+  std::atomic<int64_t> peak_incoming_depth_;
+  std::atomic<uint64_t> latency_sum_us_;
+  std::atomic<uint64_t> max_latency_us_;
+  std::atomic<uint64_t> latency_histogram_[TaskQueueStats::kLatencyBuckets];
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueueStatsRecorder);
+};
+
+}  // namespace internal.
+
+}  // namespace loki.
@@ -45,6 +45,10 @@ struct LOKI_EXPORT PendingTask {
 
   std::chrono::milliseconds delayed_run_time;
 
+  // 进入incoming queue 的时间(延迟任务是预期运行的时间)，用于统计任务从
+  // 投递到运行之间的延迟.
+  std::chrono::steady_clock::time_point queue_time;
+
   std::array<const void*, 4> task_backtrace;
 
   int sequence_num;
@@ -52,6 +52,10 @@ bool CurrentlyOn(ID identifier) {
   return LokiThread::CurrentlyOn(identifier);
 }
 
+bool GetTaskQueueStats(ID identifier, TaskQueueStats* stats) {
+  return LokiThread::GetTaskQueueStats(identifier, stats);
+}
+
 }  // namespace loki
 
 
@@ -11,6 +11,7 @@
 #include "callback.h"
 #include "task_runner_util.h"
 #include "single_thread_task_runner.h"
+#include "message_loop/task_queue_stats.h"
 
 namespace loki {
 
@@ -101,6 +102,9 @@ void Invoke(ID identifier,
 
 LOKI_EXPORT bool CurrentlyOn(ID identifier);
 
+// 线程|identifier|的任务队列统计，线程没有运行时返回false.
+LOKI_EXPORT bool GetTaskQueueStats(ID identifier, TaskQueueStats* stats);
+
 }  // namespace loki
 
 #if !defined(CURRENTLY_ON)
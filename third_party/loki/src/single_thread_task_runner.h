@@ -14,10 +14,15 @@
 
 namespace loki {
 
+struct TaskQueueStats;
+
 class LOKI_EXPORT SingleThreadTaskRunner : public SequencedTaskRunner {
  public:
   bool BelongsToCurrentThread() { return RunsTasksInCurrentSequence(); }
 
+  // 获取这个线程任务队列的统计快照，不支持统计的task runner 返回false.
+  virtual bool GetTaskQueueStats(TaskQueueStats* /*stats*/) { return false; }
+
  protected:
   ~SingleThreadTaskRunner() OVERRIDE = default;
 };
@@ -103,6 +103,10 @@ class LOKI_EXPORT LokiThread {
   // 否则返回false.
   static bool GetCurrentThreadIdentifier(ID* identifier) WARN_UNUSED_RESULT;
 
+  // 获取线程|identifier|的任务队列统计(投递到运行的延迟直方图、队列深度),
+  // 线程没有运行时返回false. 可以调用在任何线程上.
+  static bool GetTaskQueueStats(ID identifier, loki::TaskQueueStats* stats);
+
   // 调用者可以在线程的生命周期之外持有一个被重新计算的任务运行器.
   static std::shared_ptr<loki::SingleThreadTaskRunner> GetTaskRunnerForThread(
       ID identifier);
@@ -177,6 +177,20 @@ bool LokiThread::GetCurrentThreadIdentifier(ID* identifier) {
 	return false;
 }
 
+// static method.
+bool LokiThread::GetTaskQueueStats(ID identifier, loki::TaskQueueStats* stats) {
+	DCHECK_GE(identifier, 0);
+	DCHECK_LT(identifier, ID_COUNT);
+
+	BrowserThreadGlobals& globals = g_globals.Get();
+	if (globals.states[identifier].load(std::memory_order_acquire) !=
+		BrowserThreadState::RUNNING) {
+		return false;
+	}
+	return globals.task_runners[identifier] &&
+		   globals.task_runners[identifier]->GetTaskQueueStats(stats);
+}
+
 // static method.
 bool LokiThread::PostTask(ID identifier,
 							 const loki::Location& from_here,
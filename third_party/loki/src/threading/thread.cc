@@ -58,12 +58,13 @@ bool Thread::StartWithOptions(const Options& options) {
 
   {
     std::lock_guard<std::mutex> lock(thread_mutex_);
+    // 新线程的Run() 会检查这个值，必须在创建线程之前设置.
+    is_thread_valid_ = true;
     thread_ = options.joinable
                   ? PlatformThread::CreateWithPriority(options.stack_size, this,
                                                        options.priority)
                   : PlatformThread::CreateNonJoinableWithPriority(
                         options.stack_size, this, options.priority);
-    is_thread_valid_ = true;
   }
 
   joinable_ = options.joinable;
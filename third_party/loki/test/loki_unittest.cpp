@@ -1,6 +1,8 @@
 ﻿#include <gtest/gtest.h>
+#include <atomic>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <condition_variable>
 #include "main_message_loop.h"
 #include "main_message_loop_std.h"
@@ -166,3 +168,100 @@ TEST(LokiTest, PostTaskDelay) {
   std::cout << time << std::endl;
   EXPECT_TRUE(time >= 28500  && time <= 31500);
 }
+
+
+void CountTask(std::atomic<int>* counter) {
+  counter->fetch_add(1, std::memory_order_relaxed);
+}
+
+TEST(LokiTest, TaskQueueStats) {
+  loki::TaskQueueStats before;
+  ASSERT_TRUE(loki::GetTaskQueueStats(WORKER, &before));
+  // 没有运行的线程没有统计.
+  loki::TaskQueueStats unused;
+  EXPECT_FALSE(loki::GetTaskQueueStats(loki::DB, &unused));
+
+  std::atomic<int> counter(0);
+  std::unique_lock<std::mutex> lock(gMutex);
+  done = false;
+  const int kTasks = 1000;
+  for (int i = 0; i < kTasks; ++i)
+    POST_TASK(WORKER, loki::BindOnceClosure(&CountTask, &counter));
+  POST_TASK(WORKER, loki::BindOnceClosure(&DoneNotify));
+  gVar.wait(lock, []() { return done; });
+  EXPECT_EQ(counter.load(), kTasks);
+
+  loki::TaskQueueStats after;
+  ASSERT_TRUE(loki::GetTaskQueueStats(WORKER, &after));
+  EXPECT_GE(after.posted_tasks - before.posted_tasks, uint64_t(kTasks + 1));
+  EXPECT_GE(after.run_tasks - before.run_tasks, uint64_t(kTasks + 1));
+  EXPECT_GE(after.peak_incoming_depth, 1);
+  EXPECT_GE(after.incoming_depth, 0);
+
+  uint64_t histogram_total = 0;
+  for (int i = 0; i < loki::TaskQueueStats::kLatencyBuckets; ++i)
+    histogram_total += after.latency_histogram[i];
+  EXPECT_EQ(histogram_total, after.run_tasks);
+  EXPECT_LE(after.LatencyPercentileUs(50), after.LatencyPercentileUs(99));
+  EXPECT_LE(after.MeanLatencyUs(), static_cast<double>(after.max_latency_us));
+}
+
+// 多个线程同时向WORKER 投递空任务，测量投递/运行吞吐量和排队延迟.
+// 运行: ./loki_unittest --gtest_also_run_disabled_tests
+//       --gtest_filter=*PostRunThroughput*
+TEST(LokiTest, DISABLED_PostRunThroughput) {
+  const int kProducers = 4;
+  const int kTasksPerProducer = 250000;
+
+  loki::TaskQueueStats before;
+  ASSERT_TRUE(loki::GetTaskQueueStats(WORKER, &before));
+
+  std::atomic<int> counter(0);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&counter]() {
+      for (int i = 0; i < kTasksPerProducer; ++i)
+        POST_TASK(WORKER, loki::BindOnceClosure(&CountTask, &counter));
+    });
+  }
+  for (auto& producer : producers)
+    producer.join();
+  auto posted = std::chrono::steady_clock::now();
+
+  {
+    std::unique_lock<std::mutex> lock(gMutex);
+    done = false;
+    POST_TASK(WORKER, loki::BindOnceClosure(&DoneNotify));
+    gVar.wait(lock, []() { return done; });
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(counter.load(), kProducers * kTasksPerProducer);
+
+  loki::TaskQueueStats after;
+  ASSERT_TRUE(loki::GetTaskQueueStats(WORKER, &after));
+  loki::TaskQueueStats delta;
+  delta.run_tasks = after.run_tasks - before.run_tasks;
+  delta.latency_sum_us = after.latency_sum_us - before.latency_sum_us;
+  delta.max_latency_us = after.max_latency_us;
+  for (int i = 0; i < loki::TaskQueueStats::kLatencyBuckets; ++i) {
+    delta.latency_histogram[i] =
+        after.latency_histogram[i] - before.latency_histogram[i];
+  }
+
+  double post_seconds = std::chrono::duration<double>(posted - start).count();
+  double total_seconds = std::chrono::duration<double>(end - start).count();
+  const double total_tasks = kProducers * kTasksPerProducer;
+  std::cout << "producers: " << kProducers << ", tasks: " << total_tasks
+            << std::endl;
+  std::cout << "post throughput: " << total_tasks / post_seconds / 1e6
+            << " M tasks/s" << std::endl;
+  std::cout << "post+run throughput: " << total_tasks / total_seconds / 1e6
+            << " M tasks/s" << std::endl;
+  std::cout << "latency mean " << delta.MeanLatencyUs() << "us, p50 <= "
+            << delta.LatencyPercentileUs(50) << "us, p99 <= "
+            << delta.LatencyPercentileUs(99) << "us, max "
+            << delta.max_latency_us << "us" << std::endl;
+  std::cout << "peak incoming depth: " << after.peak_incoming_depth
+            << std::endl;
+}
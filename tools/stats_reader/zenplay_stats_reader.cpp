@@ -0,0 +1,221 @@
+/**
+ * @file zenplay_stats_reader.cpp
+ * @brief 共享内存统计读取工具
+ *
+ * 附加到播放器发布的统计共享内存段（只读），按指定间隔打印实时数值。
+ * 播放器需以 ZENPLAY_STATS_SHM=1（或自定义段名）启动。
+ *
+ * 用法：
+ *   zenplay_stats_reader [-n /zenplay_stats] [-i 500] [--once]
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "player/stats/stats_shm_layout.h"
+
+using namespace zenplay::stats;
+
+namespace {
+
+volatile sig_atomic_t g_quit = 0;
+
+void OnSignal(int) {
+  g_quit = 1;
+}
+
+/**
+ * @brief 只读映射的统计段
+ */
+class SegmentView {
+ public:
+  ~SegmentView() { Detach(); }
+
+  bool Attach(const std::string& name) {
+    Detach();
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(StatsShmSegment)) {
+      close(fd);
+      return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    segment_ = static_cast<const StatsShmSegment*>(addr);
+    return true;
+  }
+
+  void Detach() {
+    if (segment_) {
+      munmap(const_cast<StatsShmSegment*>(segment_), size_);
+      segment_ = nullptr;
+    }
+  }
+
+  const StatsShmSegment* segment() const { return segment_; }
+
+ private:
+  const StatsShmSegment* segment_ = nullptr;
+  size_t size_ = 0;
+};
+
+void PrintSnapshot(const StatsShmSegment* segment,
+                   const StatsShmSnapshot& s) {
+  std::printf("\n=== ZenPlay stats (pid %u, publish #%llu, uptime %.1fs) ===\n",
+              segment->header.writer_pid,
+              static_cast<unsigned long long>(
+                  segment->header.publish_count.load()),
+              s.uptime_ms / 1000.0);
+  std::printf("Demux   : %llu pkts (v %llu / a %llu), %.1f pkt/s, %.1f KB/s, "
+              "avg %.2f ms, errors %llu\n",
+              static_cast<unsigned long long>(s.demux_packets_total),
+              static_cast<unsigned long long>(s.demux_packets_video),
+              static_cast<unsigned long long>(s.demux_packets_audio),
+              s.demux_read_rate_pps, s.demux_read_rate_bps / 1024.0,
+              s.demux_avg_read_time_ms,
+              static_cast<unsigned long long>(s.demux_read_errors));
+  std::printf("VDecode : %llu frames, %.1f fps, avg %.2f ms, queue %u, "
+              "errors %llu\n",
+              static_cast<unsigned long long>(s.video_frames_decoded),
+              s.video_decode_fps, s.video_avg_decode_time_ms,
+              s.video_decode_queue_size,
+              static_cast<unsigned long long>(s.video_decode_errors));
+  std::printf("ADecode : %llu frames, %.1f fps, avg %.2f ms, queue %u, "
+              "errors %llu\n",
+              static_cast<unsigned long long>(s.audio_frames_decoded),
+              s.audio_decode_fps, s.audio_avg_decode_time_ms,
+              s.audio_decode_queue_size,
+              static_cast<unsigned long long>(s.audio_decode_errors));
+  std::printf("VRender : %llu rendered, %llu dropped (%.2f%%), %.1f fps, "
+              "avg %.2f ms\n",
+              static_cast<unsigned long long>(s.video_frames_rendered),
+              static_cast<unsigned long long>(s.video_frames_dropped),
+              s.video_frame_drop_rate, s.video_render_fps,
+              s.video_avg_render_time_ms);
+  std::printf("Upload  : %.1f MB uploaded, %.1f MB saved, %llu skipped\n",
+              s.video_bytes_uploaded / (1024.0 * 1024.0),
+              s.video_bytes_upload_saved / (1024.0 * 1024.0),
+              static_cast<unsigned long long>(s.video_frames_upload_skipped));
+  std::printf("Sync    : offset %.2f ms (avg %.2f, max %.2f), A %.1f / "
+              "V %.1f ms, corrections %llu, %s\n",
+              s.av_sync_offset_ms, s.avg_sync_offset_ms, s.max_sync_error_ms,
+              s.audio_clock_ms, s.video_clock_ms,
+              static_cast<unsigned long long>(s.sync_corrections),
+              s.is_in_sync ? "in sync" : "OUT OF SYNC");
+  std::printf("System  : CPU %.1f%%, memory %llu MB\n", s.cpu_usage_percent,
+              static_cast<unsigned long long>(s.memory_usage_mb));
+  std::printf("Network : %.1f kbps, %.1f MB total, buffer %u%%, errors %llu\n",
+              s.download_rate_kbps, s.bytes_downloaded / (1024.0 * 1024.0),
+              s.buffer_health_percent,
+              static_cast<unsigned long long>(s.network_errors));
+  std::fflush(stdout);
+}
+
+void PrintUsage(const char* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [-n name] [-i interval_ms] [--once]\n"
+               "  -n name         shm segment name (default %s)\n"
+               "  -i interval_ms  print interval (default 1000)\n"
+               "  --once          print one snapshot and exit\n",
+               argv0, kDefaultStatsShmName);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string name = kDefaultStatsShmName;
+  int interval_ms = 1000;
+  bool once = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      name = argv[++i];
+    } else if (arg == "-i" && i + 1 < argc) {
+      interval_ms = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--once") {
+      once = true;
+    } else {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  signal(SIGINT, OnSignal);
+  signal(SIGTERM, OnSignal);
+
+  SegmentView view;
+  uint64_t last_publish = 0;
+  auto last_progress = std::chrono::steady_clock::now();
+  bool waiting_reported = false;
+
+  while (!g_quit) {
+    // 播放器重启会删除并重建段，长时间无更新时重新附加
+    auto now = std::chrono::steady_clock::now();
+    bool stale =
+        view.segment() && now - last_progress > std::chrono::seconds(3);
+    if (!view.segment() || stale) {
+      if (view.Attach(name)) {
+        last_publish = 0;
+        last_progress = now;
+        waiting_reported = false;
+      } else {
+        if (once) {
+          std::fprintf(stderr, "Cannot attach to %s: %s\n", name.c_str(),
+                       std::strerror(errno));
+          return 1;
+        }
+        if (!waiting_reported) {
+          std::fprintf(stderr, "Waiting for %s ...\n", name.c_str());
+          waiting_reported = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        continue;
+      }
+    }
+
+    const StatsShmSegment* segment = view.segment();
+    StatsShmSnapshot snapshot;
+    if (ReadStatsShmSnapshot(segment, &snapshot)) {
+      uint64_t publish = segment->header.publish_count.load();
+      if (publish != last_publish) {
+        last_publish = publish;
+        last_progress = now;
+      }
+      PrintSnapshot(segment, snapshot);
+      if (once) {
+        return 0;
+      }
+    } else if (segment->header.magic.load() == kStatsShmMagic &&
+               segment->header.version != kStatsShmVersion) {
+      std::fprintf(stderr, "Unsupported segment version %u (expected %u)\n",
+                   segment->header.version, kStatsShmVersion);
+      return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+  }
+  return 0;
+}